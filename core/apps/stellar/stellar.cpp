@@ -23,11 +23,71 @@
 
 #include <seqan/index.h>
 #include <seqan/arg_parse.h>
+#include <seqan/parallel.h>
 #include "stellar.h"
 #include "stellar_output.h"
 
 using namespace seqan;
 
+///////////////////////////////////////////////////////////////////////////////
+// Initializes a Finder object for a database sequence and calls stellar, or
+//  verifies the swift hits in batches of hitBatchSize with several threads
+template <typename TSequence, typename TId, typename TPattern, typename TMatches, typename TTag>
+inline void
+_stellarVerifyOne(TSequence & database,
+                  TId & databaseID,
+                  TPattern & swiftPattern,
+                  bool databaseStrand,
+                  TMatches & matches,
+                  StellarOptions & options,
+                  unsigned hitBatchSize,
+                  TTag tag)
+{
+    // finder
+    typedef Finder<TSequence, Swift<SwiftLocal> > TFinder;
+    TFinder swiftFinder(database, options.minRepeatLength, options.maxRepeatPeriod);
+
+    // stellar
+    if (hitBatchSize == 0)
+        stellar(swiftFinder, swiftPattern, options.epsilon, options.minLength, options.xDrop,
+                options.disableThresh, options.compactThresh, options.numMatches, options.verbose,
+                databaseID, databaseStrand, matches, tag);
+    else
+        _stellarParallelVerify(swiftFinder, swiftPattern, options.epsilon, options.minLength, options.xDrop,
+                               options.disableThresh, options.compactThresh, options.numMatches,
+                               databaseID, databaseStrand, matches, hitBatchSize, tag);
+}
+
+template <typename TSequence, typename TId, typename TPattern, typename TMatches>
+inline bool
+_stellarVerifyOne(TSequence & database,
+                  TId & databaseID,
+                  TPattern & swiftPattern,
+                  bool databaseStrand,
+                  TMatches & matches,
+                  StellarOptions & options,
+                  unsigned hitBatchSize = 0)
+{
+    if (options.fastOption == CharString("exact"))
+        _stellarVerifyOne(database, databaseID, swiftPattern, databaseStrand, matches, options, hitBatchSize,
+                          AllLocal());
+    else if (options.fastOption == "bestLocal")
+        _stellarVerifyOne(database, databaseID, swiftPattern, databaseStrand, matches, options, hitBatchSize,
+                          BestLocal());
+    else if (options.fastOption == "bandedGlobal")
+        _stellarVerifyOne(database, databaseID, swiftPattern, databaseStrand, matches, options, hitBatchSize,
+                          BandedGlobal());
+    else if (options.fastOption == "bandedGlobalExtend")
+        _stellarVerifyOne(database, databaseID, swiftPattern, databaseStrand, matches, options, hitBatchSize,
+                          BandedGlobalExtend());
+    else
+    {
+        std::cerr << "\nUnknown verification strategy: " << options.fastOption << std::endl;
+        return false;
+    }
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Initializes a Finder object for a database sequence,
 //  calls stellar, and writes matches to file
@@ -45,37 +105,126 @@ _stellarOnOne(TSequence & database,
         std::cout << ", complement";
     std::cout << std::flush;
 
-    // finder
-    typedef Finder<TSequence, Swift<SwiftLocal> > TFinder;
-    TFinder swiftFinder(database, options.minRepeatLength, options.maxRepeatPeriod);
-
-    // stellar
-    if (options.fastOption == CharString("exact"))
-        stellar(swiftFinder, swiftPattern, options.epsilon, options.minLength, options.xDrop,
-                options.disableThresh, options.compactThresh, options.numMatches, options.verbose,
-                databaseID, databaseStrand, matches, AllLocal());
-    else if (options.fastOption == "bestLocal")
-        stellar(swiftFinder, swiftPattern, options.epsilon, options.minLength, options.xDrop,
-                options.disableThresh, options.compactThresh, options.numMatches, options.verbose,
-                databaseID, databaseStrand, matches, BestLocal());
-    else if (options.fastOption == "bandedGlobal")
-        stellar(swiftFinder, swiftPattern, options.epsilon, options.minLength, options.xDrop,
-                options.disableThresh, options.compactThresh, options.numMatches, options.verbose,
-                databaseID, databaseStrand, matches, BandedGlobal());
-    else if (options.fastOption == "bandedGlobalExtend")
-        stellar(swiftFinder, swiftPattern, options.epsilon, options.minLength, options.xDrop,
-                options.disableThresh, options.compactThresh, options.numMatches, options.verbose,
-                databaseID, databaseStrand, matches, BandedGlobalExtend());
-    else
-    {
-        std::cerr << "\nUnknown verification strategy: " << options.fastOption << std::endl;
+    if (!_stellarVerifyOne(database, databaseID, swiftPattern, databaseStrand, matches, options))
         return false;
-    }
 
     std::cout << std::endl;
     return true;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Computes the matches with options.threadCount threads.  Database sequences longer than
+//  1/threadCount of the whole database are filtered by one thread, while all threads verify
+//  the SWIFT hits.  Runs of shorter sequences are distributed over the threads, every thread
+//  filters with its own SWIFT pattern on the shared q-gram index and verifies the SWIFT hits
+//  into its own matches, which are merged in the order of the database.
+template <typename TSequence, typename TId, typename TQGramIndex, typename TMatches>
+inline bool
+_stellarOnAllParallel(StringSet<TSequence> & databases,
+                      StringSet<TId> & databaseIDs,
+                      TQGramIndex & qgramIndex,
+                      TMatches & matches,
+                      StellarOptions & options)
+{
+    typedef typename Value<TMatches>::Type TQueryMatches;
+
+    bool reverse = options.reverse && options.alphabet != "protein" && options.alphabet != "char";
+    bool success = true;
+
+#ifdef _OPENMP
+    int oldMaxThreads = omp_get_max_threads();
+    omp_set_num_threads(options.threadCount);
+#endif  // #ifdef _OPENMP
+
+    unsigned const hitBatchSize = 1024 * options.threadCount;
+    __uint64 longLength = lengthSum(databases) / options.threadCount;
+
+    for (unsigned seqBegin = 0, seqEnd = 0; success && seqBegin < length(databases); seqBegin = seqEnd)
+    {
+        if (length(databases[seqBegin]) >= longLength)
+        {
+            // a long database sequence, its SWIFT hits are verified concurrently
+            seqEnd = seqBegin + 1;
+            Pattern<TQGramIndex, Swift<SwiftLocal> > swiftPattern(qgramIndex);
+            if (options.forward)
+            {
+                std::cout << "  " << databaseIDs[seqBegin] << std::endl;
+                success = _stellarVerifyOne(databases[seqBegin], databaseIDs[seqBegin], swiftPattern, true,
+                                            matches, options, hitBatchSize);
+            }
+            if (success && reverse)
+            {
+                std::cout << "  " << databaseIDs[seqBegin] << ", complement" << std::endl;
+                reverseComplement(databases[seqBegin]);
+                success = _stellarVerifyOne(databases[seqBegin], databaseIDs[seqBegin], swiftPattern, false,
+                                            matches, options, hitBatchSize);
+                reverseComplement(databases[seqBegin]);
+            }
+            continue;
+        }
+
+        // a run of short database sequences, each is filtered and verified by one thread
+        for (seqEnd = seqBegin + 1; seqEnd < length(databases) && length(databases[seqEnd]) < longLength; ++seqEnd) ;
+
+        // the threads verify with a fixed compaction threshold, which is raised only while merging
+        StellarOptions threadOptions = options;
+        threadOptions.verbose = false;
+
+        SEQAN_OMP_PRAGMA(parallel for schedule(dynamic) ordered)
+        for (int i = seqBegin; i < (int)seqEnd; ++i)
+        {
+            Pattern<TQGramIndex, Swift<SwiftLocal> > swiftPattern(qgramIndex);
+            StellarOptions localOptions = threadOptions;
+
+            TMatches localMatches;
+            resize(localMatches, length(matches));
+
+            bool localSuccess = true;
+            // positive database strand
+            if (options.forward)
+                localSuccess = _stellarVerifyOne(databases[i], databaseIDs[i], swiftPattern, true, localMatches,
+                                                 localOptions);
+            // negative (reverse complemented) database strand, the sequence is owned by this thread
+            if (localSuccess && reverse)
+            {
+                reverseComplement(databases[i]);
+                localSuccess = _stellarVerifyOne(databases[i], databaseIDs[i], swiftPattern, false, localMatches,
+                                                 localOptions);
+                reverseComplement(databases[i]);
+            }
+
+            SEQAN_OMP_PRAGMA(ordered)
+            {
+                if (options.forward)
+                    std::cout << "  " << databaseIDs[i] << std::endl;
+                if (reverse)
+                    std::cout << "  " << databaseIDs[i] << ", complement" << std::endl;
+                success = success && localSuccess;
+                _mergeQueryMatches(matches, localMatches, options.minLength, options.disableThresh,
+                                   options.compactThresh, options.numMatches);
+            }
+        }
+    }
+
+    // remove overlaps and duplicates of the merged matches and keep the <numMatches> longest per query
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+    for (int i = 0; i < (int)length(matches); ++i)
+    {
+        TQueryMatches & qm = matches[i];
+        if (length(qm.matches) > 0 && !qm.disabled)
+        {
+            maskOverlaps(qm.matches, options.minLength);
+            compactMatches(qm.matches, options.numMatches);
+        }
+    }
+
+#ifdef _OPENMP
+    omp_set_num_threads(oldMaxThreads);
+#endif  // #ifdef _OPENMP
+
+    return success;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 namespace SEQAN_NAMESPACE_MAIN {
 
@@ -164,22 +313,30 @@ _stellarOnAll(StringSet<TSequence> & databases,
     resize(matches, length(queries));
 
     std::cout << "Aligning all query sequences to database sequence..." << std::endl;
-    for (unsigned i = 0; i < length(databases); ++i)
+    if (options.threadCount > 1)
     {
-        // positive database strand
-        if (options.forward)
-        {
-            if (!_stellarOnOne(databases[i], databaseIDs[i], swiftPattern, true, matches, options))
-                return 1;
-        }
-        // negative (reverse complemented) database strand
-        if (options.reverse && options.alphabet != "protein" && options.alphabet != "char")
+        if (!_stellarOnAllParallel(databases, databaseIDs, qgramIndex, matches, options))
+            return 1;
+    }
+    else
+    {
+        for (unsigned i = 0; i < length(databases); ++i)
         {
-            reverseComplement(databases[i]);
-            if (!_stellarOnOne(databases[i], databaseIDs[i], swiftPattern, false, matches, options))
-                return 1;
+            // positive database strand
+            if (options.forward)
+            {
+                if (!_stellarOnOne(databases[i], databaseIDs[i], swiftPattern, true, matches, options))
+                    return 1;
+            }
+            // negative (reverse complemented) database strand
+            if (options.reverse && options.alphabet != "protein" && options.alphabet != "char")
+            {
+                reverseComplement(databases[i]);
+                if (!_stellarOnOne(databases[i], databaseIDs[i], swiftPattern, false, matches, options))
+                    return 1;
 
-            reverseComplement(databases[i]);
+                reverseComplement(databases[i]);
+            }
         }
     }
     std::cout << std::endl;
@@ -403,6 +560,10 @@ _writeSpecifiedParams(TOptions & options)
     {
         std::cout << "  q-gram abundance cut ratio       : " << options.qgramAbundanceCut << std::endl;
     }
+    if (options.threadCount != 1)
+    {
+        std::cout << "  number of threads                : " << options.threadCount << std::endl;
+    }
     std::cout << std::endl;
 }
 
@@ -469,6 +630,7 @@ _parseOptions(ArgumentParser & parser, TOptions & options)
     getOptionValue(options.qgramAbundanceCut, parser, "abundanceCut");
 
     getOptionValue(options.verbose, parser, "verbose");
+    getOptionValue(options.threadCount, parser, "threadCount");
 
     if (isSet(parser, "kmer") && options.qGram >= 1 / options.epsilon)
     {
@@ -527,6 +689,12 @@ void _setParser(ArgumentParser & parser)
                                      ArgParseArgument::STRING));
     setValidValues(parser, "a", "dna dna5 rna rna5 protein char");
     addOption(parser, ArgParseOption("v", "verbose", "Set verbosity mode."));
+    addOption(parser, ArgParseOption("tc", "threadCount",
+                                     "Number of threads. Short database sequences are distributed over the "
+                                     "threads, the SWIFT hits of long ones are verified concurrently.",
+                                     ArgParseArgument::INTEGER));
+    setDefaultValue(parser, "tc", "1");
+    setMinValue(parser, "tc", "1");
 
     addSection(parser, "Filtering Options");
 
@@ -737,6 +737,102 @@ SEQAN_CHECKPOINT
 	}
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Calls swift filter and verifies swift hits concurrently. = Computes eps-matches.
+//  The hits are filtered in batches of batchSize, every hit is verified by one of the
+//  threads into matches of its own, and these are inserted in the order of the hits.
+//  Thus the matches equal those of the sequential stellar().
+template<typename TText, typename TStringSetSpec, typename TIndexSpec, typename TSize, typename TDrop, typename TSize1,
+         typename TSource, typename TId, typename TTag>
+void _stellarParallelVerify(Finder<TText, Swift<SwiftLocal> > & finder,
+                            Pattern<Index<StringSet<TText, TStringSetSpec>, TIndexSpec>, Swift<SwiftLocal> > & pattern,
+                            double epsilon,
+                            TSize minLength,
+                            TDrop xDrop,
+                            TSize1 disableThresh,
+                            TSize1 & compactThresh,
+                            TSize1 numMatches,
+                            TId & databaseID,
+                            bool dbStrand,
+                            StringSet<QueryMatches<StellarMatch<TSource, TId> > > & matches,
+                            unsigned batchSize,
+                            TTag tag) {
+SEQAN_CHECKPOINT
+	typedef StellarMatch<TSource, TId> TMatch;
+	typedef typename GetSequenceByNo<StringSet<TText, TStringSetSpec> >::Type TPatternSeq;
+	typedef typename Infix<TText>::Type TInfix;
+	typedef typename Infix<TPatternSeq>::Type TPatternInfix;
+	typedef StellarSwiftHit_<TInfix, TPatternInfix> THit;
+
+	String<THit> hits;
+	String<QueryMatches<TMatch> > hitMatches;
+	reserve(hits, batchSize, Exact());
+
+	bool filtering = true;
+	while (filtering) {
+		// filter the next batch of swift hits
+		clear(hits);
+		while (length(hits) < batchSize && (filtering = find(finder, pattern, epsilon, minLength))) {
+			if (value(matches, pattern.curSeqNo).disabled) continue;
+
+			THit hit;
+			TInfix finderInfix = infix(finder);
+			TInfix finderInfixSeq = infix(haystack(finder), 0, length(haystack(finder)));
+			hit.finderSegment = Segment<TInfix, InfixSegment>(finderInfixSeq,
+				beginPosition(finderInfix) - beginPosition(haystack(finder)),
+				endPosition(finderInfix) - beginPosition(haystack(finder)));
+
+			TPatternSeq patternSeq = getSequenceByNo(pattern.curSeqNo, indexText(needle(pattern)));
+			TPatternInfix patternInfix = infix(pattern, patternSeq);
+			TPatternInfix patternInfixSeq = infix(patternSeq, 0, length(patternSeq));
+			hit.patternSegment = Segment<TPatternInfix, InfixSegment>(patternInfixSeq,
+				beginPosition(patternInfix) - beginPosition(patternSeq),
+				endPosition(patternInfix) - beginPosition(patternSeq));
+
+			hit.seqNo = pattern.curSeqNo;
+			appendValue(hits, hit);
+		}
+
+		// verification, the compaction threshold is only raised below
+		clear(hitMatches);
+		resize(hitMatches, length(hits));
+		TSize1 hitCompactThresh = compactThresh;
+		SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+		for (int i = 0; i < (int)length(hits); ++i) {
+			TSize1 localCompactThresh = hitCompactThresh;
+			verifySwiftHit(hits[i].finderSegment, hits[i].patternSegment, epsilon, minLength, xDrop,
+						   pattern.bucketParams[0].delta + pattern.bucketParams[0].overlap, disableThresh,
+						   localCompactThresh, numMatches, databaseID, dbStrand, hitMatches[i], tag);
+		}
+
+		// insert the eps-matches in the order of the hits
+		for (unsigned i = 0; i < length(hits); ++i) {
+			QueryMatches<TMatch> &qm = value(matches, hits[i].seqNo);
+			if (qm.disabled) continue;
+			if (hitMatches[i].disabled) {
+				qm.disabled = true;
+				clear(qm.matches);
+				continue;
+			}
+			for (unsigned j = 0; j < length(hitMatches[i].matches); ++j)
+				if (!_insertMatch(qm, hitMatches[i].matches[j], minLength, disableThresh, compactThresh, numMatches))
+					break;
+		}
+	}
+
+	typedef typename Iterator<StringSet<QueryMatches<TMatch> >, Standard>::Type TIterator;
+	TIterator it = begin(matches, Standard());
+	TIterator itEnd = end(matches, Standard());
+
+	for(; it < itEnd; ++it) {
+		QueryMatches<TMatch> &qm = *it;
+		if (length(qm) > 0 && !qm.disabled) {
+			maskOverlaps(qm.matches, minLength);	// remove overlaps and duplicates
+			compactMatches(qm.matches, numMatches);	// keep only the <numMatches> longest matches
+		}
+	}
+}
+
 // Wrapper for stellar
 template<typename TText, typename TIndex, typename TSize, typename TDrop,
          typename TSource, typename TId, typename TTag>
@@ -757,4 +853,46 @@ SEQAN_CHECKPOINT
 			matches, tag);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Appends the matches of one database sequence to the matches of all database sequences,
+//  removes overlapping matches if threshold is reached and disables queries with more
+//  than disableThresh matches.
+template<typename TSource, typename TId, typename TSize, typename TSize1>
+void
+_mergeQueryMatches(StringSet<QueryMatches<StellarMatch<TSource, TId> > > & matches,
+				   StringSet<QueryMatches<StellarMatch<TSource, TId> > > & localMatches,
+				   TSize minLength,
+				   TSize1 disableThresh,
+				   TSize1 & compactThresh,
+				   TSize1 numMatches) {
+SEQAN_CHECKPOINT
+	SEQAN_ASSERT_EQ(length(matches), length(localMatches));
+
+	for (unsigned i = 0; i < length(matches); ++i) {
+		QueryMatches<StellarMatch<TSource, TId> > & qm = matches[i];
+		QueryMatches<StellarMatch<TSource, TId> > & localQm = localMatches[i];
+		if (qm.disabled) continue;
+
+		if (localQm.disabled) {
+			qm.disabled = true;
+			clear(qm.matches);
+			continue;
+		}
+		append(qm.matches, localQm.matches);
+
+		if (length(qm.matches) > compactThresh) {
+			maskOverlaps(qm.matches, minLength);		// remove overlaps and duplicates
+			compactMatches(qm.matches, numMatches);		// keep only the <numMatches> longest matches
+
+			// raise compact threshold if many matches are kept
+			if ((length(qm.matches) << 1) > compactThresh)
+				compactThresh += (compactThresh >> 1);
+		}
+		if (length(qm.matches) > disableThresh) {
+			qm.disabled = true;
+			clear(qm.matches);
+		}
+	}
+}
+
 #endif
@@ -57,6 +57,7 @@ struct StellarOptions {
 	unsigned minRepeatLength;	// minimal length of low complexity repeats to be filtered
 	double qgramAbundanceCut;
 	bool verbose;				// verbose mode
+	unsigned threadCount;		// number of threads filtering and verifying database sequences, 1 for sequential mode
 
 
 	StellarOptions() {
@@ -81,6 +82,7 @@ struct StellarOptions {
 		minRepeatLength = 1000;
 		qgramAbundanceCut = 1;
 		verbose = false;
+		threadCount = 1;
 	}
 }; 
 
@@ -100,6 +102,15 @@ struct QueryMatches {
 	}
 };
 
+///////////////////////////////////////////////////////////////////////////////
+// A swift hit, i.e. a database and a query segment, that is verified by one of several threads
+template<typename TInfix_, typename TPatternInfix_>
+struct StellarSwiftHit_ {
+	Segment<TInfix_, InfixSegment> finderSegment;
+	Segment<TPatternInfix_, InfixSegment> patternSegment;
+	unsigned seqNo;				// query number
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // Container for storing a local alignment match
 template<typename TSequence_, typename TId_>
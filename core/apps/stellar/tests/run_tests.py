@@ -198,6 +198,20 @@ def main(source_base, binary_base):
                   transforms)])
     conf_list.append(conf)
 
+    # Multiple threads, the SWIFT hits of the database sequence are verified concurrently:
+    conf = app_tests.TestConf(
+        program=path_to_program,
+        redir_stdout=ph.outFile('e-1_tc4.stdout'),
+        args=['-e', '0.1', '-l', '50', '-x', '10', '-k', '7', '-n', '5000',
+              '-s', '10000', '-f', '-v', '-t', '-tc', '4',
+              '-o', ph.outFile('e-1_tc4.gff'),
+              ph.inFile('512_simSeq1_e-1.fa'),
+              ph.inFile('512_simSeq2_e-1.fa')],
+        to_diff=[(ph.inFile('e-1.gff'),
+                  ph.outFile('e-1_tc4.gff'),
+                  transforms)])
+    conf_list.append(conf)
+
     # ============================================================
     # Execute the tests.
     # ============================================================
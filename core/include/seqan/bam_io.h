@@ -70,6 +70,7 @@
 #if SEQAN_HAS_ZLIB
 #include <seqan/bam_io/read_bam.h>
 #include <seqan/bam_io/write_bam.h>
+#include <seqan/bam_io/bam_alignment_record_view.h>
 #endif  // #if SEQAN_HAS_ZLIB
 
 // ===========================================================================
@@ -103,6 +104,7 @@
 #include <seqan/bam_io/bam_writer.h>
 #endif  // #if SEQAN_HAS_ZLIB
 #include <seqan/bam_io/sam_writer.h>
+#include <seqan/bam_io/xam_writer_async.h>
 
 #include <seqan/bam_io/bam_stream.h>
 
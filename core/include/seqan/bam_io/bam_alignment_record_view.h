@@ -0,0 +1,808 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Lazy, non-owning views on BAM records that are read into a shared buffer
+// with one copy per record.
+// ==========================================================================
+
+#ifndef CORE_INCLUDE_SEQAN_BAM_IO_BAM_ALIGNMENT_RECORD_VIEW_H_
+#define CORE_INCLUDE_SEQAN_BAM_IO_BAM_ALIGNMENT_RECORD_VIEW_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class BamAlignmentRecordView
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class BamAlignmentRecordView
+ * @headerfile <seqan/bam_io.h>
+ * @brief Non-owning view on the raw data of a BAM alignment record.
+ *
+ * @signature class BamAlignmentRecordView;
+ *
+ * The fixed-size fields are read directly from the raw record data.  The variable-length fields (query name,
+ * CIGAR string, sequence, qualities and tags) are only decoded when they are accessed.  Views are filled by
+ * @link BamRecordViewBatch#readBatch @endlink and are valid until the batch is read into again.
+ *
+ * The reference id is translated into the global reference id of the BamIOContext while reading, as in
+ * @link SamBamIO#readRecord @endlink.
+ */
+
+/**
+.Class.BamAlignmentRecordView
+..cat:BAM I/O
+..summary:Non-owning view on the raw data of a BAM alignment record.
+..signature:BamAlignmentRecordView
+..remarks:The fixed-size fields are read directly from the raw record data.
+The variable-length fields (query name, CIGAR string, sequence, qualities and tags) are only decoded when they are accessed.
+Views are filled by @Function.BamRecordViewBatch#readBatch@ and are valid until the batch is read into again.
+..include:seqan/bam_io.h
+*/
+
+class BamAlignmentRecordView
+{
+public:
+    // Raw record data behind the block_size field.
+    char const * _data;
+    __uint32 _size;
+
+    BamAlignmentRecordView() : _data(0), _size(0)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Class BamRecordViewBatch
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class BamRecordViewBatch
+ * @headerfile <seqan/bam_io.h>
+ * @brief A batch of @link BamAlignmentRecordView @endlink objects with the buffer they point into.
+ *
+ * @signature class BamRecordViewBatch;
+ *
+ * The buffer is reused by subsequent calls to @link BamRecordViewBatch#readBatch @endlink, so scanning a file
+ * does not allocate memory once the buffer is large enough for one batch.
+ *
+ * @var String<BamAlignmentRecordView> BamRecordViewBatch::views;
+ * @brief The views on the records of the batch.
+ */
+
+/**
+.Class.BamRecordViewBatch
+..cat:BAM I/O
+..summary:A batch of @Class.BamAlignmentRecordView@ objects with the buffer they point into.
+..signature:BamRecordViewBatch
+..remarks:The buffer is reused by subsequent calls to @Function.BamRecordViewBatch#readBatch@, so scanning a file does not allocate memory once the buffer is large enough for one batch.
+..include:seqan/bam_io.h
+
+.Memvar.BamRecordViewBatch#views
+..class:Class.BamRecordViewBatch
+..summary:The views on the records of the batch.
+..type:Class.String
+*/
+
+class BamRecordViewBatch
+{
+public:
+    String<BamAlignmentRecordView> views;
+
+    // The raw records without their block_size, stored back to back.
+    CharString _buffer;
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Helper Function _bamViewValue()
+// ----------------------------------------------------------------------------
+
+// The raw record may not be aligned, so fields are read using memcpy().
+
+template <typename TValue>
+inline TValue
+_bamViewValue(BamAlignmentRecordView const & view, unsigned offset)
+{
+    TValue result;
+    memcpy(&result, view._data + offset, sizeof(TValue));
+    return result;
+}
+
+// Offsets of the variable-length fields.
+
+inline unsigned
+_bamViewCigarOffset(BamAlignmentRecordView const & view)
+{
+    return 32 + (_bamViewValue<__uint32>(view, 8) & 0xff);
+}
+
+inline unsigned
+_bamViewSeqOffset(BamAlignmentRecordView const & view)
+{
+    return _bamViewCigarOffset(view) + 4 * (_bamViewValue<__uint32>(view, 12) & 0xffff);
+}
+
+inline unsigned
+_bamViewQualOffset(BamAlignmentRecordView const & view)
+{
+    return _bamViewSeqOffset(view) + (_bamViewValue<__int32>(view, 16) + 1) / 2;
+}
+
+inline unsigned
+_bamViewTagsOffset(BamAlignmentRecordView const & view)
+{
+    return _bamViewQualOffset(view) + _bamViewValue<__int32>(view, 16);
+}
+
+// ----------------------------------------------------------------------------
+// Function getRID(), getBeginPos(), ...
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamAlignmentRecordView#getRID
+ * @brief Return the reference id of the record.
+ *
+ * @signature __int32 getRID(view);
+ *
+ * @fn BamAlignmentRecordView#getBeginPos
+ * @brief Return the 0-based begin position of the record.
+ *
+ * @signature __int32 getBeginPos(view);
+ *
+ * @fn BamAlignmentRecordView#getMapQ
+ * @brief Return the mapping quality of the record.
+ *
+ * @signature __uint8 getMapQ(view);
+ *
+ * @fn BamAlignmentRecordView#getBin
+ * @brief Return the BAI bin of the record.
+ *
+ * @signature __uint16 getBin(view);
+ *
+ * @fn BamAlignmentRecordView#getFlag
+ * @brief Return the flag of the record.
+ *
+ * @signature __uint16 getFlag(view);
+ *
+ * @fn BamAlignmentRecordView#getRNextId
+ * @brief Return the reference id of the next fragment.
+ *
+ * @signature __int32 getRNextId(view);
+ *
+ * @fn BamAlignmentRecordView#getPNext
+ * @brief Return the 0-based position of the next fragment.
+ *
+ * @signature __int32 getPNext(view);
+ *
+ * @fn BamAlignmentRecordView#getTLen
+ * @brief Return the template length.
+ *
+ * @signature __int32 getTLen(view);
+ *
+ * @fn BamAlignmentRecordView#getSeqLength
+ * @brief Return the length of the read sequence.
+ *
+ * @signature __int32 getSeqLength(view);
+ */
+
+/**
+.Function.BamAlignmentRecordView#getRID
+..class:Class.BamAlignmentRecordView
+..cat:BAM I/O
+..signature:getRID(view)
+..summary:Return the reference id of the record.
+..param.view:The view to query.
+...type:Class.BamAlignmentRecordView
+..returns:$__int32$, the reference id.
+..include:seqan/bam_io.h
+
+.Function.BamAlignmentRecordView#getBeginPos
+..class:Class.BamAlignmentRecordView
+..cat:BAM I/O
+..signature:getBeginPos(view)
+..summary:Return the 0-based begin position of the record.
+..param.view:The view to query.
+...type:Class.BamAlignmentRecordView
+..returns:$__int32$, the begin position.
+..include:seqan/bam_io.h
+
+.Function.BamAlignmentRecordView#getMapQ
+..class:Class.BamAlignmentRecordView
+..cat:BAM I/O
+..signature:getMapQ(view)
+..summary:Return the mapping quality of the record.
+..param.view:The view to query.
+...type:Class.BamAlignmentRecordView
+..returns:$__uint8$, the mapping quality.
+..include:seqan/bam_io.h
+
+.Function.BamAlignmentRecordView#getBin
+..class:Class.BamAlignmentRecordView
+..cat:BAM I/O
+..signature:getBin(view)
+..summary:Return the BAI bin of the record.
+..param.view:The view to query.
+...type:Class.BamAlignmentRecordView
+..returns:$__uint16$, the bin.
+..include:seqan/bam_io.h
+
+.Function.BamAlignmentRecordView#getFlag
+..class:Class.BamAlignmentRecordView
+..cat:BAM I/O
+..signature:getFlag(view)
+..summary:Return the flag of the record.
+..param.view:The view to query.
+...type:Class.BamAlignmentRecordView
+..returns:$__uint16$, the flag.
+..include:seqan/bam_io.h
+
+.Function.BamAlignmentRecordView#getRNextId
+..class:Class.BamAlignmentRecordView
+..cat:BAM I/O
+..signature:getRNextId(view)
+..summary:Return the reference id of the next fragment.
+..param.view:The view to query.
+...type:Class.BamAlignmentRecordView
+..returns:$__int32$, the reference id of the next fragment.
+..include:seqan/bam_io.h
+
+.Function.BamAlignmentRecordView#getPNext
+..class:Class.BamAlignmentRecordView
+..cat:BAM I/O
+..signature:getPNext(view)
+..summary:Return the 0-based position of the next fragment.
+..param.view:The view to query.
+...type:Class.BamAlignmentRecordView
+..returns:$__int32$, the position of the next fragment.
+..include:seqan/bam_io.h
+
+.Function.BamAlignmentRecordView#getTLen
+..class:Class.BamAlignmentRecordView
+..cat:BAM I/O
+..signature:getTLen(view)
+..summary:Return the template length.
+..param.view:The view to query.
+...type:Class.BamAlignmentRecordView
+..returns:$__int32$, the template length.
+..include:seqan/bam_io.h
+
+.Function.BamAlignmentRecordView#getSeqLength
+..class:Class.BamAlignmentRecordView
+..cat:BAM I/O
+..signature:getSeqLength(view)
+..summary:Return the length of the read sequence.
+..param.view:The view to query.
+...type:Class.BamAlignmentRecordView
+..returns:$__int32$, the sequence length.
+..include:seqan/bam_io.h
+*/
+
+inline __int32
+getRID(BamAlignmentRecordView const & view)
+{
+    return _bamViewValue<__int32>(view, 0);
+}
+
+inline __int32
+getBeginPos(BamAlignmentRecordView const & view)
+{
+    return _bamViewValue<__int32>(view, 4);
+}
+
+inline __uint8
+getMapQ(BamAlignmentRecordView const & view)
+{
+    return (_bamViewValue<__uint32>(view, 8) >> 8) & 0xff;
+}
+
+inline __uint16
+getBin(BamAlignmentRecordView const & view)
+{
+    return _bamViewValue<__uint32>(view, 8) >> 16;
+}
+
+inline __uint16
+getFlag(BamAlignmentRecordView const & view)
+{
+    return _bamViewValue<__uint32>(view, 12) >> 16;
+}
+
+inline __int32
+getRNextId(BamAlignmentRecordView const & view)
+{
+    return _bamViewValue<__int32>(view, 20);
+}
+
+inline __int32
+getPNext(BamAlignmentRecordView const & view)
+{
+    return _bamViewValue<__int32>(view, 24);
+}
+
+inline __int32
+getTLen(BamAlignmentRecordView const & view)
+{
+    return _bamViewValue<__int32>(view, 28);
+}
+
+inline __int32
+getSeqLength(BamAlignmentRecordView const & view)
+{
+    return _bamViewValue<__int32>(view, 16);
+}
+
+// ----------------------------------------------------------------------------
+// Function hasFlagUnmapped(), hasFlagSecondary(), ...
+// ----------------------------------------------------------------------------
+
+/**
+.Function.hasFlagUnmapped
+..signature:hasFlagUnmapped(view)
+..param.view.type:Class.BamAlignmentRecordView
+
+.Function.hasFlagSecondary
+..signature:hasFlagSecondary(view)
+..param.view.type:Class.BamAlignmentRecordView
+
+.Function.hasFlagQCNoPass
+..signature:hasFlagQCNoPass(view)
+..param.view.type:Class.BamAlignmentRecordView
+
+.Function.hasFlagDuplicate
+..signature:hasFlagDuplicate(view)
+..param.view.type:Class.BamAlignmentRecordView
+*/
+
+inline bool
+hasFlagUnmapped(BamAlignmentRecordView const & view)
+{
+    return (getFlag(view) & BAM_FLAG_UNMAPPED) == BAM_FLAG_UNMAPPED;
+}
+
+inline bool
+hasFlagSecondary(BamAlignmentRecordView const & view)
+{
+    return (getFlag(view) & BAM_FLAG_SECONDARY) == BAM_FLAG_SECONDARY;
+}
+
+inline bool
+hasFlagQCNoPass(BamAlignmentRecordView const & view)
+{
+    return (getFlag(view) & BAM_FLAG_QC_NO_PASS) == BAM_FLAG_QC_NO_PASS;
+}
+
+inline bool
+hasFlagDuplicate(BamAlignmentRecordView const & view)
+{
+    return (getFlag(view) & BAM_FLAG_DUPLICATE) == BAM_FLAG_DUPLICATE;
+}
+
+// ----------------------------------------------------------------------------
+// Function getQName()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamAlignmentRecordView#getQName
+ * @brief Copy the query name of the record.
+ *
+ * @signature void getQName(qName, view);
+ *
+ * @param[out] qName The @link CharString @endlink to copy the query name into.
+ * @param[in]  view  The BamAlignmentRecordView to query.
+ */
+
+/**
+.Function.BamAlignmentRecordView#getQName
+..class:Class.BamAlignmentRecordView
+..cat:BAM I/O
+..signature:getQName(qName, view)
+..summary:Copy the query name of the record.
+..param.qName:The string to copy the query name into.
+...type:Shortcut.CharString
+..param.view:The view to query.
+...type:Class.BamAlignmentRecordView
+..include:seqan/bam_io.h
+*/
+
+template <typename TSpec>
+inline void
+getQName(String<char, TSpec> & qName, BamAlignmentRecordView const & view)
+{
+    unsigned lReadName = _bamViewValue<__uint32>(view, 8) & 0xff;
+    resize(qName, (lReadName > 0u) ? lReadName - 1 : 0, Exact());
+    if (!empty(qName))
+        memcpy(&front(qName), view._data + 32, length(qName));
+}
+
+// ----------------------------------------------------------------------------
+// Function getCigar()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamAlignmentRecordView#getCigar
+ * @brief Decode the CIGAR string of the record.
+ *
+ * @signature void getCigar(cigar, view);
+ *
+ * @param[out] cigar The <tt>String&lt;CigarElement&lt;&gt; &gt;</tt> to decode into.
+ * @param[in]  view  The BamAlignmentRecordView to query.
+ */
+
+/**
+.Function.BamAlignmentRecordView#getCigar
+..class:Class.BamAlignmentRecordView
+..cat:BAM I/O
+..signature:getCigar(cigar, view)
+..summary:Decode the CIGAR string of the record.
+..param.cigar:The string to decode into.
+...type:Class.String
+...remarks:A String of @Class.CigarElement@ objects.
+..param.view:The view to query.
+...type:Class.BamAlignmentRecordView
+..include:seqan/bam_io.h
+*/
+
+template <typename TCigarSpec, typename TSpec>
+inline void
+getCigar(String<CigarElement<TCigarSpec>, TSpec> & cigar, BamAlignmentRecordView const & view)
+{
+    static char const * CIGAR_MAPPING = "MIDNSHP=";
+
+    unsigned nCigarOp = _bamViewValue<__uint32>(view, 12) & 0xffff;
+    unsigned offset = _bamViewCigarOffset(view);
+    resize(cigar, nCigarOp, Exact());
+    for (unsigned i = 0; i < nCigarOp; ++i, offset += 4)
+    {
+        __uint32 ui = _bamViewValue<__uint32>(view, offset);
+        cigar[i].operation = CIGAR_MAPPING[ui & 0x0007];
+        cigar[i].count = ui >> 4;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function getAlignmentLengthInRef()
+// ----------------------------------------------------------------------------
+
+/**
+.Function.getAlignmentLengthInRef
+..signature:getAlignmentLengthInRef(view)
+..param.view.type:Class.BamAlignmentRecordView
+*/
+
+inline unsigned
+getAlignmentLengthInRef(BamAlignmentRecordView const & view)
+{
+    // As for BamAlignmentRecord, all operations but I, S, and H count.  The operation codes are 1, 4, and 5.
+    unsigned nCigarOp = _bamViewValue<__uint32>(view, 12) & 0xffff;
+    unsigned offset = _bamViewCigarOffset(view);
+    unsigned l = 0;
+    for (unsigned i = 0; i < nCigarOp; ++i, offset += 4)
+    {
+        __uint32 ui = _bamViewValue<__uint32>(view, offset);
+        if (!((0x32u >> (ui & 0x7)) & 1u))
+            l += ui >> 4;
+    }
+    return l;
+}
+
+// ----------------------------------------------------------------------------
+// Function getSeq()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamAlignmentRecordView#getSeq
+ * @brief Decode the read sequence of the record.
+ *
+ * @signature void getSeq(seq, view);
+ *
+ * @param[out] seq  The @link CharString @endlink to decode into.
+ * @param[in]  view The BamAlignmentRecordView to query.
+ */
+
+/**
+.Function.BamAlignmentRecordView#getSeq
+..class:Class.BamAlignmentRecordView
+..cat:BAM I/O
+..signature:getSeq(seq, view)
+..summary:Decode the read sequence of the record.
+..param.seq:The string to decode into.
+...type:Shortcut.CharString
+..param.view:The view to query.
+...type:Class.BamAlignmentRecordView
+..include:seqan/bam_io.h
+*/
+
+template <typename TSpec>
+inline void
+getSeq(String<char, TSpec> & seq, BamAlignmentRecordView const & view)
+{
+    static char const * SEQ_MAPPING = "=ACMGRSVTWYHKDBN";
+
+    __int32 lSeq = getSeqLength(view);
+    unsigned char const * ptr = reinterpret_cast<unsigned char const *>(view._data + _bamViewSeqOffset(view));
+    resize(seq, lSeq, Exact());
+    for (__int32 i = 0; i + 1 < lSeq; i += 2, ++ptr)
+    {
+        seq[i] = SEQ_MAPPING[*ptr >> 4];
+        seq[i + 1] = SEQ_MAPPING[*ptr & 0x0f];
+    }
+    if (lSeq & 1)
+        seq[lSeq - 1] = SEQ_MAPPING[*ptr >> 4];
+}
+
+// ----------------------------------------------------------------------------
+// Function getQual()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamAlignmentRecordView#getQual
+ * @brief Decode the PHRED qualities of the record.
+ *
+ * @signature void getQual(qual, view);
+ *
+ * @param[out] qual The @link CharString @endlink to decode into, empty if the qualities are missing.
+ * @param[in]  view The BamAlignmentRecordView to query.
+ */
+
+/**
+.Function.BamAlignmentRecordView#getQual
+..class:Class.BamAlignmentRecordView
+..cat:BAM I/O
+..signature:getQual(qual, view)
+..summary:Decode the PHRED qualities of the record.
+..param.qual:The string to decode into, empty if the qualities are missing.
+...type:Shortcut.CharString
+..param.view:The view to query.
+...type:Class.BamAlignmentRecordView
+..include:seqan/bam_io.h
+*/
+
+template <typename TSpec>
+inline void
+getQual(String<char, TSpec> & qual, BamAlignmentRecordView const & view)
+{
+    __int32 lSeq = getSeqLength(view);
+    char const * ptr = view._data + _bamViewQualOffset(view);
+    // Missing qualities are stored as 0xff (same heuristic as samtools: only look at the first byte).
+    if (lSeq == 0 || *ptr == '\xFF')
+    {
+        clear(qual);
+        return;
+    }
+    resize(qual, lSeq, Exact());
+    for (__int32 i = 0; i < lSeq; ++i)
+        qual[i] = ptr[i] + '!';
+}
+
+// ----------------------------------------------------------------------------
+// Function getTags()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamAlignmentRecordView#getTags
+ * @brief Copy the raw BAM tags of the record.
+ *
+ * @signature void getTags(tags, view);
+ *
+ * @param[out] tags The @link CharString @endlink to copy the tags into, can be used to construct a
+ *                  @link BamTagsDict @endlink.
+ * @param[in]  view The BamAlignmentRecordView to query.
+ */
+
+/**
+.Function.BamAlignmentRecordView#getTags
+..class:Class.BamAlignmentRecordView
+..cat:BAM I/O
+..signature:getTags(tags, view)
+..summary:Copy the raw BAM tags of the record.
+..param.tags:The string to copy the tags into, can be used to construct a @Class.BamTagsDict@.
+...type:Shortcut.CharString
+..param.view:The view to query.
+...type:Class.BamAlignmentRecordView
+..include:seqan/bam_io.h
+*/
+
+template <typename TSpec>
+inline void
+getTags(String<char, TSpec> & tags, BamAlignmentRecordView const & view)
+{
+    unsigned offset = _bamViewTagsOffset(view);
+    resize(tags, view._size - offset, Exact());
+    if (!empty(tags))
+        memcpy(&front(tags), view._data + offset, length(tags));
+}
+
+// ----------------------------------------------------------------------------
+// Function decodeRecord()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamAlignmentRecordView#decodeRecord
+ * @brief Decode all fields of the record into a @link BamAlignmentRecord @endlink.
+ *
+ * @signature void decodeRecord(record, view);
+ *
+ * @param[out] record The BamAlignmentRecord to decode into.
+ * @param[in]  view   The BamAlignmentRecordView to decode.
+ */
+
+/**
+.Function.BamAlignmentRecordView#decodeRecord
+..class:Class.BamAlignmentRecordView
+..cat:BAM I/O
+..signature:decodeRecord(record, view)
+..summary:Decode all fields of the record into a @Class.BamAlignmentRecord@.
+..param.record:The record to decode into.
+...type:Class.BamAlignmentRecord
+..param.view:The view to decode.
+...type:Class.BamAlignmentRecordView
+..include:seqan/bam_io.h
+*/
+
+inline void
+decodeRecord(BamAlignmentRecord & record, BamAlignmentRecordView const & view)
+{
+    record.rID = getRID(view);
+    record.beginPos = getBeginPos(view);
+    record.mapQ = getMapQ(view);
+    record.bin = getBin(view);
+    record.flag = getFlag(view);
+    record.rNextId = getRNextId(view);
+    record.pNext = getPNext(view);
+    record.tLen = getTLen(view);
+    getQName(record.qName, view);
+    getCigar(record.cigar, view);
+    getSeq(record.seq, view);
+    getQual(record.qual, view);
+    getTags(record.tags, view);
+}
+
+// ----------------------------------------------------------------------------
+// Function readBatch()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamRecordViewBatch#readBatch
+ * @brief Read a batch of BAM records into views.
+ *
+ * @signature int readBatch(batch, context, stream, maxRecords, tag);
+ *
+ * @param[out]    batch      The BamRecordViewBatch to read into.  Previous views are invalidated.
+ * @param[in,out] context    The BamIOContext to use.
+ * @param[in,out] stream     The @link StreamConcept Stream @endlink to read from, positioned behind the header.
+ * @param[in]     maxRecords The maximal number of records to read, <tt>unsigned</tt>.
+ * @param[in]     tag        The format tag, <tt>Bam</tt>.
+ *
+ * @return int A status code, 0 on success, != 0 on failure.
+ *
+ * @section Remarks
+ *
+ * Each record is copied from the stream into the batch buffer with one @link StreamConcept#streamReadBlock
+ * @endlink call, nothing else is decoded.  Fewer than <tt>maxRecords</tt> records are read at the end of the
+ * stream.
+ */
+
+/**
+.Function.BamRecordViewBatch#readBatch
+..class:Class.BamRecordViewBatch
+..cat:BAM I/O
+..signature:readBatch(batch, context, stream, maxRecords, tag)
+..summary:Read a batch of BAM records into views.
+..param.batch:The batch to read into.  Previous views are invalidated.
+...type:Class.BamRecordViewBatch
+..param.context:The context to use for reading.
+...type:Class.BamIOContext
+..param.stream:The stream to read from, positioned behind the header.
+...type:Concept.StreamConcept
+..param.maxRecords:The maximal number of records to read.
+...type:nolink:$unsigned$
+..param.tag:The format tag.
+...type:Tag.Bam
+..returns:$int$, 0 on success, != 0 on failure.
+..remarks:Each record is copied from the stream into the batch buffer with one @Function.streamReadBlock@ call, nothing else is decoded.
+Fewer than $maxRecords$ records are read at the end of the stream.
+..include:seqan/bam_io.h
+*/
+
+template <typename TStream, typename TNameStore, typename TNameStoreCache>
+int readBatch(BamRecordViewBatch & batch,
+              BamIOContext<TNameStore, TNameStoreCache> & context,
+              TStream & stream,
+              unsigned maxRecords,
+              Bam const & /*tag*/)
+{
+    clear(batch.views);
+    clear(batch._buffer);
+
+    // The views only get their pointers at the end since the buffer might be reallocated while reading.
+    for (unsigned i = 0; i < maxRecords && !atEnd(stream); ++i)
+    {
+        __int32 blockSize = 0;
+        if (streamReadBlock(reinterpret_cast<char *>(&blockSize), stream, 4) != 4)
+            return 1;  // Error reading the block size.
+        if (blockSize < 32)
+            return 1;  // Record too short for the fixed-size fields.
+
+        unsigned offset = length(batch._buffer);
+        resize(batch._buffer, offset + blockSize, Generous());
+        if (streamReadBlock(&batch._buffer[offset], stream, blockSize) != blockSize)
+            return 1;  // Error reading the record.
+
+        BamAlignmentRecordView view;
+        view._data = &batch._buffer[offset];
+        view._size = blockSize;
+
+        // Check that the variable-length fields fit into the record, so the lazy accessors stay in bounds.
+        __int64 lSeq = getSeqLength(view);
+        __int64 fieldsSize = _bamViewCigarOffset(view) + 4 * (_bamViewValue<__uint32>(view, 12) & 0xffff);
+        if (lSeq < 0 || fieldsSize + (lSeq + 1) / 2 + lSeq > blockSize)
+            return 1;
+
+        // Translate file local rID into a global rID that is compatible with the context nameStore.
+        __int32 rID = getRID(view);
+        if (rID >= 0 && !empty(context.translateFile2GlobalRefId))
+        {
+            rID = context.translateFile2GlobalRefId[rID];
+            memcpy(&batch._buffer[offset], &rID, 4);
+        }
+
+        appendValue(batch.views, view);
+    }
+
+    // The records are stored back to back in the buffer.
+    char const * ptr = begin(batch._buffer, Standard());
+    for (unsigned i = 0; i < length(batch.views); ++i)
+    {
+        batch.views[i]._data = ptr;
+        ptr += batch.views[i]._size;
+    }
+
+    return 0;
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef CORE_INCLUDE_SEQAN_BAM_IO_BAM_ALIGNMENT_RECORD_VIEW_H_
@@ -147,6 +147,63 @@ public:
     {}
 };
 
+// ----------------------------------------------------------------------------
+// Class BamRegionChunk
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class BamRegionChunk
+ * @headerfile <seqan/bam_io.h>
+ * @brief A half-open region <tt>[beginPos, endPos)</tt> on the reference <tt>rID</tt>.
+ *
+ * @signature struct BamRegionChunk;
+ *
+ * @var __int32 BamRegionChunk::rID;
+ * @brief The reference id.
+ *
+ * @var __int32 BamRegionChunk::beginPos;
+ * @brief The zero-based begin position.
+ *
+ * @var __int32 BamRegionChunk::endPos;
+ * @brief The zero-based end position (exclusive).
+ */
+
+/**
+.Class.BamRegionChunk
+..cat:BAM I/O
+..summary:A half-open region $[beginPos, endPos)$ on reference $rID$, as computed by @Function.BamIndex#computeRegionChunks@.
+..signature:BamRegionChunk
+..include:seqan/bam_io.h
+
+.Memvar.BamRegionChunk#rID
+..class:Class.BamRegionChunk
+..summary:The reference id.
+..type:nolink:$__int32$
+
+.Memvar.BamRegionChunk#beginPos
+..class:Class.BamRegionChunk
+..summary:The zero-based begin position.
+..type:nolink:$__int32$
+
+.Memvar.BamRegionChunk#endPos
+..class:Class.BamRegionChunk
+..summary:The zero-based end position (exclusive).
+..type:nolink:$__int32$
+*/
+
+struct BamRegionChunk
+{
+    __int32 rID;
+    __int32 beginPos;
+    __int32 endPos;
+
+    BamRegionChunk() : rID(BamAlignmentRecord::INVALID_REFID), beginPos(0), endPos(0)
+    {}
+
+    BamRegionChunk(__int32 rID, __int32 beginPos, __int32 endPos) : rID(rID), beginPos(beginPos), endPos(endPos)
+    {}
+};
+
 // ============================================================================
 // Metafunctions
 // ============================================================================
@@ -543,29 +600,41 @@ read(BamIndex<Bai> & index, char * filename)
 }
 
 // ----------------------------------------------------------------------------
-// Function buildIndex()
+// Function write()
 // ----------------------------------------------------------------------------
 
-/*DISABLED
-.Function.BamIndex#buildIndex
+/*!
+ * @fn BamIndex#write
+ * @brief Write a BAM index to a file.
+ *
+ * @signature int write(index, filename);
+ *
+ * @param[in] index    The BamIndex to write.
+ * @param[in] filename Path to the file to write to, <tt>char const *</tt>.
+ *
+ * @return int Status code, 0 indicating success.
+ */
+
+/**
+.Function.BamIndex#write
 ..class:Class.BamIndex
 ..cat:BAM I/O
-..signature:buildIndex(index, filename)
-..summary:Build index for BAM file with given filename.
-..remarks:This will create an index file named $filename + ".bai"$.
-..param.index:Target data structure.
+..signature:write(index, filename)
+..summary:Write a BAM index to a file with the given file name.
+..param.index:The index to write.
 ...type:Class.BamIndex
-..param.filename:Path to BAM file to load.
+..param.filename:Path to the file to write.
 ...type:nolink:$char const *$
-..returns:$bool$ indicating success.
+..returns:$int$ status code, $0$ indicating success.
 ..include:seqan/bam_io.h
  */
 
 inline int _writeIndex(BamIndex<Bai> const & index, char const * filename)
 {
-    std::cerr << "WRITE INDEX TO " << filename << std::endl;
     // Open output stream.
     std::ofstream out(filename, std::ios::binary | std::ios::out);
+    if (!out.good())
+        return 1;  // Could not open file.
 
     SEQAN_ASSERT_EQ(length(index._binIndices), length(index._linearIndices));
 
@@ -604,7 +673,7 @@ inline int _writeIndex(BamIndex<Bai> const & index, char const * filename)
         }
 
         // Write out linear index.
-        __int32 numIntervals = length(index._linearIndices);
+        __int32 numIntervals = length(linearIndex);
         out.write(reinterpret_cast<char *>(&numIntervals), 4);
         typedef Iterator<String<__uint64> const, Rooted>::Type TLinearIndexIter;
         for (TLinearIndexIter it = begin(linearIndex, Rooted()); !atEnd(it); goNext(it))
@@ -612,49 +681,140 @@ inline int _writeIndex(BamIndex<Bai> const & index, char const * filename)
     }
 
     // Write the number of unaligned reads if set.
-    std::cerr << "UNALIGNED\t" << index._unalignedCount << std::endl;
     if (index._unalignedCount != maxValue<__uint64>())
         out.write(reinterpret_cast<char const *>(&index._unalignedCount), 8);
 
     return !out.good();  // 1 on error, 0 on success.
 }
 
-inline void _baiAddAlignmentChunkToBin(BamIndex<Bai> & index,
-                                       __uint32 currBin,
-                                       __uint32 currOffset,
-                                       __uint64 prevOffset)
+inline int
+write(BamIndex<Bai> const & index, char const * filename)
 {
-    // If this is not the first reference sequence then add previous reference data.
-    Pair<__uint64> newChunk(currOffset, prevOffset);
+    return _writeIndex(index, filename);
+}
 
-    // If no interest exists yet for this bin, create one and store alignment chunk.
-    BamIndex<Bai>::TBinIndex_::iterator binIter = back(index._binIndices).find(currBin);
-    if (binIter == back(index._binIndices).end())
-    {
-        BaiBamIndexBinData_ binData;
-        appendValue(binData.chunkBegEnds, newChunk);
-        back(index._binIndices).insert(std::make_pair(currBin, binData));
-    }
-    else
-    {
-        // Otherwise, just append alignment chunk.
-        appendValue(binIter->second.chunkBegEnds, newChunk);
-    }
+// The non-const overloads are only here because of the generic write() functions in the file module.
+
+inline int
+write(BamIndex<Bai> & index, char const * filename)
+{
+    return _writeIndex(index, filename);
+}
+
+inline int
+write(BamIndex<Bai> & index, char * filename)
+{
+    return _writeIndex(index, filename);
+}
+
+// ----------------------------------------------------------------------------
+// Function buildIndex()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamIndex#buildIndex
+ * @brief Build a BAI index for a coordinate-sorted BAM file.
+ *
+ * @signature bool buildIndex(index, filename[, numThreads]);
+ *
+ * @param[out] index      The BamIndex to build.
+ * @param[in]  filename   Path to the BAM file, <tt>char const *</tt>.
+ * @param[in]  numThreads Number of threads used for decompressing the BGZF blocks ahead of the scan, defaults to
+ *                        the maximal number of OpenMP threads.
+ *
+ * @return bool <tt>true</tt> on success, <tt>false</tt> if the file could not be read or is not sorted by coordinate.
+ *
+ * @section Remarks
+ *
+ * The index is built in memory only, use @link BamIndex#write @endlink to store it in a <tt>.bai</tt> file.
+ */
+
+/**
+.Function.BamIndex#buildIndex
+..class:Class.BamIndex
+..cat:BAM I/O
+..signature:buildIndex(index, filename[, numThreads])
+..summary:Build index for BAM file with given filename.
+..remarks:The index is built in memory, use @Function.BamIndex#write@ to store it to a $.bai$ file.
+The BGZF blocks are decompressed by $numThreads$ threads ahead of the sequential scan.
+..param.index:Target data structure.
+...type:Class.BamIndex
+..param.filename:Path to BAM file to load.
+...type:nolink:$char const *$
+..param.numThreads:Number of decompression threads, defaults to the maximal number of OpenMP threads.
+...type:nolink:$unsigned$
+..returns:$bool$ indicating success.
+..include:seqan/bam_io.h
+ */
+
+inline void _baiAddAlignmentChunkToBin(BamIndex<Bai>::TBinIndex_ & binIndex,
+                                       __uint32 bin,
+                                       __uint64 chunkBegin,
+                                       __uint64 chunkEnd)
+{
+    // Creates the bin data if it does not exist yet and appends the chunk.
+    appendValue(binIndex[bin].chunkBegEnds, Pair<__uint64>(chunkBegin, chunkEnd));
+}
+
+// Record the offset of the alignment in all 16kb windows it overlaps that have no offset yet.
+
+inline void _baiAddAlignmentToLinearIndex(BamIndex<Bai>::TLinearIndex_ & linearIndex,
+                                          BamAlignmentRecord const & record,
+                                          __uint64 offset)
+{
+    __int32 endPos = record.beginPos + std::max(static_cast<__int32>(getAlignmentLengthInRef(record)), 1);
+    unsigned beginWindow = record.beginPos >> BamIndex<Bai>::BAM_LIDX_SHIFT;
+    unsigned endWindow = (endPos - 1) >> BamIndex<Bai>::BAM_LIDX_SHIFT;
+
+    if (length(linearIndex) <= endWindow)
+        resize(linearIndex, endWindow + 1, 0u);
+    for (unsigned i = beginWindow; i <= endWindow; ++i)
+        if (linearIndex[i] == 0u)
+            linearIndex[i] = offset;
+}
+
+// Merge adjacent chunks of a bin that start in the same BGZF block the previous chunk ends in.
+
+inline void _baiMergeChunks(BamIndex<Bai> & index)
+{
+    typedef BamIndex<Bai>::TBinIndex_::iterator TBinIndexIter;
+    typedef String<Pair<__uint64, __uint64> >   TChunks;
+
+    for (unsigned i = 0; i < length(index._binIndices); ++i)
+        for (TBinIndexIter it = index._binIndices[i].begin(); it != index._binIndices[i].end(); ++it)
+        {
+            if (it->first == 37450u)
+                continue;  // Skip pseudo-bin with meta data.
+
+            TChunks & chunks = it->second.chunkBegEnds;
+            if (empty(chunks))
+                continue;
+            unsigned last = 0;
+            for (unsigned j = 1; j < length(chunks); ++j)
+            {
+                if ((chunks[last].i2 >> 16) == (chunks[j].i1 >> 16))
+                    chunks[last].i2 = chunks[j].i2;
+                else
+                    chunks[++last] = chunks[j];
+            }
+            resize(chunks, last + 1);
+        }
 }
 
 inline bool
-buildIndex(BamIndex<Bai> & index, char const * filename)
+buildIndex(BamIndex<Bai> & index, char const * filename, unsigned numThreads)
 {
-    SEQAN_FAIL("This does not work ye!");
+    typedef BamIndex<Bai>::TBinIndex_ TBinIndex;
 
     index._unalignedCount = 0;
     clear(index._binIndices);
     clear(index._linearIndices);
 
-    // Open BAM file for reading.
+    // Open BAM file for reading, decompressing blocks ahead of the scan.
     Stream<Bgzf> bamStream;
     if (!open(bamStream, filename, "r"))
         return false;  // Could not open BAM file.
+    setNumThreads(bamStream, numThreads);
 
     // Initialize BamIOContext.
     typedef StringSet<CharString>      TNameStore;
@@ -670,16 +830,24 @@ buildIndex(BamIndex<Bai> & index, char const * filename)
     if (res != 0)
         return false;  // Could not read BAM header.
     __uint32 numRefSeqs = length(header.sequenceInfos);
+    resize(index._binIndices, numRefSeqs, TBinIndex());
+    resize(index._linearIndices, numRefSeqs);
 
     // Scan over BAM file and create index.
+    //
+    // The save* variables describe the currently open chunk, the last* variables the previous record.
     BamAlignmentRecord record;
-    __uint32 currBin    = maxValue<__uint32>();
-    __uint32 prevBin    = maxValue<__uint32>();
-    __int32 currRefId   = BamAlignmentRecord::INVALID_REFID;
-    __int32 prevRefId   = BamAlignmentRecord::INVALID_REFID;
-    __uint64 currOffset = streamTell(bamStream);
-    __uint64 prevOffset = currOffset;
-    __int32 prevPos     = minValue<__int32>();
+    __uint32 saveBin     = maxValue<__uint32>();
+    __uint32 lastBin     = maxValue<__uint32>();
+    __int32 saveRefId    = BamAlignmentRecord::INVALID_REFID;
+    __int32 lastRefId    = BamAlignmentRecord::INVALID_REFID;
+    __int32 lastPos      = minValue<__int32>();
+    __uint64 saveOffset  = streamTell(bamStream);
+    __uint64 lastOffset  = saveOffset;
+    __uint64 refBeginOffset = saveOffset;
+    __uint64 numMapped   = 0;
+    __uint64 numUnmapped = 0;
+    bool reachedUnplaced = false;
 
     while (!atEnd(bamStream))
     {
@@ -687,130 +855,338 @@ buildIndex(BamIndex<Bai> & index, char const * filename)
         res = readRecord(record, bamIOContext, bamStream, Bam());
         if (res != 0)
             return false;
+        if (record.rID >= static_cast<__int32>(numRefSeqs))
+            return false;  // Invalid reference id.
 
-        // Check ordering.
-        if (prevRefId == record.rID && prevPos > record.beginPos)
-            return false;
-
-        // The reference sequence changed, close bins for previous reference.
-        if (prevRefId != record.rID)
+        // Check ordering, unplaced records must come last.
+        if (record.rID != lastRefId)
         {
-            if (prevRefId != BamAlignmentRecord::INVALID_REFID)
-            {
-                _baiAddAlignmentChunkToBin(index, currBin, currOffset, prevOffset);
-
-                // Add an index for all empty references between prevRefId (excluded) and record.rID (included).
-                for (int i = prevRefId + 1; i < record.rID; ++i)
-                {
-                    BamIndex<Bai>::TBinIndex_ binIndex;
-                    appendValue(index._binIndices, binIndex);
-                    BamIndex<Bai>::TLinearIndex_ linearIndex;
-                    appendValue(index._linearIndices, linearIndex);
-                }
-
-                // Update bin book keeping.
-                currOffset = prevOffset;
-                currBin    = record.bin;
-                prevBin    = record.bin;
-                currRefId  = record.rID;
-            }
-            else
-            {
-                // Otherwise, this is the first pass.  Create an index for all empty references up to and including
-                // current refId.
-                for (int i = 0; i < record.rID; ++i)
-                {
-                    BamIndex<Bai>::TBinIndex_ binIndex;
-                    appendValue(index._binIndices, binIndex);
-                    BamIndex<Bai>::TLinearIndex_ linearIndex;
-                    appendValue(index._linearIndices, linearIndex);
-                }
-            }
-
-            // Update reference book keeping.
-            prevRefId = record.rID;
-            prevBin = minValue<__int32>();
+            if (record.rID >= 0 && lastRefId > record.rID)
+                return false;  // Not sorted by reference.
+            lastRefId = record.rID;
+            lastBin = maxValue<__uint32>();
         }
-
-        // If the alignment's reference id is valid and its bin is not a leaf.
-        if (record.rID >= 0 && record.bin < 4681)
+        else if (record.rID >= 0 && lastPos > record.beginPos)
         {
-            __int32 beginOffset = record.beginPos >> BamIndex<Bai>::BAM_LIDX_SHIFT;
-            __int32 endPos      = getAlignmentLengthInRef(record);
-            __int32 endOffset   = (endPos - 1) >> BamIndex<Bai>::BAM_LIDX_SHIFT;
-
-            // Resize linear index if necessary.
-            unsigned oldSize = length(index._linearIndices);
-            unsigned newSize = endOffset + 1;
-            if (oldSize < newSize)
-                resize(back(index._linearIndices), newSize, 0);
-
-            // Store offset.
-            for (int i = beginOffset + 1; i <= endOffset; ++i)
-                if (back(index._linearIndices)[i] == 0u)
-                    back(index._linearIndices)[i] = prevOffset;
+            return false;  // Not sorted by position.
         }
 
+        if (record.rID >= 0 && !hasFlagUnmapped(record))
+            _baiAddAlignmentToLinearIndex(index._linearIndices[record.rID], record, lastOffset);
+
         // Handle the case if we changed to a new BAI bin.
-        if (record.bin != prevBin)
+        if (record.bin != lastBin)
         {
-            // If not first bin of reference, save previous bin data.
-            if (currBin != maxValue<__uint32>())
-                _baiAddAlignmentChunkToBin(index, currBin, currOffset, prevOffset);
+            // If not the first record, save previous chunk.
+            if (saveBin != maxValue<__uint32>())
+                _baiAddAlignmentChunkToBin(index._binIndices[saveRefId], saveBin, saveOffset, lastOffset);
+
+            // The reference changed, write the pseudo-bin with the meta data of the previous one.
+            if (lastBin == maxValue<__uint32>() && saveRefId != BamAlignmentRecord::INVALID_REFID)
+            {
+                _baiAddAlignmentChunkToBin(index._binIndices[saveRefId], 37450u, refBeginOffset, lastOffset);
+                _baiAddAlignmentChunkToBin(index._binIndices[saveRefId], 37450u, numMapped, numUnmapped);
+                numMapped = numUnmapped = 0;
+                refBeginOffset = lastOffset;
+            }
 
             // Update markers.
-            currOffset = prevOffset;
-            currBin    = record.bin;
-            prevBin    = record.bin;
-            currRefId  = record.rID;
+            saveOffset = lastOffset;
+            saveBin = lastBin = record.bin;
+            saveRefId = record.rID;
 
-            // If the reference id is invalid then break out.
-            if (currRefId < 0)
+            // Only unplaced records follow.
+            if (saveRefId < 0)
+            {
+                reachedUnplaced = true;
+                index._unalignedCount += 1;
                 break;
+            }
         }
 
-        // Make sure that the current file pointer is beyond prevOffset.
-        if (streamTell(bamStream) <= static_cast<__int64>(prevOffset))
+        // Make sure that the current file pointer is beyond lastOffset.
+        if (streamTell(bamStream) <= static_cast<__int64>(lastOffset))
             return false;  // Calculating offsets failed.
 
-        // Update prevOffset and prevPos.
-        prevOffset = streamTell(bamStream);
-        prevPos    = record.beginPos;
+        if (hasFlagUnmapped(record))
+            numUnmapped += 1;
+        else
+            numMapped += 1;
+        lastOffset = streamTell(bamStream);
+        lastPos = record.beginPos;
     }
 
-    // Count remaining unaligned records.
-    while (!streamEof(bamStream))
+    // Close the last reference if the file does not end with unplaced records.
+    // As in samtools, the chunks end behind the BGZF EOF marker block then.
+    if (!reachedUnplaced && saveRefId >= 0)
     {
-        SEQAN_ASSERT_GT(index._unalignedCount, 0u);
+        __uint64 endOffset = static_cast<__uint64>(bamStream._fileSize) << 16;
+        _baiAddAlignmentChunkToBin(index._binIndices[saveRefId], saveBin, saveOffset, endOffset);
+        _baiAddAlignmentChunkToBin(index._binIndices[saveRefId], 37450u, refBeginOffset, endOffset);
+        _baiAddAlignmentChunkToBin(index._binIndices[saveRefId], 37450u, numMapped, numUnmapped);
+    }
 
+    // Count remaining unplaced records.
+    while (!atEnd(bamStream))
+    {
         res = readRecord(record, bamIOContext, bamStream, Bam());
         if (res != 0 || record.rID >= 0)
-            return false;  // Could not read record.
-
+            return false;  // Could not read record or placed record after unplaced ones.
         index._unalignedCount += 1;
     }
 
-    // After loading all alignments, if any data was read, perform checks.
-    if (currRefId >= 0)
+    _baiMergeChunks(index);
+
+    // Fill windows without alignment starts with the offset of the previous window.
+    for (unsigned i = 0; i < length(index._linearIndices); ++i)
+        for (unsigned j = 1; j < length(index._linearIndices[i]); ++j)
+            if (index._linearIndices[i][j] == 0u)
+                index._linearIndices[i][j] = index._linearIndices[i][j - 1];
+
+    return true;
+}
+
+inline bool
+buildIndex(BamIndex<Bai> & index, char const * filename)
+{
+    return buildIndex(index, filename, omp_get_max_threads());
+}
+
+// ----------------------------------------------------------------------------
+// Function computeRegionChunks()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamIndex#computeRegionChunks
+ * @brief Split the alignments of an indexed BAM file into region chunks of similar size.
+ *
+ * @signature void computeRegionChunks(chunks, index, numChunks);
+ *
+ * @param[out] chunks    A <tt>String&lt;BamRegionChunk&gt;</tt> with the resulting chunks.
+ * @param[in]  index     The BamIndex of the BAM file.
+ * @param[in]  numChunks The number of chunks to aim for, <tt>unsigned</tt>.
+ *
+ * @section Remarks
+ *
+ * The size of a chunk is estimated from the compressed file offsets in the linear index, chunk borders are placed
+ * at 16kb window borders.  Chunks never span more than one reference, so the number of resulting chunks can
+ * differ from <tt>numChunks</tt>.  The chunks of a reference cover all positions, the last one ends at the BAI
+ * maximal position <tt>2^29</tt>.
+ *
+ * Each chunk can be processed independently, e.g. by a thread with its own BgzfStream and BamIOContext, using
+ * @link BamIndex#jumpToRegionChunk @endlink and @link BamIndex#readRegionChunkRecord @endlink.  Each placed
+ * alignment is read in exactly one chunk, the one containing its begin position.
+ *
+ * References without alignments get no chunk, this includes references that only have unmapped records placed at
+ * the position of their mates.  Such unmapped records are not read from any chunk.
+ */
+
+/**
+.Function.BamIndex#computeRegionChunks
+..class:Class.BamIndex
+..cat:BAM I/O
+..signature:computeRegionChunks(chunks, index, numChunks)
+..summary:Split the alignments of an indexed BAM file into region chunks of similar size.
+..param.chunks:The resulting chunks.
+...type:Class.String
+...remarks:A String of @Class.BamRegionChunk@ objects.
+..param.index:The index of the BAM file.
+...type:Class.BamIndex
+..param.numChunks:The number of chunks to aim for.
+...type:nolink:$unsigned$
+..remarks:The chunk sizes are estimated from the compressed file offsets in the linear index.
+Chunks never span more than one reference, so the number of resulting chunks can differ from $numChunks$.
+Each chunk can be processed independently with its own @Spec.BGZF Stream@ and @Class.BamIOContext@, using
+@Function.BamIndex#jumpToRegionChunk@ and @Function.BamIndex#readRegionChunkRecord@.
+References without alignments, e.g. with only unmapped records placed at the position of their mates, get no chunk.
+..include:seqan/bam_io.h
+ */
+
+// Returns the compressed file offset at which the alignments of reference refId end.
+
+inline __uint64
+_baiReferenceEndOffset(BamIndex<Bai> const & index, unsigned refId)
+{
+    BamIndex<Bai>::TBinIndex_::const_iterator it = index._binIndices[refId].find(37450u);
+    if (it != index._binIndices[refId].end() && !empty(it->second.chunkBegEnds))
+        return front(it->second.chunkBegEnds).i2;
+    for (unsigned i = refId + 1; i < length(index._linearIndices); ++i)
+        if (!empty(index._linearIndices[i]))
+            return front(index._linearIndices[i]);
+    return back(index._linearIndices[refId]);
+}
+
+template <typename TSpec>
+inline void
+computeRegionChunks(String<BamRegionChunk, TSpec> & chunks,
+                    BamIndex<Bai> const & index,
+                    unsigned numChunks)
+{
+    typedef BamIndex<Bai>::TLinearIndex_ TLinearIndex;
+
+    clear(chunks);
+    if (numChunks == 0u)
+        numChunks = 1;
+
+    // Weight each 16kb window with the number of compressed blocks its alignments start in.
+    String<String<__uint64> > weights;
+    resize(weights, length(index._linearIndices));
+    __uint64 totalWeight = 0;
+    for (unsigned i = 0; i < length(index._linearIndices); ++i)
     {
-        // Store last alignment chunk to its bin and then write last reference entry with data.
-        _baiAddAlignmentChunkToBin(index, currBin, currOffset, prevOffset);
+        TLinearIndex const & linearIndex = index._linearIndices[i];
+        resize(weights[i], length(linearIndex), 0u);
+        for (unsigned j = 0; j < length(linearIndex); ++j)
+        {
+            __uint64 endOffset = (j + 1 < length(linearIndex)) ? linearIndex[j + 1] : _baiReferenceEndOffset(index, i);
+            __uint64 weight = 1;
+            if ((endOffset >> 16) > (linearIndex[j] >> 16))
+                weight += (endOffset >> 16) - (linearIndex[j] >> 16);
+            weights[i][j] = weight;
+            totalWeight += weight;
+        }
+    }
 
-        // Finally, write any empty references remaining at end of file.
-        SEQAN_ASSERT_GEQ(numRefSeqs, length(index._binIndices));
-        BamIndex<Bai>::TBinIndex_ binIndex;
-        resize(index._binIndices, numRefSeqs, binIndex);  // TODO(holtgrew): binIndex is unnecessary if resize used T() as default value as vector.resize() does.
+    // Cut chunks at window borders once they reach the average weight.
+    __uint64 chunkWeight = (totalWeight + numChunks - 1) / numChunks;
+    for (unsigned i = 0; i < length(weights); ++i)
+    {
+        // The linear index only covers alignments, a reference with only unmapped records has an empty one and gets
+        // no chunk.
+        if (empty(index._linearIndices[i]))
+            continue;
+
+        __int32 beginPos = 0;
+        __uint64 weight = 0;
+        for (unsigned j = 0; j + 1 < length(weights[i]); ++j)
+        {
+            weight += weights[i][j];
+            if (weight < chunkWeight)
+                continue;
+            __int32 endPos = static_cast<__int32>(j + 1) << BamIndex<Bai>::BAM_LIDX_SHIFT;
+            appendValue(chunks, BamRegionChunk(i, beginPos, endPos));
+            beginPos = endPos;
+            weight = 0;
+        }
+        appendValue(chunks, BamRegionChunk(i, beginPos, 1 << 29));
     }
+}
+
+// ----------------------------------------------------------------------------
+// Function jumpToRegionChunk()
+// ----------------------------------------------------------------------------
 
-    // Merge small bins if possible.
-    SEQAN_FAIL("TODO: Merge bins!");
+/*!
+ * @fn BamIndex#jumpToRegionChunk
+ * @brief Seek to the first alignment of a region chunk.
+ *
+ * @signature bool jumpToRegionChunk(stream, hasAlignments, context, chunk, index);
+ *
+ * @param[in,out] stream        The BgzfStream to seek in.
+ * @param[out]    hasAlignments <tt>bool</tt> set to <tt>true</tt> if there are alignments in the chunk.
+ * @param[in,out] context       The BamIOContext to use for reading records.
+ * @param[in]     chunk         The BamRegionChunk to jump to.
+ * @param[in]     index         The BamIndex to use.
+ *
+ * @return bool <tt>true</tt> on success.
+ */
 
-    // Write out index.
-    CharString baiFilename(filename);
-    append(baiFilename, ".bai");
-    res = _writeIndex(index, toCString(baiFilename));
+/**
+.Function.BamIndex#jumpToRegionChunk
+..class:Class.BamIndex
+..cat:BAM I/O
+..signature:jumpToRegionChunk(bgzfStream, hasAlignments, bamIOContext, chunk, bamIndex)
+..summary:Seek to the first alignment of a region chunk.
+..param.bgzfStream:The BGZF Stream to seek in.
+...type:Spec.BGZF Stream
+..param.hasAlignments:Set to $true$ iff there are alignments in the chunk.
+...type:nolink:$bool$
+..param.bamIOContext:Context to use for loading alignments.
+...type:Class.BamIOContext
+..param.chunk:The chunk to jump to.
+...type:Class.BamRegionChunk
+..param.bamIndex:The index to use.
+...type:Class.BamIndex
+..returns:$bool$ indicating success.
+..include:seqan/bam_io.h
+*/
+
+template <typename TNameStore, typename TNameStoreCache>
+inline bool
+jumpToRegionChunk(Stream<Bgzf> & stream,
+                  bool & hasAlignments,
+                  BamIOContext<TNameStore, TNameStoreCache> & bamIOContext,
+                  BamRegionChunk const & chunk,
+                  BamIndex<Bai> const & index)
+{
+    return jumpToRegion(stream, hasAlignments, bamIOContext, chunk.rID, chunk.beginPos, chunk.endPos, index);
+}
 
-    return (res == 0);
+// ----------------------------------------------------------------------------
+// Function readRegionChunkRecord()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamIndex#readRegionChunkRecord
+ * @brief Read the next alignment that begins in a region chunk.
+ *
+ * @signature int readRegionChunkRecord(record, hasRecord, context, stream, chunk);
+ *
+ * @param[out]    record    The BamAlignmentRecord to read into.
+ * @param[out]    hasRecord <tt>bool</tt> set to <tt>false</tt> if there are no more alignments in the chunk.
+ * @param[in,out] context   The BamIOContext to use.
+ * @param[in,out] stream    The BgzfStream to read from, positioned with @link BamIndex#jumpToRegionChunk @endlink.
+ * @param[in]     chunk     The BamRegionChunk to read.
+ *
+ * @return int Status code, 0 indicating success.
+ *
+ * @section Remarks
+ *
+ * Alignments beginning before the chunk are skipped, so each alignment is read in exactly one chunk.
+ */
+
+/**
+.Function.BamIndex#readRegionChunkRecord
+..class:Class.BamIndex
+..cat:BAM I/O
+..signature:readRegionChunkRecord(record, hasRecord, bamIOContext, bgzfStream, chunk)
+..summary:Read the next alignment that begins in a region chunk.
+..param.record:The record to read into.
+...type:Class.BamAlignmentRecord
+..param.hasRecord:Set to $false$ iff there are no more alignments in the chunk.
+...type:nolink:$bool$
+..param.bamIOContext:Context to use for loading alignments.
+...type:Class.BamIOContext
+..param.bgzfStream:The BGZF Stream to read from, positioned with @Function.BamIndex#jumpToRegionChunk@.
+...type:Spec.BGZF Stream
+..param.chunk:The chunk to read.
+...type:Class.BamRegionChunk
+..returns:$int$ status code, $0$ indicating success.
+..remarks:Alignments beginning before the chunk are skipped, so each alignment is read in exactly one chunk.
+..include:seqan/bam_io.h
+*/
+
+template <typename TNameStore, typename TNameStoreCache>
+inline int
+readRegionChunkRecord(BamAlignmentRecord & record,
+                      bool & hasRecord,
+                      BamIOContext<TNameStore, TNameStoreCache> & bamIOContext,
+                      Stream<Bgzf> & stream,
+                      BamRegionChunk const & chunk)
+{
+    hasRecord = false;
+    while (!atEnd(stream))
+    {
+        if (readRecord(record, bamIOContext, stream, Bam()) != 0)
+            return 1;
+        if (record.rID != chunk.rID || record.beginPos >= chunk.endPos)
+            return 0;  // Left the chunk.
+        if (record.beginPos < chunk.beginPos)
+            continue;  // Belongs to the previous chunk.
+        hasRecord = true;
+        return 0;
+    }
+    return 0;
 }
 
 }  // namespace seqan
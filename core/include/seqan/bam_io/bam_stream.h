@@ -712,6 +712,130 @@ inline int writeRecord(BamStream & bamIO, BamAlignmentRecord const & record)
     return res;
 }
 
+// ----------------------------------------------------------------------------
+// Function writeRecords()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamStream#writeRecords
+ * @brief Write a batch of @link BamAlignmentRecord @endlinks to a @link BamStream @endlink.
+ *
+ * @signature int writeRecords(stream, records);
+ *
+ * @param[in,out] stream  The @link BamStream @endlink object to write to.
+ * @param[in]     records A @link String @endlink of @link BamAlignmentRecord @endlinks to write out.
+ *
+ * @return int A status code, 0 on success.
+ *
+ * @section Remarks
+ *
+ * The result is the same as calling @link BamStream#writeRecord @endlink for each record.  After
+ * @link BamStream#setNumThreads @endlink, the records are handed over to the writer thread in one go.
+ */
+
+/**
+.Function.BamStream#writeRecords
+..class:Class.BamStream
+..summary:Write a batch of @Class.BamAlignmentRecord@s to a @Class.BamStream@.
+..signature:writeRecords(bamIO, records)
+..param.bamIO:The @Class.BamStream@ object to write to.
+...type:Class.BamStream
+..param.records:The @Class.BamAlignmentRecord@s to write out.
+...type:Class.String
+..returns:An $int$ status code: $0$ on success, non-$0$ on failure.
+..remarks:The result is the same as calling @Function.BamStream#writeRecord@ for each record.
+After @Function.BamStream#setNumThreads@, the records are handed over to the writer thread in one go.
+..include:seqan/bam_io.h
+*/
+
+inline int writeRecords(BamStream & bamIO, String<BamAlignmentRecord> const & records)
+{
+    bamIO._writeHeader();  // Does nothing if head already written out.
+
+    int res = bamIO._writer->writeRecords(records, bamIO.bamIOContext);
+    bamIO._isGood = bamIO._isGood && (res == 0);
+    return res;
+}
+
+// ----------------------------------------------------------------------------
+// Function setNumThreads()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamStream#setNumThreads
+ * @brief Write asynchronously, encoding and compressing records with multiple threads.
+ *
+ * @signature int setNumThreads(stream, numThreads);
+ *
+ * @param[in,out] stream     The @link BamStream @endlink object to configure, opened for writing.
+ * @param[in]     numThreads The number of threads to use, <tt>unsigned</tt>.  1 switches back to synchronous writing.
+ *
+ * @return int A status code, 0 on success, <tt>!= 0</tt> if the stream is not open for writing or if the records
+ *             written with the previous setting could not be written.
+ *
+ * @section Remarks
+ *
+ * With more than one thread, written records are collected in batches and handed over to a writer thread.  The
+ * writer thread encodes the records of a batch with <tt>numThreads</tt> OpenMP threads, BGZF blocks are compressed
+ * by the same number of threads.  At most four batches of 4096 records wait for the writer thread, writing blocks
+ * while the queue is full.  The output is identical to synchronous writing.
+ *
+ * Errors of the writer thread are reported by later calls to @link BamStream#flush @endlink or
+ * @link BamStream#close @endlink.  The setting is lost on @link BamStream#open @endlink and
+ * @link BamStream#reset @endlink.
+ */
+
+/**
+.Function.BamStream#setNumThreads
+..class:Class.BamStream
+..summary:Write asynchronously, encoding and compressing records with multiple threads.
+..signature:setNumThreads(bamIO, numThreads)
+..param.bamIO:The @Class.BamStream@ object to configure, opened for writing.
+...type:Class.BamStream
+..param.numThreads:The number of threads to use, 1 switches back to synchronous writing.
+...type:nolink:$unsigned$
+..returns:An $int$ status code: $0$ on success, non-$0$ if the stream is not open for writing or if the records written with the previous setting could not be written.
+..remarks:With more than one thread, written records are collected in batches and handed over to a writer thread.
+The writer thread encodes the records of a batch with $numThreads$ OpenMP threads, BGZF blocks are compressed by the same number of threads.
+At most four batches of 4096 records wait for the writer thread, writing blocks while the queue is full.
+The output is identical to synchronous writing.
+..remarks:Errors of the writer thread are reported by later calls to @Function.BamStream#flush@ or @Function.BamStream#close@.
+The setting is lost on @Function.BamStream#open@ and @Function.BamStream#reset@.
+..include:seqan/bam_io.h
+*/
+
+inline int setNumThreads(BamStream & bamIO, unsigned numThreads)
+{
+    if (bamIO._mode != BamStream::WRITE || bamIO._writer.get() == 0)
+        return 1;
+
+    // Unwrap the writer if it is already asynchronous.
+    XamAsyncWriter_ * asyncWriter = dynamic_cast<XamAsyncWriter_ *>(bamIO._writer.get());
+    if (asyncWriter != 0)
+    {
+        asyncWriter->_stopThread();
+        int res = asyncWriter->_error;
+        XamWriter_ * writer = asyncWriter->_writer.release();
+        bamIO._writer.reset(writer);
+        if (res != 0)
+        {
+            bamIO._isGood = false;
+            return res;
+        }
+    }
+
+    int res = bamIO._writer->setNumThreads(numThreads);
+    if (res != 0)
+    {
+        bamIO._isGood = false;
+        return res;
+    }
+
+    if (numThreads > 1)
+        bamIO._writer.reset(new XamAsyncWriter_(bamIO._writer.release(), numThreads));
+    return 0;
+}
+
 // ----------------------------------------------------------------------------
 // Function fileSize()
 // ----------------------------------------------------------------------------
@@ -71,6 +71,11 @@ public:
                             BamIOContext<StringSet<CharString> > const & context);
     virtual int writeRecord(BamAlignmentRecord const & record,
                             BamIOContext<StringSet<CharString> > const & context);
+    virtual int encodeRecord(CharString & buffer,
+                             BamAlignmentRecord const & record,
+                             BamIOContext<StringSet<CharString> > const & context);
+    virtual int writeEncoded(CharString const & buffer);
+    virtual int setNumThreads(unsigned numThreads);
     virtual int flush();
     virtual int close();
 };
@@ -137,6 +142,37 @@ inline int BamWriter_::writeRecord(BamAlignmentRecord const & record,
     return write2(this->_stream, record, context, Bam());
 }
 
+// ----------------------------------------------------------------------------
+// Member Function BamWriter_::encodeRecord()
+// ----------------------------------------------------------------------------
+
+inline int BamWriter_::encodeRecord(CharString & buffer,
+                                    BamAlignmentRecord const & record,
+                                    BamIOContext<StringSet<CharString> > const & context)
+{
+    return write2(buffer, record, context, Bam());
+}
+
+// ----------------------------------------------------------------------------
+// Member Function BamWriter_::writeEncoded()
+// ----------------------------------------------------------------------------
+
+inline int BamWriter_::writeEncoded(CharString const & buffer)
+{
+    if (empty(buffer))
+        return 0;
+    return streamWriteBlock(this->_stream, &buffer[0], length(buffer)) != length(buffer);
+}
+
+// ----------------------------------------------------------------------------
+// Member Function BamWriter_::setNumThreads()
+// ----------------------------------------------------------------------------
+
+inline int BamWriter_::setNumThreads(unsigned numThreads)
+{
+    return seqan::setNumThreads(this->_stream, numThreads);
+}
+
 // ----------------------------------------------------------------------------
 // Member Function BamWriter_::flush()
 // ----------------------------------------------------------------------------
@@ -66,6 +66,10 @@ public:
     virtual bool isGood();
     virtual int writeHeader(BamHeader const & header, BamIOContext<StringSet<CharString> > const & context);
     virtual int writeRecord(BamAlignmentRecord const & record, BamIOContext<StringSet<CharString> > const & context);
+    virtual int encodeRecord(CharString & buffer,
+                             BamAlignmentRecord const & record,
+                             BamIOContext<StringSet<CharString> > const & context);
+    virtual int writeEncoded(CharString const & buffer);
     virtual int flush();
     virtual int close();
 };
@@ -136,6 +140,28 @@ inline int SamWriter_::writeRecord(BamAlignmentRecord const & record, BamIOConte
     return seqan::write2(*this->_stream, record, context, Sam());
 }
 
+// ----------------------------------------------------------------------------
+// Member Function SamWriter_::encodeRecord()
+// ----------------------------------------------------------------------------
+
+inline int SamWriter_::encodeRecord(CharString & buffer,
+                                    BamAlignmentRecord const & record,
+                                    BamIOContext<StringSet<CharString> > const & context)
+{
+    return seqan::write2(buffer, record, context, Sam());
+}
+
+// ----------------------------------------------------------------------------
+// Member Function SamWriter_::writeEncoded()
+// ----------------------------------------------------------------------------
+
+inline int SamWriter_::writeEncoded(CharString const & buffer)
+{
+    if (empty(buffer))
+        return 0;
+    return streamWriteBlock(*this->_stream, &buffer[0], length(buffer)) != length(buffer);
+}
+
 // ----------------------------------------------------------------------------
 // Member Function SamWriter_::flush()
 // ----------------------------------------------------------------------------
@@ -78,6 +78,30 @@ public:
     virtual int writeRecord(BamAlignmentRecord const & record,
                             BamIOContext<StringSet<CharString> > const & bamIOContext) = 0;
 
+    // Write a batch of BAM records to the wrapped file.
+    virtual int writeRecords(String<BamAlignmentRecord> const & records,
+                             BamIOContext<StringSet<CharString> > const & bamIOContext)
+    {
+        for (unsigned i = 0; i < length(records); ++i)
+            if (writeRecord(records[i], bamIOContext) != 0)
+                return 1;
+        return 0;
+    }
+
+    // Append the serialized BAM record to buffer without writing it.  Must be safe to call from multiple threads.
+    virtual int encodeRecord(CharString & buffer,
+                             BamAlignmentRecord const & record,
+                             BamIOContext<StringSet<CharString> > const & bamIOContext) = 0;
+
+    // Write records that were serialized with encodeRecord() to the wrapped file.
+    virtual int writeEncoded(CharString const & buffer) = 0;
+
+    // Set the number of threads to use for compression, ignored by writers without compression.
+    virtual int setNumThreads(unsigned /*numThreads*/)
+    {
+        return 0;
+    }
+
     // Flush all buffers.
     virtual int flush() = 0;
 
@@ -0,0 +1,368 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Asynchronous SAM/BAM writer.  Records are collected in batches that are
+// handed over to a writer thread which encodes them in parallel and passes
+// the result on to the wrapped (possibly compressing) writer.
+// ==========================================================================
+
+#ifndef CORE_INCLUDE_SEQAN_BAM_IO_XAM_WRITER_ASYNC_H_
+#define CORE_INCLUDE_SEQAN_BAM_IO_XAM_WRITER_ASYNC_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+class XamAsyncWriter_;
+
+// Runs the main loop of XamAsyncWriter_ on the writer thread.
+
+struct XamAsyncWriterWorker_
+{
+    XamAsyncWriter_ * _writer;
+
+    XamAsyncWriterWorker_(XamAsyncWriter_ & writer) : _writer(&writer)
+    {}
+
+    inline void run(Thread<XamAsyncWriterWorker_> *);
+};
+
+// Writer that wraps a SamWriter_ or BamWriter_ and moves record encoding and compression to a separate thread.
+//
+// The caller fills batches of at most _batchSize records.  Full batches are put into a queue of at most _maxQueued
+// batches, the caller blocks while the queue is full.  The writer thread takes one batch at a time, encodes its
+// records into one buffer per chunk using _numThreads OpenMP threads and writes the buffers in order to the wrapped
+// writer.  The output is therefore identical to writing the records one by one.
+
+class XamAsyncWriter_ :
+    public XamWriter_
+{
+public:
+    typedef BamIOContext<StringSet<CharString> > TContext;
+
+    // The wrapped writer that owns the file.
+    std::SEQAN_AUTO_PTR_NAME<XamWriter_> _writer;
+    // The context to encode the records with, set on the first record.
+    TContext const * _context;
+
+    // Number of threads for encoding and compression.
+    unsigned _numThreads;
+    // Maximal number of records per batch and maximal number of batches in the queue.
+    unsigned _batchSize;
+    unsigned _maxQueued;
+
+    // The batch currently filled by the caller.
+    String<BamAlignmentRecord> _current;
+    // Full batches waiting for the writer thread.
+    ConcurrentQueue<String<BamAlignmentRecord> > _queue;
+    // The batch the writer thread is working on and the encoded chunks of it.
+    String<BamAlignmentRecord> _work;
+    String<CharString> _buffers;
+
+    // Status code of the caller, 0 if no error occured.  The status code of the writer thread is only written by the
+    // writer thread and taken over after waiting for the queue.
+    int _error;
+    int _threadError;
+    // Whether the writer thread is running.
+    bool _running;
+
+    Thread<XamAsyncWriterWorker_> _thread;
+
+    XamAsyncWriter_(XamWriter_ * writer, unsigned numThreads, unsigned batchSize = 4096, unsigned maxQueued = 4) :
+        XamWriter_(writer->_filename), _writer(writer), _context(0), _numThreads(_max(numThreads, 1u)),
+        _batchSize(_max(batchSize, 1u)), _maxQueued(_max(maxQueued, 1u)), _queue(_maxQueued), _error(0),
+        _threadError(0), _running(false), _thread(*this)
+    {
+        _running = run(_thread);
+    }
+
+    ~XamAsyncWriter_()
+    {
+        _stopThread();
+    }
+
+    // XamWriter_ interface.
+
+    virtual int open(CharString const & filename);
+    virtual bool isGood();
+    virtual int writeHeader(BamHeader const & header, TContext const & context);
+    virtual int writeRecord(BamAlignmentRecord const & record, TContext const & context);
+    virtual int writeRecords(String<BamAlignmentRecord> const & records, TContext const & context);
+    virtual int encodeRecord(CharString & buffer, BamAlignmentRecord const & record, TContext const & context);
+    virtual int writeEncoded(CharString const & buffer);
+    virtual int flush();
+    virtual int close();
+
+    // Queue handling.
+
+    int _pushCurrent();
+    int _drain();
+    void _stopThread();
+    int _writeBatch(String<BamAlignmentRecord> const & batch);
+    void _run();
+
+private:
+    XamAsyncWriter_(XamAsyncWriter_ const &);
+    XamAsyncWriter_ & operator=(XamAsyncWriter_ const &);
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Member Function XamAsyncWriter_::_writeBatch()
+// ----------------------------------------------------------------------------
+
+// Encode the records in parallel chunks and write the chunks out in order, called by the writer thread.
+
+inline int XamAsyncWriter_::_writeBatch(String<BamAlignmentRecord> const & batch)
+{
+    if (empty(batch))
+        return 0;
+
+    Splitter<unsigned> splitter(0, length(batch), _min((unsigned)length(batch), 4 * _numThreads));
+    int numChunks = length(splitter);
+    resize(_buffers, numChunks);
+
+    int res = 0;
+    SEQAN_OMP_PRAGMA(parallel for num_threads(_numThreads) schedule(dynamic) reduction(|:res))
+    for (int c = 0; c < numChunks; ++c)
+    {
+        clear(_buffers[c]);
+        for (unsigned i = splitter[c]; i < splitter[c + 1]; ++i)
+            res |= _writer->encodeRecord(_buffers[c], batch[i], *_context);
+    }
+    if (res != 0)
+        return 1;
+
+    for (int c = 0; c < numChunks; ++c)
+        if (_writer->writeEncoded(_buffers[c]) != 0)
+            return 1;
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Member Function XamAsyncWriter_::_run()
+// ----------------------------------------------------------------------------
+
+// Main loop of the writer thread.
+
+inline void XamAsyncWriter_::_run()
+{
+    while (popFront(_work, _queue))
+    {
+        if (_threadError == 0)
+            _threadError = _writeBatch(_work);
+        clear(_work);
+        markProcessed(_queue);
+    }
+}
+
+inline void XamAsyncWriterWorker_::run(Thread<XamAsyncWriterWorker_> *)
+{
+    _writer->_run();
+}
+
+// ----------------------------------------------------------------------------
+// Member Function XamAsyncWriter_::_pushCurrent()
+// ----------------------------------------------------------------------------
+
+// Hand the current batch over to the writer thread, blocks while the queue is full.
+
+inline int XamAsyncWriter_::_pushCurrent()
+{
+    if (empty(_current))
+        return _error;
+    if (!_running)
+    {
+        // The writer thread could not be started, write synchronously.
+        int res = (_error == 0) ? _writeBatch(_current) : 0;
+        clear(_current);
+        if (res != 0)
+            _error = res;
+        return _error;
+    }
+
+    pushBack(_queue, _current);
+    clear(_current);
+    return _error;
+}
+
+// ----------------------------------------------------------------------------
+// Member Function XamAsyncWriter_::_drain()
+// ----------------------------------------------------------------------------
+
+// Hand over the current batch and wait until the writer thread has written all batches.
+
+inline int XamAsyncWriter_::_drain()
+{
+    _pushCurrent();
+    if (!_running)
+        return _error;
+
+    waitForProcessed(_queue);
+    if (_error == 0)
+        _error = _threadError;
+    return _error;
+}
+
+// ----------------------------------------------------------------------------
+// Member Function XamAsyncWriter_::_stopThread()
+// ----------------------------------------------------------------------------
+
+inline void XamAsyncWriter_::_stopThread()
+{
+    _drain();
+    if (!_running)
+        return;
+
+    seqan::close(_queue);
+    waitFor(_thread);
+    _running = false;
+}
+
+// ----------------------------------------------------------------------------
+// Member Function XamAsyncWriter_::open()
+// ----------------------------------------------------------------------------
+
+inline int XamAsyncWriter_::open(CharString const & filename)
+{
+    if (_drain() != 0)
+        return 1;
+    return _writer->open(filename);
+}
+
+// ----------------------------------------------------------------------------
+// Member Function XamAsyncWriter_::isGood()
+// ----------------------------------------------------------------------------
+
+inline bool XamAsyncWriter_::isGood()
+{
+    return _drain() == 0 && _writer->isGood();
+}
+
+// ----------------------------------------------------------------------------
+// Member Function XamAsyncWriter_::writeHeader()
+// ----------------------------------------------------------------------------
+
+inline int XamAsyncWriter_::writeHeader(BamHeader const & header, TContext const & context)
+{
+    if (_drain() != 0)
+        return 1;
+    return _writer->writeHeader(header, context);
+}
+
+// ----------------------------------------------------------------------------
+// Member Function XamAsyncWriter_::writeRecord()
+// ----------------------------------------------------------------------------
+
+inline int XamAsyncWriter_::writeRecord(BamAlignmentRecord const & record, TContext const & context)
+{
+    _context = &context;
+    appendValue(_current, record);
+    if (length(_current) >= _batchSize)
+        return _pushCurrent();
+    return _error;
+}
+
+// ----------------------------------------------------------------------------
+// Member Function XamAsyncWriter_::writeRecords()
+// ----------------------------------------------------------------------------
+
+inline int XamAsyncWriter_::writeRecords(String<BamAlignmentRecord> const & records, TContext const & context)
+{
+    _context = &context;
+    for (unsigned i = 0; i < length(records); ++i)
+    {
+        appendValue(_current, records[i]);
+        if (length(_current) >= _batchSize && _pushCurrent() != 0)
+            return 1;
+    }
+    return _error;
+}
+
+// ----------------------------------------------------------------------------
+// Member Function XamAsyncWriter_::encodeRecord()
+// ----------------------------------------------------------------------------
+
+inline int XamAsyncWriter_::encodeRecord(CharString & buffer, BamAlignmentRecord const & record,
+                                         TContext const & context)
+{
+    return _writer->encodeRecord(buffer, record, context);
+}
+
+// ----------------------------------------------------------------------------
+// Member Function XamAsyncWriter_::writeEncoded()
+// ----------------------------------------------------------------------------
+
+inline int XamAsyncWriter_::writeEncoded(CharString const & buffer)
+{
+    if (_drain() != 0)
+        return 1;
+    return _writer->writeEncoded(buffer);
+}
+
+// ----------------------------------------------------------------------------
+// Member Function XamAsyncWriter_::flush()
+// ----------------------------------------------------------------------------
+
+inline int XamAsyncWriter_::flush()
+{
+    if (_drain() != 0)
+        return 1;
+    return _writer->flush();
+}
+
+// ----------------------------------------------------------------------------
+// Member Function XamAsyncWriter_::close()
+// ----------------------------------------------------------------------------
+
+inline int XamAsyncWriter_::close()
+{
+    _stopThread();
+    int res = _writer->close();
+    return (_error != 0) ? _error : res;
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef CORE_INCLUDE_SEQAN_BAM_IO_XAM_WRITER_ASYNC_H_
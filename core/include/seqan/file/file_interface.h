@@ -148,6 +148,10 @@ namespace seqan {
  * @var FileOpenMode OPEN_QUIET
  * @brief Don't print any warning message if the file could not be opened.
  *
+ * @var FileOpenMode OPEN_SHARED_MEMORY
+ * @brief Open a named POSIX shared memory object instead of a file.  The name must start with a <tt>/</tt> and must
+ *        not contain further slashes.  Not supported on Windows.
+ *
  * @var FileOpenMode OPEN_MASK
  * @brief (Internal) Bitmask to extract the read/write open mode.
  *
@@ -179,6 +183,8 @@ namespace seqan {
 ..value.OPEN_CREATE:Create a file if it not yet exists.
 ..value.OPEN_APPEND:Keep the existing data. If this flag is not given, the file is cleared in write mode.
 ..value.OPEN_QUIET:Don't print any warning message if the file could not be opened.
+..value.OPEN_SHARED_MEMORY:Open a named POSIX shared memory object (see $shm_open$) instead of a file.
+The name must start with a slash and must not contain further slashes. Not supported on Windows.
 ..value.OPEN_MASK:(Internal) Bitmask to extract the read/write open mode.
 ..example.text:Code example to test for read-only mode.
 ..example.code:
@@ -199,6 +205,7 @@ if (openMode & OPEN_MASK == OPEN_READ)
         OPEN_APPEND     = 8,
         OPEN_ASYNC      = 16,
 		OPEN_TEMPORARY	= 32,
+		OPEN_SHARED_MEMORY = 64,
 		OPEN_QUIET		= 128
     }; //IOREV is it intended that two labels share the same value? What is OPEN_MASK anyway?
 
@@ -408,6 +408,36 @@ openTemp(FileMapping<TSpec> &mapping)
     return result;
 }
 
+// ----------------------------------------------------------------------------
+// Function _isMappedFile()
+// ----------------------------------------------------------------------------
+
+// Returns true if fileName refers to the file that is mapped, e.g. via another path or a hard link.  Only the
+// OPEN_SHARED_MEMORY flag of openMode is used.
+
+template <typename TSpec>
+inline bool
+_isMappedFile(FileMapping<TSpec> const &mapping, const char *fileName, int openMode)
+{
+    typename FileMapping<TSpec>::TFile other;
+    if (!mapping.file || !open(other, fileName, OPEN_RDONLY | OPEN_QUIET | (openMode & OPEN_SHARED_MEMORY)))
+        return false;
+#ifdef PLATFORM_WINDOWS
+    BY_HANDLE_FILE_INFORMATION info, otherInfo;
+    bool result = GetFileInformationByHandle(mapping.file.handle, &info) &&
+                  GetFileInformationByHandle(other.handle, &otherInfo) &&
+                  info.dwVolumeSerialNumber == otherInfo.dwVolumeSerialNumber &&
+                  info.nFileIndexHigh == otherInfo.nFileIndexHigh &&
+                  info.nFileIndexLow == otherInfo.nFileIndexLow;
+#else
+    struct stat info, otherInfo;
+    bool result = fstat(mapping.file.handle, &info) == 0 && fstat(other.handle, &otherInfo) == 0 &&
+                  info.st_dev == otherInfo.st_dev && info.st_ino == otherInfo.st_ino;
+#endif
+    close(other);
+    return result;
+}
+
 /*!
  * @fn FileMapping#close
  * @brief Close a file and its memory mapping.
@@ -916,6 +946,46 @@ remapFileSegment(FileMapping<TSpec> &mapping, void *oldAddr, TPos oldFileOfs, TS
     return addr;
 }
 
+/*!
+ * @fn removeSharedMemory
+ * @headerfile <seqan/file.h>
+ * @brief Remove a named shared memory object.
+ *
+ * @signature bool removeSharedMemory(name);
+ *
+ * @param[in] name The name of the shared memory object, as given to <tt>open</tt> with <tt>OPEN_SHARED_MEMORY</tt>.
+ *
+ * @return bool <tt>true</tt> on success, <tt>false</tt> otherwise.
+ *
+ * @section Remarks
+ *
+ * Processes that have the object still mapped can access it until they unmap it.  Not supported on Windows.
+ */
+
+/**
+.Function.removeSharedMemory
+..cat:Input/Output
+..summary:Remove a named shared memory object.
+..signature:removeSharedMemory(name)
+..param.name:C-style character string containing the name of the shared memory object.
+...remarks:The same name that was used to open the object with $OPEN_SHARED_MEMORY$, see @Enum.FileOpenMode@.
+..returns:A $bool$ which is $true$ on success.
+..remarks:Processes that have the object still mapped can access it until they unmap it.
+Not supported on Windows.
+..include:seqan/file.h
+*/
+
+inline bool
+removeSharedMemory(const char *name)
+{
+#ifdef PLATFORM_WINDOWS
+    ignoreUnusedVariableWarning(name);
+    return false;
+#else
+    return shm_unlink(name) == 0;
+#endif
+}
+
 }  // namespace seqan
 
 #endif  // #ifndef SEQAN_CORE_INCLUDE_SEQAN_FILE_MAPPING_H_
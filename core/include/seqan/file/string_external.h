@@ -137,7 +137,11 @@ namespace SEQAN_NAMESPACE_MAIN
  *
  * The External String implements a LRU mechanism to swap out pages.  The External String's Iterator detects a forward or
  * backward iteration and asynchronously prefetches pages that certainly will be accessed and automatically swaps out
- * pages that certainly won't be accessed any more in the iteration process.
+ * pages that certainly won't be accessed any more in the iteration process.  Random accesses with a constant page
+ * stride (e.g. sequential scans or column-wise traversals) also prefetch the next pages.  The number of pages in
+ * flight is set with @link ExternalString#setPrefetchDepth @endlink, the paging counters are returned by
+ * @link ExternalString#pagingStats @endlink.  Use <tt>File&lt;PReadAsync&lt;&gt; &gt;</tt> to have several pages
+ * transferred at the same time.
  *
  * The String is implemented like a virtual memory manager.  It divides its character sequence into pages of a fixed
  * length (e.g. 1MB) and maintains a page table with information for each page (e.g. resides in memory or was swapped
@@ -171,6 +175,9 @@ See the @Memfunc.External String#String@ constructor for more details.
 The External String's @Metafunction.Iterator@ detects a forward or backward iteration and asynchronously prefetches pages that
 certainly will be accessed and automatically swaps out pages that certainly won't be accessed any more in the iteration
 process.
+Random accesses with a constant page stride (e.g. sequential scans or column-wise traversals) also prefetch the next pages.
+The number of pages in flight is set with @Function.setPrefetchDepth@, the paging counters are returned by @Function.pagingStats@.
+Use @Spec.PReadAsync@ files to have several pages transferred at the same time.
 ..remarks:The String is implemented like a virtual memory manager.
 It divides its character sequence into pages of a fixed length (e.g. 1MB) and maintains a
 page table with information for each page (e.g. resides in memory or was swapped out, is dirty and needs to be saved, ...).
@@ -668,7 +675,7 @@ you should think of using @Tag.ExternalConfig@.
             // synchronize PageFrame dirty flag on dirty false->true change
             if (!dirty) {
                 const_cast<TIterator*>(this)->dirty = true;
-    			extString->getPage(pageNo).dirty = true;
+    			extString->cache[extString->pager[pageNo]].dirty = true;    // the page is pinned by this iterator
             }
 			return const_cast<TIterator*>(this)->begin[pageOfs];
 		}
@@ -1183,6 +1190,65 @@ you should think of using @Tag.ExternalConfig@.
 	
 	
 	
+	//////////////////////////////////////////////////////////////////////////////
+    // paging statistics of an External String
+
+/*!
+ * @class ExternalStringStats
+ * @headerfile <seqan/file.h>
+ * @brief Paging counters of an @link ExternalString @endlink.
+ *
+ * @signature struct ExternalStringStats;
+ *
+ * @var __uint64 ExternalStringStats::hits;
+ * @brief Number of page requests served by a page frame.
+ *
+ * @var __uint64 ExternalStringStats::misses;
+ * @brief Number of page requests that had to load or allocate a page frame.
+ *
+ * @var __uint64 ExternalStringStats::prefetches;
+ * @brief Number of pages read ahead asynchronously.
+ *
+ * @var __uint64 ExternalStringStats::waits;
+ * @brief Number of hits that had to wait for a transfer in progress (e.g. a prefetch that came too late).
+ */
+
+/**
+.Class.ExternalStringStats:
+..cat:Strings
+..summary:Paging counters of an @Spec.External String@.
+..signature:ExternalStringStats
+..remarks:Use @Function.pagingStats@ to get the counters of a string.
+..include:seqan/file.h
+.Memvar.ExternalStringStats#hits:
+..class:Class.ExternalStringStats
+..summary:Number of page requests served by a page frame.
+.Memvar.ExternalStringStats#misses:
+..class:Class.ExternalStringStats
+..summary:Number of page requests that had to load or allocate a page frame.
+.Memvar.ExternalStringStats#prefetches:
+..class:Class.ExternalStringStats
+..summary:Number of pages read ahead asynchronously.
+.Memvar.ExternalStringStats#waits:
+..class:Class.ExternalStringStats
+..summary:Number of hits that had to wait for a transfer in progress (e.g. a prefetch that came too late).
+*/
+
+    struct ExternalStringStats
+    {
+        __uint64    hits;
+        __uint64    misses;
+        __uint64    prefetches;
+        __uint64    waits;
+
+        ExternalStringStats():
+            hits(0),
+            misses(0),
+            prefetches(0),
+            waits(0) {}
+    };
+
+
 	//////////////////////////////////////////////////////////////////////////////
     // External String
     //////////////////////////////////////////////////////////////////////////////
@@ -1212,9 +1278,17 @@ you should think of using @Tag.ExternalConfig@.
         int                 lastDiskPage;       // the last page on disk and in mem 
         unsigned            lastDiskPageSize;   // can be smaller than PAGESIZE
 
+        unsigned            prefetchDepth;      // number of pages to read ahead of a sequential or strided access
+        int                 lastPageNo;         // page and stride of the previous random access
+        int                 lastStride;
+        ExternalStringStats stats;
+
 		String(TSize size = 0):
             file(NULL),
-			data_size(0)
+			data_size(0),
+            prefetchDepth(_defaultPrefetchDepth()),
+            lastPageNo(-1),
+            lastStride(0)
         {
             _temporary = true;
             _ownFile = false;
@@ -1284,13 +1358,19 @@ needs to swap out page frames. Then a temporary file will be used which will be
 Instead of giving $file$ or $fileName$ to the constructor, you could also use the default constructor and call @Function.open@
 or @Function.openTemp@ afterwards to reach the same behaviour.
 */
-		String(TFile &_file)
+		String(TFile &_file):
+            prefetchDepth(_defaultPrefetchDepth()),
+            lastPageNo(-1),
+            lastStride(0)
         {
 			open(*this, _file);
         }
 
 		String(const char *fileName, int openMode = DefaultOpenMode<TFile>::VALUE):
-			file(NULL)
+			file(NULL),
+            prefetchDepth(_defaultPrefetchDepth()),
+            lastPageNo(-1),
+            lastStride(0)
         {
 			open(*this, fileName, openMode);
         }
@@ -1328,6 +1408,11 @@ or @Function.openTemp@ afterwards to reach the same behaviour.
             return file;
         }
 
+        static inline unsigned _defaultPrefetchDepth()
+        {
+            return (FRAMES > 2)? FRAMES / 2: 1;
+        }
+
 		//////////////////////////////////////////////////////////////////////////////
 		// swapping interface
 
@@ -1457,21 +1542,34 @@ or @Function.openTemp@ afterwards to reach the same behaviour.
 			}
 		};
 
+        // prefetchPages > 0 .. prefetch pages pageNo + i * prefetchStride for i = 1..prefetchPages
+        // prefetchPages < 0 .. prefetch pages pageNo - i for i = 1..-prefetchPages
         inline TPageFrame &getPage(
             int pageNo,
             typename TPageFrame::Priority maxLevel,
             typename TPageFrame::Priority newLevel,
-            int prefetchPages)
+            int prefetchPages,
+            int prefetchStride = 1)
         {
+            // iterators keep their prefetched pages until they reach them, random accesses don't
+            typename TPageFrame::Priority prefetchLevel = (newLevel >= TPageFrame::ITERATOR_LEVEL)?
+                TPageFrame::PREFETCH_LEVEL: TPageFrame::NORMAL_LEVEL;
+
 			int frameNo = pager[pageNo];
 			if (frameNo >= 0)					// cache hit
             {
 				TPageFrame &pf = cache[frameNo];
-				cache.upgrade(
-                    pf, 
-                    _max(pf.priority, newLevel));    		// update lru order
+                if (pf.priority == TPageFrame::PREFETCH_LEVEL && newLevel < TPageFrame::PREFETCH_LEVEL)
+                    cache.upgrade(pf, newLevel);            // a prefetched page is consumed
+                else
+    				cache.upgrade(
+                        pf, 
+                        _max(pf.priority, newLevel));    	// update lru order
 
                 PageFrameStatus oldStatus = pf.status;
+                ++stats.hits;
+                if (oldStatus != READY)
+                    ++stats.waits;
 				bool waitResult = waitFor(pf);              // wait for I/O transfer to complete
 
                 // TODO(weese): Throw an I/O exception
@@ -1482,14 +1580,15 @@ or @Function.openTemp@ afterwards to reach the same behaviour.
                     if (pf.pageNo >= lastDiskPage)
                         lastDiskPage = -1;       			// make lastDiskPage(Size) invalid because file size is aligned
 
-                if (prefetchPages > 0) prefetch(pageNo + 1, pageNo + 1 + prefetchPages, frameNo);
-                else if (prefetchPages < 0) prefetch(pageNo + prefetchPages, pageNo, frameNo);
+                if (prefetchPages > 0) _prefetchAhead(pageNo, prefetchPages, prefetchStride, frameNo, prefetchLevel);
+                else if (prefetchPages < 0) _prefetchAhead(pageNo, -prefetchPages, -1, frameNo, prefetchLevel);
 
 				return pf;
 
 			} else {							// cache miss
 
 				typename TPageFrame::DataStatus dataStatus = static_cast<typename TPageFrame::DataStatus>(frameNo);
+                ++stats.misses;
 				frameNo = cache.mru(testIODone(*this), maxLevel);   // try to get an undirty and READY pageframe
 				if (frameNo < 0)							// if there is none,
 					frameNo = cache.mruDirty();				// get the most recently used dirty frame
@@ -1518,8 +1617,8 @@ or @Function.openTemp@ afterwards to reach the same behaviour.
                     pf,
                     _max(getPriority(pageNo), newLevel));    // update lru order
 
-                if (prefetchPages > 0) prefetch(pageNo + 1, pageNo + 1 + prefetchPages, frameNo);
-                else if (prefetchPages < 0) prefetch(pageNo + prefetchPages, pageNo, frameNo);
+                if (prefetchPages > 0) _prefetchAhead(pageNo, prefetchPages, prefetchStride, frameNo, prefetchLevel);
+                else if (prefetchPages < 0) _prefetchAhead(pageNo, -prefetchPages, -1, frameNo, prefetchLevel);
                 
 				bool waitResult = waitFor(pf);              // wait for I/O transfer to complete
 
@@ -1531,49 +1630,81 @@ or @Function.openTemp@ afterwards to reach the same behaviour.
 			}
 		}
         
+		// random access, detects sequential and strided page accesses and prefetches the next pages
 		inline TPageFrame &getPage(int pageNo)
         {
-			return getPage(pageNo, TPageFrame::NORMAL_LEVEL, TPageFrame::NORMAL_LEVEL, 0);
+            int prefetchPages = 0;
+            int stride = pageNo - lastPageNo;
+            if (stride != 0)
+            {
+                // the demanded and prefetched pages must fit into the cache at the same time
+                if (stride == lastStride && (int)FRAMES > 2)
+                    prefetchPages = _prefetchIffAsync(_min((int)prefetchDepth, (int)FRAMES - 2), file);
+                lastPageNo = pageNo;
+                lastStride = stride;
+            }
+			return getPage(pageNo, TPageFrame::NORMAL_LEVEL, TPageFrame::NORMAL_LEVEL, prefetchPages, stride);
 		}
 
+        // start reading a page into a free page frame, returns false if there is none
+		inline bool _prefetchPage(int pageNo, int except, typename TPageFrame::Priority level)
+		{
+            int frameNo = pager[pageNo];
+            typename TPageFrame::DataStatus dataStatus = static_cast<typename TPageFrame::DataStatus>(frameNo);
+            if (dataStatus != TPageFrame::ON_DISK ||                // prefetch only if page is on disk
+                pageNo == lastDiskPage)                             // reading the last page is blocking
+                return true;
+
+            frameNo = cache.mru(
+                testIODone(*this),
+                TPageFrame::NORMAL_LEVEL);                          // choose undirty and ready page
+
+            if (frameNo < 0 || frameNo == except) return false;    // no lowlevel-page left for prefetching
+            TPageFrame &pf = cache[frameNo];
+            #ifdef SEQAN_VERBOSE
+                ::std::cerr << "prefetch: page " << pageNo << ::std::endl;
+            #endif
+
+            // *** frame is choosen ***
+
+            if (pf.begin)
+                swapOutAndWait(pf);						            // write synchronously to disk, if page is dirty
+            else
+                allocPage(pf, file);                                // allocate memory if page is virgin
+
+            // *** frame is free now ***
+
+            pf.dataStatus = dataStatus;
+            readPage(pageNo, pf, file);
+            pager[pageNo] = frameNo;					            // assign new page to page table
+            pf.pageNo = pageNo;							            // set back link
+            cache.upgrade(pf, level);                               // update lru order
+            ++stats.prefetches;
+            return true;
+		}
+
+        // prefetch the pages pageNo + i * stride for i = 1..count, nearest first
+        inline void _prefetchAhead(int pageNo, int count, int stride, int except,
+                                   typename TPageFrame::Priority level)
+        {
+            if (!file) return;
+            for (int i = 1; i <= count; ++i)
+            {
+                __int64 p = (__int64)pageNo + (__int64)i * stride;
+                if (p < 0 || p >= (__int64)length(pager) - 1) return;
+                if (!_prefetchPage((int)p, except, level)) return;
+            }
+        }
+
         // prefetch is non-blocking and should speed up swapping
 		inline void prefetch(int pageBegin, int pageEnd, int except = -1) 
 		{
             if (!file) return;
             if (pageBegin < 0)					pageBegin = 0;
             if (pageEnd >= (int)length(pager))	pageEnd = (int)length(pager) - 1;
-            for(int pageNo = pageBegin; pageNo < pageEnd; ++pageNo) {
-			    int frameNo = pager[pageNo];
-				typename TPageFrame::DataStatus dataStatus = static_cast<typename TPageFrame::DataStatus>(frameNo);
-                if (dataStatus == TPageFrame::ON_DISK &&             // prefetch only if page is on disk
-                    pageNo != lastDiskPage)                         // reading the last page is blocking
-                {   
-				    frameNo = cache.mru(
-                        testIODone(*this),
-                        TPageFrame::NORMAL_LEVEL);                   // choose undirty and ready page
-
-                    if (frameNo < 0 || frameNo == except) return;   // no lowlevel-page left for prefetching
-				    TPageFrame &pf = cache[frameNo];
-                    #ifdef SEQAN_VERBOSE
-						::std::cerr << "prefetch: page " << pageNo << ::std::endl;
-                    #endif
-
-                    // *** frame is choosen ***
-
-				    if (pf.begin)
-					    swapOutAndWait(pf);						    // write synchronously to disk, if page is dirty
-				    else
-					    allocPage(pf, file);                        // allocate memory if page is virgin
-
-    				// *** frame is free now ***
-
-    				pf.dataStatus = dataStatus;
-                    readPage(pageNo, pf, file);
-				    pager[pageNo] = frameNo;					    // assign new page to page table
-    				pf.pageNo = pageNo;							    // set back link
-                    cache.upgrade(pf, TPageFrame::PREFETCH_LEVEL);  // update lru order
-                }
-            }
+            for(int pageNo = pageBegin; pageNo < pageEnd; ++pageNo)
+                if (!_prefetchPage(pageNo, except, TPageFrame::PREFETCH_LEVEL))
+                    return;
 		}
 		
 	    template < typename T >
@@ -1586,13 +1717,21 @@ or @Function.openTemp@ afterwards to reach the same behaviour.
 			return prefetchPages;
 		}
 
+#ifndef PLATFORM_WINDOWS
+		template < typename TSpec >
+		inline static int _prefetchIffAsync(int prefetchPages, File<PReadAsync<TSpec> > const &) {
+			return prefetchPages;
+		}
+#endif
+
+        // prefetchPages is the direction of the iterator (-1, 0, 1)
 		inline TPageFrame &getSharedPage(int pageNo, int prefetchPages = 0) 
 		{
 			return getPage(
                 pageNo, 
                 TPageFrame::PREFETCH_LEVEL, 
                 TPageFrame::ITERATOR_LEVEL,
-                _prefetchIffAsync(prefetchPages, file));
+                _prefetchIffAsync(prefetchPages * (int)prefetchDepth, file));
 		}
 
 		inline void releasePage(int pageNo, bool writeThrough = false) 
@@ -1742,6 +1881,101 @@ or @Function.openTemp@ afterwards to reach the same behaviour.
     }
 //____________________________________________________________________________
 
+/*!
+ * @fn ExternalString#setPrefetchDepth
+ * @brief Set the number of pages that are read ahead of a sequential or strided access.
+ *
+ * @signature void setPrefetchDepth(str, pages);
+ *
+ * @param[in,out] str   The ExternalString to configure.
+ * @param[in]     pages The number of pages to keep in flight.  Default: <tt>FRAMES/2</tt> or 1 if <tt>FRAMES</tt> is
+ *                      smaller than 4.
+ *
+ * @section Remarks
+ *
+ * Pages are only prefetched if the file supports asynchronous I/O, e.g. <tt>File&lt;Async&lt;&gt; &gt;</tt> or
+ * <tt>File&lt;PReadAsync&lt;&gt; &gt;</tt>.  Random accesses prefetch at most <tt>FRAMES-2</tt> pages.
+ */
+
+/**
+.Function.setPrefetchDepth:
+..cat:Strings
+..summary:Set the number of pages that are read ahead of a sequential or strided access.
+..signature:setPrefetchDepth(string, pages)
+..param.string:An external string.
+...type:Spec.External String
+..param.pages:The number of pages to keep in flight.
+...default:$FRAMES/2$ or 1 if $FRAMES$ is smaller than 4.
+..remarks:Pages are only prefetched if the file supports asynchronous I/O, e.g. @Spec.Async@ or @Spec.PReadAsync@.
+Random accesses prefetch at most $FRAMES-2$ pages.
+..include:seqan/file.h
+*/
+
+    template < typename TValue, typename TConfig >
+    inline void
+    setPrefetchDepth(String<TValue, External<TConfig> > &me, unsigned pages)
+    {
+        me.prefetchDepth = pages;
+    }
+
+/*!
+ * @fn ExternalString#pagingStats
+ * @brief Returns the paging counters of an ExternalString.
+ *
+ * @signature ExternalStringStats const & pagingStats(str);
+ *
+ * @param[in] str The ExternalString to query.
+ *
+ * @return ExternalStringStats const & The counters since construction or the last call of
+ *                                     @link ExternalString#clearPagingStats @endlink.
+ */
+
+/**
+.Function.pagingStats:
+..cat:Strings
+..summary:Returns the paging counters of an external string.
+..signature:pagingStats(string)
+..param.string:An external string.
+...type:Spec.External String
+..returns:The counters since construction or the last call of @Function.clearPagingStats@.
+...type:Class.ExternalStringStats
+..include:seqan/file.h
+*/
+
+    template < typename TValue, typename TConfig >
+    inline ExternalStringStats const &
+    pagingStats(String<TValue, External<TConfig> > const &me)
+    {
+        return me.stats;
+    }
+
+/*!
+ * @fn ExternalString#clearPagingStats
+ * @brief Resets the paging counters of an ExternalString.
+ *
+ * @signature void clearPagingStats(str);
+ *
+ * @param[in,out] str The ExternalString to reset the counters of.
+ */
+
+/**
+.Function.clearPagingStats:
+..cat:Strings
+..summary:Resets the paging counters of an external string.
+..signature:clearPagingStats(string)
+..param.string:An external string.
+...type:Spec.External String
+..include:seqan/file.h
+*/
+
+    template < typename TValue, typename TConfig >
+    inline void
+    clearPagingStats(String<TValue, External<TConfig> > &me)
+    {
+        me.stats = ExternalStringStats();
+    }
+//____________________________________________________________________________
+
 	// wait until IO of every page is finished
     template < typename TValue, typename TConfig >
 	inline void 
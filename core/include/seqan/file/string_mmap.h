@@ -665,20 +665,29 @@ SEQAN_CHECKPOINT
 
 	template < typename TValue, typename TConfig >
     inline bool 
-    save(String<TValue, MMap<TConfig> > const &/*me*/, const char * /*fileName*/, int /*openMode*/) {
+    save(String<TValue, MMap<TConfig> > const &me, const char *fileName, int openMode) {
 //IOREV _nodoc_ shouldn't we flush here? in case of abnormal termination...
-		// Memory Mapped Strings are persistent, thus there is no need to save them
-		//MMapStringsDontNeedToBeSaved error;
-		return true;
+		// Memory Mapped Strings are persistent in their own file, thus there is no need to save them there
+		if (!me.mapping.temporary && _isMappedFile(me.mapping, fileName, openMode))
+			return true;
+
+		// Strings mapped to a temporary or another file, e.g. index fibres built in external memory, are written out
+		typedef typename TConfig::TFile TFile;
+		TFile file;
+		if (!open(file, fileName, openMode)) return false;
+		bool result = empty(me) || write(file, me.data_begin, length(me));
+		resize(file, (typename Size<TFile>::Type)length(me) * (typename Size<TFile>::Type)sizeof(TValue));
+		close(file);
+		return result;
 	}
 
 	template < typename TValue, typename TConfig >
     inline bool 
-    save(String<TValue, MMap<TConfig> > const &/*me*/, const char * /*fileName*/) {
+    save(String<TValue, MMap<TConfig> > const &me, const char *fileName) {
 //IOREV _nodoc_ shouldn't we flush here? in case of abnormal termination...
 		// Memory Mapped Strings are persistent, thus there is no need to save them
 		//MMapStringsDontNeedToBeSaved error;
-		return true;
+		return save(me, fileName, OPEN_WRONLY | OPEN_CREATE);
 	}
 
 	template < typename TValue, typename TConfig >
@@ -186,6 +186,9 @@ class GffStream
 {
 public:
     typedef RecordReader<std::istream, SinglePass<> > TReader_;
+#if SEQAN_HAS_ZLIB
+    typedef RecordReader<Stream<Bgzf>, SinglePass<> > TBgzfReader_;
+#endif  // #if SEQAN_HAS_ZLIB
     typedef seqan::StringSet<seqan::CharString> TNameStore;
     typedef seqan::NameStoreCache<seqan::StringSet<seqan::CharString> > TNameStoreCache;
     typedef GffIOContext<TNameStore, TNameStoreCache> TGffIOContext;
@@ -215,6 +218,12 @@ public:
     int _error;
     bool _isGood;
 
+#if SEQAN_HAS_ZLIB
+    // Bgzip compressed files are read through _bgzfReader.
+    Stream<Bgzf> _bgzfStream;
+    std::SEQAN_AUTO_PTR_NAME<TBgzfReader_> _bgzfReader;
+#endif  // #if SEQAN_HAS_ZLIB
+
     TNameStore sequenceNames;
     TNameStoreCache _sequenceNamesCache;
     TGffIOContext _context;
@@ -240,6 +249,31 @@ public:
 
         if (mode == READ)
         {
+#if SEQAN_HAS_ZLIB
+            // Bgzip compressed files start with the gzip magic number.
+            _bgzfReader.reset();
+            if (_filename != "-")
+            {
+                std::fstream inStream(filename, std::ios::binary | std::ios::in);
+                char buffer[3] = { 0, 0, 0 };
+                inStream.read(&buffer[0], 3);
+                if (buffer[0] == '\x1F' && buffer[1] == '\x8B' && buffer[2] == '\x08')
+                {
+                    _stream.reset();
+                    _reader.reset();
+                    _inStream = 0;
+                    _outStream = 0;
+                    if (!open(_bgzfStream, toCString(_filename), "r"))
+                    {
+                        _isGood = false;
+                        return false;
+                    }
+                    _bgzfReader.reset(new TBgzfReader_(_bgzfStream));
+                    return true;
+                }
+            }
+#endif  // #if SEQAN_HAS_ZLIB
+
             if (_filename == "-")
             {
                 _stream.reset();
@@ -406,7 +440,13 @@ inline void addSequenceName(GffStream & stream, CharString const & name)
 inline int readRecord(GffRecord & record,
                       GffStream & stream)
 {
-    int res = readRecord(record, *stream._reader, stream._context, Gff());
+    int res = 1;
+    if (stream._reader.get())
+        res = readRecord(record, *stream._reader, stream._context, Gff());
+#if SEQAN_HAS_ZLIB
+    else if (stream._bgzfReader.get())
+        res = readRecord(record, *stream._bgzfReader, stream._context, Gff());
+#endif  // #if SEQAN_HAS_ZLIB
     if (res != 0)
         stream._isGood = false;
     return res;
@@ -518,6 +558,15 @@ inline int flush(GffStream & stream)
 
 inline int close(GffStream & stream)
 {
+#if SEQAN_HAS_ZLIB
+    if (stream._bgzfReader.get())
+    {
+        stream._bgzfReader.reset();
+        close(stream._bgzfStream);
+        return 0;
+    }
+#endif  // #if SEQAN_HAS_ZLIB
+    // Close only when not stdout/stdin.
     if (stream._stream.get())
         stream._stream->close();
     return 0;
@@ -584,14 +633,98 @@ inline bool isGood(GffStream const & stream)
 
 inline bool atEnd(GffStream const & stream)
 {
+#if SEQAN_HAS_ZLIB
+    if (stream._bgzfReader.get())
+        return atEnd(*stream._bgzfReader);
+#endif  // #if SEQAN_HAS_ZLIB
     return atEnd(*stream._reader);
 }
 
 inline bool atEnd(GffStream & stream)
 {
+#if SEQAN_HAS_ZLIB
+    if (stream._bgzfReader.get())
+        return atEnd(*stream._bgzfReader);
+#endif  // #if SEQAN_HAS_ZLIB
     return atEnd(*stream._reader);
 }
 
+// ----------------------------------------------------------------------------
+// Function jumpToRegion()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn GffStream#jumpToRegion
+ * @brief Seek in a bgzip compressed GFF file to the first record overlapping a region.
+ *
+ * @signature bool jumpToRegion(gffStream, hasRecords, refName, pos, posEnd, index);
+ *
+ * @param[in,out] gffStream  The GffStream to seek in, opened for reading a bgzip compressed GFF file.
+ * @param[out]    hasRecords A <tt>bool</tt> that is set to <tt>true</tt> if there are records overlapping the region.
+ * @param[in]     refName    The name of the sequence.
+ * @param[in]     pos        The 0-based begin of the region.
+ * @param[in]     posEnd     The 0-based end of the region (exclusive).
+ * @param[in]     index      The @link TabixIndex @endlink of the file.
+ *
+ * @return bool <tt>true</tt> if seeking was successful, <tt>false</tt> if not.
+ *
+ * @section Remarks
+ *
+ * The records following the first overlapping record are not necessarily overlapping the region, the caller has to
+ * filter them and can stop at the first record beginning behind <tt>posEnd</tt>.  Only available if zlib is available.
+ */
+
+/**
+.Function.GffStream#jumpToRegion
+..class:Class.GffStream
+..cat:GFF I/O
+..summary:Seek in a bgzip compressed GFF file to the first record overlapping a region.
+..signature:bool jumpToRegion(gffStream, hasRecords, refName, pos, posEnd, index)
+..param.gffStream:The @Class.GffStream@ to seek in, opened for reading a bgzip compressed GFF file.
+...type:Class.GffStream
+..param.hasRecords:Set to $true$ iff there are records overlapping the region.
+...type:nolink:$bool$
+..param.refName:The name of the sequence.
+..param.pos:Zero-based begin position of the region.
+...type:nolink:$__int32$
+..param.posEnd:Zero-based (exclusive, C-style) end position of the region.
+...type:nolink:$__int32$
+..param.index:The index of the file.
+...type:Class.TabixIndex
+..returns:$true$ if seeking was successful, $false$ if not.
+..remarks:The records following the first overlapping record are not necessarily overlapping the region, the caller has to filter them and can stop at the first record beginning behind $posEnd$.
+Only available if zlib is available.
+..include:seqan/gff_io.h
+*/
+
+#if SEQAN_HAS_ZLIB
+template <typename TName>
+inline bool jumpToRegion(GffStream & stream,
+                         bool & hasRecords,
+                         TName const & refName,
+                         __int32 pos,
+                         __int32 posEnd,
+                         TabixIndex const & index)
+{
+    hasRecords = false;
+    if (!stream._bgzfReader.get())
+        return false;  // Only bgzip compressed files can be indexed.
+
+    __int32 refId = 0;
+    if (!getIdByName(index, refName, refId))
+        return true;  // No records on this sequence.
+    if (!jumpToRegion(stream._bgzfStream, hasRecords, refId, pos, posEnd, index))
+    {
+        stream._isGood = false;
+        return false;
+    }
+
+    // The record reader has buffered data from the old position.
+    stream._bgzfReader.reset(new GffStream::TBgzfReader_(stream._bgzfStream));
+    return true;
+}
+#endif  // #if SEQAN_HAS_ZLIB
+
 }  // namespace seqan
 
 #endif  // #ifndef SEQAN_EXTRAS_INCLUDE_SEQAN_GFF_IO_GFF_STREAM_H_
@@ -560,8 +560,9 @@ getAlignmentStatistics(String<TFragment, TSpec1> const& matches,
 	TFragIter itFragEnd = itFrag;
 	itFrag += from;
 	itFragEnd += to;
-	TId id1 = sequenceId(*itFrag, 0);
-	TId id2 = sequenceId(*itFrag, 1);
+	// Pairs without any match have no fragment to take the ids from
+	TId id1 = (from < to) ? sequenceId(*itFrag, 0) : 0;
+	TId id2 = (from < to) ? sequenceId(*itFrag, 1) : 0;
 	TSize fragLen = 0;
 	TSize beginI = 0;
 	TSize beginJ = 0;
@@ -588,6 +589,64 @@ getAlignmentStatistics(String<TFragment, TSpec1> const& matches,
 	overlapLength = alignLength -  minId1 - minId2 - (len1 + len2 - maxId1 - maxId2);
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// Parallel Segment Match Generation
+//////////////////////////////////////////////////////////////////////////////
+
+// The pairs of a library are split into more blocks than there are threads for load balancing.  Each block collects
+// its segment matches and scores in its own buffers.  The buffers are appended in block order, so the library does
+// not depend on the number of threads.
+
+template<typename TSize>
+inline TSize
+_libraryBlockCount(TSize numPairs)
+{
+	SEQAN_CHECKPOINT
+	return _min(numPairs, (TSize) (8 * omp_get_max_threads()));
+}
+
+// Adding edges to a distance graph is not thread-safe, these libraries use one block.
+
+template<typename TSize, typename TDistance>
+inline TSize
+_libraryBlockCount(TSize numPairs, TDistance const&)
+{
+	SEQAN_CHECKPOINT
+	return _libraryBlockCount(numPairs);
+}
+
+template<typename TSize, typename TCargo, typename TSpec>
+inline TSize
+_libraryBlockCount(TSize numPairs, Graph<Undirected<TCargo, TSpec> > const&)
+{
+	SEQAN_CHECKPOINT
+	return _min(numPairs, (TSize) 1);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template<typename TSegmentMatches, typename TScores>
+inline void
+_appendLibraryBlocks(TSegmentMatches& matches,
+					 TScores& scores,
+					 String<TSegmentMatches>& blockMatches,
+					 String<TScores>& blockScores)
+{
+	SEQAN_CHECKPOINT
+	typedef typename Size<TSegmentMatches>::Type TSize;
+
+	TSize total = length(matches);
+	for(TSize b = 0; b < length(blockMatches); ++b) total += length(blockMatches[b]);
+	reserve(matches, total, Exact());
+	reserve(scores, total, Exact());
+	for(TSize b = 0; b < length(blockMatches); ++b) {
+		append(matches, blockMatches[b]);
+		append(scores, blockScores[b]);
+		clear(blockMatches[b]);
+		clear(blockScores[b]);
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // Segment Match Generation
 //////////////////////////////////////////////////////////////////////////////
@@ -609,34 +668,45 @@ appendSegmentMatches(StringSet<TString, Dependent<TSpec> > const& str,
 	typedef typename Id<TStringSet>::Type TId;
 	//typedef typename Value<TSegmentMatches>::Type TFragment;
 	//typedef typename Value<TScores>::Type TScoreValue;
-	typedef typename Iterator<TPairList const, Standard>::Type TPairIter;
-
-	// Pairwise longest common subsequence
-	TPairIter itPair = begin(pList, Standard());
-	TPairIter itPairEnd = end(pList, Standard());
-	for(;itPair != itPairEnd; ++itPair) {
-		TStringSet pairSet;
-		TId id1 = positionToId(str, *itPair); ++itPair;
-		TId id2 = positionToId(str, *itPair);
-		assignValueById(pairSet, const_cast<TStringSet&>(str), id1);
-		assignValueById(pairSet, const_cast<TStringSet&>(str), id2);
-
-		// Lcs between first and second string
-		TSize from = length(matches);
-		globalAlignment(matches, pairSet, Lcs());
-		TSize to = length(matches);
-
-		// Record the scores
-		resize(scores, to);
-		typedef typename Iterator<TSegmentMatches, Standard>::Type TMatchIter;
-		typedef typename Iterator<TScores, Standard>::Type TScoreIter;
-		TScoreIter itScore = begin(scores, Standard());
-		TScoreIter itScoreEnd = end(scores, Standard());
-		TMatchIter itMatch = begin(matches, Standard());
-		itScore+=from;
-		itMatch+=from;
-		for(;itScore != itScoreEnd; ++itScore, ++itMatch) *itScore = (*itMatch).len;
+	typedef typename Size<TPairList>::Type TPairSize;
+
+	// Pairwise longest common subsequences, computed blockwise in parallel
+	TPairSize numPairs = length(pList) / 2;
+	Splitter<TPairSize> splitter(0, numPairs, _libraryBlockCount(numPairs));
+	String<TSegmentMatches> blockMatches;
+	String<TScores> blockScores;
+	resize(blockMatches, length(splitter));
+	resize(blockScores, length(splitter));
+
+	SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+	for(int job = 0; job < (int) length(splitter); ++job) {
+		TSegmentMatches& myMatches = blockMatches[job];
+		TScores& myScores = blockScores[job];
+		for(TPairSize p = splitter[job]; p < splitter[job + 1]; ++p) {
+			TStringSet pairSet;
+			TId id1 = positionToId(str, pList[2 * p]);
+			TId id2 = positionToId(str, pList[2 * p + 1]);
+			assignValueById(pairSet, const_cast<TStringSet&>(str), id1);
+			assignValueById(pairSet, const_cast<TStringSet&>(str), id2);
+
+			// Lcs between first and second string
+			TSize from = length(myMatches);
+			globalAlignment(myMatches, pairSet, Lcs());
+			TSize to = length(myMatches);
+
+			// Record the scores
+			resize(myScores, to);
+			typedef typename Iterator<TSegmentMatches, Standard>::Type TMatchIter;
+			typedef typename Iterator<TScores, Standard>::Type TScoreIter;
+			TScoreIter itScore = begin(myScores, Standard());
+			TScoreIter itScoreEnd = end(myScores, Standard());
+			TMatchIter itMatch = begin(myMatches, Standard());
+			itScore+=from;
+			itMatch+=from;
+			for(;itScore != itScoreEnd; ++itScore, ++itMatch) *itScore = (*itMatch).len;
+		}
 	}
+	_appendLibraryBlocks(matches, scores, blockMatches, blockScores);
 }
 
 
@@ -742,21 +812,30 @@ appendSegmentMatches(StringSet<TString, Dependent<TSpec> > const& str,
 	typedef String<TSize2, TSpec2> TPairList;
 	//typedef typename Size<TStringSet>::Type TSize;
 	typedef typename Id<TStringSet>::Type TId;
-	typedef typename Iterator<TPairList const, Standard>::Type TPairIter;
-
-	// Pairwise alignments
-	TPairIter itPair = begin(pList, Standard());
-	TPairIter itPairEnd = end(pList, Standard());
-	for(;itPair != itPairEnd; ++itPair) {
-		// Make a pairwise string-set
-		TStringSet pairSet;
-		TId id1 = positionToId(str, *itPair); ++itPair;
-		TId id2 = positionToId(str, *itPair);
-		assignValueById(pairSet, const_cast<TStringSet&>(str), id1);
-		assignValueById(pairSet, const_cast<TStringSet&>(str), id2);
-
-		_multiLocalAlignment(pairSet, matches, scores, score_type, 4, SmithWatermanClump());
+	typedef typename Size<TPairList>::Type TPairSize;
+
+	// Pairwise alignments, computed blockwise in parallel
+	TPairSize numPairs = length(pList) / 2;
+	Splitter<TPairSize> splitter(0, numPairs, _libraryBlockCount(numPairs));
+	String<TSegmentMatches> blockMatches;
+	String<TScores> blockScores;
+	resize(blockMatches, length(splitter));
+	resize(blockScores, length(splitter));
+
+	SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+	for(int job = 0; job < (int) length(splitter); ++job) {
+		for(TPairSize p = splitter[job]; p < splitter[job + 1]; ++p) {
+			// Make a pairwise string-set
+			TStringSet pairSet;
+			TId id1 = positionToId(str, pList[2 * p]);
+			TId id2 = positionToId(str, pList[2 * p + 1]);
+			assignValueById(pairSet, const_cast<TStringSet&>(str), id1);
+			assignValueById(pairSet, const_cast<TStringSet&>(str), id2);
+
+			_multiLocalAlignment(pairSet, blockMatches[job], blockScores[job], score_type, 4, SmithWatermanClump());
+		}
 	}
+	_appendLibraryBlocks(matches, scores, blockMatches, blockScores);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -880,39 +959,50 @@ appendSegmentMatches(StringSet<TString, Dependent<TSpec> > const& str,
 	typedef typename Id<TStringSet>::Type TId;
 	typedef typename Size<TStringSet>::Type TSize;
 	typedef typename Value<TScoreValues>::Type TScoreValue;
-	typedef typename Iterator<String<TSize2, TSpec2> const, Standard>::Type TPairIter;
+	typedef typename Size<String<TSize2, TSpec2> >::Type TPairSize;
 
 	// Initialization
 	TSize nseq = length(str);
 	_resizeWithRespectToDistance(dist, nseq);
 	
-	// Pairwise alignments
-	TPairIter itPair = begin(pList, Standard());
-	TPairIter itPairEnd = end(pList, Standard());
-	for(;itPair != itPairEnd; ++itPair) {
-		// Make a pairwise string-set
-		TStringSet pairSet;
-		TId id1 = positionToId(str, *itPair); ++itPair;
-		TId id2 = positionToId(str, *itPair);
-		assignValueById(pairSet, const_cast<TStringSet&>(str), id1);
-		assignValueById(pairSet, const_cast<TStringSet&>(str), id2);
-				
-		// Alignment
-		TSize from = length(matches);
-		TScoreValue myScore = globalAlignment(matches, pairSet, score_type, ac, Gotoh() );
-		TSize to = length(matches);
-
-		// Record the scores
-		resize(scores, to);
-		typedef typename Iterator<TScoreValues, Standard>::Type TScoreIter;
-		TScoreIter itScore = begin(scores, Standard());
-		TScoreIter itScoreEnd = end(scores, Standard());
-		itScore+=from;
-		for(;itScore != itScoreEnd; ++itScore) *itScore = myScore;
-			
-		// Get the alignment statistics
-		_setDistanceValue(matches, pairSet, dist, (TSize) *(itPair-1), (TSize) *itPair, (TSize) nseq, (TSize)from);
+	// Pairwise alignments, computed blockwise in parallel
+	TPairSize numPairs = length(pList) / 2;
+	Splitter<TPairSize> splitter(0, numPairs, _libraryBlockCount(numPairs, dist));
+	String<TSegmentMatches> blockMatches;
+	String<TScoreValues> blockScores;
+	resize(blockMatches, length(splitter));
+	resize(blockScores, length(splitter));
+
+	SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+	for(int job = 0; job < (int) length(splitter); ++job) {
+		TSegmentMatches& myMatches = blockMatches[job];
+		TScoreValues& myScores = blockScores[job];
+		for(TPairSize p = splitter[job]; p < splitter[job + 1]; ++p) {
+			// Make a pairwise string-set
+			TStringSet pairSet;
+			TId id1 = positionToId(str, pList[2 * p]);
+			TId id2 = positionToId(str, pList[2 * p + 1]);
+			assignValueById(pairSet, const_cast<TStringSet&>(str), id1);
+			assignValueById(pairSet, const_cast<TStringSet&>(str), id2);
+
+			// Alignment
+			TSize from = length(myMatches);
+			TScoreValue myScore = globalAlignment(myMatches, pairSet, score_type, ac, Gotoh() );
+			TSize to = length(myMatches);
+
+			// Record the scores
+			resize(myScores, to);
+			typedef typename Iterator<TScoreValues, Standard>::Type TScoreIter;
+			TScoreIter itScore = begin(myScores, Standard());
+			TScoreIter itScoreEnd = end(myScores, Standard());
+			itScore+=from;
+			for(;itScore != itScoreEnd; ++itScore) *itScore = myScore;
+
+			// Get the alignment statistics, each pair has its own entry in the distance matrix
+			_setDistanceValue(myMatches, pairSet, dist, (TSize) pList[2 * p], (TSize) pList[2 * p + 1], (TSize) nseq, (TSize)from);
+		}
 	}
+	_appendLibraryBlocks(matches, scores, blockMatches, blockScores);
 }
 
 
@@ -177,18 +177,37 @@ progressiveAlignment(Graph<Alignment<TStringSet, TCargo, TSpec> >& g,
 	for(;!atEnd(bfsIt);goNext(bfsIt), --itVertEnd) 
 		*itVertEnd = *bfsIt;
 
-	// Progressive alignment
+	// Group the vertices by their height in the guide tree, children always come before their parent
+	String<TSize> height;
+	resize(height, nVertices, 0);
+	String<TVertexString> levels;
 	itVert = begin(vertices, Standard());
 	itVertEnd = end(vertices, Standard());
 	for(;itVert != itVertEnd; ++itVert) {
-		if(isLeaf(tree, *itVert)) _buildLeafString(g, *itVert, segString[*itVert]);
-		else {
-			// Align the two children (Binary tree)
+		if(!isLeaf(tree, *itVert)) {
 			TAdjacencyIterator adjIt(tree, *itVert);
-			TVertexDescriptor child1 = *adjIt; goNext(adjIt);
-			heaviestCommonSubsequence(g, segString[child1], segString[*adjIt], segString[*itVert]);
-			clear(segString[child1]);
-			clear(segString[*adjIt]);
+			for(;!atEnd(adjIt);goNext(adjIt)) 
+				if (height[*itVert] < height[*adjIt] + 1) height[*itVert] = height[*adjIt] + 1;
+		}
+		if (length(levels) <= height[*itVert]) resize(levels, height[*itVert] + 1);
+		appendValue(levels[height[*itVert]], *itVert);
+	}
+
+	// Progressive alignment, the subtrees of one level are independent and are aligned in parallel
+	for(TSize level = 0; level < length(levels); ++level) {
+		TVertexString const& levelVertices = levels[level];
+		SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+		for(int i = 0; i < (int) length(levelVertices); ++i) {
+			TVertexDescriptor v = levelVertices[i];
+			if(isLeaf(tree, v)) _buildLeafString(g, v, segString[v]);
+			else {
+				// Align the two children (Binary tree)
+				TAdjacencyIterator adjIt(tree, v);
+				TVertexDescriptor child1 = *adjIt; goNext(adjIt);
+				heaviestCommonSubsequence(g, segString[child1], segString[*adjIt], segString[v]);
+				clear(segString[child1]);
+				clear(segString[*adjIt]);
+			}
 		}
 	}
 
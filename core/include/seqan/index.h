@@ -77,6 +77,7 @@
 #include <seqan/index/shape_onegapped.h>
 #include <seqan/index/shape_predefined.h>
 #include <seqan/index/shape_threshold.h>
+#include <seqan/index/shape_bulk.h>
 #include <seqan/index/index_qgram.h>
 #include <seqan/index/index_qgram_openaddressing.h>
 //#include <seqan/index/index_qgram_nested.h>
@@ -118,6 +119,7 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include <seqan/index/index_shims.h>
+#include <seqan/index/index_file_header.h>
 
 //____________________________________________________________________________
 // (virtual) string trees
@@ -175,9 +177,11 @@
 // #include <seqan/index/index_fm_wavelet_tree.h>
 #include <seqan/index/index_fm_rank_dictionary_wt.h>
 #include <seqan/index/index_fm_rank_dictionary_bms.h>
+#include <seqan/index/index_fm_rank_dictionary_clb.h>
 #include <seqan/index/index_fm_sentinel_rank_dictionary.h>
 #include <seqan/index/index_fm_lf_table.h>
 #include <seqan/index/index_fm.h>
+#include <seqan/index/index_fm_blockwise.h>
 #include <seqan/index/index_fm_stree.h>
 
 #endif //#ifndef SEQAN_HEADER_...
@@ -169,6 +169,7 @@ struct DefaultIndexSpec
 ..param.TIndex:An @Class.Index@ Type.
 ..returns:If the underlying text is a @Class.String@ or a set of Strings (see @Class.StringSet@) the String's spec. type is returned.
 ..remarks:Most of the @Class.Index@ fibres are strings. The @Class.String@ specialization type is chosen by this meta-function.
+..remarks:If the text is a @Spec.MMap String@, the fibres are memory mapped strings as well and @Function.open@ maps saved fibre files in place instead of reading them into memory.
 ..include:seqan/index.h
 */
 
@@ -188,6 +189,10 @@ struct DefaultIndexSpec
  *
  * Most of the @link Index @endlink fibres are strings. The @link String
  * @endlink specialization type is chosen by this meta-function.
+ *
+ * If the text is a @link MMapString @endlink, the fibres are memory mapped
+ * strings as well and <tt>open</tt> maps saved fibre files in place instead
+ * of reading them into memory.
  */
 // default which should actually never been used
 template <typename TIndex>
@@ -202,6 +207,12 @@ struct DefaultIndexStringSpec<String<TValue, External<TSpec> > >
     typedef External<TSpec> Type;
 };
 
+template <typename TValue, typename TConfig>
+struct DefaultIndexStringSpec<String<TValue, MMap<TConfig> > >
+{
+    typedef MMap<TConfig> Type;
+};
+
 template <typename TString, typename TSpec>
 struct DefaultIndexStringSpec<StringSet<TString, TSpec> >:
     DefaultIndexStringSpec<TString>{};
@@ -2022,8 +2033,11 @@ inline typename Fibre<Index<TText, TSpec> const, FibreChildtab>::Type & indexChi
 ...remarks:To create or overwrite a file add $OPEN_CREATE$.
 ...remarks:To append a file if existing add $OPEN_APPEND$.
 ...remarks:To circumvent problems, files are always opened in binary mode.
+...remarks:To open an index placed into POSIX shared memory by @Function.Index#save@ add $OPEN_SHARED_MEMORY$.
 ...default:$OPEN_RDWR | OPEN_CREATE | OPEN_APPEND$
 ..returns:A $bool$ which is $true$ on success.
+..remarks:If the text is a @Spec.MMap String@ and the index is opened with $OPEN_RDONLY | OPEN_SHARED_MEMORY$,
+the fibres point into the shared memory objects and all processes share a single copy of the index.
 ..include:seqan/index.h
 ..example
 ...text:The following code shows how the function @Function.open@ is used with indices.
@@ -2039,7 +2053,8 @@ inline typename Fibre<Index<TText, TSpec> const, FibreChildtab>::Type & indexChi
  * @param mode The combination of flags defining how the file should be opened.To open a file read-only, write-only or
  *             to read and write use <tt>OPEN_RDONLY</tt>, <tt>OPEN_WRONLY</tt>, or <tt>OPEN_RDWR</tt>.To create or
  *             overwrite a file add <tt>OPEN_CREATE</tt>.To append a file if existing add <tt>OPEN_APPEND</tt>.To
- *             circumvent problems, files are always opened in binary mode.
+ *             circumvent problems, files are always opened in binary mode.  To open an index placed into
+ *             POSIX shared memory add <tt>OPEN_SHARED_MEMORY</tt>.
  *             Default: <tt>OPEN_RDWR | OPEN_CREATE | OPEN_APPEND</tt>
  *
  * @param index The index to be opened.
@@ -2065,7 +2080,8 @@ inline typename Fibre<Index<TText, TSpec> const, FibreChildtab>::Type & indexChi
  * @param mode The combination of flags defining how the file should be opened.To open a file read-only, write-only or
  *             to read and write use <tt>OPEN_RDONLY</tt>, <tt>OPEN_WRONLY</tt>, or <tt>OPEN_RDWR</tt>.To create or
  *             overwrite a file add <tt>OPEN_CREATE</tt>.To append a file if existing add <tt>OPEN_APPEND</tt>.To
- *             circumvent problems, files are always opened in binary mode.
+ *             circumvent problems, files are always opened in binary mode.  Add <tt>OPEN_SHARED_MEMORY</tt> to
+ *             write every fibre into a POSIX shared memory object named <tt>fileName</tt> + fibre suffix.
  *             Default: <tt>OPEN_RDWR | OPEN_CREATE | OPEN_APPEND</tt>
  *
  * @param index The index to be saved to disk.
@@ -2091,6 +2107,8 @@ inline typename Fibre<Index<TText, TSpec> const, FibreChildtab>::Type & indexChi
 ...remarks:To create or overwrite a file add $OPEN_CREATE$.
 ...remarks:To append a file if existing add $OPEN_APPEND$.
 ...remarks:To circumvent problems, files are always opened in binary mode.
+...remarks:Add $OPEN_SHARED_MEMORY$ to write every fibre into a POSIX shared memory object named $fileName$ + fibre suffix,
+e.g. $/hg19.sa$. The objects persist until they are removed with @Function.removeSharedMemory@.
 ...default:$OPEN_RDWR | OPEN_CREATE | OPEN_APPEND$
 ..returns:A $bool$ which is $true$ on success.
 ..include:seqan/index.h
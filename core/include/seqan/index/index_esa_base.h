@@ -602,6 +602,11 @@ information of the suffix tree) are provided.
 		const char *fileName,
 		int openMode)
 	{
+		typedef typename SAValue<Index< TObject, IndexEsa<TSpec> > >::Type TSAValue;
+
+		// reject fibre files that don't match the header written by save()
+		if (!_checkIndexFileHeader(fileName, sizeof(TSAValue), openMode)) return false;
+
 		String<char> name;
 
 		name = fileName;	append(name, ".txt");
@@ -640,6 +645,8 @@ information of the suffix tree) are provided.
 		const char *fileName,
 		int openMode)
 	{
+		typedef typename SAValue<Index< TObject, IndexEsa<TSpec> > >::Type TSAValue;
+
 		String<char> name;
 
 		name = fileName;	append(name, ".txt");	
@@ -658,7 +665,8 @@ information of the suffix tree) are provided.
 		name = fileName;	append(name, ".bwt");
         if (!save(getFibre(index, EsaBwt()), toCString(name), openMode)) return false;
 
-		return true;
+		static char const * const suffixes[] = { ".txt", ".txt.concat", ".txt.limits", ".sa", ".lcp", ".child", ".bwt" };
+		return _saveIndexFileHeader(fileName, suffixes, 7, 3, sizeof(TSAValue), openMode);
 	}
 	template < typename TObject, typename TSpec >
 	inline bool save(
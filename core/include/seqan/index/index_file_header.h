@@ -0,0 +1,211 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Header file written next to the fibre files of a saved index.  It stores
+// a format version and the sizes of the fibre files such that open() can
+// reject truncated, mixed or incompatible index files before mapping them.
+// ==========================================================================
+
+//SEQAN_NO_DDDOC:do not generate documentation for this file
+
+#ifndef INDEX_FILE_HEADER_H_
+#define INDEX_FILE_HEADER_H_
+
+namespace seqan {
+
+// ==========================================================================
+// Classes
+// ==========================================================================
+
+// ----------------------------------------------------------------------------
+// Class IndexFileHeader_
+// ----------------------------------------------------------------------------
+
+// Every fibre is stored as a raw array in a file of its own.  The files are mapped at offset 0 and hence page aligned
+// such that a String<TValue, MMap<> > fibre can be used in place.  The header is stored in <fileName>.hdr.
+
+struct IndexFileHeaderFibre_
+{
+    // The suffix appended to the index file name, e.g. ".sa".
+    char suffix[24];
+    // The size of the fibre file in bytes.
+    __uint64 size;
+};
+
+struct IndexFileHeader_
+{
+    enum
+    {
+        VERSION = 1,
+        MAX_FIBRES = 16
+    };
+
+    char magic[8];
+    __uint32 version;
+    // The sizeof(TSAValue) values for suffix array entries.
+    __uint32 sizeOfSAEntry;
+    __uint32 numFibres;
+    __uint32 reserved;
+    IndexFileHeaderFibre_ fibres[MAX_FIBRES];
+    // FNV-1a hash of all preceding bytes.
+    __uint64 checksum;
+};
+
+// ==========================================================================
+// Functions
+// ==========================================================================
+
+// ----------------------------------------------------------------------------
+// Function _indexFileHeaderChecksum()
+// ----------------------------------------------------------------------------
+
+inline __uint64
+_indexFileHeaderChecksum(IndexFileHeader_ const & header)
+{
+    unsigned char const * ptr = reinterpret_cast<unsigned char const *>(&header);
+    unsigned char const * ptrEnd = reinterpret_cast<unsigned char const *>(&header.checksum);
+
+    __uint64 hash = 14695981039346656037ull;
+    for (; ptr != ptrEnd; ++ptr)
+        hash = (hash ^ *ptr) * 1099511628211ull;
+    return hash;
+}
+
+// ----------------------------------------------------------------------------
+// Function _indexFileSize()
+// ----------------------------------------------------------------------------
+
+// Returns false if the file does not exist.  Only the OPEN_SHARED_MEMORY flag of openMode is used.
+
+inline bool
+_indexFileSize(__uint64 & fileSize, const char * fileName, int openMode)
+{
+    File<> file;
+    if (!open(file, fileName, OPEN_RDONLY | OPEN_QUIET | (openMode & OPEN_SHARED_MEMORY)))
+        return false;
+    fileSize = size(file);
+    close(file);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function _saveIndexFileHeader()
+// ----------------------------------------------------------------------------
+
+// Write the header for the fibre files <fileName><suffix>.  The first numTextSuffixes suffixes belong to the text,
+// which is saved either as .txt or as .txt.concat and .txt.limits, at least one of them must exist.  All other fibre
+// files must exist, otherwise false is returned and no header is written.
+
+inline bool
+_saveIndexFileHeader(const char * fileName, char const * const * suffixes, unsigned numSuffixes,
+                     unsigned numTextSuffixes, unsigned sizeOfSAEntry, int openMode)
+{
+    String<IndexFileHeader_> headerString;
+    resize(headerString, 1);
+    IndexFileHeader_ & header = headerString[0];
+    memset(&header, 0, sizeof(IndexFileHeader_));
+
+    memcpy(header.magic, "SEQANIDX", 8);
+    header.version = IndexFileHeader_::VERSION;
+    header.sizeOfSAEntry = sizeOfSAEntry;
+
+    String<char> name;
+    bool textFound = (numTextSuffixes == 0);
+    for (unsigned i = 0; i < numSuffixes; ++i)
+    {
+        __uint64 fileSize;
+        name = fileName;    append(name, suffixes[i]);
+        if (!_indexFileSize(fileSize, toCString(name), openMode))
+        {
+            if (i < numTextSuffixes)
+                continue;
+            return false;       // a fibre was not saved
+        }
+        if (i < numTextSuffixes)
+            textFound = true;
+
+        SEQAN_ASSERT_LT(header.numFibres, (unsigned)IndexFileHeader_::MAX_FIBRES);
+        SEQAN_ASSERT_LT(strlen(suffixes[i]), sizeof(header.fibres[0].suffix));
+        IndexFileHeaderFibre_ & fibre = header.fibres[header.numFibres++];
+        strncpy(fibre.suffix, suffixes[i], sizeof(fibre.suffix) - 1);
+        fibre.size = fileSize;
+    }
+    if (!textFound)
+        return false;
+    header.checksum = _indexFileHeaderChecksum(header);
+
+    name = fileName;    append(name, ".hdr");
+    return save(headerString, toCString(name), openMode);
+}
+
+// ----------------------------------------------------------------------------
+// Function _checkIndexFileHeader()
+// ----------------------------------------------------------------------------
+
+// Returns false if the header does not match the fibre files.  Indices saved without a header are accepted.
+
+inline bool
+_checkIndexFileHeader(const char * fileName, unsigned sizeOfSAEntry, int openMode)
+{
+    String<char> name;
+    name = fileName;    append(name, ".hdr");
+
+    __uint64 fileSize;
+    if (!_indexFileSize(fileSize, toCString(name), openMode))
+        return true;
+    if (fileSize != sizeof(IndexFileHeader_))
+        return false;
+
+    String<IndexFileHeader_> headerString;
+    if (!open(headerString, toCString(name), OPEN_RDONLY | (openMode & OPEN_SHARED_MEMORY)) ||
+        length(headerString) != 1)
+        return false;
+    IndexFileHeader_ const & header = headerString[0];
+
+    if (memcmp(header.magic, "SEQANIDX", 8) != 0 ||
+        header.version > IndexFileHeader_::VERSION ||
+        header.checksum != _indexFileHeaderChecksum(header) ||
+        header.sizeOfSAEntry != sizeOfSAEntry ||
+        header.numFibres > IndexFileHeader_::MAX_FIBRES)
+        return false;
+
+    for (unsigned i = 0; i < header.numFibres; ++i)
+    {
+        name = fileName;    append(name, header.fibres[i].suffix);
+        if (!_indexFileSize(fileSize, toCString(name), openMode) || fileSize != header.fibres[i].size)
+            return false;
+    }
+    return true;
+}
+
+}
+
+#endif  // INDEX_FILE_HEADER_H_
@@ -180,6 +180,20 @@ struct Fibre<Index<StringSet<TText, TStringSetSpec>, FMIndex<SBM<TWaveletTreeSpe
     typedef SentinelRankDictionary<RankDictionary<SequenceBitMask<TValue_> >, Sentinels> Type;
 };
 
+template <typename TText, typename TCacheLineBlocksSpec, typename TSpec>
+struct Fibre<Index<TText, FMIndex<CLB<TCacheLineBlocksSpec>, TSpec> >, FibreOccTable>
+{
+    typedef typename Value<TText>::Type TValue_;
+    typedef SentinelRankDictionary<RankDictionary<CacheLineBlocks<TValue_> >, Sentinel> Type;
+};
+
+template <typename TText, typename TStringSetSpec, typename TCacheLineBlocksSpec, typename TSpec>
+struct Fibre<Index<StringSet<TText, TStringSetSpec>, FMIndex<CLB<TCacheLineBlocksSpec>, TSpec > >, FibreOccTable>
+{
+    typedef typename Value<TText>::Type TValue_;
+    typedef SentinelRankDictionary<RankDictionary<CacheLineBlocks<TValue_> >, Sentinels> Type;
+};
+
 template <typename TText, typename TOccSpec, typename TSpec>
 struct Fibre<Index<TText, FMIndex<TOccSpec, TSpec> >, FibreLfTable>
 {
@@ -216,7 +230,8 @@ template <typename TText, typename TOccSpec, typename TSpec>
 struct Fibre<Index<TText, FMIndex<TOccSpec, TSpec> >, FibreSA>
 {
 	typedef typename SAValue<Index<TText, FMIndex<TOccSpec, TSpec> > >::Type                TSAValue_;
-	typedef SparseString<String<TSAValue_>, void>                                           TSparseString_;
+	typedef typename DefaultIndexStringSpec<Index<TText, FMIndex<TOccSpec, TSpec> > >::Type  TSAStringSpec_;
+	typedef SparseString<String<TSAValue_, TSAStringSpec_>, void>                           TSparseString_;
 	typedef typename Fibre<Index<TText, FMIndex<TOccSpec, TSpec> >, FibreLfTable>::Type     TLfTable_;
 	typedef CompressedSA<TSparseString_, TLfTable_, void>                                   Type;
 };
@@ -799,6 +814,9 @@ inline void _range(const Index<TText, FMIndex<TOccSpec, TSpec> > & index, const
 ...remarks:To circumvent problems, files are always opened in binary mode.
 ...default:$OPEN_RDWR | OPEN_CREATE | OPEN_APPEND$
 ..returns:A $bool$ which is $true$ on success.
+..remarks:If the text is a @Spec.MMap String@, the text and the suffix array samples are mapped in place.
+Open them with $OPEN_RDONLY$ to share the pages between processes using the same index.
+..remarks:Returns $false$ if the files don't match the header written by @Function.Index#save@.
 ..include:seqan/index.h
 */
 
@@ -808,9 +826,12 @@ inline bool open(Index<TText, FMIndex<TOccSpec, TSpec> > & index, const char * f
 {
     String<char> name;
 
-//    typedef Index<TText, FMIndex<TOccSpec, TSpec> > TIndex;
-//    typedef typename Fibre<TIndex, FibreSA>::Type TSAFibre;
-//    typedef typename Value<TSAFibre>::Type TSAValue;
+    typedef Index<TText, FMIndex<TOccSpec, TSpec> > TIndex;
+    typedef typename Fibre<TIndex, FibreSA>::Type TSAFibre;
+    typedef typename Value<TSAFibre>::Type TSAValue;
+
+    // Reject fibre files that don't match the header written by save().
+    if (!_checkIndexFileHeader(fileName, sizeof(TSAValue), openMode)) return false;
 
     String<FmIndexInfo_> infoString;
 
@@ -899,7 +920,10 @@ inline bool save(Index<TText, FMIndex<TOccSpec, TSpec> > const & index, const ch
     name = fileName;    append(name, ".fma");
     if (!save(infoString, toCString(name), openMode)) return false;
 
-    return true;
+    static char const * const suffixes[] = { ".txt", ".txt.concat", ".txt.limits", ".sa.val", ".fma" };
+    if (IsSameType<TSpec, CompressText>::VALUE)
+        return _saveIndexFileHeader(fileName, suffixes + 3, 2, 0, sizeof(TSAValue), openMode);
+    return _saveIndexFileHeader(fileName, suffixes, 5, 3, sizeof(TSAValue), openMode);
 }
 
 // This function can be used to save an index on disk.
@@ -0,0 +1,741 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Memory-bounded construction of the FM index. The suffixes are partitioned
+// into buckets by a sorted sample of splitter suffixes. Groups of buckets
+// fitting into the memory limit are sorted one after another and streamed
+// directly into the BWT and the compressed suffix array, such that the
+// complete suffix array is never materialized. Suffix comparisons are
+// bounded by a difference cover sample.
+// ==========================================================================
+
+#ifndef INDEX_FM_BLOCKWISE_H_
+#define INDEX_FM_BLOCKWISE_H_
+
+namespace seqan {
+
+// ==========================================================================
+// Tags, Classes, Enums
+// ==========================================================================
+
+// ----------------------------------------------------------------------------
+// Class BlockwiseBwt
+// ----------------------------------------------------------------------------
+
+/**
+.Class.BlockwiseBwt
+..cat:Index
+..summary:Selects the memory-bounded construction of a @Spec.FMIndex@.
+..signature:BlockwiseBwt
+..remarks:The suffix array is never built as a whole. Instead, the suffixes are sorted in blocks whose suffix array
+entries fit into $maxMemory$ bytes and each sorted block is directly turned into the corresponding part of the
+BWT and the compressed suffix array. The memory needed for the text, the BWT and the resulting index is not covered
+by this limit. On highly repetitive texts a single block can exceed the limit.
+Suffixes are compared with the help of a difference cover sample such that no comparison inspects more than 256
+characters. The sample stores one rank for about every 8 text characters in addition to the limit.
+..include:seqan/index.h
+.Memvar.BlockwiseBwt#maxMemory
+..class:Class.BlockwiseBwt
+..summary:The maximal number of bytes used for suffix array entries during construction.
+..type:nolink:$__uint64$
+..default:1 GiB
+*/
+
+/*!
+ * @class BlockwiseBwt
+ * @headerfile seqan/index.h
+ * @brief Selects the memory-bounded construction of an @link FMIndex @endlink.
+ *
+ * @signature struct BlockwiseBwt;
+ *
+ * The suffix array is never built as a whole. Instead, the suffixes are sorted in blocks whose suffix array entries
+ * fit into <tt>maxMemory</tt> bytes and each sorted block is directly turned into the corresponding part of the BWT
+ * and the compressed suffix array. The memory needed for the text, the BWT and the resulting index is not covered by
+ * this limit. On highly repetitive texts a single block can exceed the limit.
+ *
+ * Suffixes are compared with the help of a difference cover sample such that no comparison inspects more than 256
+ * characters. The sample stores one rank for about every 8 text characters in addition to the limit.
+ *
+ * @var __uint64 BlockwiseBwt::maxMemory
+ * @brief The maximal number of bytes used for suffix array entries during construction, defaults to 1 GiB.
+ */
+
+struct BlockwiseBwt
+{
+    __uint64 maxMemory;
+
+    BlockwiseBwt() :
+        maxMemory(1024ull * 1024ull * 1024ull)
+    {}
+
+    explicit BlockwiseBwt(__uint64 maxMemory_) :
+        maxMemory(maxMemory_)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Class FMDcSample_
+// ----------------------------------------------------------------------------
+
+// A difference cover sample of the text. The cover D = {0, ..., ROOT - 1} u
+// {ROOT, 2 ROOT, ..., (ROOT - 1) ROOT} has the property that for any two
+// offsets i and j there is a k < PERIOD such that (i + k) mod PERIOD and
+// (j + k) mod PERIOD are both in D. All suffixes starting at an offset in D
+// (modulo PERIOD) are ranked, so two arbitrary suffixes can be compared by at
+// most PERIOD characters followed by a rank lookup.
+template <typename TText>
+struct FMDcSample_
+{
+    typedef typename Size<TText>::Type TSize;
+
+    enum
+    {
+        ROOT = 16,
+        PERIOD = ROOT * ROOT,
+        COVER_SIZE = 2 * ROOT - 1
+    };
+
+    // Position of an offset in the cover or COVER_SIZE if it is not covered.
+    String<unsigned> coverIndex;
+    // An element x of the cover such that (x + d) mod PERIOD is covered, too.
+    String<unsigned> coverElement;
+    // Index of the first sample of each sequence in ranks.
+    String<TSize> seqBegin;
+    // The rank of each sampled suffix.
+    String<TSize> ranks;
+};
+
+// ----------------------------------------------------------------------------
+// Metafunction FMBlockwiseSeq_
+// ----------------------------------------------------------------------------
+
+template <typename TText>
+struct FMBlockwiseSeq_
+{
+    typedef TText Type;
+};
+
+template <typename TString, typename TSetSpec>
+struct FMBlockwiseSeq_<StringSet<TString, TSetSpec> >
+{
+    typedef TString Type;
+};
+
+// ----------------------------------------------------------------------------
+// Class FMDcsPrefixLess_
+// ----------------------------------------------------------------------------
+
+// Compares two sampled suffixes by their first PERIOD characters.
+template <typename TSAValue, typename TText>
+struct FMDcsPrefixLess_
+{
+    TText const & _text;
+
+    FMDcsPrefixLess_(TText const & text) :
+        _text(text)
+    {}
+
+    inline bool operator()(TSAValue const & a, TSAValue const & b) const
+    {
+        return _fmBlockwiseCompare(_text, a, b, (unsigned)FMDcSample_<TText>::PERIOD) < 0;
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Class FMDcsDoublingLess_
+// ----------------------------------------------------------------------------
+
+// Compares two sampled suffixes with equal rank by the rank of the sampled
+// suffixes shift characters behind them.
+template <typename TSAValue, typename TText>
+struct FMDcsDoublingLess_
+{
+    typedef FMDcSample_<TText>  TDcs;
+    typedef typename TDcs::TSize TSize;
+
+    TDcs const & _dcs;
+    TText const & _text;
+    TSize _shift;
+
+    FMDcsDoublingLess_(TDcs const & dcs, TText const & text, TSize shift) :
+        _dcs(dcs),
+        _text(text),
+        _shift(shift)
+    {}
+
+    inline TSize _key(TSAValue const & sa) const
+    {
+        if (getSeqOffset(sa) + _shift >= _fmBlockwiseSeqLength(_text, getSeqNo(sa)))
+            return 0;
+        return _dcs.ranks[_fmDcsIndex(_dcs, getSeqNo(sa), getSeqOffset(sa) + _shift)];
+    }
+
+    inline bool operator()(TSAValue const & a, TSAValue const & b) const
+    {
+        return _key(a) < _key(b);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Class FMSuffixLess_
+// ----------------------------------------------------------------------------
+
+// Compares two suffixes in the order of the FM index suffix array, i.e. the
+// order produced by Skew7. A suffix that ends first is smaller and equal
+// suffixes of different sequences are ordered by decreasing sequence number.
+// At most PERIOD characters are compared, ties are broken by the difference
+// cover sample.
+template <typename TSAValue, typename TText>
+struct FMSuffixLess_
+{
+    typedef FMDcSample_<TText> TDcs;
+
+    TText const & _text;
+    TDcs const & _dcs;
+
+    FMSuffixLess_(TText const & text, TDcs const & dcs) :
+        _text(text),
+        _dcs(dcs)
+    {}
+
+    inline bool operator()(TSAValue const a, TSAValue const b) const
+    {
+        if (a == b)
+            return false;
+
+        unsigned i = getSeqOffset(a) % TDcs::PERIOD;
+        unsigned j = getSeqOffset(b) % TDcs::PERIOD;
+        unsigned k = (_dcs.coverElement[(j + TDcs::PERIOD - i) % TDcs::PERIOD] + TDcs::PERIOD - i) % TDcs::PERIOD;
+
+        int cmp = _fmBlockwiseCompare(_text, a, b, k);
+        if (cmp != 0)
+            return cmp < 0;
+        return _dcs.ranks[_fmDcsIndex(_dcs, getSeqNo(a), getSeqOffset(a) + k)] <
+               _dcs.ranks[_fmDcsIndex(_dcs, getSeqNo(b), getSeqOffset(b) + k)];
+    }
+};
+
+// ==========================================================================
+// Functions
+// ==========================================================================
+
+// ----------------------------------------------------------------------------
+// Helper function _fmBlockwiseSeqBegin
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TSeqNo>
+inline typename Iterator<TText const, Standard>::Type
+_fmBlockwiseSeqBegin(TText const & text, TSeqNo /*seqNo*/)
+{
+    return begin(text, Standard());
+}
+
+template <typename TString, typename TSetSpec, typename TSeqNo>
+inline typename Iterator<TString const, Standard>::Type
+_fmBlockwiseSeqBegin(StringSet<TString, TSetSpec> const & text, TSeqNo seqNo)
+{
+    return begin(text[seqNo], Standard());
+}
+
+// ----------------------------------------------------------------------------
+// Helper function _fmBlockwiseSeqLength
+// ----------------------------------------------------------------------------
+
+template <typename TText, typename TSeqNo>
+inline typename Size<TText>::Type
+_fmBlockwiseSeqLength(TText const & text, TSeqNo /*seqNo*/)
+{
+    return length(text);
+}
+
+template <typename TString, typename TSetSpec, typename TSeqNo>
+inline typename Size<StringSet<TString, TSetSpec> >::Type
+_fmBlockwiseSeqLength(StringSet<TString, TSetSpec> const & text, TSeqNo seqNo)
+{
+    return length(text[seqNo]);
+}
+
+// ----------------------------------------------------------------------------
+// Helper function _fmBlockwiseSetSuffix
+// ----------------------------------------------------------------------------
+
+template <typename TSAValue, typename TSeqNo, typename TOffset>
+inline void _fmBlockwiseSetSuffix(TSAValue & sa, TSeqNo /*seqNo*/, TOffset offset)
+{
+    sa = offset;
+}
+
+template <typename T1, typename T2, typename TPack, typename TSeqNo, typename TOffset>
+inline void _fmBlockwiseSetSuffix(Pair<T1, T2, TPack> & sa, TSeqNo seqNo, TOffset offset)
+{
+    sa.i1 = seqNo;
+    sa.i2 = offset;
+}
+
+// ----------------------------------------------------------------------------
+// Helper function _fmBlockwiseCompare
+// ----------------------------------------------------------------------------
+
+// Compares the first maxLength characters of two suffixes. Returns a negative
+// (positive) value if a is smaller (greater) than b and 0 if both prefixes are
+// equal and both suffixes are longer than maxLength.
+template <typename TText, typename TSAValue, typename TSize>
+inline int _fmBlockwiseCompare(TText const & text, TSAValue const & a, TSAValue const & b, TSize maxLength)
+{
+    typedef typename Iterator<typename FMBlockwiseSeq_<TText>::Type const, Standard>::Type TIter;
+
+    if (a == b)
+        return 0;
+
+    TIter itA = _fmBlockwiseSeqBegin(text, getSeqNo(a)) + getSeqOffset(a);
+    TIter itB = _fmBlockwiseSeqBegin(text, getSeqNo(b)) + getSeqOffset(b);
+    TIter itAEnd = _fmBlockwiseSeqBegin(text, getSeqNo(a)) + _fmBlockwiseSeqLength(text, getSeqNo(a));
+    TIter itBEnd = _fmBlockwiseSeqBegin(text, getSeqNo(b)) + _fmBlockwiseSeqLength(text, getSeqNo(b));
+    for (; maxLength != 0 && itA != itAEnd && itB != itBEnd; --maxLength, ++itA, ++itB)
+    {
+        if (ordLess(*itA, *itB)) return -1;
+        if (ordLess(*itB, *itA)) return 1;
+    }
+    if (itA == itAEnd && itB == itBEnd)
+        return (getSeqNo(a) > getSeqNo(b)) ? -1 : 1;
+    if (itA == itAEnd)
+        return -1;
+    if (itB == itBEnd)
+        return 1;
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Helper function _fmDcsIndex
+// ----------------------------------------------------------------------------
+
+// Returns the index of a sampled suffix in the rank table.
+template <typename TText, typename TSeqNo, typename TOffset>
+inline typename FMDcSample_<TText>::TSize
+_fmDcsIndex(FMDcSample_<TText> const & dcs, TSeqNo seqNo, TOffset offset)
+{
+    typedef FMDcSample_<TText> TDcs;
+
+    SEQAN_ASSERT_LT(dcs.coverIndex[offset % TDcs::PERIOD], (unsigned)TDcs::COVER_SIZE);
+    return dcs.seqBegin[seqNo] + (offset / TDcs::PERIOD) * TDcs::COVER_SIZE + dcs.coverIndex[offset % TDcs::PERIOD];
+}
+
+// ----------------------------------------------------------------------------
+// Helper function _fmDcsCreate
+// ----------------------------------------------------------------------------
+
+// Ranks all sampled suffixes. They are sorted by their first PERIOD characters
+// and groups of equal rank are refined by prefix doubling, i.e. in round r the
+// suffixes are compared by the rank of the sampled suffixes PERIOD * 2^r
+// characters behind them.
+template <typename TText>
+inline void _fmDcsCreate(FMDcSample_<TText> & dcs, TText const & text)
+{
+    typedef FMDcSample_<TText>                          TDcs;
+    typedef typename TDcs::TSize                        TSize;
+    typedef typename SAValue<TText>::Type               TSAValue;
+    typedef String<TSAValue>                            TSamples;
+    typedef typename Iterator<TSamples, Standard>::Type TSamplesIter;
+
+    // Build the difference cover and, for each difference d, the element x with x + d in the cover.
+    resize(dcs.coverIndex, (unsigned)TDcs::PERIOD, (unsigned)TDcs::COVER_SIZE, Exact());
+    for (unsigned x = 0, i = 0; x < (unsigned)TDcs::PERIOD; ++x)
+        if (x < (unsigned)TDcs::ROOT || x % TDcs::ROOT == 0)
+            dcs.coverIndex[x] = i++;
+
+    resize(dcs.coverElement, (unsigned)TDcs::PERIOD, Exact());
+    for (unsigned d = 0; d < (unsigned)TDcs::PERIOD; ++d)
+        for (unsigned x = 0; x < (unsigned)TDcs::PERIOD; ++x)
+            if (dcs.coverIndex[x] != (unsigned)TDcs::COVER_SIZE &&
+                dcs.coverIndex[(x + d) % TDcs::PERIOD] != (unsigned)TDcs::COVER_SIZE)
+            {
+                dcs.coverElement[d] = x;
+                break;
+            }
+
+    // Collect the sampled suffixes.
+    TSize seqCount = countSequences(text);
+    resize(dcs.seqBegin, seqCount + 1, Exact());
+    dcs.seqBegin[0] = 0;
+    for (TSize seqNo = 0; seqNo < seqCount; ++seqNo)
+        dcs.seqBegin[seqNo + 1] = dcs.seqBegin[seqNo] +
+            (_fmBlockwiseSeqLength(text, seqNo) + TDcs::PERIOD - 1) / TDcs::PERIOD * TDcs::COVER_SIZE;
+
+    TSamples samples;
+    reserve(samples, back(dcs.seqBegin), Exact());
+    for (TSize seqNo = 0; seqNo < seqCount; ++seqNo)
+        for (TSize offset = 0; offset < _fmBlockwiseSeqLength(text, seqNo); ++offset)
+            if (dcs.coverIndex[offset % TDcs::PERIOD] != (unsigned)TDcs::COVER_SIZE)
+            {
+                TSAValue sa;
+                _fmBlockwiseSetSuffix(sa, seqNo, offset);
+                appendValue(samples, sa);
+            }
+
+    // Rank the samples by their first PERIOD characters. The rank of a sample is one plus the position of
+    // the first sample with an equal prefix.
+    std::sort(begin(samples, Standard()), end(samples, Standard()), FMDcsPrefixLess_<TSAValue, TText>(text));
+
+    clear(dcs.ranks);
+    resize(dcs.ranks, back(dcs.seqBegin), 0, Exact());
+    bool unresolved = false;
+    TSamplesIter samplesBegin = begin(samples, Standard());
+    TSize sampleCount = length(samples);
+    for (TSize i = 0; i < sampleCount; ++i)
+    {
+        TSize rank = i + 1;
+        if (i != 0 && _fmBlockwiseCompare(text, samplesBegin[i - 1], samplesBegin[i], (unsigned)TDcs::PERIOD) == 0)
+        {
+            rank = dcs.ranks[_fmDcsIndex(dcs, getSeqNo(samplesBegin[i - 1]), getSeqOffset(samplesBegin[i - 1]))];
+            unresolved = true;
+        }
+        dcs.ranks[_fmDcsIndex(dcs, getSeqNo(samplesBegin[i]), getSeqOffset(samplesBegin[i]))] = rank;
+    }
+
+    // Refine groups of equal rank until all ranks are distinct.
+    String<TSize> newRanks;
+    for (TSize shift = TDcs::PERIOD; unresolved; shift *= 2)
+    {
+        typedef FMDcsDoublingLess_<TSAValue, TText> TDoublingLess;
+        TDoublingLess less(dcs, text, shift);
+
+        newRanks = dcs.ranks;
+        unresolved = false;
+        for (TSize groupBegin = 0, groupEnd; groupBegin < sampleCount; groupBegin = groupEnd)
+        {
+            TSize rank = dcs.ranks[_fmDcsIndex(dcs, getSeqNo(samplesBegin[groupBegin]),
+                                               getSeqOffset(samplesBegin[groupBegin]))];
+            for (groupEnd = groupBegin + 1; groupEnd < sampleCount; ++groupEnd)
+                if (dcs.ranks[_fmDcsIndex(dcs, getSeqNo(samplesBegin[groupEnd]),
+                                          getSeqOffset(samplesBegin[groupEnd]))] != rank)
+                    break;
+            if (groupEnd - groupBegin == 1)
+                continue;
+
+            std::sort(samplesBegin + groupBegin, samplesBegin + groupEnd, less);
+            for (TSize i = groupBegin; i < groupEnd; ++i)
+            {
+                TSize newRank = i + 1;
+                if (i != groupBegin && less._key(samplesBegin[i - 1]) == less._key(samplesBegin[i]))
+                {
+                    newRank = newRanks[_fmDcsIndex(dcs, getSeqNo(samplesBegin[i - 1]),
+                                                   getSeqOffset(samplesBegin[i - 1]))];
+                    unresolved = true;
+                }
+                newRanks[_fmDcsIndex(dcs, getSeqNo(samplesBegin[i]), getSeqOffset(samplesBegin[i]))] = newRank;
+            }
+        }
+        swap(dcs.ranks, newRanks);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Helper function _fmBlockwiseSuffix
+// ----------------------------------------------------------------------------
+
+// Converts a global text position into a suffix array value.
+template <typename TSAValue, typename TText, typename TPos>
+inline void _fmBlockwiseSuffix(TSAValue & sa, TText const & /*text*/, TPos pos)
+{
+    sa = pos;
+}
+
+template <typename TSAValue, typename TString, typename TSetSpec, typename TPos>
+inline void _fmBlockwiseSuffix(TSAValue & sa, StringSet<TString, TSetSpec> const & text, TPos pos)
+{
+    posLocalize(sa, pos, stringSetLimits(text));
+}
+
+// ----------------------------------------------------------------------------
+// Helper function _fmBlockwiseBucket
+// ----------------------------------------------------------------------------
+
+// Returns the number of the bucket of a suffix. Bucket i contains all suffixes s
+// with splitters[i - 1] < s <= splitters[i].
+template <typename TSplitters, typename TSAValue, typename TLess>
+inline typename Size<TSplitters>::Type
+_fmBlockwiseBucket(TSplitters const & splitters, TSAValue const & sa, TLess const & less)
+{
+    return std::lower_bound(begin(splitters, Standard()), end(splitters, Standard()), sa, less) -
+           begin(splitters, Standard());
+}
+
+// ----------------------------------------------------------------------------
+// Helper function _fmBlockwiseSetBwt
+// ----------------------------------------------------------------------------
+
+// Writes the BWT character of a suffix into the given row of the BWT.
+template <typename TBwt, typename TSentinelPosition, typename TText, typename TSAValue, typename TPos,
+          typename TSentinelSub>
+inline void _fmBlockwiseSetBwt(TBwt & bwt, TSentinelPosition & sentinelPos, TText const & text,
+                               TSAValue const & sa, TPos row, TSentinelSub const sentinelSub)
+{
+    if (sa != 0)
+        bwt[row] = text[sa - 1];
+    else
+    {
+        bwt[row] = sentinelSub;
+        sentinelPos = row;
+    }
+}
+
+template <typename TBwt, typename TSentinelPosition, typename TString, typename TSetSpec, typename TSAValue,
+          typename TPos, typename TSentinelSub>
+inline void _fmBlockwiseSetBwt(TBwt & bwt, TSentinelPosition & sentinelPos, StringSet<TString, TSetSpec> const & text,
+                               TSAValue const & sa, TPos row, TSentinelSub const sentinelSub)
+{
+    if (getSeqOffset(sa) != 0)
+        bwt[row] = text[getSeqNo(sa)][getSeqOffset(sa) - 1];
+    else
+    {
+        bwt[row] = sentinelSub;
+        setBit(sentinelPos, row);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Helper function _fmBlockwiseInitBwt
+// ----------------------------------------------------------------------------
+
+// Fills the BWT rows of the sentinel suffixes (they are all at the beginning of the BWT).
+template <typename TBwt, typename TSentinelPosition, typename TText>
+inline void _fmBlockwiseInitBwt(TBwt & bwt, TSentinelPosition & /*sentinelPos*/, TText const & text)
+{
+    bwt[0] = back(text);
+}
+
+template <typename TBwt, typename TSentinelPosition, typename TString, typename TSetSpec>
+inline void _fmBlockwiseInitBwt(TBwt & bwt, TSentinelPosition & /*sentinelPos*/, StringSet<TString, TSetSpec> const & text)
+{
+    typedef typename Size<StringSet<TString, TSetSpec> >::Type TSize;
+
+    TSize seqNum = countSequences(text);
+    for (TSize i = 1; i <= seqNum; ++i)
+        bwt[i - 1] = back(text[seqNum - i]);
+}
+
+// ----------------------------------------------------------------------------
+// Helper function _fmBlockwiseFinishBwt
+// ----------------------------------------------------------------------------
+
+template <typename TSentinelPosition, typename TText>
+inline void _fmBlockwiseFinishBwt(TSentinelPosition & /*sentinelPos*/, TText const & /*text*/)
+{}
+
+template <typename TSentinelPosition, typename TString, typename TSetSpec>
+inline void _fmBlockwiseFinishBwt(TSentinelPosition & sentinelPos, StringSet<TString, TSetSpec> const & /*text*/)
+{
+    _updateRanks(sentinelPos);
+}
+
+// ----------------------------------------------------------------------------
+// Helper function _fmBlockwiseSplitters
+// ----------------------------------------------------------------------------
+
+// Draws a sorted sample of distinct splitter suffixes such that the expected
+// bucket size is a quarter of the given block size.
+template <typename TSplitters, typename TText, typename TSize, typename TLess>
+inline void _fmBlockwiseSplitters(TSplitters & splitters, TText const & text, TSize textLength, TSize blockSize,
+                                  TLess const & less)
+{
+    typedef typename Value<TSplitters>::Type TSAValue;
+
+    clear(splitters);
+    TSize splitterCount = 4 * (textLength / blockSize);
+    if (splitterCount == 0)
+        return;
+    if (splitterCount > textLength)
+        splitterCount = textLength;
+
+    // Take one pseudo-random position out of each of splitterCount equally sized text ranges.
+    reserve(splitters, splitterCount, Exact());
+    __uint64 seed = 0x2545F4914F6CDD1Dull;
+    for (TSize i = 0; i < splitterCount; ++i)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        TSize rangeBegin = (__uint64)i * textLength / splitterCount;
+        TSize rangeEnd = (__uint64)(i + 1) * textLength / splitterCount;
+        TSAValue sa;
+        _fmBlockwiseSuffix(sa, text, rangeBegin + (TSize)((seed >> 33) % (rangeEnd - rangeBegin)));
+        appendValue(splitters, sa);
+    }
+
+    std::sort(begin(splitters, Standard()), end(splitters, Standard()), less);
+}
+
+// ----------------------------------------------------------------------------
+// Function _indexCreateBlockwise
+// ----------------------------------------------------------------------------
+
+// Creates the lf table and the compressed suffix array of an FM index without
+// keeping the complete suffix array in memory.
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline bool _indexCreateBlockwise(Index<TText, FMIndex<TIndexSpec, TSpec> > & index, TText & text,
+                                  BlockwiseBwt const & config)
+{
+    typedef Index<TText, FMIndex<TIndexSpec, TSpec> >               TIndex;
+    typedef typename Fibre<TIndex, FibreLfTable>::Type              TLfTable;
+    typedef typename Fibre<TLfTable, FibreOccTable>::Type           TOccTable;
+    typedef typename Fibre<TOccTable, FibreSentinelPosition>::Type  TSentinelPosition;
+    typedef typename Fibre<TIndex, FibreSA>::Type                   TCompressedSA;
+    typedef typename Fibre<TCompressedSA, FibreSparseString>::Type  TSparseSA;
+    typedef typename Fibre<TSparseSA, FibreIndicatorString>::Type   TIndicatorString;
+    typedef typename Value<TIndex>::Type                            TAlphabet;
+    typedef typename SAValue<TIndex>::Type                          TSAValue;
+    typedef typename Size<TIndex>::Type                             TSize;
+    typedef String<TSAValue>                                        TBlock;
+    typedef typename Iterator<TBlock, Standard>::Type               TBlockIter;
+    typedef FMSuffixLess_<TSAValue, TText>                          TLess;
+
+    if (empty(text))
+        return false;
+
+    TSize textLength = lengthSum(text);
+    TSize offset = countSequences(text);
+    TSize blockSize = config.maxMemory / sizeof(TSAValue);
+    if (blockSize == 0)
+        blockSize = 1;
+
+    FMDcSample_<TText> dcs;
+    _fmDcsCreate(dcs, text);
+    TLess less(text, dcs);
+
+    // Determine the buckets and their sizes.
+    String<TSAValue> splitters;
+    _fmBlockwiseSplitters(splitters, text, textLength, blockSize, less);
+
+    String<TSize> bucketSizes;
+    resize(bucketSizes, length(splitters) + 1, 0, Exact());
+    if (empty(splitters))
+        bucketSizes[0] = textLength;
+    else
+        for (TSize pos = 0; pos < textLength; ++pos)
+        {
+            TSAValue sa;
+            _fmBlockwiseSuffix(sa, text, pos);
+            ++bucketSizes[_fmBlockwiseBucket(splitters, sa, less)];
+        }
+
+    // Prepare the lf table.
+    createPrefixSumTable(index.lfTable.prefixSumTable, text);
+
+    TAlphabet sentinelSub(0);
+    _determineSentinelSubstitute(index.lfTable.prefixSumTable, sentinelSub);
+
+    String<TAlphabet> bwt;
+    resize(bwt, index.n, Exact());
+    TSentinelPosition sentinelPos = _setDefaultSentinelPosition(length(bwt), TSentinelPosition());
+    _fmBlockwiseInitBwt(bwt, sentinelPos, text);
+
+    // Prepare the compressed suffix array.
+    TCompressedSA & compressedSA = getFibre(index, FibreSA());
+    setLfTable(compressedSA, getFibre(index, FibreLfTable()));
+    TSparseSA & sparseString = getFibre(compressedSA, FibreSparseString());
+    TIndicatorString & indicatorString = getFibre(sparseString, FibreIndicatorString());
+    clear(compressedSA);
+    resize(compressedSA, textLength + offset, Exact());
+    clear(sparseString.valueString);
+    reserve(sparseString.valueString, textLength / index.compressionFactor + offset, Exact());
+
+    // Sort groups of consecutive buckets that fit into the block and stream them into the tables.
+    TBlock block;
+    TSize row = offset;
+    for (TSize bucketBegin = 0; bucketBegin < length(bucketSizes);)
+    {
+        TSize bucketEnd = bucketBegin + 1;
+        TSize blockLength = bucketSizes[bucketBegin];
+        while (bucketEnd < length(bucketSizes) && blockLength + bucketSizes[bucketEnd] <= blockSize)
+            blockLength += bucketSizes[bucketEnd++];
+
+        clear(block);
+        reserve(block, blockLength, Exact());
+        for (TSize pos = 0; pos < textLength; ++pos)
+        {
+            TSAValue sa;
+            _fmBlockwiseSuffix(sa, text, pos);
+            if (bucketBegin != 0 && !less(splitters[bucketBegin - 1], sa))
+                continue;
+            if (bucketEnd != length(bucketSizes) && less(splitters[bucketEnd - 1], sa))
+                continue;
+            appendValue(block, sa);
+        }
+        SEQAN_ASSERT_EQ(length(block), blockLength);
+
+        std::sort(begin(block, Standard()), end(block, Standard()), less);
+
+        for (TBlockIter it = begin(block, Standard()); it != end(block, Standard()); ++it, ++row)
+        {
+            _fmBlockwiseSetBwt(bwt, sentinelPos, text, *it, row, sentinelSub);
+            if (getSeqOffset(*it) % index.compressionFactor == 0)
+            {
+                setBit(indicatorString, row);
+                appendValue(sparseString.valueString, *it);
+            }
+        }
+
+        bucketBegin = bucketEnd;
+    }
+    clear(block);
+    shrinkToFit(block);
+
+    _updateRanks(indicatorString);
+    _fmBlockwiseFinishBwt(sentinelPos, text);
+
+    createSentinelRankDictionary(index.lfTable, bwt, sentinelSub, sentinelPos);
+
+    _insertSentinel(index.lfTable.prefixSumTable, countSequences(text));
+
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function indexCreate
+// ----------------------------------------------------------------------------
+
+/**
+.Function.FMIndex#indexCreate
+..signature:indexCreate(index, fibreTag, config)
+..param.config:Selects the memory-bounded construction and its memory limit.
+...type:Class.BlockwiseBwt
+..example.code:
+Index<DnaString, FMIndex<> > index(genome);
+indexCreate(index, FibreSaLfTable(), BlockwiseBwt(512ull * 1024 * 1024));  // at most 512 MiB for suffixes
+*/
+
+template <typename TText, typename TIndexSpec, typename TSpec>
+inline bool indexCreate(Index<TText, FMIndex<TIndexSpec, TSpec> > & index, FibreSaLfTable const,
+                        BlockwiseBwt const & config)
+{
+    return _indexCreateBlockwise(index, getFibre(index, FibreText()), config);
+}
+
+}
+#endif  // INDEX_FM_BLOCKWISE_H_
@@ -39,6 +39,7 @@ space efficient.
 ..param.TOccSpec:Occurrence table specialisation. 
 ...type:Tag.WT
 ...type:Tag.SBM
+...type:Tag.CLB
 ...remarks:The tags are really shortcuts for the different @Class.SentinelRankDictionary@s
 ...default:Tag.WT
 ..param.TSpec:FM index specialisation.
@@ -566,6 +567,39 @@ of the rank of a specified character at a specified position.
 */
 ///.Function.RankDictionary#getFibre.param.fibreTag.type:Spec.SequenceBitMask Fibres
 /**
+.Tag.CLB
+..summary:Tag that specifies the @Spec.FMIndex@ to use a @Spec.CacheLineBlocks@ rank dictionary as the occurrence table.
+..cat:Index
+..remarks:Only applicable to alphabets with at most four characters, e.g. @Spec.Dna@.
+*/
+/**
+.Spec.CacheLineBlocks Fibres
+..cat:Index
+..summary:Tag to select a specific fibre of a CacheLineBlocks rank dictionary.
+..remarks:These tags can be used to get @Metafunction.Fibre.Fibres@ of a CacheLineBlocks rank dictionary.
+
+..DISABLED.tag.FibreBlocks:The string of 64-byte blocks holding the packed text and the block ranks.
+..DISABLED.tag.FibreSuperBlocks:The string holding the superblock ranks.
+
+..see:Metafunction.Fibre
+..see:Function.getFibre
+..include:seqan/index.h
+*/
+/**
+.Spec.CacheLineBlocks:
+..cat:Index
+..general:Class.RankDictionary
+..summary:A rank dictionary storing the 2-bit packed text interleaved with the block ranks of all characters.
+..signature:CacheLineBlocks<TValue>
+..param.TValue:The value type of the text.
+..include:seqan/index.h
+..remarks:Every 64-byte block stores 192 characters and the ranks of all four characters at the beginning of the
+block. Therefore, a rank query accesses only one block and a small superblock table which usually resides in the
+cache. This data structure is restricted to alphabets of size at most four, such as @Spec.Dna@. Consider using a
+@Spec.SequenceBitMask@ or a @Spec.WaveletTree@ for larger alphabets.
+*/
+///.Function.RankDictionary#getFibre.param.fibreTag.type:Spec.CacheLineBlocks Fibres
+/**
 .Tag.WaveletTree Fibres
 ..summary:Tag to select a specific fibre (e.g. table, object, ...) of a @Spec.WaveletTree@.
 ..remarks:These tags can be used to get @Metafunction.Fibre.Fibres@ of a @Spec.WaveletTree@.
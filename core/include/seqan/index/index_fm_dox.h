@@ -42,6 +42,10 @@
  * @tag FMIndexRankDictionarySpec#SBM
  * @brief Tag that specifies the @link FMIndex @endlink to use a StringSet of rank support bis strings as the occurrence table.
  *
+ * @tag FMIndexRankDictionarySpec#CLB
+ * @brief Tag that specifies the @link FMIndex @endlink to use a @link CacheLineBlocks @endlink rank dictionary as the
+ *        occurrence table. Only applicable to alphabets with at most four characters.
+ *
  */
 
 /*!
@@ -108,7 +112,7 @@
  * 
  * @tparam TOccSpec Occurrence table specialisation.The tags are really
  *                  shortcuts for the different @link SentinelRankDictionary
- *                  @endlinks Types: @link FMIndexRankDictionarySpec#WT @endlink, @link FMIndexRankDictionarySpec#SBM @endlink, Default: @link FMIndexRankDictionarySpec#WT @endlink
+ *                  @endlinks Types: @link FMIndexRankDictionarySpec#WT @endlink, @link FMIndexRankDictionarySpec#SBM @endlink, @link FMIndexRankDictionarySpec#CLB @endlink, Default: @link FMIndexRankDictionarySpec#WT @endlink
  *
  * @tparam TSpec FM index specialisation. Types: @link FMIndexCompressionSpec#CompressText @endlink, @link FMIndexCompressionSpec#void @endlink, Default: @link FMIndexCompressionSpec#void @endlink
  *
@@ -774,7 +778,7 @@
  * @signature RankDictionary<TSpec>
  * 
  * @tparam TSpec The rank dictionary specialisation. Types: WaveletTree,
- *               SequenceBitMask Default: @link WaveletTree @endlink
+ *               SequenceBitMask, CacheLineBlocks Default: @link WaveletTree @endlink
  */
 
 /*!
@@ -861,6 +865,45 @@
  * @see Index#getFibre
  */
 
+/*!
+ * @class CacheLineBlocks
+ *
+ * @extends RankDictionary
+ * 
+ * @headerfile seqan/index.h
+ * 
+ * @brief A rank dictionary storing the 2-bit packed text interleaved with the
+ *        block ranks of all characters.
+ * 
+ * @signature template <typename TValue>
+ *            RankDictionary<CacheLineBlocks<TValue> >
+ * 
+ * @tparam TValue The value type of the text.
+ * 
+ * @section Remarks
+ * 
+ * Every 64-byte block stores 192 characters and the ranks of all four
+ * characters at the beginning of the block. Therefore, a rank query accesses
+ * only one block and a small superblock table which usually resides in the
+ * cache. This data structure is restricted to alphabets of size at most four,
+ * such as @link Dna @endlink.  Consider using a @link SequenceBitMask @endlink
+ * or a @link WaveletTree @endlink for larger alphabets.
+ */
+
+/*!
+ * @class CacheLineBlocksFibres CacheLineBlocks Fibres
+ * 
+ * @headerfile seqan/index.h
+ * 
+ * @brief Tag to select a specific fibre of a CacheLineBlocks rank dictionary.
+ *
+ * @tag CacheLineBlocksFibres#FibreBlocks The string of 64-byte blocks holding the packed text and the block ranks.
+ * @tag CacheLineBlocksFibres#FibreSuperBlocks The string holding the superblock ranks.
+ * 
+ * @see Index#Fibre
+ * @see Index#getFibre
+ */
+
 /*!
  * @mfn RankDictionary#Fibre
  *
@@ -868,7 +911,8 @@
  *
  * signature Fibre<RankDictionary, FibreSpec>::Type
  *
- * @tparam FibreSpec The Fibre of interest. Types: @link WaveletTreeFibres @endlink, @link SequenceBitMaskFibres @endlink.
+ * @tparam FibreSpec The Fibre of interest. Types: @link WaveletTreeFibres @endlink, @link SequenceBitMaskFibres @endlink,
+ *                   @link CacheLineBlocksFibres @endlink.
  *
  */
 
@@ -0,0 +1,546 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Rank dictionary for alphabets of size at most four that stores the 2-bit
+// packed text together with the block ranks of all characters in one
+// 64-byte block, such that a rank query touches a single cache line.
+// ==========================================================================
+
+//SEQAN_NO_DDDOC:do not generate documentation for this file
+
+#ifndef INDEX_FM_RANK_DICTIONARY_CLB_H_
+#define INDEX_FM_RANK_DICTIONARY_CLB_H_
+
+namespace seqan {
+
+// ==========================================================================
+// Forwards
+// ==========================================================================
+
+template <typename TValue>
+class CacheLineBlocks;
+
+template<typename TSpec>
+class RankDictionary;
+
+// ==========================================================================
+// Tags
+// ==========================================================================
+
+/**
+.Tag.CLB
+..summary:Tag that specifies the @Spec.FMIndex@ to use a @Spec.CacheLineBlocks@ rank dictionary as the occurrence table.
+..cat:Index
+..remarks:Only applicable to alphabets with at most four characters, e.g. @Spec.Dna@.
+*/
+template <typename TSpec = void>
+class CLB;
+
+// ==========================================================================
+// Classes
+// ==========================================================================
+
+// ----------------------------------------------------------------------------
+// Class CacheLineBlock_
+// ----------------------------------------------------------------------------
+
+// One block occupies exactly 64 bytes: the number of occurrences of each of
+// the four characters from the start of the superblock up to the start of
+// the block, followed by 192 characters packed into 2 bits each. Character
+// i of the block is stored in the bits 2 * (i % 32) and 2 * (i % 32) + 1 of
+// word i / 32.
+struct CacheLineBlock_
+{
+    enum
+    {
+        WORDS = 6,
+        CHARS_PER_WORD = 32,
+        CHARS = WORDS * CHARS_PER_WORD
+    };
+
+    __uint32 ranks[4];
+    __uint64 words[WORDS];
+
+    bool operator==(CacheLineBlock_ const & other) const
+    {
+        for (unsigned i = 0; i < 4; ++i)
+            if (ranks[i] != other.ranks[i])
+                return false;
+        for (unsigned i = 0; i < WORDS; ++i)
+            if (words[i] != other.words[i])
+                return false;
+        return true;
+    }
+};
+
+SEQAN_STATIC_ASSERT_MSG(sizeof(CacheLineBlock_) == 64, "A CacheLineBlock_ must fill exactly one cache line.");
+
+// ==========================================================================
+// Metafunctions
+// ==========================================================================
+
+/**
+.Spec.CacheLineBlocks Fibres
+..cat:Index
+..summary:Tag to select a specific fibre of a CacheLineBlocks rank dictionary.
+..remarks:These tags can be used to get @Metafunction.Fibre.Fibres@ of a CacheLineBlocks rank dictionary.
+
+..DISABLED.tag.FibreBlocks:The string of 64-byte blocks holding the packed text and the block ranks.
+..DISABLED.tag.FibreSuperBlocks:The string holding the superblock ranks.
+
+..see:Metafunction.Fibre
+..see:Function.getFibre
+..include:seqan/index.h
+*/
+
+// ----------------------------------------------------------------------------
+// Metafunction Size
+// ----------------------------------------------------------------------------
+
+template <typename TValue>
+struct Size<RankDictionary<CacheLineBlocks<TValue> > >
+{
+    typedef typename Size<String<TValue> >::Type Type;
+};
+
+template <typename TValue>
+struct Size<RankDictionary<CacheLineBlocks<TValue> > const> :
+    public Size<RankDictionary<CacheLineBlocks<TValue> > > {};
+
+// ----------------------------------------------------------------------------
+// Metafunction Value
+// ----------------------------------------------------------------------------
+
+template <typename TValue>
+struct Value<RankDictionary<CacheLineBlocks<TValue> > >
+{
+    typedef TValue Type;
+};
+
+template <typename TValue>
+struct Value<RankDictionary<CacheLineBlocks<TValue> > const> :
+    public Value<RankDictionary<CacheLineBlocks<TValue> > > {};
+
+// ----------------------------------------------------------------------------
+// Metafunction Fibre
+// ----------------------------------------------------------------------------
+
+template <typename TValue>
+struct Fibre<RankDictionary<CacheLineBlocks<TValue> >, FibreBlocks>
+{
+    typedef String<CacheLineBlock_> Type;
+};
+
+template <typename TValue>
+struct Fibre<RankDictionary<CacheLineBlocks<TValue> > const, FibreBlocks>
+{
+    typedef typename Fibre<RankDictionary<CacheLineBlocks<TValue> >, FibreBlocks>::Type const Type;
+};
+
+template <typename TValue>
+struct Fibre<RankDictionary<CacheLineBlocks<TValue> >, FibreSuperBlocks>
+{
+    typedef String<typename Size<RankDictionary<CacheLineBlocks<TValue> > >::Type> Type;
+};
+
+template <typename TValue>
+struct Fibre<RankDictionary<CacheLineBlocks<TValue> > const, FibreSuperBlocks>
+{
+    typedef typename Fibre<RankDictionary<CacheLineBlocks<TValue> >, FibreSuperBlocks>::Type const Type;
+};
+
+// ==========================================================================
+// Classes
+// ==========================================================================
+
+// ----------------------------------------------------------------------------
+// Spec CacheLineBlocks
+// ----------------------------------------------------------------------------
+
+/**
+.Spec.CacheLineBlocks:
+..cat:Index
+..summary:A rank dictionary storing the 2-bit packed text interleaved with the block ranks of all characters.
+..signature:CacheLineBlocks<TValue>
+..param.TValue:The value type of the text.
+..include:seqan/index.h
+..remarks:Every 64-byte block stores 192 characters and the ranks of all four characters at the beginning of the
+block. Therefore, a call to @Function.RankDictionary#countOccurrences@ accesses only one block and a small
+superblock table which usually resides in the cache. This data structure is restricted to alphabets of size at most
+four, such as @Spec.Dna@. Consider using a @Spec.SequenceBitMask@ or a @Spec.WaveletTree@ for larger alphabets.
+*/
+template <typename TValue>
+class RankDictionary<CacheLineBlocks<TValue> >
+{
+    SEQAN_STATIC_ASSERT_MSG(ValueSize<TValue>::VALUE <= 4, "CacheLineBlocks requires an alphabet of size at most 4.");
+
+    typedef typename Fibre<RankDictionary, FibreBlocks>::Type       TBlocks;
+    typedef typename Fibre<RankDictionary, FibreSuperBlocks>::Type  TSuperBlocks;
+
+public:
+    // The ranks stored in a block are 32 bit wide, hence a superblock covers 2^20 blocks.
+    static const unsigned BLOCKS_PER_SUPERBLOCK = 1u << 20;
+
+    TBlocks blocks;
+    TSuperBlocks superBlocks;
+
+    RankDictionary() {}
+
+    template <typename TText>
+    RankDictionary(TText const & text)
+    {
+        createRankDictionary(*this, text);
+    }
+
+    RankDictionary & operator=(RankDictionary const & other)
+    {
+        blocks = other.blocks;
+        superBlocks = other.superBlocks;
+        return *this;
+    }
+
+    bool operator==(RankDictionary const & b) const
+    {
+        typedef typename Size<TBlocks>::Type TSize;
+
+        if (length(blocks) != length(b.blocks) || !(superBlocks == b.superBlocks))
+            return false;
+
+        for (TSize i = 0; i < length(blocks); ++i)
+            if (!(blocks[i] == b.blocks[i]))
+                return false;
+
+        return true;
+    }
+};
+
+// ==========================================================================
+// Functions
+// ==========================================================================
+
+// ----------------------------------------------------------------------------
+// Function allocate()
+// ----------------------------------------------------------------------------
+
+// The default allocator only guarantees the alignment of operator new, hence a
+// block could straddle two cache lines.  We over-allocate by one cache line,
+// align the returned pointer to 64 bytes and keep the original pointer in the
+// bytes just before it.  Mapped fibres need no special care as they are page
+// aligned.  Buffers allocated by other owners, e.g. files, are not affected.
+inline CacheLineBlock_ *
+_clbAllocate(size_t count)
+{
+    char * raw = static_cast<char *>(operator new(count * sizeof(CacheLineBlock_) + 64));
+    char * aligned = reinterpret_cast<char *>((reinterpret_cast<size_t>(raw) + 64) & ~static_cast<size_t>(63));
+    reinterpret_cast<char **>(aligned)[-1] = raw;
+    return reinterpret_cast<CacheLineBlock_ *>(aligned);
+}
+
+template <typename TSpec, typename TSize, typename TUsage>
+inline void
+allocate(String<CacheLineBlock_, Alloc<TSpec> > const &, CacheLineBlock_ * & data, TSize count, Tag<TUsage> const &)
+{
+    data = _clbAllocate(count);
+}
+
+template <typename TSpec, typename TSize, typename TUsage>
+inline void
+allocate(String<CacheLineBlock_, Alloc<TSpec> > &, CacheLineBlock_ * & data, TSize count, Tag<TUsage> const &)
+{
+    data = _clbAllocate(count);
+}
+
+// ----------------------------------------------------------------------------
+// Function deallocate()
+// ----------------------------------------------------------------------------
+
+inline void
+_clbDeallocate(CacheLineBlock_ * data)
+{
+    if (data != NULL)
+        operator delete(reinterpret_cast<char **>(data)[-1]);
+}
+
+template <typename TSpec, typename TSize, typename TUsage>
+inline void
+deallocate(String<CacheLineBlock_, Alloc<TSpec> > const &, CacheLineBlock_ * data, TSize, Tag<TUsage> const)
+{
+    _clbDeallocate(data);
+}
+
+template <typename TSpec, typename TSize, typename TUsage>
+inline void
+deallocate(String<CacheLineBlock_, Alloc<TSpec> > &, CacheLineBlock_ * data, TSize, Tag<TUsage> const)
+{
+    _clbDeallocate(data);
+}
+
+// ----------------------------------------------------------------------------
+// Function _clbReplicate()
+// ----------------------------------------------------------------------------
+
+// Returns a word in which each 2-bit field holds the given character.
+inline __uint64 _clbReplicate(unsigned ord)
+{
+    return static_cast<__uint64>(ord) * 0x5555555555555555ull;
+}
+
+// ----------------------------------------------------------------------------
+// Function _clbCountInWord()
+// ----------------------------------------------------------------------------
+
+// Returns the number of 2-bit fields of word equal to ord among the first
+// (lowest) count fields.
+inline unsigned _clbCountInWord(__uint64 word, unsigned ord, unsigned count)
+{
+    __uint64 x = word ^ _clbReplicate(ord);
+    x = ~(x | (x >> 1)) & 0x5555555555555555ull;
+    if (count < CacheLineBlock_::CHARS_PER_WORD)
+        x &= (static_cast<__uint64>(1) << (2 * count)) - 1;
+    return popCount(x);
+}
+
+// ----------------------------------------------------------------------------
+// Function clear
+// ----------------------------------------------------------------------------
+
+template <typename TValue>
+inline void clear(RankDictionary<CacheLineBlocks<TValue> > & dictionary)
+{
+    clear(getFibre(dictionary, FibreBlocks()));
+    clear(getFibre(dictionary, FibreSuperBlocks()));
+}
+
+// ----------------------------------------------------------------------------
+// Function empty
+// ----------------------------------------------------------------------------
+
+template <typename TValue>
+inline bool empty(RankDictionary<CacheLineBlocks<TValue> > const & dictionary)
+{
+    return empty(getFibre(dictionary, FibreBlocks()));
+}
+
+// ----------------------------------------------------------------------------
+// Function getValue
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TPos>
+inline TValue
+getValue(RankDictionary<CacheLineBlocks<TValue> > const & dictionary, TPos pos)
+{
+    CacheLineBlock_ const & block = dictionary.blocks[pos / CacheLineBlock_::CHARS];
+    unsigned i = pos % CacheLineBlock_::CHARS;
+    return TValue((block.words[i / CacheLineBlock_::CHARS_PER_WORD] >>
+                   (2 * (i % CacheLineBlock_::CHARS_PER_WORD))) & 3);
+}
+
+template <typename TValue, typename TPos>
+inline TValue
+getValue(RankDictionary<CacheLineBlocks<TValue> > & dictionary, TPos pos)
+{
+    return getValue(const_cast<RankDictionary<CacheLineBlocks<TValue> > const &>(dictionary), pos);
+}
+
+// ----------------------------------------------------------------------------
+// Function getFibre
+// ----------------------------------------------------------------------------
+
+///.Function.RankDictionary#getFibre.param.fibreTag.type:Spec.CacheLineBlocks Fibres
+template <typename TValue>
+inline typename Fibre<RankDictionary<CacheLineBlocks<TValue> >, FibreBlocks>::Type &
+getFibre(RankDictionary<CacheLineBlocks<TValue> > & dictionary, FibreBlocks)
+{
+    return dictionary.blocks;
+}
+
+template <typename TValue>
+inline typename Fibre<RankDictionary<CacheLineBlocks<TValue> >, FibreBlocks>::Type const &
+getFibre(RankDictionary<CacheLineBlocks<TValue> > const & dictionary, FibreBlocks)
+{
+    return dictionary.blocks;
+}
+
+template <typename TValue>
+inline typename Fibre<RankDictionary<CacheLineBlocks<TValue> >, FibreSuperBlocks>::Type &
+getFibre(RankDictionary<CacheLineBlocks<TValue> > & dictionary, FibreSuperBlocks)
+{
+    return dictionary.superBlocks;
+}
+
+template <typename TValue>
+inline typename Fibre<RankDictionary<CacheLineBlocks<TValue> >, FibreSuperBlocks>::Type const &
+getFibre(RankDictionary<CacheLineBlocks<TValue> > const & dictionary, FibreSuperBlocks)
+{
+    return dictionary.superBlocks;
+}
+
+// ----------------------------------------------------------------------------
+// Function countOccurrences
+// ----------------------------------------------------------------------------
+
+// This functions computes the number of occurrences of a specified character
+// up to a specified position.
+template <typename TValue, typename TCharIn, typename TPos>
+inline typename Size<RankDictionary<CacheLineBlocks<TValue> > const>::Type
+countOccurrences(RankDictionary<CacheLineBlocks<TValue> > const & dictionary,
+                 TCharIn const character, TPos const pos)
+{
+    typedef RankDictionary<CacheLineBlocks<TValue> >                TRankDictionary;
+    typedef typename Size<TRankDictionary>::Type                    TSize;
+
+    unsigned ord = ordValue(TValue(character));
+    TSize blockId = pos / CacheLineBlock_::CHARS;
+    unsigned posInBlock = pos % CacheLineBlock_::CHARS;
+    CacheLineBlock_ const & block = dictionary.blocks[blockId];
+
+    TSize occ = dictionary.superBlocks[4 * (blockId / TRankDictionary::BLOCKS_PER_SUPERBLOCK) + ord];
+    occ += block.ranks[ord];
+
+    unsigned lastWord = posInBlock / CacheLineBlock_::CHARS_PER_WORD;
+    for (unsigned i = 0; i < lastWord; ++i)
+        occ += _clbCountInWord(block.words[i], ord, CacheLineBlock_::CHARS_PER_WORD);
+    occ += _clbCountInWord(block.words[lastWord], ord, posInBlock % CacheLineBlock_::CHARS_PER_WORD + 1);
+
+    return occ;
+}
+
+template <typename TValue, typename TCharIn, typename TPos>
+inline typename Size<RankDictionary<CacheLineBlocks<TValue> > >::Type
+countOccurrences(RankDictionary<CacheLineBlocks<TValue> > & dictionary, TCharIn const character,
+                 TPos const pos)
+{
+    return countOccurrences(const_cast<RankDictionary<CacheLineBlocks<TValue> > const &>(dictionary), character, pos);
+}
+
+// ----------------------------------------------------------------------------
+// Function createRankDictionary
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TText>
+inline void createRankDictionary(RankDictionary<CacheLineBlocks<TValue> > & dictionary, TText const & text)
+{
+    typedef RankDictionary<CacheLineBlocks<TValue> >                TRankDictionary;
+    typedef typename Size<TRankDictionary>::Type                    TSize;
+    typedef typename Iterator<TText const, Standard>::Type          TTextIter;
+
+    clear(dictionary);
+
+    TSize textLength = length(text);
+    TSize blockCount = (textLength + CacheLineBlock_::CHARS - 1) / CacheLineBlock_::CHARS;
+    TSize superBlockCount = (blockCount + TRankDictionary::BLOCKS_PER_SUPERBLOCK - 1) /
+                            TRankDictionary::BLOCKS_PER_SUPERBLOCK;
+
+    resize(dictionary.blocks, blockCount, Exact());
+    resize(dictionary.superBlocks, 4 * superBlockCount, 0, Exact());
+
+    TSize total[4] = {0, 0, 0, 0};
+    __uint32 inSuperBlock[4] = {0, 0, 0, 0};
+
+    TTextIter it = begin(text, Standard());
+    TTextIter itEnd = end(text, Standard());
+    for (TSize blockId = 0; blockId < blockCount; ++blockId)
+    {
+        if (blockId % TRankDictionary::BLOCKS_PER_SUPERBLOCK == 0)
+        {
+            for (unsigned c = 0; c < 4; ++c)
+            {
+                dictionary.superBlocks[4 * (blockId / TRankDictionary::BLOCKS_PER_SUPERBLOCK) + c] = total[c];
+                inSuperBlock[c] = 0;
+            }
+        }
+
+        CacheLineBlock_ & block = dictionary.blocks[blockId];
+        for (unsigned c = 0; c < 4; ++c)
+            block.ranks[c] = inSuperBlock[c];
+
+        for (unsigned w = 0; w < CacheLineBlock_::WORDS; ++w)
+        {
+            __uint64 word = 0;
+            for (unsigned i = 0; i < CacheLineBlock_::CHARS_PER_WORD && it != itEnd; ++i, ++it)
+            {
+                unsigned ord = ordValue(TValue(*it));
+                word |= static_cast<__uint64>(ord) << (2 * i);
+                ++total[ord];
+                ++inSuperBlock[ord];
+            }
+            block.words[w] = word;
+        }
+    }
+}
+
+template <typename TValue, typename TSpec, typename TPrefixSumTable, typename TText>
+inline void createRankDictionary(LfTable<SentinelRankDictionary<RankDictionary<CacheLineBlocks<TValue> >, TSpec>, TPrefixSumTable> & lfTable,
+                                 TText const & text)
+{
+    createRankDictionary(getFibre(getFibre(lfTable, FibreOccTable()), FibreRankDictionary()), text);
+}
+
+// ----------------------------------------------------------------------------
+// Function open
+// ----------------------------------------------------------------------------
+
+template <typename TValue>
+inline bool open(RankDictionary<CacheLineBlocks<TValue> > & dictionary, const char * fileName, int openMode)
+{
+    String<char> name;
+    name = fileName;    append(name, ".rd");    if (!open(getFibre(dictionary, FibreBlocks()), toCString(name), openMode)) return false;
+    name = fileName;    append(name, ".rds");   if (!open(getFibre(dictionary, FibreSuperBlocks()), toCString(name), openMode)) return false;
+    return true;
+}
+
+template <typename TValue>
+inline bool open(RankDictionary<CacheLineBlocks<TValue> > & dictionary, const char * fileName)
+{
+    return open(dictionary, fileName, DefaultOpenMode<RankDictionary<CacheLineBlocks<TValue> > >::VALUE);
+}
+
+// ----------------------------------------------------------------------------
+// Function save
+// ----------------------------------------------------------------------------
+
+template <typename TValue>
+inline bool save(RankDictionary<CacheLineBlocks<TValue> > const & dictionary, const char * fileName, int openMode)
+{
+    String<char> name;
+    name = fileName;    append(name, ".rd");    if (!save(getFibre(dictionary, FibreBlocks()), toCString(name), openMode)) return false;
+    name = fileName;    append(name, ".rds");   if (!save(getFibre(dictionary, FibreSuperBlocks()), toCString(name), openMode)) return false;
+    return true;
+}
+
+template <typename TValue>
+inline bool save(RankDictionary<CacheLineBlocks<TValue> > const & dictionary, const char * fileName)
+{
+    return save(dictionary, fileName, DefaultOpenMode<RankDictionary<CacheLineBlocks<TValue> > >::VALUE);
+}
+
+}
+#endif  // INDEX_FM_RANK_DICTIONARY_CLB_H_
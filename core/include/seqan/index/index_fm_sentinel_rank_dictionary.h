@@ -107,6 +107,12 @@ struct Fibre<SentinelRankDictionary<RankDictionary<SequenceBitMask<TValue> >, TS
     typedef RankDictionary<SequenceBitMask<TValue> > Type;
 };
 
+template <typename TValue, typename TSpec>
+struct Fibre<SentinelRankDictionary<RankDictionary<CacheLineBlocks<TValue> >, TSpec>, FibreRankDictionary>
+{
+    typedef RankDictionary<CacheLineBlocks<TValue> > Type;
+};
+
 template <typename TRankDictionary, typename TSpec>
 struct Fibre<SentinelRankDictionary<TRankDictionary, TSpec> const, FibreRankDictionary>
 {
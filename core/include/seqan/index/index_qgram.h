@@ -1217,19 +1217,19 @@ To take effect of changing the $stepSize$ the q-gram index should be empty or re
 		TSize num_qgrams = (length(text) - length(shape)) / stepSize + 1;
 
 		TIterator itText = begin(text, Standard());
-		++dir[requestBucket(bucketMap, hash(shape, itText))];
 		if (stepSize == 1)
-			for(TSize i = 1; i < num_qgrams; ++i)
-			{
-				++itText;
-				++dir[requestBucket(bucketMap, hashNext(shape, itText))];
-			}
-		else
-			for(TSize i = 1; i < num_qgrams; ++i)
-			{
-				itText += stepSize;
-				++dir[requestBucket(bucketMap, hash(shape, itText))];
-			}
+		{
+			BulkHasher_<TShape, TIterator> hasher(shape, itText, num_qgrams);
+			for(TSize i = 0; i < num_qgrams; ++i)
+				++dir[requestBucket(bucketMap, hasher.next())];
+			return;
+		}
+		++dir[requestBucket(bucketMap, hash(shape, itText))];
+		for(TSize i = 1; i < num_qgrams; ++i)
+		{
+			itText += stepSize;
+			++dir[requestBucket(bucketMap, hash(shape, itText))];
+		}
 	}
 
 	template < typename TDir, typename TBucketMap, typename TString, typename TSpec, typename TShape, typename TStepSize >
@@ -1249,13 +1249,9 @@ To take effect of changing the $stepSize$ the q-gram index should be empty or re
 				if (length(sequence) < length(shape)) continue;
 				TSize num_qgrams = length(sequence) - length(shape) + 1;
 
-				TIterator itText = begin(sequence, Standard());
-				++dir[requestBucket(bucketMap, hash(shape, itText))];
-				for(TSize i = 1; i < num_qgrams; ++i)
-				{
-					++itText;
-					++dir[requestBucket(bucketMap, hashNext(shape, itText))];
-				}
+				BulkHasher_<TShape, TIterator> hasher(shape, begin(sequence, Standard()), num_qgrams);
+				for(TSize i = 0; i < num_qgrams; ++i)
+					++dir[requestBucket(bucketMap, hasher.next())];
 			}
 		else
 			for(unsigned seqNo = 0; seqNo < length(stringSet); ++seqNo) 
@@ -1273,6 +1269,139 @@ To take effect of changing the $stepSize$ the q-gram index should be empty or re
 			}
 	}
 
+	// parallel counting, the q-grams of the text are split into one interval per thread
+	template < typename TDir, typename TBucketMap, typename TSequence, typename TShape, typename TStepSize, typename TSize, typename TParallelTag >
+	inline void
+	_qgramCountQGramsRange(TDir &dir, TBucketMap &bucketMap, TSequence const &sequence, TShape shape, TStepSize stepSize,
+                           TSize qBegin, TSize qEnd, Tag<TParallelTag> parallelTag)
+	{
+		typedef typename Iterator<TSequence const, Standard>::Type	TIterator;
+
+		if (qBegin >= qEnd) return;
+
+		TIterator itText = begin(sequence, Standard()) + qBegin * stepSize;
+		if (stepSize == 1)
+		{
+			BulkHasher_<TShape, TIterator> hasher(shape, itText, qEnd - qBegin);
+			for(TSize i = qBegin; i < qEnd; ++i)
+				atomicInc(dir[requestBucket(bucketMap, hasher.next(), parallelTag)], parallelTag);
+			return;
+		}
+		atomicInc(dir[requestBucket(bucketMap, hash(shape, itText), parallelTag)], parallelTag);
+		for(TSize i = qBegin + 1; i < qEnd; ++i)
+		{
+			itText += stepSize;
+			atomicInc(dir[requestBucket(bucketMap, hash(shape, itText), parallelTag)], parallelTag);
+		}
+	}
+
+	// Small directories are counted in one private copy per thread which are added up afterwards, as atomic
+	// increments of the same few counters would contend.  Adding up takes threads * |dir| steps, so private
+	// copies are only used while this is not more than the number of q-grams.  Larger directories are
+	// incremented atomically, there the increments of different threads rarely collide.
+	template < typename TDir, typename TSize >
+	inline bool
+	_qgramCountLocally(TDir const &dir, TSize numQGrams, unsigned threads)
+	{
+		return (__uint64)length(dir) * threads <= (__uint64)numQGrams;
+	}
+
+	template < typename TDir, typename TLocalDirs >
+	inline void
+	_qgramAddLocalDirs(TDir &dir, TLocalDirs const &localDirs, Parallel parallelTag)
+	{
+		typedef typename Size<TDir>::Type TPos;
+
+		Splitter<TPos> splitter(0, length(dir), parallelTag);
+
+		SEQAN_OMP_PRAGMA(parallel for)
+		for (int job = 0; job < (int)length(splitter); ++job)
+			for (unsigned i = 0; i < length(localDirs); ++i)
+				if (!empty(localDirs[i]))
+					for (TPos j = splitter[job]; j != splitter[job + 1]; ++j)
+						dir[j] += localDirs[i][j];
+	}
+
+	template < typename TDir, typename TBucketMap, typename TText, typename TShape, typename TStepSize >
+	inline void
+	_qgramCountQGrams(TDir &dir, TBucketMap &bucketMap, TText const &text, TShape shape, TStepSize stepSize, Parallel parallelTag)
+	{
+		typedef typename Value<TDir>::Type						TSize;
+
+		if (length(text) < length(shape) || empty(shape)) return;
+		TSize num_qgrams = (length(text) - length(shape)) / stepSize + 1;
+
+		Splitter<TSize> splitter(0, num_qgrams, parallelTag);
+
+		if (_qgramCountLocally(dir, num_qgrams, length(splitter)))
+		{
+			String<String<TSize> > localDirs;
+			resize(localDirs, length(splitter), Exact());
+
+			SEQAN_OMP_PRAGMA(parallel for)
+			for (int job = 0; job < (int)length(splitter); ++job)
+			{
+				resize(localDirs[job], length(dir), 0, Exact());
+				_qgramCountQGramsRange(localDirs[job], bucketMap, text, shape, stepSize, splitter[job], splitter[job + 1], Serial());
+			}
+			_qgramAddLocalDirs(dir, localDirs, parallelTag);
+			return;
+		}
+
+		SEQAN_OMP_PRAGMA(parallel for)
+		for (int job = 0; job < (int)length(splitter); ++job)
+			_qgramCountQGramsRange(dir, bucketMap, text, shape, stepSize, splitter[job], splitter[job + 1], parallelTag);
+	}
+
+	template < typename TDir, typename TBucketMap, typename TString, typename TSpec, typename TShape, typename TStepSize >
+	inline void
+	_qgramCountQGrams(TDir &dir, TBucketMap &bucketMap, StringSet<TString, TSpec> const &stringSet, TShape shape, TStepSize stepSize,
+                      Parallel parallelTag)
+	{
+		typedef typename Value<TDir>::Type							TSize;
+
+		if (empty(shape)) return;
+
+		if (_qgramCountLocally(dir, lengthSum(stringSet) / stepSize, omp_get_max_threads()))
+		{
+			String<String<TSize> > localDirs;
+			resize(localDirs, omp_get_max_threads(), Exact());
+
+			SEQAN_OMP_PRAGMA(parallel)
+			{
+				String<TSize> &localDir = localDirs[omp_get_thread_num()];
+				resize(localDir, length(dir), 0, Exact());
+
+				SEQAN_OMP_PRAGMA(for schedule(dynamic))
+				for (int seqNo = 0; seqNo < (int)length(stringSet); ++seqNo)
+				{
+					TString const &sequence = value(stringSet, seqNo);
+					if (length(sequence) < length(shape)) continue;
+					TSize num_qgrams = (length(sequence) - length(shape)) / stepSize + 1;
+					_qgramCountQGramsRange(localDir, bucketMap, sequence, shape, stepSize, (TSize)0, num_qgrams, Serial());
+				}
+			}
+			_qgramAddLocalDirs(dir, localDirs, parallelTag);
+			return;
+		}
+
+		SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+		for (int seqNo = 0; seqNo < (int)length(stringSet); ++seqNo)
+		{
+			TString const &sequence = value(stringSet, seqNo);
+			if (length(sequence) < length(shape)) continue;
+			TSize num_qgrams = (length(sequence) - length(shape)) / stepSize + 1;
+			_qgramCountQGramsRange(dir, bucketMap, sequence, shape, stepSize, (TSize)0, num_qgrams, parallelTag);
+		}
+	}
+
+	template < typename TDir, typename TBucketMap, typename TText, typename TShape, typename TStepSize >
+	inline void
+	_qgramCountQGrams(TDir &dir, TBucketMap &bucketMap, TText const &text, TShape shape, TStepSize stepSize, Serial)
+	{
+		_qgramCountQGrams(dir, bucketMap, text, shape, stepSize);
+	}
+
 	//////////////////////////////////////////////////////////////////////////////
 	// Counting sort - Step 3: Cumulative sum
     //
@@ -1317,6 +1446,92 @@ To take effect of changing the $stepSize$ the q-gram index should be empty or re
 		return sum + prev2Diff;
 	}
 
+	// The parallel version computes the same result in three passes over the Splitter intervals:
+	// local sums, exclusive prefix sum of the local sums, and the serial recurrence above
+	// restarted at each interval border.
+	template < typename TSize, typename TWithConstraints >
+	inline TSize
+	_qgramCummulativeSumValue(TSize x, TWithConstraints)
+	{
+		return (TWithConstraints::VALUE && x == (TSize)-1)? 0: x;	// disabled buckets count nothing
+	}
+
+	template < typename TDir, typename TWithConstraints, typename TParallelTag >
+	inline typename Value<TDir>::Type
+	_qgramCummulativeSum(TDir &dir, TWithConstraints, Tag<TParallelTag> parallelTag)
+	{
+		typedef typename Iterator<TDir, Standard>::Type TDirIterator;
+		typedef typename Value<TDir>::Type              TSize;
+		typedef typename Size<TDir>::Type               TPos;
+
+		if (empty(dir)) return 0;
+
+		Splitter<TPos> splitter(0, length(dir), parallelTag);
+		String<TSize> localSums;
+		String<TSize> borderValues;			// the two raw values preceding each interval
+		resize(localSums, length(splitter), Exact());
+		resize(borderValues, 2 * length(splitter), Exact());
+		TSize lastValue = back(dir);
+
+		// 1. sum up each interval
+		SEQAN_OMP_PRAGMA(parallel for)
+		for (int job = 0; job < (int)length(splitter); ++job)
+		{
+			TSize localSum = 0;
+			for (TPos i = splitter[job]; i != splitter[job + 1]; ++i)
+				localSum += _qgramCummulativeSumValue(dir[i], TWithConstraints());
+			localSums[job] = localSum;
+			borderValues[2 * job] = (splitter[job] > 1)? dir[splitter[job] - 2]: 0;
+			borderValues[2 * job + 1] = (splitter[job] > 0)? dir[splitter[job] - 1]: 0;
+		}
+
+		// 2. exclusive prefix sum over the intervals
+		TSize total = 0;
+		for (unsigned job = 0; job < length(splitter); ++job)
+		{
+			TSize localSum = localSums[job];
+			localSums[job] = total;
+			total += localSum;
+		}
+
+		// 3. run the serial recurrence on each interval with the state it would have at the interval begin
+		SEQAN_OMP_PRAGMA(parallel for)
+		for (int job = 0; job < (int)length(splitter); ++job)
+		{
+			TSize prevDiff = borderValues[2 * job + 1];
+			TSize prev2Diff = _qgramCummulativeSumValue(borderValues[2 * job], TWithConstraints());
+			TSize sum = localSums[job] - _qgramCummulativeSumValue(prevDiff, TWithConstraints()) - prev2Diff;
+
+			TDirIterator it = begin(dir, Standard()) + splitter[job];
+			TDirIterator itEnd = begin(dir, Standard()) + splitter[job + 1];
+			for (; it != itEnd; ++it)
+			{
+				if (TWithConstraints::VALUE && prevDiff == (TSize)-1)
+				{
+					sum += prev2Diff;
+					prev2Diff = 0;
+					prevDiff = *it;
+					*it = (TSize)-1;							// disable bucket
+				} else {
+					sum += prev2Diff;
+					prev2Diff = prevDiff;
+					prevDiff = *it;
+					*it = sum;
+				}
+			}
+		}
+
+		// the serial version returns the sum of all but the last entry
+		return total - _qgramCummulativeSumValue(lastValue, TWithConstraints());
+	}
+
+	template < typename TDir, typename TWithConstraints >
+	inline typename Value<TDir>::Type
+	_qgramCummulativeSum(TDir &dir, TWithConstraints, Serial)
+	{
+		return _qgramCummulativeSum(dir, TWithConstraints());
+	}
+
 	// The first entry is 0.
 	// This function is used when Steps 4 and 5 (fill SA, correct disabled buckets) are ommited.
 	template < typename TDir, typename TWithConstraints >
@@ -1377,32 +1592,33 @@ To take effect of changing the $stepSize$ the q-gram index should be empty or re
 		TSize num_qgrams = length(text) - length(shape) + 1;
 		TIterator itText = begin(text, Standard());
 
+		if (stepSize == 1)
+		{
+			BulkHasher_<TShape, TIterator> hasher(shape, itText, num_qgrams);
+			for(TSize i = 0; i < num_qgrams; ++i)
+				if (TWithConstraints::VALUE) {
+					TSize bktNo = getBucket(bucketMap, hasher.next()) + 1;
+					if (dir[bktNo] != (TSize)-1) sa[dir[bktNo]++] = i;					// if bucket is enabled
+				} else
+					sa[dir[getBucket(bucketMap, hasher.next()) + 1]++] = i;
+			return;
+		}
+
 		if (TWithConstraints::VALUE) {
 			TSize bktNo = getBucket(bucketMap, hash(shape, itText)) + 1;			// first hash
 			if (dir[bktNo] != (TSize)-1) sa[dir[bktNo]++] = 0;						// if bucket is enabled
 		} else
 			sa[dir[getBucket(bucketMap, hash(shape, itText)) + 1]++] = 0;			// first hash
 
-		if (stepSize == 1)
-			for(TSize i = 1; i < num_qgrams; ++i)
-			{
-				++itText;
-				if (TWithConstraints::VALUE) {
-					TSize bktNo = getBucket(bucketMap, hashNext(shape, itText)) + 1;	// next hash
-					if (dir[bktNo] != (TSize)-1) sa[dir[bktNo]++] = i;					// if bucket is enabled
-				} else
-					sa[dir[getBucket(bucketMap, hashNext(shape, itText)) + 1]++] = i;	// next hash
-			}
-		else
-			for(TSize i = stepSize; i < num_qgrams; i += stepSize)
-			{
-				itText += stepSize;
-				if (TWithConstraints::VALUE) {
-					TSize bktNo = getBucket(bucketMap, hash(shape, itText)) + 1;		// next hash (we mustn't use hashNext here)
-					if (dir[bktNo] != (TSize)-1) sa[dir[bktNo]++] = i;					// if bucket is enabled
-				} else
-					sa[dir[getBucket(bucketMap, hash(shape, itText)) + 1]++] = i;		// next hash
-			}
+		for(TSize i = stepSize; i < num_qgrams; i += stepSize)
+		{
+			itText += stepSize;
+			if (TWithConstraints::VALUE) {
+				TSize bktNo = getBucket(bucketMap, hash(shape, itText)) + 1;		// next hash (we mustn't use hashNext here)
+				if (dir[bktNo] != (TSize)-1) sa[dir[bktNo]++] = i;					// if bucket is enabled
+			} else
+				sa[dir[getBucket(bucketMap, hash(shape, itText)) + 1]++] = i;		// next hash
+		}
 	}
 
 	// multiple sequences
@@ -1442,22 +1658,15 @@ To take effect of changing the $stepSize$ the q-gram index should be empty or re
 				assignValueI1(localPos, seqNo);
 				assignValueI2(localPos, 0);
 
-				TIterator itText = begin(sequence, Standard());
-				if (TWithConstraints::VALUE) {
-					TSize bktNo = getBucket(bucketMap, hash(shape, itText)) + 1;					// first hash
-					if (dir[bktNo] != (TSize)-1) sa[dir[bktNo]++] = localPos;						// if bucket is enabled
-				} else
-					sa[dir[getBucket(bucketMap, hash(shape, itText)) + 1]++] = localPos;			// first hash
-
-				for(TSize i = 1; i < num_qgrams; ++i)
+				BulkHasher_<TShape, TIterator> hasher(shape, begin(sequence, Standard()), num_qgrams);
+				for(TSize i = 0; i < num_qgrams; ++i)
 				{
-					++itText;
 					assignValueI2(localPos, i);
 					if (TWithConstraints::VALUE) {
-						TSize bktNo = getBucket(bucketMap, hashNext(shape, itText)) + 1;			// next hash
+						TSize bktNo = getBucket(bucketMap, hasher.next()) + 1;						// next hash
 						if (dir[bktNo] != (TSize)-1) sa[dir[bktNo]++] = localPos;					// if bucket is enabled
 					} else
-						sa[dir[getBucket(bucketMap, hashNext(shape, itText)) + 1]++] = localPos;	// next hash
+						sa[dir[getBucket(bucketMap, hasher.next()) + 1]++] = localPos;				// next hash
 				}
 			}
 		else
@@ -1485,6 +1694,190 @@ To take effect of changing the $stepSize$ the q-gram index should be empty or re
 			}
 	}
 
+	// parallel fill, the q-grams of the text are split into one interval per thread
+	// and each thread reserves its SA slots atomically. The order within the buckets
+	// depends on the thread schedule and is restored afterwards by _qgramSortBuckets.
+	template < typename TSAValue, typename TSeqNo, typename TPos >
+	inline void
+	_qgramAssignSAValue(TSAValue &saValue, TSeqNo, TPos pos)
+	{
+		saValue = pos;
+	}
+
+	template < typename T1, typename T2, typename TPairSpec, typename TSeqNo, typename TPos >
+	inline void
+	_qgramAssignSAValue(Pair<T1, T2, TPairSpec> &saValue, TSeqNo seqNo, TPos pos)
+	{
+		assignValueI1(saValue, seqNo);
+		assignValueI2(saValue, pos);
+	}
+
+	template <
+		typename TSA,
+		typename TSequence,
+		typename TShape,
+		typename TDir,
+		typename TBucketMap,
+		typename TStepSize,
+		typename TSeqNo,
+		typename TSize,
+		typename TWithConstraints,
+		typename TParallelTag >
+	inline void
+	_qgramFillSuffixArrayRange(
+		TSA &sa,
+		TSequence const &sequence,
+		TShape shape,
+		TDir &dir,
+		TBucketMap &bucketMap,
+		TStepSize stepSize,
+		TSeqNo seqNo,
+		TSize qBegin,
+		TSize qEnd,
+		TWithConstraints const,
+		Tag<TParallelTag> parallelTag)
+	{
+		typedef typename Iterator<TSequence const, Standard>::Type	TIterator;
+		typedef typename Value<TDir>::Type							TDirValue;
+
+		if (qBegin >= qEnd) return;
+
+		typename Value<TSA>::Type localPos;
+		TIterator itText = begin(sequence, Standard()) + qBegin * stepSize;
+		if (stepSize == 1)
+		{
+			BulkHasher_<TShape, TIterator> hasher(shape, itText, qEnd - qBegin);
+			for (TSize i = qBegin; i < qEnd; ++i)
+			{
+				TDirValue bktNo = getBucket(bucketMap, hasher.next()) + 1;
+				if (!TWithConstraints::VALUE || dir[bktNo] != (TDirValue)-1)			// if bucket is enabled
+				{
+					_qgramAssignSAValue(localPos, seqNo, i);
+					sa[atomicPostInc(dir[bktNo], parallelTag)] = localPos;
+				}
+			}
+			return;
+		}
+		TDirValue bktNo = getBucket(bucketMap, hash(shape, itText)) + 1;
+		for (TSize i = qBegin; ; )
+		{
+			if (!TWithConstraints::VALUE || dir[bktNo] != (TDirValue)-1)				// if bucket is enabled
+			{
+				_qgramAssignSAValue(localPos, seqNo, i * stepSize);
+				sa[atomicPostInc(dir[bktNo], parallelTag)] = localPos;
+			}
+			if (++i == qEnd) break;
+			itText += stepSize;
+			bktNo = getBucket(bucketMap, hash(shape, itText)) + 1;		// next hash (we mustn't use hashNext here)
+		}
+	}
+
+	template <
+		typename TSA,
+		typename TText,
+		typename TShape,
+		typename TDir,
+		typename TBucketMap,
+		typename TStepSize,
+		typename TWithConstraints >
+	inline void
+	_qgramFillSuffixArray(
+		TSA &sa,
+		TText const &text,
+		TShape shape,
+		TDir &dir,
+		TBucketMap &bucketMap,
+		TStepSize stepSize,
+		TWithConstraints const,
+		Parallel parallelTag)
+	{
+		typedef typename Value<TDir>::Type						TSize;
+
+		if (empty(shape) || length(text) < length(shape)) return;
+		TSize num_qgrams = (length(text) - length(shape)) / stepSize + 1;
+
+		Splitter<TSize> splitter(0, num_qgrams, parallelTag);
+
+		SEQAN_OMP_PRAGMA(parallel for)
+		for (int job = 0; job < (int)length(splitter); ++job)
+			_qgramFillSuffixArrayRange(sa, text, shape, dir, bucketMap, stepSize, 0u, splitter[job], splitter[job + 1],
+                                       TWithConstraints(), parallelTag);
+	}
+
+	template <
+		typename TSA,
+		typename TString,
+		typename TSpec,
+		typename TShape,
+		typename TDir,
+		typename TBucketMap,
+		typename TStepSize,
+		typename TWithConstraints >
+	inline void
+	_qgramFillSuffixArray(
+		TSA &sa,
+		StringSet<TString, TSpec> const &stringSet,
+		TShape shape,
+		TDir &dir,
+		TBucketMap &bucketMap,
+		TStepSize stepSize,
+		TWithConstraints const,
+		Parallel parallelTag)
+	{
+		typedef typename Value<TDir>::Type							TSize;
+
+		if (empty(shape)) return;
+
+		SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+		for (int seqNo = 0; seqNo < (int)length(stringSet); ++seqNo)
+		{
+			TString const &sequence = value(stringSet, seqNo);
+			if (length(sequence) < length(shape)) continue;
+			TSize num_qgrams = (length(sequence) - length(shape)) / stepSize + 1;
+			_qgramFillSuffixArrayRange(sa, sequence, shape, dir, bucketMap, stepSize, (unsigned)seqNo, (TSize)0, num_qgrams,
+                                       TWithConstraints(), parallelTag);
+		}
+	}
+
+	template < typename TSA, typename TText, typename TShape, typename TDir, typename TBucketMap, typename TStepSize,
+               typename TWithConstraints >
+	inline void
+	_qgramFillSuffixArray(TSA &sa, TText const &text, TShape shape, TDir &dir, TBucketMap &bucketMap, TStepSize stepSize,
+                          TWithConstraints const, Serial)
+	{
+		_qgramFillSuffixArray(sa, text, shape, dir, bucketMap, stepSize, TWithConstraints());
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	// Step 4b: Sort the buckets by text position (only required after a parallel fill)
+	template < typename TSA, typename TDir, typename TParallelTag >
+	inline void
+	_qgramSortBuckets(TSA &sa, TDir const &dir, Tag<TParallelTag> parallelTag)
+	{
+		typedef typename Iterator<TSA, Standard>::Type			TSAIterator;
+		typedef typename Size<TDir>::Type						TPos;
+
+		if (length(dir) < 2) return;
+
+		Splitter<TPos> splitter(0, length(dir) - 1, parallelTag);
+
+		SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+		for (int job = 0; job < (int)length(splitter); ++job)
+		{
+			TSAIterator saBegin = begin(sa, Standard());
+			for (TPos i = splitter[job]; i != splitter[job + 1]; ++i)
+				if (dir[i + 1] - dir[i] > 1)
+					std::sort(saBegin + dir[i], saBegin + dir[i + 1]);
+		}
+	}
+
+	template < typename TSA, typename TDir >
+	inline void
+	_qgramSortBuckets(TSA &, TDir const &, Serial)
+	{
+		// the serial fill already sorts the buckets by text position
+	}
+
 	//////////////////////////////////////////////////////////////////////////////
 	// Step 5: Correct disabled buckets
 	template < typename TDir >
@@ -1511,11 +1904,16 @@ To take effect of changing the $stepSize$ the q-gram index should be empty or re
 .Function.createQGramIndex:
 ..summary:Builds a q-gram index on a sequence. 
 ..cat:Index
-..signature:createQGramIndex(index)
+..signature:createQGramIndex(index[, parallelTag])
 ..signature:createQGramIndex(sa, dir, bucketMap, text, shape, stepSize) [DEPRECATED]
 ..class:Spec.IndexQGram
 ..param.index:The q-gram index.
 ...type:Spec.IndexQGram
+..param.parallelTag:Tag to enable or disable the OpenMP parallel construction.
+...type:Tag.Parallel
+...type:Tag.Serial
+...default:$Parallel$ if OpenMP is enabled and the function is not called in a parallel region, $Serial$ otherwise.
+...remarks:The parallel construction counts the q-grams of small directories in one copy per thread.
 ..param.sa:The resulting list in which all q-grams are sorted alphabetically.
 ..param.dir:The resulting array that indicates at which position in index the corresponding q-grams can be found.
 ..param.bucketMap:Stores the q-gram hashes for the openaddressing hash maps, see @Function.indexBucketMap@.
@@ -1527,6 +1925,8 @@ If bucketMap is of the type @Tag.Nothing@ the q-gram hash determines the bucket
 ..returns:Index contains the sorted list of qgrams. For each q-gram $dir$ contains the first position in index that corresponds to this q-gram.
 ..remarks:This function should not be called directly. Please use @Function.indexCreate@ or @Function.indexRequire@.
 The resulting tables must have appropriate size before calling this function.
+..remarks:The parallel construction yields the same tables as the serial one.
+It is used for q-gram indices with direct addressing only, indices with open addressing are always built serially.
 ..include:seqan/index.h
 */
 /*!
@@ -1536,11 +1936,17 @@ The resulting tables must have appropriate size before calling this function.
  * 
  * @brief Builds a q-gram index on a sequence.
  * 
- * @signature createQGramIndex(index)
+ * @signature createQGramIndex(index[, parallelTag])
  * @signature createQGramIndex(sa, dir, bucketMap, text, shape, stepSize)
  *            [DEPRECATED]
  * 
  * @param index The q-gram index. Types: @link IndexQGram @endlink
+ * @param parallelTag Tag to enable or disable the OpenMP parallel construction.
+ *                    Types: @link ParallelismTags @endlink. Default: <tt>Parallel</tt>
+ *                    if OpenMP is enabled and the function is not called in a
+ *                    parallel region, <tt>Serial</tt> otherwise.  The parallel
+ *                    construction counts the q-grams of small directories in one
+ *                    copy per thread.
  * @param stepSize Store every <tt>stepSize</tt>'th q-gram in the index.
  * @param text The sequence.
  * @param bucketMap Stores the q-gram hashes for the openaddressing hash maps,
@@ -1561,6 +1967,10 @@ The resulting tables must have appropriate size before calling this function.
  * This function should not be called directly. Please use @link Index#indexCreate
  * @endlink or @link Index#indexRequire @endlink. The resulting tables must have
  * appropriate size before calling this function.
+ * 
+ * The parallel construction yields the same tables as the serial one. It is used
+ * for q-gram indices with direct addressing only, indices with open addressing
+ * are always built serially.
  */
 	template < typename TIndex >
 	inline bool _qgramDisableBuckets(TIndex &)
@@ -1568,29 +1978,42 @@ The resulting tables must have appropriate size before calling this function.
 		return false;	// we disable no buckets by default
 	}
 
+	// The parallel construction is only used for direct addressing.
+	// With open addressing the bucket numbers depend on the order in which the q-grams are seen.
+	template < typename TIndex, typename TBucketMap, typename TParallelTag >
+	inline bool _qgramParallelizable(TIndex &, TBucketMap &, Tag<TParallelTag>)
+	{
+		return false;
+	}
+
 	template < typename TIndex >
-	void createQGramIndex(TIndex &index)
+	inline bool _qgramParallelizable(TIndex &, Nothing &, Parallel)
+	{
+		return true;
+	}
+
+	template < typename TIndex, typename TParallelTag >
+	void _createQGramIndex(TIndex &index, Tag<TParallelTag> parallelTag)
 	{
-	SEQAN_CHECKPOINT
 		typename Fibre<TIndex, QGramText>::Type const &text      = indexText(index);
 		typename Fibre<TIndex, QGramSA>::Type         &sa        = indexSA(index);
 		typename Fibre<TIndex, QGramDir>::Type        &dir       = indexDir(index);
 		typename Fibre<TIndex, QGramShape>::Type      &shape     = indexShape(index);
 		typename Fibre<TIndex, QGramBucketMap>::Type  &bucketMap = index.bucketMap;
-		
+
 		// 1. clear counters
-		_qgramClearDir(dir, bucketMap);
+		_qgramClearDir(dir, bucketMap, parallelTag);
 
 		// 2. count q-grams
-		_qgramCountQGrams(dir, bucketMap, text, shape, getStepSize(index));
+		_qgramCountQGrams(dir, bucketMap, text, shape, getStepSize(index), parallelTag);
 
 		if (_qgramDisableBuckets(index))
 		{
 			// 3. cumulative sum
-			_qgramCummulativeSum(dir, True());
-			
+			_qgramCummulativeSum(dir, True(), parallelTag);
+
 			// 4. fill suffix array
-			_qgramFillSuffixArray(sa, text, shape, dir, bucketMap, getStepSize(index), True());
+			_qgramFillSuffixArray(sa, text, shape, dir, bucketMap, getStepSize(index), True(), parallelTag);
 
 			// 5. correct disabled buckets
 			_qgramPostprocessBuckets(dir);
@@ -1598,11 +2021,38 @@ The resulting tables must have appropriate size before calling this function.
 		else
 		{
 			// 3. cumulative sum
-			_qgramCummulativeSum(dir, False());
-			
+			_qgramCummulativeSum(dir, False(), parallelTag);
+
 			// 4. fill suffix array
-			_qgramFillSuffixArray(sa, text, shape, dir, bucketMap, getStepSize(index), False());
-		} 
+			_qgramFillSuffixArray(sa, text, shape, dir, bucketMap, getStepSize(index), False(), parallelTag);
+		}
+
+		// 6. restore the order of the serial fill
+		_qgramSortBuckets(sa, dir, parallelTag);
+	}
+
+	template < typename TIndex, typename TParallelTag >
+	void createQGramIndex(TIndex &index, Tag<TParallelTag> parallelTag)
+	{
+	SEQAN_CHECKPOINT
+		if (_qgramParallelizable(index, index.bucketMap, parallelTag))
+			_createQGramIndex(index, parallelTag);
+		else
+			_createQGramIndex(index, Serial());
+	}
+
+	template < typename TIndex >
+	void createQGramIndex(TIndex &index)
+	{
+#ifdef _OPENMP
+		// nested parallel regions are executed by a single thread, e.g. in the RazerS read block indices
+		if (omp_get_max_threads() > 1 && !omp_in_parallel())
+		{
+			createQGramIndex(index, Parallel());
+			return;
+		}
+#endif
+		createQGramIndex(index, Serial());
 	}
 
 	// DEPRECATED
@@ -1672,6 +2122,8 @@ The resulting tables must have appropriate size before calling this function.
 ..param.stepSize:Store every $stepSize$'th q-gram in the index.
 ..remarks:This function should not be called directly. Please use @Function.indexCreate@ or @Function.indexRequire@.
 The resulting tables must have appropriate size before calling this function.
+..remarks:The parallel construction yields the same tables as the serial one.
+It is used for q-gram indices with direct addressing only, indices with open addressing are always built serially.
 ..include:seqan/index.h
 */
 /*!
@@ -1863,6 +2315,8 @@ If bucketMap is of the type @Tag.Nothing@ the q-gram hash determines the bucket
 ..returns:Index contains the sorted list of qgrams. For each possible q-gram pos contains the first position in index that corresponds to this q-gram. 
 ..remarks:This function should not be called directly. Please use @Function.indexCreate@ or @Function.indexRequire@.
 The resulting tables must have appropriate size before calling this function.
+..remarks:The parallel construction yields the same tables as the serial one.
+It is used for q-gram indices with direct addressing only, indices with open addressing are always built serially.
 ..include:seqan/index.h
 */
 /*!
@@ -1158,6 +1158,18 @@ The hash value corresponds to the maximal @Function.hash2@ value of a shape begi
 		resize(bitmap, length(me), '1');
 	}
 
+	template <typename TShapeString, typename TValue>
+	inline void
+	shapeToString(
+		TShapeString &bitmap,
+		Shape<TValue, SimpleShape> const &me)
+	{
+	SEQAN_CHECKPOINT
+
+		clear(bitmap);
+		resize(bitmap, length(me), '1');
+	}
+
 //____________________________________________________________________________
 	
 ///.Function.reverse.param.object.type:Spec.SimpleShape
@@ -0,0 +1,419 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Bulk hashing of all overlapping q-grams of a sequence.
+//
+// For alphabets whose size is a power of two, the characters covered by the
+// shape span are kept bit-packed in one machine word (the window) and the
+// hash value is composed from the window with precomputed shift/mask pairs,
+// one pair per block of adjacent shape positions.  For packed strings the
+// windows are cut directly out of the host words without unpacking, the
+// per-window work is independent and can be vectorized by the compiler.
+// ==========================================================================
+
+#ifndef SEQAN_HEADER_SHAPE_BULK_H
+#define SEQAN_HEADER_SHAPE_BULK_H
+
+namespace SEQAN_NAMESPACE_MAIN
+{
+
+	//////////////////////////////////////////////////////////////////////////////
+	// shapes whose hash value is the rank of the q-gram at the shape positions
+
+	template <typename TShape>
+	struct HasBulkHash_:
+		public False {};
+
+	template <typename TValue>
+	struct HasBulkHash_< Shape<TValue, SimpleShape> >:
+		public True {};
+
+	template <typename TValue, unsigned q>
+	struct HasBulkHash_< Shape<TValue, UngappedShape<q> > >:
+		public True {};
+
+	template <typename TValue, typename TSpec>
+	struct HasBulkHash_< Shape<TValue, GappedShape<TSpec> > >:
+		public True {};
+
+	template <typename TValue>
+	struct HasBulkHash_< Shape<TValue, OneGappedShape> >:
+		public True {};
+
+	// shapes over alphabets with a power of two size are hashed with shifts and masks
+	template <typename TShape>
+	struct HasFastBulkHash_;
+
+	template <typename TValue, typename TSpec>
+	struct HasFastBulkHash_< Shape<TValue, TSpec> >:
+		public And<
+			HasBulkHash_< Shape<TValue, TSpec> >,
+			Eval<((__uint64)1 << Log2<ValueSize<TValue>::VALUE>::VALUE) == (__uint64)ValueSize<TValue>::VALUE>
+		>::Type {};
+
+	//////////////////////////////////////////////////////////////////////////////
+	// precomputed masks to compose a hash value from the window of span characters,
+	// every block of adjacent shape positions contributes (window >> shift) & mask
+
+	template <typename THValue>
+	struct ShapeHashMasks_
+	{
+		String<unsigned>	shifts;
+		String<THValue>		masks;
+	};
+
+	template <typename THValue, typename TValue, typename TSpec>
+	inline bool
+	_initShapeHashMasks(ShapeHashMasks_<THValue> &me, Shape<TValue, TSpec> const &shape)
+	{
+		const unsigned BITS = Log2<ValueSize<TValue>::VALUE>::VALUE;
+		const unsigned HBITS = 8 * sizeof(THValue);
+
+		CharString bitmap;
+		shapeToString(bitmap, shape);
+		unsigned span = length(bitmap);
+
+		clear(me.shifts);
+		clear(me.masks);
+		if (span == 0 || span * BITS > HBITS || bitmap[0] != '1') return false;
+
+		unsigned after = 0;			// number of shape positions right of the current block
+		for (unsigned i = 0; i < span; ++i)
+			if (bitmap[i] == '1') ++after;
+
+		for (unsigned i = 0; i < span; )
+		{
+			if (bitmap[i] != '1')
+			{
+				++i;
+				continue;
+			}
+			unsigned j = i;
+			while (j < span && bitmap[j] == '1') ++j;
+			after -= j - i;
+			appendValue(me.shifts, (span - j - after) * BITS);
+			appendValue(me.masks, (~(THValue)0 >> (HBITS - (j - i) * BITS)) << (after * BITS));
+			i = j;
+		}
+		return true;
+	}
+
+	template <typename THValue>
+	inline THValue
+	_applyShapeHashMasks(unsigned const *shifts, THValue const *masks, unsigned blocks, THValue window)
+	{
+		THValue h = (window >> shifts[0]) & masks[0];
+		for (unsigned b = 1; b < blocks; ++b)
+			h |= (window >> shifts[b]) & masks[b];
+		return h;
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	// window extraction
+
+	// generic text iterator, roll the window character by character
+	template <typename TTarget, typename THValue, typename TIter, typename TSize, typename TValue>
+	inline void
+	_hashAllWindows(TTarget &target, ShapeHashMasks_<THValue> const &me, unsigned span, TIter it, TSize count, TValue)
+	{
+		const unsigned BITS = Log2<ValueSize<TValue>::VALUE>::VALUE;
+		const unsigned HBITS = 8 * sizeof(THValue);
+
+		THValue const windowMask = ~(THValue)0 >> (HBITS - span * BITS);
+		unsigned blocks = length(me.shifts);
+		unsigned const *pShifts = begin(me.shifts, Standard());
+		THValue const *pMasks = begin(me.masks, Standard());
+
+		THValue window = 0;
+		for (unsigned i = 1; i < span; ++i, ++it)
+			window = (window << BITS) | ordValue((TValue)*it);
+
+		if (blocks == 1)
+			for (; count != 0; --count, ++it, ++target)
+			{
+				window = ((window << BITS) | ordValue((TValue)*it)) & windowMask;
+				*target = (window >> pShifts[0]) & pMasks[0];
+			}
+		else
+			for (; count != 0; --count, ++it, ++target)
+			{
+				window = ((window << BITS) | ordValue((TValue)*it)) & windowMask;
+				*target = _applyShapeHashMasks(pShifts, pMasks, blocks, window);
+			}
+	}
+
+	// packed string whose host words contain no unused bits, cut the windows out of two adjacent words
+	template <typename TTarget, typename THValue, typename TPackedString, typename THostspec, typename TSize, typename TValue>
+	inline void
+	_hashAllWindowsPacked(TTarget &target, ShapeHashMasks_<THValue> const &me, unsigned span,
+						  Iter<TPackedString, Packed<THostspec> > it, TSize count, TValue, True)
+	{
+		typedef PackedTraits_<typename RemoveConst<TPackedString>::Type>	TTraits;
+		typedef typename Host<Iter<TPackedString, Packed<THostspec> > >::Type	THostIter;
+
+		const unsigned BITS = TTraits::BITS_PER_VALUE;
+		const unsigned PER_WORD = TTraits::VALUES_PER_HOST_VALUE;
+
+		unsigned blocks = length(me.shifts);
+		unsigned const *pShifts = begin(me.shifts, Standard());
+		THValue const *pMasks = begin(me.masks, Standard());
+
+		unsigned downShift = 64 - span * BITS;
+		THostIter word = hostIterator(it);
+		unsigned local = it.localPos;
+
+		while (count != 0)
+		{
+			unsigned n = (count < (TSize)(PER_WORD - local))? (unsigned)count: PER_WORD - local;
+			__uint64 hi = word->i;
+			__uint64 lo = (local + n - 1 + span > PER_WORD)? (word + 1)->i: 0;
+
+			// windows starting in the same word are independent of each other
+			if (blocks == 1)
+				for (unsigned k = local * BITS; k < (local + n) * BITS; k += BITS, ++target)
+					*target = (THValue)(((hi << k) | ((lo >> 1) >> (63 - k))) >> downShift) & pMasks[0];
+			else
+				for (unsigned k = local * BITS; k < (local + n) * BITS; k += BITS, ++target)
+					*target = _applyShapeHashMasks(pShifts, pMasks, blocks,
+												   (THValue)(((hi << k) | ((lo >> 1) >> (63 - k))) >> downShift));
+			count -= n;
+			local = 0;
+			++word;
+		}
+	}
+
+	template <typename TTarget, typename THValue, typename TPackedString, typename THostspec, typename TSize, typename TValue>
+	inline void
+	_hashAllWindowsPacked(TTarget &target, ShapeHashMasks_<THValue> const &me, unsigned span,
+						  Iter<TPackedString, Packed<THostspec> > it, TSize count, TValue, False)
+	{
+		_hashAllWindows(target, me, span, it, count, TValue());
+	}
+
+	template <typename TTarget, typename THValue, typename TPackedString, typename THostspec, typename TSize, typename TValue>
+	inline void
+	_hashAllWindows(TTarget &target, ShapeHashMasks_<THValue> const &me, unsigned span,
+					Iter<TPackedString, Packed<THostspec> > it, TSize count, TValue)
+	{
+		typedef typename RemoveConst<TPackedString>::Type	TString;
+		typedef PackedTraits_<TString>						TTraits;
+		typedef typename Value<TString>::Type				TStringValue;
+		typedef typename And<
+			IsSameType<TStringValue, TValue>,
+			Eval<TTraits::WASTED_BITS == 0 && sizeof(typename TTraits::THostValue) == 8>
+		>::Type TDirect;
+
+		_hashAllWindowsPacked(target, me, span, it, count, TValue(), TDirect());
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+
+	template <typename TTarget, typename TValue, typename TSpec, typename TIter, typename TSize>
+	inline void
+	_hashAll(TTarget target, Shape<TValue, TSpec> &me, TIter it, TSize count, False)
+	{
+		if (count == 0) return;
+		*target = hash(me, it);
+		for (--count; count != 0; --count)
+		{
+			++it;
+			++target;
+			*target = hashNext(me, it);
+		}
+	}
+
+	// hash with masks computed by _initShapeHashMasks, without masks the q-grams are hashed one by one
+	template <typename TTarget, typename TValue, typename TSpec, typename THValue, typename TIter, typename TSize>
+	inline void
+	_hashAll(TTarget target, Shape<TValue, TSpec> &me, ShapeHashMasks_<THValue> const &masks, TIter it, TSize count,
+			 True)
+	{
+		if (count == 0) return;
+		if (empty(masks.masks))
+		{
+			_hashAll(target, me, it, count, False());
+			return;
+		}
+		_hashAllWindows(target, masks, length(me), it, count, TValue());
+
+		// leave the shape in the state of the last q-gram
+		hash(me, it + (count - 1));
+	}
+
+	template <typename TTarget, typename TValue, typename TSpec, typename THValue, typename TIter, typename TSize>
+	inline void
+	_hashAll(TTarget target, Shape<TValue, TSpec> &me, ShapeHashMasks_<THValue> const &, TIter it, TSize count,
+			 False)
+	{
+		_hashAll(target, me, it, count, False());
+	}
+
+	template <typename TTarget, typename TValue, typename TSpec, typename TIter, typename TSize>
+	inline void
+	_hashAll(TTarget target, Shape<TValue, TSpec> &me, TIter it, TSize count, True)
+	{
+		typedef typename Value< Shape<TValue, TSpec> >::Type	THValue;
+
+		if (count == 0) return;
+
+		ShapeHashMasks_<THValue> masks;
+		_initShapeHashMasks(masks, me);
+		_hashAll(target, me, masks, it, count, True());
+	}
+
+/**
+.Function.hashAll:
+..cat:Index
+..summary:Computes the hash values of all overlapping q-grams of a sequence at once.
+..signature:hashAll(codes, shape, text)
+..signature:hashAll(target, shape, it, count)
+..class:Class.Shape
+..param.codes:String the hash values are written to. It is resized to the number of q-grams in $text$.
+..param.shape:Shape to be used for hashing.
+...type:Class.Shape
+..param.text:The sequence whose q-grams are hashed.
+..param.target:Output iterator the hash values are written to.
+..param.it:Sequence iterator pointing to the first character of the first q-gram.
+..param.count:Number of q-grams to hash. $it$ must be followed by at least $count + length(shape) - 1$ characters.
+..remarks:The hash values are the same as computed by @Function.hash@ and @Function.hashNext@.
+Afterwards, $shape$ is in the same state as after calling @Function.hash@ on the last q-gram, so @Function.hashNext@ can be used to continue.
+For alphabets with a power of two size (e.g. @Spec.Dna@) and shapes spanning at most 64 bits, the characters are hashed with shifts and masks only,
+gapped shapes use one mask per block of adjacent shape positions and @Spec.Packed String@s are hashed without unpacking them.
+..see:Function.hash
+..see:Function.hashNext
+..include:seqan/index.h
+*/
+/*!
+ * @fn Shape#hashAll
+ *
+ * @headerfile seqan/index.h
+ *
+ * @brief Computes the hash values of all overlapping q-grams of a sequence at once.
+ *
+ * @signature void hashAll(codes, shape, text);
+ * @signature void hashAll(target, shape, it, count);
+ *
+ * @param codes  String the hash values are written to.  It is resized to the number of q-grams in <tt>text</tt>.
+ * @param shape  Shape to be used for hashing. Types: @link Shape @endlink
+ * @param text   The sequence whose q-grams are hashed.
+ * @param target Output iterator the hash values are written to.
+ * @param it     Sequence iterator pointing to the first character of the first q-gram.
+ * @param count  Number of q-grams to hash.  <tt>it</tt> must be followed by at least
+ *               <tt>count + length(shape) - 1</tt> characters.
+ *
+ * @section Remarks
+ *
+ * The hash values are the same as computed by @link Shape#hash @endlink and @link Shape#hashNext @endlink.
+ * Afterwards, <tt>shape</tt> is in the same state as after calling @link Shape#hash @endlink on the last q-gram.
+ *
+ * For alphabets with a power of two size (e.g. @link Dna @endlink) and shapes spanning at most 64 bits, the
+ * characters are hashed with shifts and masks only, gapped shapes use one mask per block of adjacent shape positions
+ * and @link PackedString Packed Strings @endlink are hashed without unpacking them.
+ *
+ * @see Shape#hash
+ * @see Shape#hashNext
+ */
+	template <typename TTarget, typename TValue, typename TSpec, typename TIter, typename TSize>
+	inline void
+	hashAll(TTarget target, Shape<TValue, TSpec> &me, TIter it, TSize count)
+	{
+		_hashAll(target, me, it, count, typename HasFastBulkHash_< Shape<TValue, TSpec> >::Type());
+	}
+
+	template <typename THValue, typename TStringSpec, typename TValue, typename TSpec, typename TText>
+	inline void
+	hashAll(String<THValue, TStringSpec> &codes, Shape<TValue, TSpec> &me, TText const &text)
+	{
+		typedef typename Size<TText>::Type TSize;
+
+		TSize span = length(me);
+		if (span == 0 || length(text) < span)
+		{
+			clear(codes);
+			return;
+		}
+		resize(codes, length(text) - span + 1, Exact());
+		hashAll(begin(codes, Standard()), me, begin(text, Standard()), length(codes));
+	}
+
+	//////////////////////////////////////////////////////////////////////////////
+	// helper for hash loops, hashes consecutive q-grams block-wise
+
+	template <typename TShape, typename TIter>
+	struct BulkHasher_
+	{
+		typedef typename Value<TShape>::Type			THValue;
+		typedef typename HasFastBulkHash_<TShape>::Type	TFast;
+		enum { BLOCK_SIZE = 1024 };
+
+		TShape		&shape;
+		TIter		it;
+		__uint64	left;
+		unsigned	cur, filled;
+		ShapeHashMasks_<THValue> masks;
+		THValue		codes[BLOCK_SIZE];
+
+		template <typename TSize>
+		BulkHasher_(TShape &_shape, TIter _it, TSize count):
+			shape(_shape),
+			it(_it),
+			left(count),
+			cur(0),
+			filled(0)
+		{
+			// the masks only depend on the shape, compute them once for all blocks
+			_initMasks(TFast());
+		}
+
+		inline void _initMasks(True)
+		{
+			_initShapeHashMasks(masks, shape);
+		}
+
+		inline void _initMasks(False) {}
+
+		inline THValue next()
+		{
+			if (cur == filled)
+			{
+				filled = (left < (__uint64)BLOCK_SIZE)? (unsigned)left: (unsigned)BLOCK_SIZE;
+				_hashAll(&codes[0], shape, masks, it, filled, TFast());
+				it += filled;
+				left -= filled;
+				cur = 0;
+			}
+			return codes[cur++];
+		}
+	};
+
+}	// namespace seqan
+
+#endif
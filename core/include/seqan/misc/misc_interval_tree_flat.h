@@ -0,0 +1,622 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// A static interval tree that is laid out implicitly in one array.  The
+// intervals are sorted by their begin position and the array is seen as an
+// in-order traversal of a complete binary tree, where the node at position
+// i of level k has its children at i -/+ 2^(k-1).  Each node is augmented
+// with the maximal end position of its subtree.
+// ==========================================================================
+
+#ifndef SEQAN_HEADER_MISC_INTERVAL_TREE_FLAT_H
+#define SEQAN_HEADER_MISC_INTERVAL_TREE_FLAT_H
+
+#include <algorithm>
+
+#include <seqan/misc/misc_interval_tree.h>
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Tag SortedQueries
+// ----------------------------------------------------------------------------
+
+/*!
+ * @tag SortedQueries
+ * @headerfile <seqan/misc/misc_interval_tree_flat.h>
+ * @brief Selects the sweep over queries sorted by their begin position in @link FlatIntervalTree#findIntervals
+ *        @endlink.
+ *
+ * @signature typedef Tag<SortedQueries_> SortedQueries;
+ */
+
+/**
+.Tag.SortedQueries
+..cat:Miscellaneous
+..summary:Selects the sweep over queries sorted by their begin position in @Function.FlatIntervalTree#findIntervals@.
+..signature:SortedQueries
+..include:seqan/misc/misc_interval_tree_flat.h
+*/
+
+struct SortedQueries_;
+typedef Tag<SortedQueries_> SortedQueries;
+
+// ----------------------------------------------------------------------------
+// Class FlatIntervalTree
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class FlatIntervalTree
+ * @headerfile <seqan/misc/misc_interval_tree_flat.h>
+ * @brief A static interval tree stored in one array sorted by begin positions.
+ *
+ * @signature template <[typename TValue[, typename TCargo]]>
+ *            class FlatIntervalTree;
+ *
+ * @tparam TValue The value type.  Default: <tt>int</tt>.
+ * @tparam TCargo The cargo/id type.  Default: <tt>unsigned</tt>.
+ *
+ * The tree has the same cargo and query interface as @link IntervalTree @endlink but no pointers between nodes.  The
+ * nodes are the sorted intervals themselves, a query descends the implicit tree and switches to a linear scan in
+ * subtrees of at most 15 intervals.  Queries neither allocate memory (besides the result string) nor follow pointers.
+ * The cargos of a query are reported in the order of the interval begin positions.  Intervals cannot be added or
+ * removed after construction.
+ *
+ * @fn FlatIntervalTree::FlatIntervalTree
+ * @brief Constructor
+ *
+ * @signature FlatIntervalTree::FlatIntervalTree();
+ * @signature FlatIntervalTree::FlatIntervalTree(intervals);
+ * @signature FlatIntervalTree::FlatIntervalTree(intervalBegins, intervalEnds, [intervalCargos,] len);
+ *
+ * @param[in] intervals      A string of <tt>IntervalAndCargo&lt;TValue, TCargo&gt;</tt> objects.
+ * @param[in] intervalBegins Iterator pointing to begin position of first interval.
+ * @param[in] intervalEnds   Iterator pointing to end position of first interval.
+ * @param[in] intervalCargos Iterator pointing to cargo/ids for intervals.  If omitted, the intervals are numbered
+ *                           consecutively.
+ * @param[in] len            Number of intervals to store in tree.
+ */
+
+/**
+.Class.FlatIntervalTree:
+..cat:Miscellaneous
+..summary:A static interval tree stored in one array sorted by begin positions.
+..signature:FlatIntervalTree<TValue, TCargo>
+..param.TValue:The value type.
+...default:int
+..param.TCargo:The cargo/id type.
+...default:unsigned
+..remarks:The tree has the same cargo and query interface as @Class.IntervalTree@ but no pointers between nodes.
+The nodes are the sorted intervals themselves, a query descends the implicit tree and switches to a linear scan in
+subtrees of at most 15 intervals.
+Queries neither allocate memory (besides the result string) nor follow pointers.
+The cargos of a query are reported in the order of the interval begin positions.
+Intervals cannot be added or removed after construction.
+..include:seqan/misc/misc_interval_tree_flat.h
+
+.Memfunc.FlatIntervalTree#FlatIntervalTree:
+..class:Class.FlatIntervalTree
+..summary:Constructor
+..signature:FlatIntervalTree()
+..signature:FlatIntervalTree(String<TInterval> intervals)
+..signature:FlatIntervalTree(intervalBegins, intervalEnds, len)
+..signature:FlatIntervalTree(intervalBegins, intervalEnds, intervalCargos, len)
+..param.intervals:Container of intervals.
+...type:Spec.Alloc String
+...remarks:A string of $IntervalAndCargo<TValue, TCargo>$ objects, see @Class.IntervalAndCargo@.
+..param.intervalBegins:Iterator pointing to begin position of first interval.
+..param.intervalEnds:Iterator pointing to end position of first interval.
+..param.intervalCargos:Iterator pointing to cargos/ids for intervals.
+..param.len:Number of intervals to store in tree.
+*/
+
+template <typename TValue = int, typename TCargo = unsigned int>
+class FlatIntervalTree
+{
+public:
+    typedef IntervalAndCargo<TValue, TCargo> TInterval;
+
+    // The intervals sorted by begin position and the maximal end position in the subtree of each of them.
+    String<TInterval> intervals;
+    String<TValue> maxEnds;
+    // The level of the root node, -1 for an empty tree.
+    int rootLevel;
+
+    FlatIntervalTree() : rootLevel(-1)
+    {}
+
+    template <typename TIterator, typename TCargoIterator>
+    FlatIntervalTree(TIterator intervalBegins, TIterator intervalEnds, TCargoIterator intervalCargos, size_t len) :
+        rootLevel(-1)
+    {
+        String<TInterval> tmp;
+        resize(tmp, len, Exact());
+        for (size_t i = 0; i < len; ++i, ++intervalBegins, ++intervalEnds, ++intervalCargos)
+            tmp[i] = TInterval(value(intervalBegins), value(intervalEnds), value(intervalCargos));
+        createIntervalTree(*this, tmp);
+    }
+
+    template <typename TIterator>
+    FlatIntervalTree(TIterator intervalBegins, TIterator intervalEnds, size_t len) :
+        rootLevel(-1)
+    {
+        String<TInterval> tmp;
+        resize(tmp, len, Exact());
+        for (size_t i = 0; i < len; ++i, ++intervalBegins, ++intervalEnds)
+            tmp[i] = TInterval(value(intervalBegins), value(intervalEnds), (TCargo)i);
+        createIntervalTree(*this, tmp);
+    }
+
+    FlatIntervalTree(String<TInterval> const & intervals_) :
+        rootLevel(-1)
+    {
+        createIntervalTree(*this, intervals_);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Class FlatIntervalTreeStackEntry_
+// ----------------------------------------------------------------------------
+
+// A node on the traversal stack: position, level and whether the left subtree is done.
+struct FlatIntervalTreeStackEntry_
+{
+    __int64 pos;
+    int level;
+    bool leftDone;
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Metafunction Value
+// ----------------------------------------------------------------------------
+
+///.Metafunction.Value.param.T.type:Class.FlatIntervalTree
+
+template <typename TValue, typename TCargo>
+struct Value<FlatIntervalTree<TValue, TCargo> >
+{
+    typedef TValue Type;
+};
+
+// ----------------------------------------------------------------------------
+// Metafunction Cargo
+// ----------------------------------------------------------------------------
+
+///.Metafunction.Cargo.param.T.type:Class.FlatIntervalTree
+
+template <typename TValue, typename TCargo>
+struct Cargo<FlatIntervalTree<TValue, TCargo> >
+{
+    typedef TCargo Type;
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function length()
+// ----------------------------------------------------------------------------
+
+///.Function.length.param.object.type:Class.FlatIntervalTree
+///.Function.length.class:Class.FlatIntervalTree
+
+template <typename TValue, typename TCargo>
+inline typename Size<String<IntervalAndCargo<TValue, TCargo> > >::Type
+length(FlatIntervalTree<TValue, TCargo> const & tree)
+{
+    return length(tree.intervals);
+}
+
+// ----------------------------------------------------------------------------
+// Function empty()
+// ----------------------------------------------------------------------------
+
+///.Function.empty.param.object.type:Class.FlatIntervalTree
+///.Function.empty.class:Class.FlatIntervalTree
+
+template <typename TValue, typename TCargo>
+inline bool
+empty(FlatIntervalTree<TValue, TCargo> const & tree)
+{
+    return empty(tree.intervals);
+}
+
+// ----------------------------------------------------------------------------
+// Function clear()
+// ----------------------------------------------------------------------------
+
+///.Function.clear.param.object.type:Class.FlatIntervalTree
+///.Function.clear.class:Class.FlatIntervalTree
+
+template <typename TValue, typename TCargo>
+inline void
+clear(FlatIntervalTree<TValue, TCargo> & tree)
+{
+    clear(tree.intervals);
+    clear(tree.maxEnds);
+    tree.rootLevel = -1;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _flatIntervalTreeLessBegin()
+// ----------------------------------------------------------------------------
+
+template <typename TInterval>
+inline bool
+_flatIntervalTreeLessBegin(TInterval const & a, TInterval const & b)
+{
+    return a.i1 < b.i1;
+}
+
+// ----------------------------------------------------------------------------
+// Function createIntervalTree()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn FlatIntervalTree#createIntervalTree
+ * @brief Builds a flat interval tree from a string of intervals, replacing its previous content.
+ *
+ * @signature void createIntervalTree(tree, intervals);
+ *
+ * @param[out] tree      The FlatIntervalTree to build.
+ * @param[in]  intervals A string of <tt>IntervalAndCargo&lt;TValue, TCargo&gt;</tt> objects.
+ */
+
+/**
+.Function.FlatIntervalTree#createIntervalTree
+..class:Class.FlatIntervalTree
+..cat:Miscellaneous
+..summary:Builds a flat interval tree from a string of intervals, replacing its previous content.
+..signature:createIntervalTree(tree, intervals)
+..param.tree:The tree to build.
+...type:Class.FlatIntervalTree
+..param.intervals:A string of $IntervalAndCargo<TValue, TCargo>$ objects.
+...type:Class.IntervalAndCargo
+..include:seqan/misc/misc_interval_tree_flat.h
+*/
+
+template <typename TValue, typename TCargo, typename TIntervals>
+inline void
+createIntervalTree(FlatIntervalTree<TValue, TCargo> & tree, TIntervals const & intervals)
+{
+    typedef IntervalAndCargo<TValue, TCargo> TInterval;
+
+    __int64 n = length(intervals);
+    assign(tree.intervals, intervals, Exact());
+    std::stable_sort(begin(tree.intervals, Standard()), end(tree.intervals, Standard()),
+                     _flatIntervalTreeLessBegin<TInterval>);
+    resize(tree.maxEnds, n, Exact());
+    tree.rootLevel = -1;
+    if (n == 0)
+        return;
+
+    // Level 0 consists of the even positions, they are leaves.
+    __int64 lastPos = 0;
+    TValue lastMax = TValue();
+    for (__int64 i = 0; i < n; i += 2)
+    {
+        lastPos = i;
+        lastMax = tree.maxEnds[i] = tree.intervals[i].i2;
+    }
+
+    // The nodes of level k are at positions (2^k - 1) + j * 2^(k+1).  A missing right child (position >= n) is
+    // represented by the rightmost node of the level below.
+    int level = 1;
+    for (; ((__int64)1 << level) <= n; ++level)
+    {
+        __int64 x = (__int64)1 << (level - 1);
+        __int64 step = x << 2;
+        for (__int64 i = (x << 1) - 1; i < n; i += step)
+        {
+            TValue endLeft = tree.maxEnds[i - x];
+            TValue endRight = (i + x < n) ? tree.maxEnds[i + x] : lastMax;
+            TValue e = tree.intervals[i].i2;
+            if (e < endLeft)
+                e = endLeft;
+            if (e < endRight)
+                e = endRight;
+            tree.maxEnds[i] = e;
+        }
+        lastPos = ((lastPos >> level) & 1) ? lastPos - x : lastPos + x;
+        if (lastPos < n && lastMax < tree.maxEnds[lastPos])
+            lastMax = tree.maxEnds[lastPos];
+    }
+    tree.rootLevel = level - 1;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _findIntervalsFlat()
+// ----------------------------------------------------------------------------
+
+// Appends the cargos of all intervals [i1, i2) with i1 < queryEnd (i1 <= queryEnd if closedEnd is set) and
+// queryBegin < i2.  The traversal follows the cgranges algorithm and visits the intervals in sorted order.
+template <typename TValue, typename TCargo, typename TResult>
+inline void
+_findIntervalsFlat(FlatIntervalTree<TValue, TCargo> const & tree,
+                   TValue queryBegin,
+                   TValue queryEnd,
+                   bool closedEnd,
+                   TResult & result)
+{
+    typedef IntervalAndCargo<TValue, TCargo> TInterval_;
+
+    if (tree.rootLevel < 0)
+        return;
+
+    __int64 n = length(tree.intervals);
+    FlatIntervalTreeStackEntry_ stack[64];
+    int top = 0;
+    stack[top].pos = ((__int64)1 << tree.rootLevel) - 1;
+    stack[top].level = tree.rootLevel;
+    stack[top++].leftDone = false;
+
+    while (top != 0)
+    {
+        FlatIntervalTreeStackEntry_ z = stack[--top];
+        if (z.level <= 3)
+        {
+            // Small subtree, scan it linearly.
+            __int64 i = z.pos >> z.level << z.level;
+            __int64 iEnd = i + ((__int64)1 << (z.level + 1)) - 1;
+            if (iEnd > n)
+                iEnd = n;
+            for (; i < iEnd; ++i)
+            {
+                TInterval_ const & interval = tree.intervals[i];
+                if (closedEnd ? queryEnd < interval.i1 : !(interval.i1 < queryEnd))
+                    break;
+                if (queryBegin < interval.i2)
+                    appendValue(result, interval.cargo, Generous());
+            }
+        }
+        else if (!z.leftDone)
+        {
+            // Revisit the node after its left subtree, descend only if the left subtree can reach the query.
+            __int64 left = z.pos - ((__int64)1 << (z.level - 1));
+            stack[top].pos = z.pos;
+            stack[top].level = z.level;
+            stack[top++].leftDone = true;
+            if (left >= n || queryBegin < tree.maxEnds[left])
+            {
+                stack[top].pos = left;
+                stack[top].level = z.level - 1;
+                stack[top++].leftDone = false;
+            }
+        }
+        else if (z.pos < n)
+        {
+            TInterval_ const & interval = tree.intervals[z.pos];
+            if (closedEnd ? queryEnd < interval.i1 : !(interval.i1 < queryEnd))
+                continue;
+            if (queryBegin < interval.i2)
+                appendValue(result, interval.cargo, Generous());
+            stack[top].pos = z.pos + ((__int64)1 << (z.level - 1));
+            stack[top].level = z.level - 1;
+            stack[top++].leftDone = false;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function findIntervals()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn FlatIntervalTree#findIntervals
+ * @brief Find all intervals that contain the query point or overlap with the query interval.
+ *
+ * @signature void findIntervals(tree, query, result);
+ * @signature void findIntervals(tree, queryBegin, queryEnd, result);
+ * @signature void findIntervals(tree, queryBegins, queryEnds, results[, SortedQueries()]);
+ *
+ * @param[in]  tree        The FlatIntervalTree to query.
+ * @param[in]  query       A query point.
+ * @param[in]  queryBegin  The begin position of the query interval.
+ * @param[in]  queryEnd    The end position of the query interval.
+ * @param[in]  queryBegins A string with the begin positions of a batch of query intervals.
+ * @param[in]  queryEnds   A string with the end positions of a batch of query intervals.
+ * @param[out] result      A string of <tt>TCargo</tt> objects.  The string is cleared first, its capacity is kept.
+ * @param[out] results     A @link ConcatDirectStringSet @endlink of <tt>TCargo</tt> strings with one entry per query.
+ *
+ * The batch variant appends all results into one string set and does not allocate per query.  With
+ * <tt>SortedQueries()</tt> the queries must be sorted by their begin positions, the intervals are then swept from left
+ * to right instead of descending the tree for each query, which is faster for dense queries such as the alignments
+ * of a sorted BAM file.  All variants report the cargos in the order of the interval begin positions.
+ */
+
+/**
+.Function.FlatIntervalTree#findIntervals
+..class:Class.FlatIntervalTree
+..cat:Miscellaneous
+..summary:Find all intervals that contain the query point or overlap with the query interval.
+..signature:findIntervals(tree, query, result)
+..signature:findIntervals(tree, queryBegin, queryEnd, result)
+..signature:findIntervals(tree, queryBegins, queryEnds, results[, SortedQueries()])
+..param.tree:The tree to query.
+...type:Class.FlatIntervalTree
+..param.query:A query point.
+..param.queryBegin:The begin position of the query interval.
+..param.queryEnd:The end position of the query interval.
+..param.queryBegins:A string with the begin positions of a batch of query intervals.
+..param.queryEnds:A string with the end positions of a batch of query intervals.
+..param.result:A string of $TCargo$ objects.
+The string is cleared first, its capacity is kept.
+...type:Class.String
+..param.results:A string set of $TCargo$ strings with one entry per query.
+...type:Spec.ConcatDirect
+..remarks:The batch variant appends all results into one string set and does not allocate per query.
+With $SortedQueries()$ the queries must be sorted by their begin positions, the intervals are then swept from left to
+right instead of descending the tree for each query, which is faster for dense queries such as the alignments of a
+sorted BAM file.
+All variants report the cargos in the order of the interval begin positions.
+..include:seqan/misc/misc_interval_tree_flat.h
+*/
+
+template <typename TValue, typename TCargo, typename TSpec>
+inline void
+findIntervals(FlatIntervalTree<TValue, TCargo> const & tree,
+              TValue query,
+              String<TCargo, TSpec> & result)
+{
+    clear(result);
+    _findIntervalsFlat(tree, query, query, true, result);
+}
+
+template <typename TValue, typename TCargo, typename TSpec>
+inline void
+findIntervals(FlatIntervalTree<TValue, TCargo> const & tree,
+              TValue queryBegin,
+              TValue queryEnd,
+              String<TCargo, TSpec> & result)
+{
+    clear(result);
+    _findIntervalsFlat(tree, queryBegin, queryEnd, false, result);
+}
+
+template <typename TValue, typename TCargo, typename TQueries, typename TString, typename TSpec>
+inline void
+findIntervals(FlatIntervalTree<TValue, TCargo> const & tree,
+              TQueries const & queryBegins,
+              TQueries const & queryEnds,
+              StringSet<TString, Owner<ConcatDirect<TSpec> > > & results)
+{
+    typedef typename Size<TQueries>::Type TSize;
+
+    SEQAN_ASSERT_EQ(length(queryBegins), length(queryEnds));
+
+    clear(results);
+    for (TSize i = 0; i < length(queryBegins); ++i)
+    {
+        _findIntervalsFlat(tree, (TValue)queryBegins[i], (TValue)queryEnds[i], false, results.concat);
+        appendValue(results.limits, length(results.concat));
+    }
+}
+
+template <typename TValue, typename TCargo, typename TQueries, typename TString, typename TSpec>
+inline void
+findIntervals(FlatIntervalTree<TValue, TCargo> const & tree,
+              TQueries const & queryBegins,
+              TQueries const & queryEnds,
+              StringSet<TString, Owner<ConcatDirect<TSpec> > > & results,
+              SortedQueries)
+{
+    typedef typename Size<TQueries>::Type TSize;
+    typedef typename Size<String<IntervalAndCargo<TValue, TCargo> > >::Type TPos;
+    typedef typename Iterator<String<TPos>, Standard>::Type TActiveIter;
+
+    SEQAN_ASSERT_EQ(length(queryBegins), length(queryEnds));
+
+    clear(results);
+
+    // The active intervals begin left of a previous query end and have not ended before the current query begin.
+    // They are kept in sorted order, intervals that end before a query begin can never overlap a later query.
+    String<TPos> active;
+    TPos next = 0;
+    for (TSize i = 0; i < length(queryBegins); ++i)
+    {
+        TValue queryBegin = queryBegins[i];
+        TValue queryEnd = queryEnds[i];
+        SEQAN_ASSERT(i == 0 || !(queryBegin < (TValue)queryBegins[i - 1]));
+
+        for (; next < length(tree.intervals) && tree.intervals[next].i1 < queryEnd; ++next)
+            appendValue(active, next);
+
+        TActiveIter itDst = begin(active, Standard());
+        for (TActiveIter it = itDst; it != end(active, Standard()); ++it)
+        {
+            IntervalAndCargo<TValue, TCargo> const & interval = tree.intervals[*it];
+            if (!(queryBegin < interval.i2))
+                continue;
+            *itDst++ = *it;
+            if (interval.i1 < queryEnd)
+                appendValue(results.concat, interval.cargo, Generous());
+        }
+        resize(active, itDst - begin(active, Standard()));
+        appendValue(results.limits, length(results.concat));
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function findIntervalsExcludeTouching()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn FlatIntervalTree#findIntervalsExcludeTouching
+ * @brief Find all intervals that contain the query point, exclude intervals that touch the query, i.e. where the query
+ *        point equals the start or end point.
+ *
+ * @signature void findIntervalsExcludeTouching(tree, query, result);
+ *
+ * @param[in]  tree   The FlatIntervalTree to query.
+ * @param[in]  query  The query point.
+ * @param[out] result A string of <tt>TCargo</tt> objects.
+ */
+
+/**
+.Function.FlatIntervalTree#findIntervalsExcludeTouching
+..class:Class.FlatIntervalTree
+..cat:Miscellaneous
+..summary:Find all intervals that contain the query point, exclude intervals that touch the query, i.e. where the query point equals the start or end point.
+..signature:findIntervalsExcludeTouching(tree, query, result)
+..param.tree:The tree to query.
+...type:Class.FlatIntervalTree
+..param.query:The query point.
+..param.result:A string of $TCargo$ objects.
+...type:Class.String
+..include:seqan/misc/misc_interval_tree_flat.h
+*/
+
+template <typename TValue, typename TCargo, typename TSpec>
+inline void
+findIntervalsExcludeTouching(FlatIntervalTree<TValue, TCargo> const & tree,
+                             TValue query,
+                             String<TCargo, TSpec> & result)
+{
+    clear(result);
+    _findIntervalsFlat(tree, query, query, false, result);
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_HEADER_MISC_INTERVAL_TREE_FLAT_H
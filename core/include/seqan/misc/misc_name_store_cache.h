@@ -50,6 +50,30 @@ namespace seqan {
 // Tags, Classes, Enums
 // ============================================================================
 
+// ----------------------------------------------------------------------------
+// Tag NameStoreHash
+// ----------------------------------------------------------------------------
+
+/*!
+ * @tag NameStoreCache#NameStoreHash
+ * @headerfile <seqan/misc/misc_name_store_cache.h>
+ * @brief Selects the hash table based @link HashNameStoreCache @endlink.
+ *
+ * @signature typedef Tag<NameStoreHash_> NameStoreHash;
+ */
+
+/**
+.Tag.NameStoreHash
+..summary:Selects the hash table based @Spec.Hash NameStoreCache@.
+..cat:Fragment Store
+..signature:NameStoreHash
+..see:Class.NameStoreCache
+..include:seqan/store.h
+*/
+
+struct NameStoreHash_;
+typedef Tag<NameStoreHash_> NameStoreHash;
+
 // ----------------------------------------------------------------------------
 // struct NameStoreLess_
 // ----------------------------------------------------------------------------
@@ -96,11 +120,13 @@ struct NameStoreLess_
  * @headerfile <seqan/misc/misc_name_store_cache.h>
  * @brief Stores a mapping from names to ids.
  *
- * @signature template <typename TNameStore[, typename TName]>
+ * @signature template <typename TNameStore[, typename TName[, typename TSpec]]>
  *            class NameStoreCache;
  *
  * @tparam TNameStore The type to use for the name store.  Usually a @link StringSet @endlink.
  * @tparam TName      The type to use for the names.  Defaults to <tt>Value&lt;TNameStore&gt;::Type</tt>.
+ * @tparam TSpec      The specializing type.  Defaults to <tt>void</tt> which uses a balanced search tree
+ *                    with O(log n) lookups.  Use @link NameStoreCache#NameStoreHash @endlink for a hash table.
  *
  *
  * @fn NameStoreCache::NameStoreCache
@@ -116,12 +142,15 @@ struct NameStoreLess_
 ..summary:Stores a mapping from names to ids.
 ..cat:Fragment Store
 ..signature:FragmentStore<>
-..signature:NameStoreCache<TNameStore[, TName]>
+..signature:NameStoreCache<TNameStore[, TName[, TSpec]]>
 ..param.TNameStore:The name store to be cached.
 ...see:Class.FragmentStore
 ..param.TName:The name type.
 ...default:$Value<TNameStore>::Type$
 ...type:Shortcut.CharString
+..param.TSpec:The specializing type.
+...default:$void$, a balanced search tree with O(log n) lookups.
+...type:Tag.NameStoreHash
 
 .Memfunc.NameStoreCache#NameStoreCache
 ..summary:Constructor
@@ -132,7 +161,7 @@ struct NameStoreLess_
 ..include:seqan/store.h
 */
 	
-template <typename TNameStore, typename TName = typename Value<TNameStore>::Type>
+template <typename TNameStore, typename TName = typename Value<TNameStore>::Type, typename TSpec = void>
 class NameStoreCache
 {
 public:
@@ -154,6 +183,62 @@ public:
     }
 };
 
+// ----------------------------------------------------------------------------
+// class HashNameStoreCache
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class HashNameStoreCache
+ * @extends NameStoreCache
+ * @headerfile <seqan/misc/misc_name_store_cache.h>
+ * @brief Stores a mapping from names to ids in a hash table.
+ *
+ * @signature template <typename TNameStore, typename TName>
+ *            class NameStoreCache<TNameStore, TName, NameStoreHash>;
+ *
+ * @tparam TNameStore The type to use for the name store.  Usually a @link StringSet @endlink.
+ * @tparam TName      The type to use for the names.
+ *
+ * The ids are kept in an open addressing table with linear probing that is resized to keep a load factor
+ * below 1/2.  @link NameStoreCache#getIdByName @endlink and @link NameStoreCache#appendName @endlink
+ * take expected constant time and compare only names with the same hash value.  The constructor and
+ * @link NameStoreCache#refresh @endlink build the table for the whole name store at once.
+ */
+
+/**
+.Spec.Hash NameStoreCache
+..general:Class.NameStoreCache
+..summary:Stores a mapping from names to ids in a hash table.
+..cat:Fragment Store
+..signature:NameStoreCache<TNameStore, TName, NameStoreHash>
+..param.TNameStore:The name store to be cached.
+..param.TName:The name type.
+..remarks:The ids are kept in an open addressing table with linear probing that is resized to keep a load factor below 1/2.
+@Function.getIdByName@ and @Function.appendName@ take expected constant time.
+The constructor and @Function.refresh@ build the table for the whole name store at once.
+..include:seqan/store.h
+*/
+
+template <typename TNameStore, typename TName>
+class NameStoreCache<TNameStore, TName, NameStoreHash>
+{
+public:
+    typedef typename Position<TNameStore>::Type TId;
+    typedef __uint32                            THashValue;
+
+    String<TId> table;              // ids of the names, maxValue<TId>() marks an empty slot
+    String<THashValue> hashes;      // hash values of the names in the slots
+    TId count;
+    TNameStore *nameStore;
+
+    NameStoreCache(TNameStore &_nameStore):
+        count(0),
+        nameStore(&_nameStore)
+    {
+        refresh(*this);
+    }
+};
+
 // ============================================================================
 // Metafunctions
 // ============================================================================
@@ -162,6 +247,108 @@ public:
 // Functions
 // ============================================================================
 
+// ----------------------------------------------------------------------------
+// Function _nameStoreHash()
+// ----------------------------------------------------------------------------
+
+// FNV-1a hash of the characters of a name.
+template <typename TName>
+inline __uint32
+_nameStoreHash(TName const & name)
+{
+    typedef typename Iterator<TName const, Standard>::Type TIter;
+
+    __uint32 h = 2166136261u;
+    for (TIter it = begin(name, Standard()); it != end(name, Standard()); ++it)
+    {
+        h ^= static_cast<__uint32>(ordValue(*it));
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// ----------------------------------------------------------------------------
+// Function _nameStoreCacheFindSlot()
+// ----------------------------------------------------------------------------
+
+// Returns the slot that stores name or the empty slot where it would be inserted.
+template <typename TNameStore, typename TCName, typename TName>
+inline typename Size<String<typename Position<TNameStore>::Type> >::Type
+_nameStoreCacheFindSlot(NameStoreCache<TNameStore, TCName, NameStoreHash> const & cache, TName const & name, __uint32 h)
+{
+    typedef NameStoreCache<TNameStore, TCName, NameStoreHash>   TCache;
+    typedef typename TCache::TId                                TId;
+    typedef typename Size<String<TId> >::Type                   TSlot;
+
+    TSlot mask = length(cache.table) - 1;
+    for (TSlot slot = h & mask; ; slot = (slot + 1) & mask)
+    {
+        TId id = cache.table[slot];
+        if (id == maxValue<TId>())
+            return slot;
+        if (cache.hashes[slot] == h && (*cache.nameStore)[id] == name)
+            return slot;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _nameStoreCacheInsert()
+// ----------------------------------------------------------------------------
+
+// Registers the name with the given id.  If the name is already registered the old id is kept.
+template <typename TNameStore, typename TCName, typename TId>
+inline void
+_nameStoreCacheInsert(NameStoreCache<TNameStore, TCName, NameStoreHash> & cache, TId id)
+{
+    __uint32 h = _nameStoreHash((*cache.nameStore)[id]);
+    typename Size<String<TId> >::Type slot = _nameStoreCacheFindSlot(cache, (*cache.nameStore)[id], h);
+    if (cache.table[slot] != maxValue(cache.table[slot]))
+        return;
+    cache.table[slot] = id;
+    cache.hashes[slot] = h;
+    ++cache.count;
+}
+
+// ----------------------------------------------------------------------------
+// Function _nameStoreCacheRehash()
+// ----------------------------------------------------------------------------
+
+// Resizes the table to at least twice the given number of names and reinserts the registered names.
+template <typename TNameStore, typename TCName, typename TSize>
+inline void
+_nameStoreCacheRehash(NameStoreCache<TNameStore, TCName, NameStoreHash> & cache, TSize minNames)
+{
+    typedef NameStoreCache<TNameStore, TCName, NameStoreHash>   TCache;
+    typedef typename TCache::TId                                TId;
+    typedef typename TCache::THashValue                         THashValue;
+    typedef typename Size<String<TId> >::Type                   TSlot;
+
+    TSlot newSize = 16;
+    while (newSize < 2 * (TSlot)minNames)
+        newSize <<= 1;
+
+    String<TId> oldTable;
+    String<THashValue> oldHashes;
+    swap(oldTable, cache.table);
+    swap(oldHashes, cache.hashes);
+
+    resize(cache.table, newSize, maxValue<TId>(), Exact());
+    resize(cache.hashes, newSize, Exact());
+
+    // the hash values of registered names are kept, only the slots are recomputed
+    TSlot mask = newSize - 1;
+    for (TSlot i = 0; i < length(oldTable); ++i)
+    {
+        if (oldTable[i] == maxValue<TId>())
+            continue;
+        TSlot slot = oldHashes[i] & mask;
+        while (cache.table[slot] != maxValue<TId>())
+            slot = (slot + 1) & mask;
+        cache.table[slot] = oldTable[i];
+        cache.hashes[slot] = oldHashes[i];
+    }
+}
+
 // ----------------------------------------------------------------------------
 // refresh()
 // ----------------------------------------------------------------------------
@@ -196,6 +383,21 @@ refresh(NameStoreCache<TNameStore, TName> &cache)
         cache.nameSet.insert(i);
 }
 
+template <typename TNameStore, typename TName>
+inline void
+refresh(NameStoreCache<TNameStore, TName, NameStoreHash> &cache)
+{
+    typedef typename Position<TNameStore>::Type TId;
+
+    // bulk construction, the table is sized for the whole name store at once
+    clear(cache.table);
+    clear(cache.hashes);
+    cache.count = 0;
+    _nameStoreCacheRehash(cache, length(*cache.nameStore));
+    for (TId i = 0; i < (TId)length(*cache.nameStore); ++i)
+        _nameStoreCacheInsert(cache, i);
+}
+
 
 // ----------------------------------------------------------------------------
 // getIdByName()
@@ -292,6 +494,21 @@ getIdByName(TNameStore const & /*nameStore*/, TName const & name, TPos & pos, Na
     return false;
 }
 
+template<typename TNameStore, typename TName, typename TPos, typename TCNameStore, typename TCName>
+inline bool
+getIdByName(TNameStore const & /*nameStore*/, TName const & name, TPos & pos,
+            NameStoreCache<TCNameStore, TCName, NameStoreHash> const & context)
+{
+    typedef typename Position<TCNameStore>::Type TId;
+
+    // unlike the tree based cache, the lookup does not modify the cache and is thread-safe
+    TId id = context.table[_nameStoreCacheFindSlot(context, name, _nameStoreHash(name))];
+    if (id == maxValue<TId>())
+        return false;
+    pos = id;
+    return true;
+}
+
 // ----------------------------------------------------------------------------
 // appendName()
 // ----------------------------------------------------------------------------
@@ -345,6 +562,16 @@ appendName(TNameStore &nameStore, TName const & name, NameStoreCache<TCNameStore
     context.nameSet.insert(length(nameStore) - 1);
 }
 
+template <typename TNameStore, typename TName, typename TCNameStore, typename TCName>
+inline void
+appendName(TNameStore &nameStore, TName const & name, NameStoreCache<TCNameStore, TCName, NameStoreHash> &context)
+{
+    appendValue(nameStore, name, Generous());
+    if (2 * (context.count + 1) > length(context.table))
+        _nameStoreCacheRehash(context, context.count + 1);
+    _nameStoreCacheInsert(context, length(nameStore) - 1);
+}
+
 }  // namespace seqan
 
 #endif  // #ifndef SEQAN_HEADER_MISC_NAME_STORE_CACHE_H
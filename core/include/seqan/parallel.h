@@ -61,6 +61,10 @@
 // Parallel variants of basic algorithms
 #include <seqan/parallel/parallel_algorithms.h>
 
+// Locks and job queues.
+#include <seqan/parallel/parallel_lock.h>
+#include <seqan/parallel/parallel_work_stealing.h>
+
 //____________________________________________________________________________
 
 #endif  // SEQAN_PARALLEL_H_
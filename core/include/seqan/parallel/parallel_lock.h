@@ -0,0 +1,207 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Lightweight spin lock built upon atomic primitives.
+// ==========================================================================
+
+// SEQAN_NO_GENERATED_FORWARDS: No forwards are generated for this file.
+
+#ifndef SEQAN_PARALLEL_PARALLEL_LOCK_H_
+#define SEQAN_PARALLEL_PARALLEL_LOCK_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class SpinLock
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class SpinLock
+ * @headerfile <seqan/parallel.h>
+ * @brief A lock that busy-waits instead of putting the thread to sleep.
+ *
+ * @signature class SpinLock;
+ *
+ * Spin locks are cheaper than OpenMP or system locks if they are held only for a few instructions and rarely
+ * contended, e.g. to guard a per-thread container that is only occasionally accessed by other threads.
+ * Use @link SpinLock#lock @endlink and @link SpinLock#unlock @endlink or the @link ScopedSpinLock @endlink.
+ */
+
+/**
+.Class.SpinLock
+..cat:Parallelism
+..summary:A lock that busy-waits instead of putting the thread to sleep.
+..signature:SpinLock
+..remarks:Spin locks are cheaper than OpenMP or system locks if they are held only for a few instructions and rarely contended,
+e.g. to guard a per-thread container that is only occasionally accessed by other threads.
+..include:seqan/parallel.h
+*/
+
+class SpinLock
+{
+public:
+    unsigned volatile state;
+
+    SpinLock() : state(0)
+    {}
+
+    // a copied lock is always unlocked
+    SpinLock(SpinLock const &) : state(0)
+    {}
+
+    SpinLock & operator=(SpinLock const &)
+    {
+        return *this;
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Class ScopedSpinLock
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class ScopedSpinLock
+ * @headerfile <seqan/parallel.h>
+ * @brief Holds a @link SpinLock @endlink for the lifetime of the object.
+ *
+ * @signature class ScopedSpinLock;
+ */
+
+/**
+.Class.ScopedSpinLock
+..cat:Parallelism
+..summary:Holds a @Class.SpinLock@ for the lifetime of the object.
+..signature:ScopedSpinLock(spinLock)
+..include:seqan/parallel.h
+*/
+
+class ScopedSpinLock;
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function lock()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn SpinLock#lock
+ * @brief Acquire the lock, busy-waits until it is available.
+ *
+ * @signature void lock(spinLock);
+ */
+
+/**
+.Function.SpinLock#lock
+..class:Class.SpinLock
+..summary:Acquire the lock, busy-waits until it is available.
+..cat:Parallelism
+..signature:lock(spinLock)
+..param.spinLock:The lock.
+...type:Class.SpinLock
+..include:seqan/parallel.h
+*/
+
+inline void
+lock(SpinLock & spinLock)
+{
+    while (spinLock.state != 0u || atomicCas(spinLock.state, 0u, 1u) != 0u)
+    {}
+}
+
+// ----------------------------------------------------------------------------
+// Function unlock()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn SpinLock#unlock
+ * @brief Release the lock.
+ *
+ * @signature void unlock(spinLock);
+ */
+
+/**
+.Function.SpinLock#unlock
+..class:Class.SpinLock
+..summary:Release the lock.
+..cat:Parallelism
+..signature:unlock(spinLock)
+..param.spinLock:The lock.
+...type:Class.SpinLock
+..include:seqan/parallel.h
+*/
+
+inline void
+unlock(SpinLock & spinLock)
+{
+    atomicCas(spinLock.state, 1u, 0u);      // full memory barrier
+}
+
+// ----------------------------------------------------------------------------
+// Class ScopedSpinLock
+// ----------------------------------------------------------------------------
+
+class ScopedSpinLock
+{
+public:
+    SpinLock & spinLock;
+
+    explicit ScopedSpinLock(SpinLock & spinLock_) : spinLock(spinLock_)
+    {
+        lock(spinLock);
+    }
+
+    ~ScopedSpinLock()
+    {
+        unlock(spinLock);
+    }
+
+private:
+    ScopedSpinLock(ScopedSpinLock const &);
+    ScopedSpinLock & operator=(ScopedSpinLock const &);
+};
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_PARALLEL_PARALLEL_LOCK_H_
@@ -0,0 +1,438 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Work-stealing job queue with one deque per thread.
+// ==========================================================================
+
+// SEQAN_NO_GENERATED_FORWARDS: No forwards are generated for this file.
+
+#ifndef SEQAN_PARALLEL_PARALLEL_WORK_STEALING_H_
+#define SEQAN_PARALLEL_PARALLEL_WORK_STEALING_H_
+
+#include <deque>
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class WorkStealingDeque_
+// ----------------------------------------------------------------------------
+
+// The deque of a single thread.  The padding keeps the locks of different threads
+// in different cache lines.
+template <typename TValue>
+struct WorkStealingDeque_
+{
+    std::deque<TValue> jobs;
+    size_t volatile size;           // length of jobs, can be read without holding the lock
+    SpinLock lock;
+    unsigned rng;                   // state of the victim selection
+    char _padding[64];
+
+    WorkStealingDeque_() : size(0), rng(1)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Class WorkStealingQueue
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class WorkStealingQueue
+ * @headerfile <seqan/parallel.h>
+ * @brief A job queue with one deque per thread and work stealing.
+ *
+ * @signature template <typename TValue[, typename TSpec]>
+ *            class WorkStealingQueue;
+ *
+ * @tparam TValue The job type.
+ * @tparam TSpec  The specializing type.  Default: <tt>void</tt>.
+ *
+ * Each thread pushes and pops jobs at the front of its own deque.  Only if its deque is empty, a thread steals
+ * the oldest job from the back of the deque of another thread.  Every deque is guarded by its own
+ * @link SpinLock @endlink, so threads only contend while stealing, not on every push and pop as with a single
+ * shared queue.
+ *
+ * @fn WorkStealingQueue::WorkStealingQueue
+ * @brief Constructor
+ *
+ * @signature WorkStealingQueue::WorkStealingQueue(threadCount);
+ *
+ * @param threadCount The number of threads that use the queue, their ids must be in <tt>[0, threadCount)</tt>.
+ */
+
+/**
+.Class.WorkStealingQueue
+..cat:Parallelism
+..summary:A job queue with one deque per thread and work stealing.
+..signature:WorkStealingQueue<TValue[, TSpec]>
+..param.TValue:The job type.
+..param.TSpec:The specializing type.
+...default:$void$
+..remarks:Each thread pushes and pops jobs at the front of its own deque.
+Only if its deque is empty, a thread steals the oldest job from the back of the deque of another thread.
+Every deque is guarded by its own @Class.SpinLock@, so threads only contend while stealing, not on every push and pop as with a single shared queue.
+..include:seqan/parallel.h
+
+.Memfunc.WorkStealingQueue#WorkStealingQueue
+..class:Class.WorkStealingQueue
+..summary:Constructor
+..signature:WorkStealingQueue(threadCount)
+..param.threadCount:The number of threads that use the queue, their ids must be in $[0, threadCount)$.
+*/
+
+template <typename TValue, typename TSpec = void>
+class WorkStealingQueue
+{
+public:
+    String<WorkStealingDeque_<TValue> > deques;
+    size_t volatile jobCount;
+
+    explicit WorkStealingQueue(unsigned threadCount = omp_get_max_threads()) :
+        jobCount(0)
+    {
+        resize(deques, (threadCount == 0u)? 1u: threadCount, Exact());
+        for (unsigned i = 0; i < length(deques); ++i)
+            deques[i].rng = 73 * i + 1;
+    }
+
+private:
+    WorkStealingQueue(WorkStealingQueue const &);
+    WorkStealingQueue & operator=(WorkStealingQueue const &);
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function length()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingQueue#length
+ * @brief Returns the number of jobs in all deques.
+ *
+ * @signature TSize length(queue);
+ *
+ * @param queue The WorkStealingQueue.
+ *
+ * The result is only a snapshot if other threads concurrently push or pop jobs.
+ */
+
+/**
+.Function.WorkStealingQueue#length
+..class:Class.WorkStealingQueue
+..summary:Returns the number of jobs in all deques.
+..cat:Parallelism
+..signature:length(queue)
+..param.queue:The queue.
+...type:Class.WorkStealingQueue
+..remarks:The result is only a snapshot if other threads concurrently push or pop jobs.
+..include:seqan/parallel.h
+*/
+
+template <typename TValue, typename TSpec>
+inline size_t
+length(WorkStealingQueue<TValue, TSpec> const & queue)
+{
+    return queue.jobCount;
+}
+
+// ----------------------------------------------------------------------------
+// Function empty()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingQueue#empty
+ * @brief Returns whether all deques are empty.
+ *
+ * @signature bool empty(queue);
+ *
+ * @param queue The WorkStealingQueue.
+ */
+
+/**
+.Function.WorkStealingQueue#empty
+..class:Class.WorkStealingQueue
+..summary:Returns whether all deques are empty.
+..cat:Parallelism
+..signature:empty(queue)
+..param.queue:The queue.
+...type:Class.WorkStealingQueue
+..include:seqan/parallel.h
+*/
+
+template <typename TValue, typename TSpec>
+inline bool
+empty(WorkStealingQueue<TValue, TSpec> const & queue)
+{
+    return queue.jobCount == 0u;
+}
+
+// ----------------------------------------------------------------------------
+// Function pushFront()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingQueue#pushFront
+ * @brief Push one or more jobs to the front of the deque of a thread.
+ *
+ * @signature void pushFront(queue, job, threadId);
+ * @signature void pushFront(queue, jobs, threadId);
+ *
+ * @param queue    The WorkStealingQueue.
+ * @param job      The job to push.
+ * @param jobs     A @link String @endlink of jobs to push.  The last job will be the first one to be popped.
+ * @param threadId The id of the calling thread.
+ */
+
+/**
+.Function.WorkStealingQueue#pushFront
+..class:Class.WorkStealingQueue
+..summary:Push one or more jobs to the front of the deque of a thread.
+..cat:Parallelism
+..signature:pushFront(queue, job, threadId)
+..signature:pushFront(queue, jobs, threadId)
+..param.queue:The queue.
+...type:Class.WorkStealingQueue
+..param.job:The job to push.
+..param.jobs:A @Class.String@ of jobs to push. The last job will be the first one to be popped.
+..param.threadId:The id of the calling thread.
+..include:seqan/parallel.h
+*/
+
+template <typename TValue, typename TSpec>
+inline void
+pushFront(WorkStealingQueue<TValue, TSpec> & queue, TValue const & job, unsigned threadId)
+{
+    WorkStealingDeque_<TValue> & deque = queue.deques[threadId];
+    {
+        ScopedSpinLock guard(deque.lock);
+        deque.jobs.push_front(job);
+        deque.size = deque.jobs.size();
+    }
+    atomicInc(queue.jobCount);
+}
+
+template <typename TValue, typename TSpec, typename TStringSpec>
+inline void
+pushFront(WorkStealingQueue<TValue, TSpec> & queue, String<TValue, TStringSpec> const & jobs, unsigned threadId)
+{
+    typedef typename Iterator<String<TValue, TStringSpec> const, Standard>::Type TIterator;
+
+    WorkStealingDeque_<TValue> & deque = queue.deques[threadId];
+    {
+        ScopedSpinLock guard(deque.lock);
+        for (TIterator it = begin(jobs, Standard()); it != end(jobs, Standard()); ++it)
+            deque.jobs.push_front(*it);
+        deque.size = deque.jobs.size();
+    }
+    atomicAdd(queue.jobCount, (size_t)length(jobs));
+}
+
+// ----------------------------------------------------------------------------
+// Function pushBack()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingQueue#pushBack
+ * @brief Push a job to the back of the deque of a thread.
+ *
+ * @signature void pushBack(queue, job, threadId);
+ *
+ * @param queue    The WorkStealingQueue.
+ * @param job      The job to push.  It is the next job to be stolen from this thread.
+ * @param threadId The id of the calling thread.
+ */
+
+/**
+.Function.WorkStealingQueue#pushBack
+..class:Class.WorkStealingQueue
+..summary:Push a job to the back of the deque of a thread.
+..cat:Parallelism
+..signature:pushBack(queue, job, threadId)
+..param.queue:The queue.
+...type:Class.WorkStealingQueue
+..param.job:The job to push. It is the next job to be stolen from this thread.
+..param.threadId:The id of the calling thread.
+..include:seqan/parallel.h
+*/
+
+template <typename TValue, typename TSpec>
+inline void
+pushBack(WorkStealingQueue<TValue, TSpec> & queue, TValue const & job, unsigned threadId)
+{
+    WorkStealingDeque_<TValue> & deque = queue.deques[threadId];
+    {
+        ScopedSpinLock guard(deque.lock);
+        deque.jobs.push_back(job);
+        deque.size = deque.jobs.size();
+    }
+    atomicInc(queue.jobCount);
+}
+
+// ----------------------------------------------------------------------------
+// Function stealWork()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingQueue#stealWork
+ * @brief Steal the oldest job of another thread.
+ *
+ * @signature bool stealWork(job, queue, threadId);
+ *
+ * @param job      The stolen job.
+ * @param queue    The WorkStealingQueue.
+ * @param threadId The id of the calling thread.
+ *
+ * @return bool <tt>true</tt> if a job could be stolen and <tt>false</tt> if the deques of all other threads were
+ *              empty.
+ *
+ * The victims are visited in a pseudo-random order to spread the stealing threads over the deques.
+ */
+
+/**
+.Function.WorkStealingQueue#stealWork
+..class:Class.WorkStealingQueue
+..summary:Steal the oldest job of another thread.
+..cat:Parallelism
+..signature:stealWork(job, queue, threadId)
+..param.job:The stolen job.
+..param.queue:The queue.
+...type:Class.WorkStealingQueue
+..param.threadId:The id of the calling thread.
+..returns:$true$ if a job could be stolen and $false$ if the deques of all other threads were empty.
+..remarks:The victims are visited in a pseudo-random order to spread the stealing threads over the deques.
+..include:seqan/parallel.h
+*/
+
+template <typename TValue, typename TSpec>
+inline bool
+stealWork(TValue & job, WorkStealingQueue<TValue, TSpec> & queue, unsigned threadId)
+{
+    unsigned threadCount = length(queue.deques);
+    if (threadCount < 2u || queue.jobCount == 0u)
+        return false;
+
+    // start at a pseudo-random victim and visit all other threads
+    WorkStealingDeque_<TValue> & self = queue.deques[threadId];
+    self.rng = 1664525u * self.rng + 1013904223u;
+    unsigned start = self.rng >> 8;
+
+    for (unsigned i = 0; i < threadCount; ++i)
+    {
+        unsigned victim = (start + i) % threadCount;
+        if (victim == threadId)
+            continue;
+
+        WorkStealingDeque_<TValue> & deque = queue.deques[victim];
+        if (deque.size == 0u)           // unlocked peek, re-checked below
+            continue;
+
+        ScopedSpinLock guard(deque.lock);
+        if (!deque.jobs.empty())
+        {
+            job = deque.jobs.back();
+            deque.jobs.pop_back();
+            deque.size = deque.jobs.size();
+            atomicDec(queue.jobCount);
+            return true;
+        }
+    }
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+// Function popFront()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingQueue#popFront
+ * @brief Pop a job from the front of the deque of a thread or steal one from another thread.
+ *
+ * @signature bool popFront(job, queue, threadId);
+ *
+ * @param job      The popped job.
+ * @param queue    The WorkStealingQueue.
+ * @param threadId The id of the calling thread.
+ *
+ * @return bool <tt>true</tt> if a job could be popped or stolen and <tt>false</tt> if all deques were empty.
+ */
+
+/**
+.Function.WorkStealingQueue#popFront
+..class:Class.WorkStealingQueue
+..summary:Pop a job from the front of the deque of a thread or steal one from another thread.
+..cat:Parallelism
+..signature:popFront(job, queue, threadId)
+..param.job:The popped job.
+..param.queue:The queue.
+...type:Class.WorkStealingQueue
+..param.threadId:The id of the calling thread.
+..returns:$true$ if a job could be popped or stolen and $false$ if all deques were empty.
+..include:seqan/parallel.h
+*/
+
+template <typename TValue, typename TSpec>
+inline bool
+popFront(TValue & job, WorkStealingQueue<TValue, TSpec> & queue, unsigned threadId)
+{
+    WorkStealingDeque_<TValue> & deque = queue.deques[threadId];
+    if (deque.size != 0u)
+    {
+        ScopedSpinLock guard(deque.lock);
+        if (!deque.jobs.empty())
+        {
+            job = deque.jobs.front();
+            deque.jobs.pop_front();
+            deque.size = deque.jobs.size();
+            atomicDec(queue.jobCount);
+            return true;
+        }
+    }
+    return stealWork(job, queue, threadId);
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_PARALLEL_PARALLEL_WORK_STEALING_H_
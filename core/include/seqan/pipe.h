@@ -76,5 +76,6 @@
 #include <seqan/misc/priority_type_base.h>
 #include <seqan/misc/priority_type_heap.h>
 #include <seqan/pipe/pool_sorter.h>
+#include <seqan/pipe/pool_sorter_parallel.h>
 
 #endif //#ifndef SEQAN_HEADER_...
@@ -0,0 +1,613 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Multi-threaded variant of the pool sorter.  Pages are sorted in parallel
+// during run generation and the runs are merged block-wise with loser trees
+// on disjoint partitions of the key space.
+// ==========================================================================
+
+#ifndef SEQAN_HEADER_POOL_SORTER_PARALLEL_H
+#define SEQAN_HEADER_POOL_SORTER_PARALLEL_H
+
+namespace SEQAN_NAMESPACE_MAIN
+{
+
+/*!
+ * @class ParallelSorterSpec
+ * @extends Pool
+ * @headerfile <seqan/pipe.h>
+ * @brief Sorts all elements using a custom compare function and multiple threads.
+ *
+ * @signature template <typename TValue, typename TConfig>
+ *            struct Pool<TValue, ParallelSorterSpec<TConfig> >;
+ *
+ * @tparam TConfig Configuration Spec.  Defines compare function, size type, and file type.
+ *                 Types: @link SorterConfig @endlink, @link SorterConfigSize @endlink
+ * @tparam TValue  The value type, that is the type of the stream elements.
+ *
+ * @section Remarks
+ *
+ * This is a drop-in replacement for @link SorterSpec @endlink that uses up to <tt>omp_get_max_threads()</tt>
+ * threads.  Every page is sorted in parallel before it is written to disk (while the previous page is still being
+ * written).  The sorted pages are merged block by block: each block is split into disjoint key ranges which are
+ * merged concurrently by loser trees.  The bucket of every page is double buffered, i.e. the next part of a page is
+ * read asynchronously while the current part is merged.
+ *
+ * Elements that compare equal may be output in a different order than by @link SorterSpec @endlink.
+ * Without OpenMP this sorter runs single-threaded.
+ */
+
+/**
+.Spec.ParallelSorterSpec:
+..cat:Pipelining
+..general:Class.Pool
+..summary:Sorts all elements using a custom compare function and multiple threads.
+..signature:Pool<TValue, ParallelSorterSpec<TConfig> >
+..param.TValue:The value type, that is the type of the stream elements.
+..param.TConfig:Configuration Spec. Defines compare function, size type, and file type.
+...type:Spec.SorterConfig
+...type:Spec.SorterConfigSize
+..remarks:This is a drop-in replacement for @Spec.SorterSpec@ that uses up to $omp_get_max_threads()$ threads.
+Pages are sorted in parallel during run generation and merged block-wise by loser trees on disjoint key ranges.
+The bucket of every page is double buffered to overlap reading with merging.
+...note:Elements that compare equal may be output in a different order than by @Spec.SorterSpec@.
+..include:seqan/pipe.h
+*/
+
+    template < typename TConfig >
+    struct ParallelSorterSpec {
+        typedef TConfig Config;
+    };
+
+    template < typename TValue,
+			   typename TConfig >
+    struct HandlerArgs< Pool< TValue, ParallelSorterSpec<TConfig> > >
+    {
+        typedef typename TConfig::Compare Type;
+    };
+
+
+    //////////////////////////////////////////////////////////////////////////////
+	// loser tree for k-way merging of sorted sequences
+    template < typename TValue, typename TLess >
+    struct MergeLoserTree
+    {
+        String<TValue *>    cur, end;   // remaining parts of the sequences
+        String<unsigned>    tree;       // tree[0] is the winner, inner nodes hold the losers
+        unsigned            leaves;
+        TLess               less;
+
+        MergeLoserTree(TLess const &_less):
+            leaves(0),
+            less(_less) {}
+
+        template < typename TSegments >
+        void init(TSegments const &segments)
+        {
+            unsigned k = length(segments);
+            for (leaves = 1; leaves < k; leaves <<= 1) ;
+            resize(cur, leaves, Exact());
+            resize(end, leaves, Exact());
+            resize(tree, leaves, Exact());
+            for (unsigned i = 0; i < leaves; ++i)
+                if (i < k) {
+                    cur[i] = segments[i].i1;
+                    end[i] = segments[i].i2;
+                } else
+                    cur[i] = end[i] = NULL;
+            tree[0] = _play(1);
+        }
+
+        inline bool empty() const
+        {
+            return cur[tree[0]] == end[tree[0]];
+        }
+
+        inline TValue & top()
+        {
+            return *cur[tree[0]];
+        }
+
+        inline void pop()
+        {
+            unsigned winner = tree[0];
+            ++cur[winner];
+            // replay the matches on the path from the winner's leaf to the root
+            for (unsigned node = (winner + leaves) >> 1; node > 0; node >>= 1)
+                if (_beats(tree[node], winner))
+                    ::std::swap(tree[node], winner);
+            tree[0] = winner;
+        }
+
+    private:
+
+        // a beats b if its current element must be merged first (ties are broken by sequence number)
+        inline bool _beats(unsigned a, unsigned b) const
+        {
+            if (cur[a] == end[a]) return false;
+            if (cur[b] == end[b]) return true;
+            if (less(*cur[a], *cur[b])) return true;
+            if (less(*cur[b], *cur[a])) return false;
+            return a < b;
+        }
+
+        unsigned _play(unsigned node)
+        {
+            if (node >= leaves) return node - leaves;
+            unsigned left = _play(2 * node);
+            unsigned right = _play(2 * node + 1);
+            if (_beats(right, left)) {
+                tree[node] = left;
+                return right;
+            }
+            tree[node] = right;
+            return left;
+        }
+    };
+
+    // minimal number of elements a thread should merge or sort
+    enum { PARALLEL_SORTER_MIN_PART = 4096 };
+
+    template < typename TValue, typename TLess >
+    inline void _mergeLoserTree(String< Pair<TValue *, TValue *> > const &segments, TValue *out, TLess const &less)
+    {
+        if (length(segments) == 1) {
+            ::std::copy(segments[0].i1, segments[0].i2, out);
+            return;
+        }
+        MergeLoserTree<TValue, TLess> lt(less);
+        lt.init(segments);
+        for (; !lt.empty(); lt.pop(), ++out)
+            *out = lt.top();
+    }
+
+    // Merges sorted segments into out.  The key space is partitioned by splitters
+    // sampled from all segments and every partition is merged by its own thread.
+    template < typename TValue, typename TLess >
+    inline void _mergeParallel(String< Pair<TValue *, TValue *> > const &segments, TValue *out, TLess const &less)
+    {
+        typedef Pair<TValue *, TValue *> TSegment;
+
+        unsigned k = length(segments);
+        size_t total = 0;
+        for (unsigned r = 0; r < k; ++r)
+            total += segments[r].i2 - segments[r].i1;
+
+        unsigned parts = _min((size_t)omp_get_max_threads(), total / PARALLEL_SORTER_MIN_PART);
+        if (parts <= 1 || k <= 1) {
+            if (k != 0) _mergeLoserTree(segments, out, less);
+            return;
+        }
+
+        // 1. sample each segment proportionally to its length and choose parts-1 splitters
+        String<TValue> samples;
+        size_t oversampling = 8 * parts;
+        for (unsigned r = 0; r < k; ++r) {
+            size_t len = segments[r].i2 - segments[r].i1;
+            size_t count = (len * oversampling + total - 1) / total;
+            for (size_t j = 0; j < count; ++j)
+                appendValue(samples, segments[r].i1[(len * (2 * j + 1)) / (2 * count)]);
+        }
+        ::std::sort(begin(samples, Standard()), end(samples, Standard()), less);
+
+        // 2. cut every segment at the splitters
+        String<TValue *> bounds;
+        resize(bounds, k * (parts + 1), Exact());
+        for (unsigned r = 0; r < k; ++r) {
+            TValue **b = begin(bounds, Standard()) + r * (parts + 1);
+            b[0] = segments[r].i1;
+            for (unsigned j = 1; j < parts; ++j)
+                b[j] = ::std::upper_bound(b[j - 1], segments[r].i2, samples[(length(samples) * j) / parts], less);
+            b[parts] = segments[r].i2;
+        }
+
+        String<size_t> offsets;
+        resize(offsets, parts + 1, 0, Exact());
+        for (unsigned j = 0; j < parts; ++j) {
+            offsets[j + 1] = offsets[j];
+            for (unsigned r = 0; r < k; ++r)
+                offsets[j + 1] += bounds[r * (parts + 1) + j + 1] - bounds[r * (parts + 1) + j];
+        }
+
+        // 3. merge the partitions concurrently
+        SEQAN_OMP_PRAGMA(parallel for num_threads((int)parts) schedule(dynamic))
+        for (int j = 0; j < (int)parts; ++j) {
+            String<TSegment> part;
+            for (unsigned r = 0; r < k; ++r) {
+                TValue *partBegin = bounds[r * (parts + 1) + j];
+                TValue *partEnd = bounds[r * (parts + 1) + j + 1];
+                if (partBegin != partEnd)
+                    appendValue(part, TSegment(partBegin, partEnd));
+            }
+            if (!empty(part))
+                _mergeLoserTree(part, out + offsets[j], less);
+        }
+    }
+
+    // Sorts chunks of [first,last) in parallel and merges them with _mergeParallel.
+    template < typename TValue, typename TLess >
+    inline void _sortParallel(TValue *first, TValue *last, TLess const &less)
+    {
+        typedef Pair<TValue *, TValue *> TSegment;
+
+        size_t len = last - first;
+        unsigned chunks = _min((size_t)omp_get_max_threads(), len / PARALLEL_SORTER_MIN_PART);
+        if (chunks <= 1) {
+            ::std::sort(first, last, less);
+            return;
+        }
+
+        Splitter<size_t> splitter(0, len, chunks);
+        SEQAN_OMP_PRAGMA(parallel for num_threads((int)chunks))
+        for (int i = 0; i < (int)chunks; ++i)
+            ::std::sort(first + splitter[i], first + splitter[i + 1], less);
+
+        String<TSegment> segments;
+        for (unsigned i = 0; i < chunks; ++i)
+            appendValue(segments, TSegment(first + splitter[i], first + splitter[i + 1]));
+
+        Buffer<TValue> tmp;
+        allocPage(tmp, len, tmp);
+        _mergeParallel(segments, tmp.begin, less);
+        ::std::copy(tmp.begin, tmp.end, first);
+        freePage(tmp, tmp);
+    }
+
+
+    //////////////////////////////////////////////////////////////////////////////
+	// a sorted page on disk with a double buffered bucket
+    template < typename TValue, typename TFile >
+    struct ParallelSorterRun_
+    {
+        typedef typename AsyncRequest<TFile>::Type TRequest;
+
+        TValue      *cur, *end;         // unmerged part of the active buffer
+        TValue      *buffer[2];         // the inactive buffer is being prefetched
+        size_t      capacity[2];
+        unsigned    active;
+        int         pageNo;
+        size_t      pageOfs;            // page offset of the next read
+        size_t      pendingSize;        // size of the prefetch in flight, 0 if none
+        TRequest    request;
+    };
+
+
+    //////////////////////////////////////////////////////////////////////////////
+	// block based parallel multiway merge
+    struct ReadParallelSorterSpec_;
+	typedef Tag<ReadParallelSorterSpec_> ReadParallelSorterSpec;
+
+    template <typename TValue, typename TPoolSpec>
+    struct Handler<Pool<TValue, TPoolSpec>, ReadParallelSorterSpec>
+    {
+        typedef Pool<TValue, TPoolSpec>                 TPool;
+        typedef typename TPool::File                    TFile;
+        typedef typename TPool::TBuffer					TBuffer;
+        typedef typename TPoolSpec::Config::Compare     TCompare;
+        typedef AdaptorCompare2Less<TCompare>           TLess;
+        typedef PageBucketExtended<TValue>              TPageBucket;
+        typedef ParallelSorterRun_<TValue, TFile>       TRun;
+        typedef Pair<TValue *, TValue *>                TSegment;
+
+		TPool           &pool;
+        TLess           less;
+        TBuffer         bucketBuffer;
+        TBuffer         mergeBuffer;    // the current merged block
+        String<TRun>    runs;
+        TValue          *mergeCur;
+
+        Handler(TPool &_pool):
+            pool(_pool),
+            less(_pool.handlerArgs),
+            mergeCur(NULL) { }
+
+        ~Handler() {
+            cancel();
+        }
+
+		struct insertRun : public ::std::unary_function<TPageBucket,void>
+        {
+			Handler &me;
+			insertRun(Handler &_me): me(_me) {}
+
+			inline void operator() (TPageBucket &pb) const
+            {
+                // split the bucket into two buffers (if possible)
+                TRun run;
+                size_t bucketSize = pb.end - pb.begin;
+                run.buffer[0] = pb.begin;
+                run.capacity[0] = bucketSize - bucketSize / 2;
+                run.buffer[1] = pb.begin + run.capacity[0];
+                run.capacity[1] = bucketSize / 2;
+                if (bucketSize < 2) {
+                    run.buffer[1] = run.buffer[0];
+                    run.capacity[1] = run.capacity[0];
+                }
+                run.cur = run.end = run.buffer[0];
+                run.active = 1;
+                run.pageNo = length(me.runs);
+                run.pageOfs = 0;
+                run.pendingSize = 0;
+                appendValue(me.runs, run);
+			}
+		};
+
+        bool begin()
+        {
+            // 1. distribute the bucket buffer over the pages, two buffers per page
+            if (!equiDistantDistribution(
+                bucketBuffer, _max(pool.bucketBufferSize, 2 * pool.pages()), *this,
+                pool._size, pool.pageSize,
+                insertRun(*this)))
+                return false;
+
+            // 2. runs mustn't be moved in memory from now on (pending requests)
+            size_t mergeSize = 0;
+            for (unsigned i = 0; i < length(runs); ++i) {
+                TRun &run = runs[i];
+                mergeSize += _max(run.capacity[0], run.capacity[1]);
+                _prefetch(run);
+            }
+            allocPage(mergeBuffer, mergeSize, *this);
+            _merge();
+            return true;
+        }
+
+        inline TValue const & front() const
+        {
+			return *mergeCur;
+        }
+
+        inline void pop(TValue &Ref_)
+		{
+            Ref_ = *mergeCur;
+            if (++mergeCur == mergeBuffer.end)
+                _merge();
+        }
+
+        inline void pop()
+        {
+            if (++mergeCur == mergeBuffer.end)
+                _merge();
+        }
+
+		inline bool eof() const
+        {
+			return mergeCur == mergeBuffer.end;
+		}
+
+        inline void end()
+        {
+            cancel();
+        }
+
+        void cancel()
+        {
+            for (unsigned i = 0; i < length(runs); ++i)
+                if (runs[i].pendingSize != 0)
+                    waitFor(runs[i].request);
+            clear(runs);
+            freePage(mergeBuffer, *this);
+            freePage(bucketBuffer, *this);
+            mergeCur = NULL;
+        }
+
+        inline void process() {}
+
+        // merge the next block of elements into mergeBuffer
+        void _merge()
+        {
+            // 1. refill drained buckets
+            for (unsigned i = 0; i < length(runs); ++i)
+                if (runs[i].cur == runs[i].end)
+                    _fetch(runs[i]);
+
+            // 2. only elements not greater than the smallest last element of a
+            //    partially read page can be merged without knowing the rest
+            TValue const *bound = NULL;
+            for (unsigned i = 0; i < length(runs); ++i) {
+                TRun const &run = runs[i];
+                if (run.cur != run.end && _hasMore(run) && (bound == NULL || less(*(run.end - 1), *bound)))
+                    bound = run.end - 1;
+            }
+
+            String<TSegment> segments;
+            String<unsigned> segmentRuns;
+            size_t total = 0;
+            for (unsigned i = 0; i < length(runs); ++i) {
+                TRun const &run = runs[i];
+                if (run.cur == run.end) continue;
+                TValue *segEnd = (bound == NULL)? run.end: ::std::upper_bound(run.cur, run.end, *bound, less);
+                if (segEnd == run.cur) continue;
+                appendValue(segments, TSegment(run.cur, segEnd));
+                appendValue(segmentRuns, i);
+                total += segEnd - run.cur;
+            }
+
+            // 3. merge the segments and consume them
+            _mergeParallel(segments, mergeBuffer.begin, less);
+            mergeCur = mergeBuffer.begin;
+            mergeBuffer.end = mergeBuffer.begin + total;
+
+            for (unsigned s = 0; s < length(segments); ++s)
+                runs[segmentRuns[s]].cur = segments[s].i2;
+        }
+
+    private:
+
+        inline bool _hasMore(TRun const &run) const
+        {
+            return run.pendingSize != 0 || run.pageOfs < pool.dataSize(run.pageNo);
+        }
+
+        // issue an asynchronous read of the next part of the page into the inactive buffer
+        inline void _prefetch(TRun &run)
+        {
+            typedef typename Position<TFile>::Type TPos;
+            unsigned other = run.active ^ 1;
+            size_t readSize = _min(pool.dataSize(run.pageNo) - run.pageOfs, run.capacity[other]);
+            if (run.buffer[other] == run.buffer[run.active])
+                readSize = 0;
+            run.pendingSize = readSize;
+            if (readSize == 0) return;
+            if (!asyncReadAt(pool.file, run.buffer[other], readSize,
+                             (TPos)run.pageNo * (TPos)pool.pageSize + run.pageOfs, run.request))
+                SEQAN_FAIL("Asynchronous read of page %d failed: \"%s\"", run.pageNo, strerror(errno));
+            run.pageOfs += readSize;
+        }
+
+        // switch to the prefetched buffer and prefetch the next one
+        inline bool _fetch(TRun &run)
+        {
+            typedef typename Position<TFile>::Type TPos;
+            if (run.pendingSize == 0)
+            {
+                // bucket is too small for double buffering, read synchronously
+                size_t readSize = _min(pool.dataSize(run.pageNo) - run.pageOfs, run.capacity[run.active]);
+                if (readSize == 0) return false;
+                if (!readAt(pool.file, run.buffer[run.active], readSize,
+                            (TPos)run.pageNo * (TPos)pool.pageSize + run.pageOfs))
+                    SEQAN_FAIL("Read of page %d failed: \"%s\"", run.pageNo, strerror(errno));
+                run.pageOfs += readSize;
+                run.cur = run.buffer[run.active];
+                run.end = run.cur + readSize;
+                return true;
+            }
+            if (!waitFor(run.request))
+                SEQAN_FAIL("Read operation could not be completed: \"%s\"", strerror(errno));
+            run.active ^= 1;
+            run.cur = run.buffer[run.active];
+            run.end = run.cur + run.pendingSize;
+            _prefetch(run);
+            return true;
+        }
+    };
+
+
+    template <typename TValue, typename TPoolSpec>
+    struct BufferHandler< Pool<TValue, TPoolSpec>, ReadParallelSorterSpec >
+    {
+        typedef Pool<TValue, TPoolSpec>                                 TPool;
+        typedef Handler<Pool<TValue, TPoolSpec>, ReadParallelSorterSpec> TMerger;
+        typedef Buffer<TValue>                                          TBuffer;
+
+        TMerger     merger;
+        TBuffer     block;
+
+        BufferHandler(TPool &_pool):
+            merger(_pool) {}
+
+        BufferHandler(TPool &_pool, size_t):
+            merger(_pool) {}
+
+        inline TBuffer & first()
+        {
+            merger.begin();
+            return _block();
+        }
+
+		inline TBuffer & next()
+        {
+            merger._merge();
+            return _block();
+		}
+
+        inline void end()
+        {
+            merger.end();
+        }
+
+        inline void cancel()
+        {
+            merger.cancel();
+        }
+
+        inline void process() {}
+
+    private:
+
+        inline TBuffer & _block()
+        {
+            block.begin = merger.mergeCur;
+            block.end = merger.mergeBuffer.end;
+            return block;
+        }
+    };
+
+
+	//////////////////////////////////////////////////////////////////////////////
+	// run generation
+	template < typename TValue,
+			   typename TConfig >
+    inline Buffer<TValue, PageFrame<typename TConfig::File, Dynamic> > & processBuffer(
+        Buffer<TValue, PageFrame<typename TConfig::File, Dynamic> > &buf,
+        BufferHandler< Pool< TValue, ParallelSorterSpec<TConfig> >, WriteFileSpec > &me)
+    {
+        _sortParallel(buf.begin, buf.end, AdaptorCompare2Less<typename TConfig::Compare>(me.pool.handlerArgs));
+		return buf;
+    }
+
+    template < typename TValue,
+               typename TConfig >
+    inline Buffer<TValue> & processBuffer(
+        Buffer<TValue> &buf,
+        BufferHandler< Pool< TValue, ParallelSorterSpec<TConfig> >, MemorySpec > &me)
+    {
+        _sortParallel(buf.begin, buf.end, AdaptorCompare2Less<typename TConfig::Compare>(me.pool.handlerArgs));
+		return buf;
+    }
+
+
+	//////////////////////////////////////////////////////////////////////////////
+	// character and buffer based handler definitions
+    template < typename TValue,
+			   typename TConfig >
+    struct BufReadHandler< Pool< TValue, ParallelSorterSpec<TConfig> > >
+    {
+        typedef BufferHandler< Bundle2<
+			BufferHandler< Pool< TValue, ParallelSorterSpec<TConfig> >, MemorySpec >,
+			BufferHandler< Pool< TValue, ParallelSorterSpec<TConfig> >, ReadParallelSorterSpec >
+		>, MultiplexSpec > Type;
+    };
+
+    template < typename TValue,
+			   typename TConfig >
+    struct ReadHandler< Pool< TValue, ParallelSorterSpec<TConfig> > >
+    {
+        typedef Handler< Bundle2<
+			Handler< BufferHandler < Pool< TValue, ParallelSorterSpec<TConfig> >, MemorySpec >, AdapterSpec >,
+			Handler<				 Pool< TValue, ParallelSorterSpec<TConfig> >, ReadParallelSorterSpec >
+		>, MultiplexSpec > Type;
+    };
+
+}
+
+#endif
@@ -62,6 +62,7 @@
 // ===========================================================================
 
 #include <seqan/seq_io/sequence_stream_impl.h>
+#include <seqan/seq_io/sequence_stream_parallel.h>
 #include <seqan/seq_io/sequence_stream.h>
 
 // ===========================================================================
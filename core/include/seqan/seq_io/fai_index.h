@@ -153,6 +153,95 @@ public:
     {}
 };
 
+// ----------------------------------------------------------------------------
+// Class FaiRegionCache
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class FaiRegionCache
+ * @headerfile <seqan/seq_io.h>
+ * @brief LRU cache of decoded windows of an indexed FASTA file.
+ *
+ * @signature template <[typename TValue[, typename TSpec]]>
+ *            class FaiRegionCache;
+ *
+ * @tparam TValue The alphabet the windows are decoded to.  Default: <tt>Dna5</tt>.
+ * @tparam TSpec  Tag for specializing the cache.  Default: <tt>void</tt>.
+ *
+ * Regions are served from windows of the FASTA file that have already been decoded into strings over
+ * <tt>TValue</tt>.  On a miss, a window of at least <tt>windowSize</tt> characters around the region is decoded from
+ * the memory mapped FASTA file and the least recently used window is evicted if the cache is full.  Repeated queries
+ * to nearby regions thus neither touch the file nor decode characters again.
+ *
+ * The cache only stores a pointer to the FaiIndex, which must outlive the cache.  One FaiIndex can be shared by
+ * multiple threads, each using its own cache.
+ *
+ * @fn FaiRegionCache::FaiRegionCache
+ * @brief Constructor.
+ *
+ * @signature FaiRegionCache::FaiRegionCache(faiIndex[, windowSize[, capacity]]);
+ *
+ * @param[in] faiIndex   The FaiIndex to read from.
+ * @param[in] windowSize The minimal number of characters decoded on a miss.  Default: 65536.
+ * @param[in] capacity   The maximal number of cached windows.  Default: 16.
+ */
+
+/**
+.Class.FaiRegionCache
+..cat:Input/Output
+..signature:FaiRegionCache<TValue[, TSpec]>
+..summary:LRU cache of decoded windows of a @Class.FaiIndex@.
+..param.TValue:The alphabet the windows are decoded to.
+...default:@Spec.Dna5@
+..param.TSpec:Tag for specializing the cache.
+...default:$void$
+..remarks:On a miss, a window of at least $windowSize$ characters around the region is decoded from the memory mapped FASTA file and the least recently used window is evicted.
+Repeated queries to nearby regions thus neither touch the file nor decode characters again.
+..remarks:The @Class.FaiIndex@ must outlive the cache. It can be shared by multiple threads, each using its own cache.
+..include:seqan/seq_io.h
+
+.Memvar.FaiRegionCache#FaiRegionCache
+..class:Class.FaiRegionCache
+..signature:FaiRegionCache(faiIndex[, windowSize[, capacity]])
+..param.faiIndex:The @Class.FaiIndex@ to read from.
+...type:Class.FaiIndex
+..param.windowSize:The minimal number of characters decoded on a miss.
+...default:65536
+..param.capacity:The maximal number of cached windows.
+...default:16
+*/
+
+template <typename TValue = Dna5, typename TSpec = void>
+class FaiRegionCache
+{
+public:
+    typedef String<TValue> TWindow;
+
+    // Position of a cached window and the time of its last use.
+    struct Entry_
+    {
+        unsigned refId;
+        unsigned beginPos;
+        __uint64 lastUse;
+    };
+
+    FaiIndex const * faiIndex;
+    unsigned windowSize;
+    unsigned capacity;
+
+    // The decoded windows, entries[i] belongs to windows[i].
+    String<TWindow> windows;
+    String<Entry_> entries;
+    __uint64 clock;
+
+    FaiRegionCache(FaiIndex const & faiIndex, unsigned windowSize = 65536, unsigned capacity = 16) :
+        faiIndex(&faiIndex), windowSize(std::max(windowSize, 1u)), capacity(std::max(capacity, 1u)), clock(0)
+    {
+        reserve(windows, this->capacity, Exact());
+        reserve(entries, this->capacity, Exact());
+    }
+};
+
 // ============================================================================
 // Metafunctions
 // ============================================================================
@@ -409,33 +498,41 @@ inline int readRegion(String<TValue, TSpec> & str,
     endPos = std::min(std::max(beginPos, endPos), seqLen);
     unsigned toRead = endPos - beginPos;
 
+    if (toRead == 0)
+    {
+        clear(str);
+        return 0;
+    }
+
     typedef typename Iterator<String<char, MMap<> > const, Standard>::Type TSourceIter;
     typedef typename Iterator<String<TValue, TSpec>, Standard>::Type TTargetIter;
+    FaiIndexEntry_ const & entry = index.indexEntryStore[refId];
     TSourceIter itSource = begin(index.mmapString, Standard());
-    __uint64 offset = index.indexEntryStore[refId].offset;
+    __uint64 offset = entry.offset;
     // First, compute offset of the completely filled lines.
-    unsigned numLines = beginPos / index.indexEntryStore[refId].lineLength;
-    unsigned numBytes = numLines * index.indexEntryStore[refId].overallLineLength;
+    unsigned numLines = beginPos / entry.lineLength;
+    __uint64 numBytes = (__uint64)numLines * entry.overallLineLength;
     // Then, compute overall offset by adding remaining bytes, too.
-    numBytes += beginPos % index.indexEntryStore[refId].lineLength;
+    numBytes += beginPos % entry.lineLength;
     offset += numBytes;
     // Advance iterator in MMap file.
     itSource += offset;
 
-    // Copy out the characters from FASTA file and convert via iterator assignment to target string's type.
+    // Copy out the characters from FASTA file line by line, skipping the line breaks, and convert via assignment to
+    // target string's type.
     resize(str, toRead, TValue());
     TTargetIter itTarget = begin(str, Standard());
-    for (unsigned i = 0; i < toRead; )
+    unsigned lineBreakLength = entry.overallLineLength - entry.lineLength;
+    unsigned chunk = std::min(entry.lineLength - beginPos % entry.lineLength, toRead);
+    while (true)
     {
-        if (isspace(*itSource))
-        {
-            ++itSource;
-            continue;  // Skip spaces.
-        }
-        *itTarget = *itSource;
-        ++itTarget;
-        ++itSource;
-        ++i;
+        arrayCopyForward(itSource, itSource + chunk, itTarget);
+        toRead -= chunk;
+        if (toRead == 0)
+            break;
+        itTarget += chunk;
+        itSource += chunk + lineBreakLength;
+        chunk = std::min(entry.lineLength, toRead);
     }
 
     return 0;
@@ -505,6 +602,233 @@ inline int readSequence(String<TValue, TSpec> & str, FaiIndex const & index, uns
     return readRegion(str, index, refId, 0, sequenceLength(index, refId));
 }
 
+// ----------------------------------------------------------------------------
+// Function clear()                                            [FaiRegionCache]
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn FaiRegionCache#clear
+ * @brief Drop all cached windows of a FaiRegionCache.
+ *
+ * @signature void clear(cache);
+ *
+ * @param[in,out] cache The FaiRegionCache to clear.
+ */
+
+/**
+.Function.FaiRegionCache#clear
+..cat:Input/Output
+..class:Class.FaiRegionCache
+..signature:clear(cache)
+..param.cache:The @Class.FaiRegionCache@ to clear.
+...type:Class.FaiRegionCache
+..summary:Drop all cached windows of a @Class.FaiRegionCache@.
+..include:seqan/seq_io.h
+*/
+
+template <typename TValue, typename TSpec>
+inline void clear(FaiRegionCache<TValue, TSpec> & cache)
+{
+    clear(cache.windows);
+    clear(cache.entries);
+    cache.clock = 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function _findWindow()                                      [FaiRegionCache]
+// ----------------------------------------------------------------------------
+
+// Returns the slot of a cached window containing the given region, or length(cache.entries) if there is none.
+
+template <typename TValue, typename TSpec>
+inline unsigned _findWindow(FaiRegionCache<TValue, TSpec> const & cache,
+                            unsigned refId,
+                            unsigned beginPos,
+                            unsigned endPos)
+{
+    for (unsigned i = 0; i < length(cache.entries); ++i)
+        if (cache.entries[i].refId == refId && cache.entries[i].beginPos <= beginPos &&
+            endPos <= cache.entries[i].beginPos + length(cache.windows[i]))
+            return i;
+    return length(cache.entries);
+}
+
+// ----------------------------------------------------------------------------
+// Function _loadWindow()                                      [FaiRegionCache]
+// ----------------------------------------------------------------------------
+
+// Decodes the window around the given region into a free or the least recently used slot and returns the slot.
+
+template <typename TValue, typename TSpec>
+inline unsigned _loadWindow(FaiRegionCache<TValue, TSpec> & cache,
+                            unsigned refId,
+                            unsigned beginPos,
+                            unsigned endPos)
+{
+    typedef typename FaiRegionCache<TValue, TSpec>::Entry_ TEntry;
+
+    unsigned slot = length(cache.entries);
+    if (slot < cache.capacity)
+    {
+        resize(cache.windows, slot + 1);
+        resize(cache.entries, slot + 1);
+    }
+    else
+    {
+        slot = 0;
+        for (unsigned i = 1; i < length(cache.entries); ++i)
+            if (cache.entries[i].lastUse < cache.entries[slot].lastUse)
+                slot = i;
+    }
+
+    // Windows start at multiples of the window size such that queries to the same neighbourhood share them.
+    TEntry & entry = cache.entries[slot];
+    entry.refId = refId;
+    entry.beginPos = beginPos - beginPos % cache.windowSize;
+    unsigned windowEnd = std::max(entry.beginPos + cache.windowSize, endPos);
+    readRegion(cache.windows[slot], *cache.faiIndex, refId, entry.beginPos, windowEnd);
+
+    return slot;
+}
+
+// ----------------------------------------------------------------------------
+// Function regionInfix()                                      [FaiRegionCache]
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn FaiRegionCache#regionInfix
+ * @brief Return an infix of a cached window covering a region, without copying.
+ *
+ * @signature TInfix regionInfix(cache, refId, beginPos, endPos);
+ *
+ * @param[in,out] cache    The FaiRegionCache to query.
+ * @param[in]     refId    The id of the reference to read.  Type: unsigned.
+ * @param[in]     beginPos The begin position of the region to read.  Type: unsigned.
+ * @param[in]     endPos   The end position of the region to read.  Type: unsigned.
+ *
+ * @return TInfix An infix of the decoded window.  The infix is only valid until the next call on the cache, as this
+ *                call might evict the window.
+ */
+
+/**
+.Function.FaiRegionCache#regionInfix
+..cat:Input/Output
+..class:Class.FaiRegionCache
+..signature:regionInfix(cache, refId, beginPos, endPos)
+..summary:Return an infix of a cached window covering a region, without copying.
+..description:The region is limited to the sequence like in @Function.FaiIndex#readRegion@.
+If no cached window covers the region, the window is decoded first.
+..param.cache:The @Class.FaiRegionCache@ to query.
+...type:Class.FaiRegionCache
+..param.refId:The index of the reference in the file.
+...type:nolink:$unsigned$
+..param.beginPos:The begin position of the infix.
+...type:nolink:$unsigned$
+..param.endPos:The end position of the infix.
+...type:nolink:$unsigned$
+..returns:An infix of the decoded window.
+The infix is only valid until the next call on the cache, as this call might evict the window.
+..include:seqan/seq_io.h
+*/
+
+template <typename TValue, typename TSpec>
+inline typename Infix<typename FaiRegionCache<TValue, TSpec>::TWindow>::Type
+regionInfix(FaiRegionCache<TValue, TSpec> & cache,
+            unsigned refId,
+            unsigned beginPos,
+            unsigned endPos)
+{
+    // Limit region to the infix and make sure that beginPos <= endPos.
+    unsigned seqLen = sequenceLength(*cache.faiIndex, refId);
+    beginPos = std::min(beginPos, seqLen);
+    endPos = std::min(std::max(beginPos, endPos), seqLen);
+
+    unsigned slot = _findWindow(cache, refId, beginPos, endPos);
+    if (slot == length(cache.entries))
+        slot = _loadWindow(cache, refId, beginPos, endPos);
+    cache.entries[slot].lastUse = ++cache.clock;
+
+    unsigned windowBegin = cache.entries[slot].beginPos;
+    return infix(cache.windows[slot], beginPos - windowBegin, endPos - windowBegin);
+}
+
+// ----------------------------------------------------------------------------
+// Function readRegion()                                       [FaiRegionCache]
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn FaiRegionCache#readRegion
+ * @brief Load the infix of a sequence through a FaiRegionCache.
+ *
+ * @signature int readRegion(str, cache, refId, beginPos, endPos);
+ * @signature int readRegion(str, cache, region);
+ *
+ * @param[out]    str      The @link String @endlink to read the sequence into.
+ * @param[in,out] cache    The FaiRegionCache to read from.
+ * @param[in]     refId    The id of the reference to read.  Type: unsigned.
+ * @param[in]     beginPos The begin position of the region to read.  Type: unsigned.
+ * @param[in]     endPos   The end position of the region to read.  Type: unsigned.
+ * @param[in]     region   The @link GenomicRegion @endlink to read.
+ *
+ * @return int 0 on success, 1 on errors.
+ */
+
+/**
+.Function.FaiRegionCache#readRegion
+..cat:Input/Output
+..class:Class.FaiRegionCache
+..signature:readRegion(str, cache, refId, beginPos, endPos)
+..signature:readRegion(str, cache, region);
+..summary:Load the infix of a sequence through a @Class.FaiRegionCache@.
+..param.str:The sequence infix is written into this string.
+...type:Class.String
+..param.cache:The @Class.FaiRegionCache@ to read from.
+...type:Class.FaiRegionCache
+..param.refId:The index of the reference in the file.
+...type:nolink:$unsigned$
+..param.beginPos:The begin position of the infix to write to $str$.
+...type:nolink:$unsigned$
+..param.endPos:The end position of the infix to write to $str$.
+...type:nolink:$unsigned$
+..param.region:The @Class.GenomicRegion@ to read.
+...type:Class.GenomicRegion
+..return:Status code $int$, $0$ indicating success and $1$ an error.
+..include:seqan/seq_io.h
+*/
+
+template <typename TStrValue, typename TStrSpec, typename TValue, typename TSpec>
+inline int readRegion(String<TStrValue, TStrSpec> & str,
+                      FaiRegionCache<TValue, TSpec> & cache,
+                      unsigned refId,
+                      unsigned beginPos,
+                      unsigned endPos)
+{
+    assign(str, regionInfix(cache, refId, beginPos, endPos));
+    return 0;
+}
+
+template <typename TStrValue, typename TStrSpec, typename TValue, typename TSpec>
+inline int readRegion(String<TStrValue, TStrSpec> & str,
+                      FaiRegionCache<TValue, TSpec> & cache,
+                      GenomicRegion const & region)
+{
+    int seqId = region.seqId;
+    if (seqId == -1)
+    {
+        unsigned x = 0;
+        if (!getIdByName(*cache.faiIndex, region.seqName, x))
+            return 1;  // Sequence with this name could not be found.
+        seqId = x;
+    }
+    int beginPos = region.beginPos;
+    if (beginPos == -1)
+        beginPos = 0;
+    int endPos = region.endPos;
+    if (endPos == -1)
+        endPos = sequenceLength(*cache.faiIndex, seqId);
+    return readRegion(str, cache, seqId, beginPos, endPos);
+}
+
 // ----------------------------------------------------------------------------
 // Function read()
 // ----------------------------------------------------------------------------
@@ -323,12 +323,18 @@ public:
     SeqIOFileType_::Type _fileType;
     SeqIOFileFormat_::Type _fileFormat;
 
+    // Number of parsing threads and characters per chunk for parallel batch reading.
+    unsigned _numThreads;
+    size_t _chunkSize;
+    // Created by the first parallel readBatch()/readAll() call, reads from the record readers of _impl.
+    std::SEQAN_AUTO_PTR_NAME<SeqIOParallelReaderBase_> _parallelReader;
+
     // -----------------------------------------------------------------------
     // Constructor
     // -----------------------------------------------------------------------
 
     SequenceStream() : _atEnd(false), _isGood(false), _fileType(SeqIOFileType_::FILE_TYPE_TEXT),
-        _fileFormat(SeqIOFileFormat_::FILE_FORMAT_FASTA)
+        _fileFormat(SeqIOFileFormat_::FILE_FORMAT_FASTA), _numThreads(1), _chunkSize(1024 * 1024)
     {}
 
     SequenceStream(char const * filename,
@@ -336,7 +342,7 @@ public:
                    FileFormat format = AUTO_FORMAT,
                    FileType fileType = AUTO_TYPE) :
         filename(filename), operationMode(operationMode), _atEnd(false), _isGood(true), _fileType(SeqIOFileType_::FILE_TYPE_TEXT),
-        _fileFormat(SeqIOFileFormat_::FILE_FORMAT_FASTA)
+        _fileFormat(SeqIOFileFormat_::FILE_FORMAT_FASTA), _numThreads(1), _chunkSize(1024 * 1024)
     {
         _init(operationMode, format, fileType);
     }
@@ -379,6 +385,7 @@ public:
 
         bool isRead = (operationMode != WRITE);
         bool hintDoublePass = (operationMode == READ_PERSISTENT);
+        _parallelReader.reset();
         _impl.reset(new SequenceStreamImpl_(filename, _fileFormat, _fileType, isRead, hintDoublePass));
         // Copy out, possibly detected/adjusted file type and format.
         _fileType = _impl->_fileType;
@@ -478,6 +485,7 @@ inline void open(SequenceStream & seqIO,
 
 inline void close(SequenceStream & seqIO)
 {
+    seqIO._parallelReader.reset();
     seqIO._impl->close();
 }
 
@@ -581,6 +589,57 @@ inline bool isGood(SequenceStream const & seqIO)
     return seqIO._isGood;
 }
 
+// ----------------------------------------------------------------------------
+// Function setNumThreads()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn SequenceStream#setNumThreads
+ * @brief Set the number of threads used by readBatch and readAll.
+ *
+ * @signature int setNumThreads(seqStream, numThreads);
+ *
+ * @param[in,out] seqStream  The SequenceStream to configure.  Type: SequenceStream
+ * @param[in]     numThreads The number of parsing threads, 1 to read sequentially.
+ *
+ * @return int 0 on success, 1 if the SequenceStream is not opened for reading.
+ *
+ * @section Remarks
+ *
+ * With more than one thread, a background thread decompresses the file and cuts it into chunks of complete
+ * records that are parsed by numThreads threads, while the caller processes the previous batch.  Batches contain
+ * the records in file order.  Once a parallel batch has been read, the records must be read with the same
+ * @link SequenceStream#readBatch @endlink / @link SequenceStream#readAll @endlink variant and string types only, not
+ * with @link SequenceStream#readRecord @endlink.  Files opened with READ_PERSISTENT and standard input are read
+ * sequentially.
+ */
+
+/**
+.Function.SequenceStream#setNumThreads
+..class:Class.SequenceStream
+..summary:Set the number of threads used by @Function.SequenceStream#readBatch@ and @Function.SequenceStream#readAll@.
+..signature:int setNumThreads(seqIO, numThreads)
+..param.seqIO:The @Class.SequenceStream@ object to configure.
+...type:Class.SequenceStream
+..param.numThreads:The number of parsing threads, $1$ to read sequentially.
+...type:nolink:$unsigned$
+..returns:An integer, $0$ on success, $1$ if $seqIO$ is not opened for reading.
+...type:nolink:$int$
+..remarks:With more than one thread, a background thread decompresses the file and cuts it into chunks of complete records that are parsed by $numThreads$ threads, while the caller processes the previous batch.
+Batches contain the records in file order.
+Once a parallel batch has been read, the records must be read with the same @Function.SequenceStream#readBatch@ / @Function.SequenceStream#readAll@ variant and string types only, not with @Function.SequenceStream#readRecord@.
+Files opened with $READ_PERSISTENT$ and standard input are read sequentially.
+..include:seqan/seq_io.h
+*/
+
+inline int setNumThreads(SequenceStream & seqIO, unsigned numThreads)
+{
+    if (seqIO.operationMode == SequenceStream::WRITE || seqIO._parallelReader.get() != 0)
+        return 1;
+    seqIO._numThreads = numThreads;
+    return 0;
+}
+
 // ----------------------------------------------------------------------------
 // Function readRecord()
 // ----------------------------------------------------------------------------
@@ -705,6 +764,48 @@ int readRecord(TId & id, TSequence & seq, SequenceStream & seqIO)
     return res;
 }
 
+// ----------------------------------------------------------------------------
+// Function _readBatchParallel()
+// ----------------------------------------------------------------------------
+
+// Read a batch with the parallel reader of seqIO, returns false if the batch has to be read sequentially.
+
+template <typename TId, typename TSequence, typename TQualities, typename TIdSet, typename TSeqSet, typename TQualSet,
+          typename TFormatTag>
+inline bool
+_readBatchParallel(int & res,
+                   TIdSet & ids,
+                   TSeqSet & seqs,
+                   TQualSet & quals,
+                   SequenceStream & seqIO,
+                   size_t num,
+                   TFormatTag const & /*tag*/)
+{
+    typedef SeqIOParallelReader_<TId, TSequence, TQualities, TFormatTag> TReader;
+
+    if (seqIO._numThreads <= 1)
+        return false;
+
+    TReader * reader = dynamic_cast<TReader *>(seqIO._parallelReader.get());
+    if (reader == 0)
+    {
+        if (seqIO._parallelReader.get() != 0)
+        {
+            res = 1;  // The reader was created for other string types.
+            return true;
+        }
+        SeqIORawSource_ * source = _seqIORawSource(*seqIO._impl);
+        if (source == 0)
+            return false;
+        seqIO._parallelReader.reset(reader = new TReader(source, seqIO._numThreads, seqIO._chunkSize));
+    }
+
+    res = reader->readBatch(ids, seqs, quals, num);
+    seqIO._impl->_isGood = seqIO._impl->_isGood && (res == 0);
+    seqIO._impl->_atEnd = reader->atEnd();
+    return true;
+}
+
 // ----------------------------------------------------------------------------
 // Function readBatch()
 // ----------------------------------------------------------------------------
@@ -796,9 +897,15 @@ int readBatch(StringSet<TId, TIdSpec> & ids,
     int res = 0;
 
     if (seqIO._fileFormat == SeqIOFileFormat_::FILE_FORMAT_FASTA)
-        res = seqIO._impl->readBatch(ids, seqs, quals, num, Fasta());
+    {
+        if (!_readBatchParallel<TId, TSequence, TQualities>(res, ids, seqs, quals, seqIO, num, Fasta()))
+            res = seqIO._impl->readBatch(ids, seqs, quals, num, Fasta());
+    }
     else if (seqIO._fileFormat == SeqIOFileFormat_::FILE_FORMAT_FASTQ)
-        res = seqIO._impl->readBatch(ids, seqs, quals, num, Fastq());
+    {
+        if (!_readBatchParallel<TId, TSequence, TQualities>(res, ids, seqs, quals, seqIO, num, Fastq()))
+            res = seqIO._impl->readBatch(ids, seqs, quals, num, Fastq());
+    }
     else
         res = 1;
 
@@ -814,11 +921,18 @@ int readBatch(StringSet<TId, TIdSpec> & ids,
               unsigned num)
 {
     int res = 0;
+    Nothing nothing;
 
     if (seqIO._fileFormat == SeqIOFileFormat_::FILE_FORMAT_FASTA)
-        res = seqIO._impl->readBatch(ids, seqs, num, Fasta());
+    {
+        if (!_readBatchParallel<TId, TSequence, Nothing>(res, ids, seqs, nothing, seqIO, num, Fasta()))
+            res = seqIO._impl->readBatch(ids, seqs, num, Fasta());
+    }
     else if (seqIO._fileFormat == SeqIOFileFormat_::FILE_FORMAT_FASTQ)
-        res = seqIO._impl->readBatch(ids, seqs, num, Fastq());
+    {
+        if (!_readBatchParallel<TId, TSequence, Nothing>(res, ids, seqs, nothing, seqIO, num, Fastq()))
+            res = seqIO._impl->readBatch(ids, seqs, num, Fastq());
+    }
     else
         res = 1;
 
@@ -918,9 +1032,15 @@ int readAll(StringSet<TId, TIdSpec> & ids,
     int res = 0;
 
     if (seqIO._fileFormat == SeqIOFileFormat_::FILE_FORMAT_FASTA)
-        res = seqIO._impl->readAll(ids, seqs, quals, Fasta());
+    {
+        if (!_readBatchParallel<TId, TSequence, TQualities>(res, ids, seqs, quals, seqIO, MaxValue<size_t>::VALUE, Fasta()))
+            res = seqIO._impl->readAll(ids, seqs, quals, Fasta());
+    }
     else if (seqIO._fileFormat == SeqIOFileFormat_::FILE_FORMAT_FASTQ)
-        res = seqIO._impl->readAll(ids, seqs, quals, Fastq());
+    {
+        if (!_readBatchParallel<TId, TSequence, TQualities>(res, ids, seqs, quals, seqIO, MaxValue<size_t>::VALUE, Fastq()))
+            res = seqIO._impl->readAll(ids, seqs, quals, Fastq());
+    }
     else
         res = 1;
 
@@ -935,11 +1055,18 @@ int readAll(StringSet<TId, TIdSpec> & ids,
             SequenceStream & seqIO)
 {
     int res = 0;
+    Nothing nothing;
 
     if (seqIO._fileFormat == SeqIOFileFormat_::FILE_FORMAT_FASTA)
-        res = seqIO._impl->readAll(ids, seqs, Fasta());
+    {
+        if (!_readBatchParallel<TId, TSequence, Nothing>(res, ids, seqs, nothing, seqIO, MaxValue<size_t>::VALUE, Fasta()))
+            res = seqIO._impl->readAll(ids, seqs, Fasta());
+    }
     else if (seqIO._fileFormat == SeqIOFileFormat_::FILE_FORMAT_FASTQ)
-        res = seqIO._impl->readAll(ids, seqs, Fastq());
+    {
+        if (!_readBatchParallel<TId, TSequence, Nothing>(res, ids, seqs, nothing, seqIO, MaxValue<size_t>::VALUE, Fastq()))
+            res = seqIO._impl->readAll(ids, seqs, Fastq());
+    }
     else
         res = 1;
 
@@ -0,0 +1,574 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Parallel batch reading for SequenceStream.  One thread decompresses the
+// input and cuts it into chunks of complete records, the chunks are parsed
+// by multiple OpenMP threads and delivered in order through a bounded queue.
+// ==========================================================================
+
+#ifndef CORE_INCLUDE_SEQAN_SEQ_IO_SEQUENCE_STREAM_PARALLEL_H_
+#define CORE_INCLUDE_SEQAN_SEQ_IO_SEQUENCE_STREAM_PARALLEL_H_
+
+#include <memory>
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ---------------------------------------------------------------------------
+// Class SeqIORawSource_
+// ---------------------------------------------------------------------------
+
+// Type erasure for the single-pass record readers of SequenceStreamImpl_, gives access to the raw (decompressed)
+// characters of the file.
+
+class SeqIORawSource_
+{
+public:
+    virtual ~SeqIORawSource_()
+    {}
+
+    // Append up to count characters to target, returns the number of characters appended.
+    virtual size_t read(CharString & target, size_t count) = 0;
+
+    virtual bool atEnd() = 0;
+
+    // Status code of the underlying record reader, 0 if there was no error.
+    virtual int resultCode() = 0;
+};
+
+template <typename TRecordReader>
+class SeqIORawSourceImpl_ :
+    public SeqIORawSource_
+{
+public:
+    TRecordReader & _reader;
+
+    SeqIORawSourceImpl_(TRecordReader & reader) :
+        _reader(reader)
+    {}
+
+    virtual size_t read(CharString & target, size_t count)
+    {
+        size_t total = 0;
+        while (total < count && !seqan::atEnd(_reader))
+        {
+            // Copy what is buffered, atEnd() refills the buffer of stream-based readers.
+            size_t n = _min(count - total, (size_t)(_reader._end - _reader._current));
+            size_t oldLength = length(target);
+            resize(target, oldLength + n);
+            std::copy(_reader._current, _reader._current + n, begin(target, Standard()) + oldLength);
+            _reader._current += n;
+            total += n;
+        }
+        return total;
+    }
+
+    virtual bool atEnd()
+    {
+        return seqan::atEnd(_reader);
+    }
+
+    virtual int resultCode()
+    {
+        return seqan::resultCode(_reader);
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Class SeqIOParallelReaderBase_
+// ---------------------------------------------------------------------------
+
+// Base class of SeqIOParallelReader_ such that SequenceStream can hold readers for arbitrary string types.
+
+class SeqIOParallelReaderBase_
+{
+public:
+    virtual ~SeqIOParallelReaderBase_()
+    {}
+};
+
+// ---------------------------------------------------------------------------
+// Class SeqIOParsedChunk_
+// ---------------------------------------------------------------------------
+
+// The records of one chunk, qualities are omitted if TQualities is Nothing.
+
+template <typename TQualities>
+struct SeqIOChunkQuals_
+{
+    typedef StringSet<TQualities, Owner<ConcatDirect<> > > Type;
+};
+
+template <>
+struct SeqIOChunkQuals_<Nothing>
+{
+    typedef Nothing Type;
+};
+
+template <typename TId, typename TSequence, typename TQualities>
+struct SeqIOParsedChunk_
+{
+    StringSet<TId, Owner<ConcatDirect<> > >         ids;
+    StringSet<TSequence, Owner<ConcatDirect<> > >   seqs;
+    typename SeqIOChunkQuals_<TQualities>::Type     quals;
+
+    // Status code of readRecord(), the records before the failing one are kept.
+    int res;
+
+    SeqIOParsedChunk_() : res(0)
+    {}
+};
+
+// ---------------------------------------------------------------------------
+// Class SeqIOParallelReader_
+// ---------------------------------------------------------------------------
+
+// Runs the producer loop of a SeqIOParallelReader_ on the background thread.
+
+template <typename TReader>
+struct SeqIOParallelReaderWorker_
+{
+    TReader * _reader;
+
+    SeqIOParallelReaderWorker_(TReader & reader) : _reader(&reader)
+    {}
+
+    void run(Thread<SeqIOParallelReaderWorker_> *)
+    {
+        _reader->_run();
+    }
+};
+
+// Reads batches of records with a background thread.
+//
+// The background thread repeatedly cuts _numThreads chunks of about _chunkSize characters from the source, each
+// ending at a record boundary.  The chunks of one round are parsed in parallel while one of the threads already cuts
+// the chunks of the next round.  Parsed chunks are put into a queue of at most _maxQueued chunks, the background
+// thread blocks while the queue is full.  If the thread cannot be started, the rounds are processed on the caller's
+// thread.
+
+template <typename TId, typename TSequence, typename TQualities, typename TFormatTag>
+class SeqIOParallelReader_ :
+    public SeqIOParallelReaderBase_
+{
+public:
+    typedef SeqIOParsedChunk_<TId, TSequence, TQualities> TChunk;
+
+    std::SEQAN_AUTO_PTR_NAME<SeqIORawSource_> _source;
+
+    unsigned _numThreads;
+    size_t _chunkSize;
+    unsigned _maxQueued;
+
+    // Characters after the last record boundary of the previous chunk.
+    CharString _pending;
+    // Raw chunks of the current and the next round.
+    String<CharString> _raw, _rawNext;
+    unsigned _rawLength;
+
+    // Parsed chunks, closed by the background thread when the source is exhausted, and the chunk currently consumed
+    // by the caller.
+    ConcurrentQueue<TChunk *> _queue;
+    TChunk * _front;
+    size_t _frontPos;
+
+    // Status code of the source, set when the source is exhausted.
+    int _error;
+    bool _running;
+
+    Thread<SeqIOParallelReaderWorker_<SeqIOParallelReader_> > _thread;
+
+    SeqIOParallelReader_(SeqIORawSource_ * source, unsigned numThreads, size_t chunkSize) :
+        _source(source), _numThreads(_max(numThreads, 1u)), _chunkSize(_max(chunkSize, (size_t)1)),
+        _maxQueued(2 * _max(numThreads, 1u)), _rawLength(0), _queue(_maxQueued), _front(0), _frontPos(0), _error(0),
+        _running(false), _thread(*this)
+    {
+        _rawLength = _cutChunks(_raw);
+        _running = run(_thread);
+    }
+
+    ~SeqIOParallelReader_()
+    {
+        if (_running)
+        {
+            // Let the background thread stop at its next chunk.
+            close(_queue);
+            waitFor(_thread);
+        }
+        delete _front;
+        TChunk * chunk = 0;
+        while (popFront(chunk, _queue))
+        {
+            delete chunk;
+            chunk = 0;
+        }
+    }
+
+    // -----------------------------------------------------------------------
+    // Producer
+    // -----------------------------------------------------------------------
+
+    // Returns the length of the prefix of chunk that consists of complete records, 0 if there is none.  The first
+    // scanned characters of chunk are known to contain no record boundary.
+    size_t _completeRecords(CharString const & chunk, size_t scanned, Fasta const &)
+    {
+        // A record ends where the next one starts with '>' at the beginning of a line.
+        for (size_t pos = length(chunk); pos > 1 && pos > scanned; --pos)
+            if (chunk[pos - 1] == '>' && chunk[pos - 2] == '\n')
+                return pos - 1;
+        return 0;
+    }
+
+    size_t _completeRecords(CharString const & chunk, size_t /*scanned*/, Fastq const &)
+    {
+        // Follow the records as '@' can also start a line of qualities.  The qualities of a record end as soon as
+        // there are as many as sequence characters.
+        char const * data = begin(chunk, Standard());
+        size_t len = length(chunk);
+        size_t pos = 0, last = 0;
+
+        while (true)
+        {
+            while (pos < len && isspace(data[pos]))
+                ++pos;
+            if (pos == len)
+                return last;
+            if (data[pos] != '@')
+                return len;  // Invalid format, leave the error to readRecord().
+
+            char const * nl = static_cast<char const *>(memchr(data + pos, '\n', len - pos));
+            if (nl == 0)
+                return last;
+            pos = nl - data + 1;
+
+            size_t seqLength = 0;
+            while (pos < len && data[pos] != '+')
+            {
+                if ((nl = static_cast<char const *>(memchr(data + pos, '\n', len - pos))) == 0)
+                    return last;
+                for (; data + pos != nl; ++pos)
+                    seqLength += !isspace(data[pos]);
+                ++pos;
+            }
+            if (pos == len || (nl = static_cast<char const *>(memchr(data + pos, '\n', len - pos))) == 0)
+                return last;
+            pos = nl - data + 1;
+
+            size_t qualLength = 0;
+            while (qualLength < seqLength)
+            {
+                if ((nl = static_cast<char const *>(memchr(data + pos, '\n', len - pos))) == 0)
+                    return last;
+                for (; data + pos != nl; ++pos)
+                    qualLength += !isspace(data[pos]);
+                ++pos;
+            }
+            last = pos;
+        }
+    }
+
+    // Cut up to _numThreads chunks of complete records from the source, returns the number of non-empty chunks.
+    unsigned _cutChunks(String<CharString> & chunks)
+    {
+        resize(chunks, _numThreads);
+        unsigned n = 0;
+        for (; n < _numThreads; ++n)
+        {
+            CharString & chunk = chunks[n];
+            swap(chunk, _pending);
+            clear(_pending);
+
+            size_t cut = 0;
+            size_t scanned = 0;
+            while (true)
+            {
+                if (length(chunk) < _chunkSize)
+                    _source->read(chunk, _chunkSize - length(chunk));
+                if (_source->atEnd())
+                {
+                    cut = length(chunk);
+                    break;
+                }
+                if ((cut = _completeRecords(chunk, scanned, TFormatTag())) != 0)
+                    break;
+                // The chunk contains no record boundary yet.  Double it such that a record is scanned a constant
+                // number of times on average, independent of its length.
+                scanned = length(chunk);
+                _source->read(chunk, _max(scanned, _chunkSize));
+            }
+
+            if (cut < length(chunk))
+                _pending = suffix(chunk, cut);
+            resize(chunk, cut);
+            if (empty(chunk))
+                break;
+        }
+        if (n < _numThreads)
+            _error = _source->resultCode();
+        return n;
+    }
+
+    void _parseChunk(TChunk & target, CharString & chunk)
+    {
+        RecordReader<CharString, SinglePass<StringReader> > reader(chunk);
+        TId id;
+        TSequence seq;
+        TQualities qual;
+
+        while (!seqan::atEnd(reader))
+        {
+            if ((target.res = _seqIOReadRecord(id, seq, qual, reader, TFormatTag())) != 0)
+                break;
+            appendValue(target.ids, id);
+            appendValue(target.seqs, seq);
+            _seqIOAppendQual(target.quals, qual);
+        }
+    }
+
+    // Parse the current round and cut the next one, returns false if there was nothing left to parse.
+    bool _processRound(String<TChunk *> & parsed)
+    {
+        if (_rawLength == 0)
+            return false;
+
+        int n = _rawLength;
+        resize(parsed, n);
+        for (int i = 0; i < n; ++i)
+            parsed[i] = new TChunk();
+
+        unsigned nextLength = 0;
+        SEQAN_OMP_PRAGMA(parallel num_threads(_numThreads))
+        {
+            SEQAN_OMP_PRAGMA(single nowait)
+            nextLength = _cutChunks(_rawNext);
+
+            SEQAN_OMP_PRAGMA(for schedule(dynamic))
+            for (int i = 0; i < n; ++i)
+                _parseChunk(*parsed[i], _raw[i]);
+        }
+
+        swap(_raw, _rawNext);
+        _rawLength = nextLength;
+        return true;
+    }
+
+    void _run()
+    {
+        String<TChunk *> parsed;
+
+        while (_processRound(parsed))
+        {
+            unsigned i = 0;
+            for (; i < length(parsed); ++i)
+                if (!pushBack(_queue, parsed[i]))
+                    break;
+
+            if (i < length(parsed))
+            {
+                // The reader is destroyed.
+                for (; i < length(parsed); ++i)
+                    delete parsed[i];
+                return;
+            }
+        }
+        close(_queue);
+    }
+
+    // -----------------------------------------------------------------------
+    // Consumer
+    // -----------------------------------------------------------------------
+
+    // Wait for the next chunk and make it the front chunk, returns false if there are no more chunks.
+    bool _popFront()
+    {
+        delete _front;
+        _front = 0;
+        _frontPos = 0;
+
+        if (!_running && empty(_queue))
+        {
+            // Process the rounds on the caller's thread, the queue has room for a whole round.
+            String<TChunk *> parsed;
+            if (_processRound(parsed))
+                for (unsigned i = 0; i < length(parsed); ++i)
+                    pushBack(_queue, parsed[i]);
+            else
+                close(_queue);
+        }
+
+        popFront(_front, _queue);
+        return _front != 0;
+    }
+
+    // Returns true if there are no more records, waits for the next chunk if necessary.
+    bool atEnd()
+    {
+        while (_front == 0 || _frontPos == length(_front->ids))
+        {
+            if (_front != 0 && _front->res != 0)
+                return false;  // Let readBatch() report the error.
+            if (!_popFront())
+                return true;
+        }
+        return false;
+    }
+
+    template <typename TIdSet, typename TSeqSet, typename TQualSet>
+    int readBatch(TIdSet & ids, TSeqSet & seqs, TQualSet & quals, size_t num)
+    {
+        clear(ids);
+        clear(seqs);
+        _seqIOClearQuals(quals);
+
+        while (length(ids) < num && !atEnd())
+        {
+            size_t count = _min(num - length(ids), length(_front->ids) - _frontPos);
+            for (size_t i = _frontPos; i < _frontPos + count; ++i)
+            {
+                appendValue(ids, _front->ids[i]);
+                appendValue(seqs, _front->seqs[i]);
+                _seqIOAppendQual(quals, _front->quals, i);
+            }
+            _frontPos += count;
+
+            if (_frontPos == length(_front->ids) && _front->res != 0)
+                return _front->res;
+        }
+
+        if (atEnd() && _error != 0)
+            return _error;
+        return 0;
+    }
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Helper Functions for Records with and without Qualities
+// ----------------------------------------------------------------------------
+
+template <typename TId, typename TSequence, typename TQualities, typename TRecordReader, typename TFormatTag>
+inline int
+_seqIOReadRecord(TId & id, TSequence & seq, TQualities & qual, TRecordReader & reader, TFormatTag const & tag)
+{
+    return readRecord(id, seq, qual, reader, tag);
+}
+
+template <typename TId, typename TSequence, typename TRecordReader, typename TFormatTag>
+inline int
+_seqIOReadRecord(TId & id, TSequence & seq, Nothing & /*qual*/, TRecordReader & reader, TFormatTag const & tag)
+{
+    return readRecord(id, seq, reader, tag);
+}
+
+template <typename TQualSet, typename TQualities>
+inline void
+_seqIOAppendQual(TQualSet & quals, TQualities const & qual)
+{
+    appendValue(quals, qual);
+}
+
+inline void
+_seqIOAppendQual(Nothing & /*quals*/, Nothing const & /*qual*/)
+{}
+
+template <typename TQualSet, typename TSourceSet, typename TPos>
+inline void
+_seqIOAppendQual(TQualSet & quals, TSourceSet const & source, TPos pos)
+{
+    appendValue(quals, source[pos]);
+}
+
+template <typename TPos>
+inline void
+_seqIOAppendQual(Nothing & /*quals*/, Nothing const & /*source*/, TPos /*pos*/)
+{}
+
+template <typename TQualSet>
+inline void
+_seqIOClearQuals(TQualSet & quals)
+{
+    clear(quals);
+}
+
+inline void
+_seqIOClearQuals(Nothing & /*quals*/)
+{}
+
+// ----------------------------------------------------------------------------
+// Function _seqIORawSource()
+// ----------------------------------------------------------------------------
+
+// Returns a new raw source for the single-pass record reader of impl, 0 if there is none.
+
+inline SeqIORawSource_ *
+_seqIORawSource(SequenceStreamImpl_ & impl)
+{
+    switch (impl._fileType)
+    {
+    case SeqIOFileType_::FILE_TYPE_TEXT:
+        if (impl._hintDoublePass)
+            return 0;
+        return new SeqIORawSourceImpl_<RecordReader<String<char, MMap<> >, SinglePass<StringReader> > >(
+                *impl._mmapReaderSinglePass);
+
+#if SEQAN_HAS_ZLIB
+    case SeqIOFileType_::FILE_TYPE_GZ:
+    case SeqIOFileType_::FILE_TYPE_GZ_DIRECT:
+        return new SeqIORawSourceImpl_<RecordReader<Stream<GZFile>, SinglePass<> > >(*impl._gzReader);
+
+#endif  // #if SEQAN_HAS_ZLIB
+#if SEQAN_HAS_BZIP2
+    case SeqIOFileType_::FILE_TYPE_BZ2:
+        return new SeqIORawSourceImpl_<RecordReader<Stream<BZ2File>, SinglePass<> > >(*impl._bz2Reader);
+
+#endif  // #if SEQAN_HAS_BZIP2
+    default:
+        return 0;
+    }
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef CORE_INCLUDE_SEQAN_SEQ_IO_SEQUENCE_STREAM_PARALLEL_H_
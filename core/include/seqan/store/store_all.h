@@ -788,7 +788,7 @@ public:
 	TAnnotationTypeStore	annotationTypeStore;
 	TAnnotationKeyStore		annotationKeyStore;
 	
-	NameStoreCache<TReadNameStore, CharString>			readNameStoreCache;
+	NameStoreCache<TReadNameStore, CharString, NameStoreHash>	readNameStoreCache;
 	NameStoreCache<TContigNameStore, CharString>		contigNameStoreCache;
 	NameStoreCache<TAnnotationNameStore, CharString>	annotationNameStoreCache;
 	NameStoreCache<TAnnotationTypeStore, CharString>	annotationTypeStoreCache;
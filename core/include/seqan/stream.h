@@ -85,6 +85,7 @@
 #include <seqan/basic.h>
 #include <seqan/file.h>
 #include <seqan/sequence.h>
+#include <seqan/parallel.h>
 
 // ===========================================================================
 // Stream Concept, Adaptions, Stream Class and Specializations.
@@ -134,4 +135,12 @@
 #include <seqan/stream/tokenize.h>
 #include <seqan/stream/lexical_cast.h>
 
+// ===========================================================================
+// Tabix Index for BGZF Compressed Files
+// ===========================================================================
+
+#if SEQAN_HAS_ZLIB
+#include <seqan/stream/tabix_index.h>
+#endif  // #if SEQAN_HAS_ZLIB
+
 #endif  // SEQAN_STREAM_H_
@@ -339,6 +339,47 @@ For String RecordReader objects, this works nicely, when reading from streams, s
 ..include:seqan/stream.h
  */
 
+// ----------------------------------------------------------------------------
+// Helper Function _bufferBegin(), _bufferEnd()
+// ----------------------------------------------------------------------------
+
+// The unread characters of the current buffer.  The tokenizers scan them as a
+// whole instead of calling value() and goNext() for each character.
+
+template <typename TStream, typename TSpec>
+inline char const *
+_bufferBegin(RecordReader<TStream, TSpec> & recordReader)
+{
+    SEQAN_ASSERT(recordReader._current != recordReader._end);
+    return &*recordReader._current;
+}
+
+template <typename TStream, typename TSpec>
+inline char const *
+_bufferEnd(RecordReader<TStream, TSpec> & recordReader)
+{
+    return _bufferBegin(recordReader) + (recordReader._end - recordReader._current);
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _advanceBuffer()
+// ----------------------------------------------------------------------------
+
+// Equivalent to calling goNext() count times, count must not exceed the number of
+// unread characters in the current buffer.  Returns the result of the last goNext().
+
+template <typename TStream, typename TSpec, typename TSize>
+inline bool
+_advanceBuffer(RecordReader<TStream, TSpec> & recordReader, TSize count)
+{
+    SEQAN_ASSERT_GT(count, 0);
+    SEQAN_ASSERT_LEQ(count, recordReader._end - recordReader._current);
+
+    // Only the last step may reach the end of the buffer and trigger a refill.
+    recordReader._current += count - 1;
+    return goNext(recordReader);
+}
+
 }  // namespace seqan
 
 #endif  // #ifndef SEQAN_STREAM_RECORD_READER_BASE_H_
@@ -449,6 +449,22 @@ value(RecordReader<TFile, DoublePass<> > & recordReader)
     return *recordReader._current;
 }
 
+// ----------------------------------------------------------------------------
+// Helper Function _advanceBuffer()
+// ----------------------------------------------------------------------------
+
+template <typename TFile, typename TSize>
+inline bool
+_advanceBuffer(RecordReader<TFile, DoublePass<> > & recordReader, TSize count)
+{
+    SEQAN_ASSERT_GT(count, 0);
+    SEQAN_ASSERT_LEQ(count, recordReader._end - recordReader._current);
+
+    recordReader._current += count - 1;
+    recordReader._position += count - 1;
+    return goNext(recordReader);
+}
+
 }  // namespace seqan
 
 #endif  // #ifndef SEQAN_STREAM_RECORD_READER_DOUBLE_H_
@@ -93,6 +93,24 @@ struct BgzfCacheEntry_
     __int64 endOffset;
 };
 
+// One block of a read-ahead or write-behind batch, used when (de)compressing with multiple threads.
+
+struct BgzfBatchBlock_
+{
+    // Address of the (first) compressed block in the file and the address behind it.
+    __int64 blockAddress;
+    __int64 endOffset;
+
+    // Number of uncompressed bytes when reading, number of compressed bytes when writing, -1 on errors.
+    int size;
+
+    String<char> compressed;
+    String<char> uncompressed;
+
+    BgzfBatchBlock_() : blockAddress(-1), endOffset(-1), size(0)
+    {}
+};
+
 /*!
  * @class BgzfStream
  * @extends Stream
@@ -108,6 +126,9 @@ struct BgzfCacheEntry_
  * possible to jump to beginnings of blocks in the resulting files, decompress the block and then jump into the block
  * itself.
  *
+ * Using @link BgzfStream#setNumThreads @endlink, blocks can be decompressed ahead of the reader and compressed behind
+ * the writer by multiple OpenMP threads.
+ *
  * @section Examples
  *
  * @code{.cpp}
@@ -129,6 +150,7 @@ struct BgzfCacheEntry_
 BGZF is the Block GZip Format which is used as the underlying format for BAM and TABIX.
 Data is written out compressed with gzip but the uncompressed data is split into blocks with a maximum block size.
 It is therefore possible to jump to beginnings of blocks in the resulting files, decompress the block and then jump into the block itself.
+..remarks:Using @Function.setNumThreads@, blocks can be decompressed ahead of the reader and compressed behind the writer by multiple OpenMP threads.
 ..include:seqan/stream.h
 ..example.code:
 Stream<Bgzf> stream;
@@ -193,8 +215,24 @@ public:
     // Size of the file in bytes as it is on the disk.
     __int64 _fileSize;
 
+    // Number of threads to use for (de)compression, 1 disables read-ahead and write-behind.
+    unsigned _numThreads;
+
+    // Blocks read ahead or written behind, only the first _batchLength entries are valid.
+    String<BgzfBatchBlock_> _batch;
+    unsigned _batchLength;
+
+    // When writing, the first _batchCompressed entries of the batch are compressed already and take
+    // _batchCompressedSize bytes in the file.
+    unsigned _batchCompressed;
+    __int64 _batchCompressedSize;
+
+    // Index of the next read-ahead block that is expected to be requested by the reader.
+    unsigned _batchPos;
+
     Stream() : _error(0), _atEof(false), _openMode(0), _compressLevel(Z_DEFAULT_COMPRESSION), _blockPosition(0),
-               _blockLength(0), _blockOffset(0), _cacheSize(0), _maxCacheSize(0), _fileOwned(false), _fileSize(0)
+               _blockLength(0), _blockOffset(0), _cacheSize(0), _maxCacheSize(0), _fileOwned(false), _fileSize(0),
+               _numThreads(1), _batchLength(0), _batchCompressed(0), _batchCompressedSize(0), _batchPos(0)
     {}
 
     ~Stream()
@@ -399,15 +437,16 @@ _bgzfCheckHeader(char const * header)
 // Helper Function _bgzfLoadBlockFromCache()
 // ----------------------------------------------------------------------------
 
-// Returns number of bytes loaded from cache, 0 if address could not be found.
+// Returns true if the block was loaded from cache, false if address could not be found.  Empty blocks, e.g. the EOF
+// marker block, are cached as well.
 
-inline int
+inline bool
 _bgzfLoadBlockFromCache(Stream<Bgzf> & stream, __int64 blockAddress)
 {
     // If there is no block in the cache with this address then return false.
     std::map<__int64, BgzfCacheEntry_ *>::iterator it = stream._cache.find(blockAddress);
     if (it == stream._cache.end())
-        return 0;
+        return false;
 
     // Update fields of stream.
     if (stream._blockLength != 0)
@@ -422,7 +461,7 @@ _bgzfLoadBlockFromCache(Stream<Bgzf> & stream, __int64 blockAddress)
     // Seek to end of cached block in the underlying file.
     seek(stream._file, it->second->endOffset, SEEK_SET);
 
-    return it->second->size;
+    return true;
 }
 
 // ----------------------------------------------------------------------------
@@ -481,10 +520,11 @@ _bgzfClearCache(Stream<Bgzf> & stream)
 // Helper Function _bgzfInflateBlock()
 // ----------------------------------------------------------------------------
 
-// Inflate from compression to decompression buffer.
+// Inflate compressed block of length blockLength (including header and footer) from source to target.  Returns the
+// number of uncompressed bytes or -1 on errors.
 
 inline int
-_bgzfInflateBlock(Stream<Bgzf> & stream, size_t blockLength)
+_bgzfInflate(char * target, size_t targetLength, char const * source, size_t blockLength)
 {
     int const GZIP_WINDOW_BITS = -15;  // no zlib header
 
@@ -492,10 +532,10 @@ _bgzfInflateBlock(Stream<Bgzf> & stream, size_t blockLength)
 	int status;
     zs.zalloc = NULL;
     zs.zfree = NULL;
-    zs.next_in = static_cast<Bytef *>(static_cast<void *>(&stream._compressedBlock[0])) + 18;
+    zs.next_in = const_cast<Bytef *>(static_cast<Bytef const *>(static_cast<void const *>(source))) + 18;
     zs.avail_in = blockLength - 16;
-    zs.next_out = static_cast<Bytef *>(static_cast<void *>(&stream._uncompressedBlock[0]));
-    zs.avail_out = length(stream._uncompressedBlock);
+    zs.next_out = static_cast<Bytef *>(static_cast<void *>(target));
+    zs.avail_out = targetLength;
 
     status = inflateInit2(&zs, GZIP_WINDOW_BITS);
     if (status != Z_OK)
@@ -515,6 +555,148 @@ _bgzfInflateBlock(Stream<Bgzf> & stream, size_t blockLength)
     return zs.total_out;
 }
 
+// Inflate from compression to decompression buffer.
+
+inline int
+_bgzfInflateBlock(Stream<Bgzf> & stream, size_t blockLength)
+{
+    return _bgzfInflate(&stream._uncompressedBlock[0], length(stream._uncompressedBlock),
+                        &stream._compressedBlock[0], blockLength);
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bgzfBatchSize()
+// ----------------------------------------------------------------------------
+
+// Number of blocks that are read ahead or written behind at once, we give each thread a few blocks to balance the load.
+
+inline unsigned
+_bgzfBatchSize(Stream<Bgzf> const & stream)
+{
+    return 4 * stream._numThreads;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bgzfReadCompressedBlock()
+// ----------------------------------------------------------------------------
+
+// Read the next compressed block from the file into buffer which must have room for 64 KiB.  Returns the length of
+// the compressed block, -1 on errors and -2 on EOF.
+
+inline int
+_bgzfReadCompressedBlock(char * buffer, Stream<Bgzf>::TFile & file)
+{
+    int const BLOCK_HEADER_LENGTH = 18;
+
+    // Try to read the header.
+    __int64 posBefore = tell(file);
+    bool success = read(file, buffer, BLOCK_HEADER_LENGTH);
+    int count = tell(file) - posBefore;
+    if (!success && count == 0)
+        return -2;  // EOF.
+    if (!success || count != BLOCK_HEADER_LENGTH)
+        return -1;  // Could not read the full header.
+    if (!_bgzfCheckHeader(buffer))
+        return -1;  // Header was invalid.
+
+    // Read remainder of block.
+    int blockLength = _bgzfUnpackInt16((unsigned char *)&buffer[16]) + 1;
+    int remaining = blockLength - BLOCK_HEADER_LENGTH;
+    if (!read(file, buffer + BLOCK_HEADER_LENGTH, remaining))
+        return -1;  // Read failed.
+
+    return blockLength;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bgzfLoadBlockFromBatch()
+// ----------------------------------------------------------------------------
+
+// Returns 1 if the block at the given address was read ahead and is now loaded, 0 if it was not read ahead and -1 if
+// it could not be decompressed.
+
+inline int
+_bgzfLoadBlockFromBatch(Stream<Bgzf> & stream, __int64 blockAddress)
+{
+    // Usually, the reader requests the block after the last one, so we start searching there.
+    for (unsigned k = 0; k < stream._batchLength; ++k)
+    {
+        unsigned i = (stream._batchPos + k) % stream._batchLength;
+        BgzfBatchBlock_ const & entry = stream._batch[i];
+        if (entry.blockAddress != blockAddress)
+            continue;
+        if (entry.size < 0)
+            return -1;  // Decompression failed.
+
+        // Update fields of stream as if the block had been read and decompressed right now.
+        if (stream._blockLength != 0)
+            stream._blockOffset = 0;
+        stream._blockPosition = blockAddress;
+        stream._blockLength = entry.size;
+        if (entry.size != 0)
+            memcpy(&stream._uncompressedBlock[0], &entry.uncompressed[0], entry.size);
+
+        // Seek to end of the block in the underlying file.
+        seek(stream._file, entry.endOffset, SEEK_SET);
+        stream._batchPos = i + 1;
+
+        _bgzfCacheBlock(stream, entry.endOffset - blockAddress);
+        return 1;
+    }
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bgzfReadAhead()
+// ----------------------------------------------------------------------------
+
+// Read the next blocks from the current file position and decompress them in parallel.  Returns 0 on success, -1 on
+// errors and -2 on EOF.
+
+inline int
+_bgzfReadAhead(Stream<Bgzf> & stream)
+{
+    unsigned const MAX_BLOCK_SIZE = 64 * 1024;
+
+    if (length(stream._batch) < _bgzfBatchSize(stream))
+        resize(stream._batch, _bgzfBatchSize(stream));
+    stream._batchLength = 0;
+    stream._batchPos = 0;
+
+    // Read the compressed blocks sequentially.  Errors after the first block are reported once the reader gets there.
+    int res = 0;
+    while (stream._batchLength < _bgzfBatchSize(stream))
+    {
+        BgzfBatchBlock_ & entry = stream._batch[stream._batchLength];
+        resize(entry.compressed, MAX_BLOCK_SIZE);
+        entry.blockAddress = tell(stream._file);
+        res = _bgzfReadCompressedBlock(&entry.compressed[0], stream._file);
+        if (res < 0)
+            break;
+        entry.endOffset = entry.blockAddress + res;
+        ++stream._batchLength;
+
+        // Do not read beyond an empty block (ISIZE in the footer is 0), it marks the end of the file.
+        if (_bgzfUnpackInt16((unsigned char *)&entry.compressed[res - 4]) == 0 &&
+            _bgzfUnpackInt16((unsigned char *)&entry.compressed[res - 2]) == 0)
+            break;
+    }
+    if (stream._batchLength == 0)
+        return res;
+
+    // Decompress the blocks in parallel.
+    SEQAN_OMP_PRAGMA(parallel for num_threads(stream._numThreads) schedule(dynamic))
+    for (int i = 0; i < (int)stream._batchLength; ++i)
+    {
+        BgzfBatchBlock_ & entry = stream._batch[i];
+        resize(entry.uncompressed, MAX_BLOCK_SIZE);
+        entry.size = _bgzfInflate(&entry.uncompressed[0], length(entry.uncompressed), &entry.compressed[0],
+                                  entry.endOffset - entry.blockAddress);
+    }
+
+    return 0;
+}
+
 // ----------------------------------------------------------------------------
 // Helper Function _bgzfReadBlock()
 // ----------------------------------------------------------------------------
@@ -537,6 +719,20 @@ _bgzfReadBlock(Stream<Bgzf> & stream)
     if (_bgzfLoadBlockFromCache(stream, blockAddress))
         return 0;
 
+    // Take block from the read-ahead batch, read and decompress the next batch if it is not there.
+    if (stream._numThreads > 1)
+    {
+        int res = _bgzfLoadBlockFromBatch(stream, blockAddress);
+        if (res == 0)
+        {
+            res = _bgzfReadAhead(stream);
+            if (res != 0)
+                return res;
+            res = _bgzfLoadBlockFromBatch(stream, blockAddress);
+        }
+        return (res == 1) ? 0 : -1;
+    }
+
     // Try to read the heder.
     __int64 posBefore = tell(stream._file);
     // TODO(holtgrew): Complicated reading because File<> interface is not so good.
@@ -598,13 +794,15 @@ _bgzfReadBlock(Stream<Bgzf> & stream)
 }
 
 // ----------------------------------------------------------------------------
-// Helper Function _bgzfDeflateBlock()
+// Helper Function _bgzfDeflate()
 // ----------------------------------------------------------------------------
 
-// Deflate from uncompressed block to compressed block.  Also add extra field that stores the compressed block length.
+// Deflate up to inputLength bytes from source into a BGZF block in buffer.  Also add extra field that stores the
+// compressed block length.  On return, inputLength contains the number of bytes that actually fit into the block.
+// Returns the compressed block length or -1 on errors.
 
 inline int
-_bgzfDeflateBlock(Stream<Bgzf> & stream, int blockLength)
+_bgzfDeflate(char * buffer, int bufferSize, char const * source, int & inputLength, int compressLevel)
 {
     const int BLOCK_HEADER_LENGTH = 18;
     const int BLOCK_FOOTER_LENGTH = 8;
@@ -624,13 +822,6 @@ _bgzfDeflateBlock(Stream<Bgzf> & stream, int blockLength)
 
     const int MAX_BLOCK_SIZE = 64 * 1024;
 
-    // Make sure there is enough space in the buffer for compressed and uncompressed data.
-    resize(stream._compressedBlock, MAX_BLOCK_SIZE);
-    resize(stream._uncompressedBlock, MAX_BLOCK_SIZE);
-
-    char * buffer = &stream._compressedBlock[0];
-    int bufferSize = length(stream._compressedBlock);
-
     // Init gzip header
     buffer[0] = GZIP_ID1;
     buffer[1] = GZIP_ID2;
@@ -652,19 +843,18 @@ _bgzfDeflateBlock(Stream<Bgzf> & stream, int blockLength)
     buffer[17] = 0;
 
     // Loop to retry for blocks that do not compress enough.
-    int inputLength = blockLength;
     int compressedLength = 0;
     while (true)
     {
         z_stream zs;
         zs.zalloc = NULL;
         zs.zfree = NULL;
-        zs.next_in = static_cast<Bytef *>(static_cast<void *>(&stream._uncompressedBlock[0]));
+        zs.next_in = const_cast<Bytef *>(static_cast<Bytef const *>(static_cast<void const *>(source)));
         zs.avail_in = inputLength;
         zs.next_out = static_cast<Bytef *>(static_cast<void *>(&buffer[BLOCK_HEADER_LENGTH]));
         zs.avail_out = bufferSize - BLOCK_HEADER_LENGTH - BLOCK_FOOTER_LENGTH;
 
-        int status = deflateInit2(&zs, stream._compressLevel, Z_DEFLATED,
+        int status = deflateInit2(&zs, compressLevel, Z_DEFLATED,
                                   GZIP_WINDOW_BITS, Z_DEFAULT_MEM_LEVEL, Z_DEFAULT_STRATEGY);
         if (status != Z_OK)
             return -1;  // deflateInit2() failed.
@@ -700,10 +890,34 @@ _bgzfDeflateBlock(Stream<Bgzf> & stream, int blockLength)
     // Set compressed length into buffer, compute CRC and write CRC into buffer.
     _bgzfPackInt16((unsigned char*)&buffer[16], compressedLength - 1);
     __uint32 crc = crc32(0L, NULL, 0L);
-    crc = crc32(crc, static_cast<Bytef *>(static_cast<void *>(&stream._uncompressedBlock[0])), inputLength);
+    crc = crc32(crc, static_cast<Bytef const *>(static_cast<void const *>(source)), inputLength);
     _bgzfPackInt32((unsigned char*)&buffer[compressedLength - 8], crc);
     _bgzfPackInt32((unsigned char*)&buffer[compressedLength - 4], inputLength);
 
+    return compressedLength;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bgzfDeflateBlock()
+// ----------------------------------------------------------------------------
+
+// Deflate from uncompressed block to compressed block.
+
+inline int
+_bgzfDeflateBlock(Stream<Bgzf> & stream, int blockLength)
+{
+    const int MAX_BLOCK_SIZE = 64 * 1024;
+
+    // Make sure there is enough space in the buffer for compressed and uncompressed data.
+    resize(stream._compressedBlock, MAX_BLOCK_SIZE);
+    resize(stream._uncompressedBlock, MAX_BLOCK_SIZE);
+
+    int inputLength = blockLength;
+    int compressedLength = _bgzfDeflate(&stream._compressedBlock[0], length(stream._compressedBlock),
+                                        &stream._uncompressedBlock[0], inputLength, stream._compressLevel);
+    if (compressedLength < 0)
+        return -1;
+
     // Copy data that did not fit into the compressed block forward in the uncompressed data buffer.
     int remaining = blockLength - inputLength;
     if (remaining > 0)
@@ -719,6 +933,192 @@ _bgzfDeflateBlock(Stream<Bgzf> & stream, int blockLength)
     return compressedLength;
 }
 
+// ----------------------------------------------------------------------------
+// Helper Function _bgzfCompressBatchBlock()
+// ----------------------------------------------------------------------------
+
+// Compress the uncompressed data of a write-behind batch entry into one or more BGZF blocks, splitting the data
+// exactly like streamFlush() does for data that does not compress enough.
+
+inline void
+_bgzfCompressBatchBlock(BgzfBatchBlock_ & entry, int compressLevel)
+{
+    unsigned const MAX_BLOCK_SIZE = 64 * 1024;
+
+    char const * source = begin(entry.uncompressed, Standard());
+    int remaining = length(entry.uncompressed);
+    entry.size = 0;
+
+    while (remaining > 0)
+    {
+        resize(entry.compressed, entry.size + MAX_BLOCK_SIZE);
+        int inputLength = remaining;
+        int compressedLength = _bgzfDeflate(&entry.compressed[entry.size], MAX_BLOCK_SIZE, source, inputLength,
+                                            compressLevel);
+        if (compressedLength < 0)
+        {
+            entry.size = -1;  // Compression failed.
+            return;
+        }
+        entry.size += compressedLength;
+        source += inputLength;
+        remaining -= inputLength;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bgzfCompressBatch()
+// ----------------------------------------------------------------------------
+
+// Compress the blocks of the write-behind batch that are not compressed yet in parallel.  Returns 0 on success and -1
+// on errors.
+
+inline int
+_bgzfCompressBatch(Stream<Bgzf> & stream)
+{
+    int first = stream._batchCompressed;
+    SEQAN_OMP_PRAGMA(parallel for num_threads(stream._numThreads) schedule(dynamic))
+    for (int i = first; i < (int)stream._batchLength; ++i)
+        _bgzfCompressBatchBlock(stream._batch[i], stream._compressLevel);
+
+    for (; stream._batchCompressed < stream._batchLength; ++stream._batchCompressed)
+    {
+        if (stream._batch[stream._batchCompressed].size < 0)
+            return -1;  // Compression failed.
+        stream._batchCompressedSize += stream._batch[stream._batchCompressed].size;
+    }
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bgzfWriteBatch()
+// ----------------------------------------------------------------------------
+
+// Compress all blocks of the write-behind batch in parallel and write them out in order.  Returns 0 on success and -1
+// on errors, the stream is marked as bad then.
+
+inline int
+_bgzfWriteBatchImpl(Stream<Bgzf> & stream)
+{
+    if (_bgzfCompressBatch(stream) != 0)
+        return -1;
+
+    for (unsigned i = 0; i < stream._batchLength; ++i)
+    {
+        BgzfBatchBlock_ const & entry = stream._batch[i];
+        if (entry.size == 0)
+            continue;
+
+        typedef Position<Stream<Bgzf> >::Type TPos;
+        TPos posBefore = tell(stream._file);
+        if (!write(stream._file, &entry.compressed[0], entry.size))
+            return -1;  // Could not write.
+        TPos posAfter = tell(stream._file);
+        if (posAfter - posBefore != entry.size)
+            return -1;  // Writing failed.
+
+        stream._blockPosition += entry.size;
+    }
+
+    return 0;
+}
+
+inline int
+_bgzfWriteBatch(Stream<Bgzf> & stream)
+{
+    int res = _bgzfWriteBatchImpl(stream);
+    stream._batchLength = 0;
+    stream._batchCompressed = 0;
+    stream._batchCompressedSize = 0;
+    if (res != 0)
+        stream._error = 1;  // The collected blocks are lost.
+    return res;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bgzfWriteBehind()
+// ----------------------------------------------------------------------------
+
+// Move the current uncompressed block into the write-behind batch.  The batch is compressed and written once it is
+// full.  Returns 0 on success and -1 on errors.
+
+inline int
+_bgzfWriteBehind(Stream<Bgzf> & stream)
+{
+    if (stream._blockOffset == 0)
+        return 0;
+
+    if (length(stream._batch) < _bgzfBatchSize(stream))
+        resize(stream._batch, _bgzfBatchSize(stream));
+    BgzfBatchBlock_ & entry = stream._batch[stream._batchLength++];
+    resize(entry.uncompressed, stream._blockOffset);
+    memcpy(&entry.uncompressed[0], &stream._uncompressedBlock[0], stream._blockOffset);
+    stream._blockOffset = 0;
+
+    if (stream._batchLength == _bgzfBatchSize(stream))
+        return _bgzfWriteBatch(stream);
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function setNumThreads()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BgzfStream#setNumThreads
+ * @brief Set the number of threads used for compression and decompression.
+ *
+ * @signature int setNumThreads(stream, numThreads);
+ *
+ * @param[in,out] stream     The BgzfStream to configure.
+ * @param[in]     numThreads The number of threads to use.  Type: <tt>unsigned</tt>.
+ *
+ * @return int 0 on success, -1 if the blocks collected with the previous setting could not be written.
+ *
+ * @section Remarks
+ *
+ * With more than one thread, a batch of blocks is read ahead of the reader and decompressed in parallel.  When
+ * writing, full blocks are collected behind the writer and compressed in parallel.  The resulting files are identical
+ * to those written with one thread and virtual offsets from @link BgzfStream#streamTell @endlink stay valid.  Calling
+ * <tt>streamTell</tt> while writing compresses the collected blocks that are not compressed yet, but they are only
+ * written out once the batch is full.
+ *
+ * Parallelism requires OpenMP, the default is one thread.
+ */
+
+/**
+.Function.setNumThreads
+..class:Spec.BGZF Stream
+..cat:Input/Output
+..summary:Set the number of threads used for compression and decompression.
+..signature:setNumThreads(stream, numThreads)
+..param.stream:The stream to configure.
+...type:Spec.BGZF Stream
+..param.numThreads:The number of threads to use.
+...type:nolink:$unsigned$
+..returns:$0$ on success, $-1$ if the blocks collected with the previous setting could not be written.
+..remarks:With more than one thread, a batch of blocks is read ahead of the reader and decompressed in parallel.
+When writing, full blocks are collected behind the writer and compressed in parallel.
+The resulting files are identical to those written with one thread and virtual offsets from @Function.streamTell@ stay valid.
+Calling $streamTell$ while writing compresses the collected blocks that are not compressed yet, but they are only written out once the batch is full.
+..remarks:Parallelism requires OpenMP, the default is one thread.
+..include:seqan/stream.h
+*/
+
+inline int
+setNumThreads(Stream<Bgzf> & stream, unsigned numThreads)
+{
+    // Write out any blocks collected with the previous setting.
+    int res = 0;
+    if ((stream._openMode & OPEN_WRONLY) && stream._batchLength != 0)
+        res = _bgzfWriteBatch(stream);
+
+    stream._numThreads = (numThreads == 0) ? 1 : numThreads;
+    stream._batchLength = 0;
+    stream._batchPos = 0;
+    return res;
+}
+
 // ----------------------------------------------------------------------------
 // Function attachToFile
 // ----------------------------------------------------------------------------
@@ -803,6 +1203,10 @@ open(Stream<Bgzf> & stream, char const * filename, char const * mode)
     stream._blockLength = 0;
     stream._blockOffset = 0;
     stream._fileSize = 0;
+    stream._batchLength = 0;
+    stream._batchPos = 0;
+    stream._batchCompressed = 0;
+    stream._batchCompressedSize = 0;
 
     // Actually open files.
     if (mode[0] == 'r' || mode[0] == 'R')  // Open for reading.
@@ -855,6 +1259,13 @@ open(Stream<Bgzf> & stream, char const * filename, char const * mode)
 inline int
 streamFlush(Stream<Bgzf> & stream)
 {
+    if (stream._numThreads > 1 && (stream._openMode & OPEN_WRONLY))
+    {
+        if (_bgzfWriteBehind(stream) != 0)
+            return -1;
+        return _bgzfWriteBatch(stream);
+    }
+
     while (stream._blockOffset > 0)
     {
 		int blockLength = _bgzfDeflateBlock(stream, stream._blockOffset);
@@ -919,8 +1330,10 @@ close(Stream<Bgzf> & stream)
         flush(stream._file);
     }
 
-    // Clear the cache.
+    // Clear the cache and read-ahead blocks.
     _bgzfClearCache(stream);
+    stream._batchLength = 0;
+    stream._batchPos = 0;
 
     // Close file.
     close(stream._file);
@@ -1162,8 +1575,12 @@ streamWriteBlock(Stream<Bgzf> & stream, char const * source, size_t count)
         inPtr += copyLength;
         bytesWritten += copyLength;
 
-        if (stream._blockOffset == blockLength && streamFlush(stream) != 0)
-            break;
+        if (stream._blockOffset == blockLength)
+        {
+            int res = (stream._numThreads > 1) ? _bgzfWriteBehind(stream) : streamFlush(stream);
+            if (res != 0)
+                break;
+        }
     }
 
     return bytesWritten;
@@ -1223,7 +1640,17 @@ streamSeek(Stream<Bgzf> & stream, __uint64 virtualPos, int origin)
 inline Position<Stream<Bgzf> >::Type
 streamTell(Stream<Bgzf> & stream)
 {
-    return (stream._blockPosition << 16) | (stream._blockOffset & 0xFFFF);
+    // The position of the current block is only known after the blocks behind the writer have been compressed, they
+    // stay in the batch until it is full.
+    __int64 blockPosition = stream._blockPosition;
+    if (stream._openMode & OPEN_WRONLY)
+    {
+        if (stream._batchCompressed < stream._batchLength && _bgzfCompressBatch(stream) != 0)
+            stream._error = 1;  // Compression failed, the position is meaningless.
+        blockPosition += stream._batchCompressedSize;
+    }
+
+    return (blockPosition << 16) | (stream._blockOffset & 0xFFFF);
 }
 
 }  // namespace seqan
@@ -0,0 +1,1130 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Tabix-style binning and linear index for BGZF compressed tab-delimited
+// files, e.g. VCF, BED, GFF and ROI.  The index files are compatible with
+// the TBI files of the tabix program.
+// ==========================================================================
+
+#ifndef CORE_INCLUDE_SEQAN_STREAM_TABIX_INDEX_H_
+#define CORE_INCLUDE_SEQAN_STREAM_TABIX_INDEX_H_
+
+#include <map>
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Helper Class TabixIndexBinData_
+// ----------------------------------------------------------------------------
+
+// Store the information of a bin.
+
+struct TabixIndexBinData_
+{
+    String<Pair<__uint64, __uint64> > chunkBegEnds;
+};
+
+// ----------------------------------------------------------------------------
+// Class TabixIndex
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class TabixIndex
+ * @headerfile <seqan/stream.h>
+ * @brief Binning and linear index for BGZF compressed tab-delimited files (tabix-style).
+ *
+ * @signature class TabixIndex;
+ *
+ * @section Remarks
+ *
+ * The index stores for each sequence the BGZF offsets of the lines overlapping each bin of the BAI binning scheme
+ * and each 16kb window.  It can be built for files sorted by sequence and begin position, the sequences are
+ * identified by their names in the index.  The index files are compatible with the <tt>.tbi</tt> files of tabix.
+ *
+ * The columns of the sequence name, begin and end position are configured with @link TabixIndex#setPreset @endlink
+ * before building the index, the default is GFF.  Only available if zlib is available.
+ */
+
+/*!
+ * @enum TabixIndex::Preset
+ * @headerfile <seqan/stream.h>
+ * @brief Column configuration of the indexed file format.
+ *
+ * @signature enum TabixIndex::Preset;
+ *
+ * @var TabixIndex::Preset TabixIndex::GFF;
+ * @brief GFF and GTF, sequence in column 1, 1-based begin and end position in columns 4 and 5.
+ *
+ * @var TabixIndex::Preset TabixIndex::BED;
+ * @brief BED, sequence in column 1, 0-based begin and end position in columns 2 and 3.
+ *
+ * @var TabixIndex::Preset TabixIndex::VCF;
+ * @brief VCF, sequence in column 1, 1-based position in column 2, the end is computed from the REF column.
+ *
+ * @var TabixIndex::Preset TabixIndex::ROI;
+ * @brief ROI, sequence in column 1, 1-based begin and end position in columns 2 and 3.
+ */
+
+/**
+.Class.TabixIndex
+..cat:Input/Output
+..summary:Binning and linear index for BGZF compressed tab-delimited files (tabix-style).
+..signature:TabixIndex
+..remarks:The index stores for each sequence the BGZF offsets of the lines overlapping each bin of the BAI binning scheme and each 16kb window.
+It can be built for files sorted by sequence and begin position, the sequences are identified by their names in the index.
+The index files are compatible with the $.tbi$ files of tabix.
+..remarks:The columns of the sequence name, begin and end position are configured with @Function.TabixIndex#setPreset@ before building the index, the default is GFF.
+Only available if zlib is available.
+..include:seqan/stream.h
+
+.Enum.TabixIndex\colon\colonPreset
+..cat:Input/Output
+..summary:Column configuration of the format indexed by a @Class.TabixIndex@.
+..value.GFF:GFF and GTF, sequence in column 1, 1-based begin and end position in columns 4 and 5.
+..value.BED:BED, sequence in column 1, 0-based begin and end position in columns 2 and 3.
+..value.VCF:VCF, sequence in column 1, 1-based position in column 2, the end is computed from the REF column.
+..value.ROI:ROI, sequence in column 1, 1-based begin and end position in columns 2 and 3.
+..include:seqan/stream.h
+*/
+
+class TabixIndex
+{
+public:
+    typedef std::map<__uint32, TabixIndexBinData_> TBinIndex_;
+    typedef String<__uint64> TLinearIndex_;
+
+    enum Preset
+    {
+        GFF,
+        BED,
+        VCF,
+        ROI
+    };
+
+    // Values of the format field, the flag marks 0-based half-open intervals.
+    static const __int32 TBX_GENERIC = 0;
+    static const __int32 TBX_SAM = 1;
+    static const __int32 TBX_VCF = 2;
+    static const __int32 TBX_UCSC = 0x10000;
+
+    // 1<<14 is the size of the minimum bin.
+    static const __int32 TBX_LIDX_SHIFT = 14;
+
+    // The column configuration, columns are 1-based, an end column of 0 means that the end is the begin + 1.
+    __int32 _format;
+    __int32 _colSeq;
+    __int32 _colBeg;
+    __int32 _colEnd;
+    __int32 _meta;
+    __int32 _skip;
+
+    // Number of lines without coordinate, maxValue<__uint64>() if unknown.
+    __uint64 _unplacedCount;
+
+    StringSet<CharString> _names;
+    String<TBinIndex_> _binIndices;
+    String<TLinearIndex_> _linearIndices;
+
+    TabixIndex() : _format(TBX_GENERIC), _colSeq(1), _colBeg(4), _colEnd(5), _meta('#'), _skip(0),
+                   _unplacedCount(maxValue<__uint64>())
+    {}
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function setPreset()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn TabixIndex#setPreset
+ * @brief Configure the columns of a TabixIndex for a file format.
+ *
+ * @signature void setPreset(index, preset);
+ *
+ * @param[in,out] index  The TabixIndex to configure.
+ * @param[in]     preset The format of the indexed file, @link TabixIndex::Preset @endlink.
+ */
+
+/**
+.Function.TabixIndex#setPreset
+..class:Class.TabixIndex
+..cat:Input/Output
+..summary:Configure the columns of a @Class.TabixIndex@ for a file format.
+..signature:setPreset(index, preset)
+..param.index:The index to configure.
+...type:Class.TabixIndex
+..param.preset:The format of the indexed file.
+...type:Enum.TabixIndex\colon\colonPreset
+..include:seqan/stream.h
+*/
+
+inline void
+setPreset(TabixIndex & index, TabixIndex::Preset preset)
+{
+    index._meta = '#';
+    index._skip = 0;
+    switch (preset)
+    {
+        case TabixIndex::BED:
+            index._format = TabixIndex::TBX_GENERIC | TabixIndex::TBX_UCSC;
+            index._colSeq = 1;
+            index._colBeg = 2;
+            index._colEnd = 3;
+            break;
+        case TabixIndex::VCF:
+            index._format = TabixIndex::TBX_VCF;
+            index._colSeq = 1;
+            index._colBeg = 2;
+            index._colEnd = 0;
+            break;
+        case TabixIndex::ROI:
+            index._format = TabixIndex::TBX_GENERIC;
+            index._colSeq = 1;
+            index._colBeg = 2;
+            index._colEnd = 3;
+            break;
+        default:
+            index._format = TabixIndex::TBX_GENERIC;
+            index._colSeq = 1;
+            index._colBeg = 4;
+            index._colEnd = 5;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function clear()
+// ----------------------------------------------------------------------------
+
+inline void
+clear(TabixIndex & index)
+{
+    clear(index._names);
+    clear(index._binIndices);
+    clear(index._linearIndices);
+    index._unplacedCount = maxValue<__uint64>();
+}
+
+// ----------------------------------------------------------------------------
+// Function numSeqs()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn TabixIndex#numSeqs
+ * @brief Return the number of sequences in a TabixIndex.
+ *
+ * @signature unsigned numSeqs(index);
+ *
+ * @param[in] index The TabixIndex to query.
+ *
+ * @return unsigned The number of sequences.
+ */
+
+/**
+.Function.TabixIndex#numSeqs
+..class:Class.TabixIndex
+..cat:Input/Output
+..summary:Return the number of sequences in a @Class.TabixIndex@.
+..signature:numSeqs(index)
+..param.index:The index to query.
+...type:Class.TabixIndex
+..returns:$unsigned$, the number of sequences.
+..include:seqan/stream.h
+*/
+
+inline unsigned
+numSeqs(TabixIndex const & index)
+{
+    return length(index._names);
+}
+
+// ----------------------------------------------------------------------------
+// Function sequenceName()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn TabixIndex#sequenceName
+ * @brief Return the name of a sequence in a TabixIndex.
+ *
+ * @signature CharString sequenceName(index, refId);
+ *
+ * @param[in] index The TabixIndex to query.
+ * @param[in] refId The id of the sequence in the index.
+ *
+ * @return CharString The name of the sequence.
+ */
+
+/**
+.Function.TabixIndex#sequenceName
+..class:Class.TabixIndex
+..cat:Input/Output
+..summary:Return the name of a sequence in a @Class.TabixIndex@.
+..signature:sequenceName(index, refId)
+..param.index:The index to query.
+...type:Class.TabixIndex
+..param.refId:The id of the sequence in the index.
+..returns:The name of the sequence, a @Shortcut.CharString@.
+..include:seqan/stream.h
+*/
+
+template <typename TPos>
+inline CharString const &
+sequenceName(TabixIndex const & index, TPos refId)
+{
+    return index._names[refId];
+}
+
+// ----------------------------------------------------------------------------
+// Function getIdByName()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn TabixIndex#getIdByName
+ * @brief Return the id of a sequence in a TabixIndex.
+ *
+ * @signature bool getIdByName(index, name, refId);
+ *
+ * @param[in]  index The TabixIndex to query.
+ * @param[in]  name  The name of the sequence.
+ * @param[out] refId The id of the sequence in the index.
+ *
+ * @return bool <tt>true</tt> if the index has entries for the sequence and <tt>false</tt> otherwise.
+ */
+
+/**
+.Function.TabixIndex#getIdByName
+..class:Class.TabixIndex
+..cat:Input/Output
+..summary:Return the id of a sequence in a @Class.TabixIndex@.
+..signature:getIdByName(index, name, refId)
+..param.index:The index to query.
+...type:Class.TabixIndex
+..param.name:The name of the sequence.
+..param.refId:The id of the sequence in the index.
+..returns:$true$ if the index has entries for the sequence and $false$ otherwise.
+..include:seqan/stream.h
+*/
+
+// The names are searched linearly, the number of sequences is small compared to the work of a query.
+
+template <typename TName, typename TId>
+inline bool
+getIdByName(TabixIndex const & index, TName const & name, TId & refId)
+{
+    for (unsigned i = 0; i < length(index._names); ++i)
+        if (index._names[i] == name)
+        {
+            refId = i;
+            return true;
+        }
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _tabixReg2bin(), _tabixReg2bins()
+// ----------------------------------------------------------------------------
+
+// The binning scheme of BAI, [beg, end) must be below 2^29.
+
+inline __uint32
+_tabixReg2bin(__uint32 beg, __uint32 end)
+{
+    --end;
+    if (beg >> 14 == end >> 14)
+        return 4681 + (beg >> 14);
+    if (beg >> 17 == end >> 17)
+        return 585 + (beg >> 17);
+    if (beg >> 20 == end >> 20)
+        return 73 + (beg >> 20);
+    if (beg >> 23 == end >> 23)
+        return 9 + (beg >> 23);
+    if (beg >> 26 == end >> 26)
+        return 1 + (beg >> 26);
+    return 0;
+}
+
+inline void
+_tabixReg2bins(String<__uint32> & list, __uint32 beg, __uint32 end)
+{
+    clear(list);
+    if (beg >= end)
+        return;
+    if (end >= 1u << 29)
+        end = 1u << 29;
+    --end;
+    appendValue(list, 0);
+    for (__uint32 k =    1 + (beg >> 26); k <=    1 + (end >> 26); ++k) appendValue(list, k);
+    for (__uint32 k =    9 + (beg >> 23); k <=    9 + (end >> 23); ++k) appendValue(list, k);
+    for (__uint32 k =   73 + (beg >> 20); k <=   73 + (end >> 20); ++k) appendValue(list, k);
+    for (__uint32 k =  585 + (beg >> 17); k <=  585 + (end >> 17); ++k) appendValue(list, k);
+    for (__uint32 k = 4681 + (beg >> 14); k <= 4681 + (end >> 14); ++k) appendValue(list, k);
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _tabixReadLine()
+// ----------------------------------------------------------------------------
+
+// Read the next line without the line break, the uncompressed blocks are scanned for the line break directly.
+// Returns 0 on success and 1 on EOF or errors.
+
+inline int
+_tabixReadLine(CharString & line, Stream<Bgzf> & stream)
+{
+    clear(line);
+    char c = 0;
+    while (true)
+    {
+        // Load the next block if necessary.
+        int res = streamPeek(c, stream);
+        if (res == -1)
+            return empty(line) ? 1 : 0;  // EOF, the last line may miss its line break.
+        if (res != 0)
+            return 1;  // Error reading block.
+
+        char const * first = &stream._uncompressedBlock[0] + stream._blockOffset;
+        char const * last = &stream._uncompressedBlock[0] + stream._blockLength;
+        char const * lineEnd = static_cast<char const *>(memchr(first, '\n', last - first));
+        unsigned oldLength = length(line);
+        resize(line, oldLength + (((lineEnd != 0) ? lineEnd : last) - first), Generous());
+        std::copy(first, (lineEnd != 0) ? lineEnd : last, begin(line, Standard()) + oldLength);
+
+        // Advance behind the line and switch to the next block at its end, as streamReadChar() does.
+        stream._blockOffset += ((lineEnd != 0) ? lineEnd + 1 : last) - first;
+        if (stream._blockOffset == stream._blockLength)
+        {
+            stream._blockPosition = tell(stream._file);
+            stream._blockOffset = 0;
+            stream._blockLength = 0;
+        }
+
+        if (lineEnd != 0)
+        {
+            if (!empty(line) && back(line) == '\r')
+                resize(line, length(line) - 1);
+            return 0;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _tabixParseLine()
+// ----------------------------------------------------------------------------
+
+// Extract the sequence name and the 0-based half-open interval [beginPos, endPos) from a line.  Returns false if the
+// line has not enough columns or invalid positions.
+
+inline bool
+_tabixParsePos(__int32 & value, char const * first, char const * last)
+{
+    if (first == last || last - first > 10)
+        return false;
+    __int64 result = 0;
+    for (; first != last; ++first)
+    {
+        if (*first < '0' || *first > '9')
+            return false;
+        result = result * 10 + (*first - '0');
+    }
+    if (result > maxValue<__int32>())
+        return false;
+    value = static_cast<__int32>(result);
+    return true;
+}
+
+inline bool
+_tabixParseLine(char const * & nameBegin, char const * & nameEnd,
+                __int32 & beginPos, __int32 & endPos,
+                CharString const & line,
+                TabixIndex const & index)
+{
+    bool isVcf = (index._format & 0xffff) == TabixIndex::TBX_VCF;
+    __int32 lastCol = std::max(std::max(index._colSeq, index._colBeg), std::max(index._colEnd, isVcf ? 4 : 0));
+    bool hasBeg = false;
+    bool hasEnd = (index._colEnd == 0 && !isVcf);
+    bool hasSeq = false;
+    endPos = 0;
+
+    char const * it = begin(line, Standard());
+    char const * lineEnd = end(line, Standard());
+    for (__int32 col = 1; col <= lastCol; ++col)
+    {
+        char const * colEnd = static_cast<char const *>(memchr(it, '\t', lineEnd - it));
+        if (colEnd == 0)
+            colEnd = lineEnd;
+
+        if (col == index._colSeq)
+        {
+            nameBegin = it;
+            nameEnd = colEnd;
+            hasSeq = true;
+        }
+        if (col == index._colBeg)
+        {
+            if (!_tabixParsePos(beginPos, it, colEnd))
+                return false;
+            hasBeg = true;
+        }
+        if (col == index._colEnd && !isVcf)
+        {
+            if (!_tabixParsePos(endPos, it, colEnd))
+                return false;
+            hasEnd = true;
+        }
+        if (col == 4 && isVcf)
+        {
+            // The end of a VCF record is given by the length of the reference allele.
+            endPos = colEnd - it;
+            hasEnd = true;
+        }
+
+        if (colEnd == lineEnd)
+            break;
+        it = colEnd + 1;
+    }
+    if (!hasSeq || !hasBeg || !hasEnd)
+        return false;
+
+    // Convert to 0-based half-open intervals, 1-based inclusive ends are 0-based exclusive ends already.
+    if (!(index._format & TabixIndex::TBX_UCSC))
+        beginPos -= 1;
+    if (isVcf)
+        endPos += beginPos;
+    else if (index._colEnd == 0)
+        endPos = beginPos + 1;
+    if (beginPos < 0)
+        return false;
+    if (endPos <= beginPos)
+        endPos = beginPos + 1;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _tabixIsHeaderLine()
+// ----------------------------------------------------------------------------
+
+inline bool
+_tabixIsHeaderLine(CharString const & line, __uint64 lineNo, TabixIndex const & index)
+{
+    return empty(line) || lineNo < static_cast<__uint64>(index._skip) || line[0] == static_cast<char>(index._meta);
+}
+
+// ----------------------------------------------------------------------------
+// Function buildIndex()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn TabixIndex#buildIndex
+ * @brief Build a TabixIndex for a sorted BGZF compressed file.
+ *
+ * @signature bool buildIndex(index, filename[, preset]);
+ *
+ * @param[out] index    The TabixIndex to build.
+ * @param[in]  filename Path to the BGZF compressed file, <tt>char const *</tt>.
+ * @param[in]  preset   The format of the file, @link TabixIndex::Preset @endlink.  If omitted, the current
+ *                      configuration of <tt>index</tt> is used.
+ *
+ * @return bool <tt>true</tt> on success, <tt>false</tt> if the file could not be read or is not sorted.
+ *
+ * @section Remarks
+ *
+ * Lines starting with the meta character <tt>'#'</tt> and empty lines are skipped.  The index is built in memory
+ * only, use @link TabixIndex#write @endlink to store it in a <tt>.tbi</tt> file.
+ */
+
+/**
+.Function.TabixIndex#buildIndex
+..class:Class.TabixIndex
+..cat:Input/Output
+..summary:Build a @Class.TabixIndex@ for a sorted BGZF compressed file.
+..signature:buildIndex(index, filename[, preset])
+..param.index:The index to build.
+...type:Class.TabixIndex
+..param.filename:Path to the BGZF compressed file.
+...type:nolink:$char const *$
+..param.preset:The format of the file. If omitted, the current configuration of $index$ is used.
+...type:Enum.TabixIndex\colon\colonPreset
+..returns:$bool$ indicating success, $false$ if the file could not be read or is not sorted.
+..remarks:Lines starting with the meta character $'#'$ and empty lines are skipped.
+The index is built in memory only, use @Function.TabixIndex#write@ to store it in a $.tbi$ file.
+..include:seqan/stream.h
+*/
+
+inline void _tabixAddChunkToBin(TabixIndex::TBinIndex_ & binIndex,
+                                __uint32 bin,
+                                __uint64 chunkBegin,
+                                __uint64 chunkEnd)
+{
+    // Creates the bin data if it does not exist yet and appends the chunk.
+    appendValue(binIndex[bin].chunkBegEnds, Pair<__uint64>(chunkBegin, chunkEnd));
+}
+
+// Record the offset of the line in all 16kb windows it overlaps that have no offset yet.
+
+inline void _tabixAddToLinearIndex(TabixIndex::TLinearIndex_ & linearIndex,
+                                   __int32 beginPos,
+                                   __int32 endPos,
+                                   __uint64 offset)
+{
+    unsigned beginWindow = beginPos >> TabixIndex::TBX_LIDX_SHIFT;
+    unsigned endWindow = (endPos - 1) >> TabixIndex::TBX_LIDX_SHIFT;
+
+    if (length(linearIndex) <= endWindow)
+        resize(linearIndex, endWindow + 1, maxValue<__uint64>());
+    for (unsigned i = beginWindow; i <= endWindow; ++i)
+        if (linearIndex[i] == maxValue<__uint64>())
+            linearIndex[i] = offset;
+}
+
+// Merge adjacent chunks of a bin that start in the same BGZF block the previous chunk ends in.
+
+inline void _tabixMergeChunks(TabixIndex & index)
+{
+    typedef TabixIndex::TBinIndex_::iterator  TBinIndexIter;
+    typedef String<Pair<__uint64, __uint64> > TChunks;
+
+    for (unsigned i = 0; i < length(index._binIndices); ++i)
+        for (TBinIndexIter it = index._binIndices[i].begin(); it != index._binIndices[i].end(); ++it)
+        {
+            if (it->first == 37450u)
+                continue;  // Skip pseudo-bin with meta data.
+
+            TChunks & chunks = it->second.chunkBegEnds;
+            if (empty(chunks))
+                continue;
+            unsigned last = 0;
+            for (unsigned j = 1; j < length(chunks); ++j)
+            {
+                if ((chunks[last].i2 >> 16) == (chunks[j].i1 >> 16))
+                    chunks[last].i2 = chunks[j].i2;
+                else
+                    chunks[++last] = chunks[j];
+            }
+            resize(chunks, last + 1);
+        }
+}
+
+inline bool
+buildIndex(TabixIndex & index, char const * filename)
+{
+    clear(index);
+    index._unplacedCount = 0;
+
+    Stream<Bgzf> stream;
+    if (!open(stream, filename, "r"))
+        return false;  // Could not open file.
+
+    // The save* variables describe the currently open chunk, the last* variables the previous line.
+    CharString line;
+    char const * nameBegin = 0;
+    char const * nameEnd = 0;
+    __int32 beginPos = 0;
+    __int32 endPos = 0;
+    __uint32 saveBin     = maxValue<__uint32>();
+    __uint32 lastBin     = maxValue<__uint32>();
+    __int32 saveRefId    = -1;
+    __int32 lastRefId    = -1;
+    __int32 lastPos      = 0;
+    __uint64 saveOffset  = streamTell(stream);
+    __uint64 lastOffset  = saveOffset;
+    __uint64 refBeginOffset = saveOffset;
+    __uint64 numLines    = 0;
+
+    for (__uint64 lineNo = 0; _tabixReadLine(line, stream) == 0; ++lineNo)
+    {
+        __uint64 offset = lastOffset;
+        lastOffset = streamTell(stream);
+        if (_tabixIsHeaderLine(line, lineNo, index))
+            continue;
+        if (!_tabixParseLine(nameBegin, nameEnd, beginPos, endPos, line, index))
+            return false;  // Invalid line.
+        if (endPos > (1 << 29))
+            return false;  // Position too large for the binning scheme.
+
+        // Check ordering, each sequence must form one block.
+        if (lastRefId < 0 || index._names[lastRefId] != infix(line, nameBegin - begin(line, Standard()),
+                                                              nameEnd - begin(line, Standard())))
+        {
+            CharString name = infix(line, nameBegin - begin(line, Standard()), nameEnd - begin(line, Standard()));
+            __int32 refId = 0;
+            if (getIdByName(index, name, refId))
+                return false;  // Not sorted by sequence.
+            appendValue(index._names, name);
+            resize(index._binIndices, length(index._names));
+            resize(index._linearIndices, length(index._names));
+            lastRefId = length(index._names) - 1;
+            lastBin = maxValue<__uint32>();
+        }
+        else if (lastPos > beginPos)
+        {
+            return false;  // Not sorted by position.
+        }
+
+        _tabixAddToLinearIndex(index._linearIndices[lastRefId], beginPos, endPos, offset);
+
+        // Handle the case if we changed to a new bin.
+        __uint32 bin = _tabixReg2bin(beginPos, endPos);
+        if (bin != lastBin)
+        {
+            // If not the first line, save previous chunk.
+            if (saveBin != maxValue<__uint32>())
+                _tabixAddChunkToBin(index._binIndices[saveRefId], saveBin, saveOffset, offset);
+
+            // The sequence changed, write the pseudo-bin with the meta data of the previous one.
+            if (lastBin == maxValue<__uint32>() && saveRefId != -1)
+            {
+                _tabixAddChunkToBin(index._binIndices[saveRefId], 37450u, refBeginOffset, offset);
+                _tabixAddChunkToBin(index._binIndices[saveRefId], 37450u, numLines, 0u);
+                numLines = 0;
+            }
+            if (lastBin == maxValue<__uint32>())
+                refBeginOffset = offset;
+
+            // Update markers.
+            saveOffset = offset;
+            saveBin = lastBin = bin;
+            saveRefId = lastRefId;
+        }
+
+        numLines += 1;
+        lastPos = beginPos;
+    }
+    if (streamError(stream) != 0)
+        return false;  // Error reading the file.
+
+    // Close the chunks of the last sequence.
+    if (saveBin != maxValue<__uint32>())
+    {
+        _tabixAddChunkToBin(index._binIndices[saveRefId], saveBin, saveOffset, lastOffset);
+        _tabixAddChunkToBin(index._binIndices[saveRefId], 37450u, refBeginOffset, lastOffset);
+        _tabixAddChunkToBin(index._binIndices[saveRefId], 37450u, numLines, 0u);
+    }
+
+    _tabixMergeChunks(index);
+
+    // Fill windows without line starts with the offset of the previous window, leading windows get offset 0.
+    for (unsigned i = 0; i < length(index._linearIndices); ++i)
+        for (unsigned j = 0; j < length(index._linearIndices[i]); ++j)
+            if (index._linearIndices[i][j] == maxValue<__uint64>())
+                index._linearIndices[i][j] = (j == 0u) ? 0u : index._linearIndices[i][j - 1];
+
+    return true;
+}
+
+inline bool
+buildIndex(TabixIndex & index, char const * filename, TabixIndex::Preset preset)
+{
+    setPreset(index, preset);
+    return buildIndex(index, filename);
+}
+
+// ----------------------------------------------------------------------------
+// Function read()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn TabixIndex#read
+ * @brief Load a TabixIndex from a <tt>.tbi</tt> file.
+ *
+ * @signature int read(index, filename);
+ *
+ * @param[out] index    The TabixIndex to load into.
+ * @param[in]  filename Path to the file to load, <tt>char const *</tt>.
+ *
+ * @return int Status code, 0 indicating success.
+ */
+
+/**
+.Function.TabixIndex#read
+..class:Class.TabixIndex
+..cat:Input/Output
+..signature:read(index, filename)
+..summary:Load a @Class.TabixIndex@ from a $.tbi$ file.
+..param.index:Target data structure.
+...type:Class.TabixIndex
+..param.filename:Path to file to load.
+...type:nolink:$char const *$
+..returns:$int$ status code, $0$ indicating success.
+..include:seqan/stream.h
+*/
+
+template <typename TValue>
+inline bool
+_tabixReadValue(TValue & value, Stream<Bgzf> & stream)
+{
+    return streamReadBlock(reinterpret_cast<char *>(&value), stream, sizeof(TValue)) == sizeof(TValue);
+}
+
+inline int
+read(TabixIndex & index, char const * filename)
+{
+    clear(index);
+
+    // The index file itself is BGZF compressed.
+    Stream<Bgzf> stream;
+    if (!open(stream, filename, "r"))
+        return 1;  // Could not open file.
+
+    // Read magic number and the column configuration.
+    char magic[4];
+    if (streamReadBlock(&magic[0], stream, 4) != 4 || memcmp(&magic[0], "TBI\1", 4) != 0)
+        return 1;  // Magic number is wrong.
+
+    __int32 nRef = 0;
+    __int32 lNames = 0;
+    if (!_tabixReadValue(nRef, stream) || !_tabixReadValue(index._format, stream) ||
+        !_tabixReadValue(index._colSeq, stream) || !_tabixReadValue(index._colBeg, stream) ||
+        !_tabixReadValue(index._colEnd, stream) || !_tabixReadValue(index._meta, stream) ||
+        !_tabixReadValue(index._skip, stream) || !_tabixReadValue(lNames, stream) || nRef < 0 || lNames < 0)
+        return 1;
+
+    // The sequence names are concatenated and '\0'-terminated.
+    CharString names;
+    resize(names, lNames);
+    if (lNames > 0 && streamReadBlock(&names[0], stream, lNames) != static_cast<size_t>(lNames))
+        return 1;
+    for (unsigned i = 0, nameBegin = 0; i < length(names); ++i)
+        if (names[i] == '\0')
+        {
+            appendValue(index._names, infix(names, nameBegin, i));
+            nameBegin = i + 1;
+        }
+    if (length(index._names) != static_cast<size_t>(nRef))
+        return 1;  // Wrong number of names.
+
+    resize(index._binIndices, nRef);
+    resize(index._linearIndices, nRef);
+    for (__int32 i = 0; i < nRef; ++i)  // For each sequence.
+    {
+        // Read bin index.
+        __int32 nBin = 0;
+        if (!_tabixReadValue(nBin, stream))
+            return 1;
+        TabixIndexBinData_ data;
+        for (__int32 j = 0; j < nBin; ++j)  // For each bin.
+        {
+            clear(data.chunkBegEnds);
+            __uint32 bin = 0;
+            __int32 nChunk = 0;
+            if (!_tabixReadValue(bin, stream) || !_tabixReadValue(nChunk, stream) || nChunk < 0)
+                return 1;
+            resize(data.chunkBegEnds, nChunk);
+            for (__int32 k = 0; k < nChunk; ++k)  // For each chunk.
+                if (!_tabixReadValue(data.chunkBegEnds[k].i1, stream) ||
+                    !_tabixReadValue(data.chunkBegEnds[k].i2, stream))
+                    return 1;
+            index._binIndices[i][bin] = data;
+        }
+
+        // Read linear index.
+        __int32 nIntv = 0;
+        if (!_tabixReadValue(nIntv, stream) || nIntv < 0)
+            return 1;
+        resize(index._linearIndices[i], nIntv);
+        for (__int32 j = 0; j < nIntv; ++j)
+            if (!_tabixReadValue(index._linearIndices[i][j], stream))
+                return 1;
+    }
+
+    // Read (optional) number of lines without coordinate.
+    __uint64 nNoCoord = 0;
+    if (_tabixReadValue(nNoCoord, stream))
+        index._unplacedCount = nNoCoord;
+
+    return 0;
+}
+
+// A char * argument would otherwise select the generic read() of file.h.
+
+inline int
+read(TabixIndex & index, char * filename)
+{
+    return read(index, static_cast<char const *>(filename));
+}
+
+// ----------------------------------------------------------------------------
+// Function write()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn TabixIndex#write
+ * @brief Write a TabixIndex to a <tt>.tbi</tt> file.
+ *
+ * @signature int write(index, filename);
+ *
+ * @param[in] index    The TabixIndex to write.
+ * @param[in] filename Path to the file to write to, <tt>char const *</tt>.
+ *
+ * @return int Status code, 0 indicating success.
+ */
+
+/**
+.Function.TabixIndex#write
+..class:Class.TabixIndex
+..cat:Input/Output
+..signature:write(index, filename)
+..summary:Write a @Class.TabixIndex@ to a $.tbi$ file.
+..param.index:The index to write.
+...type:Class.TabixIndex
+..param.filename:Path to the file to write.
+...type:nolink:$char const *$
+..returns:$int$ status code, $0$ indicating success.
+..include:seqan/stream.h
+*/
+
+template <typename TValue>
+inline void
+_tabixWriteValue(Stream<Bgzf> & stream, TValue value)
+{
+    streamWriteBlock(stream, reinterpret_cast<char const *>(&value), sizeof(TValue));
+}
+
+inline int
+_writeIndex(TabixIndex const & index, char const * filename)
+{
+    typedef TabixIndex::TBinIndex_::const_iterator TBinIndexIter;
+
+    // The index file itself is BGZF compressed.
+    Stream<Bgzf> stream;
+    if (!open(stream, filename, "w"))
+        return 1;  // Could not open file.
+
+    SEQAN_ASSERT_EQ(length(index._binIndices), length(index._linearIndices));
+    SEQAN_ASSERT_EQ(length(index._binIndices), length(index._names));
+
+    // Write header with the column configuration and the '\0'-terminated sequence names.
+    streamWriteBlock(stream, "TBI\1", 4);
+    _tabixWriteValue(stream, static_cast<__int32>(length(index._names)));
+    _tabixWriteValue(stream, index._format);
+    _tabixWriteValue(stream, index._colSeq);
+    _tabixWriteValue(stream, index._colBeg);
+    _tabixWriteValue(stream, index._colEnd);
+    _tabixWriteValue(stream, index._meta);
+    _tabixWriteValue(stream, index._skip);
+    __int32 lNames = 0;
+    for (unsigned i = 0; i < length(index._names); ++i)
+        lNames += length(index._names[i]) + 1;
+    _tabixWriteValue(stream, lNames);
+    for (unsigned i = 0; i < length(index._names); ++i)
+    {
+        streamWriteBlock(stream, begin(index._names[i], Standard()), length(index._names[i]));
+        streamWriteChar(stream, '\0');
+    }
+
+    for (unsigned i = 0; i < length(index._binIndices); ++i)
+    {
+        // Write out binning index.
+        _tabixWriteValue(stream, static_cast<__int32>(index._binIndices[i].size()));
+        for (TBinIndexIter itB = index._binIndices[i].begin(); itB != index._binIndices[i].end(); ++itB)
+        {
+            _tabixWriteValue(stream, itB->first);
+            _tabixWriteValue(stream, static_cast<__int32>(length(itB->second.chunkBegEnds)));
+            for (unsigned k = 0; k < length(itB->second.chunkBegEnds); ++k)
+            {
+                _tabixWriteValue(stream, itB->second.chunkBegEnds[k].i1);
+                _tabixWriteValue(stream, itB->second.chunkBegEnds[k].i2);
+            }
+        }
+
+        // Write out linear index.
+        _tabixWriteValue(stream, static_cast<__int32>(length(index._linearIndices[i])));
+        for (unsigned j = 0; j < length(index._linearIndices[i]); ++j)
+            _tabixWriteValue(stream, index._linearIndices[i][j]);
+    }
+
+    // Write the number of lines without coordinate if set.
+    if (index._unplacedCount != maxValue<__uint64>())
+        _tabixWriteValue(stream, index._unplacedCount);
+
+    int res = streamError(stream);
+    close(stream);
+    return res != 0;  // 1 on error, 0 on success.
+}
+
+inline int
+write(TabixIndex const & index, char const * filename)
+{
+    return _writeIndex(index, filename);
+}
+
+// The non-const overloads are only here because of the generic write() functions in the file module.
+
+inline int
+write(TabixIndex & index, char const * filename)
+{
+    return _writeIndex(index, filename);
+}
+
+inline int
+write(TabixIndex & index, char * filename)
+{
+    return _writeIndex(index, filename);
+}
+
+// ----------------------------------------------------------------------------
+// Function jumpToRegion()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn TabixIndex#jumpToRegion
+ * @brief Seek in a BGZF compressed file to the first line overlapping a region.
+ *
+ * @signature bool jumpToRegion(stream, hasEntries, refId, pos, posEnd, index);
+ *
+ * @param[in,out] stream     The @link BgzfStream @endlink to seek in.
+ * @param[out]    hasEntries A <tt>bool</tt> that is set to <tt>true</tt> if there are lines overlapping the region.
+ * @param[in]     refId      The id of the sequence in the index (<tt>__int32</tt>), see
+ *                           @link TabixIndex#getIdByName @endlink.
+ * @param[in]     pos        The 0-based begin of the region.
+ * @param[in]     posEnd     The 0-based end of the region (exclusive).
+ * @param[in]     index      The TabixIndex of the file.
+ *
+ * @return bool <tt>true</tt> if seeking was successful, <tt>false</tt> if not.
+ *
+ * @section Remarks
+ *
+ * Only the BGZF blocks of the bins and windows overlapping the region are read.  The stream is positioned at the
+ * first overlapping line, the following lines can begin behind <tt>posEnd</tt> or end before <tt>pos</tt>, so reading
+ * should stop at the first line beginning behind the region.
+ */
+
+/**
+.Function.TabixIndex#jumpToRegion
+..class:Class.TabixIndex
+..cat:Input/Output
+..signature:jumpToRegion(bgzfStream, hasEntries, refId, pos, posEnd, index)
+..summary:Seek in a BGZF compressed file to the first line overlapping a region.
+..param.bgzfStream:The BGZF Stream to seek in.
+...type:Spec.BGZF Stream
+..param.hasEntries:Set to $true$ iff there are lines overlapping the region.
+...type:nolink:$bool$
+..param.refId:The id of the sequence in the index, see @Function.TabixIndex#getIdByName@.
+...type:nolink:$__int32$
+..param.pos:Zero-based begin position of the region.
+...type:nolink:$__int32$
+..param.posEnd:Zero-based (exclusive, C-style) end position of the region.
+...type:nolink:$__int32$
+..param.index:The index of the file.
+...type:Class.TabixIndex
+..returns:$bool$ indicating success.
+..remarks:Only the BGZF blocks of the bins and windows overlapping the region are read.
+The stream is positioned at the first overlapping line, the following lines can begin behind $posEnd$ or end before $pos$, so reading should stop at the first line beginning behind the region.
+..include:seqan/stream.h
+*/
+
+inline bool
+jumpToRegion(Stream<Bgzf> & stream,
+             bool & hasEntries,
+             __int32 refId,
+             __int32 pos,
+             __int32 posEnd,
+             TabixIndex const & index)
+{
+    typedef TabixIndex::TBinIndex_::const_iterator TBinIndexIter;
+
+    hasEntries = false;
+    if (refId < 0 || static_cast<unsigned>(refId) >= length(index._binIndices))
+        return false;  // Cannot seek to invalid sequence.
+    pos = std::max(pos, 0);
+    if (pos >= posEnd)
+        return true;  // Empty region.
+
+    // Retrieve the smallest required offset from the linear index, lines before it end before pos.
+    TabixIndex::TLinearIndex_ const & linearIndex = index._linearIndices[refId];
+    unsigned windowIdx = pos >> TabixIndex::TBX_LIDX_SHIFT;
+    __uint64 linearMinOffset = 0;
+    if (windowIdx < length(linearIndex))
+        linearMinOffset = linearIndex[windowIdx];
+    else if (!empty(linearIndex))
+        linearMinOffset = back(linearIndex);
+
+    // The smallest offset of a chunk of the candidate bins that is not before linearMinOffset.
+    String<__uint32> candidateBins;
+    _tabixReg2bins(candidateBins, pos, posEnd);
+    __uint64 offset = maxValue<__uint64>();
+    for (unsigned i = 0; i < length(candidateBins); ++i)
+    {
+        TBinIndexIter it = index._binIndices[refId].find(candidateBins[i]);
+        if (it == index._binIndices[refId].end())
+            continue;  // Candidate is not in index.
+        for (unsigned j = 0; j < length(it->second.chunkBegEnds); ++j)
+            if (it->second.chunkBegEnds[j].i2 > linearMinOffset)
+                offset = std::min(offset, std::max(it->second.chunkBegEnds[j].i1, linearMinOffset));
+    }
+    if (offset == maxValue<__uint64>())
+        return true;  // No lines in the region.
+
+    // Scan to the first overlapping line, the lines are sorted by begin position.
+    if (streamSeek(stream, offset, SEEK_SET) != 0)
+        return false;  // Error while seeking.
+    CharString line;
+    char const * nameBegin = 0;
+    char const * nameEnd = 0;
+    __int32 beginPos = 0;
+    __int32 endPos = 0;
+    for (__uint64 lineOffset = offset; _tabixReadLine(line, stream) == 0; lineOffset = streamTell(stream))
+    {
+        if (_tabixIsHeaderLine(line, maxValue<__uint64>(), index))
+            continue;
+        if (!_tabixParseLine(nameBegin, nameEnd, beginPos, endPos, line, index))
+            return false;  // Invalid line.
+        if (index._names[refId] != infix(line, nameBegin - begin(line, Standard()), nameEnd - begin(line, Standard())))
+            break;  // Behind the sequence.
+        if (beginPos >= posEnd)
+            break;  // Behind the region.
+        if (endPos <= pos)
+            continue;  // Before the region.
+
+        // Found the first overlapping line.
+        hasEntries = true;
+        return streamSeek(stream, lineOffset, SEEK_SET) == 0;
+    }
+
+    // Finding no overlapping line is not an error, hasEntries is false.
+    return streamError(stream) == 0;
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef CORE_INCLUDE_SEQAN_STREAM_TABIX_INDEX_H_
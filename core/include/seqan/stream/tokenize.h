@@ -40,6 +40,12 @@
 #define SEQAN_STREAM_TOKENIZE_H
 
 #include <cctype>
+#include <cstring>
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define SEQAN_TOKENIZE_SSE2 1
+#endif
 
 namespace seqan {
 
@@ -347,6 +353,178 @@ _charCompare(int const c, TabOrLineBreak_ const & /* tag*/)
 //TODO(h4nn3s): add for AminoAcid and Rna-tags
 
 
+// ----------------------------------------------------------------------------
+// Function _tokenizeFind*() [scan a buffer span]
+// ----------------------------------------------------------------------------
+
+// The tokenizers below scan the unread part of the record reader's buffer as a
+// whole, append the scanned span at once and only leave the span at buffer
+// boundaries.  The _tokenizeFind*() functions return the first position in
+// [first, last) where the tokenizer stops or last if there is none.
+
+template <typename TTagSpec>
+inline char const *
+_tokenizeFind(char const * first, char const * last, Tag<TTagSpec> const & tag, bool const desiredOutcomeOfComparison)
+{
+    for (; first != last; ++first)
+        if (bool(_charCompare(*first, tag)) == desiredOutcomeOfComparison)
+            break;
+    return first;
+}
+
+inline char const *
+_tokenizeFindChar(char const * first, char const * last, char c)
+{
+    char const * it = static_cast<char const *>(std::memchr(first, c, last - first));
+    return (it != NULL)? it : last;
+}
+
+// Compares blocks of 16 characters with SSE2 if available.
+inline char const *
+_tokenizeFindOneOf(char const * first, char const * last, char c1, char c2, char c3, char c4, char c5)
+{
+#ifdef SEQAN_TOKENIZE_SSE2
+    __m128i const v1 = _mm_set1_epi8(c1);
+    __m128i const v2 = _mm_set1_epi8(c2);
+    __m128i const v3 = _mm_set1_epi8(c3);
+    __m128i const v4 = _mm_set1_epi8(c4);
+    __m128i const v5 = _mm_set1_epi8(c5);
+    for (; last - first >= 16; first += 16)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const *>(first));
+        __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, v1), _mm_cmpeq_epi8(block, v2)),
+                                    _mm_or_si128(_mm_cmpeq_epi8(block, v3), _mm_cmpeq_epi8(block, v4)));
+        int mask = _mm_movemask_epi8(_mm_or_si128(hits, _mm_cmpeq_epi8(block, v5)));
+        if (mask != 0)
+            return first + __builtin_ctz(mask);
+    }
+#endif
+    for (; first != last; ++first)
+        if (*first == c1 || *first == c2 || *first == c3 || *first == c4 || *first == c5)
+            break;
+    return first;
+}
+
+inline char const *
+_tokenizeFind(char const * first, char const * last, UnixEOL_ const & tag, bool const desiredOutcomeOfComparison)
+{
+    if (desiredOutcomeOfComparison)
+        return _tokenizeFindChar(first, last, '\n');
+    return _tokenizeFind<UnixEOL__>(first, last, tag, false);
+}
+
+inline char const *
+_tokenizeFind(char const * first, char const * last, TabOrLineBreak_ const & tag, bool const desiredOutcomeOfComparison)
+{
+    if (desiredOutcomeOfComparison)
+        return _tokenizeFindOneOf(first, last, '\t', '\r', '\n', '\n', '\n');
+    return _tokenizeFind<TabOrLineBreak__>(first, last, tag, false);
+}
+
+// Stops on the first character of a tag class.
+template <typename TTag>
+struct TokenizeFindTag_
+{
+    bool desiredOutcomeOfComparison;
+
+    explicit
+    TokenizeFindTag_(bool desiredOutcomeOfComparison) :
+        desiredOutcomeOfComparison(desiredOutcomeOfComparison)
+    {}
+
+    inline char const * operator()(char const * first, char const * last) const
+    {
+        return _tokenizeFind(first, last, TTag(), desiredOutcomeOfComparison);
+    }
+};
+
+// Stops on one of up to five characters.
+struct TokenizeFindOneOf_
+{
+    char c1, c2, c3, c4, c5;
+    bool single;
+
+    explicit
+    TokenizeFindOneOf_(char c1) :
+        c1(c1), c2(c1), c3(c1), c4(c1), c5(c1), single(true)
+    {}
+
+    TokenizeFindOneOf_(char c1, char c2, char c3 = 0, char c4 = 0, char c5 = 0) :
+        c1(c1), c2(c2), c3(c3), c4(c4), c5(c5), single(false)
+    {
+        // Pad unused characters with a used one.
+        if (c3 == 0) this->c3 = c2;
+        if (c4 == 0) this->c4 = this->c3;
+        if (c5 == 0) this->c5 = this->c4;
+    }
+
+    inline char const * operator()(char const * first, char const * last) const
+    {
+        if (single)
+            return _tokenizeFindChar(first, last, c1);
+        return _tokenizeFindOneOf(first, last, c1, c2, c3, c4, c5);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Function _tokenizeAppend()
+// ----------------------------------------------------------------------------
+
+template <typename TBuffer>
+inline void
+_tokenizeAppend(TBuffer & buffer, char const * first, char const * last)
+{
+    if (first == last)
+        return;
+    typename Size<TBuffer>::Type oldLength = length(buffer);
+    resize(buffer, oldLength + (last - first), Generous());
+    std::copy(first, last, begin(buffer, Standard()) + oldLength);
+}
+
+// ----------------------------------------------------------------------------
+// Function _readSpans(), _skipSpans()
+// ----------------------------------------------------------------------------
+
+// Read until find() stops within the current buffer.
+template <typename TBuffer, typename TRecordReader, typename TFind>
+inline int
+_readSpans(TBuffer & buffer, TRecordReader & reader, TFind const & find)
+{
+    while (!atEnd(reader))
+    {
+        char const * first = _bufferBegin(reader);
+        char const * last = _bufferEnd(reader);
+        char const * it = find(first, last);
+        _tokenizeAppend(buffer, first, it);
+        if (it != first)
+            _advanceBuffer(reader, it - first);
+        if (it != last)
+            return 0;
+        if (resultCode(reader) != 0)
+            return resultCode(reader);
+    }
+    return EOF_BEFORE_SUCCESS;
+}
+
+template <typename TRecordReader, typename TFind>
+inline int
+_skipSpans(TRecordReader & reader, TFind const & find)
+{
+    while (!atEnd(reader))
+    {
+        char const * first = _bufferBegin(reader);
+        char const * last = _bufferEnd(reader);
+        char const * it = find(first, last);
+        if (it != first)
+            _advanceBuffer(reader, it - first);
+        if (it != last)
+            return 0;
+        if (resultCode(reader) != 0)
+            return resultCode(reader);
+    }
+    return EOF_BEFORE_SUCCESS;
+}
+
 // ----------------------------------------------------------------------------
 // Function _readHelper() [other read functions use this]
 // ----------------------------------------------------------------------------
@@ -358,23 +536,11 @@ template <typename TTagSpec, // specialization of character comparison
 inline int
 _readHelper(TBuffer & buffer,
             TRecordReader & reader,
-            Tag<TTagSpec> const & tag,
+            Tag<TTagSpec> const & /*tag*/,
             bool const desiredOutcomeOfComparison) 
 /*   desired behaviour of loop -> "readUntil()" or "readwhile()"  */
 {
-    typedef char TChar;
-
-    while (!atEnd(reader))
-    {
-        TChar c = value(reader);
-        if (bool( _charCompare(c, tag)) == desiredOutcomeOfComparison)
-            return 0;
-        appendValue(buffer, c, Generous());
-        goNext(reader);
-        if (resultCode(reader) != 0)
-            return resultCode(reader);
-    }
-    return EOF_BEFORE_SUCCESS;
+    return _readSpans(buffer, reader, TokenizeFindTag_<Tag<TTagSpec> >(desiredOutcomeOfComparison));
 }
 
 template <typename TSpec, // specialization of character comparison
@@ -401,18 +567,30 @@ _readHelper(TBuffer & buffer,
             Tag<TTagSpec2> const & skipTag,
             bool const desiredOutcomeOfComparison)
 {
-    typedef char TChar;
-
     while (!atEnd(reader))
     {
-        TChar c = value(reader);
-        if (!_charCompare(c, skipTag))
+        char const * first = _bufferBegin(reader);
+        char const * last = _bufferEnd(reader);
+        char const * runBegin = first;
+        char const * it = first;
+
+        // append runs of characters between ignored ones
+        for (; it != last; ++it)
         {
-            if (bool (_charCompare(c, compTag)) == desiredOutcomeOfComparison)
-                return 0;
-            appendValue(buffer, c, Generous());
+            if (_charCompare(*it, skipTag))
+            {
+                _tokenizeAppend(buffer, runBegin, it);
+                runBegin = it + 1;
+            }
+            else if (bool (_charCompare(*it, compTag)) == desiredOutcomeOfComparison)
+                break;
         }
-        goNext(reader);
+        _tokenizeAppend(buffer, runBegin, it);
+
+        if (it != first)
+            _advanceBuffer(reader, it - first);
+        if (it != last)
+            return 0;
         if (resultCode(reader) != 0)
             return resultCode(reader);
     }
@@ -444,21 +622,10 @@ _readHelper(TBuffer & buffer,
 template <typename TTagSpec, typename TRecordReader>
 inline int
 _skipHelper(TRecordReader & reader,
-            Tag<TTagSpec> const & tag,
+            Tag<TTagSpec> const & /*tag*/,
             bool const desiredOutcomeOfComparison)
 {
-    typedef char TChar;
-
-    while (!atEnd(reader))
-    {
-        TChar c = value(reader);
-        if (bool(_charCompare(c, tag)) == desiredOutcomeOfComparison)
-            return 0;
-        goNext(reader);
-        if (resultCode(reader) != 0)
-            return resultCode(reader);
-    }
-    return EOF_BEFORE_SUCCESS;
+    return _skipSpans(reader, TokenizeFindTag_<Tag<TTagSpec> >(desiredOutcomeOfComparison));
 }
 
 
@@ -482,16 +649,21 @@ _countHelper(unsigned & count,
             Tag<TTagSpec> const & tag,
             bool const desiredOutcomeOfComparison)
 {
-    typedef char TChar;
     count = 0;
 
     while (!atEnd(reader))
     {
-        TChar c = value(reader);
-        count++;
-        if (bool(_charCompare(c, tag)) == desiredOutcomeOfComparison)
+        char const * first = _bufferBegin(reader);
+        char const * last = _bufferEnd(reader);
+        char const * it = _tokenizeFind(first, last, tag, desiredOutcomeOfComparison);
+        count += it - first;
+        if (it != first)
+            _advanceBuffer(reader, it - first);
+        if (it != last)
+        {
+            count++;    // the character we stop on is counted as well
             return 0;
-        goNext(reader);
+        }
         if (resultCode(reader) != 0)
             return resultCode(reader);
     }
@@ -519,18 +691,25 @@ _countHelper(unsigned & count,
             bool const desiredOutcomeOfComparison)
 {
     count = 0;
-    typedef char TChar;
 
     while (!atEnd(reader))
     {
-        TChar c = value(reader);
-        if (!_charCompare(c, skipTag))
+        char const * first = _bufferBegin(reader);
+        char const * last = _bufferEnd(reader);
+        char const * it = first;
+        for (; it != last; ++it)
         {
-            if (bool (_charCompare(c, compTag)) == desiredOutcomeOfComparison)
-                return 0;
-            ++count;
+            if (!_charCompare(*it, skipTag))
+            {
+                if (bool (_charCompare(*it, compTag)) == desiredOutcomeOfComparison)
+                    break;
+                ++count;
+            }
         }
-        goNext(reader);
+        if (it != first)
+            _advanceBuffer(reader, it - first);
+        if (it != last)
+            return 0;
         if (resultCode(reader) != 0)
             return resultCode(reader);
     }
@@ -634,85 +813,35 @@ template <typename TBuffer, typename TStream, typename TPass>
 inline int
 readUntilOneOf(TBuffer & buffer, RecordReader<TStream, TPass> & reader, char c1)
 {
-    while (!atEnd(reader))
-    {
-        char c = value(reader);
-        if (c == c1)
-            return 0;
-        appendValue(buffer, c, Generous());
-        goNext(reader);
-        if (resultCode(reader) != 0)
-            return resultCode(reader);
-    }
-    return EOF_BEFORE_SUCCESS;
+    return _readSpans(buffer, reader, TokenizeFindOneOf_(c1));
 }
 
 template <typename TBuffer, typename TStream, typename TPass>
 inline int
 readUntilOneOf(TBuffer & buffer, RecordReader<TStream, TPass> & reader, char c1, char c2)
 {
-    while (!atEnd(reader))
-    {
-        char c = value(reader);
-        if (c == c1 || c == c2)
-            return 0;
-        appendValue(buffer, c, Generous());
-        goNext(reader);
-        if (resultCode(reader) != 0)
-            return resultCode(reader);
-    }
-    return EOF_BEFORE_SUCCESS;
+    return _readSpans(buffer, reader, TokenizeFindOneOf_(c1, c2));
 }
 
 template <typename TBuffer, typename TStream, typename TPass>
 inline int
 readUntilOneOf(TBuffer & buffer, RecordReader<TStream, TPass> & reader, char c1, char c2, char c3)
 {
-    while (!atEnd(reader))
-    {
-        char c = value(reader);
-        if (c == c1 || c == c2 || c == c3)
-            return 0;
-        appendValue(buffer, c, Generous());
-        goNext(reader);
-        if (resultCode(reader) != 0)
-            return resultCode(reader);
-    }
-    return EOF_BEFORE_SUCCESS;
+    return _readSpans(buffer, reader, TokenizeFindOneOf_(c1, c2, c3));
 }
 
 template <typename TBuffer, typename TStream, typename TPass>
 inline int
 readUntilOneOf(TBuffer & buffer, RecordReader<TStream, TPass> & reader, char c1, char c2, char c3, char c4)
 {
-    while (!atEnd(reader))
-    {
-        char c = value(reader);
-        if (c == c1 || c == c2 || c == c3 || c == c4)
-            return 0;
-        appendValue(buffer, c, Generous());
-        goNext(reader);
-        if (resultCode(reader) != 0)
-            return resultCode(reader);
-    }
-    return EOF_BEFORE_SUCCESS;
+    return _readSpans(buffer, reader, TokenizeFindOneOf_(c1, c2, c3, c4));
 }
 
 template <typename TBuffer, typename TStream, typename TPass>
 inline int
 readUntilOneOf(TBuffer & buffer, RecordReader<TStream, TPass> & reader, char c1, char c2, char c3, char c4, char c5)
 {
-    while (!atEnd(reader))
-    {
-        char c = value(reader);
-        if (c == c1 || c == c2 || c == c3 || c == c4 || c == c5)
-            return 0;
-        appendValue(buffer, c, Generous());
-        goNext(reader);
-        if (resultCode(reader) != 0)
-            return resultCode(reader);
-    }
-    return EOF_BEFORE_SUCCESS;
+    return _readSpans(buffer, reader, TokenizeFindOneOf_(c1, c2, c3, c4, c5));
 }
 
 /*!
@@ -875,19 +1004,7 @@ readUntilChar(TBuffer & buffer,
               TCharX const & x)
 {
     SEQAN_CHECKPOINT
-    typedef char TChar;
-
-    while (!atEnd(reader))
-    {
-        TChar c = value(reader);
-        if (c == x)
-            return 0;
-        appendValue(buffer, c, Generous());
-        goNext(reader);
-        if (resultCode(reader) != 0)
-            return resultCode(reader);
-    }
-    return EOF_BEFORE_SUCCESS;
+    return _readSpans(buffer, reader, TokenizeFindOneOf_(x));
 }
 
 /*!
@@ -1335,18 +1452,7 @@ skipUntilChar(RecordReader<TStream, TPass> & reader,
               TCharX const & x)
 {
     SEQAN_CHECKPOINT
-    typedef char TChar;
-
-    while (!atEnd(reader))
-    {
-        TChar c = value(reader);
-        if (c == x)
-            return 0;
-        goNext(reader);
-        if (resultCode(reader) != 0)
-            return resultCode(reader);
-    }
-    return EOF_BEFORE_SUCCESS;
+    return _skipSpans(reader, TokenizeFindOneOf_(x));
 }
 
 /*!
@@ -2010,6 +2116,10 @@ readLine(TBuffer & buffer, RecordReader<TStream, TPass> & reader)
 {
     int r = 0;
 
+    // Copy the line up to its end in blocks, then handle the line break below.
+    if ((r = _readSpans(buffer, reader, TokenizeFindOneOf_('\r', '\n'))) != 0)
+        return r;
+
     // Loop over characters from stream, taking early exits on line breaks and errors.
     while (!atEnd(reader))
     {
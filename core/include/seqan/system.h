@@ -56,6 +56,7 @@
 #include <semaphore.h>
 #include <aio.h>
 #include <sys/mman.h>
+#include <sys/time.h>
 
 #ifndef O_LARGEFILE
 #define O_LARGEFILE 0
@@ -80,12 +81,14 @@
 #include <seqan/system/system_sema.h>
 #include <seqan/system/system_event.h>
 #include <seqan/system/system_thread.h>
+#include <seqan/system/system_queue.h>
 
 //____________________________________________________________________________
 // synchronous and asynchronous files
 
 #include <seqan/system/file_sync.h>
 #include <seqan/system/file_async.h>
+#include <seqan/system/file_pread.h>
 #include <seqan/system/file_directory.h>
 
 #endif //#ifndef SEQAN_HEADER_...
@@ -87,6 +87,11 @@ namespace SEQAN_NAMESPACE_MAIN
             handle(INVALID_HANDLE_VALUE) {}
 
         bool open(char const *fileName, int openMode = DefaultOpenMode<File>::VALUE) {
+			if (openMode & OPEN_SHARED_MEMORY) {
+				if (!(openMode & OPEN_QUIET))
+					std::cerr << "Open failed on " << fileName << ". (Shared memory objects are not supported)" << std::endl;
+				return false;
+			}
 			SEQAN_PROADD(SEQAN_PROOPENFILES, 1);
             noBuffering = (getExtraFlags(openMode | OPEN_ASYNC) & (FILE_FLAG_NO_BUFFERING | FILE_FLAG_OVERLAPPED)) != 0;
             handleAsync = CreateFileA(fileName,
@@ -671,7 +676,7 @@ namespace SEQAN_NAMESPACE_MAIN
         virtual ~File() {}
         
         bool open(char const *fileName, int openMode = DefaultOpenMode<File>::VALUE) {
-            handle = ::open(fileName, Base::_getOFlag(openMode & ~OPEN_ASYNC), S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+            handle = Base::_openHandle(fileName, openMode & ~OPEN_ASYNC);
 			if (handle == -1) 
 			{
 				handleAsync = handle;
@@ -680,7 +685,7 @@ namespace SEQAN_NAMESPACE_MAIN
 				return false;
 			}
 
-			if (Base::_getOFlag(openMode | OPEN_ASYNC) & O_DIRECT) 
+			if (!(openMode & OPEN_SHARED_MEMORY) && (Base::_getOFlag(openMode | OPEN_ASYNC) & O_DIRECT)) 
 			{
 				handleAsync = ::open(fileName, Base::_getOFlag(openMode | (OPEN_ASYNC & ~OPEN_CREATE)), S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
 				if (handleAsync == -1 || errno == EINVAL) {	// fall back to cached access
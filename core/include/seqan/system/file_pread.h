@@ -0,0 +1,519 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Asynchronous file whose requests are served by a pool of worker threads
+// using pread() and pwrite().
+// ==========================================================================
+
+//SEQAN_NO_GENERATED_FORWARDS: no forwards are generated for this file
+
+#ifndef SEQAN_HEADER_FILE_PREAD_H
+#define SEQAN_HEADER_FILE_PREAD_H
+
+namespace SEQAN_NAMESPACE_MAIN
+{
+
+/*!
+ * @class PReadAsyncFile PReadAsync File
+ * @extends File
+ * @headerfile <seqan/file.h>
+ * @brief Asynchronous file that serves its requests by a pool of threads.
+ *
+ * @signature template <[typename TSpec]>
+ *            class File<PReadAsync<TSpec> >;
+ *
+ * @section Remarks
+ *
+ * Asynchronous reads and writes (see @link File#asyncReadAt @endlink) are queued and carried out by worker threads
+ * with <tt>pread</tt> and <tt>pwrite</tt>.  In contrast to the POSIX aio of <tt>File&lt;Async&lt;&gt; &gt;</tt>, several
+ * requests are in flight at the same time which keeps the device queue filled when an External String prefetches many
+ * pages.  The threads are started with the first request and stopped when the file is closed.  Use
+ * @link PReadAsyncFile#setNumThreads @endlink to change the number of threads (default: 4).
+ *
+ * This file is only available on POSIX systems.
+ */
+
+/**
+.Spec.PReadAsync:
+..cat:Files
+..general:Class.File
+..summary:Asynchronous file that serves its requests by a pool of threads.
+..signature:File<PReadAsync<TSpec> >
+..param.TSpec:Subspecialization tag.
+...default:$void$
+..remarks:Asynchronous reads and writes (see @Function.asyncReadAt@) are queued and carried out by worker threads
+with $pread$ and $pwrite$. In contrast to the POSIX aio of @Spec.Async@, several requests are in flight at the same time
+which keeps the device queue filled when an @Spec.External String@ prefetches many pages.
+The threads are started with the first request and stopped when the file is closed.
+..remarks:This file is only available on POSIX systems.
+..include:seqan/file.h
+*/
+
+	template <typename TSpec = void>
+	struct PReadAsync;
+
+#ifndef PLATFORM_WINDOWS
+
+    struct PReadAsyncPool_;
+
+    //////////////////////////////////////////////////////////////////////////////
+    // request of a PReadAsync file (plays the role of aiocb)
+
+    struct PReadAsyncRequest
+    {
+        enum State { IDLE, QUEUED, IN_PROGRESS, DONE };
+
+        PReadAsyncPool_     *pool;
+        int                 handle;
+        bool                write;
+        char                *buffer;
+        size_t              nbytes;     // 0 .. no transfer pending
+        off_t               offset;
+        int                 errorNo;    // errno of the failed transfer, 0 on success
+        State               state;
+
+        PReadAsyncRequest():
+            pool(NULL),
+            handle(-1),
+            write(false),
+            buffer(NULL),
+            nbytes(0),
+            offset(0),
+            errorNo(0),
+            state(IDLE) {}
+    };
+
+    // transfer all bytes of a request, returns the errno on failure or 0
+    inline int _preadAsyncTransfer(PReadAsyncRequest &request)
+    {
+        char *buffer = request.buffer;
+        size_t rest = request.nbytes;
+        off_t offset = request.offset;
+        while (rest != 0)
+        {
+            ssize_t result;
+            if (request.write)
+                result = ::pwrite(request.handle, buffer, rest, offset);
+            else
+                result = ::pread(request.handle, buffer, rest, offset);
+
+            if (result < 0)
+            {
+                if (errno == EINTR) continue;
+                return errno;
+            }
+            if (result == 0)
+                return EIO;                 // unexpected end of file
+            buffer += result;
+            offset += result;
+            rest -= result;
+        }
+        return 0;
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    // queue of requests and the worker threads serving it
+
+    struct PReadAsyncWorker_
+    {
+        PReadAsyncPool_ *pool;
+
+        PReadAsyncWorker_(PReadAsyncPool_ &_pool):
+            pool(&_pool) {}
+
+        inline void run(Thread<PReadAsyncWorker_> *);
+    };
+
+    struct PReadAsyncPool_
+    {
+        typedef Thread<PReadAsyncWorker_> TThread;
+
+        ConcurrentQueue<PReadAsyncRequest *>    queue;
+        Mutex                                   mutex;      // guards the states of the requests
+        Event                                   done;       // signaled when a request was completed
+        String<TThread *>                       threads;
+
+        PReadAsyncPool_():
+            mutex(false),
+            done(false) {}
+    };
+
+    inline void PReadAsyncWorker_::run(Thread<PReadAsyncWorker_> *)
+    {
+        PReadAsyncRequest *request = NULL;
+        while (popFront(request, pool->queue))
+        {
+            lock(pool->mutex);
+            request->state = PReadAsyncRequest::IN_PROGRESS;
+            unlock(pool->mutex);
+
+            SEQAN_PROTIMESTART(tw);
+            int errorNo = _preadAsyncTransfer(*request);
+            SEQAN_PROADD(SEQAN_PROCWAIT, SEQAN_PROTIMEDIFF(tw));
+
+            lock(pool->mutex);
+            request->errorNo = errorNo;
+            request->state = PReadAsyncRequest::DONE;
+            signal(pool->done);
+            unlock(pool->mutex);
+            markProcessed(pool->queue);
+        }
+    }
+
+    inline bool _startWorkers(PReadAsyncPool_ &pool, unsigned numThreads)
+    {
+        for (unsigned i = 0; i < numThreads; ++i)
+        {
+            PReadAsyncPool_::TThread *thread = new PReadAsyncPool_::TThread(pool);
+            if (!run(*thread))
+            {
+                delete thread;
+                return i != 0;              // at least one thread is required
+            }
+            appendValue(pool.threads, thread);
+        }
+        return true;
+    }
+
+    // serve all remaining requests and join the worker threads
+    inline void _stopWorkers(PReadAsyncPool_ &pool)
+    {
+        close(pool.queue);
+        for (unsigned i = 0; i < length(pool.threads); ++i)
+        {
+            waitFor(*pool.threads[i]);
+            delete pool.threads[i];
+        }
+        clear(pool.threads);
+    }
+
+    // wait until request is done, the mutex of the pool is held before and after
+    inline void _waitForDone(PReadAsyncPool_ &pool, PReadAsyncRequest &request)
+    {
+        while (request.state != PReadAsyncRequest::DONE)
+        {
+            reset(pool.done);
+            unlock(pool.mutex);
+            waitFor(pool.done);
+            lock(pool.mutex);
+        }
+    }
+
+	template <typename TSpec>
+    class File<PReadAsync<TSpec> > : public File<Sync<TSpec> >
+    {
+    public:
+
+        typedef File<Sync<TSpec> >  Base;
+
+        typedef off_t			FilePtr;
+		typedef off_t           SizeType;   // type of file size
+        typedef size_t          SizeType_;  // type of transfer size (for read or write)
+		typedef int				Handle;
+
+        PReadAsyncPool_ *pool;              // created with the first asynchronous request
+        unsigned        numThreads;
+
+		using Base::handle;
+
+		File(void * = NULL): 	// to be compatible with the FILE*(NULL) constructor
+            pool(NULL),
+            numThreads(4) {}
+
+        // copies share the file handle but not the worker threads
+        File(File const &other):
+            Base(other),
+            pool(NULL),
+            numThreads(other.numThreads) {}
+
+        inline File & operator=(File const &other)
+        {
+            Base::operator=(other);
+            numThreads = other.numThreads;
+            return *this;
+        }
+
+        virtual ~File()
+        {
+            _closePool();
+        }
+
+        inline PReadAsyncPool_ * _getPool()
+        {
+            if (!pool)
+            {
+                pool = new PReadAsyncPool_;
+                if (!_startWorkers(*pool, _max(numThreads, 1u)))
+                {
+                    delete pool;
+                    pool = NULL;
+                }
+            }
+            return pool;
+        }
+
+        inline void _closePool()
+        {
+            if (pool)
+            {
+                _stopWorkers(*pool);
+                delete pool;
+                pool = NULL;
+            }
+        }
+
+        virtual bool close()
+        {
+            _closePool();
+            return Base::close();
+        }
+    };
+
+
+    //////////////////////////////////////////////////////////////////////////////
+    // (SeqAn adaption)
+    //////////////////////////////////////////////////////////////////////////////
+
+	template <typename TSpec>
+    struct AsyncRequest<File<PReadAsync<TSpec> > >
+    {
+		typedef PReadAsyncRequest Type;
+    };
+
+/*!
+ * @fn PReadAsyncFile#setNumThreads
+ * @brief Set the number of worker threads of a PReadAsync File.
+ *
+ * @signature void setNumThreads(file, numThreads);
+ *
+ * @param[in,out] file       The File to configure.
+ * @param[in]     numThreads The number of threads serving the requests.  Takes effect when the threads are started
+ *                           with the next request after the file was opened.
+ */
+
+/**
+.Function.setNumThreads:
+..signature:setNumThreads(file, numThreads)
+..param.file:A PReadAsync file.
+...type:Spec.PReadAsync
+..param.numThreads:The number of threads serving the requests.
+Takes effect when the threads are started with the next request after the file was opened.
+..include:seqan/file.h
+*/
+
+    template <typename TSpec>
+    inline void setNumThreads(File<PReadAsync<TSpec> > &me, unsigned numThreads)
+    {
+        me.numThreads = numThreads;
+    }
+
+    template <typename TSpec>
+    inline bool _asyncTransferAt(File<PReadAsync<TSpec> > & me, char *memPtr, size_t nbytes, off_t fileOfs,
+        bool write, PReadAsyncRequest &request)
+    {
+        request.handle = me.handle;
+        request.write = write;
+        request.buffer = memPtr;
+        request.nbytes = nbytes;
+        request.offset = fileOfs;
+        request.errorNo = 0;
+        request.state = PReadAsyncRequest::DONE;
+        if (nbytes == 0) return true;
+
+		SEQAN_PROADD(SEQAN_PROIO, (nbytes + SEQAN_PROPAGESIZE - 1) / SEQAN_PROPAGESIZE);
+        PReadAsyncPool_ *pool = me._getPool();
+        if (!pool)
+        {
+            // transfer synchronously instead
+            request.pool = NULL;
+            request.errorNo = _preadAsyncTransfer(request);
+            errno = request.errorNo;
+            return request.errorNo == 0;
+        }
+
+        request.pool = pool;
+        lock(pool->mutex);
+        request.state = PReadAsyncRequest::QUEUED;
+        unlock(pool->mutex);
+        PReadAsyncRequest *queued = &request;
+        pushBack(pool->queue, queued);
+        return true;
+    }
+
+    template < typename TSpec, typename TValue, typename TSize, typename TPos >
+    inline bool asyncReadAt(File<PReadAsync<TSpec> > & me, TValue *memPtr, TSize const count, TPos const fileOfs,
+        PReadAsyncRequest &request)
+    {
+        return _asyncTransferAt(me, (char *)memPtr, count * sizeof(TValue), (off_t)fileOfs * (off_t)sizeof(TValue),
+                                false, request);
+    }
+
+    template < typename TSpec, typename TValue, typename TSize, typename TPos >
+    inline bool asyncWriteAt(File<PReadAsync<TSpec> > & me, const TValue *memPtr, TSize const count,
+        TPos const fileOfs, PReadAsyncRequest &request)
+    {
+        return _asyncTransferAt(me, (char *)const_cast<TValue *>(memPtr), count * sizeof(TValue),
+                                (off_t)fileOfs * (off_t)sizeof(TValue), true, request);
+    }
+
+	template <typename TSpec>
+    inline bool flush(File<PReadAsync<TSpec> > & me)
+    {
+		#if _POSIX_SYNCHRONIZED_IO > 0
+			return fdatasync(me.handle) == 0;
+		#else
+			return fsync(me.handle) == 0;
+		#endif
+    }
+
+    //////////////////////////////////////////////////////////////////////
+    // queue specific functions
+
+    inline bool _preadAsyncResult(PReadAsyncRequest &request)
+    {
+        if (request.errorNo != 0)
+        {
+            errno = request.errorNo;
+            std::cerr << "Asynchronous I/O operation failed (waitFor): \"" << ::strerror(request.errorNo) << '"'
+                      << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+	inline bool waitFor(PReadAsyncRequest &request)
+    {
+		if (request.nbytes == 0) return true;
+        if (request.pool != NULL)
+        {
+            PReadAsyncPool_ &pool = *request.pool;
+            SEQAN_PROTIMESTART(tw);
+            lock(pool.mutex);
+            _waitForDone(pool, request);
+            unlock(pool.mutex);
+            SEQAN_PROADD(SEQAN_PROCWAIT, SEQAN_PROTIMEDIFF(tw));
+        }
+        return _preadAsyncResult(request);
+	}
+
+	inline bool waitFor(PReadAsyncRequest &request, long timeoutMilliSec, bool &inProgress)
+    {
+		if (request.nbytes == 0 || request.pool == NULL)
+        {
+            inProgress = false;
+            return _preadAsyncResult(request);
+        }
+
+        PReadAsyncPool_ &pool = *request.pool;
+        lock(pool.mutex);
+        if (request.state != PReadAsyncRequest::DONE && timeoutMilliSec != 0)
+        {
+            SEQAN_PROTIMESTART(tw);
+            double deadline = sysTime() + timeoutMilliSec / 1000.0;
+            while (request.state != PReadAsyncRequest::DONE)
+            {
+                long rest = (long)((deadline - sysTime()) * 1000.0);
+                if (rest <= 0)
+                    break;
+                reset(pool.done);
+                unlock(pool.mutex);
+                bool timedOut;
+                waitFor(pool.done, rest, timedOut);
+                lock(pool.mutex);
+            }
+            SEQAN_PROADD(SEQAN_PROCWAIT, SEQAN_PROTIMEDIFF(tw));
+        }
+        inProgress = (request.state != PReadAsyncRequest::DONE);
+        unlock(pool.mutex);
+
+        if (inProgress)
+            return true;
+        return _preadAsyncResult(request);
+	}
+
+    // dequeue a pending request, a request that is already in progress is waited for
+	template <typename TSpec>
+    inline bool cancel(File<PReadAsync<TSpec> > & /*me*/, PReadAsyncRequest &request)
+    {
+		if (request.nbytes == 0 || request.pool == NULL) return true;
+
+        PReadAsyncPool_ &pool = *request.pool;
+        lock(pool.mutex);
+        if (request.state == PReadAsyncRequest::QUEUED && removeValue(pool.queue, &request))
+        {
+            request.state = PReadAsyncRequest::DONE;
+            request.errorNo = ECANCELED;
+        }
+        _waitForDone(pool, request);
+        unlock(pool.mutex);
+        return true;
+    }
+
+	template <typename TSpec>
+    inline void release(File<PReadAsync<TSpec> > & /*me*/, PReadAsyncRequest const & /*request*/)
+    {
+    }
+
+    template < typename TSpec, typename TSize >
+    inline void resize(File<PReadAsync<TSpec> > &me, TSize new_length)
+    {
+		if (!me.resize(new_length))
+            SEQAN_FAIL(
+                "resize(%d, %d) failed: \"%s\"",
+                me.handle, new_length, strerror(errno));
+    }
+
+    //////////////////////////////////////////////////////////////////////////////
+    // global functions
+
+	template <typename TSpec>
+    struct Size< File<PReadAsync<TSpec> > >
+    {
+        typedef typename File<PReadAsync<TSpec> >::SizeType Type;
+    };
+
+	template <typename TSpec>
+    struct Position< File<PReadAsync<TSpec> > >
+    {
+        typedef typename File<PReadAsync<TSpec> >::FilePtr Type;
+    };
+
+	template <typename TSpec>
+    struct Difference< File<PReadAsync<TSpec> > >
+    {
+        typedef typename File<PReadAsync<TSpec> >::FilePtr Type;
+    };
+
+#endif  // #ifndef PLATFORM_WINDOWS
+
+}
+
+#endif
@@ -130,6 +130,11 @@ namespace SEQAN_NAMESPACE_MAIN
 
         bool open(char const *fileName, int openMode = DefaultOpenMode<File>::VALUE) 
 		{
+			if (openMode & OPEN_SHARED_MEMORY) {
+				if (!(openMode & OPEN_QUIET))
+					::std::cerr << "Open failed on " << fileName << ". (Shared memory objects are not supported)" << ::std::endl;
+				return false;
+			}
             handle = _open(fileName, _getOFlag(openMode), _S_IREAD | _S_IWRITE);
 			if (handle == -1) {
 				if (!(openMode & OPEN_QUIET))
@@ -272,14 +277,26 @@ namespace SEQAN_NAMESPACE_MAIN
 			return result;
         }
 
+        // Shared memory objects only support O_RDONLY or O_RDWR combined with O_CREAT and O_TRUNC.
+        inline int _openHandle(char const *fileName, int openMode) const {
+            if (openMode & OPEN_SHARED_MEMORY)
+            {
+                int oflag = ((openMode & OPEN_MASK) == OPEN_RDONLY)? O_RDONLY: O_RDWR;
+                if (openMode & OPEN_CREATE)     oflag |= O_CREAT;
+                if ((openMode & OPEN_MASK) != OPEN_RDONLY && !(openMode & OPEN_APPEND))  oflag |= O_TRUNC;
+                return ::shm_open(fileName, oflag, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+            }
+            return ::open(fileName, _getOFlag(openMode), S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+        }
+
         virtual bool open(char const *fileName, int openMode = DefaultOpenMode<File>::VALUE) {
-            handle = ::open(fileName, _getOFlag(openMode), S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
-			if (handle == -1 && errno == EINVAL) {	// fall back to cached access
+            handle = _openHandle(fileName, openMode);
+			if (handle == -1 && errno == EINVAL && !(openMode & OPEN_SHARED_MEMORY)) {	// fall back to cached access
 	            #ifdef SEQAN_DEBUG_OR_TEST_
 					if (!(openMode & OPEN_QUIET))
 						::std::cerr << "Warning: Direct access openening failed: " << fileName << "." << ::std::endl;
 				#endif			
-          	    handle = ::open(fileName, _getOFlag(openMode & ~OPEN_ASYNC), S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+          	    handle = _openHandle(fileName, openMode & ~OPEN_ASYNC);
 			}
 			
 			if (handle == -1) {
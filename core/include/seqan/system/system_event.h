@@ -144,11 +144,6 @@ struct Event        // this class mustn't exceed the size of HANDLE (needed by w
 //////////////////////////////////////////////////////////////////////////////
 // global event functions
 
-inline void reset(Event & e)
-{
-    e.reset();
-}
-
 inline bool waitForAll(Event eventList[], DWORD count, DWORD timeoutMilliSec)
 {
     return WaitForMultipleObjects(count, &eventList[0].hEvent, true, timeoutMilliSec) != WAIT_TIMEOUT;
@@ -176,17 +171,22 @@ inline int waitForAny(Event eventList[], DWORD count)
 
 #else
 
+// Manual-reset event, signal() releases all waiting threads and the event stays signaled until reset() is called.
+
 struct Event :
     public Mutex
 {
     typedef pthread_cond_t * Handle;
     enum {Infinite = LONG_MAX};
     pthread_cond_t data, * hEvent;
+    bool signaled;
+    unsigned generation;    // incremented by signal() to release the threads waiting at that moment
 
     Event() :
-        hEvent(NULL) {}
+        hEvent(NULL), signaled(false), generation(0) {}
 
-    Event(bool initial)
+    Event(bool initial) :
+        signaled(false), generation(0)
     {
         SEQAN_DO_SYS(open(initial));
     }
@@ -200,7 +200,7 @@ struct Event :
     // TODO(weese): Change c'tor the rvalue refs
     //Event(Event const &&origin):
     Event(Event const & origin) :
-        Mutex()
+        Mutex(), signaled(origin.signaled), generation(origin.generation)
     {
         // resource sharing is not yet supported (performance reason)
         // it needs a reference counting technique
@@ -218,6 +218,8 @@ struct Event :
     {
         // resource sharing is not yet supported (performance reason)
         // it needs a reference counting technique
+        signaled = origin.signaled;
+        generation = origin.generation;
         if (origin)
         {
             data = origin.data;
@@ -231,6 +233,7 @@ struct Event :
 
     inline bool open(bool initial = false)
     {
+        signaled = false;
         if (Mutex::open() && pthread_cond_init(&data, NULL) == 0 && (hEvent = &data))
         {
             if (initial)
@@ -255,31 +258,60 @@ struct Event :
         if (!hEvent) return true;
 
         Mutex::lock();
-        return pthread_cond_wait(hEvent, Mutex::hMutex) == 0;
+        unsigned gen = generation;
+        int result = 0;
+        while (!signaled && gen == generation && result == 0)
+            result = pthread_cond_wait(hEvent, Mutex::hMutex);
+        Mutex::unlock();
+        return result == 0;
     }
 
     inline bool wait(long timeoutMilliSec, bool & inProgress)
     {
-        if (timeoutMilliSec != Infinite)
-        {
-            timespec ts;
-            ts.tv_sec = timeoutMilliSec / 1000;
-            ts.tv_nsec = (timeoutMilliSec % 1000) * 1000;
-            Mutex::lock();
-            int result = pthread_cond_timedwait(hEvent, Mutex::hMutex, &ts);
-            inProgress = (result == ETIMEDOUT);
-            return result == 0 || inProgress;
-        }
-        else
+        if (timeoutMilliSec == Infinite || !hEvent)
         {
             inProgress = false;
             return wait();
         }
+
+        // pthread_cond_timedwait expects an absolute time
+        timeval now;
+        gettimeofday(&now, NULL);
+        timespec ts;
+        ts.tv_sec = now.tv_sec + timeoutMilliSec / 1000;
+        ts.tv_nsec = now.tv_usec * 1000 + (timeoutMilliSec % 1000) * 1000000;
+        if (ts.tv_nsec >= 1000000000)
+        {
+            ts.tv_sec += 1;
+            ts.tv_nsec -= 1000000000;
+        }
+
+        Mutex::lock();
+        unsigned gen = generation;
+        int result = 0;
+        while (!signaled && gen == generation && result == 0)
+            result = pthread_cond_timedwait(hEvent, Mutex::hMutex, &ts);
+        inProgress = (result == ETIMEDOUT);
+        Mutex::unlock();
+        return result == 0 || inProgress;
     }
 
     inline bool signal()
     {
-        return pthread_cond_broadcast(hEvent) == 0;
+        Mutex::lock();
+        signaled = true;
+        ++generation;
+        bool success = (pthread_cond_broadcast(hEvent) == 0);
+        Mutex::unlock();
+        return success;
+    }
+
+    inline bool reset()
+    {
+        Mutex::lock();
+        signaled = false;
+        Mutex::unlock();
+        return true;
     }
 
     inline operator bool() const
@@ -337,6 +369,11 @@ inline bool signal(Event & e)
     return e.signal();
 }
 
+inline bool reset(Event & e)
+{
+    return e.reset();
+}
+
 /*
     //////////////////////////////////////////////////////////////////////////////
     // emulate events in a singlethreaded environment
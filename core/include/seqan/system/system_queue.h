@@ -0,0 +1,230 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// FIFO of values handed over between threads, built on Mutex and Event.
+// ==========================================================================
+
+//SEQAN_NO_GENERATED_FORWARDS: no forwards are generated for this file
+
+#ifndef SEQAN_HEADER_SYSTEM_QUEUE_H
+#define SEQAN_HEADER_SYSTEM_QUEUE_H
+
+namespace SEQAN_NAMESPACE_MAIN
+{
+
+    //////////////////////////////////////////////////////////////////////////////
+    // FIFO shared by producer and consumer threads
+    //
+    // pushBack() blocks while the queue holds capacity values (a capacity of 0
+    // lets the queue grow), popFront() blocks while the queue is empty.  Values
+    // are swapped in and out, so strings are handed over without copying them.
+    // After close() no more values are accepted and popFront() fails as soon as
+    // the queue is empty.  A consumer reports each popped value with
+    // markProcessed(), waitForProcessed() waits until all values are processed.
+
+    template <typename TValue>
+    struct ConcurrentQueue
+    {
+//IOREV _notio_
+        String<TValue>  data;           // ring buffer, data[head] is the oldest value
+        size_t          capacity;
+        size_t          head;
+        size_t          size;
+        size_t          unprocessed;    // values pushed but not marked as processed yet
+        bool            closed;
+
+        Mutex           mutex;
+        Event           notEmpty;       // signaled while the queue is non-empty or closed
+        Event           notFull;        // signaled while the queue is not full or closed
+        Event           processed;      // signaled while all values are processed
+
+        ConcurrentQueue(size_t _capacity = 0):
+            capacity(_capacity),
+            head(0),
+            size(0),
+            unprocessed(0),
+            closed(false),
+            mutex(false),
+            notEmpty(false),
+            notFull(true),
+            processed(true)
+        {
+            resize(data, (capacity != 0) ? capacity : 16);
+        }
+
+    private:
+
+        ConcurrentQueue(ConcurrentQueue const &);
+        ConcurrentQueue & operator=(ConcurrentQueue const &);
+    };
+
+    // update the events to the state of the queue, the mutex must be held
+    template <typename TValue>
+    inline void _updateEvents(ConcurrentQueue<TValue> &me)
+    {
+        if (me.size != 0 || me.closed) me.notEmpty.signal(); else me.notEmpty.reset();
+        if (me.size != me.capacity || me.closed) me.notFull.signal(); else me.notFull.reset();
+        if (me.unprocessed == 0) me.processed.signal(); else me.processed.reset();
+    }
+
+    // wait until ready is signaled, the mutex is held before and after
+    template <typename TValue>
+    inline void _waitFor(ConcurrentQueue<TValue> &me, Event &ready)
+    {
+        me.mutex.unlock();
+        ready.wait();
+        me.mutex.lock();
+    }
+
+    // double the ring buffer of a queue without capacity
+    template <typename TValue>
+    inline void _grow(ConcurrentQueue<TValue> &me)
+    {
+        using std::swap;
+        String<TValue> tmp;
+        resize(tmp, 2 * length(me.data));
+        for (size_t i = 0; i < me.size; ++i)
+            swap(tmp[i], me.data[(me.head + i) % length(me.data)]);
+        swap(me.data, tmp);
+        me.head = 0;
+    }
+
+
+	//////////////////////////////////////////////////////////////////////////////
+	// global queue functions
+
+    // swap value into the queue, returns false if the queue was closed
+    template <typename TValue>
+    inline bool pushBack(ConcurrentQueue<TValue> &me, TValue &value)
+    {
+        using std::swap;
+        me.mutex.lock();
+        while (me.capacity != 0 && me.size == me.capacity && !me.closed)
+            _waitFor(me, me.notFull);
+        if (me.closed)
+        {
+            me.mutex.unlock();
+            return false;
+        }
+        if (me.size == length(me.data))
+            _grow(me);
+        swap(me.data[(me.head + me.size) % length(me.data)], value);
+        ++me.size;
+        ++me.unprocessed;
+        _updateEvents(me);
+        me.mutex.unlock();
+        return true;
+    }
+
+    // swap the oldest value out of the queue, returns false if the queue is closed and empty
+    template <typename TValue>
+    inline bool popFront(TValue &value, ConcurrentQueue<TValue> &me)
+    {
+        using std::swap;
+        me.mutex.lock();
+        while (me.size == 0 && !me.closed)
+            _waitFor(me, me.notEmpty);
+        if (me.size == 0)
+        {
+            me.mutex.unlock();
+            return false;
+        }
+        swap(value, me.data[me.head]);
+        me.head = (me.head + 1) % length(me.data);
+        --me.size;
+        _updateEvents(me);
+        me.mutex.unlock();
+        return true;
+    }
+
+    // remove the first occurrence of value that was not popped yet, returns false if there is none
+    template <typename TValue>
+    inline bool removeValue(ConcurrentQueue<TValue> &me, TValue const &value)
+    {
+        using std::swap;
+        me.mutex.lock();
+        size_t i = 0;
+        while (i < me.size && !(me.data[(me.head + i) % length(me.data)] == value))
+            ++i;
+        bool found = (i < me.size);
+        if (found)
+        {
+            for (; i + 1 < me.size; ++i)
+                swap(me.data[(me.head + i) % length(me.data)], me.data[(me.head + i + 1) % length(me.data)]);
+            --me.size;
+            --me.unprocessed;
+            _updateEvents(me);
+        }
+        me.mutex.unlock();
+        return found;
+    }
+
+    template <typename TValue>
+    inline bool empty(ConcurrentQueue<TValue> &me)
+    {
+        me.mutex.lock();
+        bool result = (me.size == 0);
+        me.mutex.unlock();
+        return result;
+    }
+
+    // refuse further values and wake up all waiting threads
+    template <typename TValue>
+    inline void close(ConcurrentQueue<TValue> &me)
+    {
+        me.mutex.lock();
+        me.closed = true;
+        _updateEvents(me);
+        me.mutex.unlock();
+    }
+
+    template <typename TValue>
+    inline void markProcessed(ConcurrentQueue<TValue> &me)
+    {
+        me.mutex.lock();
+        --me.unprocessed;
+        _updateEvents(me);
+        me.mutex.unlock();
+    }
+
+    // wait until all values pushed so far are popped and marked as processed
+    template <typename TValue>
+    inline void waitForProcessed(ConcurrentQueue<TValue> &me)
+    {
+        me.mutex.lock();
+        while (me.unprocessed != 0)
+            _waitFor(me, me.processed);
+        me.mutex.unlock();
+    }
+
+}
+
+#endif
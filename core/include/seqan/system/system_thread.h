@@ -58,10 +58,12 @@ namespace SEQAN_NAMESPACE_MAIN
         DWORD  hThreadID;
         Worker worker;
 
-        Thread() {}
+        Thread():
+            hThread(NULL) {}
 
         template <typename TArg>
         Thread(TArg &arg):
+            hThread(NULL),
             worker(arg) {}
 
         ~Thread() {
@@ -92,7 +94,10 @@ namespace SEQAN_NAMESPACE_MAIN
         }
 
         inline bool wait(DWORD timeoutMilliSec = INFINITE) {
-            return WaitForSingleObject(hThread, timeoutMilliSec) != WAIT_TIMEOUT;
+            if (WaitForSingleObject(hThread, timeoutMilliSec) == WAIT_TIMEOUT) return false;
+            CloseHandle(hThread);       // the thread has finished
+            hThread = NULL;
+            return true;
         }
 
         inline operator bool() const {
@@ -107,7 +112,8 @@ namespace SEQAN_NAMESPACE_MAIN
         }
 
         static DWORD WINAPI _start(LPVOID _this) {
-            reinterpret_cast<Thread*>(_this)->worker.run(&reinterpret_cast<Thread*>(_this));
+            Thread *me = reinterpret_cast<Thread*>(_this);
+            me->worker.run(me);
 			return 0;	// return value should indicate success/failure
         }
     };
@@ -123,10 +129,12 @@ namespace SEQAN_NAMESPACE_MAIN
         pthread_t data, *hThread;
         Worker worker;
 
-        Thread() {}
+        Thread():
+            hThread(NULL) {}
 
         template <typename TArg>
         Thread(TArg &arg):
+            hThread(NULL),
             worker(arg) {}
 
         ~Thread() {
@@ -145,7 +153,7 @@ namespace SEQAN_NAMESPACE_MAIN
         }
 
         inline bool close() {
-            return cancel() && wait() && !(hThread == NULL);
+            return cancel() && wait();
         }
 
         inline bool cancel() {
@@ -153,11 +161,15 @@ namespace SEQAN_NAMESPACE_MAIN
         }
 
         inline bool wait() {
-            return !(pthread_join(data, NULL));
+            if (pthread_join(data, NULL)) return false;
+            hThread = NULL;             // the thread has finished
+            return true;
         }
 
         inline bool wait(void* &retVal) {
-            return !(pthread_join(data, &retVal));
+            if (pthread_join(data, &retVal)) return false;
+            hThread = NULL;
+            return true;
         }
 
         inline bool detach() {
@@ -176,7 +188,8 @@ namespace SEQAN_NAMESPACE_MAIN
         }
 
         static void* _start(void* _this) {
-            reinterpret_cast<Thread*>(_this)->worker.run(&reinterpret_cast<Thread*>(_this));
+            Thread *me = reinterpret_cast<Thread*>(_this);
+            me->worker.run(me);
 			return 0;
         }
     };
@@ -0,0 +1,177 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Tests for the lazy BAM alignment record views.
+// ==========================================================================
+
+#ifndef CORE_TESTS_BAM_IO_TEST_BAM_ALIGNMENT_RECORD_VIEW_H_
+#define CORE_TESTS_BAM_IO_TEST_BAM_ALIGNMENT_RECORD_VIEW_H_
+
+#include <seqan/basic.h>
+#include <seqan/sequence.h>
+
+#include <seqan/bam_io.h>
+
+// Read file with readRecord() and with readBatch() using the given batch size and compare the records.
+
+void testBamIOBamAlignmentRecordViewReadBatch(char const * pathFragment, unsigned batchSize)
+{
+    using namespace seqan;
+
+    typedef StringSet<CharString>      TNameStore;
+    typedef NameStoreCache<TNameStore> TNameStoreCache;
+    typedef BamIOContext<TNameStore>   TBamIOContext;
+
+    CharString bamFilename;
+    append(bamFilename, SEQAN_PATH_TO_ROOT());
+    append(bamFilename, pathFragment);
+
+    String<BamAlignmentRecord> expected;
+    {
+        Stream<Bgzf> stream;
+        SEQAN_ASSERT(open(stream, toCString(bamFilename), "r"));
+        TNameStore nameStore;
+        TNameStoreCache nameStoreCache(nameStore);
+        TBamIOContext bamIOContext(nameStore, nameStoreCache);
+        BamHeader header;
+        SEQAN_ASSERT_EQ(readRecord(header, bamIOContext, stream, Bam()), 0);
+        BamAlignmentRecord record;
+        while (!atEnd(stream))
+        {
+            SEQAN_ASSERT_EQ(readRecord(record, bamIOContext, stream, Bam()), 0);
+            appendValue(expected, record);
+        }
+    }
+
+    Stream<Bgzf> stream;
+    SEQAN_ASSERT(open(stream, toCString(bamFilename), "r"));
+    TNameStore nameStore;
+    TNameStoreCache nameStoreCache(nameStore);
+    TBamIOContext bamIOContext(nameStore, nameStoreCache);
+    BamHeader header;
+    SEQAN_ASSERT_EQ(readRecord(header, bamIOContext, stream, Bam()), 0);
+
+    BamRecordViewBatch batch;
+    BamAlignmentRecord record;
+    CharString buffer;
+    String<CigarElement<> > cigar;
+    unsigned numRecords = 0;
+    while (!atEnd(stream))
+    {
+        SEQAN_ASSERT_EQ(readBatch(batch, bamIOContext, stream, batchSize, Bam()), 0);
+        SEQAN_ASSERT_GT(length(batch.views), 0u);
+        SEQAN_ASSERT_LEQ(length(batch.views), batchSize);
+
+        for (unsigned i = 0; i < length(batch.views); ++i, ++numRecords)
+        {
+            SEQAN_ASSERT_LT(numRecords, length(expected));
+            BamAlignmentRecordView const & view = batch.views[i];
+            BamAlignmentRecord const & expectedRecord = expected[numRecords];
+
+            // Fixed-size fields.
+            SEQAN_ASSERT_EQ(getRID(view), expectedRecord.rID);
+            SEQAN_ASSERT_EQ(getBeginPos(view), expectedRecord.beginPos);
+            SEQAN_ASSERT_EQ(getMapQ(view), expectedRecord.mapQ);
+            SEQAN_ASSERT_EQ(getBin(view), expectedRecord.bin);
+            SEQAN_ASSERT_EQ(getFlag(view), expectedRecord.flag);
+            SEQAN_ASSERT_EQ(getRNextId(view), expectedRecord.rNextId);
+            SEQAN_ASSERT_EQ(getPNext(view), expectedRecord.pNext);
+            SEQAN_ASSERT_EQ(getTLen(view), expectedRecord.tLen);
+            SEQAN_ASSERT_EQ(getSeqLength(view), static_cast<__int32>(length(expectedRecord.seq)));
+            SEQAN_ASSERT_EQ(hasFlagUnmapped(view), hasFlagUnmapped(expectedRecord));
+            SEQAN_ASSERT_EQ(getAlignmentLengthInRef(view), getAlignmentLengthInRef(expectedRecord));
+
+            // Lazily decoded fields.
+            getQName(buffer, view);
+            SEQAN_ASSERT_EQ(buffer, expectedRecord.qName);
+            getCigar(cigar, view);
+            SEQAN_ASSERT(cigar == expectedRecord.cigar);
+            getSeq(buffer, view);
+            SEQAN_ASSERT_EQ(buffer, expectedRecord.seq);
+            getQual(buffer, view);
+            SEQAN_ASSERT_EQ(buffer, expectedRecord.qual);
+            getTags(buffer, view);
+            SEQAN_ASSERT_EQ(buffer, expectedRecord.tags);
+
+            decodeRecord(record, view);
+            SEQAN_ASSERT_EQ(record.qName, expectedRecord.qName);
+            SEQAN_ASSERT_EQ(record.rID, expectedRecord.rID);
+            SEQAN_ASSERT_EQ(record.seq, expectedRecord.seq);
+            SEQAN_ASSERT_EQ(record.tags, expectedRecord.tags);
+        }
+    }
+    SEQAN_ASSERT_EQ(numRecords, length(expected));
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_alignment_record_view_read_batch_small)
+{
+    testBamIOBamAlignmentRecordViewReadBatch("/core/tests/bam_io/small.bam", 2);
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_alignment_record_view_read_batch_ex1)
+{
+    testBamIOBamAlignmentRecordViewReadBatch("/core/tests/bam_io/ex1.bam", 1000);
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_alignment_record_view_tags_dict)
+{
+    using namespace seqan;
+
+    CharString bamFilename;
+    append(bamFilename, SEQAN_PATH_TO_ROOT());
+    append(bamFilename, "/core/tests/bam_io/ex1.bam");
+
+    Stream<Bgzf> stream;
+    SEQAN_ASSERT(open(stream, toCString(bamFilename), "r"));
+    StringSet<CharString> nameStore;
+    NameStoreCache<StringSet<CharString> > nameStoreCache(nameStore);
+    BamIOContext<StringSet<CharString> > bamIOContext(nameStore, nameStoreCache);
+    BamHeader header;
+    SEQAN_ASSERT_EQ(readRecord(header, bamIOContext, stream, Bam()), 0);
+
+    BamRecordViewBatch batch;
+    SEQAN_ASSERT_EQ(readBatch(batch, bamIOContext, stream, 1, Bam()), 0);
+    SEQAN_ASSERT_EQ(length(batch.views), 1u);
+
+    // The first record of ex1.bam has the tags MF:i:18, Aq:i:73, NM:i:0, UQ:i:0, H0:i:1, and H1:i:0.
+    CharString tags;
+    getTags(tags, batch.views[0]);
+    BamTagsDict tagsDict(tags);
+    SEQAN_ASSERT_EQ(length(tagsDict), 6u);
+    SEQAN_ASSERT_EQ(getTagKey(tagsDict, 0), "MF");
+    unsigned idx = 0;
+    SEQAN_ASSERT(findTagKey(idx, tagsDict, "NM"));
+    __int32 value = -1;
+    SEQAN_ASSERT(extractTagValue(value, tagsDict, idx));
+    SEQAN_ASSERT_EQ(value, 0);
+}
+
+#endif  // CORE_TESTS_BAM_IO_TEST_BAM_ALIGNMENT_RECORD_VIEW_H_
@@ -85,4 +85,241 @@ SEQAN_DEFINE_TEST(test_bam_io_bam_index_bai)
     SEQAN_ASSERT_NOT(found);
 }
 
+SEQAN_DEFINE_TEST(test_bam_io_bam_index_build_bai)
+{
+    using namespace seqan;
+
+    CharString bamFilename;
+    append(bamFilename, SEQAN_PATH_TO_ROOT());
+    append(bamFilename, "/core/tests/bam_io/small.bam");
+    CharString baiFilename = bamFilename;
+    append(baiFilename, ".bai");
+
+    BamIndex<Bai> expected;
+    SEQAN_ASSERT_EQ(read(expected, toCString(baiFilename)), 0);
+
+    // Build with the given number of threads and compare to samtools' index.
+    for (unsigned numThreads = 1; numThreads <= 2; ++numThreads)
+    {
+        BamIndex<Bai> baiIndex;
+        SEQAN_ASSERT(buildIndex(baiIndex, toCString(bamFilename), numThreads));
+
+        SEQAN_ASSERT_EQ(getUnalignedCount(baiIndex), getUnalignedCount(expected));
+        SEQAN_ASSERT_EQ(length(baiIndex._binIndices), length(expected._binIndices));
+        SEQAN_ASSERT(baiIndex._linearIndices == expected._linearIndices);
+        for (unsigned i = 0; i < length(expected._binIndices); ++i)
+        {
+            SEQAN_ASSERT_EQ(baiIndex._binIndices[i].size(), expected._binIndices[i].size());
+            typedef BamIndex<Bai>::TBinIndex_::const_iterator TIter;
+            for (TIter it = expected._binIndices[i].begin(); it != expected._binIndices[i].end(); ++it)
+            {
+                TIter it2 = baiIndex._binIndices[i].find(it->first);
+                SEQAN_ASSERT(it2 != baiIndex._binIndices[i].end());
+                SEQAN_ASSERT(it2->second.chunkBegEnds == it->second.chunkBegEnds);
+            }
+        }
+    }
+
+    // Write the built index and read it back in.
+    BamIndex<Bai> baiIndex;
+    SEQAN_ASSERT(buildIndex(baiIndex, toCString(bamFilename)));
+    CharString tmpFilename = SEQAN_TEMP_FILENAME();
+    SEQAN_ASSERT_EQ(write(baiIndex, toCString(tmpFilename)), 0);
+
+    BamIndex<Bai> baiIndex2;
+    SEQAN_ASSERT_EQ(read(baiIndex2, toCString(tmpFilename)), 0);
+    SEQAN_ASSERT_EQ(getUnalignedCount(baiIndex2), getUnalignedCount(baiIndex));
+    SEQAN_ASSERT(baiIndex2._linearIndices == baiIndex._linearIndices);
+    SEQAN_ASSERT_EQ(baiIndex2._binIndices[0].size(), baiIndex._binIndices[0].size());
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_index_region_chunks)
+{
+    using namespace seqan;
+
+    typedef StringSet<CharString>              TNameStore;
+    typedef NameStoreCache<TNameStore>         TNameStoreCache;
+    typedef BamIOContext<TNameStore>           TBamIOContext;
+
+    CharString bamFilename;
+    append(bamFilename, SEQAN_PATH_TO_ROOT());
+    append(bamFilename, "/core/tests/bam_io/ex1.bam");
+
+    BamIndex<Bai> baiIndex;
+    SEQAN_ASSERT(buildIndex(baiIndex, toCString(bamFilename), 2));
+
+    // Read all placed records sequentially.
+    String<BamAlignmentRecord> expected;
+    {
+        Stream<Bgzf> stream;
+        SEQAN_ASSERT(open(stream, toCString(bamFilename), "r"));
+        TNameStore nameStore;
+        TNameStoreCache nameStoreCache(nameStore);
+        TBamIOContext bamIOContext(nameStore, nameStoreCache);
+        BamHeader header;
+        SEQAN_ASSERT_EQ(readRecord(header, bamIOContext, stream, Bam()), 0);
+        BamAlignmentRecord record;
+        while (!atEnd(stream))
+        {
+            SEQAN_ASSERT_EQ(readRecord(record, bamIOContext, stream, Bam()), 0);
+            if (record.rID >= 0)
+                appendValue(expected, record);
+        }
+    }
+
+    // Both references of ex1.bam fit into one 16kb window, so there is one chunk per reference.
+    String<BamRegionChunk> computedChunks;
+    computeRegionChunks(computedChunks, baiIndex, 4);
+    SEQAN_ASSERT_EQ(length(computedChunks), 2u);
+    SEQAN_ASSERT_EQ(computedChunks[0].rID, 0);
+    SEQAN_ASSERT_EQ(computedChunks[0].beginPos, 0);
+    SEQAN_ASSERT_EQ(computedChunks[0].endPos, 1 << 29);
+    SEQAN_ASSERT_EQ(computedChunks[1].rID, 1);
+
+    // Split the chunks further to test borders inside references.
+    String<BamRegionChunk> chunks;
+    for (unsigned i = 0; i < length(computedChunks); ++i)
+    {
+        appendValue(chunks, BamRegionChunk(computedChunks[i].rID, 0, 500));
+        appendValue(chunks, BamRegionChunk(computedChunks[i].rID, 500, 501));
+        appendValue(chunks, BamRegionChunk(computedChunks[i].rID, 501, 1000));
+        appendValue(chunks, BamRegionChunk(computedChunks[i].rID, 1000, computedChunks[i].endPos));
+    }
+
+    // Iterating over all chunks yields the same records in the same order.
+    unsigned numRecords = 0;
+    for (unsigned i = 0; i < length(chunks); ++i)
+    {
+        if (i > 0u && chunks[i].rID == chunks[i - 1].rID)
+            SEQAN_ASSERT_EQ(chunks[i].beginPos, chunks[i - 1].endPos);
+
+        Stream<Bgzf> stream;
+        SEQAN_ASSERT(open(stream, toCString(bamFilename), "r"));
+        TNameStore nameStore;
+        TNameStoreCache nameStoreCache(nameStore);
+        TBamIOContext bamIOContext(nameStore, nameStoreCache);
+        BamHeader header;
+        SEQAN_ASSERT_EQ(readRecord(header, bamIOContext, stream, Bam()), 0);
+
+        bool hasAlignments = false;
+        SEQAN_ASSERT(jumpToRegionChunk(stream, hasAlignments, bamIOContext, chunks[i], baiIndex));
+        if (!hasAlignments)
+            continue;
+
+        BamAlignmentRecord record;
+        bool hasRecord = true;
+        while (true)
+        {
+            SEQAN_ASSERT_EQ(readRegionChunkRecord(record, hasRecord, bamIOContext, stream, chunks[i]), 0);
+            if (!hasRecord)
+                break;
+            SEQAN_ASSERT_LT(numRecords, length(expected));
+            SEQAN_ASSERT_EQ(record.qName, expected[numRecords].qName);
+            SEQAN_ASSERT_EQ(record.rID, expected[numRecords].rID);
+            SEQAN_ASSERT_EQ(record.beginPos, expected[numRecords].beginPos);
+            ++numRecords;
+        }
+    }
+    SEQAN_ASSERT_EQ(numRecords, length(expected));
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_index_region_chunks_unmapped_reference)
+{
+    using namespace seqan;
+
+    typedef StringSet<CharString>              TNameStore;
+    typedef NameStoreCache<TNameStore>         TNameStoreCache;
+    typedef BamIOContext<TNameStore>           TBamIOContext;
+    typedef BamHeader::TSequenceInfo           TSequenceInfo;
+
+    // Write a BAM file whose second reference only has unmapped records placed next to their mates.
+    CharString bamFilename = SEQAN_TEMP_FILENAME();
+    append(bamFilename, ".bam");
+    {
+        TNameStore nameStore;
+        TNameStoreCache nameStoreCache(nameStore);
+        TBamIOContext bamIOContext(nameStore, nameStoreCache);
+        BamHeader header;
+        BamHeaderRecord firstRecord;
+        firstRecord.type = BAM_HEADER_FIRST;
+        appendValue(firstRecord.tags, BamHeaderRecord::TTag("VN", "1.0"));
+        appendValue(firstRecord.tags, BamHeaderRecord::TTag("SO", "coordinate"));
+        appendValue(header.records, firstRecord);
+        char const * refNames[3] = { "chr1", "chr2", "chr3" };
+        for (unsigned i = 0; i < 3u; ++i)
+        {
+            appendValue(nameStore, refNames[i]);
+            appendValue(header.sequenceInfos, TSequenceInfo(refNames[i], 100000));
+        }
+        refresh(nameStoreCache);
+
+        Stream<Bgzf> stream;
+        SEQAN_ASSERT(open(stream, toCString(bamFilename), "w"));
+        SEQAN_ASSERT_EQ(write2(stream, header, bamIOContext, Bam()), 0);
+
+        __int32 const rIDs[8] = { 0, 0, 0, 1, 1, 2, 2, BamAlignmentRecord::INVALID_REFID };
+        __int32 const positions[8] = { 10, 20000, 40000, 100, 200, 50, 70, BamAlignmentRecord::INVALID_POS };
+        for (unsigned i = 0; i < 8u; ++i)
+        {
+            BamAlignmentRecord record;
+            record.qName = "READ";
+            appendValue(record.qName, static_cast<char>('0' + i));
+            record.rID = rIDs[i];
+            record.beginPos = positions[i];
+            record.seq = "CGATCGATAA";
+            record.qual = "IIIIIIIIII";
+            record.flag = BAM_FLAG_UNMAPPED;
+            if (rIDs[i] == 0 || rIDs[i] == 2)
+            {
+                record.flag = 0;
+                appendValue(record.cigar, CigarElement<>('M', 10));
+            }
+            SEQAN_ASSERT_EQ(write2(stream, record, bamIOContext, Bam()), 0);
+        }
+    }
+
+    BamIndex<Bai> baiIndex;
+    SEQAN_ASSERT(buildIndex(baiIndex, toCString(bamFilename), 2));
+    SEQAN_ASSERT_EQ(length(baiIndex._linearIndices), 3u);
+    SEQAN_ASSERT(empty(baiIndex._linearIndices[1]));
+
+    // The reference without alignments gets no chunk, the following one is chunked as usual.
+    String<BamRegionChunk> chunks;
+    computeRegionChunks(chunks, baiIndex, 8);
+    SEQAN_ASSERT_GEQ(length(chunks), 2u);
+    SEQAN_ASSERT_EQ(front(chunks).rID, 0);
+    SEQAN_ASSERT_EQ(back(chunks).rID, 2);
+    for (unsigned i = 0; i < length(chunks); ++i)
+        SEQAN_ASSERT_NEQ(chunks[i].rID, 1);
+
+    // Each alignment is read in exactly one chunk.
+    __int32 const expectedPositions[5] = { 10, 20000, 40000, 50, 70 };
+    unsigned numAlignments = 0;
+    for (unsigned i = 0; i < length(chunks); ++i)
+    {
+        Stream<Bgzf> stream;
+        SEQAN_ASSERT(open(stream, toCString(bamFilename), "r"));
+        TNameStore nameStore;
+        TNameStoreCache nameStoreCache(nameStore);
+        TBamIOContext bamIOContext(nameStore, nameStoreCache);
+        BamHeader header;
+        SEQAN_ASSERT_EQ(readRecord(header, bamIOContext, stream, Bam()), 0);
+
+        bool hasRecord = false;
+        SEQAN_ASSERT(jumpToRegionChunk(stream, hasRecord, bamIOContext, chunks[i], baiIndex));
+        BamAlignmentRecord record;
+        while (hasRecord)
+        {
+            SEQAN_ASSERT_EQ(readRegionChunkRecord(record, hasRecord, bamIOContext, stream, chunks[i]), 0);
+            if (!hasRecord)
+                break;
+            SEQAN_ASSERT_NOT(hasFlagUnmapped(record));
+            SEQAN_ASSERT_LT(numAlignments, 5u);
+            SEQAN_ASSERT_EQ(record.beginPos, expectedPositions[numAlignments]);
+            ++numAlignments;
+        }
+    }
+    SEQAN_ASSERT_EQ(numAlignments, 5u);
+}
+
 #endif  // CORE_TESTS_BAM_IO_TEST_BAM_INDEX_H_
@@ -45,6 +45,7 @@
 #if SEQAN_HAS_ZLIB
 #include "test_read_bam.h"
 #include "test_write_bam.h"
+#include "test_bam_alignment_record_view.h"
 #include "test_bam_index.h"
 #endif  // #if SEQAN_HAS_ZLIB
 #include "test_bam_stream.h"
@@ -152,9 +153,15 @@ SEQAN_BEGIN_TESTSUITE(test_bam_io)
     SEQAN_CALL_TEST(test_bam_io_bam_read_alignment);
     SEQAN_CALL_TEST(test_bam_io_bam_write_header);
     SEQAN_CALL_TEST(test_bam_io_bam_write_alignment);
+    SEQAN_CALL_TEST(test_bam_io_bam_alignment_record_view_read_batch_small);
+    SEQAN_CALL_TEST(test_bam_io_bam_alignment_record_view_read_batch_ex1);
+    SEQAN_CALL_TEST(test_bam_io_bam_alignment_record_view_tags_dict);
 
     // Test BAM indices.
     SEQAN_CALL_TEST(test_bam_io_bam_index_bai);
+    SEQAN_CALL_TEST(test_bam_io_bam_index_build_bai);
+    SEQAN_CALL_TEST(test_bam_io_bam_index_region_chunks);
+    SEQAN_CALL_TEST(test_bam_io_bam_index_region_chunks_unmapped_reference);
 #endif  // #if SEQAN_HAS_ZLIB
 
     // Test BamStream class.
@@ -169,5 +176,7 @@ SEQAN_BEGIN_TESTSUITE(test_bam_io)
     SEQAN_CALL_TEST(test_bam_io_bam_stream_bam_read_ex1);
     SEQAN_CALL_TEST(test_bam_io_bam_stream_bam_write_header);
     SEQAN_CALL_TEST(test_bam_io_bam_stream_bam_write_records);
+    SEQAN_CALL_TEST(test_bam_io_bam_stream_sam_write_records_async);
+    SEQAN_CALL_TEST(test_bam_io_bam_stream_bam_write_records_async);
 }
 SEQAN_END_TESTSUITE
@@ -369,6 +369,76 @@ SEQAN_DEFINE_TEST(test_bam_io_bam_stream_bam_write_records)
     testBamIOBamStreamWriteRecords("/core/tests/bam_io/small.bam");
 }
 
+// ---------------------------------------------------------------------------
+// Write Records Asynchronously
+// ---------------------------------------------------------------------------
+
+// Write the records of ex1.bam a few times, synchronously and with a writer thread, and compare the results.
+
+void testBamIOBamStreamWriteRecordsAsync(char const * extension)
+{
+    seqan::CharString inPath = SEQAN_PATH_TO_ROOT();
+    append(inPath, "/core/tests/bam_io/ex1.bam");
+
+    seqan::BamStream bamIn(toCString(inPath));
+    SEQAN_ASSERT(isGood(bamIn));
+    seqan::String<seqan::BamAlignmentRecord> records;
+    seqan::BamAlignmentRecord record;
+    while (!atEnd(bamIn))
+    {
+        SEQAN_ASSERT_EQ(readRecord(record, bamIn), 0);
+        appendValue(records, record);
+    }
+
+    seqan::CharString syncPath = SEQAN_TEMP_FILENAME();
+    append(syncPath, extension);
+    seqan::CharString asyncPath = SEQAN_TEMP_FILENAME();
+    append(asyncPath, extension);
+
+    {
+        seqan::BamStream bamOut(toCString(syncPath), seqan::BamStream::WRITE);
+        bamOut.header = bamIn.header;
+        for (unsigned k = 0; k < 4; ++k)
+        {
+            for (unsigned i = 0; i < length(records); ++i)
+                SEQAN_ASSERT_EQ(writeRecord(bamOut, records[i]), 0);
+            if (k == 1)
+                SEQAN_ASSERT_EQ(flush(bamOut), 0);
+        }
+        SEQAN_ASSERT_EQ(close(bamOut), 0);
+    }
+
+    {
+        seqan::BamStream bamOut(toCString(asyncPath), seqan::BamStream::WRITE);
+        SEQAN_ASSERT_EQ(setNumThreads(bamOut, 3), 0);
+        bamOut.header = bamIn.header;
+        for (unsigned i = 0; i < length(records); ++i)
+            SEQAN_ASSERT_EQ(writeRecord(bamOut, records[i]), 0);
+        SEQAN_ASSERT_EQ(writeRecords(bamOut, records), 0);
+        SEQAN_ASSERT_EQ(flush(bamOut), 0);
+        SEQAN_ASSERT_EQ(writeRecords(bamOut, records), 0);
+        // Switching back to synchronous writing must write out all queued records first.
+        SEQAN_ASSERT_EQ(setNumThreads(bamOut, 1), 0);
+        SEQAN_ASSERT_EQ(writeRecords(bamOut, records), 0);
+        SEQAN_ASSERT_EQ(close(bamOut), 0);
+    }
+
+    if (seqan::endsWith(extension, ".bam"))
+        SEQAN_ASSERT(seqan::_compareBinaryFiles(toCString(asyncPath), toCString(syncPath)));
+    else
+        SEQAN_ASSERT(seqan::_compareTextFiles(toCString(asyncPath), toCString(syncPath)));
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_stream_sam_write_records_async)
+{
+    testBamIOBamStreamWriteRecordsAsync(".sam");
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_stream_bam_write_records_async)
+{
+    testBamIOBamStreamWriteRecordsAsync(".bam");
+}
+
 // ---------------------------------------------------------------------------
 // File Size / Byte Position In File
 // ---------------------------------------------------------------------------
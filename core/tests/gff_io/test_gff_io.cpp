@@ -60,5 +60,8 @@ SEQAN_BEGIN_TESTSUITE(test_gff_io)
     SEQAN_CALL_TEST(test_store_io_gff_stream_read_record_gtf);
     SEQAN_CALL_TEST(test_store_io_gff_stream_write_record_gff);
     SEQAN_CALL_TEST(test_store_io_gff_stream_write_record_gtf);
+#if SEQAN_HAS_ZLIB
+    SEQAN_CALL_TEST(test_store_io_gff_stream_jump_to_region);
+#endif  // #if SEQAN_HAS_ZLIB
 }
 SEQAN_END_TESTSUITE
@@ -710,4 +710,53 @@ SEQAN_DEFINE_TEST(test_store_io_gff_stream_write_record_gtf)
     SEQAN_ASSERT(seqan::_compareTextFilesAlt(toCString(outPath), toCString(gtfPath)));
 }
 
+#if SEQAN_HAS_ZLIB
+SEQAN_DEFINE_TEST(test_store_io_gff_stream_jump_to_region)
+{
+    // Write a sorted and BGZF compressed GFF file and index it.
+    seqan::CharString gzPath(SEQAN_TEMP_FILENAME());
+    append(gzPath, ".gff.gz");
+    {
+        char const * contents =
+                "##gff-version 3\n"
+                "ctg123\t.\texon\t1050\t1500\t.\t+\t.\tID=exon00002\n"
+                "ctg123\t.\tmRNA\t1300\t9000\t.\t+\t.\tID=mrna0001\n"
+                "ctg123\t.\texon\t20000\t21000\t.\t+\t.\tID=exon00003\n"
+                "ctg456\t.\tgene\t100\t200\t.\t-\t.\tID=gene00001\n";
+        seqan::Stream<seqan::Bgzf> out;
+        SEQAN_ASSERT(open(out, toCString(gzPath), "w"));
+        SEQAN_ASSERT_EQ(streamWriteBlock(out, contents, strlen(contents)), strlen(contents));
+    }
+    seqan::TabixIndex index;
+    SEQAN_ASSERT(buildIndex(index, toCString(gzPath), seqan::TabixIndex::GFF));
+
+    seqan::GffStream gffStream(toCString(gzPath));
+    SEQAN_ASSERT(isGood(gffStream));
+    seqan::GffRecord record;
+
+    bool hasRecords = false;
+    SEQAN_ASSERT(jumpToRegion(gffStream, hasRecords, "ctg123", 5000, 6000, index));
+    SEQAN_ASSERT(hasRecords);
+    SEQAN_ASSERT_EQ(readRecord(record, gffStream), 0);
+    SEQAN_ASSERT_EQ(record.ref, "ctg123");
+    SEQAN_ASSERT_EQ(record.type, "mRNA");
+    SEQAN_ASSERT_EQ(record.beginPos, 1299u);
+    SEQAN_ASSERT_EQ(record.endPos, 9000u);
+    SEQAN_ASSERT_EQ(readRecord(record, gffStream), 0);
+    SEQAN_ASSERT_EQ(record.beginPos, 19999u);
+
+    SEQAN_ASSERT(jumpToRegion(gffStream, hasRecords, "ctg456", 0, 1000, index));
+    SEQAN_ASSERT(hasRecords);
+    SEQAN_ASSERT_EQ(readRecord(record, gffStream), 0);
+    SEQAN_ASSERT_EQ(record.ref, "ctg456");
+    SEQAN_ASSERT_EQ(record.type, "gene");
+    SEQAN_ASSERT(atEnd(gffStream));
+
+    SEQAN_ASSERT(jumpToRegion(gffStream, hasRecords, "ctg123", 10000, 15000, index));
+    SEQAN_ASSERT_NOT(hasRecords);
+    SEQAN_ASSERT(jumpToRegion(gffStream, hasRecords, "ctg789", 0, 1000, index));
+    SEQAN_ASSERT_NOT(hasRecords);
+}
+#endif  // #if SEQAN_HAS_ZLIB
+
 #endif  // CORE_TESTS_GFF_IO_TEST_GFF_IO_H_
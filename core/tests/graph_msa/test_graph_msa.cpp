@@ -67,6 +67,7 @@ SEQAN_BEGIN_TESTSUITE(test_graph_msa)
 	SEQAN_CALL_TEST(test_triplet_extension);
 	SEQAN_CALL_TEST(test_sop);
 	SEQAN_CALL_TEST(test_progressive);
+	SEQAN_CALL_TEST(test_progressive_parallel);
 	SEQAN_CALL_TEST(test_reversable_fragments);	
 }
 SEQAN_END_TESTSUITE
@@ -440,6 +440,77 @@ void Test_Progressive() {
 }
 
 
+template<typename TSequenceSet, typename TMatches, typename TScores, typename TAlignMatrix>
+void _runProgressiveParallel(TSequenceSet& seqSet, int numThreads, TMatches& matches, TScores& scores, String<double>& distanceMatrix, TAlignMatrix& mat) {
+	typedef StringSet<typename Value<TSequenceSet>::Type, Dependent<> > TDependentSequenceSet;
+	typedef Graph<Alignment<TDependentSequenceSet, unsigned int> > TGraph;
+
+#ifdef _OPENMP
+	int oldNumThreads = omp_get_max_threads();
+	omp_set_num_threads(numThreads);
+#else
+	(void) numThreads;
+#endif
+	TGraph g(seqSet);
+	Blosum62 score_type(-1,-11);
+	String<unsigned int> pList;
+	selectPairs(seqSet, pList);
+	appendSegmentMatches(stringSet(g), pList, score_type, matches, scores, distanceMatrix, GlobalPairwiseLibrary() );
+	appendSegmentMatches(stringSet(g), pList, score_type, matches, scores, LocalPairwiseLibrary() );
+	appendSegmentMatches(stringSet(g), pList, matches, scores, LcsLibrary() );
+	buildAlignmentGraph(matches, scores, g, FractionalScore() );
+	tripletLibraryExtension(g);
+	Graph<Tree<double> > guideTree;
+	njTree(distanceMatrix, guideTree);
+	TGraph gOut(seqSet);
+	progressiveAlignment(g, guideTree, gOut);
+	convertAlignment(gOut, mat);
+#ifdef _OPENMP
+	omp_set_num_threads(oldNumThreads);
+#endif
+}
+
+void Test_ProgressiveParallel() {
+	typedef String<AminoAcid> TSequence;
+	typedef StringSet<TSequence, Owner<> > TSequenceSet;
+
+	TSequenceSet seqSet;
+	appendValue(seqSet, "GARFIELDTHELASTFATCAT");
+	appendValue(seqSet, "GARFIELDTHEFASTCAT");
+	appendValue(seqSet, "GARFIELDTHEVERYFASTCAT");
+	appendValue(seqSet, "THEFATCAT");
+	appendValue(seqSet, "GARFIELDTHELASTCAT");
+	appendValue(seqSet, "GARFIELDTHEFASTFATCAT");
+	appendValue(seqSet, "GARFIELDTHEVERYLASTCAT");
+	appendValue(seqSet, "THEFASTCAT");
+	appendValue(seqSet, "GARFIELDISAFATCAT");
+	appendValue(seqSet, "THELASTGARFIELD");
+
+	// The libraries and the alignment must not depend on the number of threads
+	String<Fragment<> > matches1, matches4;
+	String<int> scores1, scores4;
+	String<double> dist1, dist4;
+	String<char> mat1, mat4;
+	_runProgressiveParallel(seqSet, 1, matches1, scores1, dist1, mat1);
+	_runProgressiveParallel(seqSet, 4, matches4, scores4, dist4, mat4);
+
+	SEQAN_ASSERT_EQ(length(matches1), length(matches4));
+	for(unsigned int i = 0; i < length(matches1); ++i) {
+		SEQAN_ASSERT_EQ(sequenceId(matches1[i], 0), sequenceId(matches4[i], 0));
+		SEQAN_ASSERT_EQ(sequenceId(matches1[i], 1), sequenceId(matches4[i], 1));
+		SEQAN_ASSERT_EQ(fragmentBegin(matches1[i], 0), fragmentBegin(matches4[i], 0));
+		SEQAN_ASSERT_EQ(fragmentBegin(matches1[i], 1), fragmentBegin(matches4[i], 1));
+		SEQAN_ASSERT_EQ(fragmentLength(matches1[i]), fragmentLength(matches4[i]));
+	}
+	SEQAN_ASSERT(scores1 == scores4);
+	SEQAN_ASSERT_EQ(length(dist1), length(dist4));
+	for(unsigned int i = 0; i < length(dist1); ++i)
+		SEQAN_ASSERT_EQ(dist1[i], dist4[i]);
+	SEQAN_ASSERT_GT(length(mat1), 0u);
+	SEQAN_ASSERT(mat1 == mat4);
+}
+
+
 void Test_ReversableFragments() {
 	typedef unsigned int TSize;
 	typedef String<Dna> TSequence;
@@ -492,6 +563,10 @@ SEQAN_DEFINE_TEST(test_progressive)
 {
 	Test_Progressive();
 }
+SEQAN_DEFINE_TEST(test_progressive_parallel)
+{
+	Test_ProgressiveParallel();
+}
 SEQAN_DEFINE_TEST(test_reversable_fragments)
 {
 	Test_ReversableFragments();
@@ -134,8 +134,10 @@ SEQAN_BEGIN_TESTSUITE(test_fm_index_beta)
     SEQAN_CALL_TEST(test_fm_index_empty);
     SEQAN_CALL_TEST(test_fm_index_find_first_index_);
     SEQAN_CALL_TEST(test_fm_index_get_fibre);
+    SEQAN_CALL_TEST(test_fm_index_create_blockwise);
     SEQAN_CALL_TEST(test_fm_index_search);
     SEQAN_CALL_TEST(test_fm_index_open_save);
+    SEQAN_CALL_TEST(test_fm_index_open_mmap);
 
     SEQAN_CALL_TEST(fm_index_iterator_constuctor);
     SEQAN_CALL_TEST(fm_index_iterator_go_down);
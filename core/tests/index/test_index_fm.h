@@ -444,6 +444,167 @@ void fmIndexSearch(Index<TText, FMIndex<TIndexSpec, TOptimization> > /*tag*/)
     }
 }
 
+template <typename TText>
+void generateBlockwiseText(TText & text)
+{
+    generateText(text, 20000);
+}
+
+template <typename TText>
+void generateBlockwiseText(StringSet<TText> & text)
+{
+    typedef typename Value<TText>::Type TChar;
+
+    Rng<MersenneTwister> rng(SEED);
+
+    resize(text, 30);
+    for (unsigned i = 0; i < length(text); ++i)
+    {
+        resize(text[i], pickRandomNumber(rng) % 20 + 1);
+        for (unsigned j = 0; j < length(text[i]); ++j)
+            text[i][j] = (TChar)(pickRandomNumber(rng) % ValueSize<TChar>::VALUE);
+    }
+}
+
+// Long repeats with a few mutations such that suffixes share prefixes longer than the difference cover period.
+template <typename TText>
+void generateRepetitiveText(TText & text)
+{
+    typedef typename Value<TText>::Type TChar;
+
+    TText unit;
+    generateText(unit, 300);
+
+    Rng<MersenneTwister> rng(SEED);
+
+    clear(text);
+    for (unsigned i = 0; i < 8; ++i)
+        append(text, unit);
+    for (unsigned i = 0; i < 3; ++i)
+        text[pickRandomNumber(rng) % length(text)] = (TChar)(pickRandomNumber(rng) % ValueSize<TChar>::VALUE);
+}
+
+// Identical sequences, their equal suffixes are ordered by decreasing sequence number.
+template <typename TText>
+void generateRepetitiveText(StringSet<TText> & text)
+{
+    TText seq;
+    generateRepetitiveText(seq);
+
+    clear(text);
+    for (unsigned i = 0; i < 3; ++i)
+        appendValue(text, seq);
+    appendValue(text, prefix(seq, 1500));
+}
+
+template <typename TText, typename TSeqNo>
+TText const & naiveFMSeq(TText const & text, TSeqNo /*seqNo*/)
+{
+    return text;
+}
+
+template <typename TString, typename TSpec, typename TSeqNo>
+TString const & naiveFMSeq(StringSet<TString, TSpec> const & text, TSeqNo seqNo)
+{
+    return text[seqNo];
+}
+
+// The suffix order of the FM index computed by plain character comparisons.
+template <typename TText>
+struct NaiveFMSuffixLess
+{
+    TText const & text;
+
+    NaiveFMSuffixLess(TText const & text_) : text(text_)
+    {}
+
+    template <typename TSAValue>
+    bool operator()(TSAValue const & a, TSAValue const & b) const
+    {
+        typedef typename Size<TText>::Type TSize;
+
+        TSize lenA = length(naiveFMSeq(text, getSeqNo(a))) - getSeqOffset(a);
+        TSize lenB = length(naiveFMSeq(text, getSeqNo(b))) - getSeqOffset(b);
+        for (TSize i = 0; i < lenA && i < lenB; ++i)
+        {
+            if (ordLess(naiveFMSeq(text, getSeqNo(a))[getSeqOffset(a) + i],
+                        naiveFMSeq(text, getSeqNo(b))[getSeqOffset(b) + i])) return true;
+            if (ordLess(naiveFMSeq(text, getSeqNo(b))[getSeqOffset(b) + i],
+                        naiveFMSeq(text, getSeqNo(a))[getSeqOffset(a) + i])) return false;
+        }
+        if (lenA == lenB)
+            return getSeqNo(a) > getSeqNo(b);
+        return lenA < lenB;
+    }
+};
+
+template <typename TText, typename TIndexSpec, typename TOptimization>
+void _fmIndexCompareBlockwise(Index<TText, FMIndex<TIndexSpec, TOptimization> > /*tag*/, TText & text)
+{
+	typedef Index<TText, FMIndex<TIndexSpec, TOptimization> > TIndex;
+    typedef typename Fibre<TIndex, FibreLfTable>::Type TLfTable;
+    typedef typename Fibre<TLfTable, FibreOccTable>::Type TOccTable;
+
+    TIndex defaultIndex(text);
+    indexCreate(defaultIndex);
+
+    // Limit the blocks to 64 suffixes.
+    TIndex blockwiseIndex(text);
+    SEQAN_ASSERT(indexCreate(blockwiseIndex, FibreSaLfTable(), BlockwiseBwt(64 * sizeof(typename SAValue<TIndex>::Type))));
+
+    TOccTable & defaultOcc = getFibre(getFibre(defaultIndex, FibreLfTable()), FibreOccTable());
+    TOccTable & blockwiseOcc = getFibre(getFibre(blockwiseIndex, FibreLfTable()), FibreOccTable());
+    SEQAN_ASSERT_EQ(length(blockwiseOcc), length(defaultOcc));
+    for (unsigned i = 0; i < length(defaultOcc); ++i)
+        SEQAN_ASSERT_EQ(getValue(blockwiseOcc, i), getValue(defaultOcc, i));
+
+    SEQAN_ASSERT(getFibre(getFibre(blockwiseIndex, FibreLfTable()), FibrePrefixSumTable()) ==
+                 getFibre(getFibre(defaultIndex, FibreLfTable()), FibrePrefixSumTable()));
+    SEQAN_ASSERT_EQ(length(getFibre(blockwiseIndex, FibreSA())), length(getFibre(defaultIndex, FibreSA())));
+    for (unsigned i = countSequences(text); i < length(getFibre(defaultIndex, FibreSA())); ++i)
+        SEQAN_ASSERT_EQ(getFibre(blockwiseIndex, FibreSA())[i], getFibre(defaultIndex, FibreSA())[i]);
+    SEQAN_ASSERT(blockwiseIndex == defaultIndex);
+}
+
+// Compares the blockwise construction with a naive suffix sort.
+template <typename TText, typename TIndexSpec, typename TOptimization>
+void _fmIndexCheckBlockwiseNaive(Index<TText, FMIndex<TIndexSpec, TOptimization> > /*tag*/, TText & text)
+{
+	typedef Index<TText, FMIndex<TIndexSpec, TOptimization> > TIndex;
+    typedef typename SAValue<TIndex>::Type TSAValue;
+    typedef typename Size<TIndex>::Type TSize;
+    typedef typename Value<TIndex>::Type TChar;
+
+    TIndex index(text);
+    SEQAN_ASSERT(indexCreate(index, FibreSaLfTable(), BlockwiseBwt(64 * sizeof(TSAValue))));
+
+    String<TSAValue> sa;
+    resize(sa, lengthSum(text));
+    for (TSize pos = 0; pos < length(sa); ++pos)
+        posLocalize(sa[pos], pos, stringSetLimits(text));
+    std::sort(begin(sa, Standard()), end(sa, Standard()), NaiveFMSuffixLess<TText>(text));
+
+    TSize offset = countSequences(text);
+    for (TSize i = 0; i < length(sa); ++i)
+    {
+        SEQAN_ASSERT_EQ(getFibre(index, FibreSA())[offset + i], sa[i]);
+        if (getSeqOffset(sa[i]) != 0)
+            SEQAN_ASSERT_EQ((TChar)getValue(getFibre(getFibre(index, FibreLfTable()), FibreOccTable()), offset + i),
+                            naiveFMSeq(text, getSeqNo(sa[i]))[getSeqOffset(sa[i]) - 1]);
+    }
+}
+
+template <typename TText, typename TIndexSpec, typename TOptimization>
+void fmIndexCreateBlockwise(Index<TText, FMIndex<TIndexSpec, TOptimization> > tag)
+{
+	TText text;
+	generateBlockwiseText(text);
+    _fmIndexCompareBlockwise(tag, text);
+
+    generateRepetitiveText(text);
+    _fmIndexCheckBlockwiseNaive(tag, text);
+}
+
 template <typename TText, typename TIndexSpec, typename TOptimization>
 void fmIndexOpenSave(Index<TText, FMIndex<TIndexSpec, TOptimization> > /*tag*/)
 {
@@ -483,6 +644,37 @@ void fmIndexOpenSave(Index<TText, FMIndex<TIndexSpec, TOptimization> > /*tag*/)
     }
 }
 
+template <typename TIndexSpec, typename TOptimization>
+void fmIndexOpenMMap(Index<DnaString, FMIndex<TIndexSpec, TOptimization> > /*tag*/)
+{
+	typedef Index<DnaString, FMIndex<TIndexSpec, TOptimization> > TIndex;
+	typedef Index<String<Dna, MMap<> >, FMIndex<TIndexSpec, TOptimization> > TMMapIndex;
+
+	DnaString text;
+	generateText(text, 1000);
+
+	CharString tempFilename = SEQAN_TEMP_FILENAME();
+
+    TIndex indexSave(text);
+    indexCreate(indexSave);
+    SEQAN_ASSERT(save(indexSave, toCString(tempFilename)));
+
+    // The text and the suffix array samples are mapped in place.
+    TMMapIndex indexOpen;
+    SEQAN_ASSERT(open(indexOpen, toCString(tempFilename), OPEN_RDONLY));
+
+    Finder<TIndex> saveFinder(indexSave);
+    Finder<TMMapIndex> openFinder(indexOpen);
+
+    DnaString pattern = "CA";
+    while (find(saveFinder, pattern))
+    {
+        SEQAN_ASSERT(find(openFinder, pattern));
+        SEQAN_ASSERT_EQ(position(openFinder), position(saveFinder));
+    }
+    SEQAN_ASSERT_NOT(find(openFinder, pattern));
+}
+
 // A test for strings.
 SEQAN_DEFINE_TEST(test_fm_index_constructor)
 {
@@ -511,6 +703,10 @@ SEQAN_DEFINE_TEST(test_fm_index_constructor)
 //         fmIndexConstructor(uCharTag);
 //         fmIndexConstructor(charTag);
     }
+    {
+        Index<String<Dna>, FMIndex<CLB<>, void > > dnaTag;
+        fmIndexConstructor(dnaTag);
+    }
 }
 
 SEQAN_DEFINE_TEST(test_fm_index_clear)
@@ -653,6 +849,48 @@ SEQAN_DEFINE_TEST(test_fm_index_search)
         fmIndexSearch(sCharTag);
         fmIndexSearch(charTag);
     }  
+    {
+        Index<DnaString, FMIndex<CLB<>, void > > dnaTag;
+        Index<StringSet<DnaString>, FMIndex<CLB<>, void > > dnaSetTag;
+        Index<DnaString, FMIndex<CLB<>, CompressText> > dnaCompressedTag;
+        Index<StringSet<DnaString>, FMIndex<CLB<>, CompressText> > dnaSetCompressedTag;
+        fmIndexSearch(dnaTag);
+        fmIndexSearch(dnaSetTag);
+        fmIndexSearch(dnaCompressedTag);
+        fmIndexSearch(dnaSetCompressedTag);
+    }
+}
+
+SEQAN_DEFINE_TEST(test_fm_index_create_blockwise)
+{
+    using namespace seqan;
+    {
+        Index<DnaString, FMIndex<WT<>, void > > dnaTag;
+        Index<String<AminoAcid>, FMIndex<WT<>, void > > asTag;
+        Index<String<Dna>, FMIndex<CLB<>, void > > dnaClbTag;
+        fmIndexCreateBlockwise(dnaTag);
+        fmIndexCreateBlockwise(asTag);
+        fmIndexCreateBlockwise(dnaClbTag);
+    }
+    {
+        Index<StringSet<DnaString>, FMIndex<WT<>, void > > dnaTag;
+        Index<StringSet<String<AminoAcid> >, FMIndex<SBM<>, void > > asTag;
+        fmIndexCreateBlockwise(dnaTag);
+        fmIndexCreateBlockwise(asTag);
+    }
+}
+
+SEQAN_DEFINE_TEST(test_fm_index_open_mmap)
+{
+    using namespace seqan;
+    {
+        Index<DnaString, FMIndex<WT<>, void > > dnaTag;
+        fmIndexOpenMMap(dnaTag);
+    }
+    {
+        Index<DnaString, FMIndex<CLB<>, void > > dnaTag;
+        fmIndexOpenMMap(dnaTag);
+    }
 }
 
 SEQAN_DEFINE_TEST(test_fm_index_open_save)
@@ -666,6 +904,14 @@ SEQAN_DEFINE_TEST(test_fm_index_open_save)
         Index<StringSet<DnaString>, FMIndex<WT<>, void > > dnaTag;
         fmIndexOpenSave(dnaTag);
     }    
+    {
+        Index<DnaString, FMIndex<CLB<>, void > > dnaTag;
+        fmIndexOpenSave(dnaTag);
+    }
+    {
+        Index<StringSet<DnaString>, FMIndex<CLB<>, void > > dnaTag;
+        fmIndexOpenSave(dnaTag);
+    }
 }
 
 
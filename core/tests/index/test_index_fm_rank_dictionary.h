@@ -56,9 +56,10 @@ typedef seqan::TagList<
             seqan::TagList<seqan::WaveletTree<signed char> >, seqan::TagList<
             seqan::TagList<seqan::SequenceBitMask<seqan::Dna> >, seqan::TagList<
             seqan::TagList<seqan::SequenceBitMask<seqan::Dna5> >, seqan::TagList<
-            seqan::TagList<seqan::SequenceBitMask<seqan::AminoAcid> >
+            seqan::TagList<seqan::SequenceBitMask<seqan::AminoAcid> >, seqan::TagList<
+            seqan::TagList<seqan::CacheLineBlocks<seqan::Dna> >
             > > > > > >
-            > > >
+            > > > >
         RankDictionaryTestTypes;
 
 
@@ -239,6 +240,22 @@ void rankDictionaryGetFibre(RankDictionary<SequenceBitMask<TValue> > & /*tag*/)
 	SEQAN_ASSERT_EQ(length(getFibre(rankDictionary, FibreBitStrings())), 110u);
 }
 
+template <typename TValue>
+void rankDictionaryGetFibre(RankDictionary<CacheLineBlocks<TValue> > & /*tag*/)
+{
+    String<typename Value<RankDictionary<CacheLineBlocks<TValue> > >::Type> text = "ACGTNACGTNACGTN";
+	RankDictionary<CacheLineBlocks<TValue> > rankDictionary(text);
+
+    SEQAN_ASSERT_EQ(length(getFibre(rankDictionary, FibreBlocks())), 1u);
+    SEQAN_ASSERT_EQ(length(getFibre(rankDictionary, FibreSuperBlocks())), 4u);
+
+    SEQAN_ASSERT_EQ(reinterpret_cast<size_t>(begin(getFibre(rankDictionary, FibreBlocks()), Standard())) % 64, 0u);
+
+    resize(getFibre(rankDictionary, FibreBlocks()), 110);
+
+	SEQAN_ASSERT_EQ(length(getFibre(rankDictionary, FibreBlocks())), 110u);
+    SEQAN_ASSERT_EQ(reinterpret_cast<size_t>(begin(getFibre(rankDictionary, FibreBlocks()), Standard())) % 64, 0u);
+}
 
 SEQAN_TYPED_TEST(RankDictionaryTestCommon, GetFibre)
 {
@@ -344,6 +361,9 @@ void _rankDictionaryFill(TRankDictionary & /*tag*/)
 template <typename TValue>
 void _rankDictionaryFill(RankDictionary<SequenceBitMask<TValue> > & /*tag*/) {}
 
+template <typename TValue>
+void _rankDictionaryFill(RankDictionary<CacheLineBlocks<TValue> > & /*tag*/) {}
+
 SEQAN_TYPED_TEST(RankDictionaryTestCommon, Fill)
 {
     using namespace seqan;
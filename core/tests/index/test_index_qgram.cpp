@@ -46,6 +46,7 @@
 #include <seqan/index.h>
 #include <seqan/sequence.h>
 #include <seqan/pipe.h>
+#include <seqan/random.h>
 
 #include "test_index_helpers.h"
 #include "test_qgram_index.h"
@@ -60,6 +61,7 @@ SEQAN_BEGIN_TESTSUITE(test_index)
 	SEQAN_CALL_TEST(testUngappedShapes);
 	SEQAN_CALL_TEST(testUngappedQGramIndex);
 	SEQAN_CALL_TEST(testUngappedQGramIndexMulti);
+	SEQAN_CALL_TEST(testQGramIndexParallel);
 	SEQAN_CALL_TEST(testQGramFind);
 }
 SEQAN_END_TESTSUITE
@@ -66,5 +66,9 @@ SEQAN_BEGIN_TESTSUITE(test_index)
 	SEQAN_CALL_TEST(testSuperMaxRepeats);
 	SEQAN_CALL_TEST(testSuperMaxRepeatsFast);
     SEQAN_CALL_TEST(testMultipleStrings_Ticket1109);
+	SEQAN_CALL_TEST(testOpenMMap_Esa);
+#ifndef PLATFORM_WINDOWS
+	SEQAN_CALL_TEST(testOpenSharedMemory_Esa);
+#endif
 }
 SEQAN_END_TESTSUITE
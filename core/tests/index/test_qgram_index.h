@@ -320,6 +320,80 @@ SEQAN_DEFINE_TEST(testUngappedQGramIndexMulti)
         SEQAN_ASSERT_EQ_MSG(saAt(i, refIndex), saAt(i, testIndex), "i is %d", i);
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename TIndex>
+void _testQGramIndexParallel(TIndex &index, unsigned stepSize)
+{
+	TIndex refIndex(indexText(index));
+	setStepSize(refIndex, stepSize);
+	setStepSize(index, stepSize);
+
+	// the tables are sized by the serial construction
+	indexCreate(refIndex, QGramSADir());
+	resize(indexSA(index), length(indexSA(refIndex)));
+	resize(indexDir(index), length(indexDir(refIndex)));
+	index.bucketMap = refIndex.bucketMap;
+
+	createQGramIndex(refIndex, Serial());
+	createQGramIndex(index, Parallel());
+
+	SEQAN_ASSERT_EQ(length(indexDir(refIndex)), length(indexDir(index)));
+	for (unsigned i = 0; i < length(indexDir(refIndex)); ++i)
+		SEQAN_ASSERT_EQ_MSG(dirAt(i, refIndex), dirAt(i, index), "i is %d", i);
+	SEQAN_ASSERT_EQ(length(indexSA(refIndex)), length(indexSA(index)));
+	for (unsigned i = 0; i < length(indexSA(refIndex)); ++i)
+		SEQAN_ASSERT_EQ_MSG(saAt(i, refIndex), saAt(i, index), "i is %d", i);
+}
+
+SEQAN_DEFINE_TEST(testQGramIndexParallel)
+{
+	typedef Index<DnaString, IndexQGram<UngappedShape<5> > >                    TIndex;
+	typedef Index<DnaString, IndexQGram<UngappedShape<5>, OpenAddressing> >     TIndexOA;
+	typedef Index<StringSet<DnaString>, IndexQGram<UngappedShape<4> > >         TIndexMulti;
+	typedef Index<StringSet<DnaString>, IndexQGram<Shape<Dna, UngappedShape<3> > > > TIndexDisabled;
+	// directories larger than the text are counted with atomic increments instead of per-thread copies
+	typedef Index<DnaString, IndexQGram<UngappedShape<8> > >                    TIndexLarge;
+	typedef Index<StringSet<DnaString>, IndexQGram<UngappedShape<8> > >         TIndexMultiLarge;
+
+	Rng<MersenneTwister> rng(42);
+
+	DnaString text;
+	for (unsigned i = 0; i < 20000; ++i)
+		appendValue(text, Dna(pickRandomNumber(rng) % 4));
+
+	StringSet<DnaString> texts;
+	for (unsigned i = 0; i < 300; ++i)
+	{
+		DnaString seq;
+		unsigned len = pickRandomNumber(rng) % 60;        // some sequences are shorter than q
+		for (unsigned j = 0; j < len; ++j)
+			appendValue(seq, Dna(pickRandomNumber(rng) % 4));
+		appendValue(texts, seq);
+	}
+
+	for (unsigned stepSize = 1; stepSize <= 3; stepSize += 2)
+	{
+		TIndex index(text);
+		_testQGramIndexParallel(index, stepSize);
+
+		TIndexOA indexOA(text);
+		_testQGramIndexParallel(indexOA, stepSize);
+
+		TIndexMulti indexMulti(texts);
+		_testQGramIndexParallel(indexMulti, stepSize);
+
+		TIndexDisabled indexDisabled(texts);        // uses _qgramDisableBuckets (see above)
+		_testQGramIndexParallel(indexDisabled, stepSize);
+
+		TIndexLarge indexLarge(text);
+		_testQGramIndexParallel(indexLarge, stepSize);
+
+		TIndexMultiLarge indexMultiLarge(texts);
+		_testQGramIndexParallel(indexMultiLarge, stepSize);
+	}
+}
+
 
 //////////////////////////////////////////////////////////////////////////////
 
@@ -137,6 +137,90 @@ SEQAN_DEFINE_TEST(testShapes)
     testHashInit(shapeC);
 }
 
+template <typename TShape, typename TText>
+void testHashAll(TShape shape, TText const &text)
+{
+    typedef typename Iterator<TText const, Standard>::Type TIter;
+
+    String<__uint64> codes;
+    hashAll(codes, shape, text);
+    if (length(text) < length(shape))
+    {
+        SEQAN_ASSERT(empty(codes));
+        return;
+    }
+    SEQAN_ASSERT_EQ(length(codes), length(text) - length(shape) + 1);
+
+    TShape shape2(shape);
+    TIter it = begin(text, Standard());
+    for (unsigned i = 0; i < length(codes); ++i, ++it)
+        SEQAN_ASSERT_EQ(codes[i], hash(shape2, it));
+
+    // hash block-wise like the q-gram index does
+    TShape shape3(shape);
+    BulkHasher_<TShape, TIter> hasher(shape3, begin(text, Standard()), length(codes));
+    for (unsigned i = 0; i < length(codes); ++i)
+        SEQAN_ASSERT_EQ(hasher.next(), codes[i]);
+
+    // start in the middle of the text and continue with hashNext afterwards
+    if (length(codes) > 40)
+    {
+        __uint64 part[20];
+        hashAll(&part[0], shape, begin(text, Standard()) + 17, 20);
+        for (unsigned i = 0; i < 20; ++i)
+            SEQAN_ASSERT_EQ(part[i], codes[17 + i]);
+        it = begin(text, Standard()) + 37;
+        SEQAN_ASSERT_EQ(hashNext(shape, it), codes[37]);
+    }
+}
+
+template <typename TShape>
+void testHashAllTexts(TShape shape)
+{
+    String<Dna> dna;
+    String<Dna, Packed<> > packedDna;
+    String<Dna5> dna5;
+    for (unsigned len = 0; len < 200; len += 13)
+    {
+        resize(dna, len);
+        for (unsigned i = 0; i < len; ++i)
+            dna[i] = (i * 7 + i / 3) % 4;
+        packedDna = dna;
+        dna5 = dna;
+        if (len > 5) dna5[5] = 'N';
+        testHashAll(shape, dna);
+        testHashAll(shape, packedDna);
+        testHashAll(shape, dna5);
+        testHashAll(shape, infix(packedDna, _min(len, 3u), len));
+    }
+
+    // more q-grams than a block of the BulkHasher_
+    resize(dna, 2500);
+    for (unsigned i = 0; i < length(dna); ++i)
+        dna[i] = (i * 7 + i / 3) % 4;
+    packedDna = dna;
+    testHashAll(shape, dna);
+    testHashAll(shape, packedDna);
+}
+
+SEQAN_DEFINE_TEST(testHashAll)
+{
+    testHashAllTexts(Shape<Dna, SimpleShape>(1));
+    testHashAllTexts(Shape<Dna, SimpleShape>(11));
+    testHashAllTexts(Shape<Dna, SimpleShape>(32));
+    testHashAllTexts(Shape<Dna, UngappedShape<6> >());
+    testHashAllTexts(Shape<Dna, GappedShape<HardwiredShape<1,1,3,1,2> > >());
+    testHashAllTexts(Shape<Dna, GenericShape>(CharString("11100110100111")));
+    testHashAllTexts(Shape<Dna, OneGappedShape>(CharString("11110011")));
+
+    // alphabet size is not a power of two
+    testHashAllTexts(Shape<Dna5, SimpleShape>(7));
+
+    CharString text = "a quick brown fox jumps over the lazy dog";
+    testHashAll(Shape<char, SimpleShape>(5), text);
+    testHashAll(Shape<char, SimpleShape>(9), text);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
 
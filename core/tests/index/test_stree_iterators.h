@@ -643,6 +643,146 @@ SEQAN_DEFINE_TEST(testMultipleStrings_Ticket1109)
     Iterator< TIndex, TopDown<> >::Type it(index);
 }
 
+SEQAN_DEFINE_TEST(testOpenMMap_Esa)
+{
+	String<Dna> text;
+	for (unsigned i = 0; i < 10000; ++i)
+		appendValue(text, Dna((i * i + i / 7) % 4));
+
+	Index<String<Dna>, IndexEsa<> > esa(text);
+	indexRequire(esa, EsaSA());
+	indexRequire(esa, EsaLcp());
+	indexRequire(esa, EsaChildtab());
+	indexRequire(esa, EsaBwt());
+
+	CharString fileName = SEQAN_TEMP_FILENAME();
+	SEQAN_ASSERT(save(esa, toCString(fileName)));
+
+	// the fibres of an index over a memory mapped text are mapped in place
+	typedef Index<String<Dna, MMap<> >, IndexEsa<> > TMMapIndex;
+	{
+		TMMapIndex mmapEsa;
+		SEQAN_ASSERT(open(mmapEsa, toCString(fileName), OPEN_RDONLY));
+		SEQAN_ASSERT(indexSA(mmapEsa) == indexSA(esa));
+		SEQAN_ASSERT(indexLcp(mmapEsa) == indexLcp(esa));
+		SEQAN_ASSERT(indexChildtab(mmapEsa) == indexChildtab(esa));
+
+		Finder<TMMapIndex> mmapFinder(mmapEsa);
+		Finder<Index<String<Dna>, IndexEsa<> > > finder(esa);
+		while (find(finder, "ACGT"))
+		{
+			SEQAN_ASSERT(find(mmapFinder, "ACGT"));
+			SEQAN_ASSERT_EQ(position(mmapFinder), position(finder));
+		}
+		SEQAN_ASSERT_NOT(find(mmapFinder, "ACGT"));
+	}
+
+	// an index over a memory mapped text can be saved under a new name and in place
+	{
+		TMMapIndex mmapEsa;
+		SEQAN_ASSERT(open(mmapEsa, toCString(fileName), OPEN_RDONLY));
+
+		CharString fileName2 = SEQAN_TEMP_FILENAME();
+		SEQAN_ASSERT(save(mmapEsa, toCString(fileName2)));
+		SEQAN_ASSERT(save(mmapEsa, toCString(fileName)));
+
+		Index<String<Dna>, IndexEsa<> > esa2;
+		SEQAN_ASSERT(open(esa2, toCString(fileName2)));
+		SEQAN_ASSERT(indexText(esa2) == indexText(esa));
+		SEQAN_ASSERT(indexSA(esa2) == indexSA(esa));
+		SEQAN_ASSERT(indexLcp(esa2) == indexLcp(esa));
+		SEQAN_ASSERT(indexChildtab(esa2) == indexChildtab(esa));
+		SEQAN_ASSERT(indexBwt(esa2) == indexBwt(esa));
+		SEQAN_ASSERT(indexSA(mmapEsa) == indexSA(esa));
+	}
+
+	// fibres built in a temporary file are saved as well
+	{
+		String<Dna, MMap<> > mmapText;
+		mmapText = text;
+		TMMapIndex mmapEsa(mmapText);
+		indexRequire(mmapEsa, EsaSA());
+
+		CharString fileName2 = SEQAN_TEMP_FILENAME();
+		SEQAN_ASSERT(save(mmapEsa, toCString(fileName2)));
+		Index<String<Dna>, IndexEsa<> > esa2;
+		SEQAN_ASSERT(open(esa2, toCString(fileName2)));
+		SEQAN_ASSERT(indexSA(esa2) == indexSA(esa));
+	}
+
+	// a fibre file that doesn't match the header is rejected
+	{
+		CharString name = fileName;
+		append(name, ".lcp");
+		File<> file;
+		SEQAN_ASSERT(open(file, toCString(name), OPEN_RDWR));
+		resize(file, 100);
+		close(file);
+
+		TMMapIndex mmapEsa;
+		SEQAN_ASSERT_NOT(open(mmapEsa, toCString(fileName), OPEN_RDONLY));
+	}
+}
+
+#ifndef PLATFORM_WINDOWS
+SEQAN_DEFINE_TEST(testOpenSharedMemory_Esa)
+{
+	String<Dna> text;
+	for (unsigned i = 0; i < 10000; ++i)
+		appendValue(text, Dna((i * i + i / 7) % 4));
+
+	Index<String<Dna>, IndexEsa<> > esa(text);
+	indexRequire(esa, EsaSA());
+	indexRequire(esa, EsaLcp());
+	indexRequire(esa, EsaChildtab());
+	indexRequire(esa, EsaBwt());
+
+	std::stringstream ss;
+	ss << "/seqan_test_esa_" << getpid();
+	CharString name = ss.str();
+	SEQAN_ASSERT(save(esa, toCString(name), OPEN_WRONLY | OPEN_CREATE | OPEN_SHARED_MEMORY));
+
+	// the fibres of an index over a memory mapped text point into the shared memory objects
+	typedef Index<String<Dna, MMap<> >, IndexEsa<> > TMMapIndex;
+	{
+		TMMapIndex mmapEsa;
+		SEQAN_ASSERT(open(mmapEsa, toCString(name), OPEN_RDONLY | OPEN_SHARED_MEMORY));
+		SEQAN_ASSERT(indexText(mmapEsa) == text);
+		SEQAN_ASSERT(indexSA(mmapEsa) == indexSA(esa));
+		SEQAN_ASSERT(indexLcp(mmapEsa) == indexLcp(esa));
+		SEQAN_ASSERT(indexChildtab(mmapEsa) == indexChildtab(esa));
+
+		Finder<TMMapIndex> mmapFinder(mmapEsa);
+		Finder<Index<String<Dna>, IndexEsa<> > > finder(esa);
+		while (find(finder, "ACGT"))
+		{
+			SEQAN_ASSERT(find(mmapFinder, "ACGT"));
+			SEQAN_ASSERT_EQ(position(mmapFinder), position(finder));
+		}
+		SEQAN_ASSERT_NOT(find(mmapFinder, "ACGT"));
+	}
+
+	// fibres in main memory are read from the shared memory objects
+	{
+		Index<String<Dna>, IndexEsa<> > esa2;
+		SEQAN_ASSERT(open(esa2, toCString(name), OPEN_RDONLY | OPEN_SHARED_MEMORY));
+		SEQAN_ASSERT(indexSA(esa2) == indexSA(esa));
+		SEQAN_ASSERT(indexLcp(esa2) == indexLcp(esa));
+	}
+
+	char const * suffixes[] = {".txt", ".sa", ".lcp", ".child", ".bwt", ".hdr"};
+	for (unsigned i = 0; i < 6; ++i)
+	{
+		CharString segment = name;
+		append(segment, suffixes[i]);
+		SEQAN_ASSERT(removeSharedMemory(toCString(segment)));
+	}
+
+	TMMapIndex mmapEsa;
+	SEQAN_ASSERT_NOT(open(mmapEsa, toCString(name), OPEN_RDONLY | OPEN_SHARED_MEMORY | OPEN_QUIET));
+}
+#endif
+
 //////////////////////////////////////////////////////////////////////////////
 
 
@@ -49,6 +49,7 @@
 #include <seqan/misc/misc_map.h>
 #include <seqan/misc/misc_set.h>
 #include <seqan/misc/misc_interval_tree.h>
+#include <seqan/misc/misc_interval_tree_flat.h>
 #include <seqan/misc/priority_type_base.h>
 #include <seqan/misc/priority_type_heap.h>
 #include <seqan/misc/misc_terminal.h>
@@ -57,6 +58,7 @@
 #include "test_misc_accumulators.h"
 #include "test_misc_edit_environment.h"
 #include "test_misc_bit_twiddling.h"
+#include "test_misc_name_store_cache.h"
 
 using namespace std;
 using namespace seqan;
@@ -116,6 +118,8 @@ SEQAN_BEGIN_TESTSUITE(test_misc) {
     SEQAN_CALL_TEST(Interval_Tree__IntervalTreeTest_FindNoInterval__int);
     SEQAN_CALL_TEST(Interval_Tree__IntervalTreeTest_GraphMap__int_ComputeCenter_StoreIntervals);
     SEQAN_CALL_TEST(Interval_Tree__IntervalTreeTest_FindIntervalsIntervals__int_ComputeCenter);
+    SEQAN_CALL_TEST(Interval_Tree__FlatIntervalTreeTest_Random__int);
+    SEQAN_CALL_TEST(Interval_Tree__FlatIntervalTreeTest_QueryAtBoundary);
 
     SEQAN_CALL_TEST(test_misc_accumulators_average_accumulator_int_average);
     SEQAN_CALL_TEST(test_misc_accumulators_average_accumulator_int_count);
@@ -131,6 +135,9 @@ SEQAN_BEGIN_TESTSUITE(test_misc) {
     SEQAN_CALL_TEST(test_misc_edit_environment_string_enumerator_iterator_hamming);
     SEQAN_CALL_TEST(test_misc_edit_environment_string_enumerator_edit);
     SEQAN_CALL_TEST(test_misc_edit_environment_string_enumerator_iterator_edit);
+
+    SEQAN_CALL_TEST(test_misc_name_store_cache_tree);
+    SEQAN_CALL_TEST(test_misc_name_store_cache_hash);
 }
 SEQAN_END_TESTSUITE
 
@@ -42,6 +42,7 @@
 // TODO(holtgrew): Split up large tests into one setup and multiple test functions.
 
 #include <seqan/misc/misc_interval_tree.h>  // Header under test.
+#include <seqan/misc/misc_interval_tree_flat.h>  // Header under test.
 
 #include <seqan/basic.h>
 
@@ -723,6 +724,113 @@ SEQAN_DEFINE_TEST(Interval_Tree__IntervalTreeTest_FindIntervalsIntervals__int_Co
     IntervalTreeTest_FindIntervalsIntervals<int, ComputeCenter>();
 }
 
+// Build a FlatIntervalTree from random intervals, many of them nested or empty.  Compare point, interval, batch and
+// sweep queries with the naive algorithm, the cargos are expected in the order of the interval begin positions.
+template <typename TValue>
+void FlatIntervalTreeTest_Random(unsigned numIntervals)
+{
+    typedef unsigned                        TCargo;
+    typedef FlatIntervalTree<TValue, TCargo> TIntervalTree;
+    typedef IntervalAndCargo<TValue, TCargo> TInterval;
+
+    String<TInterval> intervals;
+    for (unsigned i = 0; i < numIntervals; ++i)
+    {
+        TValue iBegin = rand() % 1000;
+        TValue iEnd = iBegin + rand() % ((i % 10 == 0) ? 500 : 20);
+        appendValue(intervals, TInterval(iBegin, iEnd, i));
+    }
+    TIntervalTree itree(intervals);
+    SEQAN_ASSERT_EQ(length(itree), numIntervals);
+
+    // Stable sort by begin position gives the expected result order.
+    String<TInterval> sorted = intervals;
+    std::stable_sort(begin(sorted, Standard()), end(sorted, Standard()), _flatIntervalTreeLessBegin<TInterval>);
+
+    String<TValue> queryBegins, queryEnds;
+    String<TCargo> result, naiveResult;
+    for (TValue query = -5; query < 1100; query += 7)
+    {
+        findIntervals(itree, query, result);
+        clear(naiveResult);
+        for (unsigned j = 0; j < length(sorted); ++j)
+            if (sorted[j].i1 <= query && query < sorted[j].i2)
+                appendValue(naiveResult, sorted[j].cargo);
+        SEQAN_ASSERT(result == naiveResult);
+
+        findIntervalsExcludeTouching(itree, query, result);
+        clear(naiveResult);
+        for (unsigned j = 0; j < length(sorted); ++j)
+            if (sorted[j].i1 < query && query < sorted[j].i2)
+                appendValue(naiveResult, sorted[j].cargo);
+        SEQAN_ASSERT(result == naiveResult);
+
+        TValue queryEnd = query + rand() % 30;
+        findIntervals(itree, query, queryEnd, result);
+        clear(naiveResult);
+        for (unsigned j = 0; j < length(sorted); ++j)
+            if (sorted[j].i1 < queryEnd && query < sorted[j].i2)
+                appendValue(naiveResult, sorted[j].cargo);
+        SEQAN_ASSERT(result == naiveResult);
+
+        appendValue(queryBegins, query);
+        appendValue(queryEnds, queryEnd);
+    }
+
+    // Batch and sweep queries give the same results as single queries.
+    StringSet<String<TCargo>, Owner<ConcatDirect<> > > batchResults, sweepResults;
+    findIntervals(itree, queryBegins, queryEnds, batchResults);
+    findIntervals(itree, queryBegins, queryEnds, sweepResults, SortedQueries());
+    SEQAN_ASSERT_EQ(length(batchResults), length(queryBegins));
+    SEQAN_ASSERT_EQ(length(sweepResults), length(queryBegins));
+    for (unsigned i = 0; i < length(queryBegins); ++i)
+    {
+        findIntervals(itree, queryBegins[i], queryEnds[i], result);
+        SEQAN_ASSERT(batchResults[i] == result);
+        SEQAN_ASSERT(sweepResults[i] == result);
+    }
+}
+
+SEQAN_DEFINE_TEST(Interval_Tree__FlatIntervalTreeTest_Random__int)
+{
+    FlatIntervalTreeTest_Random<int>(0);
+    FlatIntervalTreeTest_Random<int>(1);
+    FlatIntervalTreeTest_Random<int>(17);
+    FlatIntervalTreeTest_Random<int>(1000);
+    FlatIntervalTreeTest_Random<int>(4099);
+}
+
+// The flat tree returns the same intervals as the graph-based tree.
+SEQAN_DEFINE_TEST(Interval_Tree__FlatIntervalTreeTest_QueryAtBoundary)
+{
+    typedef IntervalAndCargo<int, double> TInterval;
+
+    String<TInterval> intervals;
+    appendValue(intervals, TInterval(40,60,3.3));
+    appendValue(intervals, TInterval(0,30,1.4));
+    appendValue(intervals, TInterval(30,40,2.2));
+    FlatIntervalTree<int, double> itree(intervals);
+
+    String<double> result;
+    findIntervals(itree, 30, result);
+    SEQAN_ASSERT_EQ(length(result), 1u);
+    SEQAN_ASSERT_EQ(result[0], 2.2);
+
+    findIntervals(itree, 29, 41, result);
+    SEQAN_ASSERT_EQ(length(result), 3u);
+    SEQAN_ASSERT_EQ(result[0], 1.4);
+    SEQAN_ASSERT_EQ(result[1], 2.2);
+    SEQAN_ASSERT_EQ(result[2], 3.3);
+
+    findIntervals(itree, 60, result);
+    SEQAN_ASSERT(empty(result));
+
+    clear(itree);
+    SEQAN_ASSERT(empty(itree));
+    findIntervals(itree, 30, result);
+    SEQAN_ASSERT(empty(result));
+}
+
 }  // SEQAN_NAMESPACE_MAIN
 
 #endif
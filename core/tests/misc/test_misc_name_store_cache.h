@@ -0,0 +1,109 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Tests for the NameStoreCache specializations.
+// ==========================================================================
+
+#ifndef SEQAN_TESTS_MISC_TEST_MISC_NAME_STORE_CACHE_H_
+#define SEQAN_TESTS_MISC_TEST_MISC_NAME_STORE_CACHE_H_
+
+#include <sstream>
+
+#include <seqan/basic.h>
+#include <seqan/sequence.h>
+#include <seqan/misc/misc_name_store_cache.h>
+
+using namespace seqan;
+
+template <typename TSpec>
+void testNameStoreCache()
+{
+    typedef StringSet<CharString>                           TNameStore;
+    typedef NameStoreCache<TNameStore, CharString, TSpec>   TNameStoreCache;
+
+    // bulk construction from an existing name store
+    TNameStore nameStore;
+    appendValue(nameStore, "chr1");
+    appendValue(nameStore, "chr2");
+    appendValue(nameStore, "chrX");
+    TNameStoreCache cache(nameStore);
+
+    unsigned id = 0;
+    SEQAN_ASSERT(getIdByName(nameStore, "chr2", id, cache));
+    SEQAN_ASSERT_EQ(id, 1u);
+    SEQAN_ASSERT(getIdByName(nameStore, CharString("chrX"), id, cache));
+    SEQAN_ASSERT_EQ(id, 2u);
+    SEQAN_ASSERT_NOT(getIdByName(nameStore, "chr3", id, cache));
+    SEQAN_ASSERT_NOT(getIdByName(nameStore, "", id, cache));
+
+    // enough names to grow the table several times
+    for (unsigned i = 0; i < 1000; ++i)
+    {
+        std::stringstream ss;
+        ss << "read." << i;
+        appendName(nameStore, ss.str(), cache);
+    }
+    SEQAN_ASSERT_EQ(length(nameStore), 1003u);
+    for (unsigned i = 0; i < 1000; ++i)
+    {
+        std::stringstream ss;
+        ss << "read." << i;
+        SEQAN_ASSERT(getIdByName(nameStore, ss.str(), id, cache));
+        SEQAN_ASSERT_EQ(id, i + 3);
+    }
+    SEQAN_ASSERT(getIdByName(nameStore, "chr1", id, cache));
+    SEQAN_ASSERT_EQ(id, 0u);
+
+    // duplicates keep the first id
+    appendName(nameStore, "chr1", cache);
+    SEQAN_ASSERT(getIdByName(nameStore, "chr1", id, cache));
+    SEQAN_ASSERT_EQ(id, 0u);
+
+    // refresh after the name store was modified directly
+    clear(nameStore);
+    appendValue(nameStore, "read.7");
+    refresh(cache);
+    SEQAN_ASSERT(getIdByName(nameStore, "read.7", id, cache));
+    SEQAN_ASSERT_EQ(id, 0u);
+    SEQAN_ASSERT_NOT(getIdByName(nameStore, "chr1", id, cache));
+}
+
+SEQAN_DEFINE_TEST(test_misc_name_store_cache_tree)
+{
+    testNameStoreCache<void>();
+}
+
+SEQAN_DEFINE_TEST(test_misc_name_store_cache_hash)
+{
+    testNameStoreCache<NameStoreHash>();
+}
+
+#endif  // SEQAN_TESTS_MISC_TEST_MISC_NAME_STORE_CACHE_H_
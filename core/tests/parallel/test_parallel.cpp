@@ -46,6 +46,7 @@
 #include "test_parallel_atomic_misc.h"
 #include "test_parallel_splitting.h"
 #include "test_parallel_algorithms.h"
+#include "test_parallel_work_stealing.h"
 
 SEQAN_BEGIN_TESTSUITE(test_parallel) {
 #if defined(_OPENMP)
@@ -78,5 +79,12 @@ SEQAN_BEGIN_TESTSUITE(test_parallel) {
     SEQAN_CALL_TEST(test_parallel_splitting_compute_splitters);
     SEQAN_CALL_TEST(test_parallel_sum);
     SEQAN_CALL_TEST(test_parallel_partial_sum);
+
+#if !defined(__llvm__) && !defined(PLATFORM_WINDOWS_MINGW)
+    // Tests for the spin lock and the work-stealing queue.
+    SEQAN_CALL_TEST(test_parallel_spin_lock);
+    SEQAN_CALL_TEST(test_parallel_work_stealing_queue_serial);
+    SEQAN_CALL_TEST(test_parallel_work_stealing_queue_parallel);
+#endif  // #if !defined(__llvm__) && !defined(PLATFORM_WINDOWS_MINGW)
 }
 SEQAN_END_TESTSUITE
@@ -0,0 +1,125 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Tests for the spin lock and the work-stealing queue.
+// ==========================================================================
+
+#ifndef TEST_PARALLEL_TEST_PARALLEL_WORK_STEALING_H_
+#define TEST_PARALLEL_TEST_PARALLEL_WORK_STEALING_H_
+
+#include <seqan/basic.h>
+#include <seqan/sequence.h>
+#include <seqan/parallel.h>
+
+SEQAN_DEFINE_TEST(test_parallel_spin_lock)
+{
+    using namespace seqan;
+
+    SpinLock spinLock;
+    int const COUNT = 10 * 1024;
+    int x = 0;
+
+    SEQAN_OMP_PRAGMA(parallel for schedule(static, 1))
+    for (int i = 0; i < COUNT; ++i)
+    {
+        ScopedSpinLock guard(spinLock);
+        x = x + 1;
+    }
+
+    SEQAN_ASSERT_EQ(x, COUNT);
+    SEQAN_ASSERT_EQ(spinLock.state, 0u);
+}
+
+SEQAN_DEFINE_TEST(test_parallel_work_stealing_queue_serial)
+{
+    using namespace seqan;
+
+    WorkStealingQueue<int> queue(2);
+    SEQAN_ASSERT(empty(queue));
+
+    String<int> jobs;
+    appendValue(jobs, 1);
+    appendValue(jobs, 2);
+    appendValue(jobs, 3);
+    pushFront(queue, jobs, 0);
+    pushBack(queue, 0, 0);
+    SEQAN_ASSERT_EQ(length(queue), 4u);
+
+    // the owner pops the newest job
+    int job = -1;
+    SEQAN_ASSERT(popFront(job, queue, 0));
+    SEQAN_ASSERT_EQ(job, 3);
+
+    // another thread steals the oldest job
+    SEQAN_ASSERT(popFront(job, queue, 1));
+    SEQAN_ASSERT_EQ(job, 0);
+    SEQAN_ASSERT(stealWork(job, queue, 1));
+    SEQAN_ASSERT_EQ(job, 1);
+
+    SEQAN_ASSERT_NOT(stealWork(job, queue, 0));
+    SEQAN_ASSERT(popFront(job, queue, 0));
+    SEQAN_ASSERT_EQ(job, 2);
+
+    SEQAN_ASSERT(empty(queue));
+    SEQAN_ASSERT_NOT(popFront(job, queue, 0));
+    SEQAN_ASSERT_NOT(popFront(job, queue, 1));
+}
+
+SEQAN_DEFINE_TEST(test_parallel_work_stealing_queue_parallel)
+{
+    using namespace seqan;
+
+    int const COUNT = 16 * 1024;
+    WorkStealingQueue<int> queue(omp_get_max_threads());
+    String<unsigned> seen;
+    resize(seen, COUNT, 0u);
+
+    // thread 0 creates all jobs, some of them by splitting popped jobs in two
+    for (int i = 0; i < COUNT; i += 2)
+        pushFront(queue, i, 0);
+
+    SEQAN_OMP_PRAGMA(parallel)
+    {
+        int job;
+        while (popFront(job, queue, omp_get_thread_num()))
+        {
+            atomicInc(seen[job]);
+            if (job % 2 == 0)
+                pushFront(queue, job + 1, omp_get_thread_num());
+        }
+    }
+
+    SEQAN_ASSERT(empty(queue));
+    for (int i = 0; i < COUNT; ++i)
+        SEQAN_ASSERT_EQ_MSG(seen[i], 1u, "job %d", i);
+}
+
+#endif  // #ifndef TEST_PARALLEL_TEST_PARALLEL_WORK_STEALING_H_
@@ -274,12 +274,72 @@ void testSorter(unsigned maxSize = 16*1024*1024) {
 }
 
 
+template <typename TSpec>
+void testParallelSorter(unsigned size, unsigned alphabetSize, PoolParameters const & conf)
+{
+    String<unsigned> values;
+    resize(values, size);
+    for (unsigned i = 0; i < size; ++i)
+        values[i] = (i * 2654435761u) % alphabetSize;
+
+    Pool<unsigned, TSpec> sorter(conf);
+    sorter << values;
+
+    String<unsigned> sorted;
+    sorted << sorter;
+    std::sort(begin(values, Standard()), end(values, Standard()));
+    SEQAN_ASSERT(sorted == values);
+}
+
+
 SEQAN_DEFINE_TEST(test_pipe_test_external_string) {
     testExternalString<MMap<> >(MAX_SIZE);
     testExternalString<External<> >(MAX_SIZE);
+#ifndef PLATFORM_WINDOWS
+    testExternalString<External<ExternalConfigLarge<File<PReadAsync<> >, 4096, 8> > >(MAX_SIZE);
+#endif
 }
 
 
+#ifndef PLATFORM_WINDOWS
+SEQAN_DEFINE_TEST(test_pipe_test_external_string_prefetch) {
+    typedef String<unsigned, External<ExternalConfigLarge<File<PReadAsync<> >, 1024, 8> > > TExtString;
+    typedef Iterator<TExtString, Standard>::Type TIter;
+    typedef Iterator<TExtString const, Standard>::Type TConstIter;
+
+    const unsigned PAGES = 64;
+    TExtString extString;
+    resize(extString, PAGES * 1024);
+    unsigned i = 0;
+    for (TIter it = begin(extString, Standard()); it != end(extString, Standard()); ++it, ++i)
+        *it = i * 7;
+    flush(extString);
+
+    // forward iteration with 4 pages in flight
+    setPrefetchDepth(extString, 4);
+    clearPagingStats(extString);
+    i = 0;
+    TExtString const & constString = extString;
+    for (TConstIter it = begin(constString, Standard()); it != end(constString, Standard()); ++it, ++i)
+        SEQAN_ASSERT_EQ(*it, i * 7);
+    SEQAN_ASSERT_GT(pagingStats(extString).prefetches, 0u);
+    SEQAN_ASSERT_GT(pagingStats(extString).hits, 0u);
+
+    // random accesses with a constant stride of 3 pages are detected and prefetched
+    clearPagingStats(extString);
+    for (unsigned page = 0; page < PAGES; page += 3)
+        for (unsigned j = 0; j < 1024; j += 512)
+            SEQAN_ASSERT_EQ(constString[page * 1024 + j], (page * 1024 + j) * 7);
+    SEQAN_ASSERT_GT(pagingStats(extString).prefetches, 0u);
+    SEQAN_ASSERT_GT(pagingStats(extString).hits, pagingStats(extString).misses);
+
+    // backwards with a stride of 5 pages
+    for (int page = PAGES - 1; page >= 0; page -= 5)
+        SEQAN_ASSERT_EQ(constString[page * 1024 + 1], (page * 1024 + 1) * 7);
+}
+#endif
+
+
 SEQAN_DEFINE_TEST(test_pipe_test_simple_pool) {
     testPool(MAX_SIZE);
 }
@@ -299,6 +359,27 @@ SEQAN_DEFINE_TEST(test_pipe_test_sorter) {
     testSorter(MAX_SIZE);
 }
 
+
+SEQAN_DEFINE_TEST(test_pipe_test_parallel_sorter) {
+    typedef ParallelSorterSpec<SorterConfig<SimpleCompare<unsigned> > > TSpec;
+
+    // in memory
+    testParallelSorter<TSpec>(100000, 1000000, PoolParameters());
+
+    // external with many pages, tiny buckets and many duplicates
+    PoolParameters conf;
+    conf.absoluteSizes = false;
+    conf.memBufferSize = 0;
+    conf.pageSize = 1;
+    conf.bucketBufferSize = 2000;
+    testParallelSorter<TSpec>(1, 10, conf);
+    testParallelSorter<TSpec>(16384 * 24 + 1, 1000000, conf);
+    testParallelSorter<TSpec>(16384 * 24 + 7, 3, conf);
+
+    conf.bucketBufferSize = 1 << 20;
+    testParallelSorter<TSpec>(16384 * 40 + 3, 1u << 31, conf);
+}
+
 template <typename TStringSet>
 inline void appendValues(TStringSet &stringSet, int numArgs, ...)
 {
@@ -485,10 +566,14 @@ SEQAN_DEFINE_TEST(test_pipe_sampler)
 SEQAN_BEGIN_TESTSUITE(test_pipe) {
 	std::cerr << "";  // This line is an esoteric fix for an even more esoteric crash in MS VC++ 9/10.
     SEQAN_CALL_TEST(test_pipe_test_external_string);
+#ifndef PLATFORM_WINDOWS
+    SEQAN_CALL_TEST(test_pipe_test_external_string_prefetch);
+#endif
     SEQAN_CALL_TEST(test_pipe_test_simple_pool);
     SEQAN_CALL_TEST(test_pipe_test_mapper);
     SEQAN_CALL_TEST(test_pipe_test_mapper_partially_filled);
     SEQAN_CALL_TEST(test_pipe_test_sorter);
+    SEQAN_CALL_TEST(test_pipe_test_parallel_sorter);
     SEQAN_CALL_TEST(test_pipe_sampler);
 }
 SEQAN_END_TESTSUITE
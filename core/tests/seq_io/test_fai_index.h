@@ -35,6 +35,7 @@
 #ifndef CORE_TESTS_SEQ_IO_TEST_FAI_INDEX_H_
 #define CORE_TESTS_SEQ_IO_TEST_FAI_INDEX_H_
 
+#include <seqan/random.h>
 #include <seqan/seq_io.h>
 
 SEQAN_DEFINE_TEST(test_seq_io_genomic_fai_index_build)
@@ -139,4 +140,47 @@ SEQAN_DEFINE_TEST(test_seq_io_genomic_fai_index_read_region)
     }
 }
 
+SEQAN_DEFINE_TEST(test_seq_io_genomic_fai_index_region_cache)
+{
+    seqan::CharString filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, "/core/tests/seq_io/adeno_genome.fa");
+
+    seqan::FaiIndex faiIndex;
+    SEQAN_ASSERT_EQ(read(faiIndex, toCString(filePath)), 0);
+
+    // Use small windows and few of them to exercise eviction.
+    seqan::FaiRegionCache<seqan::Dna5> cache(faiIndex, 100, 3);
+
+    seqan::Dna5String str;
+    SEQAN_ASSERT_EQ(readRegion(str, cache, 0, 100, 110), 0);
+    SEQAN_ASSERT_EQ(str, "GAGCGCGCAG");
+    SEQAN_ASSERT_EQ(regionInfix(cache, 0, 100, 110), "GAGCGCGCAG");
+    SEQAN_ASSERT_EQ(length(cache.entries), 1u);
+
+    // Over the end of the sequence.
+    SEQAN_ASSERT_EQ(readRegion(str, cache, 0, 4708, 10000), 0);
+    SEQAN_ASSERT_EQ(str, "GAGTGGGCAA");
+
+    // From GenomicRegion.
+    seqan::GenomicRegion region("gi|9632547|ref|NC_002077.1|:101-110");
+    SEQAN_ASSERT_EQ(readRegion(str, cache, region), 0);
+    SEQAN_ASSERT_EQ(str, "GAGCGCGCAG");
+
+    // Compare against the uncached readRegion().
+    seqan::Rng<seqan::MersenneTwister> rng(42);
+    seqan::Dna5String expected;
+    for (unsigned i = 0; i < 1000; ++i)
+    {
+        unsigned beginPos = pickRandomNumber(rng) % 4718;
+        unsigned endPos = beginPos + pickRandomNumber(rng) % 250;
+        SEQAN_ASSERT_EQ(readRegion(expected, faiIndex, 0, beginPos, endPos), 0);
+        SEQAN_ASSERT_EQ(readRegion(str, cache, 0, beginPos, endPos), 0);
+        SEQAN_ASSERT_EQ(str, expected);
+        SEQAN_ASSERT_LEQ(length(cache.entries), 3u);
+    }
+
+    clear(cache);
+    SEQAN_ASSERT(empty(cache.entries));
+}
+
 #endif  // #ifndef CORE_TESTS_SEQ_IO_TEST_FAI_INDEX_H_
@@ -66,6 +66,11 @@ SEQAN_BEGIN_TESTSUITE(test_seq_io)
     SEQAN_CALL_TEST(test_seq_io_sequence_stream_read_record_text_fasta);
     SEQAN_CALL_TEST(test_seq_io_sequence_stream_read_batch_text_fasta);
     SEQAN_CALL_TEST(test_seq_io_sequence_stream_read_all_text_fasta);
+    SEQAN_CALL_TEST(test_seq_io_sequence_stream_read_batch_parallel_text_fasta);
+    SEQAN_CALL_TEST(test_seq_io_sequence_stream_read_batch_parallel_text_fastq);
+    SEQAN_CALL_TEST(test_seq_io_sequence_stream_read_batch_parallel_large_records);
+    SEQAN_CALL_TEST(test_seq_io_sequence_stream_read_batch_parallel_gz_fastq);
+    SEQAN_CALL_TEST(test_seq_io_sequence_stream_read_all_parallel_text_fastq);
 
     // Test writing with different interfaces.
     SEQAN_CALL_TEST(test_seq_io_sequence_stream_write_record_text_fasta);
@@ -89,6 +94,7 @@ SEQAN_BEGIN_TESTSUITE(test_seq_io)
     SEQAN_CALL_TEST(test_seq_io_genomic_fai_index_read);
     SEQAN_CALL_TEST(test_seq_io_genomic_fai_index_read_sequence);
     SEQAN_CALL_TEST(test_seq_io_genomic_fai_index_read_region);
+    SEQAN_CALL_TEST(test_seq_io_genomic_fai_index_region_cache);
 
     // -------------- File format specific code ------------------
 
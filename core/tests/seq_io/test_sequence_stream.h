@@ -232,6 +232,159 @@ SEQAN_DEFINE_TEST(test_seq_io_sequence_stream_read_all_text_fasta)
     SEQAN_ASSERT(isGood(seqIO));
 }
 
+// ---------------------------------------------------------------------------
+// Test parallel batch reading.
+// ---------------------------------------------------------------------------
+
+// Read the file in batches sequentially and with multiple threads and compare the records.
+template <typename TQualTag>
+void testSeqIOSequenceStreamReadBatchParallel(char const * filePath, TQualTag const & /*withQuals*/)
+{
+    seqan::SequenceStream seqIO(filePath);
+    seqan::SequenceStream seqIOPar(filePath);
+    SEQAN_ASSERT_EQ(0, setNumThreads(seqIOPar, 3));
+    seqIOPar._chunkSize = 500;  // Many small chunks.
+
+    seqan::StringSet<seqan::CharString> ids, idsPar;
+    seqan::StringSet<seqan::Dna5String> seqs, seqsPar;
+    seqan::StringSet<seqan::CharString> quals, qualsPar;
+
+    unsigned numRecords = 0;
+    while (!atEnd(seqIO))
+    {
+        SEQAN_ASSERT_NOT(atEnd(seqIOPar));
+        if (seqan::IsSameType<TQualTag, seqan::True>::VALUE)
+        {
+            SEQAN_ASSERT_EQ(0, readBatch(ids, seqs, quals, seqIO, 7));
+            SEQAN_ASSERT_EQ(0, readBatch(idsPar, seqsPar, qualsPar, seqIOPar, 7));
+        }
+        else
+        {
+            SEQAN_ASSERT_EQ(0, readBatch(ids, seqs, seqIO, 7));
+            SEQAN_ASSERT_EQ(0, readBatch(idsPar, seqsPar, seqIOPar, 7));
+        }
+
+        SEQAN_ASSERT_EQ(length(ids), length(idsPar));
+        for (unsigned i = 0; i < length(ids); ++i)
+        {
+            SEQAN_ASSERT_EQ(ids[i], idsPar[i]);
+            SEQAN_ASSERT_EQ(seqs[i], seqsPar[i]);
+            if (seqan::IsSameType<TQualTag, seqan::True>::VALUE)
+                SEQAN_ASSERT_EQ(quals[i], qualsPar[i]);
+        }
+        numRecords += length(ids);
+    }
+    SEQAN_ASSERT_GT(numRecords, 0u);
+    SEQAN_ASSERT(atEnd(seqIOPar));
+    SEQAN_ASSERT(isGood(seqIOPar));
+}
+
+SEQAN_DEFINE_TEST(test_seq_io_sequence_stream_read_batch_parallel_text_fasta)
+{
+    seqan::CharString filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, "/core/tests/seq_io/test_dna.fa");
+    testSeqIOSequenceStreamReadBatchParallel(toCString(filePath), seqan::False());
+
+    // Multi-line records larger than the chunk size.
+    filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, "/core/tests/seq_io/adeno_genome.fa");
+    testSeqIOSequenceStreamReadBatchParallel(toCString(filePath), seqan::False());
+}
+
+SEQAN_DEFINE_TEST(test_seq_io_sequence_stream_read_batch_parallel_text_fastq)
+{
+    seqan::CharString filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, "/core/tests/seq_io/SRR067601_1.1k.fasta");
+    testSeqIOSequenceStreamReadBatchParallel(toCString(filePath), seqan::True());
+    testSeqIOSequenceStreamReadBatchParallel(toCString(filePath), seqan::False());
+
+    // Multi-line records with quality lines starting with '@'.
+    char const * tmpPath = SEQAN_TEMP_FILENAME();
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::out);
+        for (unsigned i = 0; i < 300; ++i)
+        {
+            out << "@read" << i << " comment\n";
+            for (unsigned j = 0; j <= i % 3; ++j)
+                out << "ACGTNACGTACGTTGCA\n";
+            out << "+\n";
+            for (unsigned j = 0; j <= i % 3; ++j)
+                out << "@II@I@IIII@@IIII@\n";
+        }
+    }
+    testSeqIOSequenceStreamReadBatchParallel(tmpPath, seqan::True());
+}
+
+SEQAN_DEFINE_TEST(test_seq_io_sequence_stream_read_batch_parallel_large_records)
+{
+    // Records of 240k characters, hundreds of times larger than the chunk size.
+    char const * fastaPath = SEQAN_TEMP_FILENAME();
+    {
+        std::ofstream out(fastaPath, std::ios::binary | std::ios::out);
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            out << ">large" << i << "\n";
+            for (unsigned j = 0; j < 4000; ++j)
+                out << "ACGTTGCAACGTTGCAACGTTGCAACGTTGCAACGTTGCAACGTTGCAACGTTGCAACGT\n";
+            out << ">small" << i << "\nACGT\n";
+        }
+    }
+    testSeqIOSequenceStreamReadBatchParallel(fastaPath, seqan::False());
+
+    char const * fastqPath = SEQAN_TEMP_FILENAME();
+    {
+        std::ofstream out(fastqPath, std::ios::binary | std::ios::out);
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            out << "@large" << i << "\n";
+            for (unsigned j = 0; j < 4000; ++j)
+                out << "ACGTTGCAACGTTGCAACGTTGCAACGTTGCAACGTTGCAACGTTGCAACGTTGCAACGT\n";
+            out << "+\n";
+            for (unsigned j = 0; j < 4000; ++j)
+                out << "@IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII\n";
+            out << "@small" << i << "\nACGT\n+\nIIII\n";
+        }
+    }
+    testSeqIOSequenceStreamReadBatchParallel(fastqPath, seqan::True());
+}
+
+SEQAN_DEFINE_TEST(test_seq_io_sequence_stream_read_batch_parallel_gz_fastq)
+{
+#if SEQAN_HAS_ZLIB
+    seqan::CharString filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, "/core/tests/seq_io/SRR067601_1.1k.fasta.gz");
+    testSeqIOSequenceStreamReadBatchParallel(toCString(filePath), seqan::True());
+#endif  // #if SEQAN_HAS_ZLIB
+}
+
+SEQAN_DEFINE_TEST(test_seq_io_sequence_stream_read_all_parallel_text_fastq)
+{
+    seqan::CharString filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, "/core/tests/seq_io/SRR067601_1.1k.fasta");
+
+    seqan::SequenceStream seqIO(toCString(filePath));
+    seqan::SequenceStream seqIOPar(toCString(filePath));
+    SEQAN_ASSERT_EQ(0, setNumThreads(seqIOPar, 4));
+    seqIOPar._chunkSize = 1000;
+
+    seqan::StringSet<seqan::CharString> ids, idsPar;
+    seqan::StringSet<seqan::Dna5String> seqs, seqsPar;
+    seqan::StringSet<seqan::CharString> quals, qualsPar;
+
+    SEQAN_ASSERT_EQ(0, readAll(ids, seqs, quals, seqIO));
+    SEQAN_ASSERT_EQ(0, readAll(idsPar, seqsPar, qualsPar, seqIOPar));
+    SEQAN_ASSERT_EQ(length(idsPar), 1000u);
+    SEQAN_ASSERT_EQ(length(ids), length(idsPar));
+    for (unsigned i = 0; i < length(ids); ++i)
+    {
+        SEQAN_ASSERT_EQ(ids[i], idsPar[i]);
+        SEQAN_ASSERT_EQ(seqs[i], seqsPar[i]);
+        SEQAN_ASSERT_EQ(quals[i], qualsPar[i]);
+    }
+    SEQAN_ASSERT(atEnd(seqIOPar));
+    SEQAN_ASSERT(isGood(seqIOPar));
+}
+
 // ---------------------------------------------------------------------------
 // Test writing with different interfaces.
 // ---------------------------------------------------------------------------
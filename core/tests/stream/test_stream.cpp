@@ -43,6 +43,7 @@
 #if SEQAN_HAS_ZLIB
 #include "test_stream_gz_file.h"
 #include "test_stream_bgzf.h"
+#include "test_stream_tabix_index.h"
 #endif  // #if SEQAN_HAS_ZLIB
 #if SEQAN_HAS_BZIP2
 #include "test_stream_bz2_file.h"
@@ -150,6 +151,14 @@ SEQAN_BEGIN_TESTSUITE(test_stream)
 
     SEQAN_CALL_TEST(test_stream_bgzf_write_large_and_compare_with_file);
     SEQAN_CALL_TEST(test_stream_bgzf_from_file_and_compare);
+    SEQAN_CALL_TEST(test_stream_bgzf_write_large_multithreaded_and_compare_with_file);
+    SEQAN_CALL_TEST(test_stream_bgzf_from_file_multithreaded_and_compare);
+    SEQAN_CALL_TEST(test_stream_bgzf_seek_tell_multithreaded);
+
+    SEQAN_CALL_TEST(test_stream_tabix_index_reg2bins);
+    SEQAN_CALL_TEST(test_stream_tabix_index_parse_line);
+    SEQAN_CALL_TEST(test_stream_tabix_index_build_read_write);
+    SEQAN_CALL_TEST(test_stream_tabix_index_jump_to_region);
 #endif  // #if SEQAN_HAS_ZLIB
 
 #if SEQAN_HAS_BZIP2  // Enable tests for Stream<BZ2File> if available.
@@ -282,6 +291,7 @@ SEQAN_BEGIN_TESTSUITE(test_stream)
     SEQAN_CALL_TEST(test_stream_tokenizing_read_digits);
     SEQAN_CALL_TEST(test_stream_tokenizing_read_alpha_nums);
     SEQAN_CALL_TEST(test_stream_tokenizing_read_float);
+    SEQAN_CALL_TEST(test_stream_tokenizing_buffer_boundaries);
 
     // Tests for lexical_cast
     SEQAN_CALL_TEST(test_stream_lexical_cast_1_stdstring);
@@ -526,4 +526,152 @@ SEQAN_DEFINE_TEST(test_stream_bgzf_from_file_and_compare)
     SEQAN_ASSERT(feof(inFasta));
 }
 
+// Writing with multiple threads must yield the same file as writing with one thread.
+SEQAN_DEFINE_TEST(test_stream_bgzf_write_large_multithreaded_and_compare_with_file)
+{
+    using namespace seqan;
+
+    // Open test file for reading.
+    char tempPath[1000];
+    strcpy(tempPath, SEQAN_PATH_TO_ROOT());
+    strcat(tempPath, "/core/tests/stream/SRR067601_1.1k.fasta");
+    FILE * fp = fopen(tempPath, "rb");
+    SEQAN_ASSERT(fp != NULL);
+
+    // Open BGZF stream for writing with multiple threads.
+    char outFilename[1000];
+    strcpy(outFilename, SEQAN_TEMP_FILENAME());
+
+    Stream<Bgzf> stream;
+    SEQAN_ASSERT(open(stream, outFilename, "w"));
+    setNumThreads(stream, 2);
+
+    // Copy from fp to stream.
+    String<char> buffer;
+    resize(buffer, 765);
+    while (!feof(fp))
+    {
+        int len = fread(&buffer[0], 1, 765, fp);
+        streamWriteBlock(stream, &buffer[0], len);
+    }
+    fclose(fp);
+    close(stream);
+
+    // Compare with file written by one thread.
+    char inPath1[1000];
+    strcpy(inPath1, SEQAN_PATH_TO_ROOT());
+    strcat(inPath1, "/core/tests/stream/SRR067601_1.1k.fasta.gz");
+    FILE * fin1 = fopen(inPath1, "rb");
+    SEQAN_ASSERT(fin1 != NULL);
+    FILE * fin2 = fopen(outFilename, "rb");
+    SEQAN_ASSERT(fin2 != NULL);
+
+    int i = 0;
+    while (!feof(fin1) && !feof(fin2))
+    {
+        int i1 = fgetc(fin1);
+        int i2 = fgetc(fin2);
+        SEQAN_ASSERT_EQ_MSG(i1, i2, "At character pos %d", i);
+        ++i;
+    }
+
+    SEQAN_ASSERT(feof(fin1));
+    SEQAN_ASSERT(feof(fin2));
+    fclose(fin1);
+    fclose(fin2);
+}
+
+// Reading with multiple threads.
+SEQAN_DEFINE_TEST(test_stream_bgzf_from_file_multithreaded_and_compare)
+{
+    using namespace seqan;
+
+    char gzPath[1000];
+    strcpy(gzPath, SEQAN_PATH_TO_ROOT());
+    strcat(gzPath, "/core/tests/stream/SRR067601_1.1k.fasta.gz");
+    char fastaPath[1000];
+    strcpy(fastaPath, SEQAN_PATH_TO_ROOT());
+    strcat(fastaPath, "/core/tests/stream/SRR067601_1.1k.fasta");
+
+    Stream<Bgzf> inBgzf;
+    SEQAN_ASSERT(open(inBgzf, gzPath, "r"));
+    setNumThreads(inBgzf, 2);
+
+    FILE * inFasta = fopen(fastaPath, "rb");
+    SEQAN_ASSERT(inFasta != NULL);
+
+    String<char> expected, buffer;
+    resize(expected, 1000);
+    resize(buffer, 1000);
+    int i = 0;
+    while (true)
+    {
+        size_t len1 = fread(&expected[0], 1, 1000, inFasta);
+        size_t len2 = streamReadBlock(&buffer[0], inBgzf, 1000);
+        SEQAN_ASSERT_EQ_MSG(len1, len2, "At block %d", i);
+        SEQAN_ASSERT(prefix(expected, len1) == prefix(buffer, len2));
+        if (len1 < 1000u)
+            break;
+        ++i;
+    }
+
+    SEQAN_ASSERT(streamEof(inBgzf));
+    fclose(inFasta);
+}
+
+// Virtual offsets from streamTell() while writing with multiple threads must be valid for seeking when reading with
+// multiple threads.
+SEQAN_DEFINE_TEST(test_stream_bgzf_seek_tell_multithreaded)
+{
+    using namespace seqan;
+
+    char filenameBuffer[1000];
+    strcpy(filenameBuffer, SEQAN_TEMP_FILENAME());
+
+    // Write out 40 lines of 40k characters each, spanning many blocks and several batches.
+    String<__int64> offsets;
+    Stream<Bgzf> bgzfOut;
+    SEQAN_ASSERT(open(bgzfOut, filenameBuffer, "w"));
+    SEQAN_ASSERT_EQ(setNumThreads(bgzfOut, 2), 0);
+    CharString line;
+    bool keptBatch = false;
+    for (int i = 0; i < 40; ++i)
+    {
+        clear(line);
+        for (int j = 0; j < 40000; ++j)
+            appendValue(line, (char)('a' + (i * 7 + j * (j % 13)) % 26));
+        line[0] = 'A' + (i % 26);
+        appendValue(offsets, streamTell(bgzfOut));
+        streamWriteBlock(bgzfOut, &line[0], length(line));
+        // Telling must not force the collected blocks out.
+        streamTell(bgzfOut);
+        keptBatch = keptBatch || bgzfOut._batchLength != 0u;
+    }
+    SEQAN_ASSERT(keptBatch);
+    SEQAN_ASSERT_EQ(streamError(bgzfOut), 0);
+    close(bgzfOut);
+
+    // Seek to the lines in reverse order and check the first character.
+    Stream<Bgzf> f;
+    SEQAN_ASSERT(open(f, filenameBuffer, "r"));
+    setNumThreads(f, 2);
+    for (int i = 39; i >= 0; --i)
+    {
+        SEQAN_ASSERT_EQ(streamSeek(f, offsets[i], SEEK_SET), 0);
+        SEQAN_ASSERT_EQ((__int64)streamTell(f), offsets[i]);
+        char c = '\0';
+        SEQAN_ASSERT_EQ(streamReadChar(c, f), 0);
+        SEQAN_ASSERT_EQ(c, (char)('A' + (i % 26)));
+    }
+
+    // Read the whole file sequentially.
+    SEQAN_ASSERT_EQ(streamSeek(f, 0, SEEK_SET), 0);
+    size_t total = 0;
+    char c = '\0';
+    while (streamReadChar(c, f) == 0)
+        ++total;
+    SEQAN_ASSERT_EQ(total, 40u * 40000u);
+    SEQAN_ASSERT(streamEof(f));
+}
+
 #endif // #ifndef CORE_TESTS_STREAM_TEST_STREAM_BGZF_H_
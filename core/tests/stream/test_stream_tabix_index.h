@@ -0,0 +1,249 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Tests for the TabixIndex of BGZF compressed files.
+// ==========================================================================
+
+#ifndef CORE_TESTS_STREAM_TEST_STREAM_TABIX_INDEX_H_
+#define CORE_TESTS_STREAM_TEST_STREAM_TABIX_INDEX_H_
+
+#include <sstream>
+
+#include <seqan/basic.h>
+#include <seqan/sequence.h>
+#include <seqan/stream.h>
+
+// Write a BED file with 20000 short intervals on chr1, one long interval on chr1 and a few intervals on chr2, the
+// file spans many BGZF blocks.
+
+inline void _writeTabixTestFile(char const * filename)
+{
+    using namespace seqan;
+
+    Stream<Bgzf> stream;
+    SEQAN_ASSERT(open(stream, filename, "w"));
+    char const * header = "#chrom\tbegin\tend\n";
+    streamWriteBlock(stream, header, strlen(header));
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::stringstream ss;
+        ss << "chr1\t" << i * 100 << '\t' << i * 100 + 50 << "\tshort" << i << '\n';
+        if (i == 5000)
+            ss << "chr1\t500000\t1500000\tlong\n";
+        std::string line = ss.str();
+        streamWriteBlock(stream, line.c_str(), line.size());
+    }
+    char const * chr2 = "chr2\t10\t20\ta\nchr2\t100000\t100100\tb\n";
+    streamWriteBlock(stream, chr2, strlen(chr2));
+    close(stream);
+}
+
+SEQAN_DEFINE_TEST(test_stream_tabix_index_reg2bins)
+{
+    using namespace seqan;
+
+    SEQAN_ASSERT_EQ(_tabixReg2bin(0, 1), 4681u);
+    SEQAN_ASSERT_EQ(_tabixReg2bin(16384, 16385), 4682u);
+    SEQAN_ASSERT_EQ(_tabixReg2bin(16383, 16385), 585u);
+    SEQAN_ASSERT_EQ(_tabixReg2bin(0, 1 << 29), 0u);
+
+    String<__uint32> bins;
+    _tabixReg2bins(bins, 0, 1);
+    SEQAN_ASSERT_EQ(length(bins), 6u);
+    SEQAN_ASSERT_EQ(bins[0], 0u);
+    SEQAN_ASSERT_EQ(bins[1], 1u);
+    SEQAN_ASSERT_EQ(bins[5], 4681u);
+}
+
+SEQAN_DEFINE_TEST(test_stream_tabix_index_parse_line)
+{
+    using namespace seqan;
+
+    TabixIndex index;
+    char const * nameBegin = 0;
+    char const * nameEnd = 0;
+    __int32 beginPos = 0;
+    __int32 endPos = 0;
+
+    // GFF, 1-based inclusive.
+    CharString line = "chr1\tsrc\tgene\t101\t200\t.\t+\t.\tID=x";
+    SEQAN_ASSERT(_tabixParseLine(nameBegin, nameEnd, beginPos, endPos, line, index));
+    SEQAN_ASSERT_EQ(std::string(nameBegin, nameEnd), "chr1");
+    SEQAN_ASSERT_EQ(beginPos, 100);
+    SEQAN_ASSERT_EQ(endPos, 200);
+
+    // BED, 0-based half-open.
+    setPreset(index, TabixIndex::BED);
+    line = "chr2\t100\t200";
+    SEQAN_ASSERT(_tabixParseLine(nameBegin, nameEnd, beginPos, endPos, line, index));
+    SEQAN_ASSERT_EQ(std::string(nameBegin, nameEnd), "chr2");
+    SEQAN_ASSERT_EQ(beginPos, 100);
+    SEQAN_ASSERT_EQ(endPos, 200);
+    line = "chr2\t100";
+    SEQAN_ASSERT_NOT(_tabixParseLine(nameBegin, nameEnd, beginPos, endPos, line, index));
+    line = "chr2\t1x0\t200";
+    SEQAN_ASSERT_NOT(_tabixParseLine(nameBegin, nameEnd, beginPos, endPos, line, index));
+
+    // VCF, the end is given by the reference allele.
+    setPreset(index, TabixIndex::VCF);
+    line = "20\t14370\trs6054257\tGAT\tA\t29\tPASS\t.";
+    SEQAN_ASSERT(_tabixParseLine(nameBegin, nameEnd, beginPos, endPos, line, index));
+    SEQAN_ASSERT_EQ(std::string(nameBegin, nameEnd), "20");
+    SEQAN_ASSERT_EQ(beginPos, 14369);
+    SEQAN_ASSERT_EQ(endPos, 14372);
+
+    // ROI, 1-based inclusive.
+    setPreset(index, TabixIndex::ROI);
+    line = "chr3\t1\t10\tregion\t+\t10";
+    SEQAN_ASSERT(_tabixParseLine(nameBegin, nameEnd, beginPos, endPos, line, index));
+    SEQAN_ASSERT_EQ(beginPos, 0);
+    SEQAN_ASSERT_EQ(endPos, 10);
+}
+
+SEQAN_DEFINE_TEST(test_stream_tabix_index_build_read_write)
+{
+    using namespace seqan;
+
+    CharString tmpPath = SEQAN_TEMP_FILENAME();
+    append(tmpPath, ".bed.gz");
+    _writeTabixTestFile(toCString(tmpPath));
+
+    TabixIndex index;
+    SEQAN_ASSERT(buildIndex(index, toCString(tmpPath), TabixIndex::BED));
+    SEQAN_ASSERT_EQ(numSeqs(index), 2u);
+    SEQAN_ASSERT_EQ(sequenceName(index, 0), "chr1");
+    SEQAN_ASSERT_EQ(sequenceName(index, 1), "chr2");
+    __int32 refId = -1;
+    SEQAN_ASSERT(getIdByName(index, "chr2", refId));
+    SEQAN_ASSERT_EQ(refId, 1);
+    SEQAN_ASSERT_NOT(getIdByName(index, "chr3", refId));
+
+    // 20000 * 100 bp span 123 windows of 16kb.
+    SEQAN_ASSERT_EQ(length(index._linearIndices[0]), 123u);
+    SEQAN_ASSERT_EQ(index._binIndices[0][37450u].chunkBegEnds[1].i1, 20001u);
+    SEQAN_ASSERT_EQ(index._binIndices[1][37450u].chunkBegEnds[1].i1, 2u);
+
+    CharString tbiPath = tmpPath;
+    append(tbiPath, ".tbi");
+    SEQAN_ASSERT_EQ(write(index, toCString(tbiPath)), 0);
+
+    TabixIndex index2;
+    SEQAN_ASSERT_EQ(read(index2, toCString(tbiPath)), 0);
+    SEQAN_ASSERT_EQ(index2._format, index._format);
+    SEQAN_ASSERT_EQ(index2._colSeq, 1);
+    SEQAN_ASSERT_EQ(index2._colBeg, 2);
+    SEQAN_ASSERT_EQ(index2._colEnd, 3);
+    SEQAN_ASSERT_EQ(index2._meta, '#');
+    SEQAN_ASSERT_EQ(index2._unplacedCount, 0u);
+    SEQAN_ASSERT_EQ(length(index2._names), 2u);
+    SEQAN_ASSERT_EQ(index2._names[0], "chr1");
+    SEQAN_ASSERT_EQ(index2._names[1], "chr2");
+    SEQAN_ASSERT(index2._linearIndices == index._linearIndices);
+    SEQAN_ASSERT_EQ(length(index2._binIndices), 2u);
+    for (unsigned i = 0; i < 2; ++i)
+    {
+        SEQAN_ASSERT_EQ(index2._binIndices[i].size(), index._binIndices[i].size());
+        typedef TabixIndex::TBinIndex_::const_iterator TIter;
+        for (TIter it = index._binIndices[i].begin(), it2 = index2._binIndices[i].begin();
+             it != index._binIndices[i].end(); ++it, ++it2)
+        {
+            SEQAN_ASSERT_EQ(it->first, it2->first);
+            SEQAN_ASSERT(it->second.chunkBegEnds == it2->second.chunkBegEnds);
+        }
+    }
+
+    // An unsorted file cannot be indexed.
+    CharString unsortedPath = SEQAN_TEMP_FILENAME();
+    {
+        Stream<Bgzf> stream;
+        SEQAN_ASSERT(open(stream, toCString(unsortedPath), "w"));
+        char const * text = "chr1\t10\t20\nchr2\t10\t20\nchr1\t30\t40\n";
+        streamWriteBlock(stream, text, strlen(text));
+    }
+    SEQAN_ASSERT_NOT(buildIndex(index2, toCString(unsortedPath), TabixIndex::BED));
+}
+
+SEQAN_DEFINE_TEST(test_stream_tabix_index_jump_to_region)
+{
+    using namespace seqan;
+
+    CharString tmpPath = SEQAN_TEMP_FILENAME();
+    _writeTabixTestFile(toCString(tmpPath));
+
+    TabixIndex index;
+    SEQAN_ASSERT(buildIndex(index, toCString(tmpPath), TabixIndex::BED));
+
+    Stream<Bgzf> stream;
+    SEQAN_ASSERT(open(stream, toCString(tmpPath), "r"));
+    bool hasEntries = false;
+    CharString line;
+
+    // The long interval overlaps the region and comes first.
+    SEQAN_ASSERT(jumpToRegion(stream, hasEntries, 0, 1234567, 1234800, index));
+    SEQAN_ASSERT(hasEntries);
+    SEQAN_ASSERT_EQ(_tabixReadLine(line, stream), 0);
+    SEQAN_ASSERT_EQ(line, "chr1\t500000\t1500000\tlong");
+    for (int i = 0; i < 5000; ++i)
+        SEQAN_ASSERT_EQ(_tabixReadLine(line, stream), 0);
+    SEQAN_ASSERT_EQ(line, "chr1\t1000000\t1000050\tshort10000");
+
+    // Behind the long interval, the first short interval that ends behind the begin of the region.
+    SEQAN_ASSERT(jumpToRegion(stream, hasEntries, 0, 1734567, 1734800, index));
+    SEQAN_ASSERT(hasEntries);
+    SEQAN_ASSERT_EQ(_tabixReadLine(line, stream), 0);
+    SEQAN_ASSERT_EQ(line, "chr1\t1734600\t1734650\tshort17346");
+
+    // Jump backwards into the first block.
+    SEQAN_ASSERT(jumpToRegion(stream, hasEntries, 0, 0, 10, index));
+    SEQAN_ASSERT(hasEntries);
+    SEQAN_ASSERT_EQ(_tabixReadLine(line, stream), 0);
+    SEQAN_ASSERT_EQ(line, "chr1\t0\t50\tshort0");
+
+    // Second sequence.
+    SEQAN_ASSERT(jumpToRegion(stream, hasEntries, 1, 50000, 100050, index));
+    SEQAN_ASSERT(hasEntries);
+    SEQAN_ASSERT_EQ(_tabixReadLine(line, stream), 0);
+    SEQAN_ASSERT_EQ(line, "chr2\t100000\t100100\tb");
+    SEQAN_ASSERT_EQ(_tabixReadLine(line, stream), 1);
+
+    // Regions without entries.
+    SEQAN_ASSERT(jumpToRegion(stream, hasEntries, 0, 1234555, 1234600, index));
+    SEQAN_ASSERT(hasEntries);  // The long interval.
+    SEQAN_ASSERT(jumpToRegion(stream, hasEntries, 0, 1999960, 1999999, index));
+    SEQAN_ASSERT_NOT(hasEntries);
+    SEQAN_ASSERT(jumpToRegion(stream, hasEntries, 0, 5000000, 6000000, index));
+    SEQAN_ASSERT_NOT(hasEntries);
+    SEQAN_ASSERT(jumpToRegion(stream, hasEntries, 1, 30, 90000, index));
+    SEQAN_ASSERT_NOT(hasEntries);
+    SEQAN_ASSERT_NOT(jumpToRegion(stream, hasEntries, 2, 0, 100, index));
+}
+
+#endif  // CORE_TESTS_STREAM_TEST_STREAM_TABIX_INDEX_H_
@@ -644,4 +644,66 @@ SEQAN_DEFINE_TEST(test_stream_tokenizing_skipUntilLineBeginsWithOneCharOfStr)
     delete file;
 }
 
+// block-wise reading across buffer boundaries
+SEQAN_DEFINE_TEST(test_stream_tokenizing_buffer_boundaries)
+{
+    using namespace seqan;
+
+    // Build lines longer than the reader's buffer and longer than one SSE block.
+    CharString line1, line2, line3;
+    for (unsigned i = 0; i < 100; ++i)
+    {
+        appendValue(line1, "ACGT"[i % 4]);
+        appendValue(line2, "acgtn"[i % 5]);
+        appendValue(line3, "0123456789"[i % 10]);
+    }
+    CharString str = line1;
+    append(str, "\r\n");
+    append(str, line2);
+    append(str, "\t");
+    append(str, line3);
+    append(str, "\n");
+    append(str, line1);
+    append(str, " \n ");
+    append(str, line2);
+    append(str, "\n>");
+
+    const char * tempFilename = SEQAN_TEMP_FILENAME();
+    char filenameBuffer[1000];
+    strcpy(filenameBuffer, tempFilename);
+    std::fstream file(filenameBuffer, std::ios_base::in | std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    SEQAN_ASSERT(file.is_open());
+    file.write(toCString(str), length(str));
+    file.seekg(0);
+
+    RecordReader<std::fstream, SinglePass<void> > reader(file, 7);
+    CharString buf;
+
+    SEQAN_ASSERT_EQ(readLine(buf, reader), 0);
+    SEQAN_ASSERT_EQ(buf, line1);
+
+    clear(buf);
+    SEQAN_ASSERT_EQ(readUntilTabOrLineBreak(buf, reader), 0);
+    SEQAN_ASSERT_EQ(buf, line2);
+    SEQAN_ASSERT_EQ(value(reader), '\t');
+    goNext(reader);
+
+    clear(buf);
+    SEQAN_ASSERT_EQ(readUntilOneOf(buf, reader, 'x', '\n', 'y'), 0);
+    SEQAN_ASSERT_EQ(buf, line3);
+    SEQAN_ASSERT_EQ(value(reader), '\n');
+    goNext(reader);
+
+    // Whitespace is skipped, the first non-alphanumeric character stops reading.
+    clear(buf);
+    SEQAN_ASSERT_EQ(_readHelper(buf, reader, AlphaNum_(), Whitespace_(), false), 0);
+    append(line1, line2);
+    SEQAN_ASSERT_EQ(buf, line1);
+    SEQAN_ASSERT_EQ(value(reader), '>');
+
+    clear(buf);
+    SEQAN_ASSERT_EQ(readUntilChar(buf, reader, 'Z'), EOF_BEFORE_SUCCESS);
+    SEQAN_ASSERT_EQ(buf, ">");
+}
+
 #endif // ndef TEST_STREAM_TEST_STREAM_TOKENIZING_H_
@@ -66,7 +66,10 @@ struct FxBamCoverageOptions
     // Window size to use for computation.
     __int32 windowSize;
 
-    FxBamCoverageOptions() : verbosity(1), windowSize(10*1000)
+    // Number of threads to use for reading BAM files.
+    unsigned numThreads;
+
+    FxBamCoverageOptions() : verbosity(1), windowSize(10*1000), numThreads(1)
     {}
 };
 
@@ -128,6 +131,11 @@ parseArgs(FxBamCoverageOptions & options,
     addSection(parser, "Main Options");
     addOption(parser, seqan::ArgParseOption("w", "window-size", "Set the size of the non-overlapping windows in base pairs.", seqan::ArgParseArgument::INTEGER, "NUM"));
     setDefaultValue(parser, "window-size", "10000");
+    addOption(parser, seqan::ArgParseOption("t", "threads", "Number of threads to use.  BAM files are then split into "
+                                            "regions using the BAI index, which is built if \\fIMAPPING.bam.bai\\fP "
+                                            "does not exist.", seqan::ArgParseArgument::INTEGER, "NUM"));
+    setMinValue(parser, "threads", "1");
+    setDefaultValue(parser, "threads", "1");
 
     addSection(parser, "Output Options");
     addOption(parser, seqan::ArgParseOption("o", "out-path", "Path to the resulting file.  If omitted, result is printed to stdout.", seqan::ArgParseArgument::OUTPUTFILE, "TSV"));
@@ -141,6 +149,7 @@ parseArgs(FxBamCoverageOptions & options,
         getOptionValue(options.inGenomePath, parser, "in-reference");
         getOptionValue(options.inBamPath, parser, "in-mapping");
         getOptionValue(options.outPath, parser, "out-path");
+        getOptionValue(options.numThreads, parser, "threads");
 
         if (isSet(parser, "verbose"))
             options.verbosity = 2;
@@ -151,6 +160,164 @@ parseArgs(FxBamCoverageOptions & options,
     return res;
 }
 
+// ---------------------------------------------------------------------------
+// Function computeCoverage()
+// ---------------------------------------------------------------------------
+
+// Count the alignments starting in each bin, reading the mapping file sequentially.
+
+int computeCoverage(seqan::String<seqan::String<BinData> > & bins,
+                    seqan::FaiIndex const & faiIndex,
+                    FxBamCoverageOptions const & options)
+{
+    seqan::BamStream bamStream(toCString(options.inBamPath));
+    if (!isGood(bamStream))
+    {
+        std::cerr << "Could not open " << options.inBamPath << "!\n";
+        return 1;
+    }
+
+    seqan::BamAlignmentRecord record;
+    while (!atEnd(bamStream))
+    {
+        if (readRecord(record, bamStream) != 0)
+        {
+            std::cerr << "ERROR: Could not read record from BAM file!\n";
+            return 1;
+        }
+
+        if (hasFlagUnmapped(record) || hasFlagSecondary(record) || record.rID == seqan::BamAlignmentRecord::INVALID_REFID)
+            continue;  // Skip these records.
+
+        int contigId = 0;
+        seqan::CharString const & contigName = nameStore(bamStream.bamIOContext)[record.rID];
+        if (!getIdByName(faiIndex, contigName, contigId))
+        {
+            std::cerr << "ERROR: Alignment to unknown contig " << contigId << "!\n";
+            return 1;
+        }
+        unsigned binNo = record.beginPos / options.windowSize;
+        bins[contigId][binNo].coverage += 1;
+    }
+
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Function computeCoverageParallel()
+// ---------------------------------------------------------------------------
+
+// Count the alignments starting in each bin, splitting the BAM file into region chunks that are processed by
+// options.numThreads threads, each with its own BGZF stream.
+
+int computeCoverageParallel(seqan::String<seqan::String<BinData> > & bins,
+                            seqan::FaiIndex const & faiIndex,
+                            FxBamCoverageOptions const & options)
+{
+    typedef seqan::StringSet<seqan::CharString> TNameStore;
+    typedef seqan::NameStoreCache<TNameStore>   TNameStoreCache;
+    typedef seqan::BamIOContext<TNameStore>     TBamIOContext;
+
+    // Load the BAI index or build it if there is none.
+    seqan::BamIndex<seqan::Bai> baiIndex;
+    seqan::CharString baiPath = options.inBamPath;
+    append(baiPath, ".bai");
+    if (read(baiIndex, toCString(baiPath)) != 0)
+    {
+        if (options.verbosity >= 2)
+            std::cerr << " (building BAI index)";
+        if (!buildIndex(baiIndex, toCString(options.inBamPath), options.numThreads))
+        {
+            std::cerr << "ERROR: Could not build BAI index for " << options.inBamPath << "!\n";
+            return 1;
+        }
+    }
+
+    // Map the BAM reference ids to the contig ids of the FAI index.  This is done once up front since the lookup
+    // through the name store cache is not thread-safe.
+    seqan::String<int> contigIds;
+    {
+        seqan::Stream<seqan::Bgzf> stream;
+        if (!open(stream, toCString(options.inBamPath), "r"))
+        {
+            std::cerr << "Could not open " << options.inBamPath << "!\n";
+            return 1;
+        }
+        TNameStore nameStore;
+        TNameStoreCache nameStoreCache(nameStore);
+        TBamIOContext bamIOContext(nameStore, nameStoreCache);
+        seqan::BamHeader header;
+        if (readRecord(header, bamIOContext, stream, seqan::Bam()) != 0)
+        {
+            std::cerr << "ERROR: Could not read header from BAM file!\n";
+            return 1;
+        }
+        resize(contigIds, length(nameStore), -1);
+        for (unsigned i = 0; i < length(nameStore); ++i)
+            getIdByName(faiIndex, nameStore[i], contigIds[i]);
+    }
+
+    seqan::String<seqan::BamRegionChunk> chunks;
+    computeRegionChunks(chunks, baiIndex, options.numThreads * 4);
+
+    // Set by any worker thread on errors, the others stop processing chunks then.
+    unsigned volatile failed = 0;
+    SEQAN_OMP_PRAGMA(parallel num_threads(options.numThreads))
+    {
+        // Each thread reads with its own stream and context.
+        seqan::Stream<seqan::Bgzf> stream;
+        TNameStore nameStore;
+        TNameStoreCache nameStoreCache(nameStore);
+        TBamIOContext bamIOContext(nameStore, nameStoreCache);
+        seqan::BamHeader header;
+        if (!open(stream, toCString(options.inBamPath), "r") ||
+            readRecord(header, bamIOContext, stream, seqan::Bam()) != 0)
+            seqan::atomicCas(failed, 0u, 1u);
+
+        seqan::BamAlignmentRecord record;
+        SEQAN_OMP_PRAGMA(for schedule(dynamic))
+        for (int i = 0; i < static_cast<int>(length(chunks)); ++i)
+        {
+            if (failed)
+                continue;
+
+            bool hasRecord = false;
+            if (!jumpToRegionChunk(stream, hasRecord, bamIOContext, chunks[i], baiIndex))
+            {
+                seqan::atomicCas(failed, 0u, 1u);
+                continue;
+            }
+
+            while (hasRecord)
+            {
+                if (readRegionChunkRecord(record, hasRecord, bamIOContext, stream, chunks[i]) != 0)
+                {
+                    seqan::atomicCas(failed, 0u, 1u);
+                    break;
+                }
+                if (!hasRecord || hasFlagUnmapped(record) || hasFlagSecondary(record))
+                    continue;  // Skip these records.
+
+                int contigId = contigIds[record.rID];
+                if (contigId < 0)
+                {
+                    seqan::atomicCas(failed, 0u, 1u);
+                    break;
+                }
+                unsigned binNo = record.beginPos / options.windowSize;
+                seqan::atomicInc(bins[contigId][binNo].coverage);
+            }
+        }
+    }
+
+    if (failed)
+    {
+        std::cerr << "ERROR: Could not read records from BAM file or alignment to unknown contig!\n";
+        return 1;
+    }
+    return 0;
+}
+
 // ---------------------------------------------------------------------------
 // Function main()
 // ---------------------------------------------------------------------------
@@ -178,7 +345,8 @@ int main(int argc, char const ** argv)
                   << "GENOME       " << options.inGenomePath << "\n"
                   << "SAM/BAM      " << options.inBamPath << "\n"
                   << "OUT          " << options.outPath << "\n"
-                  << "WINDOW SIZE  " << options.windowSize << "\n";
+                  << "WINDOW SIZE  " << options.windowSize << "\n"
+                  << "THREADS      " << options.numThreads << "\n";
     }
 
     // -----------------------------------------------------------------------
@@ -244,35 +412,16 @@ int main(int argc, char const ** argv)
               << "\n"
               << "Computing Coverage...";
 
-    seqan::BamStream bamStream(toCString(options.inBamPath));
-    if (!isGood(bamStream))
-    {
-        std::cerr << "Could not open " << options.inBamPath << "!\n";
+    // BAM files are processed in parallel, split into chunks using the BAI index.
+    bool isBam = length(options.inBamPath) >= 4u &&
+                 suffix(options.inBamPath, length(options.inBamPath) - 4) == ".bam";
+    int covRes = 0;
+    if (options.numThreads > 1u && isBam)
+        covRes = computeCoverageParallel(bins, faiIndex, options);
+    else
+        covRes = computeCoverage(bins, faiIndex, options);
+    if (covRes != 0)
         return 1;
-    }
-
-    seqan::BamAlignmentRecord record;
-    while (!atEnd(bamStream))
-    {
-        if (readRecord(record, bamStream) != 0)
-        {
-            std::cerr << "ERROR: Could not read record from BAM file!\n";
-            return 1;
-        }
-
-        if (hasFlagUnmapped(record) || hasFlagSecondary(record) || record.rID == seqan::BamAlignmentRecord::INVALID_REFID)
-            continue;  // Skip these records.
-
-        int contigId = 0;
-        seqan::CharString const & contigName = nameStore(bamStream.bamIOContext)[record.rID];
-        if (!getIdByName(faiIndex, contigName, contigId))
-        {
-            std::cerr << "ERROR: Alignment to unknown contig " << contigId << "!\n";
-            return 1;
-        }
-        unsigned binNo = record.beginPos / options.windowSize;
-        bins[contigId][binNo].coverage += 1;
-    }
 
     std::cerr << "DONE\n";
 
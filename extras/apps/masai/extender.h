@@ -61,6 +61,7 @@ template <typename TMatchesDelegate, typename TDistance = HammingDistance, typen
 struct Extender
 {
     TFragmentStore &        store;
+    TContigStore &          contigStore;
     TMatchesDelegate &      matchesDelegate;
     String<TContigSeqSize>  contigSizes;
     TReadSeqStoreSize       readsCount;
@@ -76,6 +77,25 @@ struct Extender
              TReadSeqStoreSize readsCount,
              bool disabled = false) :
         store(store),
+        contigStore(store.contigStore),
+        matchesDelegate(matchesDelegate),
+        readsCount(readsCount),
+        minErrorsPerRead(0),
+        maxErrorsPerRead(0),
+        seedLength(0),
+        disabled(disabled)
+    {
+        _init(*this);
+    }
+
+    // The contigs can live in a different store than the reads, e.g. when mapping reads in batches.
+    Extender(TFragmentStore & store,
+             TContigStore & contigStore,
+             TMatchesDelegate & matchesDelegate,
+             TReadSeqStoreSize readsCount,
+             bool disabled = false) :
+        store(store),
+        contigStore(contigStore),
         matchesDelegate(matchesDelegate),
         readsCount(readsCount),
         minErrorsPerRead(0),
@@ -110,6 +130,14 @@ struct Extender<TMatchesDelegate, EditDistance, TSpec>:
              bool disabled = false) :
         TBase(store, matchesDelegate, readsCount, disabled)
     {}
+
+    Extender(TFragmentStore & store,
+             TContigStore & contigStore,
+             TMatchesDelegate & matchesDelegate,
+             TReadSeqStoreSize readsCount,
+             bool disabled = false) :
+        TBase(store, contigStore, matchesDelegate, readsCount, disabled)
+    {}
 };
 
 // ============================================================================
@@ -124,9 +152,9 @@ struct Extender<TMatchesDelegate, EditDistance, TSpec>:
 template <typename TMatchesDelegate, typename TDistance, typename TSpec>
 inline void _init(Extender<TMatchesDelegate, TDistance, TSpec> & extender)
 {
-    reserve(extender.contigSizes, length(extender.store.contigStore), Exact());
-    for (TContigStoreSize contigId = 0; contigId < length(extender.store.contigStore); ++contigId)
-        appendValue(extender.contigSizes, length(extender.store.contigStore[contigId].seq));
+    reserve(extender.contigSizes, length(extender.contigStore), Exact());
+    for (TContigStoreSize contigId = 0; contigId < length(extender.contigStore); ++contigId)
+        appendValue(extender.contigSizes, length(extender.contigStore[contigId].seq));
 }
 
 // TODO(esiragusa): Remove this.
@@ -162,7 +190,7 @@ inline bool onSeedHit(Extender<TMatchesDelegate, HammingDistance, TSpec> & exten
 
     TReadSeqSize errors = seedErrors;
 
-    TContigSeq & contig = extender.store.contigStore[contigId].seq;
+    TContigSeq & contig = extender.contigStore[contigId].seq;
     TReadSeq & read = extender.store.readSeqStore[readId];
     TReadSeqSize readLength = length(read);
 
@@ -259,7 +287,7 @@ inline bool onSeedHit(Extender<TMatchesDelegate, EditDistance, TSpec> & extender
 
     TReadSeqSize errors = seedErrors;
 
-    TContigSeq & contig = extender.store.contigStore[contigId].seq;
+    TContigSeq & contig = extender.contigStore[contigId].seq;
     TReadSeq & read = extender.store.readSeqStore[readId];
     TReadSeqSize readLength = length(read);
 
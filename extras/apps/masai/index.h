@@ -417,6 +417,14 @@ bool load(GenomeIndex<TGenome, TIndex, TSpec> & genomeIndex, TString const & gen
     return open(genomeIndex.index, toCString(genomeIndexFile));
 }
 
+template <typename TGenome, typename TIndex, typename TSpec, typename TString>
+bool load(GenomeIndex<TGenome, TIndex, TSpec> & genomeIndex, TString const & genomeIndexFile, int openMode)
+{
+    genomeIndex.index = TIndex(genomeIndex.genome.contigs);
+
+    return open(genomeIndex.index, toCString(genomeIndexFile), openMode);
+}
+
 // ----------------------------------------------------------------------------
 // Function build()                                               [GenomeIndex]
 // ----------------------------------------------------------------------------
@@ -457,6 +465,12 @@ bool dump(GenomeIndex<TGenome, TIndex, TSpec> & genomeIndex, TString const & gen
     return save(genomeIndex.index, toCString(genomeIndexFile));
 }
 
+template <typename TGenome, typename TIndex, typename TSpec, typename TString>
+bool dump(GenomeIndex<TGenome, TIndex, TSpec> & genomeIndex, TString const & genomeIndexFile, int openMode)
+{
+    return save(genomeIndex.index, toCString(genomeIndexFile), openMode);
+}
+
 // ----------------------------------------------------------------------------
 // Function clear()                                               [GenomeIndex]
 // ----------------------------------------------------------------------------
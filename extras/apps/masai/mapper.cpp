@@ -36,6 +36,7 @@
 
 #include <seqan/basic.h>
 #include <seqan/sequence.h>
+#include <seqan/parallel.h>
 
 #include "options.h"
 #include "index.h"
@@ -56,6 +57,7 @@ struct Options : public MasaiOptions
 {
     CharString  genomeFile;
     CharString  genomeIndexFile;
+    CharString  genomeIndexShm;
     IndexType   genomeIndexType;
     CharString  readsFile;
     int         mappingBlock;
@@ -69,6 +71,9 @@ struct Options : public MasaiOptions
     unsigned    seedLength;
     bool        mismatchesOnly;
 
+    unsigned    threadsCount;
+    unsigned    batchSize;
+
     bool        noVerify;
     bool        noDump;
     bool        noMultiple;
@@ -83,6 +88,8 @@ struct Options : public MasaiOptions
         errorsPerRead(5),
         seedLength(33),
         mismatchesOnly(false),
+        threadsCount(1),
+        batchSize(10000),
         noVerify(false),
         noDump(false),
         noMultiple(false)
@@ -135,11 +142,20 @@ void setupArgumentParser(ArgumentParser & parser, Options const & options)
 
     addOption(parser, ArgParseOption("ng", "no-gaps", "Do not align reads with gaps."));
 
+    addOption(parser, ArgParseOption("t", "threads", "Number of threads.", ArgParseOption::INTEGER));
+    setMinValue(parser, "threads", "1");
+    setDefaultValue(parser, "threads", options.threadsCount);
+
+    addOption(parser, ArgParseOption("bs", "batch-size", "Number of reads mapped at once by one thread.", ArgParseOption::INTEGER));
+    setMinValue(parser, "batch-size", "1");
+    setDefaultValue(parser, "batch-size", options.batchSize);
+
 
     addSection(parser, "Genome Index Options");
 
     setIndexType(parser, options);
     setIndexPrefix(parser);
+    setIndexSharedMemory(parser);
 
 
     addSection(parser, "Output Options");
@@ -184,9 +200,16 @@ parseCommandLine(Options & options, ArgumentParser & parser, int argc, char cons
     getOptionValue(options.seedLength, parser, "seed-length");
     options.mismatchesOnly = isSet(parser, "no-gaps");
 
+    // Parse threads count.
+    getOptionValue(options.threadsCount, parser, "threads");
+    getOptionValue(options.batchSize, parser, "batch-size");
+
     // Parse genome index prefix.
     getIndexPrefix(options, parser);
 
+    // Parse genome index shared memory name.
+    getIndexSharedMemory(options, parser);
+
     // Parse genome index type.
     getIndexType(options, parser);
 
@@ -205,6 +228,51 @@ parseCommandLine(Options & options, ArgumentParser & parser, int argc, char cons
     return seqan::ArgumentParser::PARSE_OK;
 }
 
+// ----------------------------------------------------------------------------
+// Function mapReadsInBatches()
+// ----------------------------------------------------------------------------
+
+// The reads are split into batches of a fixed size, many more than threads, which are
+// scheduled dynamically.  Each batch is mapped by its own mapper, sharing the genome
+// index and the contigs.  The batch reads are copied into a store owned by the thread,
+// which is reused for all its batches.  The matches of each batch are buffered and
+// passed to the writer in batch order.
+template <typename TMapperConfig, typename TReads, typename TGenomeIndex, typename TWriter>
+void mapReadsInBatches(Options const & options, TReads & reads, TGenomeIndex & genomeIndex, TWriter & writer)
+{
+    typedef MatchCollector<>                                    TCollector;
+    typedef Mapper<TReads, TCollector, void, TMapperConfig>     TMapper;
+
+    int batchesCount = (reads.readsCount + options.batchSize - 1) / options.batchSize;
+
+    String<TCollector> collectors;
+    resize(collectors, batchesCount);
+
+    String<TFragmentStore> threadStores;
+    resize(threadStores, options.threadsCount);
+
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic, 1) num_threads(options.threadsCount))
+    for (int batchId = 0; batchId < batchesCount; ++batchId)
+    {
+        unsigned readsBegin = batchId * options.batchSize;
+        unsigned readsEnd = std::min(readsBegin + options.batchSize, reads.readsCount);
+
+        TReads batchReads(threadStores[omp_get_thread_num()]);
+        assignBatch(batchReads, reads, readsBegin, readsEnd);
+
+        TCollector & collector = collectors[batchId];
+        collector.readIdOffset = readsBegin;
+
+        TMapper mapper(batchReads, genomeIndex.genome._store.contigStore, collector, options.noVerify);
+        setSeedLength(mapper, options.seedLength);
+        setReads(mapper, batchReads);
+        mapReads(mapper, genomeIndex, options.errorsPerRead);
+    }
+
+    for (int batchId = 0; batchId < batchesCount; ++batchId)
+        flush(collectors[batchId], writer);
+}
+
 // ----------------------------------------------------------------------------
 // Function runMapper()
 // ----------------------------------------------------------------------------
@@ -243,7 +311,12 @@ int runMapper(Options & options, TMapperConfig const & /* config */, TReadsConfi
     // Load genome index.
     std::cout << "Loading genome index:\t\t" << std::flush;
     start = sysTime();
-    if (!load(genomeIndex, options.genomeIndexFile))
+    bool loaded;
+    if (empty(options.genomeIndexShm))
+        loaded = load(genomeIndex, options.genomeIndexFile);
+    else
+        loaded = load(genomeIndex, options.genomeIndexShm, OPEN_RDONLY | OPEN_SHARED_MEMORY);
+    if (!loaded)
     {
         std::cout << "Error while loading genome index" << std::endl;
         return 1;
@@ -292,14 +365,21 @@ int runMapper(Options & options, TMapperConfig const & /* config */, TReadsConfi
         // Pass reads to writer.
         setReads(writer, reads);
 
-        // Configure mapper.
-        TMapper mapper(reads, writer, options.noVerify);
-        setSeedLength(mapper, options.seedLength);
-        setReads(mapper, reads);
-
         // Map reads.
         start = sysTime();
-        mapReads(mapper, genomeIndex, options.errorsPerRead);
+        if (options.threadsCount > 1)
+        {
+            mapReadsInBatches<TMapperConfig>(options, reads, genomeIndex, writer);
+        }
+        else
+        {
+            // Configure mapper.
+            TMapper mapper(reads, writer, options.noVerify);
+            setSeedLength(mapper, options.seedLength);
+            setReads(mapper, reads);
+
+            mapReads(mapper, genomeIndex, options.errorsPerRead);
+        }
         finish = sysTime();
         std::cout << "Mapping time:\t\t\t" << std::flush;
         std::cout << finish - start << " sec" << std::endl;
@@ -98,6 +98,17 @@ struct Mapper
     {
         _seeder.readsCount = reads.readsCount;
     }
+
+    Mapper(TReads & reads, TContigStore & contigStore, TDelegate & delegate, bool disableExtender = false) :
+        reads(reads),
+        delegate(delegate),
+        _manager(delegate, reads.readsCount),
+        _extender(value(reads._store), contigStore, _manager, reads.readsCount, disableExtender),
+        _seeder(value(reads._store), _manager, _extender),
+        _seedLength(0)
+    {
+        _seeder.readsCount = reads.readsCount;
+    }
 };
 
 // ----------------------------------------------------------------------------
@@ -152,6 +152,22 @@ struct MatchStore
     TSorterPool sorterPool;
 };
 
+// ----------------------------------------------------------------------------
+// Class MatchCollector
+// ----------------------------------------------------------------------------
+
+// Matches delegate buffering the matches of one batch of reads until they can be passed on in order.
+template <typename TSpec = void, typename TMatch = Match<TSpec> >
+struct MatchCollector
+{
+    String<TMatch>  matches;
+    unsigned        readIdOffset;
+
+    MatchCollector() :
+        readIdOffset(0)
+    {}
+};
+
 // ============================================================================
 // Metafunctions
 // ============================================================================
@@ -257,6 +273,41 @@ inline void onMatch(TMatchesDelegate & matchesDelegate, Match<TSpec> const & mat
             matchRev.beginPos, endPos(matchRev), matchRev.readId, matchRev.errors);
 }
 
+// ----------------------------------------------------------------------------
+// Function onMatch()                                          [MatchCollector]
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TMatch,
+          typename TContigId, typename TContigPos, typename TReadId, typename TErrors>
+inline void onMatch(MatchCollector<TSpec, TMatch> & collector,
+                    TContigId contigId,
+                    TContigPos beginPos,
+                    TContigPos endPos,
+                    TReadId readId,
+                    TErrors errors,
+                    bool reverseComplemented)
+{
+    TMatch match;
+    fill(match, contigId, beginPos, endPos, collector.readIdOffset + readId, errors, reverseComplemented);
+    appendValue(collector.matches, match, Generous());
+}
+
+// ----------------------------------------------------------------------------
+// Function flush()                                            [MatchCollector]
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TMatch, typename TMatchesDelegate>
+inline void flush(MatchCollector<TSpec, TMatch> & collector, TMatchesDelegate & matchesDelegate)
+{
+    typedef typename Iterator<String<TMatch> const, Standard>::Type     TIterator;
+
+    TIterator matchesEnd = end(collector.matches, Standard());
+    for (TIterator matchesIt = begin(collector.matches, Standard()); matchesIt != matchesEnd; ++matchesIt)
+        onMatch(matchesDelegate, *matchesIt);
+
+    clear(collector.matches);
+}
+
 // ----------------------------------------------------------------------------
 // Function open()                                                 [MatchStore]
 // ----------------------------------------------------------------------------
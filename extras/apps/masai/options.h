@@ -306,6 +306,27 @@ void getIndexPrefix(TOptions & options, ArgumentParser const & parser)
         options.genomeIndexFile = trimExtension(options.genomeFile);
 }
 
+// ----------------------------------------------------------------------------
+// Function setIndexSharedMemory()
+// ----------------------------------------------------------------------------
+
+void setIndexSharedMemory(ArgumentParser & parser)
+{
+    addOption(parser, ArgParseOption("xs", "index-shared-memory", "Use the genome index placed into shared memory \
+                                     by masai_shm under this name, e.g. /hg19. \
+                                     Default: load the genome index from the index prefix.", ArgParseOption::STRING));
+}
+
+// ----------------------------------------------------------------------------
+// Function getIndexSharedMemory()
+// ----------------------------------------------------------------------------
+
+template <typename TOptions>
+void getIndexSharedMemory(TOptions & options, ArgumentParser const & parser)
+{
+    getOptionValue(options.genomeIndexShm, parser, "index-shared-memory");
+}
+
 // ----------------------------------------------------------------------------
 // Function getOutputFormat()
 // ----------------------------------------------------------------------------
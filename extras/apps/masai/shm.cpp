@@ -0,0 +1,280 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2011, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// This file contains the masai_shm application.  It places a genome index
+// into named POSIX shared memory objects, one per index fibre, such that
+// all masai_mapper processes on a node can attach to the same copy.
+// ==========================================================================
+
+#define SEQAN_EXTRAS_MASAI_DISABLE_MMAP
+
+#include <seqan/basic.h>
+#include <seqan/sequence.h>
+#include <seqan/file.h>
+
+#include "options.h"
+#include "index.h"
+
+using namespace seqan;
+
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class Options
+// ----------------------------------------------------------------------------
+
+struct Options : public MasaiOptions
+{
+    CharString genomeFile;
+    CharString genomeIndexFile;
+    CharString genomeIndexShm;
+    IndexType  genomeIndexType;
+    bool       remove;
+
+    Options() :
+        MasaiOptions(),
+        genomeIndexType(INDEX_SA),
+        remove(false)
+    {}
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function setupArgumentParser()                              [ArgumentParser]
+// ----------------------------------------------------------------------------
+
+void setupArgumentParser(ArgumentParser & parser, Options const & options)
+{
+    setAppName(parser, "masai_shm");
+    setShortDescription(parser, "Masai Shared Memory Index");
+    setCategory(parser, "Read Mapping");
+
+    setDateAndVersion(parser);
+    setDescription(parser);
+
+    addUsageLine(parser, "[\\fIOPTIONS\\fP] <\\fIGENOME FILE\\fP> <\\fISHARED MEMORY NAME\\fP>");
+
+    addArgument(parser, ArgParseArgument(ArgParseArgument::INPUTFILE));
+    setValidValues(parser, 0, "fasta fa");
+
+    addArgument(parser, ArgParseArgument(ArgParseArgument::STRING));
+
+    addSection(parser, "Genome Index Options");
+
+    setIndexType(parser, options);
+    setIndexPrefix(parser);
+
+    addOption(parser, ArgParseOption("r", "remove", "Remove the genome index from shared memory. \
+                                     Running mappers keep their mapping until they exit."));
+}
+
+// ----------------------------------------------------------------------------
+// Function parseCommandLine()                                        [Options]
+// ----------------------------------------------------------------------------
+
+ArgumentParser::ParseResult
+parseCommandLine(Options & options, ArgumentParser & parser, int argc, char const ** argv)
+{
+    ArgumentParser::ParseResult res = parse(parser, argc, argv);
+
+    if (res != seqan::ArgumentParser::PARSE_OK)
+        return res;
+
+    // Parse genome input file.
+    getArgumentValue(options.genomeFile, parser, 0);
+
+    // Parse shared memory name.
+    getArgumentValue(options.genomeIndexShm, parser, 1);
+
+    // POSIX shared memory names consist of one leading slash followed by a name without slashes.
+    if (length(options.genomeIndexShm) < 2 || options.genomeIndexShm[0] != '/' ||
+        std::find(begin(options.genomeIndexShm) + 1, end(options.genomeIndexShm), '/') != end(options.genomeIndexShm))
+    {
+        std::cerr << getAppName(parser) << ": The shared memory name must be of the form /name" << std::endl;
+        return seqan::ArgumentParser::PARSE_ERROR;
+    }
+
+    // Parse genome index prefix.
+    getIndexPrefix(options, parser);
+
+    // Parse genome index type.
+    getIndexType(options, parser);
+
+    options.remove = isSet(parser, "remove");
+
+    return seqan::ArgumentParser::PARSE_OK;
+}
+
+// ----------------------------------------------------------------------------
+// Function removeShm()
+// ----------------------------------------------------------------------------
+
+// Removes the shared memory object <shm><suffix> of every index file <prefix><suffix>.
+
+int removeShm(Options & options)
+{
+    CharString const & indexPrefix = options.genomeIndexFile;
+
+    Size<CharString>::Type dirLength = length(indexPrefix);
+    while (dirLength > 0 && indexPrefix[dirLength - 1] != '/')
+        --dirLength;
+
+    CharString dirName = prefix(indexPrefix, dirLength);
+    CharString baseName = suffix(indexPrefix, dirLength);
+    if (empty(dirName))
+        dirName = ".";
+
+    Directory dir;
+    if (!open(dir, toCString(dirName)))
+    {
+        std::cerr << "Error while listing " << dirName << std::endl;
+        return 1;
+    }
+
+    unsigned removed = 0;
+    for (; !atEnd(dir); goNext(dir))
+    {
+        CharString fileName = value(dir);
+        if (length(fileName) <= length(baseName) || prefix(fileName, length(baseName)) != baseName)
+            continue;
+
+        CharString shmName = options.genomeIndexShm;
+        append(shmName, suffix(fileName, length(baseName)));
+        if (removeSharedMemory(toCString(shmName)))
+            ++removed;
+    }
+    close(dir);
+
+    std::cout << "Removed shared memory objects:\t" << removed << std::endl;
+
+    return removed == 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function runShm()
+// ----------------------------------------------------------------------------
+
+template <typename TIndex>
+int runShm(Options & options)
+{
+    typedef Genome<>                        TGenome;
+    typedef GenomeIndex<TGenome, TIndex>    TGenomeIndex;
+
+    if (options.remove)
+        return removeShm(options);
+
+    TFragmentStore      store;
+    TGenome             genome(store);
+    TGenomeIndex        genomeIndex(genome);
+
+    double start, finish;
+
+    std::cout << "Loading genome:\t\t\t" << std::flush;
+    start = sysTime();
+    if (!load(genome, options.genomeFile))
+    {
+        std::cerr << "Error while loading genome" << std::endl;
+        return 1;
+    }
+    finish = sysTime();
+    std::cout << finish - start << " sec" << std::endl;
+
+    std::cout << "Loading genome index:\t\t" << std::flush;
+    start = sysTime();
+    if (!load(genomeIndex, options.genomeIndexFile))
+    {
+        std::cerr << "Error while loading genome index" << std::endl;
+        return 1;
+    }
+    finish = sysTime();
+    std::cout << finish - start << " sec" << std::endl;
+
+    std::cout << "Dumping genome index to shm:\t" << std::flush;
+    start = sysTime();
+    if (!dump(genomeIndex, options.genomeIndexShm, OPEN_RDWR | OPEN_CREATE | OPEN_SHARED_MEMORY))
+    {
+        std::cerr << "Error while dumping genome index" << std::endl;
+        return 1;
+    }
+    finish = sysTime();
+    std::cout << finish - start << " sec" << std::endl;
+
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Functions configure*()
+// ----------------------------------------------------------------------------
+
+int configureIndex(Options & options)
+{
+    switch (options.genomeIndexType)
+    {
+    case Options::INDEX_ESA:
+        return runShm<TGenomeEsa>(options);
+
+    case Options::INDEX_SA:
+        return runShm<TGenomeSa>(options);
+
+    case Options::INDEX_QGRAM:
+        return runShm<TGenomeQGram>(options);
+
+    case Options::INDEX_FM:
+        return runShm<TGenomeFM>(options);
+
+    default:
+        return 1;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function main()
+// ----------------------------------------------------------------------------
+
+int main(int argc, char const ** argv)
+{
+    ArgumentParser parser;
+    Options options;
+    setupArgumentParser(parser, options);
+
+    ArgumentParser::ParseResult res = parseCommandLine(options, parser, argc, argv);
+
+    if (res != seqan::ArgumentParser::PARSE_OK)
+        return res == seqan::ArgumentParser::PARSE_ERROR;
+
+    return configureIndex(options);
+}
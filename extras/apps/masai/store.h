@@ -430,6 +430,36 @@ inline TReadId getReadId(Reads<TSpec, TConfig> const & reads, TReadId readId)
     return readId;
 }
 
+// ----------------------------------------------------------------------------
+// Function assignBatch()                                               [Reads]
+// ----------------------------------------------------------------------------
+
+// Assigns the reads in [readsBegin, readsEnd) of source, followed by their reverse complements, to target.
+template <typename TSpec, typename TConfig, typename TSize>
+void assignBatch(Reads<TSpec, TConfig> & target, Reads<TSpec, TConfig> const & source,
+                 TSize readsBegin, TSize readsEnd)
+{
+    SEQAN_ASSERT_LEQ(readsBegin, readsEnd);
+    SEQAN_ASSERT_LEQ(readsEnd, source.readsCount);
+
+    clear(target);
+
+    TSize readsCount = readsEnd - readsBegin;
+    target._avgSeqLengthEstimate = source._avgSeqLengthEstimate;
+    target._avgNameLengthEstimate = source._avgNameLengthEstimate;
+    target._countEstimate = readsCount;
+    target.readsCount = readsCount;
+
+    reserve(getSeqs(target).concat, 2 * readsCount * source._avgSeqLengthEstimate, Exact());
+    reserve(getSeqs(target), 2 * readsCount, Exact());
+
+    for (TSize readId = readsBegin; readId < readsEnd; ++readId)
+        appendSeq(target, getSeqs(source)[readId]);
+
+    for (TSize readId = readsBegin; readId < readsEnd; ++readId)
+        appendSeq(target, getSeqs(source)[source.readsCount + readId]);
+}
+
 // ----------------------------------------------------------------------------
 // Function avgSeqLength()                                              [Reads]
 // ----------------------------------------------------------------------------
@@ -1145,7 +1145,7 @@ void _mapMatePairReadsParallel(
     // -----------------------------------------------------------------------
     // Perform filtration.
     // -----------------------------------------------------------------------
-    TaskQueue<TVerificationJob, OmpLock> taskQueue;
+    WorkStealingQueue<TVerificationJob> taskQueue(omp_get_max_threads());
     volatile unsigned leaderWindowsDone = 0;  // Number of windows done in leaders.
     volatile unsigned threadsFiltering = options.threadCount;
 
@@ -1281,7 +1281,7 @@ void _mapMatePairReadsParallel(
                     appendValue(jobs, TVerificationJob(tls.threadId, tls.verificationResults, store, contigId, orientation, previousLeftHits, previousLeftHitsSplitters[i], previousLeftHitsSplitters[i + 1], leftHits, leftHitsSplitters[i], leftHitsSplitters[i + 1], rightHits, rightHitsSplitters[i], rightHitsSplitters[i + 1], rightWindowBegin, *tls.globalOptions, tls.filterPatternL, tls.filterPatternR));
                 }
 
-                pushFront(taskQueue, jobs);
+                pushFront(taskQueue, jobs, omp_get_thread_num());
             }
             tls.options.timeFiltration += sysTime() - filterStart;
 #ifdef RAZERS_PROFILE
@@ -1292,7 +1292,7 @@ void _mapMatePairReadsParallel(
             while (leaderWindowsDone == windowsDone)
             {
                 TVerificationJob job;
-                if (!popFront(job, taskQueue))
+                if (!popFront(job, taskQueue, omp_get_thread_num()))
                     break;
                 workVerification(tls, job, splitters);
             }
@@ -1326,7 +1326,7 @@ void _mapMatePairReadsParallel(
         while (threadsFiltering > 0u)
         {
             TVerificationJob job;
-            if (popFront(job, taskQueue))
+            if (popFront(job, taskQueue, omp_get_thread_num()))
                 workVerification(tls, job, splitters);
         }
 
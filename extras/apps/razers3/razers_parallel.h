@@ -4,7 +4,6 @@
 // TODO(holtgrew): Ideally, we do not need any locks.
 
 #include "parallel_misc.h"
-#include "parallel_job_queue.h"
 #include "razers_match_filter.h"
 
 namespace seqan {
@@ -16,6 +15,9 @@ namespace seqan {
 template <typename TSpec>
 class Lock;
 
+template <typename TSpec>
+class Job;
+
 struct Omp_;
 typedef Tag<Omp_> Omp;
 
@@ -631,7 +633,7 @@ void _mapSingleReadsParallelToContig(
     // -----------------------------------------------------------------------
     // Perform filtration.
     // -----------------------------------------------------------------------
-    TaskQueue<TVerificationJob, OmpLock> taskQueue;
+    WorkStealingQueue<TVerificationJob> taskQueue(omp_get_max_threads());
     volatile unsigned leaderWindowsDone = 0;  // Number of windows done in leaders.
     volatile unsigned threadsFiltering = options.threadCount;
 
@@ -729,7 +731,7 @@ void _mapSingleReadsParallelToContig(
 // SEQAN_OMP_PRAGMA(critical)
 //                     std::cerr << "new job(" << tls.threadId << ", tls.verificationResults, store, " << contigId << ", " << windowsDone - 1 << ", hitsPtr, " << i - 1 << ", " << splitters[i - 1] << ", " << splitters[i] << ", *tls.globalOptions, tls.filterPattern)" << std::endl;
                 }
-                pushFront(taskQueue, jobs);
+                pushFront(taskQueue, jobs, omp_get_thread_num());
 
                 // Preallocate space in bucket and initialize "to do" counter.
                 clear(tls.verificationResultBuckets[windowsDone - 1]);
@@ -751,7 +753,7 @@ void _mapSingleReadsParallelToContig(
             while (leaderWindowsDone == windowsDone)
             {
                 TVerificationJob job;
-                if (!popFront(job, taskQueue))
+                if (!popFront(job, taskQueue, omp_get_thread_num()))
                     break;
                 // fprintf(stderr, "[verify]");
                 workVerification(tls, job, splitters);
@@ -788,7 +790,7 @@ void _mapSingleReadsParallelToContig(
         while (threadsFiltering > 0u)
         {
             TVerificationJob job;
-            if (popFront(job, taskQueue))
+            if (popFront(job, taskQueue, omp_get_thread_num()))
                 workVerification(tls, job, splitters);
         }
 
@@ -0,0 +1,480 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Interface for computing batches of pairwise alignments with the
+// inter-sequence vectorized dp kernel.
+// ==========================================================================
+
+#ifndef SEQAN_EXTRAS_INCLUDE_SEQAN_ALIGN_SIMD_ALIGN_SIMD_INTERFACE_H_
+#define SEQAN_EXTRAS_INCLUDE_SEQAN_ALIGN_SIMD_ALIGN_SIMD_INTERFACE_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _alignmentScoreSequential()
+// ----------------------------------------------------------------------------
+
+// Used for the pairs that cannot be computed in the lanes of a SIMD vector.
+
+template <typename TScoreValue, typename TSeqH, typename TSeqV, typename TScoreSpec>
+inline TScoreValue
+_alignmentScoreSequential(TSeqH const & seqH,
+                          TSeqV const & seqV,
+                          Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                          Tag<GlobalAlignment_<> > const &)
+{
+    // The sequential dp requires non-empty sequences.
+    if (empty(seqH) || empty(seqV))
+    {
+        unsigned gapLength = length(seqH) + length(seqV);
+        return (gapLength == 0u) ? 0 : scoreGapOpen(scoringScheme) + (gapLength - 1) * scoreGapExtend(scoringScheme);
+    }
+    return globalAlignmentScore(seqH, seqV, scoringScheme);
+}
+
+template <typename TScoreValue, typename TSeqH, typename TSeqV, typename TScoreSpec>
+inline TScoreValue
+_alignmentScoreSequential(TSeqH const & seqH,
+                          TSeqV const & seqV,
+                          Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                          Tag<LocalAlignment_<> > const &)
+{
+    if (empty(seqH) || empty(seqV))
+        return 0;
+    DPScoutState_<Default> noState;
+    return _setUpAndRunAlignment(noState, seqH, seqV, scoringScheme, SmithWaterman(),
+                                 TracebackConfig_<SingleTrace, GapsLeft>());
+}
+
+// ----------------------------------------------------------------------------
+// Function _alignmentSequential()
+// ----------------------------------------------------------------------------
+
+template <typename TSequence, typename TAlignSpec, typename TScoreValue, typename TScoreSpec, typename TAlgoTag>
+inline TScoreValue
+_alignmentSequentialEmpty(Align<TSequence, TAlignSpec> & align,
+                          Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                          TAlgoTag const & algoTag)
+{
+    String<TraceSegment_<unsigned, unsigned> > traceSegments;
+    if (IsSameType<TAlgoTag, Tag<GlobalAlignment_<> > >::VALUE)
+    {
+        _recordSegment(traceSegments, 0u, 0u, length(source(row(align, 0))), +TraceBitMap_::HORIZONTAL);
+        _recordSegment(traceSegments, 0u, 0u, length(source(row(align, 1))), +TraceBitMap_::VERTICAL);
+    }
+    _adaptTraceSegmentsTo(row(align, 0), row(align, 1), traceSegments);
+    return _alignmentScoreSequential(source(row(align, 0)), source(row(align, 1)), scoringScheme, algoTag);
+}
+
+template <typename TSequence, typename TAlignSpec, typename TScoreValue, typename TScoreSpec>
+inline TScoreValue
+_alignmentSequential(Align<TSequence, TAlignSpec> & align,
+                     Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                     Tag<GlobalAlignment_<> > const & algoTag)
+{
+    if (empty(source(row(align, 0))) || empty(source(row(align, 1))))
+        return _alignmentSequentialEmpty(align, scoringScheme, algoTag);
+    return globalAlignment(align, scoringScheme);
+}
+
+template <typename TSequence, typename TAlignSpec, typename TScoreValue, typename TScoreSpec>
+inline TScoreValue
+_alignmentSequential(Align<TSequence, TAlignSpec> & align,
+                     Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                     Tag<LocalAlignment_<> > const & algoTag)
+{
+    if (empty(source(row(align, 0))) || empty(source(row(align, 1))))
+        return _alignmentSequentialEmpty(align, scoringScheme, algoTag);
+    return localAlignment(align, scoringScheme);
+}
+
+// ----------------------------------------------------------------------------
+// Function _computeBatch()
+// ----------------------------------------------------------------------------
+
+// Computes the batch beginning at batchBegin in the SIMD lanes.  Returns false
+// if the batch does not fit into the lanes.
+
+#ifdef __SSE4_1__
+template <typename TSimdVector, typename TStringsH, typename TStringsV, typename TScoreValue, typename TScoreSpec,
+          typename TAlgoTag, typename TTraceFlag>
+inline bool
+_computeBatch(DPSimdBatch_<TSimdVector> & batch,
+              TStringsH const & stringsH,
+              TStringsV const & stringsV,
+              unsigned batchBegin,
+              Score<TScoreValue, TScoreSpec> const & scoringScheme,
+              TAlgoTag const & algoTag,
+              TTraceFlag const & traceFlag)
+{
+    if (!_initDPSimdBatch(batch, stringsH, stringsV, batchBegin, scoringScheme))
+        return false;
+
+    if (scoreGapOpen(scoringScheme) == scoreGapExtend(scoringScheme))
+        _computeDPSimdBatch(batch, stringsH, stringsV, batchBegin, scoringScheme, algoTag, LinearGaps(), traceFlag);
+    else
+        _computeDPSimdBatch(batch, stringsH, stringsV, batchBegin, scoringScheme, algoTag, AffineGaps(), traceFlag);
+    return true;
+}
+#endif  // #ifdef __SSE4_1__
+
+// ----------------------------------------------------------------------------
+// Function _alignmentScoreBatch()
+// ----------------------------------------------------------------------------
+
+template <typename TScoreValue, typename TSpec, typename TStringsH, typename TStringsV, typename TScoreSpec,
+          typename TAlgoTag>
+inline void
+_alignmentScoreBatch(String<TScoreValue, TSpec> & scores,
+                     TStringsH const & stringsH,
+                     TStringsV const & stringsV,
+                     Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                     TAlgoTag const & algoTag)
+{
+    SEQAN_ASSERT_EQ(length(stringsH), length(stringsV));
+
+    unsigned pairsCount = length(stringsH);
+    resize(scores, pairsCount, Exact());
+
+    unsigned pos = 0;
+#ifdef __SSE4_1__
+    // The lanes hold 16 bit scores, i.e. 8 pairs with SSE4 and 16 pairs with AVX2.
+    typedef typename SimdVector<short>::Type TSimdVector;
+    typedef DPSimdBatch_<TSimdVector> TBatch;
+
+    TBatch batch;
+    for (; pos < pairsCount; pos += batch.count)
+    {
+        if (!_computeBatch(batch, stringsH, stringsV, pos, scoringScheme, algoTag, False()))
+        {
+            for (unsigned k = 0; k < batch.count; ++k)
+                scores[pos + k] = _alignmentScoreSequential(stringsH[pos + k], stringsV[pos + k], scoringScheme,
+                                                            algoTag);
+            continue;
+        }
+        for (unsigned k = 0; k < batch.count; ++k)
+            scores[pos + k] = batch.score[k];
+    }
+#endif  // #ifdef __SSE4_1__
+
+    for (; pos < pairsCount; ++pos)
+        scores[pos] = _alignmentScoreSequential(stringsH[pos], stringsV[pos], scoringScheme, algoTag);
+}
+
+// ----------------------------------------------------------------------------
+// Function _alignmentBatch()
+// ----------------------------------------------------------------------------
+
+template <typename TScoreValue, typename TSpec, typename TSequence, typename TAlignSpec, typename TAlignsSpec,
+          typename TScoreSpec, typename TAlgoTag>
+inline void
+_alignmentBatch(String<TScoreValue, TSpec> & scores,
+                String<Align<TSequence, TAlignSpec>, TAlignsSpec> & aligns,
+                Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                TAlgoTag const & algoTag)
+{
+    unsigned pairsCount = length(aligns);
+    resize(scores, pairsCount, Exact());
+
+    unsigned pos = 0;
+#ifdef __SSE4_1__
+    typedef typename SimdVector<short>::Type TSimdVector;
+    typedef DPSimdBatch_<TSimdVector> TBatch;
+    typedef StringSet<TSequence, Dependent<> > TStrings;
+
+    // The rows of the alignments are accessed without copying the sequences.
+    TStrings stringsH;
+    TStrings stringsV;
+    reserve(stringsH, pairsCount, Exact());
+    reserve(stringsV, pairsCount, Exact());
+    for (unsigned k = 0; k < pairsCount; ++k)
+    {
+        SEQAN_ASSERT_EQ(length(rows(aligns[k])), 2u);
+        appendValue(stringsH, source(row(aligns[k], 0)));
+        appendValue(stringsV, source(row(aligns[k], 1)));
+    }
+
+    TBatch batch;
+    String<TraceSegment_<unsigned, unsigned> > traceSegments;
+    for (; pos < pairsCount; pos += batch.count)
+    {
+        if (!_computeBatch(batch, stringsH, stringsV, pos, scoringScheme, algoTag, True()))
+        {
+            for (unsigned k = 0; k < batch.count; ++k)
+                scores[pos + k] = _alignmentSequential(aligns[pos + k], scoringScheme, algoTag);
+            continue;
+        }
+        for (unsigned k = 0; k < batch.count; ++k)
+        {
+            scores[pos + k] = batch.score[k];
+            if (scoreGapOpen(scoringScheme) == scoreGapExtend(scoringScheme))
+                _tracebackDPSimdBatch(traceSegments, batch, k, algoTag, LinearGaps());
+            else
+                _tracebackDPSimdBatch(traceSegments, batch, k, algoTag, AffineGaps());
+            _adaptTraceSegmentsTo(row(aligns[pos + k], 0), row(aligns[pos + k], 1), traceSegments);
+        }
+    }
+#endif  // #ifdef __SSE4_1__
+
+    for (; pos < pairsCount; ++pos)
+        scores[pos] = _alignmentSequential(aligns[pos], scoringScheme, algoTag);
+}
+
+// ----------------------------------------------------------------------------
+// Function globalAlignmentScoreBatch()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn globalAlignmentScoreBatch
+ * @headerfile <seqan/align_simd.h>
+ * @brief Computes the global alignment scores of many pairs of sequences at once.
+ *
+ * @signature void globalAlignmentScoreBatch(scores, stringsH, stringsV, scoringScheme);
+ *
+ * @param[out] scores        A @link String @endlink of scores.  The i-th score belongs to the i-th pair.
+ * @param[in]  stringsH      A @link StringSet @endlink with the horizontal sequences.
+ * @param[in]  stringsV      A @link StringSet @endlink with the vertical sequences, same length as
+ *                           <tt>stringsH</tt>.
+ * @param[in]  scoringScheme The @link Score @endlink to use.  Linear gap costs are used if the gap open and gap
+ *                           extension scores are equal, affine gap costs otherwise.
+ *
+ * The pairs are aligned in batches, each lane of a SIMD vector computes one pair.  With SSE4.1 8 pairs and with AVX2
+ * 16 pairs are computed at once.  Batches whose scores could overflow the 16 bit lanes and all pairs on machines
+ * without SSE4.1 are computed with @link globalAlignmentScore @endlink.
+ *
+ * @see localAlignmentScoreBatch
+ * @see globalAlignmentBatch
+ */
+
+/**
+.Function.globalAlignmentScoreBatch
+..summary:Computes the global alignment scores of many pairs of sequences at once.
+..cat:Alignments
+..signature:globalAlignmentScoreBatch(scores, stringsH, stringsV, scoringScheme)
+..param.scores:The resulting scores, the i-th score belongs to the i-th pair.
+...type:Class.String
+..param.stringsH:The horizontal sequences.
+...type:Class.StringSet
+..param.stringsV:The vertical sequences, the same number as $stringsH$.
+...type:Class.StringSet
+..param.scoringScheme:The scoring scheme to use.
+Linear gap costs are used if the gap open and gap extension scores are equal, affine gap costs otherwise.
+...type:Class.Score
+..remarks:The pairs are aligned in batches, each lane of a SIMD vector computes one pair.
+With SSE4.1 8 pairs and with AVX2 16 pairs are computed at once.
+Batches whose scores could overflow the 16 bit lanes and all pairs on machines without SSE4.1 are computed with @Function.globalAlignmentScore@.
+..see:Function.localAlignmentScoreBatch
+..see:Function.globalAlignmentBatch
+..include:seqan/align_simd.h
+*/
+
+template <typename TScoreValue, typename TSpec, typename TStringH, typename TStringSetSpecH, typename TStringV,
+          typename TStringSetSpecV, typename TScoreSpec>
+inline void
+globalAlignmentScoreBatch(String<TScoreValue, TSpec> & scores,
+                          StringSet<TStringH, TStringSetSpecH> const & stringsH,
+                          StringSet<TStringV, TStringSetSpecV> const & stringsV,
+                          Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    _alignmentScoreBatch(scores, stringsH, stringsV, scoringScheme, Tag<GlobalAlignment_<> >());
+}
+
+// ----------------------------------------------------------------------------
+// Function localAlignmentScoreBatch()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn localAlignmentScoreBatch
+ * @headerfile <seqan/align_simd.h>
+ * @brief Computes the local alignment scores of many pairs of sequences at once.
+ *
+ * @signature void localAlignmentScoreBatch(scores, stringsH, stringsV, scoringScheme);
+ *
+ * @param[out] scores        A @link String @endlink of scores.  The i-th score belongs to the i-th pair.
+ * @param[in]  stringsH      A @link StringSet @endlink with the horizontal sequences.
+ * @param[in]  stringsV      A @link StringSet @endlink with the vertical sequences, same length as
+ *                           <tt>stringsH</tt>.
+ * @param[in]  scoringScheme The @link Score @endlink to use.
+ *
+ * See @link globalAlignmentScoreBatch @endlink for the batch computation.
+ *
+ * @see globalAlignmentScoreBatch
+ * @see localAlignmentBatch
+ */
+
+/**
+.Function.localAlignmentScoreBatch
+..summary:Computes the local alignment scores of many pairs of sequences at once.
+..cat:Alignments
+..signature:localAlignmentScoreBatch(scores, stringsH, stringsV, scoringScheme)
+..param.scores:The resulting scores, the i-th score belongs to the i-th pair.
+...type:Class.String
+..param.stringsH:The horizontal sequences.
+...type:Class.StringSet
+..param.stringsV:The vertical sequences, the same number as $stringsH$.
+...type:Class.StringSet
+..param.scoringScheme:The scoring scheme to use.
+...type:Class.Score
+..remarks:See @Function.globalAlignmentScoreBatch@ for the batch computation.
+..see:Function.globalAlignmentScoreBatch
+..see:Function.localAlignmentBatch
+..include:seqan/align_simd.h
+*/
+
+template <typename TScoreValue, typename TSpec, typename TStringH, typename TStringSetSpecH, typename TStringV,
+          typename TStringSetSpecV, typename TScoreSpec>
+inline void
+localAlignmentScoreBatch(String<TScoreValue, TSpec> & scores,
+                         StringSet<TStringH, TStringSetSpecH> const & stringsH,
+                         StringSet<TStringV, TStringSetSpecV> const & stringsV,
+                         Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    _alignmentScoreBatch(scores, stringsH, stringsV, scoringScheme, Tag<LocalAlignment_<> >());
+}
+
+// ----------------------------------------------------------------------------
+// Function globalAlignmentBatch()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn globalAlignmentBatch
+ * @headerfile <seqan/align_simd.h>
+ * @brief Computes the global alignments of many pairs of sequences at once.
+ *
+ * @signature void globalAlignmentBatch(scores, aligns, scoringScheme);
+ *
+ * @param[out]    scores        A @link String @endlink of scores.  The i-th score belongs to the i-th alignment.
+ * @param[in,out] aligns        A @link String @endlink of @link Align @endlink objects with two rows each.  The
+ *                              rows are aligned in place.
+ * @param[in]     scoringScheme The @link Score @endlink to use.
+ *
+ * The dp matrices are computed as in @link globalAlignmentScoreBatch @endlink, the traceback is done per alignment.
+ * Note that the trace matrix of a batch needs space quadratic in the length of its longest sequences.
+ *
+ * @see localAlignmentBatch
+ * @see globalAlignmentScoreBatch
+ */
+
+/**
+.Function.globalAlignmentBatch
+..summary:Computes the global alignments of many pairs of sequences at once.
+..cat:Alignments
+..signature:globalAlignmentBatch(scores, aligns, scoringScheme)
+..param.scores:The resulting scores, the i-th score belongs to the i-th alignment.
+...type:Class.String
+..param.aligns:A @Class.String@ of @Class.Align@ objects with two rows each.
+The rows are aligned in place.
+...type:Class.String
+..param.scoringScheme:The scoring scheme to use.
+...type:Class.Score
+..remarks:The dp matrices are computed as in @Function.globalAlignmentScoreBatch@, the traceback is done per alignment.
+Note that the trace matrix of a batch needs space quadratic in the length of its longest sequences.
+..see:Function.localAlignmentBatch
+..see:Function.globalAlignmentScoreBatch
+..include:seqan/align_simd.h
+*/
+
+template <typename TScoreValue, typename TSpec, typename TSequence, typename TAlignSpec, typename TAlignsSpec,
+          typename TScoreSpec>
+inline void
+globalAlignmentBatch(String<TScoreValue, TSpec> & scores,
+                     String<Align<TSequence, TAlignSpec>, TAlignsSpec> & aligns,
+                     Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    _alignmentBatch(scores, aligns, scoringScheme, Tag<GlobalAlignment_<> >());
+}
+
+// ----------------------------------------------------------------------------
+// Function localAlignmentBatch()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn localAlignmentBatch
+ * @headerfile <seqan/align_simd.h>
+ * @brief Computes the local alignments of many pairs of sequences at once.
+ *
+ * @signature void localAlignmentBatch(scores, aligns, scoringScheme);
+ *
+ * @param[out]    scores        A @link String @endlink of scores.  The i-th score belongs to the i-th alignment.
+ * @param[in,out] aligns        A @link String @endlink of @link Align @endlink objects with two rows each.  The
+ *                              rows are aligned in place.
+ * @param[in]     scoringScheme The @link Score @endlink to use.
+ *
+ * @see globalAlignmentBatch
+ * @see localAlignmentScoreBatch
+ */
+
+/**
+.Function.localAlignmentBatch
+..summary:Computes the local alignments of many pairs of sequences at once.
+..cat:Alignments
+..signature:localAlignmentBatch(scores, aligns, scoringScheme)
+..param.scores:The resulting scores, the i-th score belongs to the i-th alignment.
+...type:Class.String
+..param.aligns:A @Class.String@ of @Class.Align@ objects with two rows each.
+The rows are aligned in place.
+...type:Class.String
+..param.scoringScheme:The scoring scheme to use.
+...type:Class.Score
+..see:Function.globalAlignmentBatch
+..see:Function.localAlignmentScoreBatch
+..include:seqan/align_simd.h
+*/
+
+template <typename TScoreValue, typename TSpec, typename TSequence, typename TAlignSpec, typename TAlignsSpec,
+          typename TScoreSpec>
+inline void
+localAlignmentBatch(String<TScoreValue, TSpec> & scores,
+                    String<Align<TSequence, TAlignSpec>, TAlignsSpec> & aligns,
+                    Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    _alignmentBatch(scores, aligns, scoringScheme, Tag<LocalAlignment_<> >());
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_EXTRAS_INCLUDE_SEQAN_ALIGN_SIMD_ALIGN_SIMD_INTERFACE_H_
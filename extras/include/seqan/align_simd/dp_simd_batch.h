@@ -0,0 +1,642 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Inter-sequence vectorized dynamic programming kernel.  Each lane of a
+// SimdVector computes the alignment of one pair of sequences.
+// ==========================================================================
+
+#ifndef SEQAN_EXTRAS_INCLUDE_SEQAN_ALIGN_SIMD_DP_SIMD_BATCH_H_
+#define SEQAN_EXTRAS_INCLUDE_SEQAN_ALIGN_SIMD_DP_SIMD_BATCH_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class DPSimdBatch_
+// ----------------------------------------------------------------------------
+
+// Holds the state of one batch of pairwise alignments, i.e. the padded
+// sequences, the dp columns and, if requested, the trace matrix.  A batch
+// object can be reused for consecutive batches to avoid reallocations.
+
+template <typename TSimdVector>
+struct DPSimdBatch_
+{
+    typedef typename Value<TSimdVector>::Type TValue;
+
+    enum { LANES = LENGTH<TSimdVector>::VALUE };
+
+    unsigned count;                 // number of used lanes
+    unsigned maxLengthH;
+    unsigned maxLengthV;
+    unsigned lengthH[LANES];
+    unsigned lengthV[LANES];
+
+    TValue score[LANES];            // the alignment scores
+    unsigned endH[LANES];           // the end positions of the alignments
+    unsigned endV[LANES];
+
+    __int64 maxAbsScore;            // bound for a single scoring step, computed once
+
+    // The buffers store LANES values per entry.  They hold scalars since the
+    // allocators do not align memory to the size of AVX vectors.
+    String<TValue> charsV;          // vertical sequences, one entry per row
+    String<TValue> columnH;         // the current dp column
+    String<TValue> columnE;         // horizontal gap scores (affine gaps only)
+    String<TValue> profile;         // substitution scores for the current column
+    String<TValue> trace;           // the trace matrix in column-major order
+
+    DPSimdBatch_() : count(0), maxLengthH(0), maxLengthV(0), maxAbsScore(-1)
+    {}
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _simdBlend()
+// ----------------------------------------------------------------------------
+
+template <typename TSimdVector>
+inline TSimdVector
+_simdBlend(TSimdVector const & mask, TSimdVector const & a, TSimdVector const & b)
+{
+    return (mask & a) | (~mask & b);
+}
+
+// ----------------------------------------------------------------------------
+// Function _simdMax()
+// ----------------------------------------------------------------------------
+
+template <typename TSimdVector>
+inline TSimdVector
+_simdMax(TSimdVector const & a, TSimdVector const & b)
+{
+    return _simdBlend(TSimdVector(a > b), a, b);
+}
+
+// ----------------------------------------------------------------------------
+// Function _simdFill()
+// ----------------------------------------------------------------------------
+
+template <typename TSimdVector, typename TValue>
+inline TSimdVector
+_simdFill(TSimdVector const &, TValue value)
+{
+    TSimdVector vec;
+    fill(vec, static_cast<typename Value<TSimdVector>::Type>(value));
+    return vec;
+}
+
+// ----------------------------------------------------------------------------
+// Function _simdLoad()
+// ----------------------------------------------------------------------------
+
+// Loads entry pos of a buffer of a DPSimdBatch_.
+
+template <typename TSimdVector, typename TValue, typename TSpec>
+inline TSimdVector
+_simdLoad(TSimdVector const &, String<TValue, TSpec> const & buffer, unsigned pos)
+{
+    TSimdVector vec;
+    std::memcpy(&vec, begin(buffer, Standard()) + pos * LENGTH<TSimdVector>::VALUE, sizeof(TSimdVector));
+    return vec;
+}
+
+// ----------------------------------------------------------------------------
+// Function _simdStore()
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TSimdVector>
+inline void
+_simdStore(String<TValue, TSpec> & buffer, unsigned pos, TSimdVector const & vec)
+{
+    std::memcpy(begin(buffer, Standard()) + pos * LENGTH<TSimdVector>::VALUE, &vec, sizeof(TSimdVector));
+}
+
+// ----------------------------------------------------------------------------
+// Function _maxAbsScore()
+// ----------------------------------------------------------------------------
+
+// Returns an upper bound for the absolute value of a single scoring step.
+
+template <typename TAlphabetH, typename TAlphabetV, typename TScoreValue>
+inline TScoreValue
+_maxAbsScore(Score<TScoreValue, Simple> const & scoringScheme, TAlphabetH const &, TAlphabetV const &)
+{
+    TScoreValue result = _abs(scoreMatch(scoringScheme));
+    result = _max(result, _abs(scoreMismatch(scoringScheme)));
+    result = _max(result, _abs(scoreGapOpen(scoringScheme)));
+    return _max(result, _abs(scoreGapExtend(scoringScheme)));
+}
+
+template <typename TAlphabetH, typename TAlphabetV, typename TScoreValue, typename TScoreSpec>
+inline TScoreValue
+_maxAbsScore(Score<TScoreValue, TScoreSpec> const & scoringScheme, TAlphabetH const &, TAlphabetV const &)
+{
+    TScoreValue result = _max(_abs(scoreGapOpen(scoringScheme)), _abs(scoreGapExtend(scoringScheme)));
+    for (unsigned a = 0; a < ValueSize<TAlphabetH>::VALUE; ++a)
+        for (unsigned b = 0; b < ValueSize<TAlphabetV>::VALUE; ++b)
+            result = _max(result, _abs(score(scoringScheme, TAlphabetH(a), TAlphabetV(b))));
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+// Function _initDPSimdBatch()
+// ----------------------------------------------------------------------------
+
+// Sets up the lengths of the batch of pairs [batchBegin, batchBegin + LANES).
+// Returns false if the scores could exceed the value range of the lanes, in
+// which case the caller has to fall back to the sequential implementation.
+
+template <typename TSimdVector, typename TStringsH, typename TStringsV, typename TScoreValue, typename TScoreSpec>
+inline bool
+_initDPSimdBatch(DPSimdBatch_<TSimdVector> & batch,
+                 TStringsH const & stringsH,
+                 TStringsV const & stringsV,
+                 unsigned batchBegin,
+                 Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    typedef DPSimdBatch_<TSimdVector> TBatch;
+    typedef typename TBatch::TValue TValue;
+    typedef typename Value<typename Value<TStringsH const>::Type>::Type TAlphabetH;
+    typedef typename Value<typename Value<TStringsV const>::Type>::Type TAlphabetV;
+
+    batch.count = _min((unsigned)TBatch::LANES, (unsigned)length(stringsH) - batchBegin);
+    batch.maxLengthH = 0;
+    batch.maxLengthV = 0;
+    for (unsigned k = 0; k < (unsigned)TBatch::LANES; ++k)
+    {
+        batch.lengthH[k] = (k < batch.count) ? length(stringsH[batchBegin + k]) : 0;
+        batch.lengthV[k] = (k < batch.count) ? length(stringsV[batchBegin + k]) : 0;
+        batch.maxLengthH = _max(batch.maxLengthH, batch.lengthH[k]);
+        batch.maxLengthV = _max(batch.maxLengthV, batch.lengthV[k]);
+    }
+
+    // Every cell score is bounded by (i + j) times the largest absolute step score and the
+    // minus infinity value is half the minimal lane value, so everything stays in range.
+    if (batch.maxAbsScore < 0)
+        batch.maxAbsScore = _maxAbsScore(scoringScheme, TAlphabetH(), TAlphabetV());
+    __int64 bound = ((__int64)batch.maxLengthH + batch.maxLengthV + 2) * batch.maxAbsScore;
+    return bound < (__int64)(MaxValue<TValue>::VALUE / 2) &&
+           (__int64)batch.maxLengthH < (__int64)MaxValue<TValue>::VALUE &&
+           (__int64)batch.maxLengthV < (__int64)MaxValue<TValue>::VALUE;
+}
+
+// ----------------------------------------------------------------------------
+// Function _initCharsV()
+// ----------------------------------------------------------------------------
+
+// Stores the vertical sequences row-wise.  For the simple score the characters
+// are converted into the horizontal alphabet so that they can be compared
+// directly, for other schemes the ordinal values index the profile.
+
+template <typename TSimdVector, typename TStringsV, typename TAlphabetH, typename TScoreValue>
+inline void
+_initCharsV(DPSimdBatch_<TSimdVector> & batch,
+            TStringsV const & stringsV,
+            unsigned batchBegin,
+            TAlphabetH const &,
+            Score<TScoreValue, Simple> const &)
+{
+    resize(batch.charsV, batch.maxLengthV * DPSimdBatch_<TSimdVector>::LANES, Exact());
+    for (unsigned j = 0; j < batch.maxLengthV; ++j)
+        for (unsigned k = 0; k < (unsigned)DPSimdBatch_<TSimdVector>::LANES; ++k)
+            batch.charsV[j * DPSimdBatch_<TSimdVector>::LANES + k] = (j < batch.lengthV[k]) ?
+                (int)ordValue(TAlphabetH(stringsV[batchBegin + k][j])) : -2;
+}
+
+template <typename TSimdVector, typename TStringsV, typename TAlphabetH, typename TScoreValue, typename TScoreSpec>
+inline void
+_initCharsV(DPSimdBatch_<TSimdVector> & batch,
+            TStringsV const & stringsV,
+            unsigned batchBegin,
+            TAlphabetH const &,
+            Score<TScoreValue, TScoreSpec> const &)
+{
+    resize(batch.charsV, batch.maxLengthV * DPSimdBatch_<TSimdVector>::LANES, Exact());
+    for (unsigned j = 0; j < batch.maxLengthV; ++j)
+        for (unsigned k = 0; k < (unsigned)DPSimdBatch_<TSimdVector>::LANES; ++k)
+            batch.charsV[j * DPSimdBatch_<TSimdVector>::LANES + k] = (j < batch.lengthV[k]) ? (int)ordValue(stringsV[batchBegin + k][j]) : 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function _updateProfile()
+// ----------------------------------------------------------------------------
+
+// Prepares the substitution scores of column i.  For the simple score only
+// the horizontal characters are stored, other schemes store one score vector
+// per character of the vertical alphabet.
+
+template <typename TSimdVector, typename TStringsH, typename TAlphabetV, typename TScoreValue>
+inline void
+_updateProfile(DPSimdBatch_<TSimdVector> & batch,
+               TStringsH const & stringsH,
+               unsigned batchBegin,
+               unsigned i,
+               TAlphabetV const &,
+               Score<TScoreValue, Simple> const &)
+{
+    resize(batch.profile, DPSimdBatch_<TSimdVector>::LANES, Exact());
+    for (unsigned k = 0; k < (unsigned)DPSimdBatch_<TSimdVector>::LANES; ++k)
+        batch.profile[k] = (i < batch.lengthH[k]) ? (int)ordValue(stringsH[batchBegin + k][i]) : -1;
+}
+
+template <typename TSimdVector, typename TStringsH, typename TAlphabetV, typename TScoreValue, typename TScoreSpec>
+inline void
+_updateProfile(DPSimdBatch_<TSimdVector> & batch,
+               TStringsH const & stringsH,
+               unsigned batchBegin,
+               unsigned i,
+               TAlphabetV const &,
+               Score<TScoreValue, TScoreSpec> const & scoringScheme)
+{
+    typedef typename Value<TSimdVector>::Type TValue;
+
+    resize(batch.profile, ValueSize<TAlphabetV>::VALUE * DPSimdBatch_<TSimdVector>::LANES, Exact());
+    for (unsigned k = 0; k < (unsigned)DPSimdBatch_<TSimdVector>::LANES; ++k)
+    {
+        if (i >= batch.lengthH[k])
+        {
+            for (unsigned c = 0; c < ValueSize<TAlphabetV>::VALUE; ++c)
+                batch.profile[c * DPSimdBatch_<TSimdVector>::LANES + k] = 0;
+            continue;
+        }
+        for (unsigned c = 0; c < ValueSize<TAlphabetV>::VALUE; ++c)
+            batch.profile[c * DPSimdBatch_<TSimdVector>::LANES + k] = (TValue)score(scoringScheme, stringsH[batchBegin + k][i], TAlphabetV(c));
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _substitutionScores()
+// ----------------------------------------------------------------------------
+
+template <typename TSimdVector, typename TAlphabetV, typename TScoreValue>
+inline TSimdVector
+_substitutionScores(DPSimdBatch_<TSimdVector> const & batch,
+                    TSimdVector const & charsV,
+                    TSimdVector const & vMatch,
+                    TSimdVector const & vMismatch,
+                    TAlphabetV const &,
+                    Score<TScoreValue, Simple> const &)
+{
+    return _simdBlend(TSimdVector(_simdLoad(charsV, batch.profile, 0) == charsV), vMatch, vMismatch);
+}
+
+template <typename TSimdVector, typename TAlphabetV, typename TScoreValue, typename TScoreSpec>
+inline TSimdVector
+_substitutionScores(DPSimdBatch_<TSimdVector> const & batch,
+                    TSimdVector const & charsV,
+                    TSimdVector const &,
+                    TSimdVector const &,
+                    TAlphabetV const &,
+                    Score<TScoreValue, TScoreSpec> const &)
+{
+    TSimdVector result;
+    clear(result);
+
+    // Small alphabets select the score with one comparison per character, for
+    // larger alphabets the scores are gathered lane by lane.
+    if (ValueSize<TAlphabetV>::VALUE <= 32)
+    {
+        TSimdVector c;
+        clear(c);
+        for (unsigned ord = 0; ord < ValueSize<TAlphabetV>::VALUE; ++ord)
+        {
+            result |= TSimdVector(charsV == c) & _simdLoad(c, batch.profile, ord);
+            c = c + _simdFill(c, 1);
+        }
+    }
+    else
+    {
+        for (unsigned k = 0; k < (unsigned)DPSimdBatch_<TSimdVector>::LANES; ++k)
+            result[k] = batch.profile[charsV[k] * DPSimdBatch_<TSimdVector>::LANES + k];
+    }
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+// Function _initMatchScores()
+// ----------------------------------------------------------------------------
+
+template <typename TSimdVector, typename TScoreValue>
+inline void
+_initMatchScores(TSimdVector & vMatch, TSimdVector & vMismatch, Score<TScoreValue, Simple> const & scoringScheme)
+{
+    vMatch = _simdFill(vMatch, scoreMatch(scoringScheme));
+    vMismatch = _simdFill(vMismatch, scoreMismatch(scoringScheme));
+}
+
+template <typename TSimdVector, typename TScoreValue, typename TScoreSpec>
+inline void
+_initMatchScores(TSimdVector &, TSimdVector &, Score<TScoreValue, TScoreSpec> const &)
+{}
+
+// ----------------------------------------------------------------------------
+// Function _computeDPSimdBatch()
+// ----------------------------------------------------------------------------
+
+// Computes the dp matrices of all lanes of the batch column by column.  The
+// gap costs and the algorithm are selected at compile time, TTraceFlag selects
+// whether the trace matrix is stored.
+
+template <typename TSimdVector, typename TStringsH, typename TStringsV, typename TScoreValue, typename TScoreSpec,
+          typename TAlgoTag, typename TGapCosts, typename TTraceFlag>
+inline void
+_computeDPSimdBatch(DPSimdBatch_<TSimdVector> & batch,
+                    TStringsH const & stringsH,
+                    TStringsV const & stringsV,
+                    unsigned batchBegin,
+                    Score<TScoreValue, TScoreSpec> const & scoringScheme,
+                    TAlgoTag const &,
+                    TGapCosts const &,
+                    TTraceFlag const &)
+{
+    typedef typename Value<TSimdVector>::Type TValue;
+    typedef typename Value<typename Value<TStringsH const>::Type>::Type TAlphabetH;
+    typedef typename Value<typename Value<TStringsV const>::Type>::Type TAlphabetV;
+    typedef TraceBitMap_ TTraceBits;
+
+    const bool isLocal = IsSameType<TAlgoTag, Tag<LocalAlignment_<> > >::VALUE;
+    const bool isAffine = IsSameType<TGapCosts, AffineGaps>::VALUE;
+    const bool storeTrace = IsSameType<TTraceFlag, True>::VALUE;
+    const unsigned lanes = DPSimdBatch_<TSimdVector>::LANES;
+
+    TSimdVector vZero;
+    clear(vZero);
+    TSimdVector vMinusInf = _simdFill(vZero, MinValue<TValue>::VALUE / 2);
+    TSimdVector vGapOpen = _simdFill(vZero, scoreGapOpen(scoringScheme));
+    TSimdVector vGapExtend = _simdFill(vZero, scoreGapExtend(scoringScheme));
+    TSimdVector vMatch = vZero;
+    TSimdVector vMismatch = vZero;
+    _initMatchScores(vMatch, vMismatch, scoringScheme);
+    // Linear gaps are scored with the gap extension score only.
+    if (!isAffine)
+        vGapOpen = vGapExtend;
+
+    TSimdVector vDiagonal = _simdFill(vZero, TTraceBits::DIAGONAL);
+    TSimdVector vHorizontal = _simdFill(vZero, TTraceBits::HORIZONTAL);
+    TSimdVector vVertical = _simdFill(vZero, TTraceBits::VERTICAL);
+    TSimdVector vHorizontalOpen = _simdFill(vZero, TTraceBits::HORIZONTAL_OPEN);
+    TSimdVector vVerticalOpen = _simdFill(vZero, TTraceBits::VERTICAL_OPEN);
+
+    unsigned rows = batch.maxLengthV + 1;
+    _initCharsV(batch, stringsV, batchBegin, TAlphabetH(), scoringScheme);
+    resize(batch.columnH, rows * lanes, Exact());
+    if (isAffine)
+        resize(batch.columnE, rows * lanes, Exact());
+    if (storeTrace)
+        resize(batch.trace, (batch.maxLengthH + 1) * rows * lanes, Exact());
+
+    // Initialize the first column.
+    TValue gapOpen = scoreGapOpen(scoringScheme);
+    TValue gapExtend = scoreGapExtend(scoringScheme);
+    if (!isAffine)
+        gapOpen = gapExtend;
+    _simdStore(batch.columnH, 0, vZero);
+    for (unsigned j = 1; j < rows; ++j)
+    {
+        _simdStore(batch.columnH, j, isLocal ? vZero : _simdFill(vZero, gapOpen + (j - 1) * gapExtend));
+        if (isAffine)
+            _simdStore(batch.columnE, j, vMinusInf);
+    }
+
+    // The global alignments of empty horizontal sequences end in the first column.
+    for (unsigned k = 0; k < lanes; ++k)
+    {
+        batch.score[k] = (isLocal || batch.lengthH[k] != 0) ? 0 : batch.columnH[batch.lengthV[k] * lanes + k];
+        batch.endH[k] = isLocal ? 0 : batch.lengthH[k];
+        batch.endV[k] = isLocal ? 0 : batch.lengthV[k];
+    }
+
+    // The local alignments store the best score and its position per lane.
+    TSimdVector vBest = vZero;
+    TSimdVector vBestH = vZero;
+    TSimdVector vBestV = vZero;
+    TSimdVector vLengthH = vZero;
+    TSimdVector vLengthV = vZero;
+    for (unsigned k = 0; k < lanes; ++k)
+    {
+        vLengthH[k] = batch.lengthH[k];
+        vLengthV[k] = batch.lengthV[k];
+    }
+
+    for (unsigned i = 1; i <= batch.maxLengthH; ++i)
+    {
+        _updateProfile(batch, stringsH, batchBegin, i - 1, TAlphabetV(), scoringScheme);
+
+        TSimdVector vI = _simdFill(vZero, i);
+        TSimdVector vValidH = TSimdVector(vLengthH >= vI);
+
+        TSimdVector diagonal = _simdLoad(vZero, batch.columnH, 0);
+        TSimdVector up = isLocal ? vZero : _simdFill(vZero, gapOpen + (i - 1) * gapExtend);
+        _simdStore(batch.columnH, 0, up);
+        TSimdVector vertical = vMinusInf;
+        TSimdVector vJ = vZero;
+
+        for (unsigned j = 1; j < rows; ++j)
+        {
+            vJ = vJ + _simdFill(vZero, 1);
+
+            TSimdVector scoreDiagonal = diagonal + _substitutionScores(batch, _simdLoad(vZero, batch.charsV, j - 1),
+                                                                       vMatch, vMismatch, TAlphabetV(), scoringScheme);
+            TSimdVector left = _simdLoad(vZero, batch.columnH, j);
+            diagonal = left;
+
+            // Horizontal gaps come from the previous column, vertical gaps from the previous row.
+            TSimdVector horizontalOpen = left + vGapOpen;
+            TSimdVector horizontal = horizontalOpen;
+            TSimdVector verticalOpen = up + vGapOpen;
+            if (isAffine)
+            {
+                horizontal = _simdMax(horizontalOpen, _simdLoad(vZero, batch.columnE, j) + vGapExtend);
+                _simdStore(batch.columnE, j, horizontal);
+                vertical = _simdMax(verticalOpen, vertical + vGapExtend);
+            }
+            else
+            {
+                vertical = verticalOpen;
+            }
+
+            TSimdVector current = _simdMax(scoreDiagonal, _simdMax(horizontal, vertical));
+            if (isLocal)
+                current = _simdMax(current, vZero);
+            _simdStore(batch.columnH, j, current);
+            up = current;
+
+            if (storeTrace)
+            {
+                TSimdVector traceValue = _simdBlend(TSimdVector(current == scoreDiagonal), vDiagonal,
+                                                    _simdBlend(TSimdVector(current == horizontal),
+                                                               vHorizontal, vVertical));
+                if (isAffine)
+                {
+                    traceValue |= TSimdVector(horizontal == horizontalOpen) & vHorizontalOpen;
+                    traceValue |= TSimdVector(vertical == verticalOpen) & vVerticalOpen;
+                }
+                // Local alignments stop in cells with score zero.
+                if (isLocal)
+                    traceValue &= ~(TSimdVector(current == vZero) & (vDiagonal | vHorizontal | vVertical));
+                _simdStore(batch.trace, i * rows + j, traceValue);
+            }
+
+            if (isLocal)
+            {
+                TSimdVector valid = vValidH & TSimdVector(vLengthV >= vJ);
+                TSimdVector better = TSimdVector((current & valid) > vBest);
+                vBest = _simdBlend(better, current, vBest);
+                if (storeTrace)
+                {
+                    vBestH = _simdBlend(better, vI, vBestH);
+                    vBestV = _simdBlend(better, vJ, vBestV);
+                }
+            }
+        }
+
+        if (!isLocal)
+            for (unsigned k = 0; k < lanes; ++k)
+                if (batch.lengthH[k] == i)
+                    batch.score[k] = batch.columnH[batch.lengthV[k] * lanes + k];
+    }
+
+    if (isLocal)
+    {
+        for (unsigned k = 0; k < lanes; ++k)
+        {
+            batch.score[k] = vBest[k];
+            batch.endH[k] = vBestH[k];
+            batch.endV[k] = vBestV[k];
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _tracebackDPSimdBatch()
+// ----------------------------------------------------------------------------
+
+// Follows the trace of a single lane from its end position and records the
+// trace segments from the end to the begin of the alignment.
+
+template <typename TTraceSegments, typename TSimdVector, typename TAlgoTag, typename TGapCosts>
+inline void
+_tracebackDPSimdBatch(TTraceSegments & traceSegments,
+                      DPSimdBatch_<TSimdVector> const & batch,
+                      unsigned lane,
+                      TAlgoTag const &,
+                      TGapCosts const &)
+{
+    typedef TraceBitMap_ TTraceBits;
+    typedef typename TTraceBits::TTraceValue TTraceValue;
+
+    const bool isLocal = IsSameType<TAlgoTag, Tag<LocalAlignment_<> > >::VALUE;
+    const bool isAffine = IsSameType<TGapCosts, AffineGaps>::VALUE;
+
+    clear(traceSegments);
+
+    unsigned rows = batch.maxLengthV + 1;
+    unsigned i = batch.endH[lane];
+    unsigned j = batch.endV[lane];
+
+    // The matrix the traceback is currently in.
+    TTraceValue matrix = TTraceBits::DIAGONAL;
+    TTraceValue segmentValue = TTraceBits::NONE;
+    unsigned segmentLength = 0;
+
+    while (i != 0 || j != 0)
+    {
+        TTraceValue step;
+        if (i == 0 || j == 0)
+        {
+            // The local alignments begin at the border, the global ones end with a gap.
+            if (isLocal)
+                break;
+            step = (i == 0) ? TTraceBits::VERTICAL : TTraceBits::HORIZONTAL;
+        }
+        else
+        {
+            TTraceValue traceValue = batch.trace[(i * rows + j) * DPSimdBatch_<TSimdVector>::LANES + lane];
+            if (matrix == TTraceBits::DIAGONAL)
+            {
+                if (!(traceValue & (TTraceBits::DIAGONAL | TTraceBits::HORIZONTAL | TTraceBits::VERTICAL)))
+                    break;
+                if (traceValue & TTraceBits::DIAGONAL)
+                    step = TTraceBits::DIAGONAL;
+                else
+                    matrix = step = (traceValue & TTraceBits::HORIZONTAL) ? +TTraceBits::HORIZONTAL : +TTraceBits::VERTICAL;
+            }
+            else
+            {
+                step = matrix;
+            }
+
+            // Gaps that are opened in this cell continue in the score matrix.
+            if (step == TTraceBits::HORIZONTAL)
+            {
+                if (!isAffine || (traceValue & TTraceBits::HORIZONTAL_OPEN))
+                    matrix = TTraceBits::DIAGONAL;
+            }
+            else if (step == TTraceBits::VERTICAL)
+            {
+                if (!isAffine || (traceValue & TTraceBits::VERTICAL_OPEN))
+                    matrix = TTraceBits::DIAGONAL;
+            }
+        }
+
+        if (step != segmentValue)
+        {
+            _recordSegment(traceSegments, i, j, segmentLength, segmentValue);
+            segmentValue = step;
+            segmentLength = 0;
+        }
+        ++segmentLength;
+        if (step != TTraceBits::VERTICAL)
+            --i;
+        if (step != TTraceBits::HORIZONTAL)
+            --j;
+    }
+    _recordSegment(traceSegments, i, j, segmentLength, segmentValue);
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_EXTRAS_INCLUDE_SEQAN_ALIGN_SIMD_DP_SIMD_BATCH_H_
@@ -46,6 +46,11 @@
 #include <seqan/sequence.h>
 #include <seqan/statistics.h>
 #include <seqan/misc/edit_environment.h>
+#include <seqan/parallel.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif  // #ifdef __SSE2__
 
 // ===========================================================================
 // Module's headers.
@@ -42,6 +42,23 @@
 
 namespace seqan {
 
+// Computes the D2 score of two sequences from the cached kmer counts, used by _alignmentFreeFillMatrix().
+template <typename TValue>
+struct AlignmentFreePairD2_
+{
+    StringSet<String<unsigned> > const & kmerCounts;
+    AFScore<D2> const & score;
+
+    AlignmentFreePairD2_(StringSet<String<unsigned> > const & kmerCounts_, AFScore<D2> const & score_) :
+        kmerCounts(kmerCounts_), score(score_)
+    {}
+
+    void operator()(TValue & result, unsigned rowIndex, unsigned colIndex)
+    {
+        _alignmentFreeCompareCounts(result, kmerCounts[rowIndex], kmerCounts[colIndex], score);
+    }
+};
+
 /*
  * _alignmentFreeComparison is called by alignmentFreeComparison() (see alignment_free_comparison.h)
  */
@@ -50,12 +67,6 @@ void _alignmentFreeComparison(Matrix<TValue, 2> & scoreMatrix,
                               TStringSet const & sequenceSet,
                               AFScore<D2> const & score)
 {
-    //typedef typename Value<TStringSet>::Type                        TString;
-    //typedef typename Value<TString>::Type                           TAlphabet;
-    typedef typename Iterator<TStringSet const>::Type               TIteratorSet;
-    typedef typename Iterator<StringSet<String<unsigned> > >::Type  TIteratorSetInt;
-    //typedef Matrix<TValue, 2>                                       TMatrix;
-
     unsigned seqNumber = length(sequenceSet);
 
     // Resize the scoreMatrix
@@ -66,34 +77,18 @@ void _alignmentFreeComparison(Matrix<TValue, 2> & scoreMatrix,
     StringSet<String<unsigned> > kmerCounts;
     resize(kmerCounts, seqNumber);
 
-    // Count all kmers
-    TIteratorSetInt itKmerCounts = begin(kmerCounts);
-    TIteratorSet itSeqSet = begin(sequenceSet);
-
-    for (; itSeqSet < end(sequenceSet); ++itSeqSet)
-    {
-        countKmers(value(itKmerCounts), value(itSeqSet), score.kmerSize);
-        ++itKmerCounts;
-    }
+    // Count all kmers once per sequence
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+    for (int seqIndex = 0; seqIndex < (int)seqNumber; ++seqIndex)
+        countKmers(kmerCounts[seqIndex], sequenceSet[seqIndex], score.kmerSize);
     if(score.verbose)
     {
       std::cout << "\ncounted words";
     }
 
     // Calculate all pairwise scores and store them in scoreMatrix
-    for (unsigned rowIndex = 0; rowIndex < seqNumber; ++rowIndex)
-    {
-        if(score.verbose)
-        {
-            std::cout << "\nSequence number " << rowIndex;
-        }
-        for (unsigned colIndex = rowIndex; colIndex < seqNumber; ++colIndex)
-        {
-            _alignmentFreeCompareCounts(value(scoreMatrix, rowIndex, colIndex), kmerCounts[rowIndex], kmerCounts[colIndex], score);
-            value(scoreMatrix, colIndex, rowIndex) = value(scoreMatrix, rowIndex, colIndex);  // Copy symmetric entries
-        }
-    }
-
+    AlignmentFreePairD2_<TValue> pairScore(kmerCounts, score);
+    _alignmentFreeFillMatrix(scoreMatrix, seqNumber, pairScore, score.verbose);
 }
 
 /*
@@ -106,17 +101,7 @@ _alignmentFreeCompareCounts(TValue & result,
                             String<unsigned> const & kmerCounts2,
                             AFScore<D2> const & /*score*/)
 {
-    typedef typename Iterator<String<unsigned> const>::Type TIteratorInt;
-
-    TIteratorInt it1 = begin(kmerCounts1);
-    TIteratorInt it2 = begin(kmerCounts2);
-
-    result = 0;
-    for (; it1 < end(kmerCounts1); ++it1)
-    {
-        result += value(it1) * value(it2);
-        ++it2;
-    }
+    result = _alignmentFreeDotProduct(kmerCounts1, kmerCounts2);
 }
 
 }  // namespace seqan
@@ -44,6 +44,36 @@
 
 namespace seqan {
 
+// Computes the D2* score of two sequences from the cached kmer and nucleotide counts, used by
+// _alignmentFreeFillMatrix().  The Markov background of higher orders is estimated from the concatenation of both
+// sequences and cannot be combined from per-sequence models, it is built for every pair.  The word probabilities
+// depend on the background of the pair for all orders, so the counts are standardised here and not per sequence.
+template <typename TValue, typename TStringSet>
+struct AlignmentFreePairD2Star_
+{
+    TStringSet const & sequenceSet;
+    StringSet<String<unsigned> > const & kmerCounts;
+    StringSet<String<unsigned> > const & backgroundCounts;
+    AFScore<D2Star> const & score;
+
+    AlignmentFreePairD2Star_(TStringSet const & sequenceSet_,
+                             StringSet<String<unsigned> > const & kmerCounts_,
+                             StringSet<String<unsigned> > const & backgroundCounts_,
+                             AFScore<D2Star> const & score_) :
+        sequenceSet(sequenceSet_), kmerCounts(kmerCounts_), backgroundCounts(backgroundCounts_), score(score_)
+    {}
+
+    void operator()(TValue & result, unsigned rowIndex, unsigned colIndex)
+    {
+        if (score.bgModelOrder == 0)
+            _d2star(result, kmerCounts[rowIndex], backgroundCounts[rowIndex], kmerCounts[colIndex],
+                    backgroundCounts[colIndex], score);
+        else
+            _d2star(result, sequenceSet[rowIndex], kmerCounts[rowIndex], sequenceSet[colIndex], kmerCounts[colIndex],
+                    score);
+    }
+};
+
 /*
  * _alignmentFreeComparison is called by alignmentFreeComparison() (see alignment_free_comparison.h)
  */
@@ -52,34 +82,30 @@ void _alignmentFreeComparison(Matrix<TValue, 2> & scoreMatrix,
                               TStringSet const & sequenceSet,
                               AFScore<D2Star> const & score)
 {
-
-    //typedef typename Iterator<TStringSet const>::Type             TIteratorSet;
-    //typedef typename Iterator<StringSet<String<double> > >::Type  TIteratorSetDouble;
-
-    //typedef Matrix<TValue, 2> TMatrix;
-
     unsigned seqNumber = length(sequenceSet);
 
     // Resize the scoreMatrix
     setLength(scoreMatrix, 0, seqNumber);
     setLength(scoreMatrix, 1, seqNumber);
     resize(scoreMatrix, (TValue) 0);
-    StringSet<String<double> > standardisedKmerCounts;
-    resize(standardisedKmerCounts, seqNumber);
 
-    // Calculate all pairwise scores and store them in scoreMatrix
-    for (unsigned rowIndex = 0; rowIndex < seqNumber; ++rowIndex)
+    // Count all kmers (and nucleotides for the order 0 background) once per sequence
+    StringSet<String<unsigned> > kmerCounts;
+    StringSet<String<unsigned> > backgroundCounts;
+    resize(kmerCounts, seqNumber);
+    resize(backgroundCounts, seqNumber);
+
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+    for (int seqIndex = 0; seqIndex < (int)seqNumber; ++seqIndex)
     {
-        if(score.verbose)
-        {
-            std::cout << "\nSequence number " << rowIndex;
-        }
-        for (unsigned colIndex = rowIndex; colIndex < seqNumber; ++colIndex)
-        {
-            _d2star(value(scoreMatrix, rowIndex, colIndex), sequenceSet[rowIndex], sequenceSet[colIndex], score);
-            value(scoreMatrix, colIndex, rowIndex) = value(scoreMatrix, rowIndex, colIndex);  // Copy symmetric entries
-        }
+        countKmers(kmerCounts[seqIndex], sequenceSet[seqIndex], score.kmerSize);
+        if (score.bgModelOrder == 0)
+            countKmers(backgroundCounts[seqIndex], sequenceSet[seqIndex], 1);
     }
+
+    // Calculate all pairwise scores and store them in scoreMatrix
+    AlignmentFreePairD2Star_<TValue, TStringSet> pairScore(sequenceSet, kmerCounts, backgroundCounts, score);
+    _alignmentFreeFillMatrix(scoreMatrix, seqNumber, pairScore, score.verbose);
 }
 
 /*
@@ -91,130 +117,141 @@ void _d2star(TValue & result,
              TSequence const & sequence2,
              AFScore<D2Star> const & score)
 {
-    typedef typename Value<TSequence>::Type              TAlphabet;
-    typedef typename UnmaskedAlphabet_<TAlphabet>::Type  TUnmaskedAlphabet;
+    String<unsigned> kmerCounts1;
+    String<unsigned> kmerCounts2;
+    countKmers(kmerCounts1, sequence1, score.kmerSize);
+    countKmers(kmerCounts2, sequence2, score.kmerSize);
 
+    if (score.bgModelOrder == 0)
+    {
+        String<unsigned> backgroundCounts1;
+        String<unsigned> backgroundCounts2;
+        countKmers(backgroundCounts1, sequence1, 1);
+        countKmers(backgroundCounts2, sequence2, 1);
+        _d2star(result, kmerCounts1, backgroundCounts1, kmerCounts2, backgroundCounts2, score);
+    }
+    else
+    {
+        _d2star(result, sequence1, kmerCounts1, sequence2, kmerCounts2, score);
+    }
+}
+
+/*
+ * Order 0 background model: the nucleotide frequencies of the concatenation of both sequences are the sums of the
+ * per-sequence nucleotide counts.
+ */
+template <typename TValue>
+void _d2star(TValue & result,
+             String<unsigned> const & kmerCounts1,
+             String<unsigned> const & backgroundCounts1,
+             String<unsigned> const & kmerCounts2,
+             String<unsigned> const & backgroundCounts2,
+             AFScore<D2Star> const & score)
+{
     TValue missing = -pow(10.0, 10);
-    TSequence seq1seq2;
-    append(seq1seq2, sequence1);
-    append(seq1seq2, sequence2);
     result = 0.0;
 
-    // Note that there is some code below that looks like copy-and-paste.  However, pulling this out into another
-    // function is the only way to get rid of the duplicate lines since we use different types.  After some discussion,
-    // weese, goeke and holtgrew agreed that it is probably easier to read and maintain this way than to spread the code
-    // over to one more function.
-    if (score.bgModelOrder == 0)
+    unsigned alphabetSize = length(backgroundCounts1);
+    String<double> backgroundFrequencies;
+    resize(backgroundFrequencies, alphabetSize, 0);
+    int sumBG = 0;
+    for (unsigned i = 0; i < alphabetSize; ++i)
     {
-        // --------------------------------------------------------------------
-        // Order 0 Background Model
-        // --------------------------------------------------------------------
-
-        String<unsigned> kmerCounts1;
-        String<unsigned> kmerCounts2;
-        String<unsigned> backgroundCounts;
-        String<double> backgroundFrequencies;
-        resize(backgroundFrequencies, 4, 0);
-        countKmers(kmerCounts1, sequence1, score.kmerSize);
-        countKmers(kmerCounts2, sequence2, score.kmerSize);
-        countKmers(backgroundCounts, seq1seq2, 1);
-        int sumBG = 0;
-        for (unsigned i = 0; i < length(backgroundCounts); ++i)
-        {
-            sumBG += backgroundCounts[i];
-        }
-        for (unsigned i = 0; i < length(backgroundCounts); ++i)
-        {
-            backgroundFrequencies[i] = backgroundCounts[i] / ((double)sumBG);
-        }
-        unsigned nvals = length(kmerCounts1);  // Number of kmers
-        int len1 = 0;
-        int len2 = 0;
+        sumBG += backgroundCounts1[i] + backgroundCounts2[i];
+    }
+    for (unsigned i = 0; i < alphabetSize; ++i)
+    {
+        backgroundFrequencies[i] = (backgroundCounts1[i] + backgroundCounts2[i]) / ((double)sumBG);
+    }
+    unsigned nvals = length(kmerCounts1);  // Number of kmers
+    int len1 = _alignmentFreeSum(kmerCounts1);
+    int len2 = _alignmentFreeSum(kmerCounts2);
 
-        for (unsigned l = 0; l < nvals; l++)
-        {
-            len1 += kmerCounts1[l];
-            len2 += kmerCounts2[l];
-        }
+    // Word probabilities p_w of all kmers, extended letter by letter from the probabilities of their prefixes.  This
+    // multiplies in the same order as calculateProbability().
+    String<TValue> probabilities;
+    String<TValue> prefixProbabilities;
+    resize(probabilities, 1, (TValue) 1);
+    for (unsigned l = 0; l < score.kmerSize; ++l)
+    {
+        swap(probabilities, prefixProbabilities);
+        resize(probabilities, length(prefixProbabilities) * alphabetSize, Exact());
+        for (unsigned i = 0; i < length(probabilities); ++i)
+            probabilities[i] = prefixProbabilities[i / alphabetSize] * backgroundFrequencies[i % alphabetSize];
+    }
+    SEQAN_ASSERT_EQ(length(probabilities), nvals);
 
-        String<TValue> probabilities;  // String of TValue to store the word probabilities p_w
-        resize(probabilities, nvals, missing);
+    TValue const infinity = pow(10.0, 10);
+    for (unsigned i = 0; i < nvals; ++i)
+    {
+        TValue p_w = probabilities[i];  // Probability of kmer
+        TValue variance1 = sqrt(len1 * p_w);
+        TValue variance2 = sqrt(len2 * p_w);
 
-        for (unsigned i = 0; i < nvals; ++i)
+        // Test if variance is larer than 0 and smaller than inf before dividing
+        if ((variance1 > missing) && (variance1 < infinity))
         {
-            TValue p_w = 1;  // Probability of kmer
-
-            String<TUnmaskedAlphabet> w;
-            unhash(w, i, score.kmerSize);
-            calculateProbability(p_w, w, backgroundFrequencies);
-            TValue variance1 = 0.0;
-            TValue variance2 = 0.0;
-
-            variance1 = pow(len1 * p_w, 0.5);
-            variance2 = pow(len2 * p_w, 0.5);
-
-            // Test if variance is larer than 0 and smaller than inf before dividing
-            if ((variance1 > missing) && (variance1 < pow(10.0, 10)))
+            if (p_w > 0)
             {
-                if (p_w > 0)
-                {
-                    TValue stCount1 = (kmerCounts1[i] - p_w * len1) / variance1;
-                    TValue stCount2 = (kmerCounts2[i] - p_w * len2) / variance2;
-                    result += stCount1 * stCount2;
-                }
+                TValue stCount1 = (kmerCounts1[i] - p_w * len1) / variance1;
+                TValue stCount2 = (kmerCounts2[i] - p_w * len2) / variance2;
+                result += stCount1 * stCount2;
             }
         }
     }
-    else
+}
+
+/*
+ * Higher order background model: the Markov model is built from the concatenation of both sequences.
+ */
+template <typename TValue, typename TSequence>
+void _d2star(TValue & result,
+             TSequence const & sequence1,
+             String<unsigned> const & kmerCounts1,
+             TSequence const & sequence2,
+             String<unsigned> const & kmerCounts2,
+             AFScore<D2Star> const & score)
+{
+    typedef typename Value<TSequence>::Type              TAlphabet;
+    typedef typename UnmaskedAlphabet_<TAlphabet>::Type  TUnmaskedAlphabet;
+
+    TSequence seq1seq2;
+    append(seq1seq2, sequence1);
+    append(seq1seq2, sequence2);
+    result = 0.0;
+
+    StringSet<String<TUnmaskedAlphabet> > bgSequences;
+    stringToStringSet(bgSequences, seq1seq2);  // Create unmasked sequences
+    MarkovModel<TUnmaskedAlphabet, TValue> backgroundModel(score.bgModelOrder);
+    buildMarkovModel(backgroundModel, bgSequences);
+
+    unsigned nvals = length(kmerCounts1);  // Number of kmers
+    int len1 = _alignmentFreeSum(kmerCounts1);
+    int len2 = _alignmentFreeSum(kmerCounts2);
+
+    String<TUnmaskedAlphabet> w;
+    for (unsigned i = 0; i < nvals; ++i)
     {
-        // --------------------------------------------------------------------
-        // Higher Order Background Model
-        // --------------------------------------------------------------------
-
-        String<unsigned> kmerCounts1;
-        String<unsigned> kmerCounts2;
-        StringSet<String<TUnmaskedAlphabet> > bgSequences;
-        stringToStringSet(bgSequences, seq1seq2);  // Create unmasked sequences
-        MarkovModel<TUnmaskedAlphabet, TValue> backgroundModel(score.bgModelOrder);
-        buildMarkovModel(backgroundModel, bgSequences);
-        countKmers(kmerCounts1, sequence1, score.kmerSize);
-        countKmers(kmerCounts2, sequence2, score.kmerSize);
-
-        unsigned nvals = length(kmerCounts1);  // Number of kmers
-        int len1 = 0;
-        int len2 = 0;
-
-        for (unsigned l = 0; l < nvals; l++)
-        {
-            len1 += kmerCounts1[l];
-            len2 += kmerCounts2[l];
-        }
-        String<TValue> probabilities;
-        resize(probabilities, nvals, missing);
-        for (unsigned i = 0; i < nvals; ++i)
+        TValue p_w = 1.0;  // Probability of kmer
+        TValue variance = 0.0;
+        unhash(w, i, score.kmerSize);
+        p_w = emittedProbability(backgroundModel, w);
+        variance = ((TValue) pow(((TValue) len1 * len2), 0.5)) * p_w;
+        TValue variance1 = 0.0;
+        TValue variance2 = 0.0;
+
+        variance1 = pow(len1 * p_w, 0.5);
+        variance2 = pow(len2 * p_w, 0.5);
+
+        // Calculate standardised kmer Count
+        if ((variance > pow(10.0, -10)) && (variance < pow(10.0, 10)))
         {
-            TValue p_w = 1.0;  // Probability of kmer
-            TValue variance = 0.0;
-            String<TUnmaskedAlphabet> w;
-            unhash(w, i, score.kmerSize);
-            p_w = emittedProbability(backgroundModel, w);
-            variance = ((TValue) pow(((TValue) len1 * len2), 0.5)) * p_w;
-            TValue variance1 = 0.0;
-            TValue variance2 = 0.0;
-
-            variance1 = pow(len1 * p_w, 0.5);
-            variance2 = pow(len2 * p_w, 0.5);
-
-            // Calculate standardised kmer Count
-            if ((variance > pow(10.0, -10)) && (variance < pow(10.0, 10)))
+            if (p_w > 0)
             {
-                if (p_w > 0)
-                {
-                    TValue stCount1 = (kmerCounts1[i] - p_w * len1) / variance1;
-                    TValue stCount2 = (kmerCounts2[i] - p_w * len2) / variance2;
-                    result += stCount1 * stCount2;
-                 }
-            }
+                TValue stCount1 = (kmerCounts1[i] - p_w * len1) / variance1;
+                TValue stCount2 = (kmerCounts2[i] - p_w * len2) / variance2;
+                result += stCount1 * stCount2;
+             }
         }
     }
 }
@@ -47,6 +47,27 @@
 
 namespace seqan {
 
+// Computes the D2z score of two sequences from the cached kmer counts and background models (a StringSet of
+// nucleotide frequencies or a String of Markov models), used by _alignmentFreeFillMatrix().
+template <typename TValue, typename TBackground>
+struct AlignmentFreePairD2z_
+{
+    StringSet<String<unsigned> > const & kmerCounts;
+    TBackground & background;
+    AFScore<D2z> const & score;
+
+    AlignmentFreePairD2z_(StringSet<String<unsigned> > const & kmerCounts_, TBackground & background_,
+                          AFScore<D2z> const & score_) :
+        kmerCounts(kmerCounts_), background(background_), score(score_)
+    {}
+
+    void operator()(TValue & result, unsigned rowIndex, unsigned colIndex)
+    {
+        _alignmentFreeCompareCounts(result, kmerCounts[rowIndex], background[rowIndex], kmerCounts[colIndex],
+                                    background[colIndex], score);
+    }
+};
+
 /*
  * _alignmentFreeComparison is called by alignmentFreeComparison() (see alignment_free_comparison.h)
  */
@@ -58,10 +79,6 @@ void _alignmentFreeComparison(Matrix<TValue, 2> & scoreMatrix,
     typedef typename Value<TStringSet>::Type                                    TString;
     typedef typename Value<TString>::Type                                       TAlphabet;
     typedef typename UnmaskedAlphabet_<TAlphabet>::Type                         TUnmaskedAlphabet;
-    typedef typename Iterator<TStringSet const>::Type                           TIteratorSet;
-    typedef typename Iterator<StringSet<String<unsigned> > >::Type              TIteratorSetUnsigned;
-    typedef typename Iterator<StringSet<String<double> > >::Type                TIteratorSetDouble;
-    typedef typename Iterator<String<MarkovModel<TUnmaskedAlphabet> > >::Type   TIteratorMarkovModel;
 
     unsigned seqNumber = length(sequenceSet);
 
@@ -86,36 +103,17 @@ void _alignmentFreeComparison(Matrix<TValue, 2> & scoreMatrix,
         StringSet<String<double> > backgroundFrequencies;
         resize(backgroundFrequencies, seqNumber);
 
-        // Count all kmers and all background nucleotide frequencies and store them in stringSets
-        TIteratorSetUnsigned itKmerCounts = begin(kmerCounts);
-        TIteratorSetDouble itBackgroundFrequencies = begin(backgroundFrequencies);
-
-        TIteratorSet itSeqSet = begin(sequenceSet);
-        for (; itSeqSet < end(sequenceSet); ++itSeqSet)
-        {
-            countKmers(*itKmerCounts, *itBackgroundFrequencies, *itSeqSet, score.kmerSize);
-            ++itKmerCounts;
-            ++itBackgroundFrequencies;
-        }
+        // Count all kmers and all background nucleotide frequencies once per sequence and store them in stringSets
+        SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+        for (int seqIndex = 0; seqIndex < (int)seqNumber; ++seqIndex)
+            countKmers(kmerCounts[seqIndex], backgroundFrequencies[seqIndex], sequenceSet[seqIndex], score.kmerSize);
         if(score.verbose)
         {
             std::cout << "\ncounted words";
         }
         // Calculate all pairwise scores and store them in scoreMatrix
-        for (unsigned rowIndex = 0; rowIndex < seqNumber; ++rowIndex)
-        {
-            if(score.verbose)
-            {
-                std::cout << "\nSequence number " << rowIndex;
-            }
-            for (unsigned colIndex = rowIndex; colIndex < seqNumber; ++colIndex)
-            {
-                _alignmentFreeCompareCounts(value(scoreMatrix, rowIndex, colIndex), kmerCounts[rowIndex],
-                                            backgroundFrequencies[rowIndex], kmerCounts[colIndex],
-                                            backgroundFrequencies[colIndex], score);
-                value(scoreMatrix, colIndex, rowIndex) = value(scoreMatrix, rowIndex, colIndex);  // Copy symmetric entries
-            }
-        }
+        AlignmentFreePairD2z_<TValue, StringSet<String<double> > > pairScore(kmerCounts, backgroundFrequencies, score);
+        _alignmentFreeFillMatrix(scoreMatrix, seqNumber, pairScore, score.verbose);
     }
     else
     {
@@ -125,41 +123,22 @@ void _alignmentFreeComparison(Matrix<TValue, 2> & scoreMatrix,
 
         String<MarkovModel<TUnmaskedAlphabet> > backgroundModels;
         resize(backgroundModels, seqNumber, MarkovModel<TUnmaskedAlphabet>(score.bgModelOrder));
-        TIteratorMarkovModel itMM = begin(backgroundModels);
-        TIteratorSet itSeqSet = begin(sequenceSet);
-        // Count all kmers and all background nucleotide frequencies and store them in StringSets
-        TIteratorSetUnsigned itKmerCounts = begin(kmerCounts);
 
-        for (; itSeqSet < end(sequenceSet); ++itSeqSet)
+        // Count all kmers and estimate the background models once per sequence
+        SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+        for (int seqIndex = 0; seqIndex < (int)seqNumber; ++seqIndex)
         {
-            countKmers(*itKmerCounts, *itMM, *itSeqSet, score.kmerSize);
-            ++itKmerCounts;
-            if (itMM < end(backgroundModels))
-            {
-                itMM->_computeAuxiliaryMatrices();
-                ++itMM;
-            }
-
+            countKmers(kmerCounts[seqIndex], backgroundModels[seqIndex], sequenceSet[seqIndex], score.kmerSize);
+            backgroundModels[seqIndex]._computeAuxiliaryMatrices();
         }
         if(score.verbose)
         {
             std::cout << "\ncounted words";
         }
         // Calculate all pairwise scores and store them in scoreMatrix
-        for (unsigned rowIndex = 0; rowIndex < seqNumber; ++rowIndex)
-        {
-            if(score.verbose)
-            {
-                std::cout << "\nSequence number " << rowIndex;
-            }
-            for (unsigned colIndex = rowIndex; colIndex < seqNumber; ++colIndex)
-            {
-                _alignmentFreeCompareCounts(value(scoreMatrix, rowIndex, colIndex), kmerCounts[rowIndex],
-                                            backgroundModels[rowIndex], kmerCounts[colIndex],
-                                            backgroundModels[colIndex], score);
-                value(scoreMatrix, colIndex, rowIndex) = value(scoreMatrix, rowIndex, colIndex);  // Copy symmetric entries
-            }
-        }
+        AlignmentFreePairD2z_<TValue, String<MarkovModel<TUnmaskedAlphabet> > > pairScore(kmerCounts, backgroundModels,
+                                                                                          score);
+        _alignmentFreeFillMatrix(scoreMatrix, seqNumber, pairScore, score.verbose);
     }
 }
 
@@ -502,18 +481,9 @@ void _alignmentFreeCompareCounts(TValue & result,
                                 AFScore<D2z> const & score)
 {
     typedef typename Value<TStringBG>::Type TValueBG;
-    TValueBG sum = 0;
-    unsigned len1 = score.kmerSize - 1;
-    unsigned len2 = score.kmerSize - 1;
-    unsigned nvals = length(kmerCounts1);
-
-    for (unsigned l = 0; l < nvals; l++)
-    {
-        len1 += kmerCounts1[l];
-        len2 += kmerCounts2[l];
-
-        sum += kmerCounts1[l] * kmerCounts2[l];
-    }
+    TValueBG sum = _alignmentFreeDotProduct(kmerCounts1, kmerCounts2);
+    unsigned len1 = score.kmerSize - 1 + _alignmentFreeSum(kmerCounts1);
+    unsigned len2 = score.kmerSize - 1 + _alignmentFreeSum(kmerCounts2);
 
     TValueBG q1[4];
     TValueBG q2[4];
@@ -551,19 +521,10 @@ void _alignmentFreeCompareCounts(TValue & result,
                                 MarkovModel<TAlphabet, TValue, TSpec> /*const*/ & bgModel2,
                                 AFScore<D2z> const & score)
 {
-    unsigned nvals = length(kmerCounts1);
-    int sum = 0;
-    int sumCounts1 = score.kmerSize - 1;
-    int sumCounts2 = score.kmerSize - 1;
-
-    for (unsigned l = 0; l < nvals; l++)
-    {
-        sumCounts1 += kmerCounts1[l];
-        sumCounts2 += kmerCounts2[l];
-        sum += value(kmerCounts1, l) * value(kmerCounts2, l);  // Calculate the inner product
-    }
+    int sumCounts1 = score.kmerSize - 1 + _alignmentFreeSum(kmerCounts1);
+    int sumCounts2 = score.kmerSize - 1 + _alignmentFreeSum(kmerCounts2);
 
-    TValue D2 = (TValue) sum;
+    TValue D2 = (TValue) _alignmentFreeDotProduct(kmerCounts1, kmerCounts2);  // Calculate the inner product
 
     // Compute mean and variance
     TValue indicatorexpectation = 0;
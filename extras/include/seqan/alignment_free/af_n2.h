@@ -131,6 +131,26 @@ inline void _initialiseKmerNeighbourhood(StringSet<String<unsigned> > & kmerNeig
     }
 }
 
+// Computes the N2 score of two sequences from the cached standardised kmer counts, used by _alignmentFreeFillMatrix().
+template <typename TValue, typename TStringSet>
+struct AlignmentFreePairN2_
+{
+    String<unsigned> const & revComIndex;
+    TStringSet const & standardisedKmerCounts;
+    AFScore<N2> const & score;
+
+    AlignmentFreePairN2_(String<unsigned> const & revComIndex_, TStringSet const & standardisedKmerCounts_,
+                         AFScore<N2> const & score_) :
+        revComIndex(revComIndex_), standardisedKmerCounts(standardisedKmerCounts_), score(score_)
+    {}
+
+    void operator()(TValue & result, unsigned rowIndex, unsigned colIndex)
+    {
+        _alignmentFreeCompareCounts(result, revComIndex, standardisedKmerCounts[rowIndex],
+                                    standardisedKmerCounts[colIndex], score);
+    }
+};
+
 /*
  * _alignmentFreeComparison is called by alignmentFreeComparison() (see alignment_free_comparison.h)
  */
@@ -145,8 +165,6 @@ void _alignmentFreeComparison(Matrix<TValue, 2> & scoreMatrix,
     typedef typename Value<TStringSet>::Type                            TString;
     typedef typename Value<TString>::Type                               TAlphabet;
     typedef typename UnmaskedAlphabet_<TAlphabet>::Type                 TUnmaskedAlphabet;
-    typedef typename Iterator<TStringSet const>::Type                   TIteratorSet;
-    typedef typename Iterator<StringSet<String<double> > >::Type        TIteratorSetDouble;
 
 
     // Initialise the reverse complement hash table
@@ -170,35 +188,25 @@ void _alignmentFreeComparison(Matrix<TValue, 2> & scoreMatrix,
 
     StringSet<String<double> > standardisedKmerCounts;
     resize(standardisedKmerCounts, seqNumber);
-    // Count all kmers and all background nucleotide frequencies and store them in StringSets
-    TIteratorSetDouble itStandardisedKmerCounts = begin(standardisedKmerCounts);
-    TIteratorSet itSeqSet = begin(sequenceSet);
-    for (; itSeqSet < end(sequenceSet); ++itSeqSet)
+    // Count and standardise all kmers once per sequence and store them in StringSets
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+    for (int seqIndex = 0; seqIndex < (int)seqNumber; ++seqIndex)
     {
-
-        _standardiseCounts(*itStandardisedKmerCounts, revComIndex, kmerNeighbourhood, *itSeqSet, score);
-        if(score.verbose)
+        _standardiseCounts(standardisedKmerCounts[seqIndex], revComIndex, kmerNeighbourhood, sequenceSet[seqIndex],
+                           score);
+        if (score.norm == true) // Normalise the score so that sequence-self-comparisons are always 1
         {
-            std::cout << "\n" << position(itSeqSet);
-        }
-        ++itStandardisedKmerCounts;
-    }
-
-    if (score.norm == true) // Normalise the score so that sequence-self-comparisons are always 1
-    {
-        itStandardisedKmerCounts = begin(standardisedKmerCounts);
-        for (; itStandardisedKmerCounts < end(standardisedKmerCounts); ++itStandardisedKmerCounts)
-        {
-            TValue normValue = 0.0;
-            for (unsigned i = 0; i < length(value(itStandardisedKmerCounts)); ++i)
-            {
-                normValue += value(itStandardisedKmerCounts)[i] * value(itStandardisedKmerCounts)[i];
-            }
-            for (unsigned i = 0; i < length(value(itStandardisedKmerCounts)); ++i)
+            String<double> & counts = standardisedKmerCounts[seqIndex];
+            TValue normValue = _alignmentFreeDotProduct(counts, counts);
+            for (unsigned i = 0; i < length(counts); ++i)
             {
-                value(itStandardisedKmerCounts)[i] /= sqrt(normValue);
+                counts[i] /= sqrt(normValue);
             }
-
+        }
+        if(score.verbose)
+        {
+            SEQAN_OMP_PRAGMA(critical (alignment_free_verbose))
+            std::cout << "\n" << seqIndex;
         }
     }
 
@@ -231,18 +239,8 @@ void _alignmentFreeComparison(Matrix<TValue, 2> & scoreMatrix,
     }
 
     // Calculate all pairwise scores and store them in scoreMatrix
-    for (unsigned rowIndex = 0; rowIndex < seqNumber; ++rowIndex)
-    {
-        if(score.verbose)
-        {
-            std::cout << "\nSequence number " << rowIndex;
-        }
-        for (unsigned colIndex = rowIndex; colIndex < seqNumber; ++colIndex)
-        {
-            _alignmentFreeCompareCounts(value(scoreMatrix, rowIndex, colIndex), revComIndex, standardisedKmerCounts[rowIndex], standardisedKmerCounts[colIndex], score);
-            value(scoreMatrix, colIndex, rowIndex) = value(scoreMatrix, rowIndex, colIndex);  // Copy symmetric entries
-        }
-    }
+    AlignmentFreePairN2_<TValue, StringSet<String<double> > > pairScore(revComIndex, standardisedKmerCounts, score);
+    _alignmentFreeFillMatrix(scoreMatrix, seqNumber, pairScore, score.verbose);
 }
 
 /*
@@ -251,27 +249,18 @@ void _alignmentFreeComparison(Matrix<TValue, 2> & scoreMatrix,
 template <typename TValue, typename TString>
 void
 _alignmentFreeCompareCounts(TValue & result,
-                            String<unsigned> const revComIndex,
+                            String<unsigned> const & revComIndex,
                             TString const & kmerCounts1,
                             TString const & kmerCounts2,
                             AFScore<N2> const & score)
 {
-    typedef typename Iterator<TString const, Rooted>::Type    TIteratorTString;
-
-    TIteratorTString it1 = begin(kmerCounts1);
-    TIteratorTString it2 = begin(kmerCounts2);
-    result = 0.0;
+    result = (TValue)_alignmentFreeDotProduct(kmerCounts1, kmerCounts2);
     TValue resultRC = 0.0;
-    for (; it1 < end(kmerCounts1); ++it1)
+    // Computation of the reverse complement strand score
+    if ((score.revCom != "") && (score.revCom != "both_strands"))
     {
-        result += (TValue)(value(it1) * value(it2));
-        // Computation of the reverse complement strand score
-        if ((score.revCom != "") && (score.revCom != "both_strands"))
-        {
-            unsigned hashValue = revComIndex[position(it1)];
-            resultRC += (TValue)(value(it1) * kmerCounts2[hashValue]);
-        }
-        ++it2;
+        for (unsigned i = 0; i < length(kmerCounts1); ++i)
+            resultRC += (TValue)(kmerCounts1[i] * kmerCounts2[revComIndex[i]]);
     }
 
     if (score.revCom == "mean")
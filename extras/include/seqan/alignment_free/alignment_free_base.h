@@ -492,6 +492,128 @@ struct AFScore<D2z>
     {}
 };
 
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _alignmentFreeDotProduct()
+// ----------------------------------------------------------------------------
+
+// Inner products of count vectors.  Several independent accumulators break the dependency chain of the additions so the
+// loops can be vectorised, the double version uses SSE2 explicitly.
+
+inline __uint64 _alignmentFreeDotProduct(unsigned const * a, unsigned const * b, size_t n)
+{
+    __uint64 sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        sum0 += (__uint64)a[i] * b[i];
+        sum1 += (__uint64)a[i + 1] * b[i + 1];
+        sum2 += (__uint64)a[i + 2] * b[i + 2];
+        sum3 += (__uint64)a[i + 3] * b[i + 3];
+    }
+    for (; i < n; ++i)
+        sum0 += (__uint64)a[i] * b[i];
+    return sum0 + sum1 + sum2 + sum3;
+}
+
+inline double _alignmentFreeDotProduct(double const * a, double const * b, size_t n)
+{
+    size_t i = 0;
+    double sum = 0.0;
+#ifdef __SSE2__
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    for (; i + 4 <= n; i += 4)
+    {
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+    }
+    double tmp[2];
+    _mm_storeu_pd(tmp, _mm_add_pd(acc0, acc1));
+    sum = tmp[0] + tmp[1];
+#endif  // #ifdef __SSE2__
+    for (; i < n; ++i)
+        sum += a[i] * b[i];
+    return sum;
+}
+
+// The inner product of unsigned counts can exceed 32 bits, it is returned as __uint64.
+template <typename TValue>
+struct AlignmentFreeDotProductValue_
+{
+    typedef __uint64 Type;
+};
+
+template <>
+struct AlignmentFreeDotProductValue_<double>
+{
+    typedef double Type;
+};
+
+template <typename TValue, typename TSpec>
+inline typename AlignmentFreeDotProductValue_<TValue>::Type
+_alignmentFreeDotProduct(String<TValue, TSpec> const & a, String<TValue, TSpec> const & b)
+{
+    SEQAN_ASSERT_EQ(length(a), length(b));
+    if (empty(a))
+        return 0;
+    return _alignmentFreeDotProduct(&a[0], &b[0], length(a));
+}
+
+inline unsigned _alignmentFreeSum(String<unsigned> const & counts)
+{
+    unsigned sum = 0;
+    for (unsigned i = 0; i < length(counts); ++i)
+        sum += counts[i];
+    return sum;
+}
+
+// ----------------------------------------------------------------------------
+// Function _alignmentFreeFillMatrix()
+// ----------------------------------------------------------------------------
+
+// Fills the symmetric score matrix.  The upper triangle is cut into square tiles that are computed in parallel, every
+// cell is written by exactly one thread.  pairScore(result, row, col) computes the score of one pair from data that
+// was computed once per sequence beforehand.
+template <typename TValue, typename TPairScore>
+void _alignmentFreeFillMatrix(Matrix<TValue, 2> & scoreMatrix,
+                              unsigned seqNumber,
+                              TPairScore & pairScore,
+                              bool verbose)
+{
+    // Small tiles keep the count vectors of a tile in the cache and balance the load of the triangle.
+    unsigned const tileSize = 16;
+    unsigned tileNumber = (seqNumber + tileSize - 1) / tileSize;
+    String<Pair<unsigned> > tiles;
+    reserve(tiles, tileNumber * (tileNumber + 1) / 2, Exact());
+    for (unsigned rowTile = 0; rowTile < tileNumber; ++rowTile)
+        for (unsigned colTile = rowTile; colTile < tileNumber; ++colTile)
+            appendValue(tiles, Pair<unsigned>(rowTile * tileSize, colTile * tileSize));
+
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+    for (int tile = 0; tile < (int)length(tiles); ++tile)
+    {
+        unsigned rowBegin = tiles[tile].i1;
+        unsigned colBegin = tiles[tile].i2;
+        unsigned rowEnd = _min(rowBegin + tileSize, seqNumber);
+        unsigned colEnd = _min(colBegin + tileSize, seqNumber);
+        if (verbose && rowBegin == colBegin)
+        {
+            SEQAN_OMP_PRAGMA(critical (alignment_free_verbose))
+            std::cout << "\nSequence number " << rowBegin << " to " << (rowEnd - 1);
+        }
+        for (unsigned rowIndex = rowBegin; rowIndex < rowEnd; ++rowIndex)
+            for (unsigned colIndex = _max(rowIndex, colBegin); colIndex < colEnd; ++colIndex)
+            {
+                pairScore(value(scoreMatrix, rowIndex, colIndex), rowIndex, colIndex);
+                value(scoreMatrix, colIndex, rowIndex) = value(scoreMatrix, rowIndex, colIndex);  // Copy symmetric entries
+            }
+    }
+}
+
 }  // namespace seqan
 
 #endif  // SEQAN_EXTRAS_INCLUDE_SEQAN_ALIGNMENT_FREE_ALIGNMENT_FREE_BASE_H_
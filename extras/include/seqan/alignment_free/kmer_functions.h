@@ -195,6 +195,7 @@ void countKmers(String<unsigned> & kmerCounts, TString const & sequence, unsigne
     typedef typename Value<TString>::Type               TAlphabet;
     typedef typename UnmaskedAlphabet_<TAlphabet>::Type TUnmaskedAlphabet;
     typedef typename Iterator<TString const>::Type      TIterator;
+    typedef typename Iterator<TString const, Standard>::Type TStdIterator;
     typedef typename Position<TIterator>::Type          TPosition;
     typedef Shape<TUnmaskedAlphabet, SimpleShape>       TShape;
     // Declare variables
@@ -216,6 +217,9 @@ void countKmers(String<unsigned> & kmerCounts, TString const & sequence, unsigne
             counterN = i + 1;
         }
     }
+    // The hash values of all kmers are computed blockwise, kmers covering an "N" are skipped below
+    BulkHasher_<TShape, TStdIterator> hasher(myShape, begin(sequence, Standard()),
+                                             (length(sequence) < k) ? 0 : length(sequence) - k + 1);
     for (; itSequence <= (end(sequence) - k); ++itSequence)
     {
         // Check if there is a "N" at the end of the new kmer
@@ -223,11 +227,9 @@ void countKmers(String<unsigned> & kmerCounts, TString const & sequence, unsigne
             counterN = k;  // Do not consider any kmer covering this "N"
 
         // If there is no "N" overlapping with the current kmer, count it
+        unsigned hashValue = hasher.next();
         if (counterN <= 0)
-        {
-            unsigned hashValue = hash(myShape, itSequence);
             ++kmerCounts[hashValue];
-        }
         counterN--;
     }
 }
@@ -242,6 +244,7 @@ void countKmers(String<unsigned> & kmerCounts, String<TValueBG> & backgroundFreq
     typedef typename Value<TString>::Type                    TAlphabet;
     typedef typename UnmaskedAlphabet_<TAlphabet>::Type      TUnmaskedAlphabet;
     typedef typename Iterator<TString const>::Type           TIterator;
+    typedef typename Iterator<TString const, Standard>::Type TStdIterator;
     typedef typename Iterator<String<TValueBG> >::Type       TIteratorTStringBG;
     typedef typename Position<TIterator>::Type               TPosition;
     typedef Shape<TUnmaskedAlphabet, SimpleShape>            TShape;
@@ -273,6 +276,8 @@ void countKmers(String<unsigned> & kmerCounts, String<TValueBG> & backgroundFreq
     }
 
     int sumBG = 0;  // Count the number of nucleotides for the nucleotide frequency calculation (Ns are not considered anymore).
+    BulkHasher_<TShape, TStdIterator> hasher(myShape, begin(sequence, Standard()),
+                                             (length(sequence) < k) ? 0 : length(sequence) - k + 1);
     for (; itSequence <= (end(sequence) - k); ++itSequence)
     {
         // Check if there is a "N" at the end of the new kmer
@@ -281,11 +286,9 @@ void countKmers(String<unsigned> & kmerCounts, String<TValueBG> & backgroundFreq
             counterN = k;  // Do not consider any kmer covering this "N"
         }
         // If there is no "N" overlapping with the current kmer, count it.
+        unsigned hashValue = hasher.next();
         if (counterN <= 0)
-        {
-            unsigned hashValue = hash(myShape, itSequence);
             ++kmerCounts[hashValue];
-        }
         // Check if there is a "N" at the end of the new background word, here single letters only.
         if (_repeatMaskValue(value(itSequence)))
         {
@@ -332,6 +335,7 @@ void countKmers(String<unsigned> & kmerCounts, MarkovModel<TAlphabetBG, TValue>
     //typedef typename Value<TString>::Type                   TAlphabet;
     //typedef typename UnmaskedAlphabet_<TAlphabet>::Type     TUnmaskedAlphabet;
     typedef typename Iterator<TString const, Rooted>::Type  TIterator;
+    typedef typename Iterator<TString const, Standard>::Type TStdIterator;
     //typedef typename Iterator<String<int>, Rooted>::Type    TIteratorInt;
     typedef typename Position<TIterator>::Type              TPosition;
     typedef Shape<TAlphabetBG, SimpleShape>                 TShape;
@@ -367,6 +371,8 @@ void countKmers(String<unsigned> & kmerCounts, MarkovModel<TAlphabetBG, TValue>
     int counterN = 0;
     TPosition startSplitSequence = position(itSeq);  // The position of possible start of a sequence after NNs is stored to split sequences.
 
+    BulkHasher_<TShape, TStdIterator> hasher(myShape, begin(sequence, Standard()) + position(itSeq),
+                                             (length(sequence) < position(itSeq) + k) ? 0 : length(sequence) - k + 1 - position(itSeq));
     for (; itSeq <= (end(sequence) - k); ++itSeq)
     {
         if (_repeatMaskValue(value(itSeq + (k - 1))))
@@ -378,11 +384,9 @@ void countKmers(String<unsigned> & kmerCounts, MarkovModel<TAlphabetBG, TValue>
 
             startSplitSequence = (position(itSeq) + k);  // Position after N, possible start
         }
+        unsigned hashValue = hasher.next();
         if (counterN <= 0)
-        {
-            unsigned hashValue = hash(myShape, itSeq);
             ++kmerCounts[hashValue];
-        }
 
         counterN--;
     }
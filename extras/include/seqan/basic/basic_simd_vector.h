@@ -38,7 +38,7 @@
 #define SEQAN_EXTRAS_INCLUDE_SEQAN_BASIC_SIMD_VECTOR_H_
 
 #ifdef __SSE4_1__
-//#include <immintrin.h>
+#include <immintrin.h>
 #else
 // SSE4.1 or greater required
 // #warning "SSE4.1 instruction set not enabled"
@@ -51,6 +51,9 @@ namespace seqan {
 // Useful Macros
 // ============================================================================
 
+// Newer compilers do not convert implicitly between the SimdVector types and the intrinsic types.
+#define SEQAN_VECTOR_CAST_(T, value) reinterpret_cast<T>(value)
+
 #define SEQAN_DEFINE_SIMD_VECTOR_GETVALUE_(TSimdVector)                                                 \
 template <typename TPosition>                                                                           \
 inline typename Value<TSimdVector>::Type                                                                \
@@ -148,59 +151,62 @@ SEQAN_DEFINE_SIMD_VECTOR_(SimdVector2Double,    double,         16);
 // ============================================================================
 
 #ifdef __AVX__
-inline SimdVector32Char&    fill(SimdVector32Char &vector,   char x)            { return vector = _mm256_set1_epi8(x); }
-inline SimdVector32SChar&   fill(SimdVector32SChar &vector,  signed char x)     { return vector = _mm256_set1_epi8(x); }
-inline SimdVector32UChar&   fill(SimdVector32UChar &vector,  unsigned char x)   { return vector = _mm256_set1_epi8(x); }
-inline SimdVector16Short&   fill(SimdVector16Short &vector,  short x)           { return vector = _mm256_set1_epi16(x); }
-inline SimdVector16UShort&  fill(SimdVector16UShort &vector, unsigned short x)  { return vector = _mm256_set1_epi16(x); }
-inline SimdVector8Int&      fill(SimdVector8Int &vector,     int x)             { return vector = _mm256_set1_epi32(x); }
-inline SimdVector8UInt&     fill(SimdVector8UInt &vector,    unsigned int x)    { return vector = _mm256_set1_epi32(x); }
-inline SimdVector4Int64&    fill(SimdVector4Int64 &vector,   __int64 x)         { return vector = _mm256_set1_epi64x(x); }
-inline SimdVector4UInt64&   fill(SimdVector4UInt64 &vector,  __uint64 x)        { return vector = _mm256_set1_epi64x(x); }
-inline SimdVector8Float&    fill(SimdVector8Float &vector,   float x)           { return vector = _mm256_set1_ps(x); }
-inline SimdVector4Double&   fill(SimdVector4Double &vector,  double x)          { return vector = _mm256_set1_pd(x); }
-
-inline void clear(SimdVector32Char &vector)     { vector = _mm256_setzero_si256(); }
-inline void clear(SimdVector32SChar &vector)    { vector = _mm256_setzero_si256(); }
-inline void clear(SimdVector32UChar &vector)    { vector = _mm256_setzero_si256(); }
-inline void clear(SimdVector16Short &vector)    { vector = _mm256_setzero_si256(); }
-inline void clear(SimdVector16UShort &vector)   { vector = _mm256_setzero_si256(); }
-inline void clear(SimdVector8Int &vector)       { vector = _mm256_setzero_si256(); }
-inline void clear(SimdVector8UInt &vector)      { vector = _mm256_setzero_si256(); }
-inline void clear(SimdVector4Int64 &vector)     { vector = _mm256_setzero_si256(); }
-inline void clear(SimdVector4UInt64 &vector)    { vector = _mm256_setzero_si256(); }
-inline void clear(SimdVector8Float &vector)     { vector = _mm256_setzero_ps(); }
-inline void clear(SimdVector4Double &vector)    { vector = _mm256_setzero_pd(); }
+inline SimdVector32Char&    fill(SimdVector32Char &vector,   char x)            { return vector = SEQAN_VECTOR_CAST_(SimdVector32Char, _mm256_set1_epi8(x)); }
+inline SimdVector32SChar&   fill(SimdVector32SChar &vector,  signed char x)     { return vector = SEQAN_VECTOR_CAST_(SimdVector32SChar, _mm256_set1_epi8(x)); }
+inline SimdVector32UChar&   fill(SimdVector32UChar &vector,  unsigned char x)   { return vector = SEQAN_VECTOR_CAST_(SimdVector32UChar, _mm256_set1_epi8(x)); }
+inline SimdVector16Short&   fill(SimdVector16Short &vector,  short x)           { return vector = SEQAN_VECTOR_CAST_(SimdVector16Short, _mm256_set1_epi16(x)); }
+inline SimdVector16UShort&  fill(SimdVector16UShort &vector, unsigned short x)  { return vector = SEQAN_VECTOR_CAST_(SimdVector16UShort, _mm256_set1_epi16(x)); }
+inline SimdVector8Int&      fill(SimdVector8Int &vector,     int x)             { return vector = SEQAN_VECTOR_CAST_(SimdVector8Int, _mm256_set1_epi32(x)); }
+inline SimdVector8UInt&     fill(SimdVector8UInt &vector,    unsigned int x)    { return vector = SEQAN_VECTOR_CAST_(SimdVector8UInt, _mm256_set1_epi32(x)); }
+inline SimdVector4Int64&    fill(SimdVector4Int64 &vector,   __int64 x)         { return vector = SEQAN_VECTOR_CAST_(SimdVector4Int64, _mm256_set1_epi64x(x)); }
+inline SimdVector4UInt64&   fill(SimdVector4UInt64 &vector,  __uint64 x)        { return vector = SEQAN_VECTOR_CAST_(SimdVector4UInt64, _mm256_set1_epi64x(x)); }
+inline SimdVector8Float&    fill(SimdVector8Float &vector,   float x)           { return vector = SEQAN_VECTOR_CAST_(SimdVector8Float, _mm256_set1_ps(x)); }
+inline SimdVector4Double&   fill(SimdVector4Double &vector,  double x)          { return vector = SEQAN_VECTOR_CAST_(SimdVector4Double, _mm256_set1_pd(x)); }
+
+inline void clear(SimdVector32Char &vector)     { vector = SEQAN_VECTOR_CAST_(SimdVector32Char, _mm256_setzero_si256()); }
+inline void clear(SimdVector32SChar &vector)    { vector = SEQAN_VECTOR_CAST_(SimdVector32SChar, _mm256_setzero_si256()); }
+inline void clear(SimdVector32UChar &vector)    { vector = SEQAN_VECTOR_CAST_(SimdVector32UChar, _mm256_setzero_si256()); }
+inline void clear(SimdVector16Short &vector)    { vector = SEQAN_VECTOR_CAST_(SimdVector16Short, _mm256_setzero_si256()); }
+inline void clear(SimdVector16UShort &vector)   { vector = SEQAN_VECTOR_CAST_(SimdVector16UShort, _mm256_setzero_si256()); }
+inline void clear(SimdVector8Int &vector)       { vector = SEQAN_VECTOR_CAST_(SimdVector8Int, _mm256_setzero_si256()); }
+inline void clear(SimdVector8UInt &vector)      { vector = SEQAN_VECTOR_CAST_(SimdVector8UInt, _mm256_setzero_si256()); }
+inline void clear(SimdVector4Int64 &vector)     { vector = SEQAN_VECTOR_CAST_(SimdVector4Int64, _mm256_setzero_si256()); }
+inline void clear(SimdVector4UInt64 &vector)    { vector = SEQAN_VECTOR_CAST_(SimdVector4UInt64, _mm256_setzero_si256()); }
+inline void clear(SimdVector8Float &vector)     { vector = SEQAN_VECTOR_CAST_(SimdVector8Float, _mm256_setzero_ps()); }
+inline void clear(SimdVector4Double &vector)    { vector = SEQAN_VECTOR_CAST_(SimdVector4Double, _mm256_setzero_pd()); }
 
 #ifdef __AVX2__
-inline SimdVector32Char  shuffleVector(SimdVector32Char  const &vector, SimdVector32Char  const &indices) { return _mm256_shuffle_epi8(vector, indices); }
-inline SimdVector32SChar shuffleVector(SimdVector32SChar const &vector, SimdVector32SChar const &indices) { return _mm256_shuffle_epi8(vector, indices); }
-inline SimdVector32UChar shuffleVector(SimdVector32UChar const &vector, SimdVector32UChar const &indices) { return _mm256_shuffle_epi8(vector, indices); }
-
-inline SimdVector32Char   shiftRightLogical(SimdVector32Char   const &vector, const int imm) { return _mm256_srli_epi16(vector, imm) & _mm256_set1_epi8(0xff >> imm); }
-inline SimdVector32SChar  shiftRightLogical(SimdVector32SChar  const &vector, const int imm) { return _mm256_srli_epi16(vector, imm) & _mm256_set1_epi8(0xff >> imm); }
-inline SimdVector32UChar  shiftRightLogical(SimdVector32UChar  const &vector, const int imm) { return _mm256_srli_epi16(vector, imm) & _mm256_set1_epi8(0xff >> imm); }
-inline SimdVector16Short  shiftRightLogical(SimdVector16Short  const &vector, const int imm) { return _mm256_srli_epi16(vector, imm); }
-inline SimdVector16UShort shiftRightLogical(SimdVector16UShort const &vector, const int imm) { return _mm256_srli_epi16(vector, imm); }
-inline SimdVector8Int     shiftRightLogical(SimdVector8Int     const &vector, const int imm) { return _mm256_srli_epi32(vector, imm); }
-inline SimdVector8UInt    shiftRightLogical(SimdVector8UInt    const &vector, const int imm) { return _mm256_srli_epi32(vector, imm); }
-inline SimdVector4Int64   shiftRightLogical(SimdVector4Int64   const &vector, const int imm) { return _mm256_srli_epi64(vector, imm); }
-inline SimdVector4UInt64  shiftRightLogical(SimdVector4UInt64  const &vector, const int imm) { return _mm256_srli_epi64(vector, imm); }
+inline SimdVector32Char  shuffleVector(SimdVector32Char  const &vector, SimdVector32Char  const &indices) { return SEQAN_VECTOR_CAST_(SimdVector32Char, _mm256_shuffle_epi8(SEQAN_VECTOR_CAST_(__m256i, vector), SEQAN_VECTOR_CAST_(__m256i, indices))); }
+inline SimdVector32SChar shuffleVector(SimdVector32SChar const &vector, SimdVector32SChar const &indices) { return SEQAN_VECTOR_CAST_(SimdVector32SChar, _mm256_shuffle_epi8(SEQAN_VECTOR_CAST_(__m256i, vector), SEQAN_VECTOR_CAST_(__m256i, indices))); }
+inline SimdVector32UChar shuffleVector(SimdVector32UChar const &vector, SimdVector32UChar const &indices) { return SEQAN_VECTOR_CAST_(SimdVector32UChar, _mm256_shuffle_epi8(SEQAN_VECTOR_CAST_(__m256i, vector), SEQAN_VECTOR_CAST_(__m256i, indices))); }
+
+inline SimdVector32Char   shiftRightLogical(SimdVector32Char   const &vector, const int imm) { return SEQAN_VECTOR_CAST_(SimdVector32Char, _mm256_srli_epi16(SEQAN_VECTOR_CAST_(__m256i, vector), imm) & _mm256_set1_epi8(0xff >> imm)); }
+inline SimdVector32SChar  shiftRightLogical(SimdVector32SChar  const &vector, const int imm) { return SEQAN_VECTOR_CAST_(SimdVector32SChar, _mm256_srli_epi16(SEQAN_VECTOR_CAST_(__m256i, vector), imm) & _mm256_set1_epi8(0xff >> imm)); }
+inline SimdVector32UChar  shiftRightLogical(SimdVector32UChar  const &vector, const int imm) { return SEQAN_VECTOR_CAST_(SimdVector32UChar, _mm256_srli_epi16(SEQAN_VECTOR_CAST_(__m256i, vector), imm) & _mm256_set1_epi8(0xff >> imm)); }
+inline SimdVector16Short  shiftRightLogical(SimdVector16Short  const &vector, const int imm) { return SEQAN_VECTOR_CAST_(SimdVector16Short, _mm256_srli_epi16(SEQAN_VECTOR_CAST_(__m256i, vector), imm)); }
+inline SimdVector16UShort shiftRightLogical(SimdVector16UShort const &vector, const int imm) { return SEQAN_VECTOR_CAST_(SimdVector16UShort, _mm256_srli_epi16(SEQAN_VECTOR_CAST_(__m256i, vector), imm)); }
+inline SimdVector8Int     shiftRightLogical(SimdVector8Int     const &vector, const int imm) { return SEQAN_VECTOR_CAST_(SimdVector8Int, _mm256_srli_epi32(SEQAN_VECTOR_CAST_(__m256i, vector), imm)); }
+inline SimdVector8UInt    shiftRightLogical(SimdVector8UInt    const &vector, const int imm) { return SEQAN_VECTOR_CAST_(SimdVector8UInt, _mm256_srli_epi32(SEQAN_VECTOR_CAST_(__m256i, vector), imm)); }
+inline SimdVector4Int64   shiftRightLogical(SimdVector4Int64   const &vector, const int imm) { return SEQAN_VECTOR_CAST_(SimdVector4Int64, _mm256_srli_epi64(SEQAN_VECTOR_CAST_(__m256i, vector), imm)); }
+inline SimdVector4UInt64  shiftRightLogical(SimdVector4UInt64  const &vector, const int imm) { return SEQAN_VECTOR_CAST_(SimdVector4UInt64, _mm256_srli_epi64(SEQAN_VECTOR_CAST_(__m256i, vector), imm)); }
 #else
 inline SimdVector32Char  shuffleVector(SimdVector32Char  const &vector, SimdVector32Char  const &indices)
 {
-    return _mm256_permute2f128_si256(
-        _mm256_castsi128_si256 (_mm_shuffle_epi8(_mm256_castsi256_si128(vector), _mm256_castsi256_si128(indices))),
-        _mm256_castsi128_si256 (_mm_shuffle_epi8(_mm256_castsi256_si128(vector), _mm256_extractf128_si256(indices, 1))),
-        0x20);
+    __m256i v = SEQAN_VECTOR_CAST_(__m256i, vector);
+    __m256i i = SEQAN_VECTOR_CAST_(__m256i, indices);
+    return SEQAN_VECTOR_CAST_(SimdVector32Char, _mm256_permute2f128_si256(
+        _mm256_castsi128_si256 (_mm_shuffle_epi8(_mm256_castsi256_si128(v), _mm256_castsi256_si128(i))),
+        _mm256_castsi128_si256 (_mm_shuffle_epi8(_mm256_castsi256_si128(v), _mm256_extractf128_si256(i, 1))),
+        0x20));
 }
 
 inline SimdVector32Char   shiftRightLogical(SimdVector32Char   const &vector, const int imm)
 {
-    return _mm256_permute2f128_si256(
-        _mm256_castsi128_si256 (_mm_srli_epi16(_mm256_castsi256_si128(vector), imm)),
-        _mm256_castsi128_si256 (_mm_srli_epi16(_mm256_extractf128_si256(vector, 1), imm)),
-        0x20) & _mm256_set1_epi8(0xff >> imm);
+    __m256i v = SEQAN_VECTOR_CAST_(__m256i, vector);
+    return SEQAN_VECTOR_CAST_(SimdVector32Char, _mm256_permute2f128_si256(
+        _mm256_castsi128_si256 (_mm_srli_epi16(_mm256_castsi256_si128(v), imm)),
+        _mm256_castsi128_si256 (_mm_srli_epi16(_mm256_extractf128_si256(v, 1), imm)),
+        0x20) & _mm256_set1_epi8(0xff >> imm));
 }
 
 #endif
@@ -213,11 +219,13 @@ SEQAN_FUNC_ENABLE_IF(
 inline testAllZeros(TSimdVector const &vector, TSimdVector const &mask)
 {
 #ifdef __AVX2__
-    return _mm256_testz_si256(vector, mask);
+    return _mm256_testz_si256(SEQAN_VECTOR_CAST_(__m256i, vector), SEQAN_VECTOR_CAST_(__m256i, mask));
 #else
+    __m256i v = SEQAN_VECTOR_CAST_(__m256i, vector);
+    __m256i m = SEQAN_VECTOR_CAST_(__m256i, mask);
     return
-        _mm_testz_si128(_mm256_castsi256_si128(vector), _mm256_castsi256_si128(mask)) &
-        _mm_testz_si128(_mm256_extractf128_si256(vector, 1), _mm256_extractf128_si256(mask, 1));
+        _mm_testz_si128(_mm256_castsi256_si128(v), _mm256_castsi256_si128(m)) &
+        _mm_testz_si128(_mm256_extractf128_si256(v, 1), _mm256_extractf128_si256(m, 1));
 #endif
 }
 
@@ -228,53 +236,55 @@ SEQAN_FUNC_ENABLE_IF(
 inline testAllOnes(TSimdVector const &vector)
 {
 #ifdef __AVX2__
-    return _mm256_testc_si256(vector, _mm256_cmpeq_epi32(vector, vector));
+    return _mm256_testc_si256(SEQAN_VECTOR_CAST_(__m256i, vector),
+                              _mm256_cmpeq_epi32(SEQAN_VECTOR_CAST_(__m256i, vector), SEQAN_VECTOR_CAST_(__m256i, vector)));
 #else
+    __m256i v = SEQAN_VECTOR_CAST_(__m256i, vector);
     return
-        _mm_test_all_ones(_mm256_castsi256_si128(vector)) &
-        _mm_test_all_ones(_mm256_extractf128_si256(vector, 1));
+        _mm_test_all_ones(_mm256_castsi256_si128(v)) &
+        _mm_test_all_ones(_mm256_extractf128_si256(v, 1));
 #endif
 }
 
 #else
 #ifdef __SSE3__
-inline void fill(SimdVector16Char &vector,  char x)             { vector = _mm_set1_epi8(x); }
-inline void fill(SimdVector16SChar &vector, signed char x)      { vector = _mm_set1_epi8(x); }
-inline void fill(SimdVector16UChar &vector, unsigned char x)    { vector = _mm_set1_epi8(x); }
-inline void fill(SimdVector8Short &vector,  short x)            { vector = _mm_set1_epi16(x); }
-inline void fill(SimdVector8UShort &vector, unsigned short x)   { vector = _mm_set1_epi16(x); }
-inline void fill(SimdVector4Int &vector,    int x)              { vector = _mm_set1_epi32(x); }
-inline void fill(SimdVector4UInt &vector,   unsigned int x)     { vector = _mm_set1_epi32(x); }
-inline void fill(SimdVector2Int64 &vector,  __int64 x)          { vector = _mm_set1_epi64x(x); }
-inline void fill(SimdVector2UInt64 &vector, __uint64 x)         { vector = _mm_set1_epi64x(x); }
-inline void fill(SimdVector4Float &vector,   float x)           { vector = _mm_set1_ps(x); }
-inline void fill(SimdVector2Double &vector,  double x)          { vector = _mm_set1_pd(x); }
-
-inline void clear(SimdVector16Char &vector)     { vector = _mm_setzero_si128(); }
-inline void clear(SimdVector16SChar &vector)    { vector = _mm_setzero_si128(); }
-inline void clear(SimdVector16UChar &vector)    { vector = _mm_setzero_si128(); }
-inline void clear(SimdVector8Short &vector)     { vector = _mm_setzero_si128(); }
-inline void clear(SimdVector8UShort &vector)    { vector = _mm_setzero_si128(); }
-inline void clear(SimdVector4Int &vector)       { vector = _mm_setzero_si128(); }
-inline void clear(SimdVector4UInt &vector)      { vector = _mm_setzero_si128(); }
-inline void clear(SimdVector2Int64 &vector)     { vector = _mm_setzero_si128(); }
-inline void clear(SimdVector2UInt64 &vector)    { vector = _mm_setzero_si128(); }
-inline void clear(SimdVector4Float &vector)     { vector = _mm_setzero_ps(); }
-inline void clear(SimdVector2Double &vector)    { vector = _mm_setzero_pd(); }
-
-inline SimdVector16Char  shuffleVector(SimdVector16Char  const &vector, SimdVector16Char  const &indices) { return _mm_shuffle_epi8(vector, indices); }
-inline SimdVector16SChar shuffleVector(SimdVector16SChar const &vector, SimdVector16SChar const &indices) { return _mm_shuffle_epi8(vector, indices); }
-inline SimdVector16UChar shuffleVector(SimdVector16UChar const &vector, SimdVector16UChar const &indices) { return _mm_shuffle_epi8(vector, indices); }
-
-inline SimdVector16Char  shiftRightLogical(SimdVector16Char  const &vector, const int imm) { return _mm_srli_epi16(vector, imm) & _mm_set1_epi8(0xff >> imm); }
-inline SimdVector16SChar shiftRightLogical(SimdVector16SChar const &vector, const int imm) { return _mm_srli_epi16(vector, imm) & _mm_set1_epi8(0xff >> imm); }
-inline SimdVector16UChar shiftRightLogical(SimdVector16UChar const &vector, const int imm) { return _mm_srli_epi16(vector, imm) & _mm_set1_epi8(0xff >> imm); }
-inline SimdVector8Short  shiftRightLogical(SimdVector8Short  const &vector, const int imm) { return _mm_srli_epi16(vector, imm); }
-inline SimdVector8UShort shiftRightLogical(SimdVector8UShort const &vector, const int imm) { return _mm_srli_epi16(vector, imm); }
-inline SimdVector4Int    shiftRightLogical(SimdVector4Int    const &vector, const int imm) { return _mm_srli_epi32(vector, imm); }
-inline SimdVector4UInt   shiftRightLogical(SimdVector4UInt   const &vector, const int imm) { return _mm_srli_epi32(vector, imm); }
-inline SimdVector2Int64  shiftRightLogical(SimdVector2Int64  const &vector, const int imm) { return _mm_srli_epi64(vector, imm); }
-inline SimdVector2UInt64 shiftRightLogical(SimdVector2UInt64 const &vector, const int imm) { return _mm_srli_epi64(vector, imm); }
+inline void fill(SimdVector16Char &vector,  char x)             { vector = SEQAN_VECTOR_CAST_(SimdVector16Char, _mm_set1_epi8(x)); }
+inline void fill(SimdVector16SChar &vector, signed char x)      { vector = SEQAN_VECTOR_CAST_(SimdVector16SChar, _mm_set1_epi8(x)); }
+inline void fill(SimdVector16UChar &vector, unsigned char x)    { vector = SEQAN_VECTOR_CAST_(SimdVector16UChar, _mm_set1_epi8(x)); }
+inline void fill(SimdVector8Short &vector,  short x)            { vector = SEQAN_VECTOR_CAST_(SimdVector8Short, _mm_set1_epi16(x)); }
+inline void fill(SimdVector8UShort &vector, unsigned short x)   { vector = SEQAN_VECTOR_CAST_(SimdVector8UShort, _mm_set1_epi16(x)); }
+inline void fill(SimdVector4Int &vector,    int x)              { vector = SEQAN_VECTOR_CAST_(SimdVector4Int, _mm_set1_epi32(x)); }
+inline void fill(SimdVector4UInt &vector,   unsigned int x)     { vector = SEQAN_VECTOR_CAST_(SimdVector4UInt, _mm_set1_epi32(x)); }
+inline void fill(SimdVector2Int64 &vector,  __int64 x)          { vector = SEQAN_VECTOR_CAST_(SimdVector2Int64, _mm_set1_epi64x(x)); }
+inline void fill(SimdVector2UInt64 &vector, __uint64 x)         { vector = SEQAN_VECTOR_CAST_(SimdVector2UInt64, _mm_set1_epi64x(x)); }
+inline void fill(SimdVector4Float &vector,   float x)           { vector = SEQAN_VECTOR_CAST_(SimdVector4Float, _mm_set1_ps(x)); }
+inline void fill(SimdVector2Double &vector,  double x)          { vector = SEQAN_VECTOR_CAST_(SimdVector2Double, _mm_set1_pd(x)); }
+
+inline void clear(SimdVector16Char &vector)     { vector = SEQAN_VECTOR_CAST_(SimdVector16Char, _mm_setzero_si128()); }
+inline void clear(SimdVector16SChar &vector)    { vector = SEQAN_VECTOR_CAST_(SimdVector16SChar, _mm_setzero_si128()); }
+inline void clear(SimdVector16UChar &vector)    { vector = SEQAN_VECTOR_CAST_(SimdVector16UChar, _mm_setzero_si128()); }
+inline void clear(SimdVector8Short &vector)     { vector = SEQAN_VECTOR_CAST_(SimdVector8Short, _mm_setzero_si128()); }
+inline void clear(SimdVector8UShort &vector)    { vector = SEQAN_VECTOR_CAST_(SimdVector8UShort, _mm_setzero_si128()); }
+inline void clear(SimdVector4Int &vector)       { vector = SEQAN_VECTOR_CAST_(SimdVector4Int, _mm_setzero_si128()); }
+inline void clear(SimdVector4UInt &vector)      { vector = SEQAN_VECTOR_CAST_(SimdVector4UInt, _mm_setzero_si128()); }
+inline void clear(SimdVector2Int64 &vector)     { vector = SEQAN_VECTOR_CAST_(SimdVector2Int64, _mm_setzero_si128()); }
+inline void clear(SimdVector2UInt64 &vector)    { vector = SEQAN_VECTOR_CAST_(SimdVector2UInt64, _mm_setzero_si128()); }
+inline void clear(SimdVector4Float &vector)     { vector = SEQAN_VECTOR_CAST_(SimdVector4Float, _mm_setzero_ps()); }
+inline void clear(SimdVector2Double &vector)    { vector = SEQAN_VECTOR_CAST_(SimdVector2Double, _mm_setzero_pd()); }
+
+inline SimdVector16Char  shuffleVector(SimdVector16Char  const &vector, SimdVector16Char  const &indices) { return SEQAN_VECTOR_CAST_(SimdVector16Char, _mm_shuffle_epi8(SEQAN_VECTOR_CAST_(__m128i, vector), SEQAN_VECTOR_CAST_(__m128i, indices))); }
+inline SimdVector16SChar shuffleVector(SimdVector16SChar const &vector, SimdVector16SChar const &indices) { return SEQAN_VECTOR_CAST_(SimdVector16SChar, _mm_shuffle_epi8(SEQAN_VECTOR_CAST_(__m128i, vector), SEQAN_VECTOR_CAST_(__m128i, indices))); }
+inline SimdVector16UChar shuffleVector(SimdVector16UChar const &vector, SimdVector16UChar const &indices) { return SEQAN_VECTOR_CAST_(SimdVector16UChar, _mm_shuffle_epi8(SEQAN_VECTOR_CAST_(__m128i, vector), SEQAN_VECTOR_CAST_(__m128i, indices))); }
+
+inline SimdVector16Char  shiftRightLogical(SimdVector16Char  const &vector, const int imm) { return SEQAN_VECTOR_CAST_(SimdVector16Char, _mm_srli_epi16(SEQAN_VECTOR_CAST_(__m128i, vector), imm) & _mm_set1_epi8(0xff >> imm)); }
+inline SimdVector16SChar shiftRightLogical(SimdVector16SChar const &vector, const int imm) { return SEQAN_VECTOR_CAST_(SimdVector16SChar, _mm_srli_epi16(SEQAN_VECTOR_CAST_(__m128i, vector), imm) & _mm_set1_epi8(0xff >> imm)); }
+inline SimdVector16UChar shiftRightLogical(SimdVector16UChar const &vector, const int imm) { return SEQAN_VECTOR_CAST_(SimdVector16UChar, _mm_srli_epi16(SEQAN_VECTOR_CAST_(__m128i, vector), imm) & _mm_set1_epi8(0xff >> imm)); }
+inline SimdVector8Short  shiftRightLogical(SimdVector8Short  const &vector, const int imm) { return SEQAN_VECTOR_CAST_(SimdVector8Short, _mm_srli_epi16(SEQAN_VECTOR_CAST_(__m128i, vector), imm)); }
+inline SimdVector8UShort shiftRightLogical(SimdVector8UShort const &vector, const int imm) { return SEQAN_VECTOR_CAST_(SimdVector8UShort, _mm_srli_epi16(SEQAN_VECTOR_CAST_(__m128i, vector), imm)); }
+inline SimdVector4Int    shiftRightLogical(SimdVector4Int    const &vector, const int imm) { return SEQAN_VECTOR_CAST_(SimdVector4Int, _mm_srli_epi32(SEQAN_VECTOR_CAST_(__m128i, vector), imm)); }
+inline SimdVector4UInt   shiftRightLogical(SimdVector4UInt   const &vector, const int imm) { return SEQAN_VECTOR_CAST_(SimdVector4UInt, _mm_srli_epi32(SEQAN_VECTOR_CAST_(__m128i, vector), imm)); }
+inline SimdVector2Int64  shiftRightLogical(SimdVector2Int64  const &vector, const int imm) { return SEQAN_VECTOR_CAST_(SimdVector2Int64, _mm_srli_epi64(SEQAN_VECTOR_CAST_(__m128i, vector), imm)); }
+inline SimdVector2UInt64 shiftRightLogical(SimdVector2UInt64 const &vector, const int imm) { return SEQAN_VECTOR_CAST_(SimdVector2UInt64, _mm_srli_epi64(SEQAN_VECTOR_CAST_(__m128i, vector), imm)); }
 
 #ifdef __SSE4_1__
 template <typename TSimdVector>
@@ -283,7 +293,7 @@ SEQAN_FUNC_ENABLE_IF(
     int)
 inline testAllZeros(TSimdVector const &vector, TSimdVector const &mask)
 {
-    return _mm_testz_si128(vector, mask);
+    return _mm_testz_si128(SEQAN_VECTOR_CAST_(__m128i, vector), SEQAN_VECTOR_CAST_(__m128i, mask));
 }
 
 template <typename TSimdVector>
@@ -292,7 +302,7 @@ SEQAN_FUNC_ENABLE_IF(
     int)
 inline testAllOnes(TSimdVector const &vector)
 {
-    return _mm_test_all_ones(vector);
+    return _mm_test_all_ones(SEQAN_VECTOR_CAST_(__m128i, vector));
 }
 
 #endif
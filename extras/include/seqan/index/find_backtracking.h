@@ -1251,6 +1251,9 @@ _search(Finder<Index<TText, TTextSpec>, Backtracking<TDistance, TBacktrackingSpe
 
                 goDown(pattern.index_iterator);
             }
+            // The prefix cannot be extended any further: move on instead of aligning the same edges again.
+            else if (!_cut_exact(finder, pattern))
+                break;
         }
         else if (!_cut_exact(finder, pattern))
             break;
@@ -44,6 +44,7 @@
 #include <seqan/basic.h>
 #include <seqan/file.h>
 #include <seqan/sequence.h>
+#include <seqan/stream.h>
 #include <seqan/store.h>  // For NameStoreCache.
 
 // ===========================================================================
@@ -53,11 +54,18 @@
 #include <seqan/vcf_io/vcf_header_record.h>
 #include <seqan/vcf_io/vcf_header.h>
 #include <seqan/vcf_io/vcf_record.h>
+#include <seqan/vcf_io/vcf_record_lazy.h>
 
 #include <seqan/vcf_io/vcf_io_context.h>
 #include <seqan/vcf_io/read_vcf.h>
 #include <seqan/vcf_io/write_vcf.h>
 
+#include <seqan/vcf_io/bcf_base.h>
+#if SEQAN_HAS_ZLIB
+#include <seqan/vcf_io/read_bcf.h>
+#include <seqan/vcf_io/write_bcf.h>
+#endif  // #if SEQAN_HAS_ZLIB
+
 #include <seqan/vcf_io/vcf_stream.h>
 
 #endif  // SEQAN_EXTRAS_INCLUDE_SEQAN_VCF_IO_H_
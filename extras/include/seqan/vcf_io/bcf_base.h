@@ -0,0 +1,251 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Definitions shared by BCF2 reading and writing.
+// ==========================================================================
+
+#ifndef SEQAN_EXTRAS_INCLUDE_SEQAN_VCF_IO_BCF_BASE_H_
+#define SEQAN_EXTRAS_INCLUDE_SEQAN_VCF_IO_BCF_BASE_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Tag Bcf
+// ----------------------------------------------------------------------------
+
+/*!
+ * @tag VcfIO#Bcf
+ * @headerfile <seqan/vcf_io.h>
+ * @brief Identify the BCF2 format, the binary counterpart of VCF.
+ *
+ * @signature typedef Tag<Bcf_> Bcf;
+ *
+ * BCF2 files are BGZF compressed.  Reading and writing uses a @link BgzfStream @endlink and the same @link VcfHeader
+ * @endlink, @link VcfRecord @endlink and @link VcfIOContext @endlink as VCF I/O.
+ */
+
+/**
+.Tag.Bcf
+..cat:VCF I/O
+..signature:Bcf
+..summary:Tag for identifying the BCF2 format, the binary counterpart of VCF.
+..remarks:BCF2 files are BGZF compressed.
+Reading and writing uses a @Spec.BGZF Stream@ and the same @Class.VcfHeader@, @Class.VcfRecord@ and @Class.VcfIOContext@ as VCF I/O.
+..include:seqan/vcf_io.h
+*/
+
+struct Bcf_;
+typedef Tag<Bcf_> Bcf;
+
+// ----------------------------------------------------------------------------
+// Enum BcfType_
+// ----------------------------------------------------------------------------
+
+// Atomic types of typed BCF values.
+
+enum BcfType_
+{
+    BCF_TYPE_MISSING = 0,
+    BCF_TYPE_INT8 = 1,
+    BCF_TYPE_INT16 = 2,
+    BCF_TYPE_INT32 = 3,
+    BCF_TYPE_FLOAT = 5,
+    BCF_TYPE_CHAR = 7
+};
+
+// ----------------------------------------------------------------------------
+// Enum BcfValueType_
+// ----------------------------------------------------------------------------
+
+// Value types of INFO and FORMAT fields as declared by "Type=" in the header.
+
+enum BcfValueType_
+{
+    BCF_VALUE_UNKNOWN = 0,
+    BCF_VALUE_INTEGER = 1,
+    BCF_VALUE_FLOAT = 2,
+    BCF_VALUE_FLAG = 3,
+    BCF_VALUE_CHARACTER = 4,
+    BCF_VALUE_STRING = 5
+};
+
+// Integer values that mark missing values and the end of vectors, in their 32 bit form.  Values of the smaller
+// integer types are translated from and into these.
+static const __int32 BCF_INT32_MISSING = static_cast<__int32>(0x80000000u);
+static const __int32 BCF_INT32_VECTOR_END = static_cast<__int32>(0x80000001u);
+
+// Bit patterns of the missing float value (identical to VcfRecord::MISSING_QUAL()) and the end of float vectors.
+static const __uint32 BCF_FLOAT_MISSING = 0x7F800001u;
+static const __uint32 BCF_FLOAT_VECTOR_END = 0x7F800002u;
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Helper Function _bcfTypeSize()
+// ----------------------------------------------------------------------------
+
+inline unsigned
+_bcfTypeSize(char type)
+{
+    switch (type)
+    {
+        case BCF_TYPE_INT8:
+        case BCF_TYPE_CHAR:
+            return 1;
+        case BCF_TYPE_INT16:
+            return 2;
+        case BCF_TYPE_INT32:
+        case BCF_TYPE_FLOAT:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _vcfHeaderField()
+// ----------------------------------------------------------------------------
+
+// Get the value of a field from a structured header value, e.g. the "Type" of "<ID=DP,Number=1,Type=Integer>".
+
+inline bool
+_vcfHeaderField(CharString & value, CharString const & headerValue, char const * key)
+{
+    if (length(headerValue) < 2u || front(headerValue) != '<' || back(headerValue) != '>')
+        return false;
+
+    CharString tmp = infix(headerValue, 1, length(headerValue) - 1);
+    StringSet<CharString> fields;
+    splitString(fields, tmp, ',');
+
+    size_t keyLength = strlen(key);
+    for (unsigned i = 0; i < length(fields); ++i)
+    {
+        if (length(fields[i]) > keyLength && startsWith(fields[i], key) && fields[i][keyLength] == '=')
+        {
+            value = suffix(fields[i], keyLength + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bcfBuildDictionary()
+// ----------------------------------------------------------------------------
+
+// Build the string dictionary and the value types of INFO and FORMAT fields from the header records.  The ids of
+// FILTER, INFO and FORMAT records are numbered in the order of their first occurrence, starting with "PASS" as 0,
+// unless an explicit "IDX" field is given.
+
+inline void
+_bcfBuildDictionary(VcfIOContext & context, VcfHeader const & header)
+{
+    clear(context._bcfStrings);
+    refresh(context._bcfStringsCache);
+    clear(context._bcfInfoTypes);
+    clear(context._bcfFormatTypes);
+    appendName(context._bcfStrings, "PASS", context._bcfStringsCache);
+
+    CharString id, buffer;
+    for (unsigned i = 0; i < length(header.headerRecords); ++i)
+    {
+        VcfHeaderRecord const & record = header.headerRecords[i];
+        bool isInfo = (record.key == "INFO");
+        bool isFormat = (record.key == "FORMAT");
+        if (!isInfo && !isFormat && record.key != "FILTER")
+            continue;
+        if (!_vcfHeaderField(id, record.value, "ID"))
+            continue;
+
+        // Get the dictionary index of the id.
+        unsigned idx = 0;
+        __int32 explicitIdx = 0;
+        if (_vcfHeaderField(buffer, record.value, "IDX") &&
+            _vcfLexicalCast(explicitIdx, begin(buffer, Standard()), end(buffer, Standard())) && explicitIdx >= 0)
+        {
+            idx = explicitIdx;
+            if (idx >= length(context._bcfStrings))
+                resize(context._bcfStrings, idx + 1);
+            context._bcfStrings[idx] = id;
+            refresh(context._bcfStringsCache);
+        }
+        else if (!getIdByName(context._bcfStrings, id, idx, context._bcfStringsCache))
+        {
+            idx = length(context._bcfStrings);
+            appendName(context._bcfStrings, id, context._bcfStringsCache);
+        }
+
+        if (!isInfo && !isFormat)
+            continue;
+
+        // Get the value type.
+        char valueType = BCF_VALUE_UNKNOWN;
+        if (_vcfHeaderField(buffer, record.value, "Type"))
+        {
+            if (buffer == "Integer")
+                valueType = BCF_VALUE_INTEGER;
+            else if (buffer == "Float")
+                valueType = BCF_VALUE_FLOAT;
+            else if (buffer == "Flag")
+                valueType = BCF_VALUE_FLAG;
+            else if (buffer == "Character")
+                valueType = BCF_VALUE_CHARACTER;
+            else if (buffer == "String")
+                valueType = BCF_VALUE_STRING;
+        }
+        String<char> & types = isInfo ? context._bcfInfoTypes : context._bcfFormatTypes;
+        if (idx >= length(types))
+            resize(types, idx + 1, (char)BCF_VALUE_UNKNOWN);
+        types[idx] = valueType;
+    }
+
+    resize(context._bcfInfoTypes, length(context._bcfStrings), (char)BCF_VALUE_UNKNOWN);
+    resize(context._bcfFormatTypes, length(context._bcfStrings), (char)BCF_VALUE_UNKNOWN);
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_EXTRAS_INCLUDE_SEQAN_VCF_IO_BCF_BASE_H_
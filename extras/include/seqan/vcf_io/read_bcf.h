@@ -0,0 +1,472 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Reading of BCF2 files.
+// ==========================================================================
+
+#ifndef SEQAN_EXTRAS_INCLUDE_SEQAN_VCF_IO_READ_BCF_H_
+#define SEQAN_EXTRAS_INCLUDE_SEQAN_VCF_IO_READ_BCF_H_
+
+#include <cstdio>
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Helper Function _bcfValue()
+// ----------------------------------------------------------------------------
+
+// The record data may not be aligned, so values are read using memcpy().
+
+template <typename TValue>
+inline TValue
+_bcfValue(char const * ptr)
+{
+    TValue result;
+    memcpy(&result, ptr, sizeof(TValue));
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bcfDecodeInt()
+// ----------------------------------------------------------------------------
+
+// Decode an integer of the given type, missing values and vector ends are translated into their 32 bit form.
+
+inline __int32
+_bcfDecodeInt(char const * ptr, char type)
+{
+    switch (type)
+    {
+        case BCF_TYPE_INT8:
+        {
+            signed char value = *ptr;
+            if (value == static_cast<signed char>(0x80))
+                return BCF_INT32_MISSING;
+            if (value == static_cast<signed char>(0x81))
+                return BCF_INT32_VECTOR_END;
+            return value;
+        }
+        case BCF_TYPE_INT16:
+        {
+            __int16 value = _bcfValue<__int16>(ptr);
+            if (value == static_cast<__int16>(0x8000))
+                return BCF_INT32_MISSING;
+            if (value == static_cast<__int16>(0x8001))
+                return BCF_INT32_VECTOR_END;
+            return value;
+        }
+        case BCF_TYPE_INT32:
+            return _bcfValue<__int32>(ptr);
+        default:
+            return BCF_INT32_MISSING;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bcfReadTypedInt(), _bcfReadTypedVector()
+// ----------------------------------------------------------------------------
+
+// These functions read a typed value at it and advance it behind it.  They return false if the record is truncated.
+
+inline bool
+_bcfReadTypedInt(__int32 & value, char const * & it, char const * end)
+{
+    if (it == end)
+        return false;
+    char type = *it & 0x0f;
+    unsigned count = static_cast<unsigned char>(*it) >> 4;
+    ++it;
+
+    unsigned typeSize = _bcfTypeSize(type);
+    if (count != 1u || typeSize == 0u || type == BCF_TYPE_FLOAT || type == BCF_TYPE_CHAR ||
+        static_cast<unsigned>(end - it) < typeSize)
+        return false;
+    value = _bcfDecodeInt(it, type);
+    it += typeSize;
+    return true;
+}
+
+inline bool
+_bcfReadTypeDescriptor(unsigned & count, char & type, char const * & it, char const * end)
+{
+    if (it == end)
+        return false;
+    type = *it & 0x0f;
+    count = static_cast<unsigned char>(*it) >> 4;
+    ++it;
+
+    // Larger counts follow as a typed integer.
+    if (count == 15u)
+    {
+        __int32 largeCount = 0;
+        if (!_bcfReadTypedInt(largeCount, it, end) || largeCount < 0)
+            return false;
+        count = largeCount;
+    }
+    return true;
+}
+
+inline bool
+_bcfReadTypedVector(char const * & data, unsigned & count, char & type, char const * & it, char const * end)
+{
+    if (!_bcfReadTypeDescriptor(count, type, it, end))
+        return false;
+    size_t numBytes = static_cast<size_t>(count) * _bcfTypeSize(type);
+    if (static_cast<size_t>(end - it) < numBytes)
+        return false;
+    data = it;
+    it += numBytes;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bcfFormatValues()
+// ----------------------------------------------------------------------------
+
+// Append a vector of typed values in VCF text form, "." if it is empty or missing.
+
+inline void
+_bcfAppendChars(CharString & target, char const * first, char const * last)
+{
+    unsigned oldLength = length(target);
+    resize(target, oldLength + (last - first), Generous());
+    std::copy(first, last, begin(target, Standard()) + oldLength);
+}
+
+inline void
+_bcfAppendNumber(CharString & target, __int32 value)
+{
+    char buffer[16];
+    int len = snprintf(buffer, 16, "%d", value);
+    _bcfAppendChars(target, &buffer[0], &buffer[0] + len);
+}
+
+inline void
+_bcfFormatValues(CharString & target, char const * data, unsigned count, char type)
+{
+    unsigned oldLength = length(target);
+
+    if (type == BCF_TYPE_CHAR)
+    {
+        // Strings are padded with '\0'.
+        char const * dataEnd = static_cast<char const *>(memchr(data, '\0', count));
+        if (dataEnd == 0)
+            dataEnd = data + count;
+        _bcfAppendChars(target, data, dataEnd);
+    }
+    else if (type == BCF_TYPE_FLOAT)
+    {
+        char buffer[32];
+        for (unsigned i = 0; i < count; ++i, data += 4)
+        {
+            __uint32 bits = _bcfValue<__uint32>(data);
+            if (bits == BCF_FLOAT_VECTOR_END)
+                break;
+            if (i > 0u)
+                appendValue(target, ',');
+            if (bits == BCF_FLOAT_MISSING)
+            {
+                appendValue(target, '.');
+                continue;
+            }
+            int len = snprintf(buffer, 32, "%g", _bcfValue<float>(data));
+            _bcfAppendChars(target, &buffer[0], &buffer[0] + len);
+        }
+    }
+    else
+    {
+        unsigned typeSize = _bcfTypeSize(type);
+        for (unsigned i = 0; i < count; ++i, data += typeSize)
+        {
+            __int32 value = _bcfDecodeInt(data, type);
+            if (value == BCF_INT32_VECTOR_END)
+                break;
+            if (i > 0u)
+                appendValue(target, ',');
+            if (value == BCF_INT32_MISSING)
+                appendValue(target, '.');
+            else
+                _bcfAppendNumber(target, value);
+        }
+    }
+
+    if (length(target) == oldLength)
+        appendValue(target, '.');
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bcfFormatGenotype()
+// ----------------------------------------------------------------------------
+
+// Append a GT value, alleles are encoded as (allele + 1) << 1 | phased where phased refers to the separator before
+// the allele.
+
+inline void
+_bcfFormatGenotype(CharString & target, char const * data, unsigned count, char type)
+{
+    unsigned typeSize = _bcfTypeSize(type);
+    unsigned i = 0;
+    for (; i < count && typeSize != 0u; ++i, data += typeSize)
+    {
+        __int32 value = _bcfDecodeInt(data, type);
+        if (value == BCF_INT32_VECTOR_END)
+            break;
+        if (i > 0u)
+            appendValue(target, (value & 1) ? '|' : '/');
+        if (value == BCF_INT32_MISSING || (value >> 1) == 0)
+            appendValue(target, '.');
+        else
+            _bcfAppendNumber(target, (value >> 1) - 1);
+    }
+    if (i == 0u)
+        appendValue(target, '.');
+}
+
+// ----------------------------------------------------------------------------
+// Function read()                                                  [VcfHeader]
+// ----------------------------------------------------------------------------
+
+/**
+.Function.VCF I/O#read
+..signature:read(header, bgzfStream, context, Bcf())
+..param.bgzfStream:A @Spec.BGZF Stream@ to read a BCF2 header from. The embedded VCF header is parsed as for VCF and the string dictionary of $context$ is built from it.
+...type:Spec.BGZF Stream
+*/
+
+template <typename TStream>
+int read(VcfHeader & header,
+         TStream & stream,
+         VcfIOContext & context,
+         Bcf const & /*tag*/)
+{
+    clear(header);
+
+    // Read BCF magic string, versions 2.1 and 2.2 are supported.
+    char magic[5];
+    if (streamReadBlock(&magic[0], stream, 5) != 5)
+        return 1;  // EOF or error while reading.
+    if (memcmp(&magic[0], "BCF\2", 4) != 0 || (magic[4] != 1 && magic[4] != 2))
+        return 1;  // Magic was wrong.
+
+    // Read header text, truncate to first position of '\0'.
+    __uint32 lText = 0;
+    if (streamReadBlock(reinterpret_cast<char *>(&lText), stream, 4) != 4)
+        return 1;  // Error reading the length of the header text.
+    CharString vcfHeader;
+    resize(vcfHeader, lText);
+    if (lText == 0u || streamReadBlock(&front(vcfHeader), stream, lText) != (int)lText)
+        return 1;  // Error reading the header text.
+    typedef Iterator<CharString, Standard>::Type TIter;
+    TIter it = std::find(begin(vcfHeader, Standard()), end(vcfHeader, Standard()), '\0');
+    resize(vcfHeader, it - begin(vcfHeader, Standard()));
+    if (empty(vcfHeader))
+        return 1;  // Empty header text.
+
+    // Parse the embedded VCF header.
+    typedef Stream<CharArray<char *> > THeaderStream;
+    THeaderStream headerStream(&vcfHeader[0], &vcfHeader[0] + length(vcfHeader));
+    RecordReader<THeaderStream, SinglePass<> > headerReader(headerStream);
+    if (read(header, headerReader, context, Vcf()) != 0)
+        return 1;  // Error reading embedded VCF header.
+
+    _bcfBuildDictionary(context, header);
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function readRecord()                                            [VcfRecord]
+// ----------------------------------------------------------------------------
+
+/**
+.Function.VCF I/O#readRecord
+..signature:readRecord(record, bgzfStream, context, Bcf())
+..param.bgzfStream:A @Spec.BGZF Stream@ to read a BCF2 record from. The typed values are converted into the string members of the @Class.VcfRecord@, no text is parsed.
+...type:Spec.BGZF Stream
+*/
+
+template <typename TStream>
+int readRecord(VcfRecord & record,
+               TStream & stream,
+               VcfIOContext & context,
+               Bcf const & /*tag*/)
+{
+    clear(record);
+
+    // Read the lengths of the shared and individual data and then the whole record.
+    __uint32 lShared = 0, lIndiv = 0;
+    if (streamReadBlock(reinterpret_cast<char *>(&lShared), stream, 4) != 4)
+        return 1;  // EOF or error while reading.
+    if (streamReadBlock(reinterpret_cast<char *>(&lIndiv), stream, 4) != 4)
+        return 1;  // Error reading the length of the individual data.
+    if (lShared < 24u)
+        return 1;  // Shared data too short for the fixed fields.
+
+    CharString & buffer = context._bcfBuffer;
+    resize(buffer, lShared + lIndiv, Generous());
+    if (streamReadBlock(&front(buffer), stream, lShared + lIndiv) != (int)(lShared + lIndiv))
+        return 1;  // Error reading the record.
+
+    char const * it = begin(buffer, Standard());
+    char const * sharedEnd = it + lShared;
+    char const * indivEnd = sharedEnd + lIndiv;
+
+    // Fixed fields.  Positions are 0-based and missing qualities have the bit pattern of VcfRecord::MISSING_QUAL().
+    record.rID = _bcfValue<__int32>(it);
+    record.beginPos = _bcfValue<__int32>(it + 4);
+    record.qual = _bcfValue<float>(it + 12);
+    __uint32 nAlleleInfo = _bcfValue<__uint32>(it + 16);
+    __uint32 nFmtSample = _bcfValue<__uint32>(it + 20);
+    it += 24;
+    if (record.rID < 0 || static_cast<unsigned>(record.rID) >= length(*context.sequenceNames))
+        return 1;  // Unknown contig.
+
+    char const * data = 0;
+    unsigned count = 0;
+    char type = 0;
+
+    // ID
+    if (!_bcfReadTypedVector(data, count, type, it, sharedEnd))
+        return 1;
+    _bcfFormatValues(record.id, data, (type == BCF_TYPE_CHAR) ? count : 0, BCF_TYPE_CHAR);
+
+    // REF and ALT
+    unsigned nAllele = nAlleleInfo >> 16;
+    for (unsigned i = 0; i < nAllele; ++i)
+    {
+        if (!_bcfReadTypedVector(data, count, type, it, sharedEnd) || type != BCF_TYPE_CHAR)
+            return 1;
+        if (i == 0u)
+        {
+            _bcfAppendChars(record.ref, data, data + count);
+            continue;
+        }
+        if (i > 1u)
+            appendValue(record.alt, ',');
+        _bcfFormatValues(record.alt, data, count, BCF_TYPE_CHAR);
+    }
+    if (nAllele <= 1u)
+        record.alt = ".";
+
+    // FILTER
+    if (!_bcfReadTypedVector(data, count, type, it, sharedEnd))
+        return 1;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        __int32 idx = _bcfDecodeInt(data + i * _bcfTypeSize(type), type);
+        if (idx < 0 || static_cast<unsigned>(idx) >= length(context._bcfStrings))
+            return 1;  // Unknown filter.
+        if (i > 0u)
+            appendValue(record.filter, ';');
+        append(record.filter, context._bcfStrings[idx]);
+    }
+    if (count == 0u)
+        record.filter = ".";
+
+    // INFO
+    unsigned nInfo = nAlleleInfo & 0xffff;
+    for (unsigned i = 0; i < nInfo; ++i)
+    {
+        __int32 idx = 0;
+        if (!_bcfReadTypedInt(idx, it, sharedEnd) || !_bcfReadTypedVector(data, count, type, it, sharedEnd))
+            return 1;
+        if (idx < 0 || static_cast<unsigned>(idx) >= length(context._bcfStrings))
+            return 1;  // Unknown INFO key.
+        if (i > 0u)
+            appendValue(record.info, ';');
+        append(record.info, context._bcfStrings[idx]);
+        if (context._bcfInfoTypes[idx] == BCF_VALUE_FLAG || (type == BCF_TYPE_MISSING && count == 0u))
+            continue;
+        appendValue(record.info, '=');
+        _bcfFormatValues(record.info, data, count, type);
+    }
+    if (nInfo == 0u)
+        record.info = ".";
+
+    // FORMAT and the samples, the values of one key are stored for all samples one after the other.
+    unsigned nFmt = nFmtSample >> 24;
+    unsigned nSample = nFmtSample & 0xffffff;
+    it = sharedEnd;
+    if (nFmt > 0u)
+        resize(record.genotypeInfos, nSample);
+    for (unsigned i = 0; i < nFmt; ++i)
+    {
+        __int32 idx = 0;
+        if (!_bcfReadTypedInt(idx, it, indivEnd) || !_bcfReadTypeDescriptor(count, type, it, indivEnd))
+            return 1;
+        if (idx < 0 || static_cast<unsigned>(idx) >= length(context._bcfStrings))
+            return 1;  // Unknown FORMAT key.
+        size_t sampleBytes = static_cast<size_t>(count) * _bcfTypeSize(type);
+        if (static_cast<size_t>(indivEnd - it) < sampleBytes * nSample)
+            return 1;  // Truncated record.
+
+        if (i > 0u)
+            appendValue(record.format, ':');
+        append(record.format, context._bcfStrings[idx]);
+        bool isGenotype = (context._bcfStrings[idx] == "GT");
+
+        for (unsigned j = 0; j < nSample; ++j, it += sampleBytes)
+        {
+            if (i > 0u)
+                appendValue(record.genotypeInfos[j], ':');
+            if (isGenotype && type != BCF_TYPE_CHAR)
+                _bcfFormatGenotype(record.genotypeInfos[j], it, count, type);
+            else
+                _bcfFormatValues(record.genotypeInfos[j], it, count, type);
+        }
+    }
+
+    // Trailing missing fields are omitted in VCF.
+    for (unsigned j = 0; j < length(record.genotypeInfos); ++j)
+        while (endsWith(record.genotypeInfos[j], ":."))
+            resize(record.genotypeInfos[j], length(record.genotypeInfos[j]) - 2);
+
+    return 0;
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_EXTRAS_INCLUDE_SEQAN_VCF_IO_READ_BCF_H_
@@ -163,10 +163,13 @@ void splitString(StringSet<CharString> & result,
  * @brief Read a VcfHeader.
  *
  * @signature int read(header, reader, context, Vcf());
+ * @signature int read(header, bgzfStream, context, Bcf());
  *
  * @param[out]    header  The VcfHeader to read into.
  * @param[in,out] reader  The SinglePassRecordReader to use for reading.
  * @param[in,out] context VcfIOContext to use.
+ * @param[in,out] bgzfStream A @link BgzfStream @endlink to read a BCF2 header from.  The embedded VCF header is parsed
+ *                           as for VCF and the string dictionary of <tt>context</tt> is built from it.
  *
  * @return int A status code, 0 on success, a different value otherwise.
  */
@@ -284,10 +287,16 @@ int read(VcfHeader & header,
  * @brief Read a VcfRecord.
  *
  * @signature int readRecord(header, reader, context, Vcf());
+ * @signature int readRecord(lazyRecord, reader, context, Vcf());
+ * @signature int readRecord(record, bgzfStream, context, Bcf());
  *
  * @param[out]    header  The VcfRecord to read into.
  * @param[in,out] reader  The SinglePassRecordReader to use for reading.
  * @param[in,out] context VcfIOContext to use.
+ * @param[out]    lazyRecord A VcfLazyRecord to read into instead.  Only the line is read and the reference name and
+ *                           position are parsed.
+ * @param[in,out] bgzfStream A @link BgzfStream @endlink to read a BCF2 record from.  The typed values are converted
+ *                           into the string members of the VcfRecord, no text is parsed.
  *
  * @return int A status code, 0 on success, a different value otherwise.
  */
@@ -452,6 +461,61 @@ int readRecord(VcfRecord & record,
     return 0;
 }
 
+// ----------------------------------------------------------------------------
+// Function readRecord()                                        [VcfLazyRecord]
+// ----------------------------------------------------------------------------
+
+/**
+.Function.VCF I/O#readRecord
+..signature:readRecord(lazyRecord, reader, context, Vcf())
+..param.lazyRecord:When reading into a @Class.VcfLazyRecord@, only the line is read and the reference name and position are parsed.
+...type:Class.VcfLazyRecord
+*/
+
+template <typename TStream>
+int readRecord(VcfLazyRecord & record,
+               RecordReader<TStream, SinglePass<> > & reader,
+               VcfIOContext & context,
+               Vcf const & /*tag*/)
+{
+    clear(record);
+    int res = 0;
+
+    // Read the whole line, a missing line break at the end of the file is OK.
+    res = readLine(record._line, reader);
+    if (res != 0 && (res != EOF_BEFORE_SUCCESS || empty(record._line)))
+        return res;  // Could be EOF_BEFORE_SUCCESS.
+
+    // Locate the columns up to FORMAT, CHROM to INFO are mandatory.
+    _vcfSplitColumns(record, VcfLazyRecord::FIRST_SAMPLE_COLUMN);
+    if (length(record._columnEnds) < (unsigned)VcfLazyRecord::FORMAT_COLUMN)
+        return 1;  // Not enough fields.
+
+    // CHROM
+    char const * columnBegin = 0;
+    char const * columnEnd = 0;
+    _vcfColumn(columnBegin, columnEnd, record, VcfLazyRecord::CHROM_COLUMN);
+    CharString chromName(infix(record._line, 0, columnEnd - columnBegin));
+    if (!getIdByName(*context.sequenceNames, chromName, record.rID, context.sequenceNamesCache))
+    {
+        record.rID = length(*context.sequenceNames);
+        appendName(*context.sequenceNames, chromName, context.sequenceNamesCache);
+    }
+
+    // POS
+    _vcfColumn(columnBegin, columnEnd, record, VcfLazyRecord::POS_COLUMN);
+    if (!_vcfLexicalCast(record.beginPos, columnBegin, columnEnd))
+        return 1;  // Could not cast number.
+    record.beginPos -= 1;  // Translate from 1-based to 0-based.
+
+    // Skip empty lines, necessary for getting to EOF if there is an empty line at the ned of the file.
+    while (!atEnd(reader) && (value(reader) == '\r' || value(reader) == '\n'))
+        if ((res = skipLine(reader)) != 0)
+            return res;
+
+    return 0;
+}
+
 }  // namespace seqan
 
 #endif  // #ifndef SEQAN_EXTRAS_INCLUDE_SEQAN_VCF_READ_VCF_H_
@@ -133,10 +133,20 @@ public:
     // Cache for the sample name lookup.
     NameStoreCache<TNameStore_> sampleNamesCache;
 
+    // BCF dictionary of the FILTER, INFO and FORMAT ids in the header, "PASS" is always the first entry.
+    TNameStore_ _bcfStrings;
+    NameStoreCache<TNameStore_> _bcfStringsCache;
+    // Types of the INFO and FORMAT fields for each dictionary entry, see BcfValueType_.
+    String<char> _bcfInfoTypes;
+    String<char> _bcfFormatTypes;
+    // Buffer for one BCF record.
+    CharString _bcfBuffer;
+
     // Default constructor.
     VcfIOContext() :
             sequenceNames(), sequenceNamesCache(*sequenceNames),
-            sampleNames(), sampleNamesCache(*sampleNames)
+            sampleNames(), sampleNamesCache(*sampleNames),
+            _bcfStringsCache(_bcfStrings)
     {}
 
     // Construct directly with references to stores.
@@ -144,7 +154,8 @@ public:
             sequenceNames(&sequenceNames),
             sequenceNamesCache(sequenceNames),
             sampleNames(&sampleNames),
-            sampleNamesCache(sequenceNames)
+            sampleNamesCache(sequenceNames),
+            _bcfStringsCache(_bcfStrings)
     {}
 };
 
@@ -0,0 +1,728 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// VCF records that keep the raw line and parse INFO, FORMAT and the sample
+// columns only when they are accessed.
+// ==========================================================================
+
+#ifndef SEQAN_EXTRAS_INCLUDE_SEQAN_VCF_IO_VCF_RECORD_LAZY_H_
+#define SEQAN_EXTRAS_INCLUDE_SEQAN_VCF_IO_VCF_RECORD_LAZY_H_
+
+#include <cstdlib>
+#include <cstring>
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class VcfLazyRecord
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class VcfLazyRecord
+ * @headerfile <seqan/vcf_io.h>
+ * @brief VCF record that keeps the raw line and parses its fields on access.
+ *
+ * @signature class VcfLazyRecord;
+ *
+ * Only the reference id and the position are parsed when reading the record.  The remaining columns are located in
+ * the raw line when reading; the sample columns are only split on the first access to a sample.  Use the accessor
+ * functions (e.g. @link VcfLazyRecord#getInfoValue @endlink or @link VcfLazyRecord#getGenotypeValue @endlink) to
+ * extract the values that are actually needed, and @link VcfLazyRecord#decodeRecord @endlink to convert the record
+ * into a @link VcfRecord @endlink.
+ *
+ * @section Remarks
+ *
+ * The columns of the line have to be separated by tabs as required by the VCF specification.  As in @link VcfRecord
+ * @endlink, the position is stored 0-based.
+ *
+ * @var __int32 VcfLazyRecord::rID
+ * @brief Numeric id of the reference sequence.
+ *
+ * @var __int32 VcfLazyRecord::beginPos
+ * @brief Position of the VCF record, 0-based.
+ */
+
+/**
+.Class.VcfLazyRecord
+..cat:VCF I/O
+..summary:VCF record that keeps the raw line and parses its fields on access.
+..signature:class VcfLazyRecord
+..description:
+Only the reference id and the position are parsed when reading the record.
+The remaining columns are located in the raw line when reading; the sample columns are only split on the first access to a sample.
+Use the accessor functions (e.g. @Function.VcfLazyRecord#getInfoValue@ or @Function.VcfLazyRecord#getGenotypeValue@) to extract the values that are actually needed, and @Function.VcfLazyRecord#decodeRecord@ to convert the record into a @Class.VcfRecord@.
+..remarks:The columns of the line have to be separated by tabs as required by the VCF specification.
+As in @Class.VcfRecord@, the position is stored 0-based.
+..include:seqan/vcf_io.h
+
+.Memvar.VcfLazyRecord#rID
+..class:Class.VcfLazyRecord
+..summary:Numeric id of the reference sequence ($__int32$).
+
+.Memvar.VcfLazyRecord#beginPos
+..class:Class.VcfLazyRecord
+..summary:Position of the VCF record, 0-based ($__int32$).
+*/
+
+class VcfLazyRecord
+{
+public:
+    // Constant for invalid reference id.
+    static const __int32 INVALID_REFID = -1;
+    // Constant for invalid position.
+    static const __int32 INVALID_POS = -1;
+
+    // Column numbers of the fixed fields.
+    enum
+    {
+        CHROM_COLUMN = 0,
+        POS_COLUMN = 1,
+        ID_COLUMN = 2,
+        REF_COLUMN = 3,
+        ALT_COLUMN = 4,
+        QUAL_COLUMN = 5,
+        FILTER_COLUMN = 6,
+        INFO_COLUMN = 7,
+        FORMAT_COLUMN = 8,
+        FIRST_SAMPLE_COLUMN = 9
+    };
+
+    // Numeric id of the reference sequence.
+    __int32 rID;
+    // Position on the reference.
+    __int32 beginPos;
+
+    // The record line without the line break.
+    CharString _line;
+    // End positions of the columns in _line.  The columns up to FORMAT are located when reading the record, the
+    // sample columns on the first access to a sample.
+    String<__uint32> _columnEnds;
+    bool _samplesSplit;
+
+    VcfLazyRecord() : rID(INVALID_REFID), beginPos(INVALID_POS), _samplesSplit(false)
+    {}
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function clear()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfLazyRecord#clear
+ * @brief Clear a VcfLazyRecord.
+ *
+ * @signature void clear(record);
+ *
+ * @param[in,out] record The VcfLazyRecord to clear.
+ */
+
+/**
+.Function.VcfLazyRecord#clear
+..cat:VCF I/O
+..class:Class.VcfLazyRecord
+..summary:Clear a @Class.VcfLazyRecord@.
+..signature:void clear(record)
+..param.record:The @Class.VcfLazyRecord@ to clear.
+...type:Class.VcfLazyRecord
+..include:seqan/vcf_io.h
+*/
+
+inline void clear(VcfLazyRecord & record)
+{
+    record.rID = VcfLazyRecord::INVALID_REFID;
+    record.beginPos = VcfLazyRecord::INVALID_POS;
+    clear(record._line);
+    clear(record._columnEnds);
+    record._samplesSplit = false;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _vcfLexicalCast()
+// ----------------------------------------------------------------------------
+
+// Cast the characters in [first, last) into a number, all characters have to be consumed.
+
+inline bool
+_vcfLexicalCast(__int32 & target, char const * first, char const * last)
+{
+    char buffer[32];
+    if (first == last || last - first >= 32)
+        return false;
+    std::copy(first, last, &buffer[0]);
+    buffer[last - first] = '\0';
+
+    char * endPtr = 0;
+    long value = std::strtol(&buffer[0], &endPtr, 10);
+    target = static_cast<__int32>(value);
+    return endPtr == &buffer[0] + (last - first);
+}
+
+inline bool
+_vcfLexicalCast(float & target, char const * first, char const * last)
+{
+    char buffer[64];
+    if (first == last || last - first >= 64)
+        return false;
+    std::copy(first, last, &buffer[0]);
+    buffer[last - first] = '\0';
+
+    char * endPtr = 0;
+    target = static_cast<float>(std::strtod(&buffer[0], &endPtr));
+    return endPtr == &buffer[0] + (last - first);
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _vcfFindField()
+// ----------------------------------------------------------------------------
+
+// Locate the field with the given number in [first, last) where fields are separated by sep.  Returns false if there
+// are not enough fields.
+
+inline bool
+_vcfFindField(char const * & fieldBegin, char const * & fieldEnd,
+              char const * first, char const * last, unsigned fieldNo, char sep)
+{
+    for (; fieldNo > 0u; --fieldNo)
+    {
+        first = static_cast<char const *>(std::memchr(first, sep, last - first));
+        if (first == 0)
+            return false;
+        ++first;
+    }
+    fieldBegin = first;
+    fieldEnd = static_cast<char const *>(std::memchr(first, sep, last - first));
+    if (fieldEnd == 0)
+        fieldEnd = last;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _vcfSplitColumns()
+// ----------------------------------------------------------------------------
+
+// Locate the ends of the columns of the raw line until there are maxColumns columns or the line ends.
+
+inline void
+_vcfSplitColumns(VcfLazyRecord & record, unsigned maxColumns)
+{
+    char const * lineBegin = begin(record._line, Standard());
+    __uint32 lineLength = length(record._line);
+
+    while (length(record._columnEnds) < maxColumns)
+    {
+        __uint32 columnBegin = empty(record._columnEnds) ? 0 : back(record._columnEnds) + 1;
+        if (columnBegin > lineLength)
+            break;  // The last column ended at the end of the line.
+        char const * it = static_cast<char const *>(std::memchr(lineBegin + columnBegin, '\t',
+                                                                lineLength - columnBegin));
+        appendValue(record._columnEnds, (it != 0) ? it - lineBegin : lineLength);
+    }
+}
+
+inline void
+_vcfSplitSamples(VcfLazyRecord & record)
+{
+    if (record._samplesSplit)
+        return;
+    _vcfSplitColumns(record, MaxValue<unsigned>::VALUE);
+    record._samplesSplit = true;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _vcfColumn()
+// ----------------------------------------------------------------------------
+
+// Get the characters of a column, an empty range if the line has fewer columns.
+
+inline void
+_vcfColumn(char const * & columnBegin, char const * & columnEnd, VcfLazyRecord const & record, unsigned column)
+{
+    columnBegin = columnEnd = begin(record._line, Standard());
+    if (column >= length(record._columnEnds))
+        return;
+    columnEnd += record._columnEnds[column];
+    if (column > 0u)
+        columnBegin += record._columnEnds[column - 1] + 1;
+}
+
+template <typename TSpec>
+inline void
+_vcfGetColumn(String<char, TSpec> & target, VcfLazyRecord const & record, unsigned column)
+{
+    char const * columnBegin = 0;
+    char const * columnEnd = 0;
+    _vcfColumn(columnBegin, columnEnd, record, column);
+    resize(target, columnEnd - columnBegin, Exact());
+    std::copy(columnBegin, columnEnd, begin(target, Standard()));
+}
+
+// ----------------------------------------------------------------------------
+// Function getId(), getRef(), getAlt(), getFilter(), getInfo(), getFormat()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfLazyRecord#getId
+ * @brief Copy the ID column of the record.
+ *
+ * @signature void getId(id, record);
+ *
+ * @param[out] id     The @link CharString @endlink to copy the column into.
+ * @param[in]  record The VcfLazyRecord to query.
+ *
+ * @fn VcfLazyRecord#getRef
+ * @brief Copy the REF column of the record.
+ *
+ * @signature void getRef(ref, record);
+ *
+ * @fn VcfLazyRecord#getAlt
+ * @brief Copy the ALT column of the record.
+ *
+ * @signature void getAlt(alt, record);
+ *
+ * @fn VcfLazyRecord#getFilter
+ * @brief Copy the FILTER column of the record.
+ *
+ * @signature void getFilter(filter, record);
+ *
+ * @fn VcfLazyRecord#getInfo
+ * @brief Copy the INFO column of the record.
+ *
+ * @signature void getInfo(info, record);
+ *
+ * @fn VcfLazyRecord#getFormat
+ * @brief Copy the FORMAT column of the record, empty if the line has no FORMAT column.
+ *
+ * @signature void getFormat(format, record);
+ */
+
+/**
+.Function.VcfLazyRecord#getId
+..class:Class.VcfLazyRecord
+..cat:VCF I/O
+..signature:getId(id, record)
+..summary:Copy the ID column of the record.
+..param.id:The string to copy the column into.
+...type:Shortcut.CharString
+..param.record:The record to query.
+...type:Class.VcfLazyRecord
+..include:seqan/vcf_io.h
+
+.Function.VcfLazyRecord#getRef
+..class:Class.VcfLazyRecord
+..cat:VCF I/O
+..signature:getRef(ref, record)
+..summary:Copy the REF column of the record.
+..include:seqan/vcf_io.h
+
+.Function.VcfLazyRecord#getAlt
+..class:Class.VcfLazyRecord
+..cat:VCF I/O
+..signature:getAlt(alt, record)
+..summary:Copy the ALT column of the record.
+..include:seqan/vcf_io.h
+
+.Function.VcfLazyRecord#getFilter
+..class:Class.VcfLazyRecord
+..cat:VCF I/O
+..signature:getFilter(filter, record)
+..summary:Copy the FILTER column of the record.
+..include:seqan/vcf_io.h
+
+.Function.VcfLazyRecord#getInfo
+..class:Class.VcfLazyRecord
+..cat:VCF I/O
+..signature:getInfo(info, record)
+..summary:Copy the INFO column of the record.
+..include:seqan/vcf_io.h
+
+.Function.VcfLazyRecord#getFormat
+..class:Class.VcfLazyRecord
+..cat:VCF I/O
+..signature:getFormat(format, record)
+..summary:Copy the FORMAT column of the record, empty if the line has no FORMAT column.
+..include:seqan/vcf_io.h
+*/
+
+template <typename TSpec>
+inline void
+getId(String<char, TSpec> & id, VcfLazyRecord const & record)
+{
+    _vcfGetColumn(id, record, VcfLazyRecord::ID_COLUMN);
+}
+
+template <typename TSpec>
+inline void
+getRef(String<char, TSpec> & ref, VcfLazyRecord const & record)
+{
+    _vcfGetColumn(ref, record, VcfLazyRecord::REF_COLUMN);
+}
+
+template <typename TSpec>
+inline void
+getAlt(String<char, TSpec> & alt, VcfLazyRecord const & record)
+{
+    _vcfGetColumn(alt, record, VcfLazyRecord::ALT_COLUMN);
+}
+
+template <typename TSpec>
+inline void
+getFilter(String<char, TSpec> & filter, VcfLazyRecord const & record)
+{
+    _vcfGetColumn(filter, record, VcfLazyRecord::FILTER_COLUMN);
+}
+
+template <typename TSpec>
+inline void
+getInfo(String<char, TSpec> & info, VcfLazyRecord const & record)
+{
+    _vcfGetColumn(info, record, VcfLazyRecord::INFO_COLUMN);
+}
+
+template <typename TSpec>
+inline void
+getFormat(String<char, TSpec> & format, VcfLazyRecord const & record)
+{
+    _vcfGetColumn(format, record, VcfLazyRecord::FORMAT_COLUMN);
+}
+
+// ----------------------------------------------------------------------------
+// Function getQual()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfLazyRecord#getQual
+ * @brief Parse the quality of the record.
+ *
+ * @signature float getQual(record);
+ *
+ * @param[in] record The VcfLazyRecord to query.
+ *
+ * @return float The quality, @link VcfRecord::MISSING_QUAL @endlink if it is "." or invalid.
+ */
+
+/**
+.Function.VcfLazyRecord#getQual
+..class:Class.VcfLazyRecord
+..cat:VCF I/O
+..signature:getQual(record)
+..summary:Parse the quality of the record.
+..param.record:The record to query.
+...type:Class.VcfLazyRecord
+..returns:The quality ($float$), @Memfunc.VcfRecord#MISSING_QUAL@ if it is "." or invalid.
+..include:seqan/vcf_io.h
+*/
+
+inline float
+getQual(VcfLazyRecord const & record)
+{
+    char const * columnBegin = 0;
+    char const * columnEnd = 0;
+    _vcfColumn(columnBegin, columnEnd, record, VcfLazyRecord::QUAL_COLUMN);
+
+    float qual = 0;
+    if (!_vcfLexicalCast(qual, columnBegin, columnEnd))
+        return VcfRecord::MISSING_QUAL();
+    return qual;
+}
+
+// ----------------------------------------------------------------------------
+// Function getInfoValue()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfLazyRecord#getInfoValue
+ * @brief Look up the value of an INFO key.
+ *
+ * @signature bool getInfoValue(value, record, key);
+ *
+ * @param[out] value  The @link CharString @endlink to copy the value into, empty for flags.
+ * @param[in]  record The VcfLazyRecord to query.
+ * @param[in]  key    The INFO key to search for, <tt>char const *</tt>.
+ *
+ * @return bool <tt>true</tt> if the key is present in the INFO column, <tt>false</tt> otherwise.
+ */
+
+/**
+.Function.VcfLazyRecord#getInfoValue
+..class:Class.VcfLazyRecord
+..cat:VCF I/O
+..signature:getInfoValue(value, record, key)
+..summary:Look up the value of an INFO key.
+..param.value:The string to copy the value into, empty for flags.
+...type:Shortcut.CharString
+..param.record:The record to query.
+...type:Class.VcfLazyRecord
+..param.key:The INFO key to search for.
+...type:nolink:$char const *$
+..returns:$true$ if the key is present in the INFO column, $false$ otherwise.
+..include:seqan/vcf_io.h
+*/
+
+template <typename TSpec>
+inline bool
+getInfoValue(String<char, TSpec> & value, VcfLazyRecord const & record, char const * key)
+{
+    char const * it = 0;
+    char const * columnEnd = 0;
+    _vcfColumn(it, columnEnd, record, VcfLazyRecord::INFO_COLUMN);
+    size_t keyLength = std::strlen(key);
+
+    while (it < columnEnd)
+    {
+        char const * entryEnd = static_cast<char const *>(std::memchr(it, ';', columnEnd - it));
+        if (entryEnd == 0)
+            entryEnd = columnEnd;
+
+        if (static_cast<size_t>(entryEnd - it) >= keyLength && std::memcmp(it, key, keyLength) == 0 &&
+            (it + keyLength == entryEnd || it[keyLength] == '='))
+        {
+            it += (it + keyLength == entryEnd) ? keyLength : keyLength + 1;
+            resize(value, entryEnd - it, Exact());
+            std::copy(it, entryEnd, begin(value, Standard()));
+            return true;
+        }
+        it = entryEnd + 1;
+    }
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+// Function numGenotypeInfos()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfLazyRecord#numGenotypeInfos
+ * @brief Return the number of sample columns of the record.
+ *
+ * @signature unsigned numGenotypeInfos(record);
+ *
+ * @param[in,out] record The VcfLazyRecord to query.  The sample columns are located on the first call.
+ *
+ * @return unsigned The number of sample columns.
+ */
+
+/**
+.Function.VcfLazyRecord#numGenotypeInfos
+..class:Class.VcfLazyRecord
+..cat:VCF I/O
+..signature:numGenotypeInfos(record)
+..summary:Return the number of sample columns of the record.
+..param.record:The record to query. The sample columns are located on the first call.
+...type:Class.VcfLazyRecord
+..returns:The number of sample columns ($unsigned$).
+..include:seqan/vcf_io.h
+*/
+
+inline unsigned
+numGenotypeInfos(VcfLazyRecord & record)
+{
+    _vcfSplitSamples(record);
+    if (length(record._columnEnds) <= (unsigned)VcfLazyRecord::FIRST_SAMPLE_COLUMN)
+        return 0;
+    return length(record._columnEnds) - VcfLazyRecord::FIRST_SAMPLE_COLUMN;
+}
+
+// ----------------------------------------------------------------------------
+// Function getGenotypeInfo()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfLazyRecord#getGenotypeInfo
+ * @brief Copy the column of one sample.
+ *
+ * @signature void getGenotypeInfo(info, record, sampleNo);
+ *
+ * @param[out]    info     The @link CharString @endlink to copy the column into.
+ * @param[in,out] record   The VcfLazyRecord to query.  The sample columns are located on the first call.
+ * @param[in]     sampleNo The number of the sample, must be less than @link VcfLazyRecord#numGenotypeInfos
+ *                         @endlink.
+ */
+
+/**
+.Function.VcfLazyRecord#getGenotypeInfo
+..class:Class.VcfLazyRecord
+..cat:VCF I/O
+..signature:getGenotypeInfo(info, record, sampleNo)
+..summary:Copy the column of one sample.
+..param.info:The string to copy the column into.
+...type:Shortcut.CharString
+..param.record:The record to query. The sample columns are located on the first call.
+...type:Class.VcfLazyRecord
+..param.sampleNo:The number of the sample, must be less than @Function.VcfLazyRecord#numGenotypeInfos@.
+..include:seqan/vcf_io.h
+*/
+
+template <typename TSpec>
+inline void
+getGenotypeInfo(String<char, TSpec> & info, VcfLazyRecord & record, unsigned sampleNo)
+{
+    SEQAN_ASSERT_LT(sampleNo, numGenotypeInfos(record));
+    _vcfGetColumn(info, record, VcfLazyRecord::FIRST_SAMPLE_COLUMN + sampleNo);
+}
+
+// ----------------------------------------------------------------------------
+// Function getGenotypeValue()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfLazyRecord#getGenotypeValue
+ * @brief Look up the value of a FORMAT key for one sample.
+ *
+ * @signature bool getGenotypeValue(value, record, sampleNo, key);
+ *
+ * @param[out]    value    The @link CharString @endlink to copy the value into.
+ * @param[in,out] record   The VcfLazyRecord to query.  The sample columns are located on the first call.
+ * @param[in]     sampleNo The number of the sample, must be less than @link VcfLazyRecord#numGenotypeInfos
+ *                         @endlink.
+ * @param[in]     key      The FORMAT key to search for, <tt>char const *</tt>.
+ *
+ * @return bool <tt>true</tt> if the key is in the FORMAT column and the sample has a value for it, <tt>false</tt>
+ *              otherwise.
+ */
+
+/**
+.Function.VcfLazyRecord#getGenotypeValue
+..class:Class.VcfLazyRecord
+..cat:VCF I/O
+..signature:getGenotypeValue(value, record, sampleNo, key)
+..summary:Look up the value of a FORMAT key for one sample.
+..param.value:The string to copy the value into.
+...type:Shortcut.CharString
+..param.record:The record to query. The sample columns are located on the first call.
+...type:Class.VcfLazyRecord
+..param.sampleNo:The number of the sample, must be less than @Function.VcfLazyRecord#numGenotypeInfos@.
+..param.key:The FORMAT key to search for.
+...type:nolink:$char const *$
+..returns:$true$ if the key is in the FORMAT column and the sample has a value for it, $false$ otherwise.
+..include:seqan/vcf_io.h
+*/
+
+template <typename TSpec>
+inline bool
+getGenotypeValue(String<char, TSpec> & value, VcfLazyRecord & record, unsigned sampleNo, char const * key)
+{
+    SEQAN_ASSERT_LT(sampleNo, numGenotypeInfos(record));
+
+    // Get the number of the key in the FORMAT column.
+    char const * it = 0;
+    char const * columnEnd = 0;
+    _vcfColumn(it, columnEnd, record, VcfLazyRecord::FORMAT_COLUMN);
+    size_t keyLength = std::strlen(key);
+    unsigned fieldNo = 0;
+    for (;; ++fieldNo)
+    {
+        char const * fieldEnd = static_cast<char const *>(std::memchr(it, ':', columnEnd - it));
+        if (fieldEnd == 0)
+            fieldEnd = columnEnd;
+        if (static_cast<size_t>(fieldEnd - it) == keyLength && std::memcmp(it, key, keyLength) == 0)
+            break;
+        if (fieldEnd == columnEnd)
+            return false;  // Key not in FORMAT.
+        it = fieldEnd + 1;
+    }
+
+    // Get the field with this number from the sample column.
+    char const * fieldBegin = 0;
+    char const * fieldEnd = 0;
+    _vcfColumn(it, columnEnd, record, VcfLazyRecord::FIRST_SAMPLE_COLUMN + sampleNo);
+    if (!_vcfFindField(fieldBegin, fieldEnd, it, columnEnd, fieldNo, ':'))
+        return false;
+    resize(value, fieldEnd - fieldBegin, Exact());
+    std::copy(fieldBegin, fieldEnd, begin(value, Standard()));
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function decodeRecord()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfLazyRecord#decodeRecord
+ * @brief Convert a VcfLazyRecord into a VcfRecord.
+ *
+ * @signature void decodeRecord(record, lazyRecord);
+ *
+ * @param[out]    record     The @link VcfRecord @endlink to write to.
+ * @param[in,out] lazyRecord The VcfLazyRecord to convert.
+ */
+
+/**
+.Function.VcfLazyRecord#decodeRecord
+..class:Class.VcfLazyRecord
+..cat:VCF I/O
+..signature:decodeRecord(record, lazyRecord)
+..summary:Convert a @Class.VcfLazyRecord@ into a @Class.VcfRecord@.
+..param.record:The record to write to.
+...type:Class.VcfRecord
+..param.lazyRecord:The record to convert.
+...type:Class.VcfLazyRecord
+..include:seqan/vcf_io.h
+*/
+
+inline void
+decodeRecord(VcfRecord & record, VcfLazyRecord & lazyRecord)
+{
+    record.rID = lazyRecord.rID;
+    record.beginPos = lazyRecord.beginPos;
+    getId(record.id, lazyRecord);
+    getRef(record.ref, lazyRecord);
+    getAlt(record.alt, lazyRecord);
+    record.qual = getQual(lazyRecord);
+    getFilter(record.filter, lazyRecord);
+    getInfo(record.info, lazyRecord);
+    getFormat(record.format, lazyRecord);
+
+    unsigned numSamples = numGenotypeInfos(lazyRecord);
+    clear(record.genotypeInfos);
+    resize(record.genotypeInfos, numSamples);
+    for (unsigned i = 0; i < numSamples; ++i)
+        getGenotypeInfo(record.genotypeInfos[i], lazyRecord, i);
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_EXTRAS_INCLUDE_SEQAN_VCF_IO_VCF_RECORD_LAZY_H_
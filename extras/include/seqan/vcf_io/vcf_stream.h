@@ -71,10 +71,11 @@ namespace seqan {
  * @brief Constructor.
  *
  * @signature VcfStream::VcfStream();
- * @signature VcfStream::VcfStream(fileName[, mode]);
+ * @signature VcfStream::VcfStream(fileName[, mode[, format]]);
  *
  * @param[in] fileName Path to the fiel to open.  Type: <tt>char const *</tt>.
  * @param[in] mode     The mode to open the file in.  Type: @link VcfStream::Mode @endlink.  Default: <tt>READ</tt>.
+ * @param[in] format   The file format.  Type: @link VcfStream::Format @endlink.  Default: <tt>AUTO</tt>.
  */
 
 /*!
@@ -94,6 +95,24 @@ namespace seqan {
  * @brief Open file for writing.
  */
 
+/*!
+ * @enum VcfStream::Format
+ * @headerfile <seqan/vcf_io.h>
+ * @brief Select the format to use for reading/writing.
+ *
+ * @signature enum Format;
+ *
+ * @var VcfStream::Format VcfStream::AUTO;
+ * @brief Auto-detect the format from file content on reading and from the file name on writing.  If auto-detection
+ *        fails, VCF is used.  Bgzip compressed VCF files are decompressed on reading with every format but BCF.
+ *
+ * @var VcfStream::Format VcfStream::VCF;
+ * @brief Force reading/writing of VCF.
+ *
+ * @var VcfStream::Format VcfStream::BCF;
+ * @brief Force reading/writing of BCF2, requires zlib.
+ */
+
 /**
 .Class.VcfStream
 ..cat:VCF I/O
@@ -107,13 +126,17 @@ namespace seqan {
 ..class:Class.VcfStream
 ..summary:Constructor.
 ..signature:VcfStream::VcfStream()
-..signature:VcfStream::VcfStream(fileName, mode=READ)
+..signature:VcfStream::VcfStream(fileName, mode=READ, format=AUTO)
 ..param.fileName:The path to the file to open.
 ...type:nolink:$char const *$
 ..param.mode:The open mode.
 ...type:Enum.VcfStream\colon\colonMode
 ...default:$VcfStream\colon\colonMode::READ$
+..param.format:The file format.
+...type:Enum.VcfStream\colon\colonFormat
+...default:$VcfStream\colon\colonFormat::AUTO$
 ..see:Enum.VcfStream\colon\colonMode
+..see:Enum.VcfStream\colon\colonFormat
 
 .Enum.VcfStream\colon\colonMode
 ..cat:VCF I/O
@@ -122,12 +145,24 @@ namespace seqan {
 ..value.READ:Open in read mode.
 ..value.WRITE:Open in write mode.
 ..include:seqan/vcf_io.h
+
+.Enum.VcfStream\colon\colonFormat
+..cat:VCF I/O
+..summary:Format of the file opened by a @Class.VcfStream@.
+..value.AUTO:Auto-detect the format from file content on reading and from the file name on writing, default is VCF.
+Bgzip compressed VCF files are decompressed on reading with every format but BCF.
+..value.VCF:Read/write VCF.
+..value.BCF:Read/write BCF2, requires zlib.
+..include:seqan/vcf_io.h
 */
 
 class VcfStream
 {
 public:
     typedef RecordReader<std::istream, SinglePass<> > TReader_;
+#if SEQAN_HAS_ZLIB
+    typedef RecordReader<Stream<Bgzf>, SinglePass<> > TBgzfReader_;
+#endif  // #if SEQAN_HAS_ZLIB
 
     enum Mode
     {
@@ -136,31 +171,46 @@ public:
         WRITE
     };
 
+    // Enum for selecting format.  AUTO is only used as the default, after opening, only VCF and BCF are used.
+    enum Format
+    {
+        AUTO,
+        VCF,
+        BCF
+    };
+
     std::SEQAN_AUTO_PTR_NAME<std::fstream> _stream;
     std::ostream * _outStream;
     std::istream * _inStream;
     CharString _filename;
     std::SEQAN_AUTO_PTR_NAME<TReader_> _reader;
     Mode _mode;
+    Format _format;
     int _error;
     bool _isGood;
     bool _headerWritten;
 
+#if SEQAN_HAS_ZLIB
+    // BCF files and bgzip compressed VCF files are BGZF compressed, the latter are read through _bgzfReader.
+    Stream<Bgzf> _bgzfStream;
+    std::SEQAN_AUTO_PTR_NAME<TBgzfReader_> _bgzfReader;
+#endif  // #if SEQAN_HAS_ZLIB
+
     VcfHeader header;
     VcfIOContext _context;
 
-    VcfStream() : _outStream(), _inStream(), _mode(INVALID), _error(0), _isGood(true), _headerWritten(false),
-                  _context(header.sequenceNames, header.sampleNames)
+    VcfStream() : _outStream(), _inStream(), _mode(INVALID), _format(VCF), _error(0), _isGood(true),
+                  _headerWritten(false), _context(header.sequenceNames, header.sampleNames)
     {}
 
-    VcfStream(char const * filename, Mode mode = READ) :
-            _outStream(), _inStream(), _filename(filename), _mode(mode), _error(0), _isGood(true),
+    VcfStream(char const * filename, Mode mode = READ, Format format = AUTO) :
+            _outStream(), _inStream(), _filename(filename), _mode(mode), _format(VCF), _error(0), _isGood(true),
             _headerWritten(false), _context(header.sequenceNames, header.sampleNames)
     {
-        _open(filename, mode);
+        _open(filename, mode, format);
     }
 
-    bool _open(char const * filename, Mode mode)
+    bool _open(char const * filename, Mode mode, Format format = AUTO)
     {
         // Reset.
         _filename = filename;
@@ -169,6 +219,28 @@ public:
         _isGood = true;
         _headerWritten = false;
 
+        // BCF and bgzip compressed VCF files start with the gzip magic number, they are told apart after
+        // decompression.
+        bool isBgzf = false;
+        if (mode == READ && _filename != "-")
+        {
+            std::fstream inStream(filename, std::ios::binary | std::ios::in);
+            char buffer[3] = { 0, 0, 0 };
+            inStream.read(&buffer[0], 3);
+            isBgzf = (buffer[0] == '\x1F' && buffer[1] == '\x8B' && buffer[2] == '\x08');
+        }
+        else if (mode == WRITE && format == AUTO)
+        {
+            format = endsWith(_filename, ".bcf") ? BCF : VCF;
+        }
+
+        if (isBgzf || format == BCF)
+            return _openBgzf(format);
+        _format = VCF;
+#if SEQAN_HAS_ZLIB
+        _bgzfReader.reset();
+#endif  // #if SEQAN_HAS_ZLIB
+
         if (mode == READ)
         {
             if (_filename == "-")
@@ -220,6 +292,54 @@ public:
         }
         return true;
     }
+
+    bool _openBgzf(Format format)
+    {
+        _stream.reset();
+        _reader.reset();
+        _inStream = 0;
+        _outStream = 0;
+        _format = (format == AUTO) ? BCF : format;
+
+#if SEQAN_HAS_ZLIB
+        _bgzfReader.reset();
+        if (_filename != "-" && open(_bgzfStream, toCString(_filename), (_mode == READ) ? "r" : "w"))
+        {
+            if (_mode == READ)
+            {
+                // BCF files start with the magic string "BCF", everything else is read as VCF.
+                if (format == AUTO)
+                {
+                    char buffer[3] = { 0, 0, 0 };
+                    streamReadBlock(&buffer[0], _bgzfStream, 3);
+                    _format = (memcmp(&buffer[0], "BCF", 3) == 0) ? BCF : VCF;
+                    streamSeek(_bgzfStream, 0, SEEK_SET);
+                }
+
+                int res = 0;
+                if (_format == BCF)
+                {
+                    res = read(header, _bgzfStream, _context, Bcf());
+                }
+                else
+                {
+                    _bgzfReader.reset(new TBgzfReader_(_bgzfStream));
+                    res = read(header, *_bgzfReader, _context, Vcf());
+                }
+                if (res != 0)
+                {
+                    _error = res;
+                    _isGood = false;
+                }
+            }
+            return true;
+        }
+#endif  // #if SEQAN_HAS_ZLIB
+
+        // BGZF requires zlib and cannot be used with stdin/stdout.
+        _isGood = false;
+        return false;
+    }
 };
 
 // ============================================================================
@@ -241,8 +361,9 @@ public:
  * @param[in,out] vcfStream The VcfStream to open.
  * @param[in]     fileName  Path to the file to open.  Type: <tt>char const *</tt>.
  * @param[in]     mode      Mode to open the file in.  Type @link VcfStream::Mode @endlink.  Default: <tt>READ</tt>.
+ * @param[in]     format    The file format.  Type @link VcfStream::Format @endlink.  Default: <tt>AUTO</tt>.
  *
- * @signature bool open(vcfStream, fileName[, mode]);
+ * @signature bool open(vcfStream, fileName[, mode[, format]]);
  *
  * @return bool <tt>true</tt> if the file could be opened and <tt>false</tt> otherwise.
  */
@@ -252,7 +373,7 @@ public:
 ..class:Class.VcfStream
 ..cat:VCF I/O
 ..summary:Open a @Class.VcfStream@.
-..signature:bool open(vcfStream, fileName, mode)
+..signature:bool open(vcfStream, fileName, mode, format)
 ..param.vcfStream:The @Class.VcfStream@ to open.
 ...type:Class.VcfStream
 ..param.fileName:The path to the file to open.
@@ -260,15 +381,19 @@ public:
 ..param.mode:The open mode.
 ...type:Enum.VcfStream\colon\colonMode
 ...default:$VcfStream\colon\colonMode::READ$
+..param.format:The file format.
+...type:Enum.VcfStream\colon\colonFormat
+...default:$VcfStream\colon\colonFormat::AUTO$
 ..returns:$true$ on success, $false$ on failure.
 ..see:Function.VcfStream#isGood
 ..see:Enum.VcfStream\colon\colonMode
 ..include:seqan/vcf_io.h
 */
 
-inline bool open(VcfStream & stream, char const * filename, VcfStream::Mode mode = VcfStream::READ)
+inline bool open(VcfStream & stream, char const * filename, VcfStream::Mode mode = VcfStream::READ,
+                 VcfStream::Format format = VcfStream::AUTO)
 {
-    return stream._open(filename, mode);
+    return stream._open(filename, mode, format);
 }
 
 // ----------------------------------------------------------------------------
@@ -280,9 +405,11 @@ inline bool open(VcfStream & stream, char const * filename, VcfStream::Mode mode
  * @brief Read a record from a VcfStream.
  *
  * @signature int readRecord(record, stream);
+ * @signature int readRecord(lazyRecord, stream);
  *
- * @param[in,out] record The @link VcfRecord @endlink to read into.
- * @param[in,out] stream The VcfStream to read from.
+ * @param[in,out] record     The @link VcfRecord @endlink to read into.
+ * @param[in,out] lazyRecord The @link VcfLazyRecord @endlink to read into.  Only supported for VCF files.
+ * @param[in,out] stream     The VcfStream to read from.
  *
  * @return int Status code, 0 on success, non-0 value on error.
  */
@@ -295,6 +422,8 @@ inline bool open(VcfStream & stream, char const * filename, VcfStream::Mode mode
 ..signature:int readRecord(record, vcfStream)
 ..param.record:The @Class.VcfRecord@ to read into.
 ...type:Class.VcfRecord
+...type:Class.VcfLazyRecord
+...remarks:@Class.VcfLazyRecord@ can only be read from VCF files.
 ..param.vcfStream:The @Class.VcfStream@ to read from.
 ...type:Class.VcfStream
 ..returns:$0$ on success, non-$0$ on failure.
@@ -304,7 +433,30 @@ inline bool open(VcfStream & stream, char const * filename, VcfStream::Mode mode
 inline int readRecord(VcfRecord & record,
                       VcfStream & stream)
 {
-    int res = readRecord(record, *stream._reader, stream._context, Vcf());
+    int res = 1;
+    if (stream._reader.get())
+        res = readRecord(record, *stream._reader, stream._context, Vcf());
+#if SEQAN_HAS_ZLIB
+    else if (stream._bgzfReader.get())
+        res = readRecord(record, *stream._bgzfReader, stream._context, Vcf());
+    else if (stream._format == VcfStream::BCF)
+        res = readRecord(record, stream._bgzfStream, stream._context, Bcf());
+#endif  // #if SEQAN_HAS_ZLIB
+    if (res != 0)
+        stream._isGood = false;
+    return res;
+}
+
+inline int readRecord(VcfLazyRecord & record,
+                      VcfStream & stream)
+{
+    int res = 1;
+    if (stream._reader.get())
+        res = readRecord(record, *stream._reader, stream._context, Vcf());
+#if SEQAN_HAS_ZLIB
+    else if (stream._bgzfReader.get())
+        res = readRecord(record, *stream._bgzfReader, stream._context, Vcf());
+#endif  // #if SEQAN_HAS_ZLIB
     if (res != 0)
         stream._isGood = false;
     return res;
@@ -319,9 +471,11 @@ inline int readRecord(VcfRecord & record,
  * @brief Write a record to a VcfStream.
  *
  * @signature int writeRecord(stream, record);
+ * @signature int writeRecord(stream, lazyRecord);
  *
- * @param[in,out] stream The VcfStream to write to.
- * @param[in]     record The @link VcfRecord @endlink to write.
+ * @param[in,out] stream     The VcfStream to write to.
+ * @param[in]     record     The @link VcfRecord @endlink to write.
+ * @param[in]     lazyRecord The @link VcfLazyRecord @endlink to write.  Only supported for VCF files.
  *
  * @return int Status code, 0 on success, non-0 value on error.
  */
@@ -336,22 +490,54 @@ inline int readRecord(VcfRecord & record,
 ...type:Class.VcfStream
 ..param.record:The @Class.VcfRecord@ to write.
 ...type:Class.VcfRecord
+...type:Class.VcfLazyRecord
+...remarks:@Class.VcfLazyRecord@ can only be written to VCF files.
 ..returns:$0$ on success, non-$0$ on failure.
 ..include:seqan/vcf_io.h
 */
 
+inline void _writeHeader(VcfStream & stream)
+{
+    if (stream._headerWritten)
+        return;
+
+    int res = 1;
+    if (stream._format == VcfStream::VCF)
+        res = write(*stream._outStream, stream.header, stream._context, Vcf());
+#if SEQAN_HAS_ZLIB
+    else
+        res = write(stream._bgzfStream, stream.header, stream._context, Bcf());
+#endif  // #if SEQAN_HAS_ZLIB
+    if (res != 0)
+        stream._isGood = false;
+    stream._headerWritten = true;
+}
+
 inline int writeRecord(VcfStream & stream,
                        VcfRecord const & record)
 {
-    if (!stream._headerWritten)
-    {
-        int res = write(*stream._outStream, stream.header, stream._context, Vcf());
-        if (res != 0)
-            stream._isGood = false;
-        stream._headerWritten = true;
-    }
+    _writeHeader(stream);
+
+    int res = 1;
+    if (stream._format == VcfStream::VCF)
+        res = writeRecord(*stream._outStream, record, stream._context, Vcf());
+#if SEQAN_HAS_ZLIB
+    else
+        res = writeRecord(stream._bgzfStream, record, stream._context, Bcf());
+#endif  // #if SEQAN_HAS_ZLIB
+    if (res != 0)
+        stream._isGood = false;
+    return res;
+}
+
+inline int writeRecord(VcfStream & stream,
+                       VcfLazyRecord const & record)
+{
+    _writeHeader(stream);
 
-    int res = writeRecord(*stream._outStream, record, stream._context, Vcf());
+    int res = 1;
+    if (stream._format == VcfStream::VCF)
+        res = writeRecord(*stream._outStream, record, stream._context, Vcf());
     if (res != 0)
         stream._isGood = false;
     return res;
@@ -386,6 +572,10 @@ inline int writeRecord(VcfStream & stream,
 
 inline int flush(VcfStream & stream)
 {
+#if SEQAN_HAS_ZLIB
+    if (stream._format == VcfStream::BCF)
+        return streamFlush(stream._bgzfStream);
+#endif  // #if SEQAN_HAS_ZLIB
     if (stream._stream.get())
         stream._stream->flush();
     return 0;
@@ -420,6 +610,16 @@ inline int flush(VcfStream & stream)
 
 inline int close(VcfStream & stream)
 {
+#if SEQAN_HAS_ZLIB
+    if (stream._format == VcfStream::BCF || stream._bgzfReader.get())
+    {
+        // Write out the header even if there are no records.
+        if (stream._mode == VcfStream::WRITE)
+            _writeHeader(stream);
+        close(stream._bgzfStream);
+        return 0;
+    }
+#endif  // #if SEQAN_HAS_ZLIB
     // Close only when not stdout/stdin.
     if (stream._stream.get())
         stream._stream->close();
@@ -487,14 +687,102 @@ inline bool isGood(VcfStream const & stream)
 
 inline bool atEnd(VcfStream const & stream)
 {
+#if SEQAN_HAS_ZLIB
+    if (stream._bgzfReader.get())
+        return atEnd(*stream._bgzfReader);
+    if (stream._format == VcfStream::BCF)
+        return streamEof(stream._bgzfStream);
+#endif  // #if SEQAN_HAS_ZLIB
     return atEnd(*stream._reader);
 }
 
 inline bool atEnd(VcfStream & stream)
 {
+#if SEQAN_HAS_ZLIB
+    if (stream._bgzfReader.get())
+        return atEnd(*stream._bgzfReader);
+    if (stream._format == VcfStream::BCF)
+        return streamEof(stream._bgzfStream);
+#endif  // #if SEQAN_HAS_ZLIB
     return atEnd(*stream._reader);
 }
 
+// ----------------------------------------------------------------------------
+// Function jumpToRegion()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfStream#jumpToRegion
+ * @brief Seek in a bgzip compressed VCF file to the first record overlapping a region.
+ *
+ * @signature bool jumpToRegion(stream, hasRecords, refName, pos, posEnd, index);
+ *
+ * @param[in,out] stream     The VcfStream to seek in, opened for reading a bgzip compressed VCF file.
+ * @param[out]    hasRecords A <tt>bool</tt> that is set to <tt>true</tt> if there are records overlapping the region.
+ * @param[in]     refName    The name of the chromosome.
+ * @param[in]     pos        The 0-based begin of the region.
+ * @param[in]     posEnd     The 0-based end of the region (exclusive).
+ * @param[in]     index      The @link TabixIndex @endlink of the file.
+ *
+ * @return bool <tt>true</tt> if seeking was successful, <tt>false</tt> if not.
+ *
+ * @section Remarks
+ *
+ * The records following the first overlapping record are not necessarily overlapping the region, the caller has to
+ * filter them and can stop at the first record beginning behind <tt>posEnd</tt>.  Only available if zlib is available.
+ */
+
+/**
+.Function.VcfStream#jumpToRegion
+..class:Class.VcfStream
+..cat:VCF I/O
+..summary:Seek in a bgzip compressed VCF file to the first record overlapping a region.
+..signature:bool jumpToRegion(vcfStream, hasRecords, refName, pos, posEnd, index)
+..param.vcfStream:The @Class.VcfStream@ to seek in, opened for reading a bgzip compressed VCF file.
+...type:Class.VcfStream
+..param.hasRecords:Set to $true$ iff there are records overlapping the region.
+...type:nolink:$bool$
+..param.refName:The name of the chromosome.
+..param.pos:Zero-based begin position of the region.
+...type:nolink:$__int32$
+..param.posEnd:Zero-based (exclusive, C-style) end position of the region.
+...type:nolink:$__int32$
+..param.index:The index of the file.
+...type:Class.TabixIndex
+..returns:$true$ if seeking was successful, $false$ if not.
+..remarks:The records following the first overlapping record are not necessarily overlapping the region, the caller has to filter them and can stop at the first record beginning behind $posEnd$.
+Only available if zlib is available.
+..include:seqan/vcf_io.h
+*/
+
+#if SEQAN_HAS_ZLIB
+template <typename TName>
+inline bool jumpToRegion(VcfStream & stream,
+                         bool & hasRecords,
+                         TName const & refName,
+                         __int32 pos,
+                         __int32 posEnd,
+                         TabixIndex const & index)
+{
+    hasRecords = false;
+    if (!stream._bgzfReader.get())
+        return false;  // Only bgzip compressed VCF files can be indexed.
+
+    __int32 refId = 0;
+    if (!getIdByName(index, refName, refId))
+        return true;  // No records on this chromosome.
+    if (!jumpToRegion(stream._bgzfStream, hasRecords, refId, pos, posEnd, index))
+    {
+        stream._isGood = false;
+        return false;
+    }
+
+    // The record reader has buffered data from the old position.
+    stream._bgzfReader.reset(new VcfStream::TBgzfReader_(stream._bgzfStream));
+    return true;
+}
+#endif  // #if SEQAN_HAS_ZLIB
+
 }  // namespace seqan
 
 #endif  // #ifndef SEQAN_EXTRAS_INCLUDE_SEQAN_VCF_IO_VCF_STREAM_H_
@@ -0,0 +1,574 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Writing of BCF2 files.
+// ==========================================================================
+
+#ifndef SEQAN_EXTRAS_INCLUDE_SEQAN_VCF_IO_WRITE_BCF_H_
+#define SEQAN_EXTRAS_INCLUDE_SEQAN_VCF_IO_WRITE_BCF_H_
+
+#include <sstream>
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Helper Function _bcfAppendValue()
+// ----------------------------------------------------------------------------
+
+template <typename TValue>
+inline void
+_bcfAppendValue(CharString & buffer, TValue value)
+{
+    unsigned oldLength = length(buffer);
+    resize(buffer, oldLength + sizeof(TValue), Generous());
+    memcpy(&buffer[oldLength], &value, sizeof(TValue));
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bcfIntType(), _bcfAppendInt()
+// ----------------------------------------------------------------------------
+
+// Smallest integer type for the given value range, the lowest values of each type are reserved.
+
+inline char
+_bcfIntType(__int32 minValue, __int32 maxValue)
+{
+    if (minValue >= -120 && maxValue <= 127)
+        return BCF_TYPE_INT8;
+    if (minValue >= -32760 && maxValue <= 32767)
+        return BCF_TYPE_INT16;
+    return BCF_TYPE_INT32;
+}
+
+// Append an integer with the given type, missing values and vector ends are translated from their 32 bit form.
+
+inline void
+_bcfAppendInt(CharString & buffer, __int32 value, char type)
+{
+    switch (type)
+    {
+        case BCF_TYPE_INT8:
+            if (value == BCF_INT32_MISSING)
+                appendValue(buffer, '\x80');
+            else if (value == BCF_INT32_VECTOR_END)
+                appendValue(buffer, '\x81');
+            else
+                appendValue(buffer, static_cast<char>(value));
+            break;
+        case BCF_TYPE_INT16:
+            if (value == BCF_INT32_MISSING)
+                _bcfAppendValue(buffer, static_cast<__int16>(0x8000));
+            else if (value == BCF_INT32_VECTOR_END)
+                _bcfAppendValue(buffer, static_cast<__int16>(0x8001));
+            else
+                _bcfAppendValue(buffer, static_cast<__int16>(value));
+            break;
+        default:
+            _bcfAppendValue(buffer, value);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bcfAppendTypedInt(), _bcfAppendTypeDescriptor()
+// ----------------------------------------------------------------------------
+
+inline void
+_bcfAppendTypedInt(CharString & buffer, __int32 value)
+{
+    char type = _bcfIntType(value, value);
+    appendValue(buffer, static_cast<char>(0x10 | type));
+    _bcfAppendInt(buffer, value, type);
+}
+
+inline void
+_bcfAppendTypeDescriptor(CharString & buffer, unsigned count, char type)
+{
+    if (count < 15u)
+    {
+        appendValue(buffer, static_cast<char>((count << 4) | type));
+    }
+    else
+    {
+        // Larger counts follow as a typed integer.
+        appendValue(buffer, static_cast<char>(0xf0 | type));
+        _bcfAppendTypedInt(buffer, count);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bcfAppendTypedString(), _bcfAppendTypedInts(), ...
+// ----------------------------------------------------------------------------
+
+inline void
+_bcfAppendTypedString(CharString & buffer, char const * first, char const * last)
+{
+    _bcfAppendTypeDescriptor(buffer, last - first, BCF_TYPE_CHAR);
+    unsigned oldLength = length(buffer);
+    resize(buffer, oldLength + (last - first), Generous());
+    std::copy(first, last, begin(buffer, Standard()) + oldLength);
+}
+
+// Smallest integer type for the values, ignoring missing values and vector ends.
+
+inline char
+_bcfIntType(String<__int32> const & values)
+{
+    __int32 minValue = 0;
+    __int32 maxValue = 0;
+    for (unsigned i = 0; i < length(values); ++i)
+    {
+        if (values[i] == BCF_INT32_MISSING || values[i] == BCF_INT32_VECTOR_END)
+            continue;
+        minValue = std::min(minValue, values[i]);
+        maxValue = std::max(maxValue, values[i]);
+    }
+    return _bcfIntType(minValue, maxValue);
+}
+
+inline void
+_bcfAppendTypedInts(CharString & buffer, String<__int32> const & values)
+{
+    char type = _bcfIntType(values);
+    _bcfAppendTypeDescriptor(buffer, length(values), empty(values) ? (char)BCF_TYPE_MISSING : type);
+    for (unsigned i = 0; i < length(values); ++i)
+        _bcfAppendInt(buffer, values[i], type);
+}
+
+inline void
+_bcfAppendTypedFloats(CharString & buffer, String<__uint32> const & values)
+{
+    _bcfAppendTypeDescriptor(buffer, length(values), BCF_TYPE_FLOAT);
+    for (unsigned i = 0; i < length(values); ++i)
+        _bcfAppendValue(buffer, values[i]);
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bcfParseInts(), _bcfParseFloats(), _bcfParseGenotype()
+// ----------------------------------------------------------------------------
+
+// These functions append the comma-separated values in [first, last) to values, "." is a missing value.  Floats are
+// stored as their bit patterns to keep the missing value.
+
+inline char const *
+_bcfNextValue(char const * first, char const * last)
+{
+    char const * it = static_cast<char const *>(memchr(first, ',', last - first));
+    return (it != 0) ? it : last;
+}
+
+inline bool
+_bcfParseInts(String<__int32> & values, char const * first, char const * last)
+{
+    for (;; ++first)
+    {
+        char const * valueEnd = _bcfNextValue(first, last);
+        __int32 value = BCF_INT32_MISSING;
+        if ((valueEnd - first != 1 || *first != '.') && !_vcfLexicalCast(value, first, valueEnd))
+            return false;  // Could not cast number.
+        appendValue(values, value);
+        if ((first = valueEnd) == last)
+            return true;
+    }
+}
+
+inline bool
+_bcfParseFloats(String<__uint32> & values, char const * first, char const * last)
+{
+    for (;; ++first)
+    {
+        char const * valueEnd = _bcfNextValue(first, last);
+        __uint32 bits = BCF_FLOAT_MISSING;
+        if (valueEnd - first != 1 || *first != '.')
+        {
+            float value = 0;
+            if (!_vcfLexicalCast(value, first, valueEnd))
+                return false;  // Could not cast number.
+            memcpy(&bits, &value, 4);
+        }
+        appendValue(values, bits);
+        if ((first = valueEnd) == last)
+            return true;
+    }
+}
+
+// Alleles are encoded as (allele + 1) << 1 | phased where phased refers to the separator before the allele.
+
+inline bool
+_bcfParseGenotype(String<__int32> & values, char const * first, char const * last)
+{
+    bool phased = false;
+    for (;; ++first)
+    {
+        char const * alleleEnd = first;
+        while (alleleEnd != last && *alleleEnd != '/' && *alleleEnd != '|')
+            ++alleleEnd;
+        __int32 allele = -1;
+        if ((alleleEnd - first != 1 || *first != '.') && (!_vcfLexicalCast(allele, first, alleleEnd) || allele < 0))
+            return false;  // Invalid allele.
+        appendValue(values, ((allele + 1) << 1) | (phased ? 1 : 0));
+        if ((first = alleleEnd) == last)
+            return true;
+        phased = (*first == '|');
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _bcfAppendFormatValues()
+// ----------------------------------------------------------------------------
+
+// Append the values of one FORMAT key for all samples.  sampleEnds[i] is the end of the values of sample i, samples
+// with fewer values are padded with vector ends, samples without values get a missing value.
+
+inline unsigned
+_bcfFormatVectorLength(String<unsigned> const & sampleEnds)
+{
+    unsigned vectorLength = 1;
+    for (unsigned i = 0, sampleBegin = 0; i < length(sampleEnds); sampleBegin = sampleEnds[i++])
+        vectorLength = std::max(vectorLength, sampleEnds[i] - sampleBegin);
+    return vectorLength;
+}
+
+inline void
+_bcfAppendFormatValues(CharString & buffer, String<__int32> const & values, String<unsigned> const & sampleEnds)
+{
+    unsigned vectorLength = _bcfFormatVectorLength(sampleEnds);
+    char type = _bcfIntType(values);
+    _bcfAppendTypeDescriptor(buffer, vectorLength, type);
+    for (unsigned i = 0, sampleBegin = 0; i < length(sampleEnds); sampleBegin = sampleEnds[i++])
+        for (unsigned j = 0; j < vectorLength; ++j)
+        {
+            if (sampleBegin + j < sampleEnds[i])
+                _bcfAppendInt(buffer, values[sampleBegin + j], type);
+            else
+                _bcfAppendInt(buffer, (j == 0u) ? BCF_INT32_MISSING : BCF_INT32_VECTOR_END, type);
+        }
+}
+
+inline void
+_bcfAppendFormatValues(CharString & buffer, String<__uint32> const & values, String<unsigned> const & sampleEnds)
+{
+    unsigned vectorLength = _bcfFormatVectorLength(sampleEnds);
+    _bcfAppendTypeDescriptor(buffer, vectorLength, BCF_TYPE_FLOAT);
+    for (unsigned i = 0, sampleBegin = 0; i < length(sampleEnds); sampleBegin = sampleEnds[i++])
+        for (unsigned j = 0; j < vectorLength; ++j)
+        {
+            if (sampleBegin + j < sampleEnds[i])
+                _bcfAppendValue(buffer, values[sampleBegin + j]);
+            else
+                _bcfAppendValue(buffer, (j == 0u) ? BCF_FLOAT_MISSING : BCF_FLOAT_VECTOR_END);
+        }
+}
+
+// ----------------------------------------------------------------------------
+// Function write()                                                 [VcfHeader]
+// ----------------------------------------------------------------------------
+
+/**
+.Function.VCF I/O#write
+..signature:write(bgzfStream, header, context, Bcf())
+..param.bgzfStream:A @Spec.BGZF Stream@ to write a BCF2 header to. The string dictionary of $context$ is built from the header.
+...type:Spec.BGZF Stream
+*/
+
+template <typename TStream>
+int write(TStream & stream,
+          VcfHeader const & header,
+          VcfIOContext & context,
+          Bcf const & /*tag*/)
+{
+    // The reference ids of BCF records refer to the contig records, so there has to be one for each sequence, in the
+    // order of the sequence names.  They are written at the position of the first contig record.
+    refresh(context.sequenceNamesCache);
+    VcfHeader bcfHeader;
+    bcfHeader.sampleNames = header.sampleNames;
+    bcfHeader.sequenceNames = *context.sequenceNames;
+
+    String<VcfHeaderRecord> contigRecords;
+    resize(contigRecords, length(*context.sequenceNames));
+    CharString id;
+    for (unsigned i = 0; i < length(contigRecords); ++i)
+    {
+        contigRecords[i].key = "contig";
+        contigRecords[i].value = "<ID=";
+        append(contigRecords[i].value, (*context.sequenceNames)[i]);
+        appendValue(contigRecords[i].value, '>');
+    }
+    for (unsigned i = 0; i < length(header.headerRecords); ++i)
+    {
+        unsigned rID = 0;
+        if (header.headerRecords[i].key == "contig" && _vcfHeaderField(id, header.headerRecords[i].value, "ID") &&
+            getIdByName(*context.sequenceNames, id, rID, context.sequenceNamesCache))
+            contigRecords[rID].value = header.headerRecords[i].value;
+    }
+
+    bool contigsWritten = false;
+    for (unsigned i = 0; i < length(header.headerRecords); ++i)
+    {
+        if (header.headerRecords[i].key != "contig")
+            appendValue(bcfHeader.headerRecords, header.headerRecords[i]);
+        else if (!contigsWritten)
+            append(bcfHeader.headerRecords, contigRecords);
+        contigsWritten = contigsWritten || header.headerRecords[i].key == "contig";
+    }
+    if (!contigsWritten)
+        append(bcfHeader.headerRecords, contigRecords);
+
+    // Write the header as VCF text into memory.
+    std::stringstream vcfHeader;
+    if (write(vcfHeader, bcfHeader, context, Vcf()) != 0)
+        return 1;
+    std::string text = vcfHeader.str();
+
+    // Write magic string for version 2.2, the header text and its terminating '\0'.
+    streamWriteBlock(stream, "BCF\2\2", 5);
+    __uint32 lText = text.size() + 1;
+    streamWriteBlock(stream, reinterpret_cast<char const *>(&lText), 4);
+    streamWriteBlock(stream, text.c_str(), lText);
+
+    _bcfBuildDictionary(context, bcfHeader);
+    return streamError(stream);
+}
+
+// ----------------------------------------------------------------------------
+// Function writeRecord()                                           [VcfRecord]
+// ----------------------------------------------------------------------------
+
+/**
+.Function.VCF I/O#writeRecord
+..signature:writeRecord(bgzfStream, record, context, Bcf())
+..param.bgzfStream:A @Spec.BGZF Stream@ to write a BCF2 record to. The FILTER, INFO and FORMAT keys must be declared in the header, the values are encoded with the types declared there.
+...type:Spec.BGZF Stream
+*/
+
+template <typename TStream>
+int writeRecord(TStream & stream,
+                VcfRecord const & record,
+                VcfIOContext & context,
+                Bcf const & /*tag*/)
+{
+    typedef Iterator<CharString const, Standard>::Type TIter;
+
+    CharString & buffer = context._bcfBuffer;
+    clear(buffer);
+
+    // Fixed fields, the numbers of alleles, INFO and FORMAT fields are filled in below.
+    _bcfAppendValue(buffer, static_cast<__int32>(record.rID));
+    _bcfAppendValue(buffer, static_cast<__int32>(record.beginPos));
+    _bcfAppendValue(buffer, static_cast<__int32>(length(record.ref)));
+    _bcfAppendValue(buffer, record.qual);
+    _bcfAppendValue(buffer, static_cast<__uint32>(0));
+    _bcfAppendValue(buffer, static_cast<__uint32>(0));
+
+    // ID
+    TIter it = begin(record.id, Standard());
+    TIter itEnd = end(record.id, Standard());
+    if (record.id == ".")
+        it = itEnd;
+    _bcfAppendTypedString(buffer, it, itEnd);
+
+    // REF and ALT
+    unsigned nAllele = 1;
+    _bcfAppendTypedString(buffer, begin(record.ref, Standard()), end(record.ref, Standard()));
+    if (!empty(record.alt) && record.alt != ".")
+        for (it = begin(record.alt, Standard()), itEnd = end(record.alt, Standard()); ; ++it)
+        {
+            ++nAllele;
+            TIter alleleEnd = _bcfNextValue(it, itEnd);
+            _bcfAppendTypedString(buffer, it, alleleEnd);
+            if ((it = alleleEnd) == itEnd)
+                break;
+        }
+
+    // FILTER
+    String<__int32> ints;
+    String<__uint32> floats;
+    CharString key;
+    unsigned idx = 0;
+    if (!empty(record.filter) && record.filter != ".")
+        for (it = begin(record.filter, Standard()), itEnd = end(record.filter, Standard()); ; ++it)
+        {
+            TIter filterEnd = std::find(it, itEnd, ';');
+            assign(key, infix(record.filter, it - begin(record.filter, Standard()), filterEnd - begin(record.filter, Standard())));
+            if (!getIdByName(context._bcfStrings, key, idx, context._bcfStringsCache))
+                return 1;  // Filter not declared in header.
+            appendValue(ints, idx);
+            if ((it = filterEnd) == itEnd)
+                break;
+        }
+    _bcfAppendTypedInts(buffer, ints);
+
+    // INFO
+    unsigned nInfo = 0;
+    if (!empty(record.info) && record.info != ".")
+        for (it = begin(record.info, Standard()), itEnd = end(record.info, Standard()); ; ++it)
+        {
+            ++nInfo;
+            TIter entryEnd = std::find(it, itEnd, ';');
+            TIter keyEnd = std::find(it, entryEnd, '=');
+            assign(key, infix(record.info, it - begin(record.info, Standard()), keyEnd - begin(record.info, Standard())));
+            if (!getIdByName(context._bcfStrings, key, idx, context._bcfStringsCache))
+                return 1;  // INFO key not declared in header.
+            _bcfAppendTypedInt(buffer, idx);
+
+            // Encode the value with the type from the header, flags are encoded as 1.
+            char valueType = context._bcfInfoTypes[idx];
+            TIter valueBegin = (keyEnd == entryEnd) ? entryEnd : keyEnd + 1;
+            if (keyEnd == entryEnd || valueType == BCF_VALUE_FLAG)
+            {
+                _bcfAppendTypedInt(buffer, 1);
+            }
+            else if (valueType == BCF_VALUE_INTEGER)
+            {
+                clear(ints);
+                if (!_bcfParseInts(ints, valueBegin, entryEnd))
+                    return 1;
+                _bcfAppendTypedInts(buffer, ints);
+            }
+            else if (valueType == BCF_VALUE_FLOAT)
+            {
+                clear(floats);
+                if (!_bcfParseFloats(floats, valueBegin, entryEnd))
+                    return 1;
+                _bcfAppendTypedFloats(buffer, floats);
+            }
+            else
+            {
+                _bcfAppendTypedString(buffer, valueBegin, entryEnd);
+            }
+
+            if ((it = entryEnd) == itEnd)
+                break;
+        }
+
+    __uint32 nAlleleInfo = (nAllele << 16) | nInfo;
+    memcpy(&buffer[16], &nAlleleInfo, 4);
+    __uint32 lShared = length(buffer);
+
+    // FORMAT and the samples, the values of one key are stored for all samples one after the other.
+    unsigned nSample = length(*context.sampleNames);
+    unsigned nFmt = 0;
+    String<unsigned> sampleEnds;
+    if (nSample > 0u && !empty(record.format) && record.format != ".")
+        for (it = begin(record.format, Standard()), itEnd = end(record.format, Standard()); ; ++it)
+        {
+            unsigned fieldNo = nFmt++;
+            TIter keyEnd = std::find(it, itEnd, ':');
+            assign(key, infix(record.format, it - begin(record.format, Standard()), keyEnd - begin(record.format, Standard())));
+            if (!getIdByName(context._bcfStrings, key, idx, context._bcfStringsCache))
+                return 1;  // FORMAT key not declared in header.
+            _bcfAppendTypedInt(buffer, idx);
+
+            // Parse the values of all samples, samples without this field get no values.
+            char valueType = (key == "GT") ? (char)BCF_VALUE_UNKNOWN : context._bcfFormatTypes[idx];
+            bool isNumeric = (key == "GT" || valueType == BCF_VALUE_INTEGER || valueType == BCF_VALUE_FLOAT);
+            clear(ints);
+            clear(floats);
+            clear(sampleEnds);
+            unsigned maxLength = 0;
+            for (unsigned i = 0; i < nSample; ++i)
+            {
+                char const * fieldBegin = 0;
+                char const * fieldEnd = 0;
+                bool hasField = false;
+                if (i < length(record.genotypeInfos) && !empty(record.genotypeInfos[i]))
+                    hasField = _vcfFindField(fieldBegin, fieldEnd, begin(record.genotypeInfos[i], Standard()),
+                                             end(record.genotypeInfos[i], Standard()), fieldNo, ':');
+                if (hasField && isNumeric && !(fieldEnd - fieldBegin == 1 && *fieldBegin == '.'))
+                {
+                    bool ok = (key == "GT") ? _bcfParseGenotype(ints, fieldBegin, fieldEnd) :
+                              (valueType == BCF_VALUE_INTEGER) ? _bcfParseInts(ints, fieldBegin, fieldEnd) :
+                              _bcfParseFloats(floats, fieldBegin, fieldEnd);
+                    if (!ok)
+                        return 1;  // Invalid value.
+                }
+                if (hasField)
+                    maxLength = std::max(maxLength, static_cast<unsigned>(fieldEnd - fieldBegin));
+                appendValue(sampleEnds, (valueType == BCF_VALUE_FLOAT) ? length(floats) : length(ints));
+            }
+
+            if (key == "GT" || valueType == BCF_VALUE_INTEGER)
+            {
+                _bcfAppendFormatValues(buffer, ints, sampleEnds);
+            }
+            else if (valueType == BCF_VALUE_FLOAT)
+            {
+                _bcfAppendFormatValues(buffer, floats, sampleEnds);
+            }
+            else
+            {
+                // Strings are padded with '\0' to the longest one.
+                _bcfAppendTypeDescriptor(buffer, maxLength, BCF_TYPE_CHAR);
+                for (unsigned i = 0; i < nSample; ++i)
+                {
+                    char const * fieldBegin = 0;
+                    char const * fieldEnd = 0;
+                    unsigned oldLength = length(buffer);
+                    resize(buffer, oldLength + maxLength, '\0', Generous());
+                    if (i < length(record.genotypeInfos) && !empty(record.genotypeInfos[i]) &&
+                        _vcfFindField(fieldBegin, fieldEnd, begin(record.genotypeInfos[i], Standard()),
+                                      end(record.genotypeInfos[i], Standard()), fieldNo, ':'))
+                        std::copy(fieldBegin, fieldEnd, begin(buffer, Standard()) + oldLength);
+                }
+            }
+
+            if ((it = keyEnd) == itEnd)
+                break;
+        }
+
+    __uint32 nFmtSample = (nFmt << 24) | nSample;
+    memcpy(&buffer[20], &nFmtSample, 4);
+    __uint32 lIndiv = length(buffer) - lShared;
+
+    streamWriteBlock(stream, reinterpret_cast<char const *>(&lShared), 4);
+    streamWriteBlock(stream, reinterpret_cast<char const *>(&lIndiv), 4);
+    streamWriteBlock(stream, &buffer[0], length(buffer));
+    return streamError(stream);
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_EXTRAS_INCLUDE_SEQAN_VCF_IO_WRITE_BCF_H_
@@ -65,9 +65,12 @@ namespace seqan {
  * @brief Write a VcfHeader.
  *
  * @signature int write(stream, header, context, Vcf());
+ * @signature int write(bgzfStream, header, context, Bcf());
  *
  * @param[in,out] stream  The StreamConcept to write to.
  * @param[out]    header  The VcfHeader to write.
+ * @param[in,out] bgzfStream A @link BgzfStream @endlink to write a BCF2 header to.  The string dictionary of
+ *                           <tt>context</tt> is built from the header.
  * @param[in,out] context VcfIOContext to use.
  *
  * @return int A status code, 0 on success, a different value otherwise.
@@ -126,10 +129,16 @@ int write(TStream & stream,
  * @brief Write a VcfRecord.
  *
  * @signature int writeRecord(stream, record, context, Vcf());
+ * @signature int writeRecord(stream, lazyRecord, context, Vcf());
+ * @signature int writeRecord(bgzfStream, record, context, Bcf());
  *
  * @param[in,out] stream  The StreamConcept to write to.
  * @param[out]    record  The VcfRecord to write.
  * @param[in,out] context VcfIOContext to use.
+ * @param[in]     lazyRecord A VcfLazyRecord to write instead.  The reference name and position are written from the
+ *                           record's members, the remaining columns are copied from the raw line.
+ * @param[in,out] bgzfStream A @link BgzfStream @endlink to write a BCF2 record to.  The FILTER, INFO and FORMAT keys
+ *                           must be declared in the header, the values are encoded with the declared types.
  *
  * @return int A status code, 0 on success, a different value otherwise.
  */
@@ -207,6 +216,40 @@ int writeRecord(TStream & stream,
     return streamError(stream);
 }
 
+// ----------------------------------------------------------------------------
+// Function writeRecord()                                       [VcfLazyRecord]
+// ----------------------------------------------------------------------------
+
+/**
+.Function.VCF I/O#writeRecord
+..signature:writeRecord(stream, lazyRecord, context, Vcf())
+..param.lazyRecord:When writing a @Class.VcfLazyRecord@, the reference name and position are written from the record's members, the remaining columns are copied from the raw line.
+...type:Class.VcfLazyRecord
+*/
+
+template <typename TStream>
+int writeRecord(TStream & stream,
+                VcfLazyRecord const & record,
+                VcfIOContext const & vcfIOContext,
+                Vcf const & /*tag*/)
+{
+    streamWriteBlock(stream, &(*vcfIOContext.sequenceNames)[record.rID][0],
+                     length((*vcfIOContext.sequenceNames)[record.rID]));
+    streamWriteChar(stream, '\t');
+    streamPut(stream, record.beginPos + 1);
+
+    // Copy the line from the tab before ID.
+    if (length(record._columnEnds) > (unsigned)VcfLazyRecord::POS_COLUMN)
+    {
+        unsigned idBegin = record._columnEnds[VcfLazyRecord::POS_COLUMN];
+        if (idBegin < length(record._line))
+            streamWriteBlock(stream, &record._line[idBegin], length(record._line) - idBegin);
+    }
+    streamWriteChar(stream, '\n');
+
+    return streamError(stream);
+}
+
 }  // namespace seqan
 
 #endif  // #ifndef SEQAN_EXTRAS_INCLUDE_SEQAN_VCF_WRITE_VCF_H_
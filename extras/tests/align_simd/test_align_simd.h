@@ -0,0 +1,239 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Tests for the align_simd module.
+// ==========================================================================
+
+#ifndef SEQAN_EXTRAS_TESTS_ALIGN_SIMD_TEST_ALIGN_SIMD_H_
+#define SEQAN_EXTRAS_TESTS_ALIGN_SIMD_TEST_ALIGN_SIMD_H_
+
+#include <seqan/basic.h>
+#include <seqan/sequence.h>
+#include <seqan/random.h>
+#include <seqan/align_simd.h>
+
+// Generates random pairs of similar sequences, some of them empty.
+template <typename TAlphabet>
+void testAlignSimdGeneratePairs(seqan::StringSet<seqan::String<TAlphabet> > & stringsH,
+                                seqan::StringSet<seqan::String<TAlphabet> > & stringsV,
+                                unsigned pairsCount,
+                                unsigned maxLength)
+{
+    seqan::Rng<seqan::MersenneTwister> rng(42);
+    for (unsigned i = 0; i < pairsCount; ++i)
+    {
+        seqan::String<TAlphabet> seqH, seqV;
+        unsigned lengthH = (i % 13 == 5) ? 0 : pickRandomNumber(rng) % maxLength;
+        for (unsigned j = 0; j < lengthH; ++j)
+            appendValue(seqH, TAlphabet(pickRandomNumber(rng) % seqan::ValueSize<TAlphabet>::VALUE));
+        // Derive the vertical sequence by mutating the horizontal one.
+        for (unsigned j = 0; j < lengthH; ++j)
+        {
+            unsigned r = pickRandomNumber(rng) % 10;
+            if (r == 0)
+                continue;
+            if (r == 1)
+                appendValue(seqV, TAlphabet(pickRandomNumber(rng) % seqan::ValueSize<TAlphabet>::VALUE));
+            else if (r == 2)
+                appendValue(seqV, TAlphabet(pickRandomNumber(rng) % seqan::ValueSize<TAlphabet>::VALUE));
+            appendValue(seqV, seqH[j]);
+        }
+        if (i % 11 == 3)
+            clear(seqV);
+        appendValue(stringsH, seqH);
+        appendValue(stringsV, seqV);
+    }
+}
+
+// The sequential global alignment requires non-empty sequences.
+template <typename TSequence, typename TScore>
+int testAlignSimdGlobalScore(TSequence const & seqH, TSequence const & seqV, TScore const & scoringScheme)
+{
+    if (empty(seqH) && empty(seqV))
+        return 0;
+    if (empty(seqH) || empty(seqV))
+        return scoreGapOpen(scoringScheme) + (length(seqH) + length(seqV) - 1) * scoreGapExtend(scoringScheme);
+    return globalAlignmentScore(seqH, seqV, scoringScheme);
+}
+
+// Recomputes the score of an alignment from its rows.
+template <typename TAlign, typename TScore>
+int testAlignSimdAlignmentScore(TAlign const & align, TScore const & scoringScheme)
+{
+    typedef typename seqan::Row<TAlign const>::Type TRow;
+    typedef typename seqan::Iterator<TRow, seqan::Standard>::Type TRowIter;
+
+    SEQAN_ASSERT_EQ(length(row(align, 0)), length(row(align, 1)));
+
+    int result = 0;
+    bool gapOpen0 = false, gapOpen1 = false;
+    TRowIter it1 = begin(row(align, 1), seqan::Standard());
+    for (TRowIter it0 = begin(row(align, 0), seqan::Standard()); it0 != end(row(align, 0), seqan::Standard()); ++it0, ++it1)
+    {
+        SEQAN_ASSERT_NOT(isGap(it0) && isGap(it1));
+        if (isGap(it0))
+            result += gapOpen0 ? scoreGapExtend(scoringScheme) : scoreGapOpen(scoringScheme);
+        else if (isGap(it1))
+            result += gapOpen1 ? scoreGapExtend(scoringScheme) : scoreGapOpen(scoringScheme);
+        else
+            result += score(scoringScheme, *it0, *it1);
+        gapOpen0 = isGap(it0);
+        gapOpen1 = isGap(it1);
+    }
+    return result;
+}
+
+template <typename TAlphabet, typename TScore>
+void testAlignSimdScore(TScore const & scoringScheme)
+{
+    using namespace seqan;
+
+    StringSet<String<TAlphabet> > stringsH, stringsV;
+    testAlignSimdGeneratePairs(stringsH, stringsV, 83, 70);
+
+    String<int> scores;
+    globalAlignmentScoreBatch(scores, stringsH, stringsV, scoringScheme);
+    SEQAN_ASSERT_EQ(length(scores), length(stringsH));
+    for (unsigned i = 0; i < length(stringsH); ++i)
+        SEQAN_ASSERT_EQ(scores[i], testAlignSimdGlobalScore(stringsH[i], stringsV[i], scoringScheme));
+
+    localAlignmentScoreBatch(scores, stringsH, stringsV, scoringScheme);
+    SEQAN_ASSERT_EQ(length(scores), length(stringsH));
+    for (unsigned i = 0; i < length(stringsH); ++i)
+    {
+        Align<String<TAlphabet> > align;
+        resize(rows(align), 2);
+        assignSource(row(align, 0), stringsH[i]);
+        assignSource(row(align, 1), stringsV[i]);
+        int expected = (empty(stringsH[i]) || empty(stringsV[i])) ? 0 : localAlignment(align, scoringScheme);
+        SEQAN_ASSERT_EQ(scores[i], expected);
+    }
+}
+
+template <typename TAlphabet, typename TScore>
+void testAlignSimdTraceback(TScore const & scoringScheme)
+{
+    using namespace seqan;
+
+    typedef Align<String<TAlphabet> > TAlign;
+
+    StringSet<String<TAlphabet> > stringsH, stringsV;
+    testAlignSimdGeneratePairs(stringsH, stringsV, 37, 50);
+
+    String<TAlign> aligns;
+    resize(aligns, length(stringsH));
+    for (unsigned i = 0; i < length(aligns); ++i)
+    {
+        resize(rows(aligns[i]), 2);
+        assignSource(row(aligns[i], 0), stringsH[i]);
+        assignSource(row(aligns[i], 1), stringsV[i]);
+    }
+
+    String<int> scores;
+    globalAlignmentBatch(scores, aligns, scoringScheme);
+    for (unsigned i = 0; i < length(aligns); ++i)
+    {
+        SEQAN_ASSERT_EQ(scores[i], testAlignSimdGlobalScore(stringsH[i], stringsV[i], scoringScheme));
+        SEQAN_ASSERT_EQ(testAlignSimdAlignmentScore(aligns[i], scoringScheme), scores[i]);
+        SEQAN_ASSERT_EQ(toSourcePosition(row(aligns[i], 0), length(row(aligns[i], 0))), length(stringsH[i]));
+        SEQAN_ASSERT_EQ(toSourcePosition(row(aligns[i], 1), length(row(aligns[i], 1))), length(stringsV[i]));
+    }
+
+    localAlignmentBatch(scores, aligns, scoringScheme);
+    for (unsigned i = 0; i < length(aligns); ++i)
+    {
+        TAlign align;
+        resize(rows(align), 2);
+        assignSource(row(align, 0), stringsH[i]);
+        assignSource(row(align, 1), stringsV[i]);
+        int expected = (empty(stringsH[i]) || empty(stringsV[i])) ? 0 : localAlignment(align, scoringScheme);
+        SEQAN_ASSERT_EQ(scores[i], expected);
+        SEQAN_ASSERT_EQ(testAlignSimdAlignmentScore(aligns[i], scoringScheme), scores[i]);
+    }
+}
+
+SEQAN_DEFINE_TEST(test_align_simd_score_linear)
+{
+    testAlignSimdScore<seqan::Dna5>(seqan::Score<int, seqan::Simple>(2, -3, -2));
+}
+
+SEQAN_DEFINE_TEST(test_align_simd_score_affine)
+{
+    testAlignSimdScore<seqan::Dna5>(seqan::Score<int, seqan::Simple>(2, -3, -1, -5));
+}
+
+SEQAN_DEFINE_TEST(test_align_simd_score_matrix)
+{
+    testAlignSimdScore<seqan::AminoAcid>(seqan::Blosum62(-1, -11));
+}
+
+SEQAN_DEFINE_TEST(test_align_simd_score_overflow)
+{
+    using namespace seqan;
+
+    // The scores of these pairs do not fit into 16 bit lanes.
+    StringSet<DnaString> stringsH, stringsV;
+    resize(stringsH, 3);
+    resize(stringsV, 3);
+    resize(stringsH[0], 3000, Dna('A'));
+    resize(stringsV[0], 3000, Dna('A'));
+    stringsH[1] = "ACGT";
+    stringsV[1] = "AGT";
+
+    Score<int, Simple> scoringScheme(10, -10, -10);
+    String<int> scores;
+    globalAlignmentScoreBatch(scores, stringsH, stringsV, scoringScheme);
+    SEQAN_ASSERT_EQ(scores[0], 30000);
+    SEQAN_ASSERT_EQ(scores[1], 20);
+    SEQAN_ASSERT_EQ(scores[2], 0);
+
+    localAlignmentScoreBatch(scores, stringsH, stringsV, scoringScheme);
+    SEQAN_ASSERT_EQ(scores[0], 30000);
+    SEQAN_ASSERT_EQ(scores[1], 20);
+    SEQAN_ASSERT_EQ(scores[2], 0);
+}
+
+SEQAN_DEFINE_TEST(test_align_simd_traceback_linear)
+{
+    testAlignSimdTraceback<seqan::Dna>(seqan::Score<int, seqan::Simple>(2, -3, -2));
+}
+
+SEQAN_DEFINE_TEST(test_align_simd_traceback_affine)
+{
+    testAlignSimdTraceback<seqan::Dna>(seqan::Score<int, seqan::Simple>(2, -3, -1, -5));
+}
+
+SEQAN_DEFINE_TEST(test_align_simd_traceback_matrix)
+{
+    testAlignSimdTraceback<seqan::AminoAcid>(seqan::Blosum62(-1, -11));
+}
+
+#endif  // SEQAN_EXTRAS_TESTS_ALIGN_SIMD_TEST_ALIGN_SIMD_H_
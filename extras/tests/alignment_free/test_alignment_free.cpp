@@ -225,6 +225,30 @@ SEQAN_DEFINE_TEST(test_alignment_free_d2_dna5)
     SEQAN_ASSERT_IN_DELTA(value(myMatrix, 1, 1), 688.0, 0.01);
 }
 
+SEQAN_DEFINE_TEST(test_alignment_free_d2_large_counts)
+{
+    using namespace seqan;
+    StringSet<DnaString> sequences;
+    resize(sequences, 2);
+    for (unsigned i = 0; i < 50000; ++i)
+    {
+        append(sequences[0], "ACGT");
+        append(sequences[1], "TGCA");
+    }
+
+    typedef Matrix<double, 2> TMatrix;
+    TMatrix myMatrix;
+
+    // Every 1-mer occurs 50000 times, the inner products exceed 32 bits.
+    AFScore<D2> myScoreD2(1);
+    alignmentFreeComparison(myMatrix, sequences, myScoreD2);
+
+    SEQAN_ASSERT_IN_DELTA(value(myMatrix, 0, 0), 1e10, 0.01);
+    SEQAN_ASSERT_IN_DELTA(value(myMatrix, 0, 1), 1e10, 0.01);
+    SEQAN_ASSERT_IN_DELTA(value(myMatrix, 1, 0), 1e10, 0.01);
+    SEQAN_ASSERT_IN_DELTA(value(myMatrix, 1, 1), 1e10, 0.01);
+}
+
 SEQAN_DEFINE_TEST(test_alignment_free_d2star_dna5)
 {
     using namespace seqan;
@@ -499,11 +523,58 @@ SEQAN_DEFINE_TEST(test_alignment_free_cut_ns)
     SEQAN_ASSERT_EQ(sequenceMaskedPartsRemoved, "TTTCCGAAAAGGTAGCAACTTTACGTGATCAAAGTTTTCCCCGTCGAAATTGGGTG");
 }
 
+// Compares every entry of the matrix of a larger sequence set, which spans several tiles, with the score computed
+// for the pair of sequences alone.
+template <typename TScore>
+void alfTestHelperCompareTiles(seqan::StringSet<seqan::Dna5String> const & sequences, TScore const & score)
+{
+    using namespace seqan;
+    Matrix<double, 2> myMatrix;
+    alignmentFreeComparison(myMatrix, sequences, score);
+
+    for (unsigned i = 0; i < length(sequences); ++i)
+        for (unsigned j = i; j < length(sequences); ++j)
+        {
+            StringSet<Dna5String> pair;
+            appendValue(pair, sequences[i]);
+            appendValue(pair, sequences[j]);
+            Matrix<double, 2> pairMatrix;
+            alignmentFreeComparison(pairMatrix, pair, score);
+            SEQAN_ASSERT_IN_DELTA(value(myMatrix, i, j), value(pairMatrix, 0, 1), 0.0001);
+            SEQAN_ASSERT_IN_DELTA(value(myMatrix, j, i), value(pairMatrix, 0, 1), 0.0001);
+        }
+}
+
+SEQAN_DEFINE_TEST(test_alignment_free_matrix_tiles)
+{
+    using namespace seqan;
+    StringSet<Dna5String> sequences;
+    unsigned seed = 42;
+    for (unsigned i = 0; i < 20; ++i)
+    {
+        Dna5String seq;
+        for (unsigned j = 0; j < 100 + 7 * i; ++j)
+        {
+            seed = seed * 1103515245u + 12345u;
+            appendValue(seq, Dna5((seed >> 16) % 4));
+        }
+        appendValue(sequences, seq);
+    }
+
+    alfTestHelperCompareTiles(sequences, AFScore<D2>(3));
+    alfTestHelperCompareTiles(sequences, AFScore<D2Star>(3, 0));
+    alfTestHelperCompareTiles(sequences, AFScore<D2Star>(3, 1));
+    alfTestHelperCompareTiles(sequences, AFScore<D2z>(3, 0));
+    alfTestHelperCompareTiles(sequences, AFScore<D2z>(3, 1));
+    alfTestHelperCompareTiles(sequences, AFScore<N2>(3, 0, "mean", 0, 0.5));
+}
+
 SEQAN_BEGIN_TESTSUITE(test_alignment_free)
 {
     // Call tests.
     SEQAN_CALL_TEST(test_alignment_free_d2_dna);
     SEQAN_CALL_TEST(test_alignment_free_d2_dna5);
+    SEQAN_CALL_TEST(test_alignment_free_d2_large_counts);
     SEQAN_CALL_TEST(test_alignment_free_d2star_dna5);
     SEQAN_CALL_TEST(test_alignment_free_d2z_dna5);
     SEQAN_CALL_TEST(test_alignment_free_n2_dna5);
@@ -516,5 +587,6 @@ SEQAN_BEGIN_TESTSUITE(test_alignment_free)
     SEQAN_CALL_TEST(test_alignment_free_calculate_overlap_indicator);
     SEQAN_CALL_TEST(test_alignment_free_string_to_string_set);
     SEQAN_CALL_TEST(test_alignment_free_cut_ns);
+    SEQAN_CALL_TEST(test_alignment_free_matrix_tiles);
 }
 SEQAN_END_TESTSUITE
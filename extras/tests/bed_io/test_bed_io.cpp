@@ -527,6 +527,56 @@ SEQAN_DEFINE_TEST(test_bed_bed_stream_write)
     SEQAN_ASSERT(seqan::_compareTextFiles(toCString(tmpPath), toCString(goldPath)));
 }
 
+#if SEQAN_HAS_ZLIB
+SEQAN_DEFINE_TEST(test_bed_bed_stream_jump_to_region)
+{
+    seqan::CharString inPath = SEQAN_PATH_TO_ROOT();
+    append(inPath, "/extras/tests/bed_io/example.bed");
+
+    // Compress the BED file with BGZF and index it.
+    seqan::CharString gzPath(SEQAN_TEMP_FILENAME());
+    append(gzPath, ".bed.gz");
+    {
+        std::ifstream in(toCString(inPath), std::ios::binary | std::ios::in);
+        std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        seqan::Stream<seqan::Bgzf> out;
+        SEQAN_ASSERT(open(out, toCString(gzPath), "w"));
+        SEQAN_ASSERT_EQ(streamWriteBlock(out, contents.c_str(), contents.size()), contents.size());
+    }
+    seqan::TabixIndex index;
+    SEQAN_ASSERT(buildIndex(index, toCString(gzPath), seqan::TabixIndex::BED));
+
+    // The compressed file is read like the plain file.
+    seqan::BedStream bedStream(toCString(gzPath));
+    SEQAN_ASSERT(isGood(bedStream));
+    seqan::BedRecord<seqan::Bed3> record;
+    SEQAN_ASSERT_EQ(readRecord(record, bedStream), 0);
+    SEQAN_ASSERT_EQ(record.ref, "chr7");
+    SEQAN_ASSERT_EQ(readRecord(record, bedStream), 0);
+    SEQAN_ASSERT_EQ(record.ref, "chr8");
+    SEQAN_ASSERT(atEnd(bedStream));
+
+    bool hasRecords = false;
+    SEQAN_ASSERT(jumpToRegion(bedStream, hasRecords, "chr8", 127473000, 127473001, index));
+    SEQAN_ASSERT(hasRecords);
+    SEQAN_ASSERT_EQ(readRecord(record, bedStream), 0);
+    SEQAN_ASSERT_EQ(record.ref, "chr8");
+    SEQAN_ASSERT_EQ(record.endPos, 127473530);
+    SEQAN_ASSERT(atEnd(bedStream));
+
+    SEQAN_ASSERT(jumpToRegion(bedStream, hasRecords, "chr7", 0, 127471200, index));
+    SEQAN_ASSERT(hasRecords);
+    SEQAN_ASSERT_EQ(readRecord(record, bedStream), 0);
+    SEQAN_ASSERT_EQ(record.ref, "chr7");
+    SEQAN_ASSERT_EQ(record.data, "Pos1\t0\t+\t127471196\t127472363\t255,0,0");
+
+    SEQAN_ASSERT(jumpToRegion(bedStream, hasRecords, "chr7", 0, 100000, index));
+    SEQAN_ASSERT_NOT(hasRecords);
+    SEQAN_ASSERT(jumpToRegion(bedStream, hasRecords, "chr9", 0, 127471200, index));
+    SEQAN_ASSERT_NOT(hasRecords);
+}
+#endif  // #if SEQAN_HAS_ZLIB
+
 SEQAN_BEGIN_TESTSUITE(test_bed_io)
 {
     // Reading of BED records.
@@ -548,5 +598,8 @@ SEQAN_BEGIN_TESTSUITE(test_bed_io)
     // BED Stream
     SEQAN_CALL_TEST(test_bed_bed_stream_read);
     SEQAN_CALL_TEST(test_bed_bed_stream_write);
+#if SEQAN_HAS_ZLIB
+    SEQAN_CALL_TEST(test_bed_bed_stream_jump_to_region);
+#endif  // #if SEQAN_HAS_ZLIB
 }
 SEQAN_END_TESTSUITE
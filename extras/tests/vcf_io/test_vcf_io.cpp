@@ -43,9 +43,16 @@ SEQAN_BEGIN_TESTSUITE(test_vcf_io)
     SEQAN_CALL_TEST(test_vcf_io_read_vcf_header);
     SEQAN_CALL_TEST(test_vcf_io_read_vcf_record);
     SEQAN_CALL_TEST(test_vcf_io_vcf_stream_read_record);
+    SEQAN_CALL_TEST(test_vcf_io_read_vcf_lazy_record);
 
     SEQAN_CALL_TEST(test_vcf_io_write_vcf_header);
     SEQAN_CALL_TEST(test_vcf_io_write_vcf_record);
+    SEQAN_CALL_TEST(test_vcf_io_write_vcf_lazy_record);
     SEQAN_CALL_TEST(test_vcf_io_vcf_stream_write_record);
+
+#if SEQAN_HAS_ZLIB
+    SEQAN_CALL_TEST(test_vcf_io_vcf_stream_bcf_round_trip);
+    SEQAN_CALL_TEST(test_vcf_io_vcf_stream_jump_to_region);
+#endif  // #if SEQAN_HAS_ZLIB
 }
 SEQAN_END_TESTSUITE
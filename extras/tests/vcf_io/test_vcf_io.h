@@ -258,6 +258,78 @@ SEQAN_DEFINE_TEST(test_vcf_io_vcf_stream_read_record)
     SEQAN_ASSERT_EQ(length(records[2].genotypeInfos), 3u);
 }
 
+SEQAN_DEFINE_TEST(test_vcf_io_read_vcf_lazy_record)
+{
+    seqan::CharString vcfPath = SEQAN_PATH_TO_ROOT();
+    append(vcfPath, "/extras/tests/vcf_io/example.vcf");
+
+    std::fstream inF(toCString(vcfPath), std::ios::in | std::ios::binary);
+    SEQAN_ASSERT(inF.good());
+
+    seqan::RecordReader<std::fstream, seqan::SinglePass<> > reader(inF);
+    seqan::VcfHeader vcfHeader;
+    seqan::VcfIOContext vcfIOContext(vcfHeader.sequenceNames, vcfHeader.sampleNames);
+
+    SEQAN_ASSERT_EQ(read(vcfHeader, reader, vcfIOContext, seqan::Vcf()), 0);
+
+    seqan::String<seqan::VcfLazyRecord> records;
+    while (!atEnd(reader))
+    {
+        seqan::VcfLazyRecord record;
+        SEQAN_ASSERT_EQ(readRecord(record, reader, vcfIOContext, seqan::Vcf()), 0);
+        appendValue(records, record);
+    }
+
+    SEQAN_ASSERT_EQ(length(records), 3u);
+
+    seqan::CharString buffer;
+    SEQAN_ASSERT_EQ(records[0].rID, 0);
+    SEQAN_ASSERT_EQ(records[0].beginPos, 14369);
+    getId(buffer, records[0]);
+    SEQAN_ASSERT_EQ(buffer, "rs6054257");
+    getRef(buffer, records[0]);
+    SEQAN_ASSERT_EQ(buffer, "G");
+    getAlt(buffer, records[0]);
+    SEQAN_ASSERT_EQ(buffer, "A");
+    SEQAN_ASSERT_EQ(getQual(records[0]), 29);
+    getFilter(buffer, records[0]);
+    SEQAN_ASSERT_EQ(buffer, "PASS");
+    getInfo(buffer, records[0]);
+    SEQAN_ASSERT_EQ(buffer, "NS=3;DP=14;AF=0.5;DB;H2");
+    SEQAN_ASSERT(getInfoValue(buffer, records[0], "DP"));
+    SEQAN_ASSERT_EQ(buffer, "14");
+    SEQAN_ASSERT(getInfoValue(buffer, records[0], "DB"));
+    SEQAN_ASSERT_EQ(buffer, "");
+    SEQAN_ASSERT_NOT(getInfoValue(buffer, records[0], "AA"));
+    getFormat(buffer, records[0]);
+    SEQAN_ASSERT_EQ(buffer, "GT:GQ:DP:HQ");
+
+    // Genotype values are only split on access.
+    SEQAN_ASSERT_EQ(numGenotypeInfos(records[1]), 3u);
+    getGenotypeInfo(buffer, records[1], 2);
+    SEQAN_ASSERT_EQ(buffer, "0/0:41:3");
+    SEQAN_ASSERT(getGenotypeValue(buffer, records[1], 1, "GQ"));
+    SEQAN_ASSERT_EQ(buffer, "3");
+    SEQAN_ASSERT(getGenotypeValue(buffer, records[1], 0, "HQ"));
+    SEQAN_ASSERT_EQ(buffer, "58,50");
+    SEQAN_ASSERT_NOT(getGenotypeValue(buffer, records[1], 2, "HQ"));
+
+    seqan::VcfRecord record;
+    decodeRecord(record, records[2]);
+    SEQAN_ASSERT_EQ(record.rID, 0);
+    SEQAN_ASSERT_EQ(record.beginPos, 1110695);
+    SEQAN_ASSERT_EQ(record.id, "rs6040355");
+    SEQAN_ASSERT_EQ(record.ref, "A");
+    SEQAN_ASSERT_EQ(record.alt, "G,T");
+    SEQAN_ASSERT_EQ(record.qual, 67);
+    SEQAN_ASSERT_EQ(record.filter, "PASS");
+    SEQAN_ASSERT_EQ(record.info, "NS=2;DP=10;AF=0.333,0.667;AA=T;DB");
+    SEQAN_ASSERT_EQ(record.format, "GT:GQ:DP:HQ");
+    SEQAN_ASSERT_EQ(length(record.genotypeInfos), 3u);
+    SEQAN_ASSERT_EQ(record.genotypeInfos[0], "1|2:21:6:23,27");
+    SEQAN_ASSERT_EQ(record.genotypeInfos[2], "2/2:35:4");
+}
+
 SEQAN_DEFINE_TEST(test_vcf_io_write_vcf_header)
 {
     seqan::CharString tmpPath(SEQAN_TEMP_FILENAME());
@@ -390,6 +462,33 @@ SEQAN_DEFINE_TEST(test_vcf_io_write_vcf_record)
     SEQAN_ASSERT(seqan::_compareTextFiles(toCString(tmpPath), toCString(goldPath)));
 }
 
+SEQAN_DEFINE_TEST(test_vcf_io_write_vcf_lazy_record)
+{
+    seqan::CharString vcfPath = SEQAN_PATH_TO_ROOT();
+    append(vcfPath, "/extras/tests/vcf_io/example.vcf");
+
+    std::fstream inF(toCString(vcfPath), std::ios::in | std::ios::binary);
+    SEQAN_ASSERT(inF.good());
+
+    seqan::RecordReader<std::fstream, seqan::SinglePass<> > reader(inF);
+    seqan::VcfHeader vcfHeader;
+    seqan::VcfIOContext vcfIOContext(vcfHeader.sequenceNames, vcfHeader.sampleNames);
+    SEQAN_ASSERT_EQ(read(vcfHeader, reader, vcfIOContext, seqan::Vcf()), 0);
+
+    seqan::VcfLazyRecord record;
+    SEQAN_ASSERT_EQ(readRecord(record, reader, vcfIOContext, seqan::Vcf()), 0);
+
+    seqan::CharString tmpPath(SEQAN_TEMP_FILENAME());
+    std::fstream outF(toCString(tmpPath), std::ios::out | std::ios::binary);
+    SEQAN_ASSERT(outF.good());
+    SEQAN_ASSERT_EQ(writeRecord(outF, record, vcfIOContext, seqan::Vcf()), 0);
+    outF.close();
+
+    seqan::CharString goldPath(SEQAN_PATH_TO_ROOT());
+    append(goldPath, "/extras/tests/vcf_io/vcf_record.vcf");
+    SEQAN_ASSERT(seqan::_compareTextFiles(toCString(tmpPath), toCString(goldPath)));
+}
+
 SEQAN_DEFINE_TEST(test_vcf_io_vcf_stream_write_record)
 {
     seqan::CharString tmpPath(SEQAN_TEMP_FILENAME());
@@ -501,4 +600,115 @@ SEQAN_DEFINE_TEST(test_vcf_io_vcf_stream_write_record)
     SEQAN_ASSERT(seqan::_compareTextFiles(toCString(tmpPath), toCString(goldPath)));
 }
 
+#if SEQAN_HAS_ZLIB
+SEQAN_DEFINE_TEST(test_vcf_io_vcf_stream_bcf_round_trip)
+{
+    seqan::CharString vcfPath = SEQAN_PATH_TO_ROOT();
+    append(vcfPath, "/extras/tests/vcf_io/example.vcf");
+
+    // Convert VCF to BCF, the format is selected by the file extension.
+    seqan::String<seqan::VcfRecord> records;
+    seqan::CharString bcfPath(SEQAN_TEMP_FILENAME());
+    append(bcfPath, ".bcf");
+    {
+        seqan::VcfStream vcfIn(toCString(vcfPath));
+        SEQAN_ASSERT(isGood(vcfIn));
+        seqan::VcfStream bcfOut(toCString(bcfPath), seqan::VcfStream::WRITE);
+        SEQAN_ASSERT(isGood(bcfOut));
+        bcfOut.header = vcfIn.header;
+
+        seqan::VcfRecord record;
+        while (!atEnd(vcfIn))
+        {
+            SEQAN_ASSERT_EQ(readRecord(record, vcfIn), 0);
+            SEQAN_ASSERT_EQ(writeRecord(bcfOut, record), 0);
+            appendValue(records, record);
+        }
+        close(bcfOut);
+    }
+
+    // Read the BCF file back in, the format is detected from the content.
+    seqan::VcfStream bcfIn(toCString(bcfPath));
+    SEQAN_ASSERT(isGood(bcfIn));
+    SEQAN_ASSERT_EQ(length(bcfIn.header.headerRecords), 18u);
+    SEQAN_ASSERT_EQ(bcfIn.header.headerRecords[4].key, "contig");
+    SEQAN_ASSERT_EQ(bcfIn.header.headerRecords[4].value, "<ID=20,length=62435964,assembly=B36,md5=f126cdf8a6e0c7f379d618ff66beb2da,species=\"Homo sapiens\",taxonomy=x>");
+    SEQAN_ASSERT_EQ(length(bcfIn.header.sequenceNames), 1u);
+    SEQAN_ASSERT_EQ(bcfIn.header.sequenceNames[0], "20");
+    SEQAN_ASSERT_EQ(length(bcfIn.header.sampleNames), 3u);
+    SEQAN_ASSERT_EQ(bcfIn.header.sampleNames[2], "NA00003");
+
+    unsigned i = 0;
+    seqan::VcfRecord record;
+    for (; !atEnd(bcfIn); ++i)
+    {
+        SEQAN_ASSERT_EQ(readRecord(record, bcfIn), 0);
+        SEQAN_ASSERT_LT(i, length(records));
+        SEQAN_ASSERT_EQ(record.rID, records[i].rID);
+        SEQAN_ASSERT_EQ(record.beginPos, records[i].beginPos);
+        SEQAN_ASSERT_EQ(record.id, records[i].id);
+        SEQAN_ASSERT_EQ(record.ref, records[i].ref);
+        SEQAN_ASSERT_EQ(record.alt, records[i].alt);
+        SEQAN_ASSERT_EQ(record.qual, records[i].qual);
+        SEQAN_ASSERT_EQ(record.filter, records[i].filter);
+        SEQAN_ASSERT_EQ(record.info, records[i].info);
+        SEQAN_ASSERT_EQ(record.format, records[i].format);
+        SEQAN_ASSERT_EQ(length(record.genotypeInfos), 3u);
+        for (unsigned j = 0; j < 3u; ++j)
+            SEQAN_ASSERT_EQ(record.genotypeInfos[j], records[i].genotypeInfos[j]);
+    }
+    SEQAN_ASSERT_EQ(i, 3u);
+}
+
+SEQAN_DEFINE_TEST(test_vcf_io_vcf_stream_jump_to_region)
+{
+    seqan::CharString vcfPath = SEQAN_PATH_TO_ROOT();
+    append(vcfPath, "/extras/tests/vcf_io/example.vcf");
+
+    // Compress the VCF file with BGZF and index it.
+    seqan::CharString gzPath(SEQAN_TEMP_FILENAME());
+    append(gzPath, ".vcf.gz");
+    {
+        std::ifstream in(toCString(vcfPath), std::ios::binary | std::ios::in);
+        std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        seqan::Stream<seqan::Bgzf> out;
+        SEQAN_ASSERT(open(out, toCString(gzPath), "w"));
+        SEQAN_ASSERT_EQ(streamWriteBlock(out, contents.c_str(), contents.size()), contents.size());
+    }
+    seqan::TabixIndex index;
+    SEQAN_ASSERT(buildIndex(index, toCString(gzPath), seqan::TabixIndex::VCF));
+
+    // The compressed file is read like the plain file.
+    seqan::VcfStream vcfIn(toCString(gzPath));
+    SEQAN_ASSERT(isGood(vcfIn));
+    SEQAN_ASSERT_EQ(length(vcfIn.header.headerRecords), 18u);
+    SEQAN_ASSERT_EQ(length(vcfIn.header.sampleNames), 3u);
+    seqan::VcfRecord record;
+    unsigned i = 0;
+    for (; !atEnd(vcfIn); ++i)
+        SEQAN_ASSERT_EQ(readRecord(record, vcfIn), 0);
+    SEQAN_ASSERT_EQ(i, 3u);
+
+    bool hasRecords = false;
+    SEQAN_ASSERT(jumpToRegion(vcfIn, hasRecords, "20", 17000, 1000000, index));
+    SEQAN_ASSERT(hasRecords);
+    SEQAN_ASSERT_EQ(readRecord(record, vcfIn), 0);
+    SEQAN_ASSERT_EQ(record.rID, 0);
+    SEQAN_ASSERT_EQ(record.beginPos, 17329);
+    SEQAN_ASSERT_EQ(readRecord(record, vcfIn), 0);
+    SEQAN_ASSERT_EQ(record.beginPos, 1110695);
+    SEQAN_ASSERT(atEnd(vcfIn));
+
+    SEQAN_ASSERT(jumpToRegion(vcfIn, hasRecords, "20", 14369, 14370, index));
+    SEQAN_ASSERT(hasRecords);
+    SEQAN_ASSERT_EQ(readRecord(record, vcfIn), 0);
+    SEQAN_ASSERT_EQ(record.id, "rs6054257");
+
+    SEQAN_ASSERT(jumpToRegion(vcfIn, hasRecords, "20", 20000, 1000000, index));
+    SEQAN_ASSERT_NOT(hasRecords);
+    SEQAN_ASSERT(jumpToRegion(vcfIn, hasRecords, "21", 0, 1000000, index));
+    SEQAN_ASSERT_NOT(hasRecords);
+}
+#endif  // #if SEQAN_HAS_ZLIB
+
 #endif  // SEQAN_EXTRAS_TESTS_VCF_TEST_VCF_IO_H_